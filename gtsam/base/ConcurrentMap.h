@@ -54,6 +54,9 @@ using ConcurrentMapBase = gtsam::FastMap<KEY, VALUE>;
 
 #include <gtsam/base/FastVector.h>
 
+#include <iterator>
+#include <utility>
+
 namespace gtsam {
 
 /**
@@ -87,6 +90,38 @@ public:
   /** Handy 'exists' function */
   bool exists(const KEY& e) const { return this->count(e); }
 
+  /**
+   * Size the hash table ahead of a batch of insertions, so the insertions do
+   * not trigger incremental rehashes.  Rehash pauses of large maps (such as
+   * the BayesTree nodes index during big ISAM2 updates) otherwise show up as
+   * multi-millisecond blips; callers that know the expected size from graph
+   * statistics should reserve before inserting.  No-op for the tree-based
+   * fallback used without TBB.
+   */
+  void reserve(size_t expectedSize) {
+#ifdef GTSAM_USE_TBB
+    this->rehash(expectedSize);
+#else
+    (void)expectedSize;
+#endif
+  }
+
+  /** Insert a range after a single up-front reserve covering all of it */
+  template<typename INPUTITERATOR>
+  void bulkInsert(INPUTITERATOR first, INPUTITERATOR last) {
+    reserve(this->size() + std::distance(first, last));
+    this->insert(first, last);
+  }
+
+  /**
+   * Copy the current contents into a flat vector.  Unlike iterating the map
+   * directly, the snapshot is unaffected by concurrent insertions and has
+   * stable, cache-friendly iteration order.
+   */
+  FastVector<std::pair<KEY, VALUE> > snapshot() const {
+    return FastVector<std::pair<KEY, VALUE> >(this->begin(), this->end());
+  }
+
 #ifndef GTSAM_USE_TBB
   // If we're not using TBB and this is actually a FastMap, we need to add these functions and hide
   // the original erase functions.
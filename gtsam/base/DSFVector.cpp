@@ -17,8 +17,16 @@
  */
 
 #include <gtsam/base/DSFVector.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <atomic>
+#endif
+
 #include <boost/make_shared.hpp>
 #include <algorithm>
+#include <numeric>
 
 using namespace std;
 
@@ -55,6 +63,42 @@ void DSFBase::merge(const size_t& i1, const size_t& i2) {
   (*v_)[find(i2)] = find(i1);
 }
 
+/* ************************************************************************* */
+DSFBase::V DSFBase::componentLabels() const {
+  // Pointer jumping: each round replaces every label by its label's label,
+  // halving tree depth, until a fixed point where every label is a root.
+  // Each round only reads the previous labels and writes disjoint entries,
+  // so the rounds parallelize trivially.
+  V labels = *v_;
+  const size_t n = labels.size();
+  bool changed = true;
+  while (changed) {
+    V next = labels;
+#ifdef GTSAM_USE_TBB
+    std::atomic<bool> anyChanged(false);
+    tbb::parallel_for(size_t(0), n, [&](size_t i) {
+      const size_t grandparent = labels[labels[i]];
+      if (grandparent != next[i]) {
+        next[i] = grandparent;
+        anyChanged.store(true, std::memory_order_relaxed);
+      }
+    });
+    changed = anyChanged.load();
+#else
+    changed = false;
+    for (size_t i = 0; i < n; ++i) {
+      const size_t grandparent = labels[labels[i]];
+      if (grandparent != next[i]) {
+        next[i] = grandparent;
+        changed = true;
+      }
+    }
+#endif
+    labels.swap(next);
+  }
+  return labels;
+}
+
 /* ************************************************************************* */
 DSFVector::DSFVector(const size_t numNodes) :
     DSFBase(numNodes) {
@@ -114,5 +158,68 @@ std::map<size_t, std::vector<size_t> > DSFVector::arrays() const {
   return arrays;
 }
 
+/* ************************************************************************* */
+DSFFlat::DSFFlat(const size_t numNodes) :
+    parent_(numNodes), rank_(numNodes, 0) {
+  std::iota(parent_.begin(), parent_.end(), size_t(0));
+}
+
+/* ************************************************************************* */
+size_t DSFFlat::find(size_t key) const {
+  // Path halving: point every other node on the path at its grandparent.
+  // One pass, no recursion, and the tree still flattens amortized.
+  while (parent_[key] != key) {
+    parent_[key] = parent_[parent_[key]];
+    key = parent_[key];
+  }
+  return key;
+}
+
+/* ************************************************************************* */
+void DSFFlat::merge(size_t i1, size_t i2) {
+  const size_t required = std::max(i1, i2) + 1;
+  if (required > parent_.size()) {
+    const size_t previous = parent_.size();
+    parent_.resize(required);
+    rank_.resize(required, 0);
+    std::iota(parent_.begin() + previous, parent_.end(), previous);
+  }
+
+  size_t root1 = find(i1), root2 = find(i2);
+  if (root1 == root2)
+    return;
+
+  // Union by rank, attach the shallower tree below the deeper one
+  if (rank_[root1] < rank_[root2])
+    std::swap(root1, root2);
+  parent_[root2] = root1;
+  if (rank_[root1] == rank_[root2])
+    ++rank_[root1];
+}
+
+/* ************************************************************************* */
+void DSFFlat::merge(const std::vector<std::pair<size_t, size_t> >& pairs) {
+  // Grow once to the largest key so the per-pair loop never reallocates
+  size_t maxKey = 0;
+  for (const std::pair<size_t, size_t>& pair : pairs)
+    maxKey = std::max(maxKey, std::max(pair.first, pair.second));
+  if (!pairs.empty() && maxKey + 1 > parent_.size()) {
+    const size_t previous = parent_.size();
+    parent_.resize(maxKey + 1);
+    rank_.resize(maxKey + 1, 0);
+    std::iota(parent_.begin() + previous, parent_.end(), previous);
+  }
+  for (const std::pair<size_t, size_t>& pair : pairs)
+    merge(pair.first, pair.second);
+}
+
+/* ************************************************************************* */
+std::map<size_t, std::set<size_t> > DSFFlat::sets() const {
+  std::map<size_t, std::set<size_t> > sets;
+  for (size_t key = 0; key < parent_.size(); ++key)
+    sets[find(key)].insert(key);
+  return sets;
+}
+
 } // namespace  gtsam
 
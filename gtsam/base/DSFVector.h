@@ -56,6 +56,14 @@ public:
   /// Merge the sets containing i1 and i2. Does nothing if i1 and i2 are already in the same set.
   void merge(const size_t& i1, const size_t& i2);
 
+  /**
+   * Label every node with its set representative, i.e. connected-component
+   * labeling over all merges so far.  Runs pointer-jumping rounds over the
+   * parent vector, parallelized with TBB when available, so large forests
+   * are labeled in O(n log d / p) instead of one find() per node.
+   */
+  V componentLabels() const;
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   inline size_t findSet(size_t key) const {return find(key);}
   inline void makeUnionInPlace(const size_t& i1, const size_t& i2) {return merge(i1,i2);}
@@ -96,4 +104,39 @@ public:
   std::map<size_t, std::vector<size_t> > arrays() const;
 };
 
+/**
+ * Flat-array union-find with path halving and union by rank.  Unlike DSFMap,
+ * which allocates a tree node per key inside a std::map, all state lives in
+ * two contiguous vectors, so merging millions of feature-track observations
+ * runs at memory bandwidth instead of pointer-chasing speed.  Keys are dense
+ * size_t indices; the arrays grow on demand when merging past the current
+ * size.
+ * @addtogroup base
+ */
+class GTSAM_EXPORT DSFFlat {
+
+private:
+  mutable std::vector<size_t> parent_; ///< mutated by path halving in find()
+  std::vector<size_t> rank_;
+
+public:
+  /// Constructor, allows for keys 0...numNodes-1; more may be added by merge.
+  explicit DSFFlat(const size_t numNodes = 0);
+
+  /// Number of nodes seen so far.
+  size_t size() const { return parent_.size(); }
+
+  /// Find the label of the set in which {key} lives, with path halving.
+  size_t find(size_t key) const;
+
+  /// Merge the sets containing i1 and i2, by rank; grows the arrays if needed.
+  void merge(size_t i1, size_t i2);
+
+  /// Bulk merge: grows the arrays once for the largest key, then merges all pairs.
+  void merge(const std::vector<std::pair<size_t, size_t> >& pairs);
+
+  /// Return all sets, i.e. a partition of all elements.
+  std::map<size_t, std::set<size_t> > sets() const;
+};
+
 }
@@ -24,13 +24,39 @@
 
 #include <boost/make_shared.hpp>
 #include <boost/pool/pool_alloc.hpp>
+#include <boost/pool/singleton_pool.hpp>
 
 #include <cmath>
 #include <iostream>
+#include <new> // operator new, std::bad_alloc
 #include <typeinfo> // operator typeid
 
 namespace gtsam {
 
+namespace internal {
+
+/**
+ * Boost pool UserAllocator that obtains its blocks through Eigen's aligned
+ * allocation.  Pool chunks are carved at multiples of the element size from
+ * the start of a block, and the element size is always a multiple of the
+ * element alignment, so an aligned block start makes every chunk satisfy the
+ * alignment of fixed-size vectorizable Eigen members.
+ */
+struct AlignedPoolAllocator {
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  static char* malloc BOOST_PREVENT_MACRO_SUBSTITUTION(const size_type bytes) {
+    return static_cast<char*>(Eigen::internal::aligned_malloc(bytes));
+  }
+
+  static void free BOOST_PREVENT_MACRO_SUBSTITUTION(char* const block) {
+    Eigen::internal::aligned_free(block);
+  }
+};
+
+} // \namespace internal
+
 /**
  * Wraps any type T so it can play as a Value
  */
@@ -177,10 +203,46 @@ public:
 	}
 
 
-  // Alignment, see https://eigen.tuxfamily.org/dox/group__TopicStructHavingEigenMembers.html
-  enum { NeedsToAlign = (sizeof(T) % 16) == 0 };
-public:
-  EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(NeedsToAlign)
+  public:
+
+    /// @name Type-segregated pooled allocation
+    /// @{
+
+    /**
+     * All GenericValue of one wrapped type share a boost singleton_pool, so
+     * the values held by a Values container cluster by type in contiguous
+     * chunks instead of scattering across the general-purpose heap, and the
+     * per-iteration retract/localCoordinates sweep over a Values walks
+     * nearly consecutive memory.  The pool also serves the aligned
+     * allocation that EIGEN_MAKE_ALIGNED_OPERATOR_NEW provided here before,
+     * see internal::AlignedPoolAllocator.
+     */
+    static void* operator new(size_t size) {
+      typedef boost::singleton_pool<GenericValue, sizeof(GenericValue),
+          internal::AlignedPoolAllocator> Pool;
+      if (size != sizeof(GenericValue)) // derived type, chunks do not fit
+        return ::operator new(size);
+      void* result = Pool::malloc();
+      if (!result)
+        throw std::bad_alloc();
+      return result;
+    }
+
+    /// Return memory to the pool; the chunk stays reserved for this type
+    static void operator delete(void* p, size_t size) {
+      typedef boost::singleton_pool<GenericValue, sizeof(GenericValue),
+          internal::AlignedPoolAllocator> Pool;
+      if (size != sizeof(GenericValue))
+        ::operator delete(p);
+      else if (p)
+        Pool::free(p);
+    }
+
+    /// Placement forms, otherwise hidden by the overloads above
+    static void* operator new(size_t, void* place) { return place; }
+    static void operator delete(void*, void*) {}
+
+    /// @}
 };
 
 /// use this macro instead of BOOST_CLASS_EXPORT for GenericValues
@@ -17,6 +17,7 @@
 
 #include <gtsam/global_includes.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/smallKernels.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/FastList.h>
@@ -374,8 +375,11 @@ Vector backSubstituteUpper(const Matrix& U, const Vector& b, bool unit) {
   assert(U.rows() == U.cols());
   if (unit)
     return U.triangularView<Eigen::UnitUpper>().solve(b);
-  else
-    return U.triangularView<Eigen::Upper>().solve(b);
+  // The non-unit path dominates; it dispatches to the fixed-size kernels
+  // for the common 3- and 6-dimensional systems
+  Vector x = b;
+  kernels::solveUpperInPlace(U, x);
+  return x;
 }
 
 /* ************************************************************************* */
@@ -483,8 +487,9 @@ void vector_scale_inplace(const Vector& v, Matrix& A, bool inf_mask) {
         A.row(i) *= vi;
     }
   } else {
-    for (DenseIndex i=0; i<m; ++i)
-      A.row(i) *= v(i);
+    // Columnwise array product vectorizes over whole columns, unlike the
+    // row-at-a-time loop above which strides across the column-major storage
+    A.array().colwise() *= v.array();
   }
 }
 
@@ -633,15 +638,38 @@ void inplace_QR(Matrix& A){
   size_t cols = A.cols();
   size_t size = std::min(rows,cols);
 
+  // Skip leading columns that already have zeros below the diagonal, so
+  // inputs that are already (partially) upper-triangular - e.g. factors that
+  // are the result of a previous elimination - only pay for the trailing
+  // block, and a fully triangular input terminates immediately.
+  size_t startCol = 0;
+  while (startCol < size && A.col(startCol).tail(rows - startCol - 1).isZero(0.0))
+    ++startCol;
+  if (startCol == size) {
+    zeroBelowDiagonal(A);
+    return;
+  }
+
   typedef Eigen::internal::plain_diag_type<Matrix>::type HCoeffsType;
   typedef Eigen::internal::plain_row_type<Matrix>::type RowVectorType;
-  HCoeffsType hCoeffs(size);
-  RowVectorType temp(cols);
+
+  // Reuse the Householder coefficient and transformation workspace across
+  // calls; the buffers only grow when a larger system than any previous one
+  // on this thread is factorized.
+  static thread_local HCoeffsType hCoeffs;
+  static thread_local RowVectorType temp;
+  if (hCoeffs.size() < static_cast<DenseIndex>(size))
+    hCoeffs.resize(size);
+  if (temp.size() < static_cast<DenseIndex>(cols))
+    temp.resize(cols);
+
+  Eigen::Block<Matrix> Ablock =
+      A.block(startCol, startCol, rows - startCol, cols - startCol);
 
 #if !EIGEN_VERSION_AT_LEAST(3,2,5)
-  Eigen::internal::householder_qr_inplace_blocked<Matrix, HCoeffsType>(A, hCoeffs, 48, temp.data());
+  Eigen::internal::householder_qr_inplace_blocked<Eigen::Block<Matrix>, HCoeffsType>(Ablock, hCoeffs, 48, temp.data());
 #else
-  Eigen::internal::householder_qr_inplace_blocked<Matrix, HCoeffsType>::run(A, hCoeffs, 48, temp.data());
+  Eigen::internal::householder_qr_inplace_blocked<Eigen::Block<Matrix>, HCoeffsType>::run(Ablock, hCoeffs, 48, temp.data());
 #endif
 
   zeroBelowDiagonal(A);
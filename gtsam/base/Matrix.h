@@ -71,6 +71,11 @@ GTSAM_MAKE_MATRIX_DEFS(7);
 GTSAM_MAKE_MATRIX_DEFS(8);
 GTSAM_MAKE_MATRIX_DEFS(9);
 
+// Matrices with a fixed number of rows and a dynamic number of columns,
+// e.g. to hold a batch of 3D points as columns
+typedef Eigen::Matrix<double, 2, Eigen::Dynamic> Matrix2X;
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+
 // Matrix expressions for accessing parts of matrices
 typedef Eigen::Block<Matrix> SubMatrix;
 typedef Eigen::Block<const Matrix> ConstSubMatrix;
@@ -0,0 +1,177 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MemoryArena.h
+ * @brief   A resettable bump allocator for short-lived, batch-freed objects
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/base/types.h>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A simple chunked bump ("arena") allocator.  Memory is carved sequentially
+ * out of large blocks; individual deallocation is a no-op and all memory is
+ * reclaimed at once by reset(), which is O(number of blocks) and keeps the
+ * blocks around for reuse.  This is intended for allocation patterns like the
+ * per-iteration linearized factor graph in the nonlinear optimizers, where
+ * thousands of small objects are created together and discarded together.
+ *
+ * Not thread-safe: concurrent allocation from one arena requires external
+ * synchronization.  Objects allocated from the arena must not outlive the
+ * next call to reset() or the arena itself.
+ */
+class MemoryArena {
+public:
+  /// Default size of each underlying block, 1 MB
+  static const size_t kDefaultBlockSize = 1024 * 1024;
+
+  /// Construct an empty arena; the first block is allocated lazily
+  explicit MemoryArena(size_t blockSize = kDefaultBlockSize)
+      : blockSize_(blockSize), currentBlock_(0), currentOffset_(0) {}
+
+  /// Allocate \c bytes with the given alignment, growing the arena if needed
+  void* allocate(size_t bytes, size_t alignment = sizeof(void*)) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    if (bytes == 0) bytes = 1;
+    while (currentBlock_ < blocks_.size()) {
+      Block& block = blocks_[currentBlock_];
+      const size_t aligned = alignUp(currentOffset_, alignment);
+      if (aligned + bytes <= block.size) {
+        currentOffset_ = aligned + bytes;
+        return block.data.get() + aligned;
+      }
+      // current block exhausted, move on (offset restarts in the next block)
+      ++currentBlock_;
+      currentOffset_ = 0;
+    }
+    // no existing block fits: allocate a new one large enough
+    addBlock(bytes > blockSize_ ? bytes : blockSize_);
+    currentOffset_ = bytes;
+    return blocks_.back().data.get();
+  }
+
+  /// Reclaim all allocations at once, keeping the blocks for reuse
+  void reset() {
+    currentBlock_ = 0;
+    currentOffset_ = 0;
+  }
+
+  /// Total bytes of block storage owned by the arena
+  size_t capacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks_) total += block.size;
+    return total;
+  }
+
+  /// Number of underlying blocks
+  size_t blockCount() const { return blocks_.size(); }
+
+private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  static size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+  }
+
+  void addBlock(size_t size) {
+    Block block;
+    block.data.reset(new char[size]);
+    block.size = size;
+    blocks_.push_back(std::move(block));
+    currentBlock_ = blocks_.size() - 1;
+    currentOffset_ = 0;
+  }
+
+  size_t blockSize_;          ///< preferred size of newly allocated blocks
+  std::vector<Block> blocks_; ///< owned storage, never shrunk before destruction
+  size_t currentBlock_;       ///< block we are currently bumping into
+  size_t currentOffset_;      ///< bump pointer within the current block
+
+  // Arena owns raw storage handed out to others, so forbid copies
+  MemoryArena(const MemoryArena&);
+  MemoryArena& operator=(const MemoryArena&);
+};
+
+/**
+ * Standard-library-compatible allocator drawing from a MemoryArena.
+ * deallocate() is a no-op; destructors still run normally, so types owning
+ * external resources (e.g. Eigen matrices) release those on destruction while
+ * the node memory itself is reclaimed in bulk by MemoryArena::reset().
+ * Usable with boost::allocate_shared to place both object and shared_ptr
+ * control block in the arena with a single bump allocation.
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename U>
+  struct rebind { typedef ArenaAllocator<U> other; };
+
+  explicit ArenaAllocator(MemoryArena& arena) : arena_(&arena) {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  pointer allocate(size_type n) {
+    return static_cast<pointer>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(pointer, size_type) {
+    // Individual deallocation is a no-op, memory is reclaimed by reset()
+  }
+
+  template<typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template<typename U>
+  void destroy(U* p) { p->~U(); }
+
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+  MemoryArena* arena() const { return arena_; }
+
+private:
+  MemoryArena* arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() != b.arena();
+}
+
+} // namespace gtsam
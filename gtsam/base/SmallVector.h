@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SmallVector.h
+ * @brief   A vector with small-buffer optimization for short sequences
+ * @author  Richard Roberts
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+
+namespace gtsam {
+
+/**
+ * SmallVector stores its first N elements (4 by default) inline, falling back
+ * to the heap only when it grows past that.  Most key lists and per-clique
+ * scratch collections in GTSAM have 1-3 entries, so the common case performs
+ * no allocation at all - cheaper and more cache-friendly than any pool, and
+ * with nothing allocated there is no allocator to contend on in parallel
+ * sections.
+ *
+ * Unlike FastVector this is not a std::vector, so it cannot be passed to APIs
+ * that take std::vector by reference; use it for internal scratch storage
+ * that is only iterated and indexed.
+ * @addtogroup base
+ */
+template <typename T, std::size_t N = 4>
+using SmallVector = boost::container::small_vector<T, N>;
+
+}  // namespace gtsam
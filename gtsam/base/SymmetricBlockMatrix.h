@@ -22,9 +22,13 @@
 #include <gtsam/base/types.h>
 #include <gtsam/dllexport.h>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 #include <cassert>
 #include <stdexcept>
 #include <array>
+#include <utility>
 
 namespace boost {
 namespace serialization {
@@ -105,6 +109,19 @@ namespace gtsam {
       assertInvariants();
     }
 
+    /// Construct from a container of the sizes of each vertical block, taking ownership of a
+    /// pre-allocated matrix (e.g. recycled through EliminationWorkspace).  The matrix is resized
+    /// if its dimensions do not already match; its contents are left uninitialized either way.
+    template<typename CONTAINER>
+    SymmetricBlockMatrix(const CONTAINER& dimensions, Matrix&& matrix, bool appendOneDimension = false) :
+      matrix_(std::move(matrix)), blockStart_(0)
+    {
+      fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
+      if(matrix_.rows() != variableColOffsets_.back() || matrix_.cols() != variableColOffsets_.back())
+        matrix_.resize(variableColOffsets_.back(), variableColOffsets_.back());
+      assertInvariants();
+    }
+
     /// Copy the block structure, but do not copy the matrix data.  If blockStart() has been
     /// modified, this copies the structure of the corresponding matrix view. In the destination
     /// SymmetricBlockMatrix, blockStart() will be 0.
@@ -279,6 +296,55 @@ namespace gtsam {
               .triangularView<Eigen::Upper>();
     }
 
+    /// @}
+    /// @name Unchecked raw block access.
+    /// @{
+
+    /** A raw, unchecked view of one block: a bare pointer into the
+     *  column-major storage plus the leading dimension.  Intended for hot
+     *  loops - e.g. the block adds in updateHessian - that cannot afford the
+     *  checked accessors.  The caller is responsible for valid block indices
+     *  and, for the symmetric storage, for writing only the upper triangle. */
+    struct RawBlock {
+      double* data;     ///< pointer to the (0,0) entry of the block
+      DenseIndex rows;  ///< block row count
+      DenseIndex cols;  ///< block column count
+      DenseIndex ld;    ///< leading dimension (column stride) of the storage
+
+      typedef Eigen::Map<Matrix, Eigen::Unaligned, Eigen::OuterStride<> > Map;
+
+      /// View the raw block as a writable Eigen expression
+      Map map() const { return Map(data, rows, cols, Eigen::OuterStride<>(ld)); }
+    };
+
+    /// Read-only counterpart of RawBlock.
+    struct ConstRawBlock {
+      const double* data;
+      DenseIndex rows;
+      DenseIndex cols;
+      DenseIndex ld;
+
+      typedef Eigen::Map<const Matrix, Eigen::Unaligned, Eigen::OuterStride<> > Map;
+
+      /// View the raw block as a read-only Eigen expression
+      Map map() const { return Map(data, rows, cols, Eigen::OuterStride<>(ld)); }
+    };
+
+    /// Raw writable view of block (I, J), computed straight from the flat
+    /// offset table with no bounds checks.
+    RawBlock rawBlock(DenseIndex I, DenseIndex J) {
+      const DenseIndex i = offset(I), j = offset(J);
+      return RawBlock{matrix_.data() + j * matrix_.rows() + i,
+                      offset(I + 1) - i, offset(J + 1) - j, matrix_.rows()};
+    }
+
+    /// Raw read-only view of block (I, J).
+    ConstRawBlock rawBlock(DenseIndex I, DenseIndex J) const {
+      const DenseIndex i = offset(I), j = offset(J);
+      return ConstRawBlock{matrix_.data() + j * matrix_.rows() + i,
+                           offset(I + 1) - i, offset(J + 1) - j, matrix_.rows()};
+    }
+
     /// @}
 
     /// Retrieve or modify the first logical block, i.e. the block referenced by block index 0.
@@ -290,6 +356,12 @@ namespace gtsam {
     /// it will be inaccessible, except by accessing the underlying matrix using matrix().
     DenseIndex blockStart() const { return blockStart_; }
 
+    /// Access the full underlying matrix directly, ignoring blockStart().
+    const Matrix& matrix() const { return matrix_; }
+
+    /// Access the full underlying matrix directly, ignoring blockStart().
+    Matrix& matrix() { return matrix_; }
+
     /**
      * Given the augmented Hessian [A1'A1 A1'A2 A1'b
      *                              A2'A1 A2'A2 A2'b
@@ -398,18 +470,45 @@ namespace gtsam {
     template<typename SymmetricBlockMatrixType> friend class SymmetricBlockMatrixBlockExpr;
 
   private:
-    /** Serialization function */
+    /** Serialization functions.  The matrix buffer (through the Matrix
+     * overload) and the offset array are archived as primitive arrays, which
+     * binary archives stream as one bulk write each instead of one archive
+     * call per element. */
     friend class boost::serialization::access;
     template<class ARCHIVE>
-    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    void save(ARCHIVE & ar, const unsigned int /*version*/) const {
       // Fill in the lower triangle part of the matrix, so boost::serialization won't
       // complain about uninitialized data with an input_stream_error exception
       // http://www.boost.org/doc/libs/1_37_0/libs/serialization/doc/exceptions.html#stream_error
-      matrix_.triangularView<Eigen::Lower>() = matrix_.triangularView<Eigen::Upper>().transpose();
-      ar & BOOST_SERIALIZATION_NVP(matrix_);
-      ar & BOOST_SERIALIZATION_NVP(variableColOffsets_);
-      ar & BOOST_SERIALIZATION_NVP(blockStart_);
+      Matrix matrix = matrix_;
+      matrix.triangularView<Eigen::Lower>() =
+          matrix_.triangularView<Eigen::Upper>().transpose();
+      ar << boost::serialization::make_nvp("matrix_", matrix);
+      const uint64_t offsetCount = variableColOffsets_.size();
+      ar << BOOST_SERIALIZATION_NVP(offsetCount);
+      ar << boost::serialization::make_nvp("variableColOffsets_",
+          boost::serialization::make_array(variableColOffsets_.data(),
+              variableColOffsets_.size()));
+      ar << BOOST_SERIALIZATION_NVP(blockStart_);
+    }
+    template<class ARCHIVE>
+    void load(ARCHIVE & ar, const unsigned int version) {
+      ar >> BOOST_SERIALIZATION_NVP(matrix_);
+      if (version < 1) {
+        // Archives written before the bulk encoding store the offsets with
+        // the regular vector serializer
+        ar >> BOOST_SERIALIZATION_NVP(variableColOffsets_);
+      } else {
+        uint64_t offsetCount = 0;
+        ar >> BOOST_SERIALIZATION_NVP(offsetCount);
+        variableColOffsets_.resize(offsetCount);
+        ar >> boost::serialization::make_nvp("variableColOffsets_",
+            boost::serialization::make_array(variableColOffsets_.data(),
+                variableColOffsets_.size()));
+      }
+      ar >> BOOST_SERIALIZATION_NVP(blockStart_);
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
   };
 
   /// Foward declare exception class
@@ -417,3 +516,5 @@ namespace gtsam {
 
 }
 
+BOOST_CLASS_VERSION(gtsam::SymmetricBlockMatrix, 1)
+
@@ -20,6 +20,12 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/FastVector.h>
 
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+
+#include <utility>
+
 namespace gtsam {
 
   // Forward declarations
@@ -53,11 +59,14 @@ namespace gtsam {
     DenseIndex rowEnd_; ///< Changes apparent matrix view, see main class comment.
     DenseIndex blockStart_; ///< Changes apparent matrix view, see main class comment.
 
+    mutable MatrixRowMajor rowMajorMirror_; ///< Lazy row-major copy, see rowMajorMirror()
+    mutable bool rowMajorValid_; ///< Whether rowMajorMirror_ reflects matrix_
+
   public:
 
     /** Construct an empty VerticalBlockMatrix */
     VerticalBlockMatrix() :
-      rowStart_(0), rowEnd_(0), blockStart_(0)
+      rowStart_(0), rowEnd_(0), blockStart_(0), rowMajorValid_(false)
     {
       variableColOffsets_.push_back(0);
       assertInvariants();
@@ -68,7 +77,7 @@ namespace gtsam {
     VerticalBlockMatrix(const CONTAINER& dimensions, DenseIndex height,
         bool appendOneDimension = false) :
         variableColOffsets_(dimensions.size() + (appendOneDimension ? 2 : 1)),
-        rowStart_(0), rowEnd_(height), blockStart_(0) {
+        rowStart_(0), rowEnd_(height), blockStart_(0), rowMajorValid_(false) {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
       matrix_.resize(height, variableColOffsets_.back());
       assertInvariants();
@@ -79,7 +88,7 @@ namespace gtsam {
     VerticalBlockMatrix(const CONTAINER& dimensions,
         const Eigen::MatrixBase<DERIVED>& matrix, bool appendOneDimension = false) :
         matrix_(matrix), variableColOffsets_(dimensions.size() + (appendOneDimension ? 2 : 1)),
-        rowStart_(0), rowEnd_(matrix.rows()), blockStart_(0) {
+        rowStart_(0), rowEnd_(matrix.rows()), blockStart_(0), rowMajorValid_(false) {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
       if (variableColOffsets_.back() != matrix_.cols())
         throw std::invalid_argument(
@@ -87,12 +96,27 @@ namespace gtsam {
       assertInvariants();
     }
 
+    /** Construct from a container of the sizes of each vertical block, taking ownership of a
+     *  pre-allocated matrix (e.g. recycled through EliminationWorkspace).  The matrix is resized
+     *  if its dimensions do not already match; its contents are left uninitialized either way. */
+    template<typename CONTAINER>
+    VerticalBlockMatrix(const CONTAINER& dimensions, DenseIndex height, Matrix&& matrix,
+        bool appendOneDimension = false) :
+        matrix_(std::move(matrix)),
+        variableColOffsets_(dimensions.size() + (appendOneDimension ? 2 : 1)),
+        rowStart_(0), rowEnd_(height), blockStart_(0), rowMajorValid_(false) {
+      fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
+      if (matrix_.rows() != height || matrix_.cols() != variableColOffsets_.back())
+        matrix_.resize(height, variableColOffsets_.back());
+      assertInvariants();
+    }
+
     /** Construct from iterator over the sizes of each vertical block. */
     template<typename ITERATOR>
     VerticalBlockMatrix(ITERATOR firstBlockDim, ITERATOR lastBlockDim,
         DenseIndex height, bool appendOneDimension = false) :
         variableColOffsets_((lastBlockDim-firstBlockDim) + (appendOneDimension ? 2 : 1)),
-        rowStart_(0), rowEnd_(height), blockStart_(0) {
+        rowStart_(0), rowEnd_(height), blockStart_(0), rowMajorValid_(false) {
       fillOffsets(firstBlockDim, lastBlockDim, appendOneDimension);
       matrix_.resize(height, variableColOffsets_.back());
       assertInvariants();
@@ -128,6 +152,7 @@ namespace gtsam {
     /** access ranges of blocks at a time */
     Block range(DenseIndex startBlock, DenseIndex endBlock) {
       assertInvariants();
+      rowMajorValid_ = false; // handing out write access invalidates the mirror
       DenseIndex actualStartBlock = startBlock + blockStart_;
       DenseIndex actualEndBlock = endBlock + blockStart_;
       if(startBlock != 0 || endBlock != 0) {
@@ -187,7 +212,25 @@ namespace gtsam {
     const Matrix& matrix() const { return matrix_; }
 
     /** Non-const access to full matrix (*including* any portions excluded by rowStart(), rowEnd(), and firstBlock()) */
-    Matrix& matrix() { return matrix_; }
+    Matrix& matrix() { rowMajorValid_ = false; return matrix_; }
+
+    /**
+     * Row-major copy of the underlying matrix, refreshed lazily: the first
+     * call after any write copies matrix_, later calls return the cached
+     * mirror.  Together with the column-major original this gives products
+     * a cache-friendly layout in both directions - row-streaming A*x from
+     * the mirror, column-streaming A'*e from matrix_ - which is what the
+     * CG operator does every iteration (see JacobianFactor::operator* and
+     * transposeMultiplyAdd).  The mirror is invalidated when write access
+     * is handed out, so do not hold a writable Block across calls.
+     */
+    const MatrixRowMajor& rowMajorMirror() const {
+      if (!rowMajorValid_) {
+        rowMajorMirror_ = matrix_;
+        rowMajorValid_ = true;
+      }
+      return rowMajorMirror_;
+    }
 
   protected:
     void assertInvariants() const {
@@ -218,16 +261,46 @@ namespace gtsam {
     friend class SymmetricBlockMatrix;
 
   private:
-    /** Serialization function */
+    /** Serialization functions.  The matrix buffer (through the Matrix
+     * overload) and the offset array are archived as primitive arrays, which
+     * binary archives stream as one bulk write each instead of one archive
+     * call per element. */
     friend class boost::serialization::access;
     template<class ARCHIVE>
-    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
-      ar & BOOST_SERIALIZATION_NVP(matrix_);
-      ar & BOOST_SERIALIZATION_NVP(variableColOffsets_);
-      ar & BOOST_SERIALIZATION_NVP(rowStart_);
-      ar & BOOST_SERIALIZATION_NVP(rowEnd_);
-      ar & BOOST_SERIALIZATION_NVP(blockStart_);
+    void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+      ar << BOOST_SERIALIZATION_NVP(matrix_);
+      const uint64_t offsetCount = variableColOffsets_.size();
+      ar << BOOST_SERIALIZATION_NVP(offsetCount);
+      ar << boost::serialization::make_nvp("variableColOffsets_",
+          boost::serialization::make_array(variableColOffsets_.data(),
+              variableColOffsets_.size()));
+      ar << BOOST_SERIALIZATION_NVP(rowStart_);
+      ar << BOOST_SERIALIZATION_NVP(rowEnd_);
+      ar << BOOST_SERIALIZATION_NVP(blockStart_);
     }
+    template<class ARCHIVE>
+    void load(ARCHIVE & ar, const unsigned int version) {
+      ar >> BOOST_SERIALIZATION_NVP(matrix_);
+      if (version < 1) {
+        // Archives written before the bulk encoding store the offsets with
+        // the regular vector serializer
+        ar >> BOOST_SERIALIZATION_NVP(variableColOffsets_);
+      } else {
+        uint64_t offsetCount = 0;
+        ar >> BOOST_SERIALIZATION_NVP(offsetCount);
+        variableColOffsets_.resize(offsetCount);
+        ar >> boost::serialization::make_nvp("variableColOffsets_",
+            boost::serialization::make_array(variableColOffsets_.data(),
+                variableColOffsets_.size()));
+      }
+      ar >> BOOST_SERIALIZATION_NVP(rowStart_);
+      ar >> BOOST_SERIALIZATION_NVP(rowEnd_);
+      ar >> BOOST_SERIALIZATION_NVP(blockStart_);
+      rowMajorValid_ = false; // the mirror is never archived
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
   };
 
 }
+
+BOOST_CLASS_VERSION(gtsam::VerticalBlockMatrix, 1)
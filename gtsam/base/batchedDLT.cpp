@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    batchedDLT.cpp
+ * @brief   Batched homogeneous least-squares solves for small fixed sizes
+ */
+
+#include <gtsam/base/batchedDLT.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+namespace {
+
+// Fixed-size path: eigendecompose the P x P normal matrix.  The singular
+// values of A are the square roots of the eigenvalues of A'A, and the right
+// singular vector of the smallest one is its eigenvector.
+template <int P>
+boost::tuple<int, double, Vector> solveFixed(const Matrix& A,
+    double rank_tol) {
+  typedef Eigen::Matrix<double, P, P> MatrixP;
+  MatrixP N;
+  N.noalias() = A.transpose() * A;
+  const Eigen::SelfAdjointEigenSolver<MatrixP> eig(N);
+
+  // Eigenvalues of A'A sit on a round-off floor of eps * lambda_max, which
+  // sqrt would inflate to ~1e-8 relative - large enough to beat typical
+  // rank tolerances.  Clamp eigenvalues below the floor to zero so exact
+  // rank deficiencies are reported as such, like the SVD does.
+  const double floor = Eigen::NumTraits<double>::epsilon()
+      * std::max(eig.eigenvalues()(P - 1), 0.0);
+  const auto singularValue = [&eig, floor](int j) {
+    const double lambda = eig.eigenvalues()(j);
+    return lambda <= floor ? 0.0 : std::sqrt(lambda);
+  };
+
+  // Eigenvalues come out ascending; count singular values above tolerance
+  const size_t m = std::min(size_t(A.rows()), size_t(P));
+  int rank = 0;
+  for (size_t j = P - m; j < size_t(P); j++)
+    if (singularValue(j) > rank_tol)
+      rank++;
+
+  const double error = m < size_t(P) ? 0.0 : singularValue(0);
+  return boost::tuple<int, double, Vector>(rank, error,
+      Vector(eig.eigenvectors().col(0)));
+}
+
+} // namespace
+
+/* ************************************************************************* */
+boost::tuple<int, double, Vector> DLTSmall(const Matrix& A, double rank_tol) {
+  switch (A.cols()) {
+  case 4: return solveFixed<4>(A, rank_tol);
+  case 5: return solveFixed<5>(A, rank_tol);
+  case 6: return solveFixed<6>(A, rank_tol);
+  case 7: return solveFixed<7>(A, rank_tol);
+  case 8: return solveFixed<8>(A, rank_tol);
+  case 9: return solveFixed<9>(A, rank_tol);
+  default: return DLT(A, rank_tol);
+  }
+}
+
+/* ************************************************************************* */
+std::vector<boost::tuple<int, double, Vector> > DLTBatch(
+    const std::vector<Matrix>& systems, double rank_tol) {
+  std::vector<boost::tuple<int, double, Vector> > results(systems.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(size_t(0), systems.size(), [&](size_t i) {
+    results[i] = DLTSmall(systems[i], rank_tol);
+  });
+#else
+  for (size_t i = 0; i < systems.size(); ++i)
+    results[i] = DLTSmall(systems[i], rank_tol);
+#endif
+  return results;
+}
+
+/* ************************************************************************* */
+} // namespace gtsam
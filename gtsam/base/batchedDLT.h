@@ -0,0 +1,54 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    batchedDLT.h
+ * @brief   Batched homogeneous least-squares solves for small fixed sizes
+ * @author  Frank Dellaert
+ *
+ * Triangulation and per-landmark calibration refinement solve thousands of
+ * independent homogeneous systems min |Ax|, |x|=1, each with 4..9 columns.
+ * The generic DLT in Matrix.h runs a dynamic-size Jacobi SVD per system;
+ * here the dominant shapes instead form the p x p normal matrix A'A and
+ * take its smallest eigenvector with a fixed-size self-adjoint
+ * eigensolver, which unrolls and vectorizes, and whole batches are solved
+ * with one TBB parallel loop over the independent systems.  Forming A'A
+ * squares the condition number, which is harmless at the rank tolerances
+ * used in triangulation (~1e-9 on well-scaled DLT rows).
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <boost/tuple/tuple.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Single homogeneous solve with the same contract as DLT in Matrix.h:
+ * returns (rank, smallest singular value, unit null vector of A).  Systems
+ * with 4..9 columns take the fixed-size normal-matrix path; other shapes
+ * fall back to the SVD-based DLT.  When A is rank deficient by more than
+ * one, the returned vector is some unit vector of the nullspace, not
+ * necessarily the one the SVD would pick.
+ */
+GTSAM_EXPORT boost::tuple<int, double, Vector> DLTSmall(const Matrix& A,
+    double rank_tol = 1e-9);
+
+/**
+ * Solve a batch of independent homogeneous systems, one DLTSmall result
+ * per input system, parallelized over the batch with TBB when enabled.
+ */
+GTSAM_EXPORT std::vector<boost::tuple<int, double, Vector> > DLTBatch(
+    const std::vector<Matrix>& systems, double rank_tol = 1e-9);
+
+} // namespace gtsam
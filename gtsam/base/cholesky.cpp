@@ -18,7 +18,13 @@
  */
 
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/smallKernels.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/format.hpp>
 #include <cmath>
@@ -32,6 +38,19 @@ static const double zeroPivotThreshold = 1e-6;
 static const double underconstrainedPrior = 1e-5;
 static const int underconstrainedExponentDifference = 12;
 
+size_t choleskyPartialParallelThreshold = 512;
+
+/* ************************************************************************* */
+size_t denseCholeskyBackendThreshold = 4096;
+
+static DenseCholeskyBackend* denseCholeskyBackend = 0;
+
+DenseCholeskyBackend* setDenseCholeskyBackend(DenseCholeskyBackend* backend) {
+  DenseCholeskyBackend* previous = denseCholeskyBackend;
+  denseCholeskyBackend = backend;
+  return previous;
+}
+
 /* ************************************************************************* */
 static inline int choleskyStep(Matrix& ATA, size_t k, size_t order) {
   // Get pivot value
@@ -104,12 +123,70 @@ pair<size_t, bool> choleskyCareful(Matrix& ATA, int order) {
   return make_pair(maxrank, success);
 }
 
+/* ************************************************************************* */
+#ifdef GTSAM_USE_TBB
+namespace {
+
+// Tiled right-looking Cholesky of the upper triangle of A, A = R'*R with R
+// stored in the upper triangle.  Per tile column: factor the diagonal tile,
+// triangular-solve the row panel, then rank-update the trailing tiles in
+// parallel, one TBB task per trailing tile column.  Returns false if a
+// diagonal tile is not positive-definite, like Eigen::LLT.
+bool blockedUpperCholesky(Eigen::Block<Matrix> A, size_t tileSize) {
+  const size_t m = static_cast<size_t>(A.rows());
+  for (size_t k = 0; k < m; k += tileSize) {
+    const size_t ks = std::min(tileSize, m - k);
+
+    // Factor diagonal tile
+    auto Akk = A.block(k, k, ks, ks);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(Akk);
+    if (llt.info() != Eigen::Success)
+      return false;
+    Akk.triangularView<Eigen::Upper>() = llt.matrixU();
+
+    const size_t rest = m - (k + ks);
+    if (rest == 0)
+      continue;
+
+    // Row panel S = inv(Rkk') * B, overwrites the panel
+    auto panel = A.block(k, k + ks, ks, rest);
+    Akk.triangularView<Eigen::Upper>().transpose().solveInPlace(panel);
+
+    // Trailing update C -= S'*S, each task owns one trailing tile column so
+    // writes never overlap and no locking is needed
+    const size_t numTiles = (rest + tileSize - 1) / tileSize;
+    tbb::parallel_for(size_t(0), numTiles, [&](size_t tj) {
+      const size_t j = k + ks + tj * tileSize;
+      const size_t js = std::min(tileSize, m - j);
+      const auto Sj = A.block(k, j, ks, js);
+      // Off-diagonal tiles above the diagonal tile of this column
+      for (size_t i = k + ks; i < j; i += tileSize) {
+        const size_t is = std::min(tileSize, m - i);
+        A.block(i, j, is, js).noalias() -= A.block(k, i, ks, is).transpose() * Sj;
+      }
+      // Diagonal tile, update upper triangle only
+      A.block(j, j, js, js).selfadjointView<Eigen::Upper>().rankUpdate(
+          Sj.transpose(), -1.0);
+    });
+  }
+  return true;
+}
+
+}
+#endif
+
 /* ************************************************************************* */
 bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   gttic(choleskyPartial);
   if (nFrontal == 0)
     return true;
 
+  // Route very large frontal blocks to the installed backend, if any
+  if (denseCholeskyBackend && nFrontal >= denseCholeskyBackendThreshold) {
+    gttic(backend);
+    return denseCholeskyBackend->choleskyPartial(ABC, nFrontal, topleft);
+  }
+
   assert(ABC.cols() == ABC.rows());
   assert(size_t(ABC.rows()) >= topleft);
   const size_t n = static_cast<size_t>(ABC.rows() - topleft);
@@ -122,12 +199,22 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
 
   // Compute Cholesky factorization A = R'*R, overwrites A.
   gttic(LLT);
-  Eigen::LLT<Matrix, Eigen::Upper> llt(A);
-  Eigen::ComputationInfo lltResult = llt.info();
-  if (lltResult != Eigen::Success)
-    return false;
+#ifdef GTSAM_USE_TBB
+  if (nFrontal >= choleskyPartialParallelThreshold) {
+    // Large frontal blocks from heavy fill-in: use the tiled parallel version
+    static const size_t tileSize = 128;
+    if (!blockedUpperCholesky(A, tileSize))
+      return false;
+  } else
+#endif
+  {
+    Eigen::LLT<Matrix, Eigen::Upper> llt(A);
+    Eigen::ComputationInfo lltResult = llt.info();
+    if (lltResult != Eigen::Success)
+      return false;
+    A.triangularView<Eigen::Upper>() = llt.matrixU();
+  }
   auto R = A.triangularView<Eigen::Upper>();
-  R = llt.matrixU();
   gttoc(LLT);
 
   // Compute S = inv(R') * B
@@ -136,10 +223,11 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
     R.transpose().solveInPlace(B);
   gttoc(compute_S);
 
-  // Compute L = C - S' * S
+  // Compute L = C - S' * S; the fixed-size kernel kicks in for the common
+  // 3- and 6-dimensional frontal blocks
   gttic(compute_L);
   if (nFrontal < n)
-    C.selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
+    kernels::rankUpdateUpper(C, B, -1.0);
   gttoc(compute_L);
 
   // Check last diagonal element - Eigen does not check it
@@ -62,5 +62,51 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft=0);
 
+/**
+ * Frontal dimension at or above which choleskyPartial switches to a tiled,
+ * multithreaded factorization of the frontal block (only when GTSAM is
+ * compiled with TBB; without TBB this value has no effect).  Small cliques
+ * keep the existing single-threaded Eigen code, which is faster there.
+ * May be changed at startup to tune for a particular machine.
+ */
+GTSAM_EXPORT extern size_t choleskyPartialParallelThreshold;
+
+/**
+ * Pluggable backend for the dense partial Cholesky of very large frontal
+ * blocks.  Cliques whose frontal dimension reaches
+ * denseCholeskyBackendThreshold are routed to the installed backend instead
+ * of the built-in CPU code, so client code can plug in an accelerator
+ * implementation (e.g. cuSOLVER) without modifying GTSAM.  When elimination
+ * runs under TBB, sibling cliques continue on CPU workers while a backend
+ * call is in flight, so transfer/compute overlap comes from the existing
+ * clique-level parallelism.
+ */
+class GTSAM_EXPORT DenseCholeskyBackend {
+public:
+  virtual ~DenseCholeskyBackend() {}
+
+  /**
+   * Factor ABC = [A B; B' C] in place with the semantics documented for
+   * choleskyPartial above.  Called only with nFrontal > 0.
+   * @return true on success, false if A was not positive-definite.
+   */
+  virtual bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) = 0;
+};
+
+/**
+ * Install a dense-factorization backend and return the previously installed
+ * one (null if none).  Pass null to restore the built-in CPU path.  The
+ * backend is not owned by GTSAM and must outlive any elimination using it.
+ */
+GTSAM_EXPORT DenseCholeskyBackend* setDenseCholeskyBackend(
+    DenseCholeskyBackend* backend);
+
+/**
+ * Frontal dimension at or above which choleskyPartial routes to the
+ * installed DenseCholeskyBackend, if any.  Below the threshold the CPU code
+ * is used regardless, since transfer overhead dominates for small cliques.
+ */
+GTSAM_EXPORT extern size_t denseCholeskyBackendThreshold;
+
 }
 
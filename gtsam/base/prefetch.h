@@ -0,0 +1,49 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    prefetch.h
+ * @brief   Portable software prefetch hints
+ * @author  Richard Roberts
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace gtsam {
+
+/**
+ * Hint the hardware to pull the cache line containing \c address into cache
+ * for a read.  A no-op on compilers without prefetch intrinsics; never
+ * faults, so the address does not have to be valid.
+ */
+inline void prefetchRead(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0 /* read */, 3 /* high temporal locality */);
+#else
+  (void)address;
+#endif
+}
+
+/**
+ * Prefetch a contiguous byte range for reading, one hint per cache line.
+ * Intended for staging the next working set (e.g. the factor blocks of the
+ * next clique in an elimination schedule) while the current one computes.
+ */
+inline void prefetchRange(const void* address, size_t bytes) {
+  static const size_t kCacheLine = 64;
+  const char* p = static_cast<const char*>(address);
+  for (size_t offset = 0; offset < bytes; offset += kCacheLine)
+    prefetchRead(p + offset);
+}
+
+} // \ namespace gtsam
@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    smallKernels.h
+ * @brief   Fixed-size kernels for the small dense micro-ops on hot paths
+ * @author  Frank Dellaert
+ *
+ * The dense helpers in Matrix.cpp and cholesky.cpp work on dynamic-size
+ * matrices, so Eigen cannot unroll or pack them and falls back to generic
+ * strided loops - a poor fit for the 3- and 6-dimensional shapes (poses,
+ * velocities, IMU states) that dominate our factor graphs.  The kernels here
+ * inspect the runtime dimensions and, for the common sizes, remap the same
+ * storage as fixed-size Eigen matrices.  Fixed-size expressions compile to
+ * the packed SIMD kernels of whatever instruction set the build enables
+ * (SSE/AVX on x86, NEON on ARM, chosen by the existing CMake vectorization
+ * flags), so this gets explicit-width code on every platform without
+ * maintaining per-ISA intrinsics.  Shapes without a fixed kernel fall back
+ * to the dynamic path unchanged.
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+namespace gtsam {
+namespace kernels {
+
+/// Reference types that also bind to blocks of larger matrices, whose outer
+/// stride differs from their width
+typedef Eigen::Ref<Matrix, 0, Eigen::OuterStride<> > BlockRef;
+typedef Eigen::Ref<const Matrix, 0, Eigen::OuterStride<> > ConstBlockRef;
+
+namespace internal {
+
+/// Remap a dynamic square block as NxN, sharing storage and stride
+template <int N>
+void solveUpperFixed(const Matrix& U, Vector& b) {
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+  Eigen::Map<const MatrixN, 0, Eigen::OuterStride<> > Ufixed(U.data(),
+      Eigen::OuterStride<>(U.outerStride()));
+  Eigen::Map<VectorN> bfixed(b.data());
+  Ufixed.template triangularView<Eigen::Upper>().solveInPlace(bfixed);
+}
+
+/// Rank update with the contraction dimension K fixed at compile time
+template <int K>
+void rankUpdateUpperFixed(BlockRef S, const ConstBlockRef& A, double alpha) {
+  typedef Eigen::Matrix<double, K, Eigen::Dynamic> MatrixKX;
+  Eigen::Map<const MatrixKX, 0, Eigen::OuterStride<> > Afixed(A.data(), K,
+      A.cols(), Eigen::OuterStride<>(A.outerStride()));
+  S.selfadjointView<Eigen::Upper>().rankUpdate(Afixed.transpose(), alpha);
+}
+
+/// Square product with both dimensions fixed at compile time
+template <int N>
+void multiplyFixed(const Matrix& A, const Matrix& B, Matrix& C) {
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  Eigen::Map<const MatrixN> Afixed(A.data());
+  Eigen::Map<const MatrixN> Bfixed(B.data());
+  Eigen::Map<MatrixN> Cfixed(C.data());
+  Cfixed.noalias() = Afixed * Bfixed;
+}
+
+}  // namespace internal
+
+/**
+ * In-place upper-triangular solve b := U^{-1} b, with fixed-size kernels for
+ * the 3x3 and 6x6 systems of back-substitution over poses and IMU states.
+ */
+inline void solveUpperInPlace(const Matrix& U, Vector& b) {
+  assert(U.rows() == U.cols() && U.rows() == b.size());
+  switch (U.rows()) {
+  case 3: internal::solveUpperFixed<3>(U, b); break;
+  case 6: internal::solveUpperFixed<6>(U, b); break;
+  default: U.triangularView<Eigen::Upper>().solveInPlace(b); break;
+  }
+}
+
+/**
+ * Symmetric rank update S += alpha * A' * A on the upper triangle of S, with
+ * fixed-size kernels when the contraction dimension (rows of A) is 3 or 6 -
+ * the Schur-complement shape of eliminating one pose or one IMU state.
+ */
+inline void rankUpdateUpper(BlockRef S, const ConstBlockRef& A, double alpha) {
+  assert(S.rows() == S.cols() && S.cols() == A.cols());
+  switch (A.rows()) {
+  case 3: internal::rankUpdateUpperFixed<3>(S, A, alpha); break;
+  case 6: internal::rankUpdateUpperFixed<6>(S, A, alpha); break;
+  default:
+    S.selfadjointView<Eigen::Upper>().rankUpdate(A.transpose(), alpha);
+    break;
+  }
+}
+
+/**
+ * Dense product C = A * B, with fully unrolled fixed-size kernels for the
+ * square 3x3 and 6x6 shapes of rotation and pose adjoint algebra.  C must
+ * already have the product's dimensions.
+ */
+inline void multiplyInto(const Matrix& A, const Matrix& B, Matrix& C) {
+  assert(A.cols() == B.rows() && C.rows() == A.rows() && C.cols() == B.cols());
+  if (A.rows() == A.cols() && B.rows() == B.cols() && A.rows() == B.rows()) {
+    switch (A.rows()) {
+    case 3: internal::multiplyFixed<3>(A, B, C); return;
+    case 6: internal::multiplyFixed<6>(A, B, C); return;
+    default: break;
+    }
+  }
+  C.noalias() = A * B;
+}
+
+}  // namespace kernels
+}  // namespace gtsam
@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testBatchedDLT.cpp
+ * @brief  Unit tests for the batched homogeneous least-squares solves
+ */
+
+#include <gtsam/base/batchedDLT.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// The null vector is defined up to sign; align it with a reference
+static Vector aligned(const Vector& v, const Vector& reference) {
+  return v.dot(reference) < 0 ? Vector(-v) : v;
+}
+
+/* ************************************************************************* */
+TEST(batchedDLT, agreesWithDLT) {
+  // Overdetermined systems for every fixed-size path and the SVD fallback
+  for (int p : {4, 6, 9, 11}) {
+    const Matrix A = Matrix::Random(2 * p, p);
+    int rank, rankSmall;
+    double error, errorSmall;
+    Vector v, vSmall;
+    boost::tie(rank, error, v) = DLT(A);
+    boost::tie(rankSmall, errorSmall, vSmall) = DLTSmall(A);
+    LONGS_EQUAL(rank, rankSmall);
+    DOUBLES_EQUAL(error, errorSmall, 1e-6);
+    EXPECT(assert_equal(v, aligned(vSmall, v), 1e-6));
+  }
+}
+
+/* ************************************************************************* */
+TEST(batchedDLT, rankDeficient) {
+  // A 4-column system built from only 2 independent rows has rank 2
+  Matrix A(4, 4);
+  A.row(0) << 1, 2, 3, 4;
+  A.row(1) << 2, -1, 0, 1;
+  A.row(2) = 2.0 * A.row(0);
+  A.row(3) = A.row(0) - A.row(1);
+  int rank;
+  double error;
+  Vector v;
+  boost::tie(rank, error, v) = DLTSmall(A);
+  LONGS_EQUAL(2, rank);
+  DOUBLES_EQUAL(0.0, error, 1e-9);
+  DOUBLES_EQUAL(0.0, (A * v).norm(), 1e-9); // v spans the nullspace
+  DOUBLES_EQUAL(1.0, v.norm(), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(batchedDLT, batch) {
+  std::vector<Matrix> systems;
+  for (size_t i = 0; i < 20; ++i)
+    systems.push_back(Matrix::Random(8, 4));
+
+  const std::vector<boost::tuple<int, double, Vector> > results =
+      DLTBatch(systems);
+  LONGS_EQUAL(20, results.size());
+  for (size_t i = 0; i < systems.size(); ++i) {
+    int rank;
+    double error;
+    Vector v;
+    boost::tie(rank, error, v) = DLTSmall(systems[i]);
+    LONGS_EQUAL(rank, results[i].get<0>());
+    DOUBLES_EQUAL(error, results[i].get<1>(), 1e-12);
+    EXPECT(assert_equal(v, Vector(results[i].get<2>()), 1e-12));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
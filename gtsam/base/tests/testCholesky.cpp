@@ -66,6 +66,53 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+namespace {
+// Backend that counts invocations and delegates to the built-in CPU code
+struct CountingBackend: DenseCholeskyBackend {
+  size_t calls;
+  CountingBackend() : calls(0) {}
+  virtual bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
+    ++calls;
+    DenseCholeskyBackend* self = setDenseCholeskyBackend(0);
+    const bool ok = gtsam::choleskyPartial(ABC, nFrontal, topleft);
+    setDenseCholeskyBackend(self);
+    return ok;
+  }
+};
+}
+
+/* ************************************************************************* */
+TEST(cholesky, denseCholeskyBackend) {
+  Matrix ABC = (Matrix(3, 3) <<
+      4.0375, 3.4584, 3.5735,
+      0., 4.7267, 3.8423,
+      0., 0., 5.1600).finished();
+  Matrix expected(ABC);
+  choleskyPartial(expected, 2);
+
+  CountingBackend backend;
+  DenseCholeskyBackend* previous = setDenseCholeskyBackend(&backend);
+  const size_t previousThreshold = denseCholeskyBackendThreshold;
+
+  // Below the threshold the CPU path is used and the backend is not called
+  denseCholeskyBackendThreshold = 100;
+  Matrix RSL(ABC);
+  EXPECT(choleskyPartial(RSL, 2));
+  LONGS_EQUAL(0, (long)backend.calls);
+  EXPECT(assert_equal(expected, RSL, 1e-9));
+
+  // At or above the threshold the backend is routed to
+  denseCholeskyBackendThreshold = 2;
+  RSL = ABC;
+  EXPECT(choleskyPartial(RSL, 2));
+  LONGS_EQUAL(1, (long)backend.calls);
+  EXPECT(assert_equal(expected, RSL, 1e-9));
+
+  denseCholeskyBackendThreshold = previousThreshold;
+  setDenseCholeskyBackend(previous);
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
@@ -0,0 +1,69 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testConcurrentMap.cpp
+ * @brief   Unit tests for ConcurrentMap bulk operations
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/base/ConcurrentMap.h>
+#include <CppUnitLite/TestHarness.h>
+
+#include <algorithm>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ConcurrentMap, bulkInsert) {
+  FastVector<std::pair<int, int> > entries;
+  for (int i = 0; i < 100; ++i)
+    entries.push_back(std::make_pair(i, 10 * i));
+
+  ConcurrentMap<int, int> map;
+  map.reserve(entries.size());
+  map.bulkInsert(entries.begin(), entries.end());
+
+  LONGS_EQUAL(100, map.size());
+  EXPECT(map.exists(0));
+  EXPECT(map.exists(99));
+  LONGS_EQUAL(420, map.find(42)->second);
+
+  // Inserting a second batch must keep the earlier entries
+  FastVector<std::pair<int, int> > more;
+  more.push_back(std::make_pair(100, 1000));
+  map.bulkInsert(more.begin(), more.end());
+  LONGS_EQUAL(101, map.size());
+  EXPECT(map.exists(42));
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentMap, snapshot) {
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 10; ++i)
+    map.insert(std::make_pair(i, i * i));
+
+  FastVector<std::pair<int, int> > flat = map.snapshot();
+  LONGS_EQUAL(10, flat.size());
+
+  // The snapshot holds exactly the map contents, independent of later changes
+  map.insert(std::make_pair(10, 100));
+  LONGS_EQUAL(10, flat.size());
+  for(const std::pair<int, int>& entry: flat)
+    LONGS_EQUAL(entry.first * entry.first, entry.second);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
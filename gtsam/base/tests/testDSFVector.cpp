@@ -219,6 +219,77 @@ TEST(DSFVector, mergePairwiseMatches) {
   EXPECT(expected2 == actual2);
 }
 
+/* ************************************************************************* */
+TEST(DSFBase, componentLabels) {
+  DSFBase dsf(6);
+  dsf.merge(0,1);
+  dsf.merge(1,2);
+  dsf.merge(3,4);
+
+  // Every node's label must equal its representative, including singletons
+  DSFBase::V labels = dsf.componentLabels();
+  LONGS_EQUAL(6, labels.size());
+  for (size_t i = 0; i < labels.size(); ++i)
+    LONGS_EQUAL(dsf.find(i), labels[i]);
+  EXPECT(labels[0] == labels[1] && labels[1] == labels[2]);
+  EXPECT(labels[3] == labels[4]);
+  EXPECT(labels[0] != labels[3]);
+  LONGS_EQUAL(5, labels[5]);
+}
+
+/* ************************************************************************* */
+TEST(DSFFlat, merge) {
+  DSFFlat dsf(3);
+  EXPECT(dsf.find(0) != dsf.find(2));
+  dsf.merge(0,2);
+  EXPECT(dsf.find(0) == dsf.find(2));
+  EXPECT(dsf.find(0) != dsf.find(1));
+}
+
+/* ************************************************************************* */
+TEST(DSFFlat, mergeGrows) {
+  // Merging past the current size grows the arrays on demand
+  DSFFlat dsf;
+  dsf.merge(2,7);
+  LONGS_EQUAL(8, dsf.size());
+  EXPECT(dsf.find(2) == dsf.find(7));
+  EXPECT(dsf.find(2) != dsf.find(5));
+}
+
+/* ************************************************************************* */
+TEST(DSFFlat, mergePairs) {
+  typedef pair<size_t,size_t> Match;
+  vector<Match> matches;
+  matches += Match(1,2), Match(2,3), Match(4,5), Match(4,6);
+
+  DSFFlat dsf;
+  dsf.merge(matches);
+
+  // Same two components as the DSFVector merge test: 1,2,3 and 4,5,6
+  map<size_t, set<size_t> > sets = dsf.sets();
+  LONGS_EQUAL(3, sets.size()); // plus the singleton 0
+  set<size_t> expected1; expected1 += 1,2,3;
+  EXPECT(expected1 == sets[dsf.find(2)]);
+  set<size_t> expected2; expected2 += 4,5,6;
+  EXPECT(expected2 == sets[dsf.find(5)]);
+}
+
+/* ************************************************************************* */
+TEST(DSFFlat, agreesWithDSFVector) {
+  // Random-ish merge sequence: both structures must induce the same partition
+  const size_t n = 50;
+  DSFFlat flat(n);
+  DSFVector dsf(n);
+  for (size_t k = 0; k < 120; ++k) {
+    const size_t i = (k * 7919) % n, j = (k * 104729) % n;
+    flat.merge(i, j);
+    dsf.merge(i, j);
+  }
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = i + 1; j < n; ++j)
+      EXPECT((flat.find(i) == flat.find(j)) == (dsf.find(i) == dsf.find(j)));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -10,6 +10,7 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/base/FastSet.h>
 #include <gtsam/base/FastVector.h>
+#include <gtsam/base/SmallVector.h>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/assign/std/set.hpp>
@@ -29,6 +30,23 @@ TEST( testFastContainers, KeySet ) {
   EXPECT(actSet == expSet);
 }
 
+/* ************************************************************************* */
+TEST( testFastContainers, SmallVector ) {
+
+  // Up to the inline capacity the elements live inside the object itself
+  SmallVector<Key> small {2, 3, 4};
+  const char* object = reinterpret_cast<const char*>(&small);
+  const char* data = reinterpret_cast<const char*>(small.data());
+  EXPECT(data >= object && data < object + sizeof(small));
+
+  // Growing past the inline capacity falls back to the heap transparently
+  for (Key j = 5; j < 20; ++j)
+    small.push_back(j);
+  LONGS_EQUAL(18, small.size());
+  LONGS_EQUAL(2, small.front());
+  LONGS_EQUAL(19, small.back());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
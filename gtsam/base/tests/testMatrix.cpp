@@ -835,6 +835,11 @@ TEST(Matrix, eigen_QR )
       00, 10,0, 0, 0, -10, -1).finished());
   inplace_QR(A);
   EXPECT(assert_equal(expected, A, 1e-3));
+
+  // an already upper-triangular input terminates early and is unchanged
+  Matrix T = expected;
+  inplace_QR(T);
+  EXPECT(assert_equal(expected, T, 1e-9));
 }
 
 /* ************************************************************************* */
@@ -0,0 +1,94 @@
+/**
+ * @file testMemoryArena.cpp
+ *
+ * @brief Test for the MemoryArena bump allocator and ArenaAllocator adapter
+ *
+ * @date Aug 29, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/base/MemoryArena.h>
+
+#include <boost/make_shared.hpp>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST( MemoryArena, allocateAndAlign ) {
+  MemoryArena arena(1024);
+
+  void* p1 = arena.allocate(16, 16);
+  void* p2 = arena.allocate(1, 1);
+  void* p3 = arena.allocate(8, 8);
+
+  CHECK(p1 != NULL);
+  CHECK(p2 != NULL);
+  CHECK(p3 != NULL);
+  EXPECT_LONGS_EQUAL(0, reinterpret_cast<std::uintptr_t>(p1) % 16);
+  EXPECT_LONGS_EQUAL(0, reinterpret_cast<std::uintptr_t>(p3) % 8);
+  EXPECT_LONGS_EQUAL(1, arena.blockCount());
+}
+
+/* ************************************************************************* */
+TEST( MemoryArena, growsBeyondOneBlock ) {
+  MemoryArena arena(64);
+
+  // a request larger than the block size gets its own block
+  void* big = arena.allocate(256);
+  CHECK(big != NULL);
+
+  for (size_t i = 0; i < 100; ++i)
+    CHECK(arena.allocate(16) != NULL);
+
+  CHECK(arena.blockCount() > 1);
+  CHECK(arena.capacity() >= 256);
+}
+
+/* ************************************************************************* */
+TEST( MemoryArena, resetReusesStorage ) {
+  MemoryArena arena(128);
+
+  void* first = arena.allocate(32, 8);
+  arena.allocate(32, 8);
+  const size_t blocks = arena.blockCount();
+
+  arena.reset();
+
+  // after reset the same storage is handed out again, no new blocks appear
+  void* again = arena.allocate(32, 8);
+  EXPECT(first == again);
+  EXPECT_LONGS_EQUAL((long)blocks, (long)arena.blockCount());
+}
+
+/* ************************************************************************* */
+TEST( MemoryArena, stlAllocator ) {
+  MemoryArena arena;
+
+  std::vector<int, ArenaAllocator<int> > values{ArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(i);
+
+  EXPECT_LONGS_EQUAL(1000, (long)values.size());
+  EXPECT_LONGS_EQUAL(999, values.back());
+}
+
+/* ************************************************************************* */
+TEST( MemoryArena, allocateShared ) {
+  MemoryArena arena;
+
+  boost::shared_ptr<double> p =
+      boost::allocate_shared<double>(ArenaAllocator<double>(arena), 3.14);
+  DOUBLES_EQUAL(3.14, *p, 1e-9);
+
+  // the object lives inside the arena's storage
+  CHECK(arena.capacity() > 0);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testSmallKernels.cpp
+ * @brief  Unit tests for the fixed-size dense micro-op kernels
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/base/smallKernels.h>
+#include <gtsam/base/Matrix.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+static Matrix randomUpper(int n) {
+  Matrix U = Matrix::Random(n, n).triangularView<Eigen::Upper>();
+  U.diagonal().array() += 2.0; // keep well-conditioned
+  return U;
+}
+
+/* ************************************************************************* */
+TEST(smallKernels, solveUpperInPlace) {
+  // Fixed-size paths (3 and 6) and the dynamic fallback (5)
+  for (int n : {3, 5, 6}) {
+    Matrix U = randomUpper(n);
+    Vector b = Vector::Random(n);
+    Vector expected = U.triangularView<Eigen::Upper>().solve(b);
+    Vector actual = b;
+    kernels::solveUpperInPlace(U, actual);
+    EXPECT(assert_equal(expected, actual, 1e-12));
+  }
+}
+
+/* ************************************************************************* */
+TEST(smallKernels, rankUpdateUpper) {
+  // Contraction dimensions with fixed kernels (3, 6) and fallback (4)
+  for (int k : {3, 4, 6}) {
+    const int n = 7;
+    Matrix A = Matrix::Random(k, n);
+    Matrix S = Matrix::Random(n, n);
+    S = (S + S.transpose()).eval();
+    Matrix expected = S - A.transpose() * A;
+    Matrix actual = S;
+    kernels::rankUpdateUpper(actual, A, -1.0);
+    // Only the upper triangle is updated
+    EXPECT(assert_equal(Matrix(expected.triangularView<Eigen::Upper>()),
+        Matrix(actual.triangularView<Eigen::Upper>()), 1e-12));
+  }
+}
+
+/* ************************************************************************* */
+TEST(smallKernels, rankUpdateUpperOnBlock) {
+  // Operating on blocks of a larger matrix exercises the strided binding
+  const int k = 6, n = 5;
+  Matrix big = Matrix::Zero(12, 14);
+  big.block(2, 3, n, n) = Matrix::Identity(n, n) * 4.0;
+  big.block(4, 9, k, n) = Matrix::Random(k, n);
+  Matrix A = big.block(4, 9, k, n);
+  Matrix expected = Matrix(big.block(2, 3, n, n)) + 2.0 * A.transpose() * A;
+  kernels::rankUpdateUpper(big.block(2, 3, n, n), big.block(4, 9, k, n), 2.0);
+  EXPECT(assert_equal(Matrix(expected.triangularView<Eigen::Upper>()),
+      Matrix(Matrix(big.block(2, 3, n, n)).triangularView<Eigen::Upper>()),
+      1e-12));
+}
+
+/* ************************************************************************* */
+TEST(smallKernels, multiplyInto) {
+  // Square fixed-size paths
+  for (int n : {3, 6}) {
+    Matrix A = Matrix::Random(n, n), B = Matrix::Random(n, n);
+    Matrix expected = A * B;
+    Matrix actual(n, n);
+    kernels::multiplyInto(A, B, actual);
+    EXPECT(assert_equal(expected, actual, 1e-12));
+  }
+  // Non-square fallback
+  Matrix A = Matrix::Random(4, 7), B = Matrix::Random(7, 2);
+  Matrix expected = A * B;
+  Matrix actual(4, 2);
+  kernels::multiplyInto(A, B, actual);
+  EXPECT(assert_equal(expected, actual, 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(smallKernels, backSubstituteUpperDispatch) {
+  // The Matrix.cpp helper now routes through the kernels; check both sizes
+  for (int n : {3, 6}) {
+    Matrix U = randomUpper(n);
+    Vector b = Vector::Random(n);
+    Vector expected = U.triangularView<Eigen::Upper>().solve(b);
+    EXPECT(assert_equal(expected, backSubstituteUpper(U, b), 1e-12));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -52,6 +52,29 @@ TEST(SymmetricBlockMatrix, ReadBlocks)
   EXPECT(assert_equal(expected2, actual2));
 }
 
+/* ************************************************************************* */
+TEST(SymmetricBlockMatrix, RawBlocks)
+{
+  // The raw views must agree with the checked accessors
+  Matrix expected1 = testBlockMatrix.block(1, 1);
+  Matrix actual1 = testBlockMatrix.rawBlock(1, 1).map();
+  EXPECT(assert_equal(expected1, actual1));
+
+  Matrix expected2 = (Matrix(3, 2) <<
+    4, 5,
+    10, 11,
+    16, 17).finished();
+  Matrix actual2 = testBlockMatrix.rawBlock(0, 1).map();
+  EXPECT(assert_equal(expected2, actual2));
+
+  // Writes through a raw view land in the underlying storage
+  SymmetricBlockMatrix bm = SymmetricBlockMatrix::LikeActiveViewOf(testBlockMatrix);
+  bm.setZero();
+  bm.rawBlock(0, 1).map() = expected2;
+  Matrix actual3 = bm.aboveDiagonalBlock(0, 1);
+  EXPECT(assert_equal(expected2, actual3));
+}
+
 /* ************************************************************************* */
 TEST(SymmetricBlockMatrix, WriteBlocks)
 {
@@ -57,6 +57,26 @@ TEST(VerticalBlockMatrix, Constructor3) {
   EXPECT_LONGS_EQUAL(3,actual.nBlocks());
 }
 
+//*****************************************************************************
+TEST(VerticalBlockMatrix, RowMajorMirror) {
+  VerticalBlockMatrix actual(dimensions, 6);
+  actual.matrix() = (Matrix(6, 6) << 1, 2, 3, 4, 5, 6, //
+      2, 8, 9, 10, 11, 12, //
+      3, 9, 15, 16, 17, 18, //
+      4, 10, 16, 22, 23, 24, //
+      5, 11, 17, 23, 29, 30, //
+      6, 12, 18, 24, 30, 36).finished();
+
+  // Mirror is a row-major copy of the full matrix
+  EXPECT(assert_equal(Matrix(actual.matrix()), Matrix(actual.rowMajorMirror())));
+
+  // Writing through a non-const accessor invalidates the mirror,
+  // so the next access reflects the new contents
+  actual(1).setConstant(42.0);
+  EXPECT(assert_equal(Matrix(actual.matrix()), Matrix(actual.rowMajorMirror())));
+  EXPECT_DOUBLES_EQUAL(42.0, actual.rowMajorMirror()(0, 3), 1e-9);
+}
+
 //*****************************************************************************
 int main() {
   TestResult tr;
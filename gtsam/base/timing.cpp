@@ -22,14 +22,24 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/format.hpp>
 
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cassert>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
 
 namespace gtsam {
 namespace internal {
@@ -38,6 +48,143 @@ GTSAM_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot(
     new TimingOutline("Total", getTicTocID("Total")));
 GTSAM_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer(gTimingRoot);
 
+/* ************************************************************************* */
+// Chrome trace-event recording.  When enabled, every tic/toc pair is recorded
+// as a complete ("X") event with a wall-clock timestamp and duration, so the
+// timing tree can be overlaid with application traces in chrome://tracing or
+// the Perfetto UI.  Like the timing tree itself, this is not thread-safe.
+/* ************************************************************************* */
+namespace {
+
+struct ChromeTraceEvent {
+  std::string name;
+  size_t tid;   // hashed thread id
+  size_t ts;    // start, in microseconds since tracing was first queried
+  size_t dur;   // duration in microseconds
+};
+
+bool gChromeTracingEnabled = false;
+std::vector<ChromeTraceEvent> gChromeTraceEvents;
+// Start timestamps of the currently open tic/toc sections, innermost last
+std::vector<std::pair<std::string, size_t> > gChromeTraceStack;
+
+size_t chromeTraceNow() {
+  static const std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - epoch).count();
+}
+
+size_t chromeTraceThreadId() {
+  return std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+// Fast clocks and sampling, see tictoc_enableFastClocks_/tictoc_setSampling_
+bool gFastClocksEnabled = false;
+size_t gSamplingPeriod = 1;
+size_t gProbeCount = 0;
+
+// Worker-thread timing trees, merged on demand by mergedTimingTree().  The
+// thread that loaded the library keeps using gTimingRoot/gCurrentTimer so the
+// existing inline entry points in timing.h remain valid.
+std::mutex gThreadRootsMutex;
+std::vector<boost::shared_ptr<TimingOutline> > gThreadRoots;
+const std::thread::id gMainThreadId = std::this_thread::get_id();
+
+// The current timer of the calling thread.  Worker threads get their own
+// tree, created on first use and registered for merging, so concurrent
+// tic/toc calls no longer race on a single global tree.
+boost::weak_ptr<TimingOutline>& currentTimer() {
+  if (std::this_thread::get_id() == gMainThreadId)
+    return gCurrentTimer;
+  static thread_local boost::shared_ptr<TimingOutline> threadRoot;
+  static thread_local boost::weak_ptr<TimingOutline> threadCurrent;
+  if (!threadRoot) {
+    threadRoot.reset(new TimingOutline("Thread", getTicTocID("Thread")));
+    threadCurrent = threadRoot;
+    std::lock_guard<std::mutex> lock(gThreadRootsMutex);
+    // Keeps the tree alive past thread exit, so its times still get merged
+    gThreadRoots.push_back(threadRoot);
+  }
+  return threadCurrent;
+}
+
+// Measure the time-stamp counter against the steady clock, once
+double calibrateTicksPerMicrosecond() {
+#if defined(__x86_64__) || defined(__i386__)
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const size_t tickStart = __rdtsc();
+  std::chrono::steady_clock::time_point now;
+  do {
+    now = std::chrono::steady_clock::now();
+  } while (std::chrono::duration_cast<std::chrono::microseconds>(now - start)
+      .count() < 1000);
+  const size_t tickEnd = __rdtsc();
+  const double usecs = double(std::chrono::duration_cast<
+      std::chrono::nanoseconds>(now - start).count()) / 1000.0;
+  return double(tickEnd - tickStart) / usecs;
+#else
+  // tickNow() falls back to steady_clock nanoseconds
+  return 1000.0;
+#endif
+}
+
+} // anonymous namespace
+
+/* ************************************************************************* */
+size_t tickNow() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/* ************************************************************************* */
+size_t ticksToMicroseconds(size_t ticks) {
+  static const double ticksPerMicrosecond = calibrateTicksPerMicrosecond();
+  return size_t(double(ticks) / ticksPerMicrosecond);
+}
+
+/* ************************************************************************* */
+void enableFastClocks(bool enable) {
+  if (enable)
+    ticksToMicroseconds(0); // calibrate now, not inside the first probe
+  gFastClocksEnabled = enable;
+}
+
+/* ************************************************************************* */
+void setSamplingPeriod(size_t period) {
+  gSamplingPeriod = period > 0 ? period : 1;
+}
+
+/* ************************************************************************* */
+void enableChromeTracing(bool enable) {
+  gChromeTracingEnabled = enable;
+  gChromeTraceStack.clear();
+}
+
+/* ************************************************************************* */
+void saveChromeTrace(const std::string& filename) {
+  std::ofstream file(filename.c_str());
+  if (!file.is_open())
+    throw std::invalid_argument(
+        "gtsam timing:  Could not open trace file " + filename);
+  file << "{\"traceEvents\":[";
+  bool first = true;
+  for (const ChromeTraceEvent& event : gChromeTraceEvents) {
+    if (!first) file << ",";
+    first = false;
+    file << "\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"ts\":"
+         << event.ts << ",\"dur\":" << event.dur << ",\"pid\":0,\"tid\":"
+         << event.tid << "}";
+  }
+  file << "\n]}\n";
+  gChromeTraceEvents.clear();
+}
+
 /* ************************************************************************* */
 // Implementation of TimingOutline
 /* ************************************************************************* */
@@ -55,7 +202,7 @@ void TimingOutline::add(size_t usecs, size_t usecsWall) {
 /* ************************************************************************* */
 TimingOutline::TimingOutline(const std::string& label, size_t id) :
     id_(id), t_(0), tWall_(0), t2_(0.0), tIt_(0), tMax_(0), tMin_(0), n_(0), myOrder_(
-        0), lastChildOrder_(0), label_(label) {
+        0), lastChildOrder_(0), label_(label), tickStart_(0), sampled_(true) {
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
   timer_.stop();
 #endif
@@ -157,6 +304,17 @@ const boost::shared_ptr<TimingOutline>& TimingOutline::child(size_t child,
 
 /* ************************************************************************* */
 void TimingOutline::tic() {
+  // In sampling mode only every period-th entry is timed; the others just
+  // get counted in toc(), without touching any clock
+  sampled_ = (gSamplingPeriod <= 1) || (++gProbeCount % gSamplingPeriod == 0);
+  if (!sampled_)
+    return;
+
+  if (gFastClocksEnabled) {
+    tickStart_ = tickNow();
+    return;
+  }
+
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
   assert(timer_.is_stopped());
   timer_.start();
@@ -173,6 +331,20 @@ void TimingOutline::tic() {
 
 /* ************************************************************************* */
 void TimingOutline::toc() {
+  if (!sampled_) {
+    ++n_; // count the call, its time is covered by the sampled ones
+    return;
+  }
+
+  if (gFastClocksEnabled) {
+    // A single elapsed measurement stands in for both CPU and wall time;
+    // under sampling, scale it back up to approximate the skipped probes
+    const size_t usecs =
+        ticksToMicroseconds(tickNow() - tickStart_) * gSamplingPeriod;
+    add(usecs, usecs);
+    return;
+  }
+
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
 
   assert(!timer_.is_stopped());
@@ -199,7 +371,29 @@ void TimingOutline::toc() {
       (tbb::tick_count::now() - tbbTimer_).seconds() * 1e6);
 #endif
 
-  add(cpuTime, wallTime);
+  add(cpuTime * gSamplingPeriod, wallTime * gSamplingPeriod);
+}
+
+/* ************************************************************************* */
+void TimingOutline::absorb(const TimingOutline& other) {
+  t_ += other.t_;
+  tWall_ += other.tWall_;
+  t2_ += other.t2_;
+  tIt_ += other.tIt_;
+  if (other.tMax_ > tMax_)
+    tMax_ = other.tMax_;
+  if (other.tMin_ > 0 && (tMin_ == 0 || other.tMin_ < tMin_))
+    tMin_ = other.tMin_;
+  n_ += other.n_;
+  for (const ChildMap::value_type& child : other.children_) {
+    boost::shared_ptr<TimingOutline>& mine = children_[child.first];
+    if (!mine) {
+      mine.reset(new TimingOutline(child.second->label_, child.first));
+      ++lastChildOrder_;
+      mine->myOrder_ = lastChildOrder_;
+    }
+    mine->absorb(*child.second);
+  }
 }
 
 /* ************************************************************************* */
@@ -221,6 +415,10 @@ size_t getTicTocID(const char *descriptionC) {
   static size_t nextId = 0;
   static gtsam::FastMap<std::string, size_t> idMap;
 
+  // The static initializers holding the IDs may run on any thread
+  static std::mutex idMutex;
+  std::lock_guard<std::mutex> lock(idMutex);
+
   // Retrieve or add this string
   gtsam::FastMap<std::string, size_t>::const_iterator it = idMap.find(
       description);
@@ -236,15 +434,19 @@ size_t getTicTocID(const char *descriptionC) {
 /* ************************************************************************* */
 void tic(size_t id, const char *labelC) {
   const std::string label(labelC);
+  boost::weak_ptr<TimingOutline>& current = currentTimer();
   boost::shared_ptr<TimingOutline> node = //
-      gCurrentTimer.lock()->child(id, label, gCurrentTimer);
-  gCurrentTimer = node;
+      current.lock()->child(id, label, current);
+  current = node;
   node->tic();
+  if (gChromeTracingEnabled)
+    gChromeTraceStack.push_back(std::make_pair(label, chromeTraceNow()));
 }
 
 /* ************************************************************************* */
 void toc(size_t id, const char *label) {
-  boost::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
+  boost::weak_ptr<TimingOutline>& currentWeak = currentTimer();
+  boost::shared_ptr<TimingOutline> current(currentWeak.lock());
   if (id != current->id_) {
     gTimingRoot->print();
     throw std::invalid_argument(
@@ -260,7 +462,28 @@ void toc(size_t id, const char *label) {
             % label).str());
   }
   current->toc();
-  gCurrentTimer = current->parent_;
+  currentWeak = current->parent_;
+  // The stack may be empty if tracing was enabled inside an open section
+  if (gChromeTracingEnabled && !gChromeTraceStack.empty()) {
+    ChromeTraceEvent event;
+    event.name = gChromeTraceStack.back().first;
+    event.tid = chromeTraceThreadId();
+    event.ts = gChromeTraceStack.back().second;
+    event.dur = chromeTraceNow() - event.ts;
+    gChromeTraceStack.pop_back();
+    gChromeTraceEvents.push_back(event);
+  }
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<TimingOutline> mergedTimingTree() {
+  boost::shared_ptr<TimingOutline> merged(
+      new TimingOutline("Total", getTicTocID("Total")));
+  merged->absorb(*gTimingRoot);
+  std::lock_guard<std::mutex> lock(gThreadRootsMutex);
+  for (const boost::shared_ptr<TimingOutline>& root : gThreadRoots)
+    merged->absorb(*root);
+  return merged;
 }
 
 } // namespace internal
@@ -139,6 +139,25 @@ namespace gtsam {
     // Call toc on gCurrentTimer and then set gCurrentTimer to the parent of gCurrentTimer
     GTSAM_EXPORT void toc(size_t id, const char *label);
 
+    // Enable or disable recording of trace events, see tictoc_saveChromeTrace_
+    GTSAM_EXPORT void enableChromeTracing(bool enable);
+
+    // Write the recorded trace events as Chrome trace-event JSON and clear the recording
+    GTSAM_EXPORT void saveChromeTrace(const std::string& filename);
+
+    // Use the processor time-stamp counter instead of the syscall-based
+    // clocks, see tictoc_enableFastClocks_
+    GTSAM_EXPORT void enableFastClocks(bool enable);
+
+    // Time only every period-th probe, see tictoc_setSampling_
+    GTSAM_EXPORT void setSamplingPeriod(size_t period);
+
+    // Raw monotonic tick count, from the time-stamp counter where available
+    GTSAM_EXPORT size_t tickNow();
+
+    // Convert a difference of tickNow() values to microseconds
+    GTSAM_EXPORT size_t ticksToMicroseconds(size_t ticks);
+
     /**
      * Timing Entry, arranged in a tree
      */
@@ -170,6 +189,8 @@ namespace gtsam {
 #ifdef GTSAM_USE_TBB
       tbb::tick_count tbbTimer_;
 #endif
+      size_t tickStart_; ///< start tick count when fast clocks are enabled
+      bool sampled_;     ///< whether the currently open section is being timed
       void add(size_t usecs, size_t usecsWall);
 
     public:
@@ -189,6 +210,8 @@ namespace gtsam {
       GTSAM_EXPORT void tic();
       GTSAM_EXPORT void toc();
       GTSAM_EXPORT void finishedIteration();
+      /// Fold the statistics of another tree into this one, matching children by id
+      GTSAM_EXPORT void absorb(const TimingOutline& other);
 
       GTSAM_EXPORT friend void toc(size_t id, const char *label);
     }; // \TimingOutline
@@ -218,6 +241,10 @@ namespace gtsam {
 
     GTSAM_EXTERN_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot;
     GTSAM_EXTERN_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer;
+
+    // Deep-copied timing tree with the per-thread trees folded into the main
+    // one, see tictoc_printMerged_
+    GTSAM_EXPORT boost::shared_ptr<TimingOutline> mergedTimingTree();
   }
 
 // Tic and toc functions that are always active (whether or not ENABLE_TIMING is defined)
@@ -257,6 +284,40 @@ inline void tictoc_print_() {
 inline void tictoc_print2_() {
   ::gtsam::internal::gTimingRoot->print2(); }
 
+// Start (or stop) recording every tic/toc pair as a wall-clock trace event
+// with a thread ID, in addition to the aggregated statistics above.  Unlike
+// the statistics, the recording keeps individual event timestamps, so outlier
+// iterations remain visible in the trace.
+inline void tictoc_enableChromeTracing_(bool enable = true) {
+  ::gtsam::internal::enableChromeTracing(enable); }
+
+// Save the recorded trace events in the Chrome trace-event JSON format and
+// clear the recording.  The file can be opened in chrome://tracing or the
+// Perfetto UI, and merged with application traces into a single timeline.
+inline void tictoc_saveChromeTrace_(const std::string& filename) {
+  ::gtsam::internal::saveChromeTrace(filename); }
+
+// Time sections with the processor time-stamp counter instead of the
+// syscall-based CPU/wall clocks.  A single elapsed-time measurement is then
+// recorded as both CPU and wall time, so the CPU columns of the printout
+// report wall time, but the per-probe cost drops to a pair of counter reads.
+inline void tictoc_enableFastClocks_(bool enable = true) {
+  ::gtsam::internal::enableFastClocks(enable); }
+
+// Only time every period-th entry into each section, scaling the recorded
+// time back up by the period; the remaining probes just count calls.  Use
+// together with fast clocks to leave instrumentation enabled in production.
+// A period of 1 (the default) times every call.
+inline void tictoc_setSampling_(size_t period) {
+  ::gtsam::internal::setSamplingPeriod(period); }
+
+// Print the timing tree with the trees of all worker threads merged in.
+// Sections timed on other threads accumulate in per-thread trees rather than
+// the main one, so this is the complete picture under TBB; the merge is done
+// on a deep copy, so neither the main nor the per-thread trees are disturbed.
+inline void tictoc_printMerged_() {
+  ::gtsam::internal::mergedTimingTree()->print(); }
+
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
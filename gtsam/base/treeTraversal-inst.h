@@ -135,6 +135,15 @@ void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre) {
   DepthFirstForest(forest, rootData, visitorPre, visitorPost);
 }
 
+/**
+ * Subtrees whose problemSize() falls below this threshold are processed within a single TBB
+ * task instead of spawning further tasks for their children, trading scheduling overhead
+ * against available parallelism.  Exposed so that timing scripts can tune it for a specific
+ * problem and core count - on many-core machines with unbalanced elimination trees a smaller
+ * value keeps more stealable tasks in flight.
+ */
+GTSAM_EXPORT extern int parallelTraversalThreshold;
+
 /** Traverse a forest depth-first with pre-order and post-order visits.
  *  @param forest The forest of trees to traverse.  The method \c forest.roots() should exist
  *         and return a collection of (shared) pointers to \c FOREST::Node.
@@ -153,7 +162,7 @@ template<class FOREST, typename DATA, typename VISITOR_PRE,
     typename VISITOR_POST>
 void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-    int problemSizeThreshold = 10) {
+    int problemSizeThreshold = parallelTraversalThreshold) {
 #ifdef GTSAM_USE_TBB
   // Typedefs
   typedef typename FOREST::Node Node;
@@ -0,0 +1,29 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    treeTraversal.cpp
+ * @brief   Tunable parameters for the parallel tree traversal
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/base/treeTraversal-inst.h>
+
+namespace gtsam {
+namespace treeTraversal {
+
+/* ************************************************************************* */
+// Default chosen so that, e.g., elimination of single-variable cliques does not
+// pay task-scheduling overhead, while larger cliques remain stealable.
+int parallelTraversalThreshold = 10;
+
+}
+}
@@ -100,8 +100,6 @@ namespace gtsam {
                 isPostOrderPhase = true;
                 recycle_as_continuation();
 
-                bool overThreshold = (treeNode->problemSize() >= problemSizeThreshold);
-
                 tbb::task* firstChild = 0;
                 tbb::task_list childTasks;
                 for(const boost::shared_ptr<NODE>& child: treeNode->children)
@@ -111,9 +109,14 @@ namespace gtsam {
                   // allocated an extra child, this causes a TBB error.
                   boost::shared_ptr<DATA> childData = boost::allocate_shared<DATA>(
                       tbb::scalable_allocator<DATA>(), visitorPre(child, *myData));
+                  // Decide for each subtree independently whether it keeps spawning stealable
+                  // tasks.  With unbalanced trees a single decision based on this node's size
+                  // would commit every child to the same fate, serializing a large subtree
+                  // whenever its siblings happen to be small.
+                  bool spawnInSubtree = (child->problemSize() >= problemSizeThreshold);
                   tbb::task* childTask =
                       new (allocate_child()) PreOrderTask(child, childData, visitorPre, visitorPost,
-                                                          problemSizeThreshold, overThreshold);
+                                                          problemSizeThreshold, spawnInSubtree);
                   if (firstChild)
                     childTasks.push_back(*childTask);
                   else
@@ -27,16 +27,38 @@
 #include <boost/tuple/tuple.hpp>
 #include <boost/assign/std/vector.hpp>
 using boost::assign::operator+=;
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <algorithm>
 #include <list>
 #include <cmath>
 #include <fstream>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 namespace gtsam {
 
+  /*********************************************************************************/
+  // Erase unique-table entries whose nodes no longer exist, once the table
+  // outgrows its sweep threshold (hash-consing, see DecisionTreeInterning)
+  template<typename TABLE>
+  void sweepUniqueTable(TABLE& table, size_t& sweepThreshold) {
+    if (table.size() <= sweepThreshold) return;
+    typename TABLE::iterator it = table.begin();
+    while (it != table.end()) {
+      if (it->second.expired())
+        it = table.erase(it);
+      else
+        ++it;
+    }
+    sweepThreshold = std::max<size_t>(256, 2 * table.size());
+  }
+
   /*********************************************************************************/
   // Node
   /*********************************************************************************/
@@ -65,6 +87,43 @@ namespace gtsam {
       return constant_;
     }
 
+    /**
+     * Create a leaf, hash-consed: when interning is enabled for this
+     * instantiation (see DecisionTreeInterning), leaves with the same
+     * constant share a single node.
+     */
+    static NodePtr Unique(const Y& constant) {
+      return Unique(constant,
+          std::integral_constant<bool, DecisionTreeInterning<L, Y>::value>());
+    }
+
+  private:
+
+    /// Interned version: look up the per-instantiation unique table.  The
+    /// table is thread_local because discrete elimination creates nodes from
+    /// parallel traversals; threads then dedupe independently, which only
+    /// narrows sharing, never correctness.
+    static NodePtr Unique(const Y& constant, std::true_type) {
+      typedef boost::unordered_map<Y, boost::weak_ptr<const Node> > UniqueTable;
+      static thread_local UniqueTable uniqueTable;
+      static thread_local size_t sweepThreshold = 256;
+      sweepUniqueTable(uniqueTable, sweepThreshold);
+      boost::weak_ptr<const Node>& entry = uniqueTable[constant];
+      NodePtr interned = entry.lock();
+      if (!interned) {
+        interned = NodePtr(new Leaf(constant));
+        entry = interned;
+      }
+      return interned;
+    }
+
+    /// Non-interned version, for types without a hash
+    static NodePtr Unique(const Y& constant, std::false_type) {
+      return NodePtr(new Leaf(constant));
+    }
+
+  public:
+
     /// Leaf-Leaf equality
     bool sameLeaf(const Leaf& q) const {
       return constant_ == q.constant_;
@@ -102,8 +161,7 @@ namespace gtsam {
 
     /** apply unary operator */
     NodePtr apply(const Unary& op) const {
-      NodePtr f(new Leaf(op(constant_)));
-      return f;
+      return Unique(op(constant_));
     }
 
     // Apply binary operator "h = f op g" on Leaf node
@@ -117,8 +175,7 @@ namespace gtsam {
 
     // Applying binary operator to two leaves results in a leaf
     NodePtr apply_g_op_fL(const Leaf& fL, const Binary& op) const {
-      NodePtr h(new Leaf(op(fL.constant_, constant_))); // fL op gL
-      return h;
+      return Unique(op(fL.constant_, constant_)); // fL op gL
     }
 
     // If second argument is a Choice node, call it's apply with leaf as second
@@ -126,9 +183,9 @@ namespace gtsam {
       return fC.apply_fC_op_gL(*this, op); // operand order back to normal
     }
 
-    /** choose a branch, create new memory ! */
+    /** choose a branch, possibly sharing an interned node */
     NodePtr choose(const L& label, size_t index) const {
-      return NodePtr(new Leaf(constant()));
+      return Unique(constant());
     }
 
     bool isLeaf() const { return true; }
@@ -161,20 +218,54 @@ namespace gtsam {
 #endif
     }
 
-    /** If all branches of a choice node f are the same, just return a branch */
+    /** If all branches of a choice node f are the same, just return a branch;
+     *  otherwise intern f so identical subtrees share one node */
     static NodePtr Unique(const ChoicePtr& f) {
 #ifndef DT_NO_PRUNING
       if (f->allSame_) {
         assert(f->branches().size() > 0);
         NodePtr f0 = f->branches_[0];
         assert(f0->isLeaf());
-        NodePtr newLeaf(new Leaf(boost::dynamic_pointer_cast<const Leaf>(f0)->constant()));
-        return newLeaf;
+        return Leaf::Unique(
+            boost::dynamic_pointer_cast<const Leaf>(f0)->constant());
       } else
 #endif
-        return f;
+        return Intern(f,
+            std::integral_constant<bool, DecisionTreeInterning<L, Y>::value>());
     }
 
+  private:
+
+    /// Hash-cons: nodes with the same label and branches share one node.
+    /// The table is thread_local for the same reason as Leaf::Unique's.
+    static NodePtr Intern(const ChoicePtr& f, std::true_type) {
+      // The signature hashes branches by pointer, which discriminates exactly
+      // because the branches themselves are already interned
+      typedef std::pair<L, std::vector<const void*> > Signature;
+      typedef boost::unordered_map<Signature, boost::weak_ptr<const Node> > UniqueTable;
+      static thread_local UniqueTable uniqueTable;
+      static thread_local size_t sweepThreshold = 256;
+      sweepUniqueTable(uniqueTable, sweepThreshold);
+      Signature signature(f->label_, std::vector<const void*>());
+      signature.second.reserve(f->branches_.size());
+      for (const NodePtr& branch: f->branches_)
+        signature.second.push_back(branch.get());
+      boost::weak_ptr<const Node>& entry = uniqueTable[signature];
+      NodePtr interned = entry.lock();
+      if (!interned) {
+        interned = f;
+        entry = interned;
+      }
+      return interned;
+    }
+
+    /// Non-interned version, for types without a hash
+    static NodePtr Intern(const ChoicePtr& f, std::false_type) {
+      return f;
+    }
+
+  public:
+
     bool isLeaf() const { return false; }
 
     /** Constructor, given choice label and mandatory expected branch count */
@@ -380,7 +471,7 @@ namespace gtsam {
   /*********************************************************************************/
   template<typename L, typename Y>
   DecisionTree<L, Y>::DecisionTree(const Y& y)  {
-    root_ = NodePtr(new Leaf(y));
+    root_ = Leaf::Unique(y);
   }
 
   /*********************************************************************************/
@@ -388,7 +479,7 @@ namespace gtsam {
   DecisionTree<L, Y>::DecisionTree(//
       const L& label, const Y& y1, const Y& y2)  {
     boost::shared_ptr<Choice> a(new Choice(label, 2));
-    NodePtr l1(new Leaf(y1)), l2(new Leaf(y2));
+    NodePtr l1 = Leaf::Unique(y1), l2 = Leaf::Unique(y2);
     a->push_back(l1);
     a->push_back(l2);
     root_ = Choice::Unique(a);
@@ -401,7 +492,7 @@ namespace gtsam {
     if (labelC.second != 2) throw std::invalid_argument(
         "DecisionTree: binary constructor called with non-binary label");
     boost::shared_ptr<Choice> a(new Choice(labelC.first, 2));
-    NodePtr l1(new Leaf(y1)), l2(new Leaf(y2));
+    NodePtr l1 = Leaf::Unique(y1), l2 = Leaf::Unique(y2);
     a->push_back(l1);
     a->push_back(l2);
     root_ = Choice::Unique(a);
@@ -547,7 +638,7 @@ namespace gtsam {
       }
       boost::shared_ptr<Choice> choice(new Choice(begin->first, endY - beginY));
       for (ValueIt y = beginY; y != endY; y++)
-        choice->push_back(NodePtr(new Leaf(*y)));
+        choice->push_back(Leaf::Unique(*y));
       return Choice::Unique(choice);
     }
 
@@ -579,7 +670,7 @@ namespace gtsam {
     // ugliness below because apparently we can't have templated virtual functions
     // If leaf, apply unary conversion "op" and create a unique leaf
     const MXLeaf* leaf = dynamic_cast<const MXLeaf*> (f.get());
-    if (leaf) return NodePtr(new Leaf(op(leaf->constant())));
+    if (leaf) return Leaf::Unique(op(leaf->constant()));
 
     // Check if Choice
     boost::shared_ptr<const MXChoice> choice = boost::dynamic_pointer_cast<const MXChoice> (f);
@@ -22,11 +22,26 @@
 #include <gtsam/discrete/Assignment.h>
 #include <boost/function.hpp>
 #include <iostream>
+#include <type_traits>
 #include <vector>
 #include <map>
 
 namespace gtsam {
 
+  /**
+   * Enables hash-consed node interning for DecisionTree<L, Y>: node creation
+   * looks up a unique table, as in BDD packages, so structurally identical
+   * subtrees share a single node and repeated products stay compact.  On by
+   * default when both the label and value types are arithmetic (and hence
+   * hashable); specialize this trait to opt other types in or out.  The
+   * unique tables are global per instantiation and not thread-safe.
+   */
+  template<typename L, typename Y>
+  struct DecisionTreeInterning {
+    static const bool value = std::is_arithmetic<L>::value
+        && std::is_arithmetic<Y>::value;
+  };
+
   /**
    * Decision Tree
    * L = label for variables
@@ -19,6 +19,7 @@
 //#define ENABLE_TIMING
 #include <gtsam/discrete/DiscreteFactorGraph.h>
 #include <gtsam/discrete/DiscreteConditional.h>
+#include <gtsam/discrete/SparseTableFactor.h>
 #include <gtsam/discrete/DiscreteBayesTree.h>
 #include <gtsam/discrete/DiscreteEliminationTree.h>
 #include <gtsam/discrete/DiscreteJunctionTree.h>
@@ -31,6 +32,7 @@ namespace gtsam {
   // Instantiate base classes
   template class FactorGraph<DiscreteFactor>;
   template class EliminateableFactorGraph<DiscreteFactorGraph>;
+  template class MultifrontalPlan<DiscreteFactorGraph>;
 
   /* ************************************************************************* */
   bool DiscreteFactorGraph::equals(const This& fg, double tol) const
@@ -129,6 +131,51 @@ namespace gtsam {
     return std::make_pair(cond, sum);
   }
 
+  /* ************************************************************************* */
+  std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
+  EliminateDiscreteSparse(const DiscreteFactorGraph& factors,
+      const Ordering& frontalKeys) {
+
+    // PRODUCT: multiply all factors in sparse-table form, so zero entries
+    // never participate
+    gttic(product);
+    SparseTableFactor product;
+    bool first = true;
+    for (const DiscreteFactor::shared_ptr& factor : factors) {
+      const SparseTableFactor* sparse =
+          dynamic_cast<const SparseTableFactor*>(factor.get());
+      const SparseTableFactor converted =
+          sparse ? *sparse : SparseTableFactor(factor->toDecisionTreeFactor());
+      product = first ? converted : product.multiply(converted);
+      first = false;
+    }
+    gttoc(product);
+
+    // sum out frontals, this is the factor on the separator
+    gttic(sum);
+    SparseTableFactor::shared_ptr sum = product.sum(frontalKeys);
+    gttoc(sum);
+
+    // Ordering keys for the conditional so that frontalKeys are really in front
+    Ordering orderedKeys;
+    orderedKeys.insert(orderedKeys.end(), frontalKeys.begin(),
+        frontalKeys.end());
+    orderedKeys.insert(orderedKeys.end(), sum->keys().begin(),
+        sum->keys().end());
+
+    // Convert to dense decision trees only here, at the clique boundary,
+    // because DiscreteConditional stores its potentials as an ADT
+    gttic(divide);
+    const DecisionTreeFactor denseProduct = product.toDecisionTreeFactor();
+    DecisionTreeFactor::shared_ptr denseSum = boost::make_shared<
+        DecisionTreeFactor>(sum->toDecisionTreeFactor());
+    DiscreteConditional::shared_ptr cond(
+        new DiscreteConditional(denseProduct, *denseSum, orderedKeys));
+    gttoc(divide);
+
+    return std::make_pair(cond, denseSum);
+  }
+
 /* ************************************************************************* */
 } // namespace
 
@@ -41,6 +41,17 @@ class DiscreteJunctionTree;
 GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
 EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& keys);
 
+/**
+ * Elimination function that forms the product and the separator marginal in
+ * sparse-table form, skipping zero entries, and converts to dense decision
+ * trees only at the clique boundary for the conditional.  Produces the same
+ * result as EliminateDiscrete; worthwhile when the factors are mostly zero,
+ * as data-association potentials typically are.  Pass to eliminate calls as
+ * the elimination function, e.g. graph.eliminateSequential(EliminateDiscreteSparse).
+ */
+GTSAM_EXPORT std::pair<boost::shared_ptr<DiscreteConditional>, DecisionTreeFactor::shared_ptr>
+EliminateDiscreteSparse(const DiscreteFactorGraph& factors, const Ordering& keys);
+
 /* ************************************************************************* */
 template<> struct EliminationTraits<DiscreteFactorGraph>
 {
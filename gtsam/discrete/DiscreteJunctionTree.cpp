@@ -31,4 +31,10 @@ namespace gtsam {
     const DiscreteEliminationTree& eliminationTree) :
   Base(eliminationTree) {}
 
+  /* ************************************************************************* */
+  DiscreteJunctionTree::DiscreteJunctionTree(
+    const DiscreteEliminationTree& eliminationTree,
+    const AmalgamationPolicy& policy) :
+  Base(eliminationTree, policy) {}
+
 }
@@ -61,6 +61,11 @@ namespace gtsam {
     * @return The elimination tree
     */
     DiscreteJunctionTree(const DiscreteEliminationTree& eliminationTree);
+
+    /** Build the junction tree from an elimination tree, amalgamating cliques
+     *  according to the given policy. */
+    DiscreteJunctionTree(const DiscreteEliminationTree& eliminationTree,
+        const AmalgamationPolicy& policy);
   };
 
 }
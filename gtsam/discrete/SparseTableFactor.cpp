@@ -0,0 +1,262 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SparseTableFactor.cpp
+ * @brief Discrete factor storing only the nonzero potential entries
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/discrete/SparseTableFactor.h>
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  namespace {
+  bool compareIndex(const SparseTableFactor::Entry& a,
+      const SparseTableFactor::Entry& b) {
+    return a.first < b.first;
+  }
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::SparseTableFactor() {
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::SparseTableFactor(const DiscreteKeys& keys,
+      const vector<double>& table) :
+      DiscreteFactor(keys.indices()), cardinalities_(keys.cardinalities()) {
+    if (table.size() != tableSize())
+      throw invalid_argument(
+          "SparseTableFactor: table size does not match key cardinalities");
+    for (size_t index = 0; index < table.size(); ++index)
+      if (table[index] != 0.0)
+        entries_.push_back(Entry(index, table[index]));
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::SparseTableFactor(const DecisionTreeFactor& factor) :
+      DiscreteFactor(factor.keys()) {
+    for (Key j : factor.keys())
+      cardinalities_[j] = factor.cardinality(j);
+    const size_t n = tableSize();
+    for (size_t index = 0; index < n; ++index) {
+      const double value = factor(assignmentOf(index));
+      if (value != 0.0)
+        entries_.push_back(Entry(index, value));
+    }
+  }
+
+  /* ************************************************************************* */
+  bool SparseTableFactor::equals(const DiscreteFactor& other, double tol) const {
+    const This* e = dynamic_cast<const This*>(&other);
+    if (!e || keys_ != e->keys_ || cardinalities_ != e->cardinalities_
+        || entries_.size() != e->entries_.size())
+      return false;
+    for (size_t i = 0; i < entries_.size(); ++i)
+      if (entries_[i].first != e->entries_[i].first
+          || fabs(entries_[i].second - e->entries_[i].second) > tol)
+        return false;
+    return true;
+  }
+
+  /* ************************************************************************* */
+  void SparseTableFactor::print(const string& s,
+      const KeyFormatter& formatter) const {
+    cout << s;
+    cout << "  keys:";
+    for (Key j : keys_)
+      cout << " " << formatter(j) << "(" << cardinality(j) << ")";
+    cout << ", " << nrEntries() << "/" << tableSize() << " entries:" << endl;
+    for (const Entry& entry : entries_) {
+      const Values assignment = assignmentOf(entry.first);
+      cout << "  (";
+      for (Key j : keys_)
+        cout << " " << assignment.at(j);
+      cout << " ): " << entry.second << endl;
+    }
+  }
+
+  /* ************************************************************************* */
+  size_t SparseTableFactor::tableSize() const {
+    size_t n = 1;
+    for (Key j : keys_)
+      n *= cardinalities_.at(j);
+    return n;
+  }
+
+  /* ************************************************************************* */
+  double SparseTableFactor::density() const {
+    return double(nrEntries()) / double(tableSize());
+  }
+
+  /* ************************************************************************* */
+  DiscreteKeys SparseTableFactor::discreteKeys() const {
+    DiscreteKeys result;
+    for (Key j : keys_)
+      result.push_back(DiscreteKey(j, cardinalities_.at(j)));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  size_t SparseTableFactor::indexOf(const Values& values) const {
+    // First key varies slowest, matching the dense table layout
+    size_t index = 0;
+    for (Key j : keys_)
+      index = index * cardinalities_.at(j) + values.at(j);
+    return index;
+  }
+
+  /* ************************************************************************* */
+  DiscreteFactor::Values SparseTableFactor::assignmentOf(size_t index) const {
+    Values assignment;
+    for (KeyVector::const_reverse_iterator j = keys_.rbegin();
+        j != keys_.rend(); ++j) {
+      const size_t cardinality = cardinalities_.at(*j);
+      assignment[*j] = index % cardinality;
+      index /= cardinality;
+    }
+    return assignment;
+  }
+
+  /* ************************************************************************* */
+  double SparseTableFactor::operator()(const Values& values) const {
+    const size_t index = indexOf(values);
+    FastVector<Entry>::const_iterator item = lower_bound(entries_.begin(),
+        entries_.end(), Entry(index, 0.0), compareIndex);
+    return (item != entries_.end() && item->first == index) ? item->second : 0.0;
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor SparseTableFactor::toDecisionTreeFactor() const {
+    if (keys_.empty()) {
+      // Constant factor: a decision tree with a single leaf
+      const double value = entries_.empty() ? 0.0 : entries_.front().second;
+      return DecisionTreeFactor(DiscreteKeys(), Potentials::ADT(value));
+    }
+    vector<double> table(tableSize(), 0.0);
+    for (const Entry& entry : entries_)
+      table[entry.first] = entry.second;
+    return DecisionTreeFactor(discreteKeys(), table);
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor SparseTableFactor::operator*(
+      const DecisionTreeFactor& f) const {
+    if (f.keys().empty())
+      // Constant factor, e.g. the identity seeding a product chain
+      return toDecisionTreeFactor() * f;
+    return multiply(SparseTableFactor(f)).toDecisionTreeFactor();
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor SparseTableFactor::multiply(
+      const SparseTableFactor& f) const {
+    // Set up the result on the union of the keys, ours first
+    This result;
+    for (Key j : keys_) {
+      result.keys_.push_back(j);
+      result.cardinalities_[j] = cardinalities_.at(j);
+    }
+    for (Key j : f.keys_)
+      if (result.cardinalities_.count(j) == 0) {
+        result.keys_.push_back(j);
+        result.cardinalities_[j] = f.cardinalities_.at(j);
+      }
+
+    // Join the nonzeros: a product entry can only be nonzero where both
+    // factors are, so zero blocks are never touched
+    map<size_t, double> values;
+    for (const Entry& entry1 : entries_) {
+      const Values assignment1 = assignmentOf(entry1.first);
+      for (const Entry& entry2 : f.entries_) {
+        Values assignment2 = f.assignmentOf(entry2.first);
+        bool compatible = true;
+        for (Key j : keys_) {
+          Values::const_iterator item = assignment2.find(j);
+          if (item != assignment2.end() && item->second != assignment1.at(j)) {
+            compatible = false;
+            break;
+          }
+        }
+        if (!compatible)
+          continue;
+        assignment2.insert(assignment1.begin(), assignment1.end());
+        values[result.indexOf(assignment2)] = entry1.second * entry2.second;
+      }
+    }
+    result.entries_.assign(values.begin(), values.end());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::shared_ptr SparseTableFactor::eliminate(
+      const Ordering& keysToEliminate,
+      double (*op)(const double&, const double&)) const {
+    // Set up the result on the remaining keys
+    shared_ptr result = boost::make_shared<This>();
+    for (Key j : keys_)
+      if (std::find(keysToEliminate.begin(), keysToEliminate.end(), j)
+          == keysToEliminate.end()) {
+        result->keys_.push_back(j);
+        result->cardinalities_[j] = cardinalities_.at(j);
+      }
+
+    // Accumulate each nonzero into its projected assignment
+    map<size_t, double> values;
+    for (const Entry& entry : entries_) {
+      Values assignment = assignmentOf(entry.first);
+      for (Key j : keysToEliminate)
+        assignment.erase(j);
+      const size_t index = result->indexOf(assignment);
+      map<size_t, double>::iterator item = values.find(index);
+      if (item == values.end())
+        values[index] = entry.second;
+      else
+        item->second = op(item->second, entry.second);
+    }
+    result->entries_.assign(values.begin(), values.end());
+    return result;
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::shared_ptr SparseTableFactor::sum(
+      const Ordering& keysToSumOut) const {
+    return eliminate(keysToSumOut, &Potentials::ADT::Ring::add);
+  }
+
+  /* ************************************************************************* */
+  SparseTableFactor::shared_ptr SparseTableFactor::max(
+      const Ordering& keysToMaxOut) const {
+    return eliminate(keysToMaxOut, &Potentials::ADT::Ring::max);
+  }
+
+  /* ************************************************************************* */
+  DiscreteFactor::shared_ptr SparseTableFactor::Switch(
+      const DecisionTreeFactor& factor, double densityThreshold) {
+    shared_ptr sparse = boost::make_shared<This>(factor);
+    if (sparse->density() <= densityThreshold)
+      return sparse;
+    else
+      return boost::make_shared<DecisionTreeFactor>(factor);
+  }
+
+  /* ************************************************************************* */
+} // namespace gtsam
@@ -0,0 +1,161 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SparseTableFactor.h
+ * @brief Discrete factor storing only the nonzero potential entries
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/discrete/DecisionTreeFactor.h>
+#include <gtsam/discrete/DiscreteFactor.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * A discrete factor that stores its potential table as a sorted list of
+   * (index, value) pairs, keeping only the nonzero entries.  Data-association
+   * and other semantic-SLAM potentials are overwhelmingly sparse - most
+   * assignments are impossible - so products and marginalizations that walk
+   * only the nonzeros run in time linear in the number of nonzero entries
+   * instead of exponential in the number of variables.
+   *
+   * Indices follow the same layout as the dense table passed to
+   * DecisionTreeFactor: the first key varies slowest.  Use Switch() to pick
+   * the representation automatically by density.
+   */
+  class GTSAM_EXPORT SparseTableFactor: public DiscreteFactor {
+
+  public:
+
+    // typedefs needed to play nice with gtsam
+    typedef SparseTableFactor This;
+    typedef DiscreteFactor Base; ///< Typedef to base class
+    typedef boost::shared_ptr<SparseTableFactor> shared_ptr;
+
+    /// A single nonzero: flat table index and its potential value
+    typedef std::pair<size_t, double> Entry;
+
+  private:
+
+    /// Cardinality for each key, as in Potentials
+    std::map<Key, size_t> cardinalities_;
+
+    /// Nonzero entries, sorted by flat table index
+    FastVector<Entry> entries_;
+
+  public:
+
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor for I/O */
+    SparseTableFactor();
+
+    /** Constructor from keys and a dense table (first key varies slowest,
+     * as in DecisionTreeFactor); zero entries are dropped. */
+    SparseTableFactor(const DiscreteKeys& keys,
+        const std::vector<double>& table);
+
+    /** Convert from a dense DecisionTreeFactor, keeping only nonzeros */
+    explicit SparseTableFactor(const DecisionTreeFactor& factor);
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /// equality
+    virtual bool equals(const DiscreteFactor& other, double tol = 1e-9) const;
+
+    // print
+    virtual void print(const std::string& s = "SparseTableFactor:\n",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /// Value for given assignment, zero if not stored
+    virtual double operator()(const Values& values) const;
+
+    /// Multiply into a DecisionTreeFactor, done sparsely on our nonzeros
+    virtual DecisionTreeFactor operator*(const DecisionTreeFactor& f) const;
+
+    /// Expand to the equivalent dense factor
+    virtual DecisionTreeFactor toDecisionTreeFactor() const;
+
+    /// Multiply two sparse factors, O(nnz(this) * nnz(f))
+    SparseTableFactor multiply(const SparseTableFactor& f) const;
+
+    /// Sum out the given keys, walking only the nonzero entries
+    shared_ptr sum(const Ordering& keysToSumOut) const;
+
+    /// Maximize over the given keys, walking only the nonzero entries
+    shared_ptr max(const Ordering& keysToMaxOut) const;
+
+    /// @}
+    /// @name Advanced Interface
+    /// @{
+
+    /// Number of nonzero entries
+    size_t nrEntries() const { return entries_.size(); }
+
+    /// Full table size, the product of all cardinalities
+    size_t tableSize() const;
+
+    /// Fraction of table entries that are nonzero, in [0,1]
+    double density() const;
+
+    /// Cardinality of variable j
+    size_t cardinality(Key j) const { return cardinalities_.at(j); }
+
+    /// Keys with cardinalities, in factor key order
+    DiscreteKeys discreteKeys() const;
+
+    /// The sorted nonzero entries
+    const FastVector<Entry>& entries() const { return entries_; }
+
+    /// Flat table index of an assignment (first key varies slowest)
+    size_t indexOf(const Values& values) const;
+
+    /// Assignment corresponding to a flat table index
+    Values assignmentOf(size_t index) const;
+
+    /**
+     * Pick a representation by density: returns a SparseTableFactor if at
+     * most densityThreshold of the table is nonzero, and a plain
+     * DecisionTreeFactor copy otherwise.
+     */
+    static DiscreteFactor::shared_ptr Switch(const DecisionTreeFactor& factor,
+        double densityThreshold = 0.5);
+
+    /// @}
+
+  private:
+
+    /// Shared implementation of sum and max
+    shared_ptr eliminate(const Ordering& keysToEliminate,
+        double (*op)(const double&, const double&)) const;
+};
+// SparseTableFactor
+
+// traits
+template<> struct traits<SparseTableFactor> : public Testable<SparseTableFactor> {};
+
+}// namespace gtsam
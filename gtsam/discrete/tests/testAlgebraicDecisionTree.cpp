@@ -516,6 +516,28 @@ TEST(ADT, zero)
   EXPECT_DOUBLES_EQUAL(0, anotb(x11), 1e-9);
 }
 
+/* ************************************************************************* */
+// test hash-consed node interning: identical subtrees share one node
+TEST(ADT, interning)
+{
+  DiscreteKey A(0,2), B(1,2);
+
+  // Identical tables produce one shared tree
+  ADT f(A & B, "1 2 3 4");
+  ADT g(A & B, "1 2 3 4");
+  EXPECT(f.root_ == g.root_);
+
+  // Different tables do not alias
+  ADT h(A & B, "1 2 3 5");
+  EXPECT(f.root_ != h.root_);
+
+  // Products with identical operands share their whole result
+  ADT fg = f * g;
+  ADT gf = g * f;
+  EXPECT(fg.root_ == gf.root_);
+  EXPECT(fg.equals(gf));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
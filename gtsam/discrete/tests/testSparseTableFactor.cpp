@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * testSparseTableFactor.cpp
+ *
+ *  @date Aug 2018
+ *  @author Frank Dellaert
+ */
+
+#include <gtsam/discrete/SparseTableFactor.h>
+#include <gtsam/discrete/DiscreteFactorGraph.h>
+#include <gtsam/discrete/DiscreteConditional.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST( SparseTableFactor, constructors)
+{
+  DiscreteKey X(0,2), Y(1,3);
+
+  // Mostly zero table, only two nonzero entries survive
+  SparseTableFactor f1(X & Y, vector<double>{0, 2, 0, 0, 0, 5});
+  EXPECT_LONGS_EQUAL(2, f1.nrEntries());
+  EXPECT_LONGS_EQUAL(6, f1.tableSize());
+  EXPECT_DOUBLES_EQUAL(2.0/6.0, f1.density(), 1e-9);
+
+  // Lookups, including entries that are not stored
+  SparseTableFactor::Values values;
+  values[0] = 0; values[1] = 1; // x=0, y=1
+  EXPECT_DOUBLES_EQUAL(2, f1(values), 1e-9);
+  values[0] = 1; values[1] = 2; // x=1, y=2
+  EXPECT_DOUBLES_EQUAL(5, f1(values), 1e-9);
+  values[0] = 1; values[1] = 0; // zero entry
+  EXPECT_DOUBLES_EQUAL(0, f1(values), 1e-9);
+
+  // Round-trip through the dense representation
+  DecisionTreeFactor dense(X & Y, "0 2 0 0 0 5");
+  SparseTableFactor f2(dense);
+  EXPECT(assert_equal(f1, f2));
+  EXPECT(assert_equal(dense, f1.toDecisionTreeFactor()));
+}
+
+/* ************************************************************************* */
+TEST( SparseTableFactor, multiplication)
+{
+  DiscreteKey v0(0,2), v1(1,2), v2(2,2);
+
+  DecisionTreeFactor f1(v0 & v1, "1 0 3 4");
+  DecisionTreeFactor f2(v1 & v2, "5 0 7 8");
+
+  // Sparse product must agree with the dense one
+  DecisionTreeFactor expected = f1 * f2;
+  SparseTableFactor actual =
+      SparseTableFactor(f1).multiply(SparseTableFactor(f2));
+  EXPECT(assert_equal(expected, actual.toDecisionTreeFactor()));
+
+  // operator* against a dense factor takes the same path
+  EXPECT(assert_equal(expected, SparseTableFactor(f1) * f2));
+}
+
+/* ************************************************************************* */
+TEST( SparseTableFactor, sum_max)
+{
+  DiscreteKey v0(0,3), v1(1,2);
+
+  DecisionTreeFactor dense(v0 & v1, "1 0  3 4  0 6");
+  SparseTableFactor sparse(dense);
+
+  Ordering keysToEliminate; keysToEliminate += Key(0);
+  EXPECT(assert_equal(*dense.sum(keysToEliminate),
+      sparse.sum(keysToEliminate)->toDecisionTreeFactor()));
+  EXPECT(assert_equal(*dense.max(1),
+      sparse.max(keysToEliminate)->toDecisionTreeFactor()));
+}
+
+/* ************************************************************************* */
+TEST( SparseTableFactor, Switch)
+{
+  DiscreteKey X(0,2), Y(1,2);
+
+  // 1/4 nonzero: stays sparse
+  DecisionTreeFactor sparse(X & Y, "0 0 3 0");
+  DiscreteFactor::shared_ptr chosen = SparseTableFactor::Switch(sparse);
+  EXPECT(boost::dynamic_pointer_cast<SparseTableFactor>(chosen));
+
+  // 3/4 nonzero: stays dense
+  DecisionTreeFactor full(X & Y, "1 2 3 0");
+  chosen = SparseTableFactor::Switch(full);
+  EXPECT(boost::dynamic_pointer_cast<DecisionTreeFactor>(chosen));
+
+  // Either way the values are unchanged
+  EXPECT(assert_equal(full, chosen->toDecisionTreeFactor()));
+}
+
+/* ************************************************************************* */
+TEST( SparseTableFactor, EliminateDiscreteSparse)
+{
+  DiscreteKey A(0,2), B(1,2), C(2,2);
+
+  // A small sparse data-association-like graph
+  DiscreteFactorGraph graph;
+  graph.add(A & B, "1 0 0 3");
+  graph.add(B & C, "0 2 4 0");
+  graph.add(C, "1 2");
+
+  Ordering frontalKeys; frontalKeys += Key(0);
+  pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>
+      expected = EliminateDiscrete(graph, frontalKeys);
+  pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>
+      actual = EliminateDiscreteSparse(graph, frontalKeys);
+  EXPECT(assert_equal(*expected.first, *actual.first));
+  EXPECT(assert_equal(*expected.second, *actual.second));
+
+  // Full sequential elimination gives the same solution
+  DiscreteFactor::sharedValues mpe =
+      graph.eliminateSequential(EliminateDiscreteSparse)->optimize();
+  EXPECT(assert_equal(*graph.optimize(), *mpe));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -134,6 +134,34 @@ Point2 PinholeBase::project2(const Point3& point, OptionalJacobian<2, 6> Dpose,
   return pn;
 }
 
+/* ************************************************************************* */
+ProjectionContext::ProjectionContext(const Pose3& pose) :
+    Rt_(pose.rotation().transpose()), t_(pose.translation()) {
+}
+
+/* ************************************************************************* */
+Point2 PinholeBase::project2(const Point3& point,
+    const ProjectionContext& context, OptionalJacobian<2, 6> Dpose,
+    OptionalJacobian<2, 3> Dpoint) const {
+
+  // same as transformTo, but with the transposed rotation already cached
+  const Point3 q = context.Rt() * (point - context.translation());
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+  if (q.z() <= 0)
+    throw CheiralityException();
+#endif
+  const Point2 pn = Project(q);
+
+  if (Dpose || Dpoint) {
+    const double d = 1.0 / q.z();
+    if (Dpose)
+      *Dpose = PinholeBase::Dpose(pn, d);
+    if (Dpoint)
+      *Dpoint = PinholeBase::Dpoint(pn, d, context.Rt());
+  }
+  return pn;
+}
+
 /* ************************************************************************* */
 Point2 PinholeBase::project2(const Unit3& pw, OptionalJacobian<2, 6> Dpose,
     OptionalJacobian<2, 2> Dpoint) const {
@@ -49,6 +49,39 @@ private:
  * @addtogroup geometry
  * \nosubgrouping
  */
+/**
+ * A per-camera cache of the rotation-derived quantities needed to project a
+ * point: the transposed rotation matrix and the camera position.  During a
+ * single linearization pass one camera typically projects many landmarks,
+ * and recomputing the transpose (and, with quaternion rotations, the
+ * quaternion-to-matrix conversion) per projection is measurable.  Build the
+ * context once per camera per pass and hand it to the project2 overloads
+ * that accept it; any change to the camera pose invalidates the context.
+ * @addtogroup geometry
+ */
+class GTSAM_EXPORT ProjectionContext {
+
+private:
+
+  Matrix3 Rt_; ///< transpose of the world-to-camera rotation
+  Point3 t_; ///< camera position in world coordinates
+
+public:
+
+  /// Pre-compute the rotation-derived quantities of the given camera pose
+  explicit ProjectionContext(const Pose3& pose);
+
+  /// transposed rotation matrix
+  const Matrix3& Rt() const {
+    return Rt_;
+  }
+
+  /// camera position in world coordinates
+  const Point3& translation() const {
+    return t_;
+  }
+};
+
 class GTSAM_EXPORT PinholeBase {
 
 public:
@@ -199,6 +232,23 @@ public:
   Point2 project2(const Point3& point, OptionalJacobian<2, 6> Dpose =
       boost::none, OptionalJacobian<2, 3> Dpoint = boost::none) const;
 
+  /** Project point into the image, reusing pre-computed rotation quantities.
+   * Identical to project2 above for a context built from this camera's pose,
+   * but skips the per-projection rotation transpose; use it when projecting
+   * many points with the same camera.
+   * @param point 3D point in world coordinates
+   * @param context cached quantities, see projectionContext()
+   * @return the intrinsic coordinates of the projected point
+   */
+  Point2 project2(const Point3& point, const ProjectionContext& context,
+      OptionalJacobian<2, 6> Dpose = boost::none,
+      OptionalJacobian<2, 3> Dpoint = boost::none) const;
+
+  /// Pre-compute the per-camera quantities reused across many projections
+  ProjectionContext projectionContext() const {
+    return ProjectionContext(pose());
+  }
+
   /** Project point at infinity into the image
    * Throws a CheiralityException if point behind image plane iff GTSAM_THROW_CHEIRALITY_EXCEPTION
    * @param point 3D point in world coordinates
@@ -119,12 +119,10 @@ public:
     if (E) E->resize(ZDim * m, N);
     if (Fs) Fs->resize(m);
 
-    // Project and fill derivatives
+    // Project and fill derivatives, writing F blocks in place
     for (size_t i = 0; i < m; i++) {
-      MatrixZD Fi;
       Eigen::Matrix<double, ZDim, N> Ei;
-      z.emplace_back(this->at(i).project2(point, Fs ? &Fi : 0, E ? &Ei : 0));
-      if (Fs) (*Fs)[i] = Fi;
+      z.emplace_back(this->at(i).project2(point, Fs ? &(*Fs)[i] : 0, E ? &Ei : 0));
       if (E) E->block<ZDim, N>(ZDim * i, 0) = Ei;
     }
 
@@ -159,29 +157,41 @@ public:
     dims.back() = 1;
     SymmetricBlockMatrix augmentedHessian(dims, Matrix::Zero(M1, M1));
 
+    // Hoist the products shared by every block out of the camera loops:
+    // E'*b is O(m) to form and was recomputed for each camera, and each
+    // (NxD) product E_j'*F_j is needed by every block in column j.
+    // The precomputed blocks live in contiguous fixed-size arrays, so the
+    // loops below stream through them instead of re-reading E.
+    typedef Eigen::Matrix<double, ZDim, N> MatrixZN;
+    typedef Eigen::Matrix<double, N, D> MatrixND;
+    const Eigen::Matrix<double, N, 1> Etb = E.transpose() * b;
+    std::vector<MatrixZN, Eigen::aligned_allocator<MatrixZN> > E_P(m);
+    std::vector<MatrixND, Eigen::aligned_allocator<MatrixND> > EtF(m);
+    for (size_t j = 0; j < m; j++) {
+      const auto Ej = E.template block<ZDim, N>(ZDim * j, 0);
+      E_P[j].noalias() = Ej * P;
+      EtF[j].noalias() = Ej.transpose() * Fs[j];
+    }
+
     // Blockwise Schur complement
     for (size_t i = 0; i < m; i++) { // for each camera
 
       const MatrixZD& Fi = Fs[i];
       const auto FiT = Fi.transpose();
-      const Eigen::Matrix<double, ZDim, N> Ei_P = //
-          E.block(ZDim * i, 0, ZDim, N) * P;
+      const MatrixZN& Ei_P = E_P[i];
 
       // D = (Dx2) * ZDim
       augmentedHessian.setOffDiagonalBlock(i, m, FiT * b.segment<ZDim>(ZDim * i) // F' * b
-      - FiT * (Ei_P * (E.transpose() * b))); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
+      - FiT * (Ei_P * Etb)); // D = (DxZDim) * (ZDimxN) * (Nx1)
 
-      // (DxD) = (DxZDim) * ( (ZDimxD) - (ZDimx3) * (3xZDim) * (ZDimxD) )
-      augmentedHessian.setDiagonalBlock(i, FiT
-          * (Fi - Ei_P * E.block(ZDim * i, 0, ZDim, N).transpose() * Fi));
+      // (DxD) = (DxZDim) * ( (ZDimxD) - (ZDimxN) * (NxD) )
+      augmentedHessian.setDiagonalBlock(i, FiT * (Fi - Ei_P * EtF[i]));
 
       // upper triangular part of the hessian
       for (size_t j = i + 1; j < m; j++) { // for each camera
-        const MatrixZD& Fj = Fs[j];
 
-        // (DxD) = (Dx2) * ( (2x2) * (2xD) )
-        augmentedHessian.setOffDiagonalBlock(i, j, -FiT
-            * (Ei_P * E.block(ZDim * j, 0, ZDim, N).transpose() * Fj));
+        // (DxD) = (DxZDim) * ( (ZDimxN) * (NxD) )
+        augmentedHessian.setOffDiagonalBlock(i, j, -FiT * (Ei_P * EtF[j]));
       }
     } // end of for over cameras
 
@@ -264,13 +274,24 @@ public:
     size_t M = (augmentedHessian.rows() - 1) / D; // all cameras in the group
     assert(allKeys.size()==M);
 
+    // Hoist shared products out of the camera loops, as in SchurComplement
+    typedef Eigen::Matrix<double, ZDim, N> MatrixZN;
+    typedef Eigen::Matrix<double, N, D> MatrixND;
+    const Eigen::Matrix<double, N, 1> Etb = E.transpose() * b;
+    std::vector<MatrixZN, Eigen::aligned_allocator<MatrixZN> > E_P(m);
+    std::vector<MatrixND, Eigen::aligned_allocator<MatrixND> > EtF(m);
+    for (size_t j = 0; j < m; j++) {
+      const auto Ej = E.template block<ZDim, N>(ZDim * j, 0);
+      E_P[j].noalias() = Ej * P;
+      EtF[j].noalias() = Ej.transpose() * Fs[j];
+    }
+
     // Blockwise Schur complement
     for (size_t i = 0; i < m; i++) { // for each camera in the current factor
 
       const MatrixZD& Fi = Fs[i];
       const auto FiT = Fi.transpose();
-      const Eigen::Matrix<double, 2, N> Ei_P = E.template block<ZDim, N>(
-          ZDim * i, 0) * P;
+      const MatrixZN& Ei_P = E_P[i];
 
       // D = (DxZDim) * (ZDim)
       // allKeys are the list of all camera keys in the group, e.g, (1,3,4,5,7)
@@ -282,27 +303,26 @@ public:
       // vectorBlock = augmentedHessian(aug_i, aug_m).knownOffDiagonal();
       // add contribution of current factor
       augmentedHessian.updateOffDiagonalBlock(aug_i, M,
-          FiT * b.segment<ZDim>(ZDim * i)      // F' * b
-        - FiT * (Ei_P * (E.transpose() * b))); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
+          FiT * b.segment<ZDim>(ZDim * i) // F' * b
+        - FiT * (Ei_P * Etb)); // D = (DxZDim) * (ZDimxN) * (Nx1)
 
-      // (DxD) += (DxZDim) * ( (ZDimxD) - (ZDimx3) * (3xZDim) * (ZDimxD) )
+      // (DxD) += (DxZDim) * ( (ZDimxD) - (ZDimxN) * (NxD) )
       // add contribution of current factor
       // TODO(gareth): Eigen doesn't let us pass the expression. Call eval() for now...
       augmentedHessian.updateDiagonalBlock(aug_i,
-         ((FiT * (Fi - Ei_P * E.template block<ZDim, N>(ZDim * i, 0).transpose() * Fi))).eval());
+         (FiT * (Fi - Ei_P * EtF[i])).eval());
 
       // upper triangular part of the hessian
       for (size_t j = i + 1; j < m; j++) { // for each camera
-        const MatrixZD& Fj = Fs[j];
 
         DenseIndex aug_j = KeySlotMap.at(keys[j]);
 
-        // (DxD) = (DxZDim) * ( (ZDimxZDim) * (ZDimxD) )
+        // (DxD) = (DxZDim) * ( (ZDimxN) * (NxD) )
         // off diagonal block - store previous block
         // matrixBlock = augmentedHessian(aug_i, aug_j).knownOffDiagonal();
         // add contribution of current factor
         augmentedHessian.updateOffDiagonalBlock(aug_i, aug_j,
-                -FiT * (Ei_P * E.template block<ZDim, N>(ZDim * j, 0).transpose() * Fj));
+                -FiT * (Ei_P * EtF[j]));
       }
     } // end of for over cameras
 
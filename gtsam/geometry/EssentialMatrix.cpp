@@ -7,6 +7,7 @@
 
 #include <gtsam/geometry/EssentialMatrix.h>
 #include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -113,6 +114,16 @@ double EssentialMatrix::error(const Vector3& vA, const Vector3& vB, //
   return dot(vA, E_ * vB);
 }
 
+/* ************************************************************************* */
+Vector EssentialMatrix::errors(const Matrix& vAs, const Matrix& vBs) const {
+  if (vAs.rows() != 3 || vBs.rows() != 3 || vAs.cols() != vBs.cols())
+    throw invalid_argument(
+        "EssentialMatrix::errors: vAs and vBs must both be 3xN");
+
+  // One packed product E * vBs, then contract each column against vAs
+  return (vAs.cwiseProduct(E_ * vBs)).colwise().sum().transpose();
+}
+
 /* ************************************************************************* */
 ostream& operator <<(ostream& os, const EssentialMatrix& E) {
   Rot3 R = E.rotation();
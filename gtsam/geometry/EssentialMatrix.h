@@ -163,6 +163,17 @@ class EssentialMatrix {
   GTSAM_EXPORT double error(const Vector3& vA, const Vector3& vB,
       OptionalJacobian<1, 5> H = boost::none) const;
 
+  /**
+   * Algebraic epipolar errors for N correspondences at once, without
+   * Jacobians: result(i) = vAs.col(i)' * E * vBs.col(i).  The homogeneous
+   * coordinates are passed in structure-of-arrays form as 3xN matrices, so
+   * the evaluation is one packed 3x3 times 3xN product plus a column-wise
+   * contraction instead of N small expression chains.  This is the kernel
+   * behind high-throughput view-graph verification (see
+   * gtsam/sfm/ViewGraphFilter.h).
+   */
+  GTSAM_EXPORT Vector errors(const Matrix& vAs, const Matrix& vBs) const;
+
   /// @}
 
   /// @name Streaming operators
@@ -251,6 +251,21 @@ public:
     return _project2(pw, Dcamera, Dpoint);
   }
 
+  /** project a 3D point, reusing the rotation-derived quantities cached in a
+   *  per-camera ProjectionContext, see PinholeBase::projectionContext()
+   */
+  Point2 project2(const Point3& pw, const ProjectionContext& context,
+      OptionalJacobian<2, dimension> Dcamera = boost::none,
+      OptionalJacobian<2, 3> Dpoint = boost::none) const {
+    Matrix26 Dpose;
+    Eigen::Matrix<double, 2, DimK> Dcal;
+    Point2 pi = Base::_project(pw, context, Dcamera ? &Dpose : 0, Dpoint,
+        Dcamera ? &Dcal : 0);
+    if (Dcamera)
+      *Dcamera << Dpose, Dcal;
+    return pi;
+  }
+
   /**
    * Calculate range to a landmark
    * @param point 3D location of landmark
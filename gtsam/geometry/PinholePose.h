@@ -114,6 +114,32 @@ public:
     return pi;
   }
 
+  /** As _project, but reusing the rotation-derived quantities cached in a
+   *  per-camera ProjectionContext, see PinholeBase::projectionContext().
+   *  Only implemented for finite points: the point-at-infinity chain does
+   *  not use the quantities the context caches.
+   */
+  Point2 _project(const Point3& pw, const ProjectionContext& context,
+      OptionalJacobian<2, 6> Dpose, OptionalJacobian<2, 3> Dpoint,
+      OptionalJacobian<2, DimK> Dcal) const {
+
+    // project to normalized coordinates
+    const Point2 pn = PinholeBase::project2(pw, context, Dpose, Dpoint);
+
+    // uncalibrate to pixel coordinates
+    Matrix2 Dpi_pn;
+    const Point2 pi = calibration().uncalibrate(pn, Dcal,
+        Dpose || Dpoint ? &Dpi_pn : 0);
+
+    // If needed, apply chain rule
+    if (Dpose)
+    *Dpose = Dpi_pn * *Dpose;
+    if (Dpoint)
+    *Dpoint = Dpi_pn * *Dpoint;
+
+    return pi;
+  }
+
   /// project a 3D point from world coordinates into the image
   Point2 project(const Point3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 3> Dpoint = boost::none,
@@ -121,6 +147,14 @@ public:
     return _project(pw, Dpose, Dpoint, Dcal);
   }
 
+  /// project a 3D point, reusing pre-computed rotation quantities
+  Point2 project(const Point3& pw, const ProjectionContext& context,
+      OptionalJacobian<2, 6> Dpose = boost::none,
+      OptionalJacobian<2, 3> Dpoint = boost::none,
+      OptionalJacobian<2, DimK> Dcal = boost::none) const {
+    return _project(pw, context, Dpose, Dpoint, Dcal);
+  }
+
   /// project a point at infinity from world coordinates into the image
   Point2 project(const Unit3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none,
@@ -375,6 +409,13 @@ public:
     return Base::project(pw, Dpose, Dpoint);
   }
 
+  /// project2 version reusing pre-computed rotation quantities
+  Point2 project2(const Point3& pw, const ProjectionContext& context,
+      OptionalJacobian<2, 6> Dpose = boost::none,
+      OptionalJacobian<2, 3> Dpoint = boost::none) const {
+    return Base::project(pw, context, Dpose, Dpoint);
+  }
+
   /// project2 version for point at infinity
   Point2 project2(const Unit3& pw, OptionalJacobian<2, 6> Dpose = boost::none,
       OptionalJacobian<2, 2> Dpoint = boost::none) const {
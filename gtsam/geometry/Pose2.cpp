@@ -285,6 +285,59 @@ double Pose2::range(const Pose2& pose,
   return r;
 }
 
+/* ************************************************************************* */
+// Fused bearing/range prediction, see declaration in Pose2.h.  The relative
+// position q and its Jacobians are the shared subexpression: bearing and
+// range are both functions of q alone, so each Jacobian is a 1x2 row times
+// the Jacobians of q.
+template <>
+BearingRange<Pose2, Point2> BearingRange<Pose2, Point2>::Measure(
+    const Pose2& pose, const Point2& point, OptionalJacobian<2, 3> H1,
+    OptionalJacobian<2, 2> H2) {
+  if (!H1 && !H2) {
+    const Point2 q = pose.transformTo(point);
+    return BearingRange(Rot2::relativeBearing(q), q.norm());
+  }
+
+  Matrix23 D_q_pose;
+  Matrix2 D_q_point;
+  const Point2 q = pose.transformTo(point, D_q_pose, D_q_point);
+
+  Matrix12 D_b_q, D_r_q;
+  const Rot2 b = Rot2::relativeBearing(q, D_b_q);
+  const double r = norm2(q, D_r_q);
+
+  if (H1) *H1 << D_b_q * D_q_pose, D_r_q * D_q_pose;
+  if (H2) *H2 << D_b_q * D_q_point, D_r_q * D_q_point;
+  return BearingRange(b, r);
+}
+
+/* ************************************************************************* */
+template <>
+BearingRange<Pose2, Pose2> BearingRange<Pose2, Pose2>::Measure(
+    const Pose2& pose, const Pose2& other, OptionalJacobian<2, 3> H1,
+    OptionalJacobian<2, 3> H2) {
+  if (!H1 && !H2) {
+    const Point2 q = pose.transformTo(other.t());
+    return BearingRange(Rot2::relativeBearing(q), q.norm());
+  }
+
+  Matrix23 D_q_pose;
+  Matrix2 D_q_point;
+  const Point2 q = pose.transformTo(other.t(), D_q_pose, D_q_point);
+
+  Matrix12 D_b_q, D_r_q;
+  const Rot2 b = Rot2::relativeBearing(q, D_b_q);
+  const double r = norm2(q, D_r_q);
+
+  // Neither measurement depends on the other pose's heading
+  const Matrix2 D_q_other = D_q_point * other.r().matrix();
+
+  if (H1) *H1 << D_b_q * D_q_pose, D_r_q * D_q_pose;
+  if (H2) *H2 << D_b_q * D_q_other, 0.0, D_r_q * D_q_other, 0.0;
+  return BearingRange(b, r);
+}
+
 /* *************************************************************************
  * New explanation, from scan.ml
  * It finds the angle using a linear method:
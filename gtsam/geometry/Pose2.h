@@ -347,5 +347,19 @@ struct Bearing<Pose2, T> : HasBearing<Pose2, T, Rot2> {};
 template <typename T>
 struct Range<Pose2, T> : HasRange<Pose2, T, double> {};
 
+// Hand-fused bearing/range predictions: the generic Measure evaluates the
+// Bearing and Range functors separately, computing the relative position and
+// its Jacobians twice.  These specializations compute the target in the pose
+// frame once and derive both measurements and their Jacobians from it.
+template <>
+GTSAM_EXPORT BearingRange<Pose2, Point2> BearingRange<Pose2, Point2>::Measure(
+    const Pose2& pose, const Point2& point, OptionalJacobian<2, 3> H1,
+    OptionalJacobian<2, 2> H2);
+
+template <>
+GTSAM_EXPORT BearingRange<Pose2, Pose2> BearingRange<Pose2, Pose2>::Measure(
+    const Pose2& pose, const Pose2& other, OptionalJacobian<2, 3> H1,
+    OptionalJacobian<2, 3> H2);
+
 } // namespace gtsam
 
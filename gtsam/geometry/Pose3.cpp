@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <stdexcept>
 
 using namespace std;
 
@@ -122,16 +123,27 @@ Pose3 Pose3::Expmap(const Vector6& xi, OptionalJacobian<6, 6> H) {
   // get angular velocity omega and translational velocity v from twist xi
   Vector3 omega(xi(0), xi(1), xi(2)), v(xi(3), xi(4), xi(5));
 
-  Rot3 R = Rot3::Expmap(omega);
   double theta2 = omega.dot(omega);
-  if (theta2 > std::numeric_limits<double>::epsilon()) {
-    Vector3 t_parallel = omega * omega.dot(v); // translation parallel to axis
-    Vector3 omega_cross_v = omega.cross(v);    // points towards axis
-    Vector3 t = (omega_cross_v - R * omega_cross_v + t_parallel) / theta2;
-    return Pose3(R, t);
-  } else {
-    return Pose3(R, v);
+  if (theta2 < 1e-8) {
+    // Small-angle tier, branch-predictable and free of trigonometry:
+    // second-order Taylor expansions of the sin/cos coefficients.  For
+    // theta^2 < 1e-8 the first neglected terms are theta^4/120 (rotation)
+    // and theta^4/5040 (translation), both below 1e-18 and hence under
+    // double rounding noise, so this tier is exact to machine precision.
+    const Matrix3 W = skewSymmetric(omega);
+    const Matrix3 R = I_3x3 + (1.0 - theta2 / 6.0) * W
+        + (0.5 - theta2 / 24.0) * (W * W);
+    const Vector3 omega_cross_v = omega.cross(v);
+    const Vector3 t = v + (0.5 - theta2 / 24.0) * omega_cross_v
+        + (1.0 / 6.0 - theta2 / 120.0) * omega.cross(omega_cross_v);
+    return Pose3(Rot3(R), t);
   }
+
+  Rot3 R = Rot3::Expmap(omega);
+  Vector3 t_parallel = omega * omega.dot(v); // translation parallel to axis
+  Vector3 omega_cross_v = omega.cross(v);    // points towards axis
+  Vector3 t = (omega_cross_v - R * omega_cross_v + t_parallel) / theta2;
+  return Pose3(R, t);
 }
 
 /* ************************************************************************* */
@@ -139,12 +151,18 @@ Vector6 Pose3::Logmap(const Pose3& p, OptionalJacobian<6, 6> H) {
   if (H) *H = LogmapDerivative(p);
   const Vector3 w = Rot3::Logmap(p.rotation());
   const Vector3 T = p.translation();
-  const double t = w.norm();
-  if (t < 1e-10) {
+  const double t2 = w.dot(w);
+  if (t2 < 1e-8) {
+    // Small-angle tier: 1 - t/(2 tan(t/2)) = t^2/12 + t^4/720 + O(t^6), so
+    // for t^2 < 1e-8 the neglected term is below 1e-24 and the polynomial
+    // matches the tangent-based formula to machine precision.
+    const Vector3 wT = w.cross(T);
+    const Vector3 u = T - 0.5 * wT + (1.0 / 12.0 + t2 / 720.0) * w.cross(wT);
     Vector6 log;
-    log << w, T;
+    log << w, u;
     return log;
   } else {
+    const double t = std::sqrt(t2);
     const Matrix3 W = skewSymmetric(w / t);
     // Formula from Agrawal06iros, equation (14)
     // simplified with Mathematica, and multiplying in T to avoid matrix math
@@ -189,6 +207,18 @@ Vector6 Pose3::ChartAtOrigin::Local(const Pose3& T, ChartJacobian H) {
 #endif
 }
 
+/* ************************************************************************* */
+std::vector<Pose3> Pose3::RetractBatch(const std::vector<Pose3>& poses,
+    const std::vector<Vector6, Eigen::aligned_allocator<Vector6> >& xis) {
+  if (poses.size() != xis.size())
+    throw std::invalid_argument("Pose3::RetractBatch: array sizes differ");
+  std::vector<Pose3> result;
+  result.reserve(poses.size());
+  for (size_t i = 0; i < poses.size(); ++i)
+    result.push_back(poses[i].retract(xis[i]));
+  return result;
+}
+
 /* ************************************************************************* */
 /**
  * Compute the 3x3 bottom-left block Q of the SE3 Expmap derivative matrix
@@ -343,6 +373,19 @@ Point3 Pose3::transformTo(const Point3& p, OptionalJacobian<3,6> Dpose,
   return q;
 }
 
+/* ************************************************************************* */
+Matrix3X Pose3::transformFrom(const Matrix3X& points) const {
+  // Get the matrix once and let Eigen vectorize the product over all columns
+  const Matrix3 R = R_.matrix();
+  return (R * points).colwise() + t_;
+}
+
+/* ************************************************************************* */
+Matrix3X Pose3::transformTo(const Matrix3X& points) const {
+  const Matrix3 Rt = R_.transpose();
+  return Rt * (points.colwise() - t_);
+}
+
 /* ************************************************************************* */
 double Pose3::range(const Point3& point, OptionalJacobian<1, 6> H1,
                     OptionalJacobian<1, 3> H2) const {
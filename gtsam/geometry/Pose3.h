@@ -24,6 +24,8 @@
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/base/Lie.h>
 
+#include <vector>
+
 namespace gtsam {
 
 class Pose2;
@@ -122,6 +124,17 @@ public:
   /// Log map at identity - return the canonical coordinates \f$ [R_x,R_y,R_z,T_x,T_y,T_z] \f$ of this rotation
   static Vector6 Logmap(const Pose3& p, OptionalJacobian<6, 6> H = boost::none);
 
+  /**
+   * Apply retract to a whole array of poses in one pass.  Equivalent to
+   * calling retract on each pose with the corresponding tangent vector, but
+   * keeps the hot loop free of per-call overhead; with GTSAM_POSE3_EXPMAP
+   * the small-angle tier of Expmap makes this trigonometry-free for the
+   * tiny updates typical of late optimizer iterations.
+   * @throws std::invalid_argument if the array sizes differ.
+   */
+  static std::vector<Pose3> RetractBatch(const std::vector<Pose3>& poses,
+      const std::vector<Vector6, Eigen::aligned_allocator<Vector6> >& xis);
+
   /**
    * Calculate Adjoint map, transforming a twist in the this pose's (i.e, body) frame to the world spatial frame
    * Ad_pose is 6*6 matrix that when applied to twist xi \f$ [R_x,R_y,R_z,T_x,T_y,T_z] \f$, returns Ad_pose(xi)
@@ -224,6 +237,23 @@ public:
   Point3 transformTo(const Point3& p, OptionalJacobian<3, 6> Dpose =
       boost::none, OptionalJacobian<3, 3> Dpoint = boost::none) const;
 
+  /**
+   * @brief transform many points in Pose coordinates to world coordinates
+   * @param points 3*N matrix with one point per column, in Pose coordinates
+   * @return 3*N matrix of the same points in world coordinates
+   * Vectorized over all columns, much faster than calling the single-point
+   * overload in a loop when transforming large point clouds.
+   */
+  Matrix3X transformFrom(const Matrix3X& points) const;
+
+  /**
+   * @brief transform many points in world coordinates to Pose coordinates
+   * @param points 3*N matrix with one point per column, in world coordinates
+   * @return 3*N matrix of the same points in Pose coordinates
+   * Vectorized over all columns, see transformFrom above.
+   */
+  Matrix3X transformTo(const Matrix3X& points) const;
+
   /// @}
   /// @name Standard Interface
   /// @{
@@ -227,6 +227,59 @@ Rot3 Rot3::slerp(double t, const Rot3& other) const {
   return interpolate(*this, other, t);
 }
 
+/* ************************************************************************* */
+void Rot3::BatchCompose(const std::vector<Rot3>& R1,
+    const std::vector<Rot3>& R2, std::vector<Rot3>* result) {
+  if (R1.size() != R2.size())
+    throw invalid_argument("Rot3::BatchCompose called with mismatched sizes");
+  const size_t n = R1.size();
+
+  // Gather the quaternion coefficients into structure-of-arrays form.  With
+  // GTSAM_USE_QUATERNIONS toQuaternion() just copies the stored coefficients.
+  Eigen::ArrayXd w1(n), x1(n), y1(n), z1(n), w2(n), x2(n), y2(n), z2(n);
+  for (size_t i = 0; i < n; ++i) {
+    const gtsam::Quaternion q1 = R1[i].toQuaternion(), q2 = R2[i].toQuaternion();
+    w1[i] = q1.w(); x1[i] = q1.x(); y1[i] = q1.y(); z1[i] = q1.z();
+    w2[i] = q2.w(); x2[i] = q2.x(); y2[i] = q2.y(); z2[i] = q2.z();
+  }
+
+  // Each Hamilton product component is one packed array expression, so the
+  // arithmetic runs over full SIMD lanes rather than one quaternion at a time
+  const Eigen::ArrayXd w = w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2;
+  const Eigen::ArrayXd x = w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2;
+  const Eigen::ArrayXd y = w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2;
+  const Eigen::ArrayXd z = w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2;
+
+  result->resize(n);
+  for (size_t i = 0; i < n; ++i)
+    (*result)[i] = Rot3(w[i], x[i], y[i], z[i]);
+}
+
+/* ************************************************************************* */
+Matrix Rot3::BatchRotate(const Rot3& R, const Matrix& points) {
+  if (points.rows() != 3)
+    throw invalid_argument("Rot3::BatchRotate expects points as a 3xN matrix");
+  return R.matrix() * points;
+}
+
+/* ************************************************************************* */
+void Rot3::BatchNormalize(std::vector<Rot3>* rotations) {
+  const size_t n = rotations->size();
+
+  Eigen::ArrayXd w(n), x(n), y(n), z(n);
+  for (size_t i = 0; i < n; ++i) {
+    const gtsam::Quaternion q = (*rotations)[i].toQuaternion();
+    w[i] = q.w(); x[i] = q.x(); y[i] = q.y(); z[i] = q.z();
+  }
+
+  const Eigen::ArrayXd scale =
+      (w * w + x * x + y * y + z * z).sqrt().inverse();
+  w *= scale; x *= scale; y *= scale; z *= scale;
+
+  for (size_t i = 0; i < n; ++i)
+    (*rotations)[i] = Rot3(w[i], x[i], y[i], z[i]);
+}
+
 /* ************************************************************************* */
 
 } // namespace gtsam
@@ -28,6 +28,8 @@
 #include <gtsam/base/concepts.h>
 #include <gtsam/config.h> // Get GTSAM_USE_QUATERNIONS macro
 
+#include <vector>
+
 // You can override the default coordinate mode using this flag
 #ifndef ROT3_DEFAULT_COORDINATES_MODE
   #ifdef GTSAM_USE_QUATERNIONS
@@ -465,6 +467,32 @@ namespace gtsam {
      */
     Vector quaternion() const;
 
+    /**
+     * Compose N pairs of rotations at once: result[i] = R1[i] * R2[i].
+     * The quaternion coefficients are gathered into structure-of-arrays form
+     * so each component of the quaternion product is one packed array
+     * expression that Eigen vectorizes across the available SIMD lanes,
+     * instead of N scalar quaternion products.  Intended for dense pose-chain
+     * operations such as trajectory smoothing.  Both inputs must have the
+     * same size; \c result may alias either input.
+     */
+    static void BatchCompose(const std::vector<Rot3>& R1,
+        const std::vector<Rot3>& R2, std::vector<Rot3>* result);
+
+    /**
+     * Rotate N points, stored as the columns of a 3xN matrix, by a single
+     * rotation, returning the rotated points in the same layout.  Evaluates
+     * as one dense 3x3 times 3xN product, which Eigen vectorizes.
+     */
+    static Matrix BatchRotate(const Rot3& R, const Matrix& points);
+
+    /**
+     * Renormalize N rotations in place using packed quaternion
+     * normalization, countering the drift accumulated by long compose
+     * chains.
+     */
+    static void BatchNormalize(std::vector<Rot3>* rotations);
+
     /**
      * @brief Spherical Linear intERPolation between *this and other
      * @param s a value between 0 and 1
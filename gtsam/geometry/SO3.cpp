@@ -23,6 +23,7 @@
 
 #include <Eigen/SVD>
 
+#include <cassert>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -130,6 +131,44 @@ Vector3 DexpFunctor::applyInvDexp(const Vector3& v, OptionalJacobian<3, 3> H1,
   return c;
 }
 
+GTSAM_EXPORT void ExpmapBatch(const Matrix& omegas, std::vector<SO3>* Rs,
+                              std::vector<Matrix3>* dexps) {
+  assert(omegas.rows() == 3);
+  assert(Rs != nullptr);
+  const DenseIndex N = omegas.cols();
+  Rs->resize(N);
+  if (dexps) dexps->resize(N);
+
+  // Structure-of-arrays phase: evaluate all trig over the batch at once, so
+  // Eigen can use vectorized math instead of one libm call per rotation
+  const Eigen::ArrayXd theta2 = omegas.colwise().squaredNorm().transpose();
+  const Eigen::ArrayXd theta = theta2.sqrt();
+  const Eigen::ArrayXd sin_theta = theta.sin();
+  const Eigen::ArrayXd s2 = (theta / 2.0).sin();
+  // numerically better than [1 - cos(theta)], as in ExpmapFunctor::init
+  const Eigen::ArrayXd one_minus_cos = 2.0 * s2.square();
+
+  // Assembly phase: per-column 3*3 products on the precomputed scalars
+  for (DenseIndex i = 0; i < N; ++i) {
+    const double wx = omegas(0, i), wy = omegas(1, i), wz = omegas(2, i);
+    Matrix3 W;
+    W << 0.0, -wz, +wy, +wz, 0.0, -wx, -wy, +wx, 0.0;
+    if (theta2(i) <= std::numeric_limits<double>::epsilon()) {
+      (*Rs)[i] = SO3(I_3x3 + W);
+      if (dexps) (*dexps)[i] = I_3x3 - 0.5 * W;
+    } else {
+      const Matrix3 K = W / theta(i);
+      const Matrix3 KK = K * K;
+      (*Rs)[i] = SO3(I_3x3 + sin_theta(i) * K + one_minus_cos(i) * KK);
+      if (dexps) {
+        const double a = one_minus_cos(i) / theta(i);
+        const double b = 1.0 - sin_theta(i) / theta(i);
+        (*dexps)[i] = I_3x3 - a * K + b * KK;
+      }
+    }
+  }
+}
+
 }  // namespace so3
 
 //******************************************************************************
@@ -126,6 +126,19 @@ GTSAM_EXPORT Matrix3 compose(const Matrix3& M, const SO3& R,
 /// (constant) Jacobian of compose wrpt M
 GTSAM_EXPORT Matrix99 Dcompose(const SO3& R);
 
+/**
+ * Batched exponential map: compute Expmap and (optionally) ExpmapDerivative
+ * for N rotation vectors at once.  The rotation vectors are the columns of
+ * the 3*N matrix \c omegas; Rs and, if non-null, dexps are resized to N
+ * entries.  The per-rotation trig is hoisted into array expressions over the
+ * whole batch, which Eigen evaluates with vectorized math, so callers that
+ * integrate many small rotations (e.g. high-rate gyro samples) are no longer
+ * trig-bound.  Results are identical to calling SO3::Expmap and
+ * SO3::ExpmapDerivative per column.
+ */
+GTSAM_EXPORT void ExpmapBatch(const Matrix& omegas, std::vector<SO3>* Rs,
+                              std::vector<Matrix3>* dexps = nullptr);
+
 // Below are two functors that allow for saving computation when exponential map
 // and its derivatives are needed at the same location in so<3>. The second
 // functor also implements dedicated methods to apply dexp and/or inv(dexp).
@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file  Sim3.cpp
+ * @brief 3D similarity transform
+ */
+
+#include <gtsam/geometry/Sim3.h>
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam {
+
+/** instantiate concept checks */
+GTSAM_CONCEPT_LIE_INST(Sim3)
+
+/* ************************************************************************* */
+namespace {
+
+/**
+ * The translation part of the Sim(3) exponential is t = W(omega, lambda) u,
+ * with W = int_0^1 exp(alpha lambda) exp(alpha Omega) d alpha
+ *        = A Omega + B Omega^2 + C I   (Strasdat10rss).
+ * All three coefficients are evaluated with cancellation-free forms:
+ * expm1 and 2 sin^2(theta/2) in the general tier, Taylor expansions in the
+ * small-angle and small-scale tiers.  The tier boundaries (1e-3 for theta,
+ * 1e-2 for lambda) are chosen where the truncation error of the expansions
+ * meets the round-off of the closed forms, keeping W within a few ulp of
+ * exact everywhere.
+ */
+Matrix3 similarityW(const Vector3& omega, double lambda) {
+  const double theta2 = omega.squaredNorm();
+  const double theta = sqrt(theta2);
+  const Matrix3 Omega = skewSymmetric(omega);
+
+  // C = (e^lambda - 1)/lambda, stable via expm1 for any nonzero lambda
+  const double C = (lambda == 0.0) ? 1.0 : std::expm1(lambda) / lambda;
+
+  double A, B;
+  if (theta < 1e-3) {
+    // Small-angle tier: Taylor in theta with lambda kept (nearly) exact.
+    // A multiplies Omega (norm theta), so its theta^2 correction matters;
+    // B multiplies Omega^2 (norm theta^2), so its theta^2 term is below
+    // rounding and is dropped.
+    double A0, B0;
+    if (fabs(lambda) < 1e-2) {
+      A0 = 0.5 + lambda / 3.0 + lambda * lambda / 8.0
+          + lambda * lambda * lambda / 30.0;
+      B0 = 1.0 / 6.0 + lambda / 8.0 + lambda * lambda / 20.0;
+    } else {
+      const double l2 = lambda * lambda, es = exp(lambda);
+      A0 = ((lambda - 1.0) * es + 1.0) / l2;
+      B0 = (es * (0.5 * l2 - lambda + 1.0) - 1.0) / (l2 * lambda);
+    }
+    // D3 = int_0^1 alpha^3 e^(alpha lambda), needed only to O(theta^2)
+    const double D3 = (fabs(lambda) < 1.0) ?
+        (0.25 + lambda / 5.0 + lambda * lambda / 12.0) :
+        (exp(lambda) * (lambda * lambda * lambda - 3.0 * lambda * lambda
+            + 6.0 * lambda - 6.0) + 6.0)
+            / (lambda * lambda * lambda * lambda);
+    A = A0 - theta2 / 6.0 * D3;
+    B = B0;
+  } else {
+    const double es = exp(lambda);
+    const double a = es * sin(theta);
+    const double halfSin = sin(0.5 * theta);
+    // N = 1 - e^lambda cos(theta), written without cancellation
+    const double N = 2.0 * halfSin * halfSin
+        - cos(theta) * std::expm1(lambda);
+    const double c = theta2 + lambda * lambda;
+    A = (a * lambda + N * theta) / (theta * c);
+    B = (C - (a * theta - N * lambda) / c) / theta2;
+  }
+  return A * Omega + B * Omega * Omega + C * I_3x3;
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void Sim3::print(const string& s) const {
+  cout << s;
+  R_.print("R:\n");
+  cout << '[' << t_.x() << ", " << t_.y() << ", " << t_.z() << "]';"
+      << " s: " << s_ << endl;
+}
+
+/* ************************************************************************* */
+bool Sim3::equals(const Sim3& other, double tol) const {
+  return R_.equals(other.R_, tol)
+      && traits<Point3>::Equals(t_, other.t_, tol)
+      && fabs(s_ - other.s_) < tol;
+}
+
+/* ************************************************************************* */
+Sim3 Sim3::inverse() const {
+  const Rot3 Rt = R_.inverse();
+  const double sinv = 1.0 / s_;
+  return Sim3(Rt, Point3(-sinv * (Rt * t_)), sinv);
+}
+
+/* ************************************************************************* */
+Sim3 Sim3::Expmap(const Vector7& xi, OptionalJacobian<7, 7> Hxi) {
+  if (Hxi) *Hxi = ExpmapDerivative(xi);
+  const Vector3 omega = xi.head<3>(), u = xi.segment<3>(3);
+  const double lambda = xi(6);
+  return Sim3(Rot3::Expmap(omega), Point3(similarityW(omega, lambda) * u),
+      exp(lambda));
+}
+
+/* ************************************************************************* */
+Vector7 Sim3::Logmap(const Sim3& g, OptionalJacobian<7, 7> Hg) {
+  const Vector3 omega = Rot3::Logmap(g.rotation());
+  const double lambda = log(g.scale());
+  const Vector3 t = g.translation();
+  // W is invertible wherever Logmap is defined (C > 0), solve for u
+  const Vector3 u = similarityW(omega, lambda).lu().solve(t);
+  Vector7 xi;
+  xi << omega, u, lambda;
+  if (Hg) *Hg = LogmapDerivative(g);
+  return xi;
+}
+
+/* ************************************************************************* */
+Matrix7 Sim3::AdjointMap() const {
+  const Matrix3 R = R_.matrix();
+  const Vector3 t(t_);
+  Matrix7 adj = Matrix7::Zero();
+  adj.block<3, 3>(0, 0) = R;
+  adj.block<3, 3>(3, 0) = skewSymmetric(t) * R;
+  adj.block<3, 3>(3, 3) = s_ * R;
+  adj.block<3, 1>(3, 6) = -t;
+  adj(6, 6) = 1.0;
+  return adj;
+}
+
+/* ************************************************************************* */
+Matrix7 Sim3::adjointMap(const Vector7& xi) {
+  const Vector3 omega = xi.head<3>(), u = xi.segment<3>(3);
+  const double lambda = xi(6);
+  Matrix7 ad = Matrix7::Zero();
+  ad.block<3, 3>(0, 0) = skewSymmetric(omega);
+  ad.block<3, 3>(3, 0) = skewSymmetric(u);
+  ad.block<3, 3>(3, 3) = skewSymmetric(omega) + lambda * I_3x3;
+  ad.block<3, 1>(3, 6) = -u;
+  return ad;
+}
+
+/* ************************************************************************* */
+Matrix7 Sim3::ExpmapDerivative(const Vector7& xi) {
+  // Right Jacobian Jr(xi) = sum_k (-ad(xi))^k / (k+1)!.  The series is
+  // entire, so it converges for any xi; terms decay factorially and for the
+  // tangent magnitudes seen in optimization a handful of terms reach
+  // machine precision.
+  const Matrix7 negAd = -adjointMap(xi);
+  Matrix7 J = Matrix7::Identity();
+  Matrix7 term = Matrix7::Identity();
+  for (int k = 1; k < 30; ++k) {
+    term = term * negAd / double(k + 1);
+    J += term;
+    if (term.lpNorm<Eigen::Infinity>() < 1e-17)
+      break;
+  }
+  return J;
+}
+
+/* ************************************************************************* */
+Matrix7 Sim3::LogmapDerivative(const Sim3& g) {
+  const Vector7 xi = Logmap(g);
+  return ExpmapDerivative(xi).inverse();
+}
+
+/* ************************************************************************* */
+Sim3 Sim3::ChartAtOrigin::Retract(const Vector7& xi, ChartJacobian Hxi) {
+  return Expmap(xi, Hxi);
+}
+
+/* ************************************************************************* */
+Vector7 Sim3::ChartAtOrigin::Local(const Sim3& g, ChartJacobian Hg) {
+  return Logmap(g, Hg);
+}
+
+/* ************************************************************************* */
+Point3 Sim3::transformFrom(const Point3& p, OptionalJacobian<3, 7> Hself,
+    OptionalJacobian<3, 3> Hpoint) const {
+  const Matrix3 sR = s_ * R_.matrix();
+  if (Hself) {
+    Hself->leftCols<3>() = -sR * skewSymmetric(p);
+    Hself->middleCols<3>(3) = sR;
+    Hself->rightCols<1>() = sR * Vector3(p);
+  }
+  if (Hpoint) *Hpoint = sR;
+  return Point3(sR * Vector3(p) + Vector3(t_));
+}
+
+/* ************************************************************************* */
+Matrix4 Sim3::matrix() const {
+  Matrix4 T = Matrix4::Identity();
+  T.topLeftCorner<3, 3>() = s_ * R_.matrix();
+  T.topRightCorner<3, 1>() = Vector3(t_);
+  return T;
+}
+
+/* ************************************************************************* */
+} // namespace gtsam
@@ -0,0 +1,165 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Sim3.h
+ * @brief  3D similarity transform (rotation, translation and scale), the
+ *         Sim(3) Lie group used for scale-drift-aware monocular loop closing
+ * @author Frank Dellaert
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/base/Lie.h>
+
+namespace gtsam {
+
+/**
+ * A 3D similarity transform, acting on points as p' = s * R * p + t.  The
+ * 7-dimensional tangent space is ordered [omega, u, lambda] - rotation rate,
+ * translation rate and log-scale rate - with the exponential coordinates of
+ * Strasdat10rss, so pure scale drift is the single coordinate lambda.
+ * Expmap, Logmap and AdjointMap are closed-form with small-angle and
+ * small-scale tiers, giving Sim(3) pose graphs the same per-factor cost as
+ * the Pose3 path.
+ * @addtogroup geometry
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT Sim3: public LieGroup<Sim3, 7> {
+private:
+
+  Rot3 R_;    ///< Rotation
+  Point3 t_;  ///< Translation
+  double s_;  ///< Scale
+
+public:
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Default constructor is the identity */
+  Sim3() : t_(0.0, 0.0, 0.0), s_(1.0) {}
+
+  /** Construct from rotation, translation and scale */
+  Sim3(const Rot3& R, const Point3& t, double s) : R_(R), t_(t), s_(s) {}
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /** print with optional string */
+  void print(const std::string& s = "") const;
+
+  /** assert equality up to a tolerance */
+  bool equals(const Sim3& other, double tol = 1e-9) const;
+
+  /// @}
+  /// @name Group
+  /// @{
+
+  /// identity for group operation
+  static Sim3 identity() { return Sim3(); }
+
+  /// composition: this * T
+  Sim3 operator*(const Sim3& T) const {
+    return Sim3(R_ * T.R_, t_ + s_ * (R_ * T.t_), s_ * T.s_);
+  }
+
+  /// inverse transformation
+  Sim3 inverse() const;
+
+  /// @}
+  /// @name Lie Group
+  /// @{
+
+  /**
+   * Exponential map at identity: rotation, translation and scale of the
+   * similarity from canonical coordinates \f$ [\omega, u, \lambda] \f$.
+   * Closed form for all inputs, with Taylor tiers for small rotation angle
+   * and small log-scale that are exact to machine precision.
+   */
+  static Sim3 Expmap(const Vector7& xi, OptionalJacobian<7, 7> Hxi = boost::none);
+
+  /// Log map at identity: return the canonical coordinates of this similarity
+  static Vector7 Logmap(const Sim3& g, OptionalJacobian<7, 7> Hg = boost::none);
+
+  /// Adjoint map: map a tangent vector at T to one at the identity
+  Matrix7 AdjointMap() const;
+
+  /// The adjoint representation of the tangent vector xi, i.e. ad(xi)
+  static Matrix7 adjointMap(const Vector7& xi);
+
+  /// Derivative of Expmap (the right Jacobian of Sim(3))
+  static Matrix7 ExpmapDerivative(const Vector7& xi);
+
+  /// Derivative of Logmap, the inverse of the right Jacobian at Logmap(g)
+  static Matrix7 LogmapDerivative(const Sim3& g);
+
+  /// Chart at origin; the exponential map, like Pose3 with GTSAM_POSE3_EXPMAP
+  struct ChartAtOrigin {
+    static Sim3 Retract(const Vector7& xi, ChartJacobian Hxi = boost::none);
+    static Vector7 Local(const Sim3& g, ChartJacobian Hg = boost::none);
+  };
+
+  using LieGroup<Sim3, 7>::inverse; // version with derivative
+
+  /// @}
+  /// @name Group Action on Point3
+  /// @{
+
+  /** Map a point from the transform's frame: p' = s * R * p + t */
+  Point3 transformFrom(const Point3& p, OptionalJacobian<3, 7> Hself =
+      boost::none, OptionalJacobian<3, 3> Hpoint = boost::none) const;
+
+  /** syntactic sugar for transformFrom */
+  Point3 operator*(const Point3& p) const { return transformFrom(p); }
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /// get rotation
+  const Rot3& rotation() const { return R_; }
+
+  /// get translation
+  const Point3& translation() const { return t_; }
+
+  /// get scale
+  double scale() const { return s_; }
+
+  /** convert to 4x4 matrix [sR t; 0 1] */
+  Matrix4 matrix() const;
+
+  /// @}
+
+private:
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class Archive>
+  void serialize(Archive & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(R_);
+    ar & BOOST_SERIALIZATION_NVP(t_);
+    ar & BOOST_SERIALIZATION_NVP(s_);
+  }
+};
+
+template<>
+struct traits<Sim3> : public internal::LieGroup<Sim3> {};
+
+template<>
+struct traits<const Sim3> : public internal::LieGroup<Sim3> {};
+
+} // namespace gtsam
@@ -36,6 +36,7 @@
 #include <iostream>
 #include <limits>
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
@@ -80,32 +81,33 @@ static Point3 CalculateBestAxis(const Point3& n) {
 
 /* ************************************************************************* */
 const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
-#ifdef GTSAM_USE_TBB
-  // NOTE(hayk): At some point it seemed like this reproducably resulted in
-  // deadlock. However, I don't know why and I can no longer reproduce it.
-  // It either was a red herring or there is still a latent bug left to debug.
-  tbb::mutex::scoped_lock lock(B_mutex_);
-#endif
+  // The basis and its Jacobian are each published exactly once through an
+  // atomic once-flag; after initialization every call here is a lock-free
+  // check, so parallel linearize no longer serializes on a mutex.  Losing
+  // threads during the first call simply wait for the one-time computation.
+  std::call_once(B_once_, [this]() {
+    Matrix32 B;
 
-  const bool cachedBasis = static_cast<bool>(B_);
-  const bool cachedJacobian = static_cast<bool>(H_B_);
+    // Choose the direction of the first basis vector b1 in the tangent plane
+    // by crossing n with the chosen axis, then normalize it to a unit vector
+    // and complete the frame with b2 orthogonal to n and b1.
+    const Point3 n(p_), axis = CalculateBestAxis(n);
+    const Point3 B1 = gtsam::cross(n, axis);
+    B.col(0) = normalize(B1);
+    B.col(1) = gtsam::cross(n, B.col(0));
+    B_ = B;
+  });
 
   if (H) {
-    if (!cachedJacobian) {
-      // Compute Jacobian. Recomputes B_
+    std::call_once(H_B_once_, [this]() {
+      // Same calculation as above, with derivatives
       Matrix32 B;
       Matrix62 jacobian;
       Matrix33 H_B1_n, H_b1_B1, H_b2_n, H_b2_b1;
 
-      // Choose the direction of the first basis vector b1 in the tangent plane
-      // by crossing n with the chosen axis.
       const Point3 n(p_), axis = CalculateBestAxis(n);
       const Point3 B1 = gtsam::cross(n, axis, &H_B1_n);
-
-      // Normalize result to get a unit vector: b1 = B1 / |B1|.
       B.col(0) = normalize(B1, &H_b1_B1);
-
-      // Get the second basis vector b2, which is orthogonal to n and b1.
       B.col(1) = gtsam::cross(n, B.col(0), &H_b2_n, &H_b2_b1);
 
       // Chain rule tomfoolery to compute the jacobian.
@@ -114,28 +116,12 @@ const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
       auto H_b1_p = jacobian.block<3, 2>(0, 0);
       jacobian.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
 
-      // Cache the result and jacobian
-      H_B_.reset(jacobian);
-      B_.reset(B);
-    }
-
-    // Return cached jacobian, possibly computed just above
-    *H = *H_B_;
+      H_B_ = jacobian;
+    });
+    *H = H_B_;
   }
 
-  if (!cachedBasis) {
-    // Same calculation as above, without derivatives.
-    // Done after H block, as that possibly computes B_ for the first time
-    Matrix32 B;
-
-    const Point3 n(p_), axis = CalculateBestAxis(n);
-    const Point3 B1 = gtsam::cross(n, axis);
-    B.col(0) = normalize(B1);
-    B.col(1) = gtsam::cross(n, B.col(0));
-    B_.reset(B);
-  }
-
-  return *B_;
+  return B_;
 }
 
 /* ************************************************************************* */
@@ -279,6 +265,41 @@ Unit3 Unit3::retract(const Vector2& v, OptionalJacobian<2,2> H) const {
   return exp_p_xi_hat;
 }
 
+/* ************************************************************************* */
+Matrix Unit3::BatchRetract(const Matrix& points, const Matrix& vs) {
+  const DenseIndex n = points.cols();
+  if (points.rows() != 3)
+    throw std::invalid_argument(
+        "Unit3::BatchRetract: points must be 3xN, one unit direction per column");
+  if (vs.rows() != 2 || vs.cols() != n)
+    throw std::invalid_argument(
+        "Unit3::BatchRetract: vs must be 2xN, one column per direction");
+
+  // Lift the tangent vectors into ambient space, one small basis product per
+  // column; the temporary Unit3 lives on the (aligned) stack
+  Matrix xiHat(3, n);
+  for (DenseIndex i = 0; i < n; ++i)
+    xiHat.col(i) = Unit3(Vector3(points.col(i))).basis() * vs.col(i);
+
+  // Exponential-map weights c = cos(theta), st = sin(theta)/theta, with the
+  // same small-angle limit st -> 1 as the scalar retract
+  const Vector thetas = xiHat.colwise().norm();
+  Vector c(n), st(n);
+  for (DenseIndex i = 0; i < n; ++i) {
+    const double theta = thetas(i);
+    c(i) = std::cos(theta);
+    st(i) = theta < std::numeric_limits<double>::epsilon()
+        ? 1.0 : std::sin(theta) / theta;
+  }
+
+  // result_i = normalize(c_i * p_i + st_i * xiHat_i), with the weighting
+  // evaluated as packed row-wise expressions over the 3xN arrays
+  Matrix R = points.array().rowwise() * c.transpose().array()
+      + xiHat.array().rowwise() * st.transpose().array();
+  R.array().rowwise() /= R.colwise().norm().array();
+  return R;
+}
+
 /* ************************************************************************* */
 Vector2 Unit3::localCoordinates(const Unit3& other) const {
   const double x = p_.dot(other.p_);
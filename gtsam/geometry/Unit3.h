@@ -30,11 +30,9 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/serialization/nvp.hpp>
 
+#include <mutex>
 #include <string>
-
-#ifdef GTSAM_USE_TBB
-#include <tbb/mutex.h>
-#endif
+#include <vector>
 
 namespace gtsam {
 
@@ -44,12 +42,14 @@ class Unit3 {
 private:
 
   Vector3 p_; ///< The location of the point on the unit sphere
-  mutable boost::optional<Matrix32> B_; ///< Cached basis
-  mutable boost::optional<Matrix62> H_B_; ///< Cached basis derivative
 
-#ifdef GTSAM_USE_TBB
-  mutable tbb::mutex B_mutex_; ///< Mutex to protect the cached basis.
-#endif
+  // The basis and its derivative are each published exactly once through an
+  // atomic once-flag; after initialization every basis() call is a lock-free
+  // check, so parallel linearize does not serialize on a mutex here.
+  mutable Matrix32 B_;                 ///< Cached basis
+  mutable Matrix62 H_B_;               ///< Cached basis derivative
+  mutable std::once_flag B_once_;      ///< Guards one-time computation of B_
+  mutable std::once_flag H_B_once_;    ///< Guards one-time computation of H_B_
 
 public:
 
@@ -190,6 +190,18 @@ public:
   /// The retract function
   GTSAM_EXPORT Unit3 retract(const Vector2& v, OptionalJacobian<2,2> H = boost::none) const;
 
+  /**
+   * Retract N directions at once, without Jacobians: columns of points are
+   * unit directions and result.col(i) = Unit3(points.col(i)).retract(vs.col(i)).
+   * The exponential-map weights are applied as packed row-wise expressions,
+   * so bearing-only updates over many directions run on whole rows instead
+   * of one small expression chain per direction.  The directions stay in
+   * 3xN matrices throughout: a std::vector of over-aligned Unit3 would need
+   * Eigen::aligned_allocator, a trap we do not want in a public signature.
+   */
+  GTSAM_EXPORT static Matrix BatchRetract(const Matrix& points,
+      const Matrix& vs);
+
   /// The local coordinates function
   GTSAM_EXPORT Vector2 localCoordinates(const Unit3& s) const;
 
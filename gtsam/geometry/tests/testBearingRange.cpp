@@ -19,6 +19,7 @@
 #include <gtsam/geometry/BearingRange.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/base/serializationTestHelpers.h>
 
 #include <CppUnitLite/TestHarness.h>
@@ -45,6 +46,47 @@ TEST(BearingRange, 2D) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+// The fused Pose2-Point2 Measure specialization must agree with the
+// separately evaluated bearing and range, Jacobians included
+TEST(BearingRange, Fused2D) {
+  const Pose2 pose(1.0, 2.0, 0.57);
+  const Point2 point(-4.0, 11.0);
+
+  Matrix23 H1;
+  Matrix2 H2;
+  BearingRange2D actual = BearingRange2D::Measure(pose, point, H1, H2);
+  EXPECT(assert_equal(pose.bearing(point), actual.bearing()));
+  EXPECT_DOUBLES_EQUAL(pose.range(point), actual.range(), 1e-9);
+
+  boost::function<BearingRange2D(const Pose2&, const Point2&)> f =
+      [](const Pose2& pose, const Point2& point) {
+        return BearingRange2D::Measure(pose, point);
+      };
+  EXPECT(assert_equal(numericalDerivative21(f, pose, point), Matrix(H1), 1e-6));
+  EXPECT(assert_equal(numericalDerivative22(f, pose, point), Matrix(H2), 1e-6));
+}
+
+/* ************************************************************************* */
+// Same for the Pose2-Pose2 specialization
+TEST(BearingRange, FusedPose2Pose2) {
+  typedef BearingRange<Pose2, Pose2> T;
+  const Pose2 pose(1.0, 2.0, 0.57);
+  const Pose2 other(-4.0, 11.0, 0.2);
+
+  Matrix23 H1, H2;
+  T actual = T::Measure(pose, other, H1, H2);
+  EXPECT(assert_equal(pose.bearing(other), actual.bearing()));
+  EXPECT_DOUBLES_EQUAL(pose.range(other), actual.range(), 1e-9);
+
+  boost::function<T(const Pose2&, const Pose2&)> f =
+      [](const Pose2& pose, const Pose2& other) {
+        return T::Measure(pose, other);
+      };
+  EXPECT(assert_equal(numericalDerivative21(f, pose, other), Matrix(H1), 1e-6));
+  EXPECT(assert_equal(numericalDerivative22(f, pose, other), Matrix(H2), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST(BearingRange, Serialization2D) {
   EXPECT(equalsObj<BearingRange2D>(br2D));
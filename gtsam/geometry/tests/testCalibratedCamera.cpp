@@ -154,6 +154,22 @@ TEST( CalibratedCamera, Dproject_point_pose2)
   CHECK(assert_equal(numerical_point, Dpoint, 1e-7));
 }
 
+/* ************************************************************************* */
+// Projecting through a pre-computed ProjectionContext must match project2
+// exactly, value and derivatives alike
+TEST( CalibratedCamera, DprojectContext)
+{
+  static const Pose3 kDefaultPose(Rot3::Ypr(0.1, -0.1, 0.4), Point3(0, 0, -10));
+  static const CalibratedCamera camera(kDefaultPose);
+  const ProjectionContext context = camera.projectionContext();
+  Matrix Dpose, Dpoint, DposeCached, DpointCached;
+  Point2 expected = camera.project2(point1, Dpose, Dpoint);
+  Point2 actual = camera.project2(point1, context, DposeCached, DpointCached);
+  CHECK(assert_equal(expected, actual));
+  CHECK(assert_equal(Dpose, DposeCached));
+  CHECK(assert_equal(Dpoint, DpointCached));
+}
+
 /* ************************************************************************* */
 static Point2 projectAtInfinity(const CalibratedCamera& camera, const Unit3& point) {
   return camera.project2(point);
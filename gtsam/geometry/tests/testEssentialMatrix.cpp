@@ -241,6 +241,25 @@ TEST (EssentialMatrix, epipoles) {
   EXPECT(assert_equal(e2, E.epipole_b()));
 }
 
+//*************************************************************************
+TEST (EssentialMatrix, errors) {
+  // Batched evaluation must match the scalar error, column for column
+  size_t n = 7;
+  Matrix vAs(3, n), vBs(3, n);
+  for (size_t i = 0; i < n; i++) {
+    vAs.col(i) = Vector3(0.1 * i, 1.0 - 0.2 * i, 1.0);
+    vBs.col(i) = Vector3(0.3 - 0.1 * i, 0.2 * i, 1.0);
+  }
+  Vector actual = trueE.errors(vAs, vBs);
+  Vector expected(n);
+  for (size_t i = 0; i < n; i++)
+    expected(i) = trueE.error(vAs.col(i), vBs.col(i));
+  EXPECT(assert_equal(expected, actual, 1e-12));
+
+  // Mismatched shapes should throw
+  CHECK_EXCEPTION(trueE.errors(vAs, vBs.leftCols(3)), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
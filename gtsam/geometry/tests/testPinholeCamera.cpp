@@ -211,6 +211,20 @@ TEST( PinholeCamera, Dproject)
   EXPECT(assert_equal(numerical_cal,   Dcal,   1e-7));
 }
 
+/* ************************************************************************* */
+// Projecting through a pre-computed ProjectionContext must match project2
+// exactly, value and derivatives alike
+TEST( PinholeCamera, DprojectContext)
+{
+  const ProjectionContext context = camera.projectionContext();
+  Matrix Dcamera, Dpoint, DcameraCached, DpointCached;
+  Point2 expected = camera.project2(point1, Dcamera, Dpoint);
+  Point2 actual = camera.project2(point1, context, DcameraCached, DpointCached);
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(Dcamera, DcameraCached));
+  EXPECT(assert_equal(Dpoint, DpointCached));
+}
+
 /* ************************************************************************* */
 static Point2 projectInfinity3(const Pose3& pose, const Unit3& point3D, const Cal3_S2& cal) {
   return Camera(pose,cal).project(point3D);
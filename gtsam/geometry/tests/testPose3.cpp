@@ -426,6 +426,23 @@ TEST(Pose3, transformTo) {
   EXPECT(assert_equal(expected, actual, 0.001));
 }
 
+/* ************************************************************************* */
+TEST(Pose3, transformBatched) {
+  // batched overloads must agree with the single-point versions
+  Matrix3X points(3, 4);
+  points << 3, 0, 1, -5, //
+      2, 1, 8, 2,        //
+      10, 0, -7, 1;
+  Matrix3X actualTo = T3.transformTo(points);
+  Matrix3X actualFrom = T3.transformFrom(points);
+  for (int j = 0; j < points.cols(); ++j) {
+    EXPECT(assert_equal(T3.transformTo(Point3(points.col(j))),
+                        Point3(actualTo.col(j)), 1e-9));
+    EXPECT(assert_equal(T3.transformFrom(Point3(points.col(j))),
+                        Point3(actualFrom.col(j)), 1e-9));
+  }
+}
+
 Pose3 transformPoseTo_(const Pose3& pose, const Pose3& pose2) {
   return pose.transformPoseTo(pose2);
 }
@@ -499,6 +516,45 @@ TEST(Pose3, expmap_logmap)
   EXPECT(assert_equal(d12, t1.logmap(t2)));
 }
 
+/* ************************************************************************* */
+// The small-angle tiers of Expmap/Logmap must agree with the trigonometric
+// paths to machine precision
+TEST(Pose3, expmap_logmap_small_angle)
+{
+  Vector6 xi;
+  xi << 1.2e-4, -0.9e-4, 0.8e-4, 0.2, -0.3, 0.5;
+  // xi takes the trigonometric path, xi/2 the polynomial tier; both lie on
+  // the same one-parameter subgroup, so exp(xi) == exp(xi/2) * exp(xi/2)
+  Vector6 xi2 = xi / 2;
+  // The trigonometric path loses a few digits to cancellation at this
+  // magnitude, so only ask for agreement at the trig path's own accuracy
+  Pose3 full = Pose3::Expmap(xi), half = Pose3::Expmap(xi2);
+  EXPECT(assert_equal(full, half * half, 1e-10));
+  // round-trip through the small-angle Logmap tier
+  EXPECT(assert_equal(xi2, Pose3::Logmap(half), 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(Pose3, RetractBatch)
+{
+  std::vector<Pose3> poses;
+  poses.push_back(T);
+  poses.push_back(T2);
+  poses.push_back(T3);
+  std::vector<Vector6, Eigen::aligned_allocator<Vector6> > xis;
+  for (size_t i = 0; i < poses.size(); ++i)
+    xis.push_back(Vector6::Constant(0.01 * (i + 1)));
+
+  std::vector<Pose3> retracted = Pose3::RetractBatch(poses, xis);
+  LONGS_EQUAL(3, (long)retracted.size());
+  for (size_t i = 0; i < poses.size(); ++i)
+    EXPECT(assert_equal(poses[i].retract(xis[i]), retracted[i]));
+
+  // mismatched array sizes are rejected
+  xis.pop_back();
+  CHECK_EXCEPTION(Pose3::RetractBatch(poses, xis), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(Pose3, retract_localCoordinates2)
 {
@@ -661,6 +661,66 @@ TEST(Rot3, ClosestTo) {
   EXPECT(assert_equal(expected, actual.matrix(), 1e-6));
 }
 
+/* ************************************************************************* */
+TEST(Rot3, BatchCompose) {
+  std::vector<Rot3> R1, R2;
+  R1.push_back(Rot3::Rodrigues(0.1, 0.2, 0.3));
+  R1.push_back(Rot3::Ypr(0.5, -0.2, 0.1));
+  R1.push_back(Rot3());
+  R2.push_back(Rot3::Rodrigues(-0.3, 0.1, 0.2));
+  R2.push_back(Rot3::Ypr(-0.1, 0.3, -0.4));
+  R2.push_back(Rot3::Rx(0.7));
+
+  std::vector<Rot3> actual;
+  Rot3::BatchCompose(R1, R2, &actual);
+  LONGS_EQUAL(3, actual.size());
+  for (size_t i = 0; i < actual.size(); ++i)
+    EXPECT(assert_equal(R1[i] * R2[i], actual[i]));
+
+  // Result may alias an input
+  Rot3::BatchCompose(R1, R2, &R1);
+  for (size_t i = 0; i < R1.size(); ++i)
+    EXPECT(assert_equal(actual[i], R1[i]));
+
+  std::vector<Rot3> tooShort(1);
+  CHECK_EXCEPTION(Rot3::BatchCompose(R2, tooShort, &actual), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(Rot3, BatchRotate) {
+  const Rot3 R = Rot3::Rodrigues(0.1, -0.4, 0.2);
+  Matrix points(3, 4);
+  points << 1, 0, 0, 2,  //
+      0, 1, 0, -1,       //
+      0, 0, 1, 3;
+
+  const Matrix rotated = Rot3::BatchRotate(R, points);
+  for (int j = 0; j < points.cols(); ++j)
+    EXPECT(assert_equal(R.rotate(Point3(points.col(j))), Point3(rotated.col(j))));
+
+  CHECK_EXCEPTION(Rot3::BatchRotate(R, Matrix(2, 4)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(Rot3, BatchNormalize) {
+  // Accumulate a long compose chain without intermediate normalization
+  std::vector<Rot3> rotations;
+  Rot3 R;
+  const Rot3 delta = Rot3::Rodrigues(0.01, -0.02, 0.03);
+  for (size_t i = 0; i < 100; ++i) {
+    R = R * delta;
+    rotations.push_back(R);
+  }
+
+  Rot3::BatchNormalize(&rotations);
+  for(const Rot3& Ri: rotations) {
+    const gtsam::Quaternion q = Ri.toQuaternion();
+    DOUBLES_EQUAL(1.0, q.norm(), 1e-12);
+  }
+  // Normalization must not move an already consistent rotation noticeably
+  EXPECT(assert_equal(R, rotations.back(), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -205,6 +205,35 @@ TEST(SO3, ExpmapDerivative) {
   EXPECT(assert_equal(expectedDexpL.inverse(), actualDexpInvL, 1e-7));
 }
 
+//******************************************************************************
+TEST(SO3, ExpmapBatch) {
+  // Batch results match per-column Expmap/ExpmapDerivative, including the
+  // near-zero column
+  Matrix omegas(3, 4);
+  omegas.col(0) = Vector3(0.1, 0, 0.1);
+  omegas.col(1) = Vector3(10, 20, 30);
+  omegas.col(2) = Vector3::Zero();
+  omegas.col(3) = Vector3(-0.3, 0.2, -0.1);
+
+  std::vector<SO3> Rs;
+  std::vector<Matrix3> dexps;
+  so3::ExpmapBatch(omegas, &Rs, &dexps);
+  EXPECT_LONGS_EQUAL(4, Rs.size());
+  EXPECT_LONGS_EQUAL(4, dexps.size());
+  for (int i = 0; i < 4; ++i) {
+    const Vector3 omega = omegas.col(i);
+    EXPECT(assert_equal(SO3::Expmap(omega), Rs[i]));
+    EXPECT(assert_equal(SO3::ExpmapDerivative(omega), dexps[i]));
+  }
+
+  // Rotations only, and an empty batch
+  std::vector<SO3> RsOnly;
+  so3::ExpmapBatch(omegas, &RsOnly);
+  EXPECT(assert_equal(Rs[1], RsOnly[1]));
+  so3::ExpmapBatch(Matrix(3, 0), &RsOnly);
+  EXPECT_LONGS_EQUAL(0, RsOnly.size());
+}
+
 //******************************************************************************
 TEST(SO3, ExpmapDerivative2) {
   const Vector3 theta(0.1, 0, 0.1);
@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testSim3.cpp
+ * @brief  Unit tests for Sim3 class
+ */
+
+#include <gtsam/geometry/Sim3.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/testLie.h>
+#include <gtsam/base/lieProxies.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+GTSAM_CONCEPT_TESTABLE_INST(Sim3)
+GTSAM_CONCEPT_LIE_INST(Sim3)
+
+static const Rot3 R = Rot3::Rodrigues(0.3, 0.2, -0.1);
+static const Point3 P(0.2, 0.7, -2.0);
+static const Sim3 T(R, P, 1.5);
+static const Sim3 T2(Rot3::Rodrigues(0.3, 0.2, 0.1), Point3(3.5, -8.2, 4.2), 0.8);
+
+/* ************************************************************************* */
+TEST(Sim3, Concept) {
+  BOOST_CONCEPT_ASSERT((IsGroup<Sim3>));
+  BOOST_CONCEPT_ASSERT((IsManifold<Sim3>));
+  BOOST_CONCEPT_ASSERT((IsLieGroup<Sim3>));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, constructors) {
+  Sim3 identity;
+  EXPECT(assert_equal(Rot3(), identity.rotation()));
+  EXPECT(assert_equal(Point3(0, 0, 0), identity.translation()));
+  DOUBLES_EQUAL(1.0, identity.scale(), 1e-9);
+  EXPECT(assert_equal(identity, Sim3::identity()));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, compose) {
+  // action of the composition equals composed actions
+  const Point3 p(1.0, -2.0, 0.5);
+  const Sim3 T12 = T * T2;
+  EXPECT(assert_equal(T.transformFrom(T2.transformFrom(p)),
+      T12.transformFrom(p)));
+  DOUBLES_EQUAL(T.scale() * T2.scale(), T12.scale(), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(Sim3, inverse) {
+  EXPECT(assert_equal(Sim3(), T * T.inverse()));
+  EXPECT(assert_equal(Sim3(), T.inverse() * T));
+  const Point3 p(1.0, -2.0, 0.5);
+  EXPECT(assert_equal(p, T.inverse().transformFrom(T.transformFrom(p))));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, matrix) {
+  const Point3 p(1.0, -2.0, 0.5);
+  const Vector4 ph = (Vector4() << p.x(), p.y(), p.z(), 1.0).finished();
+  const Vector4 qh = T.matrix() * ph;
+  EXPECT(assert_equal(Point3(T.transformFrom(p)), Point3(qh.head<3>())));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, ExpmapLogmap) {
+  // round trip, including small-angle and small-scale tiers
+  Vector7 xi;
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 0.2;
+  EXPECT(assert_equal(xi, Sim3::Logmap(Sim3::Expmap(xi)), 1e-9));
+
+  xi << 1e-9, -2e-9, 1e-9, 1.0, 2.0, -0.5, 0.3;
+  EXPECT(assert_equal(xi, Sim3::Logmap(Sim3::Expmap(xi)), 1e-9));
+
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 1e-10;
+  EXPECT(assert_equal(xi, Sim3::Logmap(Sim3::Expmap(xi)), 1e-9));
+
+  xi.setZero();
+  EXPECT(assert_equal(Sim3(), Sim3::Expmap(xi)));
+
+  // pure scale drift is the last coordinate alone
+  xi << 0, 0, 0, 0, 0, 0, 0.25;
+  const Sim3 g = Sim3::Expmap(xi);
+  EXPECT(assert_equal(Rot3(), g.rotation()));
+  DOUBLES_EQUAL(exp(0.25), g.scale(), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(Sim3, Adjoint) {
+  // T * Expmap(xi) == Expmap(Ad_T xi) * T
+  Vector7 xi;
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 0.2;
+  const Sim3 expected = T * Sim3::Expmap(xi);
+  const Sim3 actual = Sim3::Expmap(T.AdjointMap() * xi) * T;
+  EXPECT(assert_equal(expected, actual, 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, ExpmapDerivative) {
+  Vector7 xi;
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 0.2;
+  Matrix actualH;
+  Sim3::Expmap(xi, actualH);
+  const Matrix expectedH = numericalDerivative21<Sim3, Vector7,
+      OptionalJacobian<7, 7> >(&Sim3::Expmap, xi, boost::none);
+  EXPECT(assert_equal(expectedH, actualH, 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, LogmapDerivative) {
+  Vector7 xi;
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 0.2;
+  const Sim3 g = Sim3::Expmap(xi);
+  Matrix actualH;
+  Sim3::Logmap(g, actualH);
+  const Matrix expectedH = numericalDerivative21<Vector7, Sim3,
+      OptionalJacobian<7, 7> >(&Sim3::Logmap, g, boost::none);
+  EXPECT(assert_equal(expectedH, actualH, 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, composeJacobians) {
+  Matrix actualH1, actualH2;
+  T.compose(T2, actualH1, actualH2);
+  const Matrix numericalH1 = numericalDerivative21(testing::compose<Sim3>, T, T2);
+  const Matrix numericalH2 = numericalDerivative22(testing::compose<Sim3>, T, T2);
+  EXPECT(assert_equal(numericalH1, actualH1, 1e-5));
+  EXPECT(assert_equal(numericalH2, actualH2, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, betweenJacobians) {
+  Matrix actualH1, actualH2;
+  T.between(T2, actualH1, actualH2);
+  const Matrix numericalH1 = numericalDerivative21(testing::between<Sim3>, T, T2);
+  const Matrix numericalH2 = numericalDerivative22(testing::between<Sim3>, T, T2);
+  EXPECT(assert_equal(numericalH1, actualH1, 1e-5));
+  EXPECT(assert_equal(numericalH2, actualH2, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, inverseJacobian) {
+  Matrix actualH;
+  T.inverse(actualH);
+  const Matrix numericalH = numericalDerivative11(testing::inverse<Sim3>, T);
+  EXPECT(assert_equal(numericalH, actualH, 1e-5));
+}
+
+/* ************************************************************************* */
+namespace {
+Point3 transformFrom_(const Sim3& g, const Point3& p) {
+  return g.transformFrom(p);
+}
+}
+
+TEST(Sim3, transformFrom) {
+  const Point3 p(1.0, -2.0, 0.5);
+  Matrix actualHself, actualHpoint;
+  const Point3 q = T.transformFrom(p, actualHself, actualHpoint);
+  EXPECT(assert_equal(Point3(T.scale() * (T.rotation() * p) + T.translation()), q));
+  const Matrix numericalHself = numericalDerivative21(transformFrom_, T, p);
+  const Matrix numericalHpoint = numericalDerivative22(transformFrom_, T, p);
+  EXPECT(assert_equal(numericalHself, actualHself, 1e-5));
+  EXPECT(assert_equal(numericalHpoint, actualHpoint, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(Sim3, retractLocalCoordinates) {
+  Vector7 xi;
+  xi << 0.1, -0.2, 0.3, 1.0, 2.0, -0.5, 0.2;
+  const Sim3 g = T.retract(xi);
+  EXPECT(assert_equal(xi, T.localCoordinates(g), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -299,6 +299,55 @@ TEST( triangulation, outliersAndFarLandmarks) {
   EXPECT(actual.outlier());
 }
 
+//******************************************************************************
+TEST( triangulation, triangulatePoints) {
+  // Batch several landmarks, including ones that fail, and check that the
+  // structure-of-arrays result matches per-landmark triangulateSafe
+  CameraSet<PinholeCamera<Cal3_S2> > cameras;
+  cameras += camera1, camera2;
+
+  // Three landmarks seen by both cameras, one beyond the distance threshold
+  const Point3 landmark2(5, -0.5, 1.2), farLandmark(50, 5, 12);
+  vector<CameraSet<PinholeCamera<Cal3_S2> > > cameraSets;
+  vector<Point2Vector> measurementSets;
+
+  Point2Vector measurements1, measurements2, measurements3, measurements4;
+  measurements1 += camera1.project(landmark), camera2.project(landmark);
+  measurements2 += camera1.project(landmark2), camera2.project(landmark2);
+  measurements3 += camera1.project(farLandmark), camera2.project(farLandmark);
+  cameraSets += cameras, cameras, cameras;
+  measurementSets += measurements1, measurements2, measurements3;
+
+  // And one landmark seen by a single camera (degenerate)
+  CameraSet<PinholeCamera<Cal3_S2> > oneCamera;
+  oneCamera += camera1;
+  measurements4 += camera1.project(landmark);
+  cameraSets += oneCamera;
+  measurementSets += measurements4;
+
+  double landmarkDistanceThreshold = 10;
+  TriangulationParameters params(1.0, false, landmarkDistanceThreshold);
+  TriangulationResults results = triangulatePoints(cameraSets,
+      measurementSets, params);
+
+  EXPECT_LONGS_EQUAL(4, results.size());
+  EXPECT_LONGS_EQUAL(4, results.points.size());
+  EXPECT(results.valid(0));
+  EXPECT(results.valid(1));
+  EXPECT(assert_equal(landmark, results.points[0], 1e-7));
+  EXPECT(assert_equal(landmark2, results.points[1], 1e-7));
+  EXPECT(!results.valid(2));
+  EXPECT(!results.valid(3));
+  EXPECT_LONGS_EQUAL(TriangulationResult::DEGENERATE, results.statuses[3]);
+
+  // Statuses agree with the per-landmark entry point
+  for (size_t i = 0; i < results.size(); i++) {
+    TriangulationResult single = triangulateSafe(cameraSets[i],
+        measurementSets[i], params);
+    EXPECT_LONGS_EQUAL(single.status(), results.statuses[i]);
+  }
+}
+
 //******************************************************************************
 TEST( triangulation, twoIdenticalPoses) {
   // create first camera. Looking along X-axis, 1 meter above ground plane (x-y)
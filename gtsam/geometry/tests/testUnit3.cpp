@@ -391,6 +391,27 @@ TEST (Unit3, jacobian_retract) {
   }
 }
 
+//*******************************************************************************
+TEST(Unit3, BatchRetract) {
+  // A mix of directions and step sizes, including a zero step
+  boost::mt19937 rng(42);
+  const size_t n = 8;
+  Matrix points(3, n);
+  for (size_t i = 0; i < n; i++)
+    points.col(i) = Unit3::Random(rng).unitVector();
+  Matrix vs(2, n);
+  vs << 0.5, 0, -0.2, 0.8, 0.01, -0.5, 1.2, 0, //
+        0, 0, 0.1, -0.3, 0.02, 0.4, -0.7, 0;
+
+  // Must match the scalar retract column for column
+  const Matrix actual = Unit3::BatchRetract(points, vs);
+  LONGS_EQUAL(n, actual.cols());
+  for (size_t i = 0; i < n; i++) {
+    const Unit3 expected = Unit3(Vector3(points.col(i))).retract(vs.col(i));
+    EXPECT(assert_equal(expected.unitVector(), Vector3(actual.col(i)), 1e-12));
+  }
+}
+
 //*******************************************************************************
 TEST(Unit3, retract_expmap) {
   Unit3 p;
@@ -20,6 +20,7 @@
 
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/base/batchedDLT.h>
 
 namespace gtsam {
 
@@ -45,7 +46,8 @@ Vector4 triangulateHomogeneousDLT(
   int rank;
   double error;
   Vector v;
-  boost::tie(rank, error, v) = DLT(A, rank_tol);
+  // 4-column system: fixed-size normal-matrix solve, see batchedDLT.h
+  boost::tie(rank, error, v) = DLTSmall(A, rank_tol);
 
   if (rank < 3)
     throw(TriangulationUnderconstrainedException());
@@ -70,6 +72,110 @@ Point3 triangulateDLT(const std::vector<Matrix34, Eigen::aligned_allocator<Matri
  * @param landmarkKey to refer to landmark
  * @return refined Point3
  */
+TriangulationResult checkTriangulatedPoint(
+    const CameraSet<StereoCamera>& cameras, const StereoPoint2Vector& measured,
+    const Point3& point, const TriangulationParameters& params) {
+
+  // Check landmark distance and re-projection errors to avoid outliers
+  size_t i = 0;
+  double maxReprojError = 0.0;
+  for(const StereoCamera& camera: cameras) {
+    const Pose3& pose = camera.pose();
+    if (params.landmarkDistanceThreshold > 0
+        && distance3(pose.translation(), point)
+            > params.landmarkDistanceThreshold)
+      return TriangulationResult::FarPoint();
+    // Always verify cheirality: the fused point can fall behind a camera
+    // other than the ones whose disparities placed it, and no upstream
+    // exception has checked this as in the monocular DLT path
+    if (pose.transformTo(point).z() <= 0)
+      return TriangulationResult::BehindCamera();
+    // Check reprojection error
+    if (params.dynamicOutlierRejectionThreshold > 0) {
+      Vector3 reprojectionError = traits<StereoPoint2>::Local(measured.at(i),
+          camera.project2(point));
+      if (std::isnan(reprojectionError(1))) // no right pixel was measured
+        reprojectionError(1) = 0.0;
+      maxReprojError = std::max(maxReprojError, reprojectionError.norm());
+    }
+    i += 1;
+  }
+  // Flag as degenerate if average reprojection error is too large
+  if (params.dynamicOutlierRejectionThreshold > 0
+      && maxReprojError > params.dynamicOutlierRejectionThreshold)
+    return TriangulationResult::Outlier();
+
+  // all good!
+  return TriangulationResult(point);
+}
+
+Point3 triangulateStereo(const CameraSet<StereoCamera>& cameras,
+    const StereoPoint2Vector& measurements, bool optimize) {
+
+  if (cameras.size() != measurements.size())
+    throw std::invalid_argument(
+        "triangulateStereo: cameras and measurements differ in size");
+
+  // Batch backprojection: every view with a usable disparity yields a world
+  // point, fused with inverse-depth-variance weights w = (fx*b / z^2)^2
+  Vector3 weightedSum = Vector3::Zero();
+  double weightSum = 0.0;
+  CameraSet<StereoCamera> usableCameras;
+  StereoPoint2Vector usableMeasurements;
+  for (size_t i = 0; i < cameras.size(); i++) {
+    const StereoPoint2& z = measurements.at(i);
+    if (std::isnan(z.uR())) // monocular-only view, carries no depth
+      continue;
+    const double disparity = z.uL() - z.uR();
+    if (disparity <= 0)
+      throw TriangulationCheiralityException();
+    const StereoCamera& camera = cameras.at(i);
+    const Point3 point = camera.backproject2(z);
+    const Cal3_S2Stereo& K = camera.calibration();
+    const double depth = K.baseline() * K.fx() / disparity;
+    const double sigma_z = depth * depth / (K.fx() * K.baseline());
+    const double weight = 1.0 / (sigma_z * sigma_z);
+    weightedSum += weight * point;
+    weightSum += weight;
+    usableCameras.push_back(camera);
+    usableMeasurements.push_back(z);
+  }
+  if (usableCameras.empty())
+    throw TriangulationUnderconstrainedException();
+  Point3 point(weightedSum / weightSum);
+
+  // Then refine using non-linear optimization over the stereo-capable views
+  if (optimize && usableCameras.size() > 1)
+    point = triangulateNonlinear<StereoCamera>(usableCameras,
+        usableMeasurements, point);
+
+  return point;
+}
+
+TriangulationResult triangulateSafe(const CameraSet<StereoCamera>& cameras,
+    const StereoPoint2Vector& measured, const TriangulationParameters& params) {
+
+  size_t m = cameras.size();
+
+  // if we have a single pose the corresponding factor is uninformative
+  if (m < 2)
+    return TriangulationResult::Degenerate();
+  else
+    // We triangulate the 3D position of the landmark
+    try {
+      Point3 point = triangulateStereo(cameras, measured, params.enableEPI);
+      return checkTriangulatedPoint(cameras, measured, point, params);
+    } catch (TriangulationUnderconstrainedException&) {
+      // no view measured a usable disparity, e.g. all right pixels missing
+      return TriangulationResult::Degenerate();
+    } catch (TriangulationCheiralityException&) {
+      return TriangulationResult::BehindCamera();
+    } catch (StereoCheiralityException&) {
+      // thrown by project2 during the nonlinear refinement
+      return TriangulationResult::BehindCamera();
+    }
+}
+
 Point3 optimize(const NonlinearFactorGraph& graph, const Values& values,
     Key landmarkKey) {
   // Maybe we should consider Gauss-Newton?
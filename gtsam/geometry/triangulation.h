@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/StereoCamera.h>
 #include <gtsam/geometry/CameraSet.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/slam/TriangulationFactor.h>
@@ -26,6 +27,11 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
 namespace gtsam {
 
 /// Exception thrown by triangulateDLT when SVD returns rank < 3
@@ -387,9 +393,11 @@ private:
  * TriangulationResult is an optional point, along with the reasons why it is invalid.
  */
 class TriangulationResult: public boost::optional<Point3> {
+public:
   enum Status {
     VALID, DEGENERATE, BEHIND_CAMERA, OUTLIER, FAR_POINT
   };
+private:
   Status status_;
   TriangulationResult(Status s) :
       status_(s) {
@@ -435,6 +443,10 @@ public:
   bool behindCamera() const {
     return status_ == BEHIND_CAMERA;
   }
+  /// The raw status flag, e.g. for storing in structure-of-arrays form
+  Status status() const {
+    return status_;
+  }
   // stream to output
   friend std::ostream &operator<<(std::ostream &os,
       const TriangulationResult& result) {
@@ -455,6 +467,51 @@ private:
   }
 };
 
+/**
+ * Run the landmark-distance, cheirality, and reprojection-error checks of
+ * triangulateSafe on an already-triangulated point, without triangulating.
+ * Returns a valid result holding the point if all checks pass, and the
+ * appropriate failure status otherwise.  Useful to re-validate a cached
+ * triangulation after the cameras have moved slightly.
+ */
+template<class CAMERA>
+TriangulationResult checkTriangulatedPoint(const CameraSet<CAMERA>& cameras,
+    const typename CAMERA::MeasurementVector& measured, const Point3& point,
+    const TriangulationParameters& params) {
+
+  // Check landmark distance and re-projection errors to avoid outliers
+  size_t i = 0;
+  double maxReprojError = 0.0;
+  for(const CAMERA& camera: cameras) {
+    const Pose3& pose = camera.pose();
+    if (params.landmarkDistanceThreshold > 0
+        && distance3(pose.translation(), point)
+            > params.landmarkDistanceThreshold)
+      return TriangulationResult::FarPoint();
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+    // verify that the triangulated point lies in front of all cameras
+    // Only needed if this was not yet handled by exception
+    const Point3& p_local = pose.transformTo(point);
+    if (p_local.z() <= 0)
+      return TriangulationResult::BehindCamera();
+#endif
+    // Check reprojection error
+    if (params.dynamicOutlierRejectionThreshold > 0) {
+      const Point2& zi = measured.at(i);
+      Point2 reprojectionError(camera.project(point) - zi);
+      maxReprojError = std::max(maxReprojError, reprojectionError.norm());
+    }
+    i += 1;
+  }
+  // Flag as degenerate if average reprojection error is too large
+  if (params.dynamicOutlierRejectionThreshold > 0
+      && maxReprojError > params.dynamicOutlierRejectionThreshold)
+    return TriangulationResult::Outlier();
+
+  // all good!
+  return TriangulationResult(point);
+}
+
 /// triangulateSafe: extensive checking of the outcome
 template<class CAMERA>
 TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
@@ -471,38 +528,7 @@ TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
     try {
       Point3 point = triangulatePoint3<CAMERA>(cameras, measured,
           params.rankTolerance, params.enableEPI);
-
-      // Check landmark distance and re-projection errors to avoid outliers
-      size_t i = 0;
-      double maxReprojError = 0.0;
-      for(const CAMERA& camera: cameras) {
-        const Pose3& pose = camera.pose();
-        if (params.landmarkDistanceThreshold > 0
-            && distance3(pose.translation(), point)
-                > params.landmarkDistanceThreshold)
-          return TriangulationResult::FarPoint();
-#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
-        // verify that the triangulated point lies in front of all cameras
-        // Only needed if this was not yet handled by exception
-        const Point3& p_local = pose.transformTo(point);
-        if (p_local.z() <= 0)
-          return TriangulationResult::BehindCamera();
-#endif
-        // Check reprojection error
-        if (params.dynamicOutlierRejectionThreshold > 0) {
-          const Point2& zi = measured.at(i);
-          Point2 reprojectionError(camera.project(point) - zi);
-          maxReprojError = std::max(maxReprojError, reprojectionError.norm());
-        }
-        i += 1;
-      }
-      // Flag as degenerate if average reprojection error is too large
-      if (params.dynamicOutlierRejectionThreshold > 0
-          && maxReprojError > params.dynamicOutlierRejectionThreshold)
-        return TriangulationResult::Outlier();
-
-      // all good!
-      return TriangulationResult(point);
+      return checkTriangulatedPoint<CAMERA>(cameras, measured, point, params);
     } catch (TriangulationUnderconstrainedException&) {
       // This exception is thrown if
       // 1) There is a single pose for triangulation - this should not happen because we checked the number of poses before
@@ -514,5 +540,107 @@ TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
     }
 }
 
+/**
+ * Stereo version of checkTriangulatedPoint.  The monocular template does not
+ * apply because the reprojection error lives in StereoPoint2 coordinates;
+ * here the right-pixel component of the error is ignored when the
+ * measurement has no right pixel (uR is NaN), so that mixed stereo/monocular
+ * tracks can be validated.  Unlike the monocular version, cheirality is
+ * always checked: the stereo pipeline triangulates by backprojection rather
+ * than by a DLT that throws, so no exception has checked it beforehand.
+ */
+GTSAM_EXPORT TriangulationResult checkTriangulatedPoint(
+    const CameraSet<StereoCamera>& cameras, const StereoPoint2Vector& measured,
+    const Point3& point, const TriangulationParameters& params);
+
+/**
+ * Triangulate a point from rectified stereo measurements.  Each view with a
+ * finite, positive disparity determines the point by itself, so instead of a
+ * DLT we batch backproject2 over the measurement set and fuse the world
+ * points with inverse-variance weights, where the depth standard deviation
+ * of a view at depth z is sigma_z = z^2 / (fx * b) for a one-pixel disparity
+ * error.  Measurements whose right pixel is NaN (monocular-only views) are
+ * skipped.  Throws TriangulationUnderconstrainedException if no view has a
+ * usable disparity, and TriangulationCheiralityException if a disparity is
+ * not positive.
+ * @param cameras stereo cameras, one per measurement
+ * @param measurements rectified stereo measurements (uL, uR, v)
+ * @param optimize if true, refine the fused point with triangulateNonlinear
+ * @return fused world point
+ */
+GTSAM_EXPORT Point3 triangulateStereo(const CameraSet<StereoCamera>& cameras,
+    const StereoPoint2Vector& measurements, bool optimize = false);
+
+/**
+ * Stereo overload of triangulateSafe: triangulates with triangulateStereo
+ * and classifies failures exactly as the monocular version does.  A single
+ * stereo view does determine a point, but the corresponding smart factor is
+ * uninformative once the point is eliminated, so fewer than two views is
+ * still reported as degenerate.
+ */
+GTSAM_EXPORT TriangulationResult triangulateSafe(
+    const CameraSet<StereoCamera>& cameras,
+    const StereoPoint2Vector& measured, const TriangulationParameters& params);
+
+/**
+ * Structure-of-arrays result of triangulatePoints.  Entry i of each array
+ * describes landmark i; points[i] only holds a meaningful position when
+ * statuses[i] == TriangulationResult::VALID.
+ */
+struct TriangulationResults {
+  std::vector<Point3> points; ///< triangulated positions
+  std::vector<TriangulationResult::Status> statuses; ///< per-point outcomes
+  size_t size() const {
+    return statuses.size();
+  }
+  bool valid(size_t i) const {
+    return statuses[i] == TriangulationResult::VALID;
+  }
+};
+
+/**
+ * Batch version of triangulateSafe: triangulate many landmarks at once, where
+ * landmark i is observed by cameraSets[i] with measurements measurementSets[i].
+ * The landmarks are partitioned across TBB worker threads when GTSAM_USE_TBB
+ * is defined, which is safe because each landmark only writes its own slot of
+ * the preallocated result arrays.  Failures never throw; they are reported in
+ * the per-point status flags, exactly as triangulateSafe would classify them.
+ */
+template<class CAMERA>
+TriangulationResults triangulatePoints(
+    const std::vector<CameraSet<CAMERA> >& cameraSets,
+    const std::vector<typename CAMERA::MeasurementVector>& measurementSets,
+    const TriangulationParameters& params) {
+  if (cameraSets.size() != measurementSets.size())
+    throw std::invalid_argument(
+        "triangulatePoints: cameraSets and measurementSets differ in size");
+
+  const size_t n = cameraSets.size();
+  TriangulationResults results;
+  results.points.resize(n);
+  results.statuses.assign(n, TriangulationResult::DEGENERATE);
+
+  auto triangulateRange = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const TriangulationResult result = triangulateSafe(cameraSets[i],
+          measurementSets[i], params);
+      results.statuses[i] = result.status();
+      if (result)
+        results.points[i] = *result;
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&triangulateRange](const tbb::blocked_range<size_t>& range) {
+        triangulateRange(range.begin(), range.end());
+      });
+#else
+  triangulateRange(0, n);
+#endif
+
+  return results;
+}
+
 } // \namespace gtsam
 
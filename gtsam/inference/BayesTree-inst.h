@@ -22,12 +22,14 @@
 
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/BayesTree.h>
+#include <gtsam/inference/CliquePool.h>
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/optional.hpp>
 #include <boost/assign/list_of.hpp>
 #include <fstream>
+#include <set>
 
 using boost::assign::cref_list_of;
 
@@ -53,6 +55,35 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  template <class CLIQUE>
+  BayesTreeMemoryUsage BayesTree<CLIQUE>::memoryUsage() const {
+    BayesTreeMemoryUsage usage;
+    for (const sharedClique& root : roots_) memoryUsage(root, &usage);
+    return usage;
+  }
+
+  /* ************************************************************************* */
+  template <class CLIQUE>
+  void BayesTree<CLIQUE>::memoryUsage(sharedClique clique,
+                                      BayesTreeMemoryUsage* usage) const {
+    ++usage->nrCliques;
+    if (clique->conditional())
+      usage->conditionalBytes += factorMemoryBytes(
+          static_cast<const FactorType&>(*clique->conditional()));
+    if (clique->cachedSeparatorMarginal()) {
+      ++usage->nrCachedSeparatorMarginals;
+      for (const typename FactorType::shared_ptr& factor :
+          *clique->cachedSeparatorMarginal())
+        if (factor)
+          usage->cachedSeparatorMarginalBytes += factorMemoryBytes(
+              static_cast<const FactorType&>(*factor));
+    }
+    for (sharedClique c : clique->children) {
+      memoryUsage(c, usage);
+    }
+  }
+
   /* ************************************************************************* */
   template<class CLIQUE>
   size_t BayesTree<CLIQUE>::numCachedSeparatorMarginals() const {
@@ -133,6 +164,40 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  template<class CLIQUE>
+  void BayesTree<CLIQUE>::relocateCliques(CliquePool& pool) {
+    gttic(BayesTree_relocateCliques);
+    // Clone the cliques in depth-first pre-order, so each parent is
+    // allocated immediately before its children and siblings are adjacent.
+    // Children are pushed in reverse so the leftmost subtree comes first.
+    Roots newRoots;
+    FastVector<std::pair<sharedClique, sharedClique> > stack; // (old, new parent)
+    for (typename Roots::const_reverse_iterator it = roots_.rbegin();
+        it != roots_.rend(); ++it)
+      stack.push_back(std::make_pair(*it, sharedClique()));
+    while (!stack.empty()) {
+      const sharedClique old = stack.back().first;
+      const sharedClique newParent = stack.back().second;
+      stack.pop_back();
+      sharedClique clone = pool.template allocate<Clique>(*old);
+      clone->children.clear();
+      clone->parent_ = newParent;
+      if (newParent)
+        newParent->children.push_back(clone);
+      else
+        newRoots.push_back(clone);
+      for (typename FastVector<sharedClique>::const_reverse_iterator child =
+          old->children.rbegin(); child != old->children.rend(); ++child)
+        stack.push_back(std::make_pair(*child, clone));
+    }
+    // Re-point the nodes index at the relocated cliques
+    roots_.swap(newRoots);
+    nodes_.clear();
+    for (const sharedClique& root : roots_)
+      fillNodesIndex(root);
+  }
+
   /* ************************************************************************* */
   namespace {
   template <class FACTOR, class CLIQUE>
@@ -245,6 +310,21 @@ namespace gtsam {
     fillNodesIndex(subtree); // Populate nodes index
   }
 
+  /* ************************************************************************* */
+  template<class CLIQUE>
+  typename BayesTree<CLIQUE>::Cliques BayesTree<CLIQUE>::findCliques(
+      const KeyVector& keys) const {
+    Cliques cliques;
+    std::set<const Clique*> seen;
+    for (const Key& j : keys) {
+      typename Nodes::const_iterator node = nodes_.find(j);
+      if (node == nodes_.end()) continue;
+      if (seen.insert(node->second.get()).second)
+        cliques.push_back(node->second);
+    }
+    return cliques;
+  }
+
   /* ************************************************************************* */
   // First finds clique marginal then marginalizes that
   /* ************************************************************************* */
@@ -458,15 +538,41 @@ namespace gtsam {
   void BayesTree<CLIQUE>::removeTop(const KeyVector& keys, BayesNetType* bn,
                                     Cliques* orphans) {
     gttic(removetop);
-    // process each key of the new factor
-    for (const Key& j : keys) {
-      // get the clique
-      // TODO(frank): Nodes will be searched again in removeClique
-      typename Nodes::const_iterator node = nodes_.find(j);
-      if (node != nodes_.end()) {
-        // remove path from clique to root
-        this->removePath(node->second, bn, orphans);
+    // Collect the distinct cliques to remove by walking each marked key's
+    // parent chain once, tracking membership in a set.  The previous
+    // path-by-path version rescanned the growing orphan list for every
+    // removed clique, which made large relinearization events (loop closures
+    // marking tens of thousands of variables) quadratic in the number of
+    // removed cliques.
+    std::set<CLIQUE*> removedSet;
+    FastVector<sharedClique> removedCliques, path;
+    for (sharedClique clique : findCliques(keys)) {
+      // Collect the not-yet-marked part of this clique's parent chain, then
+      // append it root-first to keep the original top-down output order
+      path.clear();
+      while (clique && removedSet.insert(clique.get()).second) {
+        path.push_back(clique);
+        clique = clique->parent_.lock();
+      }
+      removedCliques.insert(removedCliques.end(), path.rbegin(), path.rend());
+    }
+
+    // Detach all marked cliques in one pass.  Since each marked clique's
+    // whole parent chain is marked as well, children of marked cliques are
+    // either marked themselves or roots of orphaned subtrees.
+    for (const sharedClique& clique : removedCliques) {
+      typename Roots::iterator root = std::find(roots_.begin(), roots_.end(), clique);
+      if (root != roots_.end()) roots_.erase(root);
+      for (const sharedClique& child : clique->children) {
+        child->parent_ = typename Clique::weak_ptr();
+        if (removedSet.count(child.get()) == 0)
+          orphans->push_back(child);
       }
+      clique->children.clear();
+      clique->parent_ = typename Clique::weak_ptr();
+      for (Key frontal : clique->conditional()->frontals())
+        nodes_.unsafe_erase(frontal);
+      bn->push_back(clique->conditional_);
     }
 
     // Delete cachedShortcuts for each orphan subtree
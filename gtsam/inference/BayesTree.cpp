@@ -33,6 +33,17 @@ void BayesTreeCliqueStats::print(const std::string& s) const {
     << "max Separator Size: "   << maxSeparatorSize   << std::endl;
 }
 
+/* ************************************************************************* */
+void BayesTreeMemoryUsage::print(const std::string& s) const {
+  std::cout << s
+    << "nr Cliques: "                      << nrCliques                    << std::endl
+    << "nr Cached Separator Marginals: "   << nrCachedSeparatorMarginals   << std::endl
+    << "conditional Bytes: "               << conditionalBytes             << std::endl
+    << "cached Separator Marginal Bytes: " << cachedSeparatorMarginalBytes << std::endl
+    << "cached Factor Bytes: "             << cachedFactorBytes            << std::endl
+    << "total Bytes: "                     << totalBytes()                 << std::endl;
+}
+
 /* ************************************************************************* */
 BayesTreeCliqueStats BayesTreeCliqueData::getStats() const
 {
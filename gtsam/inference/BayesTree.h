@@ -31,6 +31,7 @@ namespace gtsam {
   // Forward declarations
   template<class FACTOR> class FactorGraph;
   template<class BAYESTREE, class GRAPH> class EliminatableClusterTree;
+  class CliquePool;
 
   /* ************************************************************************* */
   /** clique statistics */
@@ -49,6 +50,39 @@ namespace gtsam {
     BayesTreeCliqueStats getStats() const;
   };
 
+  /**
+   * Approximate heap bytes of one factor or conditional, used by
+   * BayesTree::memoryUsage.  This generic version counts only the keys; an
+   * overload for GaussianFactor, found by argument-dependent lookup, adds
+   * the matrix storage of the derived factor.
+   */
+  template<class FACTOR>
+  std::size_t factorMemoryBytes(const FACTOR& factor) {
+    return factor.size() * sizeof(Key);
+  }
+
+  /**
+   * Compact memory accounting over all cliques, gathered by
+   * BayesTree::memoryUsage.  All byte counts are approximate heap usage;
+   * bookkeeping overhead of the tree structure itself is not included.
+   */
+  struct GTSAM_EXPORT BayesTreeMemoryUsage {
+    std::size_t nrCliques;                    ///< number of cliques in the tree
+    std::size_t nrCachedSeparatorMarginals;   ///< cliques holding a cached separator marginal
+    std::size_t conditionalBytes;             ///< storage of the clique conditionals
+    std::size_t cachedSeparatorMarginalBytes; ///< storage of the cached separator marginals
+    std::size_t cachedFactorBytes;            ///< storage of cached linearized factors (ISAM2 only)
+    BayesTreeMemoryUsage() :
+        nrCliques(0), nrCachedSeparatorMarginals(0), conditionalBytes(0),
+        cachedSeparatorMarginalBytes(0), cachedFactorBytes(0) {}
+    /// Sum of all byte counts
+    std::size_t totalBytes() const {
+      return conditionalBytes + cachedSeparatorMarginalBytes
+          + cachedFactorBytes;
+    }
+    void print(const std::string& s = "") const;
+  };
+
   /* ************************************************************************* */
   /**
    * Bayes tree
@@ -155,12 +189,26 @@ namespace gtsam {
         return c->second;
     }
 
+    /** Bulk version of clique lookup: find the cliques containing the given
+     *  keys, deduplicated, in a single pass over the keys.  Keys that are not
+     *  in the tree are skipped.  Prefer this over repeated operator[] or
+     *  clique() calls when querying many keys at once, e.g. when marking
+     *  variables during incremental updates, as several keys typically map to
+     *  the same clique. */
+    Cliques findCliques(const KeyVector& keys) const;
+
     /** Gather data on all cliques */
     BayesTreeCliqueData getCliqueData() const;
 
     /** Collect number of cliques with cached separator marginals */
     size_t numCachedSeparatorMarginals() const;
 
+    /** Gather approximate memory usage over all cliques.  This only reads
+     *  shared state and takes no locks, so it can be polled from a monitoring
+     *  thread; the counts are then approximate if the tree is being updated
+     *  concurrently. */
+    BayesTreeMemoryUsage memoryUsage() const;
+
     /** Return marginal on any variable.  Note that this actually returns a conditional, for which a
      *  solution may be directly obtained by calling .solve() on the returned object.
      *  Alternatively, it may be directly used as its factor base class.  For example, for Gaussian
@@ -228,6 +276,18 @@ namespace gtsam {
     /** add a clique (top down) */
     void addClique(const sharedClique& clique, const sharedClique& parent_clique = sharedClique());
 
+    /**
+     * Re-allocate every clique of this tree from the given pool, in
+     * depth-first pre-order, so parent-child runs and sibling lists become
+     * contiguous in memory.  Traversal-heavy passes like backsubstitution
+     * then walk sequential addresses instead of scattered heap pages; run
+     * this after big recalculate events that churn the clique layout.  The
+     * conditionals themselves are shared with the old cliques, only the
+     * clique nodes move.  The pool must outlive the tree and must not be
+     * reset while the tree is alive.
+     */
+    void relocateCliques(CliquePool& pool);
+
     /** Add all cliques in this BayesTree to the specified factor graph */
     void addFactorsToGraph(FactorGraph<FactorType>* graph) const;
 
@@ -240,6 +300,9 @@ namespace gtsam {
     /** Gather data on a single clique */
     void getCliqueData(sharedClique clique, BayesTreeCliqueData* stats) const;
 
+    /** Gather memory usage of a single clique and its children */
+    void memoryUsage(sharedClique clique, BayesTreeMemoryUsage* usage) const;
+
     /** remove a clique: warning, can result in a forest */
     void removeClique(sharedClique clique);
 
@@ -146,9 +146,15 @@ namespace gtsam {
   {
     gttic(BayesTreeCliqueBase_separatorMarginal);
     // Check if the Separator marginal was already calculated
-    if (!cachedSeparatorMarginal_)
+    if (cachedSeparatorMarginal_)
+    {
+      ++cacheRegistry().statistics.hits;
+      touchCacheEntry();
+    }
+    else
     {
       gttic(BayesTreeCliqueBase_separatorMarginal_cachemiss);
+      ++cacheRegistry().statistics.misses;
       // If this is the root, there is no separator
       if (parent_.expired() /*(if we're the root)*/)
       {
@@ -173,6 +179,9 @@ namespace gtsam {
         KeyVector indicesS(this->conditional()->beginParents(), this->conditional()->endParents());
         cachedSeparatorMarginal_ = *p_Cp.marginalMultifrontalBayesNet(Ordering(indicesS), function);
       }
+
+      // Track the new entry, evicting stale marginals if over budget
+      registerCacheEntry();
     }
 
     // return the shortcut P(S||B)
@@ -208,9 +217,95 @@ namespace gtsam {
       }
 
       //Delete CachedShortcut for this clique
+      unregisterCacheEntry();
       cachedSeparatorMarginal_ = boost::none;
     }
 
   }
 
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  typename BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::CacheRegistry&
+  BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::cacheRegistry()
+  {
+    static CacheRegistry registry;
+    return registry;
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::SetSeparatorMarginalBudget(
+      size_t maxCachedMarginals)
+  {
+    cacheRegistry().budget = maxCachedMarginals;
+    EvictOverBudget(); // enforce the new budget right away
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  const typename BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::CacheStatistics&
+  BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::GetCacheStatistics()
+  {
+    return cacheRegistry().statistics;
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::ResetCacheStatistics()
+  {
+    cacheRegistry().statistics = CacheStatistics();
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::EvictOverBudget()
+  {
+    CacheRegistry& registry = cacheRegistry();
+    if (registry.budget == 0)
+      return;
+    while (registry.entries.size() > registry.budget) {
+      const This* victim = registry.lru.back();
+      registry.lru.pop_back();
+      registry.entries.erase(victim);
+      victim->cachedSeparatorMarginal_ = boost::none;
+      ++registry.statistics.evictions;
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::touchCacheEntry() const
+  {
+    CacheRegistry& registry = cacheRegistry();
+    auto entry = registry.entries.find(this);
+    if (entry != registry.entries.end())
+      registry.lru.splice(registry.lru.begin(), registry.lru, entry->second);
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::registerCacheEntry() const
+  {
+    CacheRegistry& registry = cacheRegistry();
+    if (registry.entries.count(this)) {
+      touchCacheEntry();
+    } else {
+      registry.lru.push_front(this);
+      registry.entries.emplace(this, registry.lru.begin());
+    }
+    EvictOverBudget();
+  }
+
+  /* ************************************************************************* */
+  template<class DERIVED, class FACTORGRAPH>
+  void BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::unregisterCacheEntry() const
+  {
+    CacheRegistry& registry = cacheRegistry();
+    auto entry = registry.entries.find(this);
+    if (entry != registry.entries.end()) {
+      registry.lru.erase(entry->second);
+      registry.entries.erase(entry);
+    }
+  }
+
 }
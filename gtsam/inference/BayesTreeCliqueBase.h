@@ -20,9 +20,11 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/types.h>
+#include <gtsam/base/FastMap.h>
 #include <gtsam/base/FastVector.h>
 #include <boost/optional.hpp>
 
+#include <list>
 #include <string>
 
 namespace gtsam {
@@ -77,6 +79,15 @@ namespace gtsam {
 
     /// @}
 
+  public:
+
+    ~BayesTreeCliqueBase() {
+      if (cachedSeparatorMarginal_)
+        unregisterCacheEntry();
+    }
+
+  protected:
+
     /// This stores the Cached separator margnal P(S)
     mutable boost::optional<FactorGraphType> cachedSeparatorMarginal_;
 
@@ -146,6 +157,31 @@ namespace gtsam {
     const boost::optional<FactorGraphType>& cachedSeparatorMarginal() const {
       return cachedSeparatorMarginal_; }
 
+    /// Hit/miss/eviction counters of the separator-marginal cache
+    struct CacheStatistics {
+      size_t hits;      ///< separatorMarginal calls answered from the cache
+      size_t misses;    ///< separatorMarginal calls that had to recompute
+      size_t evictions; ///< cached marginals dropped to stay within budget
+      CacheStatistics() : hits(0), misses(0), evictions(0) {}
+    };
+
+    /**
+     * Bound the number of cliques allowed to keep a cached separator marginal
+     * (0 = unlimited, the default).  When the budget is exceeded, the least
+     * recently used marginals are dropped and transparently recomputed if
+     * queried again, so memory stays bounded on long ISAM2 runs while the hot
+     * cliques touched by marginal queries keep their cache.  The budget and
+     * counters are shared by all trees of this clique type; like the cache
+     * itself they are not thread-safe.
+     */
+    static void SetSeparatorMarginalBudget(size_t maxCachedMarginals);
+
+    /// Counters of the separator-marginal cache
+    static const CacheStatistics& GetCacheStatistics();
+
+    /// Reset the separator-marginal cache counters to zero
+    static void ResetCacheStatistics();
+
     friend class BayesTree<DerivedType>;
 
   protected:
@@ -159,10 +195,32 @@ namespace gtsam {
     KeyVector shortcut_indices(const derived_ptr& B, const FactorGraphType& p_Cp_B) const;
 
     /** Non-recursive delete cached shortcuts and marginals - internal only. */
-    void deleteCachedShortcutsNonRecursive() { cachedSeparatorMarginal_ = boost::none; }
+    void deleteCachedShortcutsNonRecursive() {
+      if (cachedSeparatorMarginal_) {
+        unregisterCacheEntry();
+        cachedSeparatorMarginal_ = boost::none;
+      }
+    }
 
   private:
 
+    /// LRU registry of the cliques currently holding a cached separator marginal
+    struct CacheRegistry {
+      size_t budget; ///< maximum number of cached marginals, 0 = unlimited
+      CacheStatistics statistics;
+      std::list<const This*> lru; ///< most recently used in front
+      FastMap<const This*, typename std::list<const This*>::iterator> entries;
+      CacheRegistry() : budget(0) {}
+    };
+    static CacheRegistry& cacheRegistry();
+
+    /// Drop least recently used cached marginals until within budget
+    static void EvictOverBudget();
+
+    void touchCacheEntry() const;
+    void registerCacheEntry() const;
+    void unregisterCacheEntry() const;
+
     /** Serialization function */
     friend class boost::serialization::access;
     template<class ARCHIVE>
@@ -0,0 +1,69 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CliquePool.h
+ * @brief   Contiguous allocation pool for BayesTree cliques
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/base/MemoryArena.h>
+
+#include <boost/make_shared.hpp>
+
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * Allocation pool for BayesTree cliques.  Cliques are normally allocated as
+ * individual heap shared_ptrs at elimination time, so a parent and its
+ * children can land anywhere on the heap and backsubstitution traversals
+ * walk pointer chains across scattered pages - a TLB- and cache-bound
+ * pattern on large trees.  The pool hands out cliques bump-allocated from a
+ * MemoryArena, with object and shared_ptr control block placed together, so
+ * cliques allocated consecutively are laid out consecutively in memory.
+ * Combined with BayesTree::relocateCliques, which re-allocates an existing
+ * tree in depth-first order, parent-child runs and sibling lists become
+ * contiguous.
+ *
+ * Individual deallocation inside the arena is a no-op: destructors of freed
+ * cliques still run (releasing their matrices), but their slots are only
+ * reclaimed by reset().  Call reset() solely when no clique from the pool is
+ * alive - e.g. after relocating a tree into a fresh pool during a big
+ * recalculate - and keep the pool alive as long as its tree.
+ */
+class CliquePool {
+ public:
+  explicit CliquePool(size_t blockSize = MemoryArena::kDefaultBlockSize) :
+      arena_(blockSize) {
+  }
+
+  /// Allocate a clique from the pool; the next allocation is adjacent
+  template<class CLIQUE, typename... Args>
+  boost::shared_ptr<CLIQUE> allocate(Args&&... args) {
+    return boost::allocate_shared<CLIQUE>(ArenaAllocator<CLIQUE>(arena_),
+        std::forward<Args>(args)...);
+  }
+
+  /// Reclaim all memory at once; only valid once every clique is released
+  void reset() { arena_.reset(); }
+
+  /// Total bytes of storage owned by the pool
+  size_t capacity() const { return arena_.capacity(); }
+
+ private:
+  MemoryArena arena_;
+};
+
+}  // namespace gtsam
@@ -14,9 +14,51 @@
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
+#include <gtsam/base/prefetch.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/SmallVector.h>
 
 namespace gtsam {
 
+/* ************************************************************************* */
+// Execution schedule of the numeric phase: records, for every cluster, the
+// cluster eliminated right after it in post-order, so the elimination visitor
+// can stage the next clique's factor blocks with software prefetches while
+// the current clique factorizes.  Under parallel traversal the realized order
+// may deviate from the schedule; the hints are then merely early, never wrong.
+template<class CLUSTERTREE>
+struct EliminationSchedule {
+  typedef typename CLUSTERTREE::Node Node;
+
+  FastMap<const Node*, const Node*> next;
+
+  explicit EliminationSchedule(const CLUSTERTREE& tree) {
+    FastVector<const Node*> postOrder;
+    for (const typename CLUSTERTREE::sharedNode& root : tree.roots())
+      collect(root.get(), postOrder);
+    for (size_t i = 0; i + 1 < postOrder.size(); ++i)
+      next.insert(std::make_pair(postOrder[i], postOrder[i + 1]));
+  }
+
+  // Issue read prefetches for the factors of the cluster scheduled after node
+  void prefetchNext(const Node* node) const {
+    typename FastMap<const Node*, const Node*>::const_iterator item =
+        next.find(node);
+    if (item == next.end())
+      return;
+    for (const typename CLUSTERTREE::sharedFactor& factor : item->second->factors)
+      if (factor)
+        prefetchRange(factor.get(), sizeof(typename CLUSTERTREE::FactorType));
+  }
+
+private:
+  void collect(const Node* node, FastVector<const Node*>& postOrder) const {
+    for (const typename CLUSTERTREE::sharedNode& child : node->children)
+      collect(child.get(), postOrder);
+    postOrder.push_back(node);
+  }
+};
+
 /* ************************************************************************* */
 template<class GRAPH>
 void ClusterTree<GRAPH>::Cluster::print(const std::string& s,
@@ -118,14 +160,23 @@ struct EliminationData {
 
   EliminationData* const parentData;
   size_t myIndexInParent;
-  FastVector<sharedFactor> childFactors;
+  // Small-buffer storage: almost all clusters have at most a handful of
+  // children, so the remaining-factor slots live inline with no allocation.
+  // The slots are sized once from the known tree arity below; children write
+  // their remaining factors in place instead of growing the vector.
+  SmallVector<sharedFactor> childFactors;
+  size_t nrChildrenRegistered;
   boost::shared_ptr<BTNode> bayesTreeNode;
 
   EliminationData(EliminationData* _parentData, size_t nChildren) :
-      parentData(_parentData), bayesTreeNode(boost::make_shared<BTNode>()) {
+      parentData(_parentData), nrChildrenRegistered(0),
+      bayesTreeNode(boost::make_shared<BTNode>()) {
+    // Preallocate one result slot per child from the arity; slots of children
+    // whose elimination leaves no remaining factor stay null
+    childFactors.resize(nChildren);
     if (parentData) {
-      myIndexInParent = parentData->childFactors.size();
-      parentData->childFactors.push_back(sharedFactor());
+      myIndexInParent = parentData->nrChildrenRegistered++;
+      assert(myIndexInParent < parentData->childFactors.size());
     } else {
       myIndexInParent = 0;
     }
@@ -152,24 +203,36 @@ struct EliminationData {
   class EliminationPostOrderVisitor {
     const typename CLUSTERTREE::Eliminate& eliminationFunction_;
     typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex_;
+    const EliminationSchedule<CLUSTERTREE>* schedule_;
 
   public:
     // Construct functor
     EliminationPostOrderVisitor(
         const typename CLUSTERTREE::Eliminate& eliminationFunction,
-        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex) :
-        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex) {
+        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex,
+        const EliminationSchedule<CLUSTERTREE>* schedule = 0) :
+        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex),
+        schedule_(schedule) {
     }
 
     // Function that does the HEAVY lifting
     void operator()(const typename CLUSTERTREE::sharedNode& node, EliminationData& myData) {
       assert(node);
 
-      // Gather factors
+      // Stage the factor blocks of the next scheduled clique while the dense
+      // elimination below has this one's data in flight
+      if (schedule_)
+        schedule_->prefetchNext(node.get());
+
+      // Gather factors.  The child slots were written in place during the
+      // children's post-order visits; move them in rather than copying
+      // shared_ptrs, and skip the null slots of children that eliminated away
       FactorGraphType gatheredFactors;
       gatheredFactors.reserve(node->factors.size() + node->nrChildren());
       gatheredFactors += node->factors;
-      gatheredFactors += myData.childFactors;
+      for (sharedFactor& childFactor : myData.childFactors)
+        if (childFactor)
+          gatheredFactors.push_back(std::move(childFactor));
 
       // Check for Bayes tree orphan subtrees, and add them to our children
       // TODO(frank): should this really happen here?
@@ -228,11 +291,12 @@ EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function)
   typedef EliminationData<This> Data;
   Data rootsContainer(0, this->nrRoots());
 
-  typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_);
+  const EliminationSchedule<This> schedule(*this);
+  typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_, &schedule);
   {
     TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
     treeTraversal::DepthFirstForestParallel(*this, rootsContainer, Data::EliminationPreOrderVisitor,
-                                            visitorPost, 10);
+                                            visitorPost, treeTraversal::parallelTraversalThreshold);
   }
 
   // Create BayesTree from roots stored in the dummy BayesTree node.
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex-inl.h
+ * @author  Richard Roberts
+ */
+
+#pragma once
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+template<class FG>
+CompressedVariableIndex::CompressedVariableIndex(const FG& factorGraph) :
+    nFactors_(0), overlayEntries_(0) {
+  gttic(CompressedVariableIndex_build);
+
+  // Pass 1: count the entries per variable.  The ordered map doubles as the
+  // sorted key enumeration, and its values become column numbers below.
+  FastMap<Key, size_t> counts;
+  for (size_t i = 0; i < factorGraph.size(); ++i) {
+    if (factorGraph[i])
+      for(const Key key: *factorGraph[i])
+        ++counts[key];
+    ++nFactors_;
+  }
+
+  // Prefix sum over the counts, repurposing each map value as the running
+  // write cursor of its column.
+  keys_.reserve(counts.size());
+  offsets_.reserve(counts.size() + 1);
+  offsets_.push_back(0);
+  for (FastMap<Key, size_t>::iterator item = counts.begin();
+      item != counts.end(); ++item) {
+    keys_.push_back(item->first);
+    offsets_.push_back(offsets_.back() + item->second);
+    item->second = offsets_[offsets_.size() - 2];
+  }
+
+  // Pass 2: scatter the factor indices into the flat array.  Scanning the
+  // factors in order leaves every column sorted by factor index.
+  entries_.resize(offsets_.back());
+  for (size_t i = 0; i < factorGraph.size(); ++i) {
+    if (factorGraph[i])
+      for(const Key key: *factorGraph[i])
+        entries_[counts[key]++] = i;
+  }
+}
+
+/* ************************************************************************* */
+template<class FG>
+void CompressedVariableIndex::augment(const FG& factors) {
+  gttic(CompressedVariableIndex_augment);
+
+  for (size_t i = 0; i < factors.size(); ++i) {
+    if (factors[i]) {
+      for(const Key key: *factors[i]) {
+        overlay_[key].push_back(nFactors_);
+        ++overlayEntries_;
+      }
+    }
+    // Increment factor count even if factors are null, to keep indices consistent
+    ++nFactors_;
+  }
+}
+
+}
@@ -0,0 +1,145 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex.cpp
+ * @author  Richard Roberts
+ */
+
+#include <iostream>
+#include <algorithm>
+
+#include <gtsam/inference/CompressedVariableIndex.h>
+
+namespace gtsam {
+
+using namespace std;
+
+/* ************************************************************************* */
+CompressedVariableIndex::CompressedVariableIndex(
+    const VariableIndex& variableIndex) :
+    nFactors_(variableIndex.nFactors()), overlayEntries_(0) {
+  // The map in a VariableIndex is already key-sorted, so a single sweep
+  // concatenates its columns into the flat layout.
+  keys_.reserve(variableIndex.size());
+  offsets_.reserve(variableIndex.size() + 1);
+  offsets_.push_back(0);
+  entries_.reserve(variableIndex.nEntries());
+  for(const VariableIndex::value_type& key_factors: variableIndex) {
+    keys_.push_back(key_factors.first);
+    entries_.insert(entries_.end(), key_factors.second.begin(),
+        key_factors.second.end());
+    offsets_.push_back(entries_.size());
+  }
+}
+
+/* ************************************************************************* */
+size_t CompressedVariableIndex::columnOf(Key variable) const {
+  KeyVector::const_iterator it = std::lower_bound(keys_.begin(), keys_.end(),
+      variable);
+  if (it == keys_.end() || *it != variable)
+    throw std::invalid_argument(
+        "Requested non-existent variable from CompressedVariableIndex");
+  return it - keys_.begin();
+}
+
+/* ************************************************************************* */
+FactorIndices CompressedVariableIndex::factors(Key variable) const {
+  FactorIndices result;
+  KeyVector::const_iterator it = std::lower_bound(keys_.begin(), keys_.end(),
+      variable);
+  const bool inBase = (it != keys_.end() && *it == variable);
+  const FactorIndices* extra = overlay(variable);
+  if (!inBase && !extra)
+    throw std::invalid_argument(
+        "Requested non-existent variable from CompressedVariableIndex");
+  if (inBase) {
+    const size_t j = it - keys_.begin();
+    result.insert(result.end(), entries_.begin() + offsets_[j],
+        entries_.begin() + offsets_[j + 1]);
+  }
+  if (extra)
+    result.insert(result.end(), extra->begin(), extra->end());
+  return result;
+}
+
+/* ************************************************************************* */
+bool CompressedVariableIndex::equals(const CompressedVariableIndex& other,
+    double tol) const {
+  if (this->nFactors_ != other.nFactors_
+      || this->nEntries() != other.nEntries() || this->size() != other.size())
+    return false;
+  // Compare the merged columns so that two indices holding the same structure
+  // compare equal regardless of what sits in the overlay of each.
+  for (size_t j = 0; j < keys_.size(); ++j)
+    if (keys_[j] != other.keys_[j] || factors(keys_[j]) != other.factors(keys_[j]))
+      return false;
+  return true;
+}
+
+/* ************************************************************************* */
+void CompressedVariableIndex::print(const string& str,
+    const KeyFormatter& keyFormatter) const {
+  cout << str;
+  cout << "nEntries = " << nEntries() << ", nFactors = " << nFactors() << "\n";
+  for (size_t j = 0; j < keys_.size(); ++j) {
+    cout << "var " << keyFormatter(keys_[j]) << ":";
+    for(const auto index: factors(keys_[j]))
+      cout << " " << index;
+    cout << "\n";
+  }
+  cout.flush();
+}
+
+/* ************************************************************************* */
+void CompressedVariableIndex::recompress() {
+  gttic(CompressedVariableIndex_recompress);
+  if (overlay_.empty())
+    return;
+
+  // Merge the sorted base columns with the key-sorted overlay in one sweep,
+  // writing into fresh arrays sized for the union.
+  KeyVector newKeys;
+  FastVector<size_t> newOffsets;
+  FactorIndices newEntries;
+  newKeys.reserve(keys_.size() + overlay_.size());
+  newOffsets.reserve(keys_.size() + overlay_.size() + 1);
+  newOffsets.push_back(0);
+  newEntries.reserve(entries_.size() + overlayEntries_);
+
+  size_t j = 0;
+  FastMap<Key, FactorIndices>::const_iterator item = overlay_.begin();
+  while (j < keys_.size() || item != overlay_.end()) {
+    const bool takeBase = item == overlay_.end()
+        || (j < keys_.size() && keys_[j] <= item->first);
+    const Key key = takeBase ? keys_[j] : item->first;
+    newKeys.push_back(key);
+    if (takeBase) {
+      newEntries.insert(newEntries.end(), entries_.begin() + offsets_[j],
+          entries_.begin() + offsets_[j + 1]);
+      ++j;
+    }
+    if (item != overlay_.end() && item->first == key) {
+      newEntries.insert(newEntries.end(), item->second.begin(),
+          item->second.end());
+      ++item;
+    }
+    newOffsets.push_back(newEntries.size());
+  }
+
+  keys_.swap(newKeys);
+  offsets_.swap(newOffsets);
+  entries_.swap(newEntries);
+  overlay_.clear();
+  overlayEntries_ = 0;
+}
+
+}
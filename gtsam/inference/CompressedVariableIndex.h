@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    CompressedVariableIndex.h
+ * @brief   Compressed sparse column storage of a factor graph's block structure
+ * @author  Richard Roberts
+ */
+
+#pragma once
+
+#include <gtsam/inference/VariableIndex.h>
+
+namespace gtsam {
+
+/**
+ * A CompressedVariableIndex stores the same variable-to-factor structure as a
+ * VariableIndex, but in compressed sparse column (CSR/CSC) form: one flat
+ * array of factor indices plus one offsets array delimiting the per-variable
+ * columns, with the variable keys in a parallel sorted array.  Compared to
+ * the map-of-vectors layout this costs a single allocation instead of one
+ * heap vector per variable, and sweeps over all entries (as done by COLAMD
+ * and elimination-tree construction) touch memory sequentially.
+ *
+ * The compressed arrays are immutable; incremental additions go into a small
+ * map overlay via augment() and are merged back into the flat storage by
+ * recompress().  Queries see the union of the base arrays and the overlay.
+ * \nosubgrouping
+ */
+class GTSAM_EXPORT CompressedVariableIndex {
+ public:
+  typedef boost::shared_ptr<CompressedVariableIndex> shared_ptr;
+
+ protected:
+  KeyVector keys_;  // Variable keys, sorted, one per column.
+  FastVector<size_t> offsets_;  // Column j spans entries_[offsets_[j], offsets_[j+1]).
+  FactorIndices entries_;  // Flat factor indices, column-major.
+  FastMap<Key, FactorIndices> overlay_;  // Entries added since the last recompress().
+  size_t nFactors_;  // Number of factors in the original factor graph.
+  size_t overlayEntries_;  // Sum of overlay column sizes.
+
+ public:
+  /// @name Standard Constructors
+  /// @{
+
+  /// Default constructor, creates an empty index
+  CompressedVariableIndex() : offsets_(1, 0), nFactors_(0), overlayEntries_(0) {}
+
+  /**
+   * Build the compressed index directly from a factor graph using a counting
+   * sort: one pass to count the entries per variable, a prefix sum over the
+   * counts, and one pass to scatter the factor indices into place.
+   */
+  template <class FG>
+  explicit CompressedVariableIndex(const FG& factorGraph);
+
+  /// Convert an existing VariableIndex into compressed form.
+  explicit CompressedVariableIndex(const VariableIndex& variableIndex);
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /// The number of variable entries.  This is equal to the number of unique variable Keys.
+  size_t size() const { return keys_.size(); }
+
+  /// The number of factors in the original factor graph
+  size_t nFactors() const { return nFactors_; }
+
+  /// The number of nonzero blocks, i.e. the number of variable-factor entries
+  size_t nEntries() const { return entries_.size() + overlayEntries_; }
+
+  /// The sorted variable keys, one per column
+  const KeyVector& keys() const { return keys_; }
+
+  /// The column offsets array, of size size()+1
+  const FastVector<size_t>& offsets() const { return offsets_; }
+
+  /// The flat column-major factor index array
+  const FactorIndices& entries() const { return entries_; }
+
+  /// Find the column of a variable by binary search, throws if not present
+  size_t columnOf(Key variable) const;
+
+  /**
+   * The factors of column j in the compressed arrays, excluding any overlay
+   * entries.  Zero-copy; the preferred accessor for sequential sweeps.
+   */
+  std::pair<FactorIndices::const_iterator, FactorIndices::const_iterator>
+  column(size_t j) const {
+    return std::make_pair(entries_.begin() + offsets_[j],
+        entries_.begin() + offsets_[j + 1]);
+  }
+
+  /// The overlay entries of a variable, or null if it has none
+  const FactorIndices* overlay(Key variable) const {
+    FastMap<Key, FactorIndices>::const_iterator item = overlay_.find(variable);
+    return item == overlay_.end() ? nullptr : &item->second;
+  }
+
+  /**
+   * All factors involving a variable, concatenating the compressed column and
+   * any overlay entries.  Returns by value; use column()/overlay() to avoid
+   * the copy in hot loops.
+   */
+  FactorIndices factors(Key variable) const;
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /// Test for equality (for unit tests and debug assertions).
+  bool equals(const CompressedVariableIndex& other, double tol = 0.0) const;
+
+  /// Print the variable index (for unit tests and debugging).
+  void print(const std::string& str = "CompressedVariableIndex: ",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @}
+  /// @name Advanced Interface
+  /// @{
+
+  /**
+   * Augment the index with new factors.  The new entries go into the map
+   * overlay, leaving the compressed arrays untouched; call recompress() once
+   * a batch of additions is complete to restore the flat layout.
+   */
+  template <class FG>
+  void augment(const FG& factors);
+
+  /// Merge the overlay back into the compressed arrays, in one counting-sort pass.
+  void recompress();
+
+  /// @}
+};
+
+/// traits
+template<>
+struct traits<CompressedVariableIndex> : public Testable<CompressedVariableIndex> {
+};
+
+} //\ namespace gtsam
+
+#include <gtsam/inference/CompressedVariableIndex-inl.h>
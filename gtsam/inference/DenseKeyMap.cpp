@@ -0,0 +1,64 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseKeyMap.cpp
+ * @brief   Incrementally maintained bijection between sparse Keys and [0,n)
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/inference/DenseKeyMap.h>
+
+#include <iostream>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+DenseIndex DenseKeyMap::insert(Key key) {
+  const DenseIndex id = static_cast<DenseIndex>(keys_.size());
+  if (!indexOf_.insert(std::make_pair(key, id)).second)
+    throw std::invalid_argument("Duplicate key inserted into DenseKeyMap");
+  keys_.push_back(key);
+  return id;
+}
+
+/* ************************************************************************* */
+boost::optional<std::pair<Key, DenseIndex> > DenseKeyMap::erase(Key key) {
+  const FastMap<Key, DenseIndex>::iterator item = indexOf_.find(key);
+  if (item == indexOf_.end())
+    throw std::invalid_argument("Erased non-existent key from DenseKeyMap");
+  const DenseIndex freedId = item->second;
+  indexOf_.erase(item);
+  const Key lastKey = keys_.back();
+  keys_.pop_back();
+  if (lastKey == key) return boost::none;  // Erased the highest id
+  // Move the key with the highest id into the freed slot
+  keys_[freedId] = lastKey;
+  indexOf_[lastKey] = freedId;
+  return std::make_pair(lastKey, freedId);
+}
+
+/* ************************************************************************* */
+bool DenseKeyMap::equals(const DenseKeyMap& other, double /*tol*/) const {
+  return keys_ == other.keys_;
+}
+
+/* ************************************************************************* */
+void DenseKeyMap::print(const std::string& str,
+                        const KeyFormatter& keyFormatter) const {
+  std::cout << str << size() << " keys:\n";
+  for (DenseIndex id = 0; id < static_cast<DenseIndex>(keys_.size()); ++id)
+    std::cout << "  " << id << ": " << keyFormatter(keys_[id]) << "\n";
+  std::cout.flush();
+}
+
+/* ************************************************************************* */
+}  // namespace gtsam
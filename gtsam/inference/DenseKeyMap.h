@@ -0,0 +1,148 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DenseKeyMap.h
+ * @brief   Incrementally maintained bijection between sparse Keys and [0,n)
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/types.h>
+#include <gtsam/dllexport.h>
+
+#include <boost/optional/optional.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * A bijection between the sparse 64-bit Key space (e.g. chr+index Symbols)
+ * and the dense integer range [0,n), maintained incrementally as variables
+ * are added and removed.  Keys are numbered in order of insertion, so
+ * per-variable quantities can be stored in flat arrays indexed by the dense
+ * id instead of in hash maps keyed by the sparse Key: the Key is hashed once
+ * here, and every downstream lookup is a plain array access.
+ *
+ * The ids stay dense under removal by moving the key with the highest id
+ * into the freed slot, so at most one key is relabeled per erase() and a
+ * downstream flat array is patched by moving a single element.
+ */
+class GTSAM_EXPORT DenseKeyMap {
+ protected:
+  FastMap<Key, DenseIndex> indexOf_;  ///< Key -> dense id
+  KeyVector keys_;                    ///< dense id -> Key
+
+ public:
+  /// @name Standard Constructors
+  /// @{
+
+  /// Default constructor, creates an empty mapping
+  DenseKeyMap() {}
+
+  /**
+   * Create a mapping covering all keys of a factor graph, numbered in order
+   * of first appearance.
+   */
+  template <class FG>
+  explicit DenseKeyMap(const FG& factorGraph) {
+    for (const auto& factor : factorGraph) {
+      if (!factor) continue;
+      for (Key key : *factor)
+        if (!exists(key)) insert(key);
+    }
+  }
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /// The number of mapped keys, equal to the one-past-the-highest dense id
+  size_t size() const { return keys_.size(); }
+
+  /// Whether no keys are mapped
+  bool empty() const { return keys_.empty(); }
+
+  /// Whether a key is mapped
+  bool exists(Key key) const { return indexOf_.find(key) != indexOf_.end(); }
+
+  /// The dense id of a key, throws std::invalid_argument if not mapped
+  DenseIndex at(Key key) const {
+    const FastMap<Key, DenseIndex>::const_iterator item = indexOf_.find(key);
+    if (item == indexOf_.end())
+      throw std::invalid_argument(
+          "Requested non-existent key from DenseKeyMap");
+    return item->second;
+  }
+
+  /// The key holding a dense id, which must be in [0,size())
+  Key keyAt(DenseIndex id) const { return keys_.at(id); }
+
+  /// All keys ordered by dense id
+  const KeyVector& keys() const { return keys_; }
+
+  /// @}
+  /// @name Advanced Interface
+  /// @{
+
+  /// Map a new key to the next dense id and return that id; throws
+  /// std::invalid_argument if the key is already mapped
+  DenseIndex insert(Key key);
+
+  /// Map every key in a range, in order
+  template <typename ITERATOR>
+  void insert(ITERATOR firstKey, ITERATOR lastKey) {
+    for (ITERATOR it = firstKey; it != lastKey; ++it) insert(*it);
+  }
+
+  /**
+   * Unmap a key.  To keep the ids dense, the key currently holding the
+   * highest id takes over the freed id; that key and its new id are returned
+   * so a downstream flat array can be patched by moving one element.  When
+   * the erased key already held the highest id nothing moves and boost::none
+   * is returned.  Throws std::invalid_argument if the key is not mapped.
+   */
+  boost::optional<std::pair<Key, DenseIndex> > erase(Key key);
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /// Test for equality (same keys with the same ids)
+  bool equals(const DenseKeyMap& other, double tol = 0.0) const;
+
+  /// Print the mapping (for unit tests and debugging)
+  void print(const std::string& str = "DenseKeyMap: ",
+             const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @}
+
+ private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& BOOST_SERIALIZATION_NVP(indexOf_);
+    ar& BOOST_SERIALIZATION_NVP(keys_);
+  }
+};
+
+/// traits
+template <>
+struct traits<DenseKeyMap> : public Testable<DenseKeyMap> {};
+
+}  // namespace gtsam
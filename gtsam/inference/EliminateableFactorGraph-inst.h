@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/inference/EliminateableFactorGraph.h>
+#include <gtsam/inference/MultifrontalPlan-inst.h>
 #include <gtsam/inference/inferenceExceptions.h>
 #include <boost/tuple/tuple.hpp>
 
@@ -132,6 +133,50 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesTreeType>
+    EliminateableFactorGraph<FACTORGRAPH>::eliminateMultifrontal(
+    const Ordering& ordering, const AmalgamationPolicy& policy,
+    const Eliminate& function, OptionalVariableIndex variableIndex) const
+  {
+    if(!variableIndex) {
+      // If no VariableIndex provided, compute one and call this function again
+      VariableIndex computedVariableIndex(asDerived());
+      return eliminateMultifrontal(ordering, policy, function, computedVariableIndex);
+    } else {
+      gttic(eliminateMultifrontal);
+      // Do elimination with given ordering, amalgamating cliques per the policy
+      EliminationTreeType etree(asDerived(), *variableIndex, ordering);
+      JunctionTreeType junctionTree(etree, policy);
+      boost::shared_ptr<BayesTreeType> bayesTree;
+      boost::shared_ptr<FactorGraphType> factorGraph;
+      boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function);
+      // If any factors are remaining, the ordering was incomplete
+      if(!factorGraph->empty())
+        throw InconsistentEliminationRequested();
+      // Return the Bayes tree
+      return bayesTree;
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  boost::shared_ptr<MultifrontalPlan<FACTORGRAPH> >
+    EliminateableFactorGraph<FACTORGRAPH>::planMultifrontal(
+    const Ordering& ordering, OptionalVariableIndex variableIndex) const
+  {
+    if(!variableIndex) {
+      // If no VariableIndex provided, compute one and call this function again
+      VariableIndex computedVariableIndex(asDerived());
+      return planMultifrontal(ordering, computedVariableIndex);
+    } else {
+      gttic(planMultifrontal);
+      return boost::make_shared<MultifrontalPlan<FACTORGRAPH> >(
+        asDerived(), ordering, *variableIndex);
+    }
+  }
+
   /* ************************************************************************* */
   template<class FACTORGRAPH>
   std::pair<boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesNetType>, boost::shared_ptr<FACTORGRAPH> >
@@ -28,6 +28,10 @@
 
 namespace gtsam {
 
+  // Forward declarations
+  template<class FACTORGRAPH> class MultifrontalPlan;
+  struct AmalgamationPolicy;
+
   /// Traits class for eliminateable factor graphs, specifies the types that result from
   /// elimination, etc.  This must be defined for each factor graph that inherits from
   /// EliminateableFactorGraph.
@@ -173,6 +177,36 @@ namespace gtsam {
       const Eliminate& function = EliminationTraitsType::DefaultEliminate,
       OptionalVariableIndex variableIndex = boost::none) const;
 
+    /** Do multifrontal elimination in the \c ordering provided, amalgamating
+     *  elimination-tree nodes into cliques according to \c policy instead of the
+     *  structural rule alone.  Clique granularity trades tree parallelism
+     *  against dense-block efficiency; see AmalgamationPolicy for the knobs and
+     *  timing/timeAmalgamationPolicy.cpp for measurements:
+     *  \code
+     *  AmalgamationPolicy policy(0, 0, 1000); // grow cliques to ~1000 flops
+     *  boost::shared_ptr<GaussianBayesTree> result = graph.eliminateMultifrontal(myOrdering, policy, EliminateCholesky);
+     *  \endcode
+     *  */
+    boost::shared_ptr<BayesTreeType> eliminateMultifrontal(
+      const Ordering& ordering,
+      const AmalgamationPolicy& policy,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate,
+      OptionalVariableIndex variableIndex = boost::none) const;
+
+    /** Build a reusable symbolic elimination plan for this graph with the given ordering.  The
+     *  plan caches the symbolic analysis performed by eliminateMultifrontal (elimination tree,
+     *  junction tree, and clique structure), so that repeated numeric eliminations of graphs with
+     *  identical sparsity - e.g. successive relinearizations inside a nonlinear optimizer - skip
+     *  the symbolic work entirely:
+     *  \code
+     *  boost::shared_ptr<MultifrontalPlan<GaussianFactorGraph> > plan = graph.planMultifrontal(ordering);
+     *  boost::shared_ptr<GaussianBayesTree> result1 = plan->eliminate(graph, EliminateCholesky);
+     *  boost::shared_ptr<GaussianBayesTree> result2 = plan->eliminate(relinearizedGraph, EliminateCholesky);
+     *  \endcode */
+    boost::shared_ptr<MultifrontalPlan<FactorGraphType> > planMultifrontal(
+      const Ordering& ordering,
+      OptionalVariableIndex variableIndex = boost::none) const;
+
     /** Do sequential elimination of some variables, in \c ordering provided, to produce a Bayes net
      *  and a remaining factor graph.  This computes the factorization \f$ p(X) = p(A|B) p(B) \f$,
      *  where \f$ A = \f$ \c variables, \f$ X \f$ is all the variables in the factor graph, and \f$
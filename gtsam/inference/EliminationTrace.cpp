@@ -0,0 +1,171 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationTrace.cpp
+ * @brief   Replayable record of a simulated vertex elimination, for ordering
+ *          diagnostics
+ * @author  Richard Roberts
+ * @date    Sep 2, 2010
+ */
+
+#include <gtsam/inference/EliminationTrace.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+EliminationTrace EliminationTrace::Simulate(const VariableIndex& variableIndex,
+    const Ordering& ordering) {
+  gttic(EliminationTrace_Simulate);
+
+  if (ordering.size() != variableIndex.size())
+    throw invalid_argument("EliminationTrace::Simulate: ordering and variable "
+        "index describe different variable sets");
+
+  EliminationTrace trace;
+
+  // The VariableIndex stores factors per variable; invert it so every
+  // factor's key list is available to form its clique in the variable graph
+  FastVector<FastVector<Key> > factorKeys(variableIndex.nFactors());
+  for (const auto& key_factors : variableIndex)
+    for (size_t factorIndex : key_factors.second)
+      factorKeys[factorIndex].push_back(key_factors.first);
+
+  // Build the variable connectivity graph: two variables are adjacent iff
+  // they appear together in some factor
+  FastMap<Key, FastSet<Key> > adjacency;
+  for (const auto& key_factors : variableIndex)
+    adjacency.insert(make_pair(key_factors.first, FastSet<Key>()));
+  for (const FastVector<Key>& clique : factorKeys) {
+    for (Key key1 : clique)
+      for (Key key2 : clique)
+        if (key1 != key2)
+          adjacency.at(key1).insert(key2);
+  }
+  for (const auto& key_neighbors : adjacency)
+    trace.nrOriginalEdges_ += key_neighbors.second.size();
+  trace.nrOriginalEdges_ /= 2; // each edge was counted from both ends
+  trace.originalEdges_ = adjacency;
+
+  // Play the elimination game: each step removes the next variable and
+  // pairwise connects its remaining neighbors, recording the edges that did
+  // not exist before as fill
+  trace.steps_.reserve(ordering.size());
+  FastSet<Key> eliminated;
+  for (Key key : ordering) {
+    const FastMap<Key, FastSet<Key> >::iterator item = adjacency.find(key);
+    if (item == adjacency.end())
+      throw invalid_argument("EliminationTrace::Simulate: ordering contains a "
+          "key that is not in the variable index");
+
+    Step step;
+    step.key = key;
+
+    // Gather the uneliminated neighbors - the front of this step
+    FastVector<Key> neighbors;
+    neighbors.reserve(item->second.size());
+    for (Key neighbor : item->second)
+      if (!eliminated.count(neighbor))
+        neighbors.push_back(neighbor);
+    step.degree = neighbors.size();
+
+    // Connect the front pairwise; every edge that was absent is fill
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+      FastSet<Key>& adjI = adjacency.at(neighbors[i]);
+      for (size_t j = i + 1; j < neighbors.size(); ++j) {
+        if (adjI.insert(neighbors[j]).second) {
+          adjacency.at(neighbors[j]).insert(neighbors[i]);
+          step.fillEdges.push_back(
+              make_pair(min(neighbors[i], neighbors[j]),
+                  max(neighbors[i], neighbors[j])));
+        }
+      }
+    }
+
+    eliminated.insert(key);
+    trace.steps_.push_back(step);
+  }
+
+  return trace;
+}
+
+/* ************************************************************************* */
+size_t EliminationTrace::totalFill() const {
+  size_t fill = 0;
+  for (const Step& step : steps_)
+    fill += step.fillEdges.size();
+  return fill;
+}
+
+/* ************************************************************************* */
+size_t EliminationTrace::maxDegree() const {
+  size_t degree = 0;
+  for (const Step& step : steps_)
+    degree = max(degree, step.degree);
+  return degree;
+}
+
+/* ************************************************************************* */
+FastMap<Key, FastSet<Key> > EliminationTrace::replayFill(size_t nrSteps) const {
+  FastMap<Key, FastSet<Key> > adjacency = originalEdges_;
+  const size_t last = min(nrSteps, steps_.size());
+  for (size_t i = 0; i < last; ++i) {
+    for (const pair<Key, Key>& edge : steps_[i].fillEdges) {
+      adjacency.at(edge.first).insert(edge.second);
+      adjacency.at(edge.second).insert(edge.first);
+    }
+  }
+  return adjacency;
+}
+
+/* ************************************************************************* */
+void EliminationTrace::print(const std::string& str,
+    const KeyFormatter& keyFormatter) const {
+  cout << str << steps_.size() << " steps, " << nrOriginalEdges_
+      << " original edges, " << totalFill() << " fill edges, max degree "
+      << maxDegree() << "\n";
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    const Step& step = steps_[i];
+    cout << "  step " << i << ": " << keyFormatter(step.key) << " degree "
+        << step.degree;
+    if (!step.fillEdges.empty()) {
+      cout << ", fill";
+      for (const pair<Key, Key>& edge : step.fillEdges)
+        cout << " (" << keyFormatter(edge.first) << ","
+            << keyFormatter(edge.second) << ")";
+    }
+    cout << "\n";
+  }
+  cout.flush();
+}
+
+/* ************************************************************************* */
+bool EliminationTrace::equals(const EliminationTrace& other, double tol) const {
+  if (steps_.size() != other.steps_.size()
+      || nrOriginalEdges_ != other.nrOriginalEdges_)
+    return false;
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    if (steps_[i].key != other.steps_[i].key
+        || steps_[i].degree != other.steps_[i].degree
+        || steps_[i].fillEdges != other.steps_[i].fillEdges)
+      return false;
+  }
+  return true;
+}
+
+}
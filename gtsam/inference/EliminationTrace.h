@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationTrace.h
+ * @brief   Replayable record of a simulated vertex elimination, for ordering
+ *          diagnostics
+ * @author  Richard Roberts
+ * @date    Sep 2, 2010
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastSet.h>
+#include <gtsam/base/FastVector.h>
+
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * A compact, replayable trace of the vertex elimination an Ordering induces
+ * on the variable connectivity graph of a factor graph.  Orderings such as
+ * Ordering::Colamd only return the final permutation; when a frame produces
+ * pathological fill-in this leaves no way to see *where* the elimination
+ * went wrong.  Simulate() plays the elimination game symbolically - each
+ * step removes the next variable and pairwise connects its remaining
+ * neighbors - and records, per step, the degree of the eliminated variable
+ * and exactly which fill edges the step added.  The trace is enough to
+ * replay the filled graph at any step, and summary statistics (total fill,
+ * largest front) localize the expensive steps so a bad ordering becomes an
+ * actionable fix rather than a mystery.  See timing/timeOrderingFill.cpp
+ * for a tool that renders fill-in heatmaps from the trace.
+ */
+class GTSAM_EXPORT EliminationTrace {
+public:
+
+  /// One elimination step: the variable removed, its degree at removal time
+  /// (the front is degree + 1 variables), and the fill edges added when its
+  /// remaining neighbors were pairwise connected.
+  struct Step {
+    Key key; ///< The variable eliminated at this step
+    size_t degree; ///< Number of uneliminated neighbors at elimination time
+    FastVector<std::pair<Key, Key> > fillEdges; ///< New edges this step added
+  };
+
+  /// Construct an empty trace
+  EliminationTrace() : nrOriginalEdges_(0) {}
+
+  /// Simulate eliminating the variables of \c variableIndex in \c ordering
+  /// order and record every step.  Cost is proportional to the size of the
+  /// filled graph, the same work symbolic elimination itself performs.
+  static EliminationTrace Simulate(const VariableIndex& variableIndex,
+      const Ordering& ordering);
+
+  /// Simulate elimination of a factor graph, building a VariableIndex
+  /// internally.  If you already have a VariableIndex it is faster to use
+  /// Simulate(const VariableIndex&, const Ordering&).
+  template<class FACTOR_GRAPH>
+  static EliminationTrace Simulate(const FACTOR_GRAPH& graph,
+      const Ordering& ordering) {
+    return Simulate(VariableIndex(graph), ordering);
+  }
+
+  /// @name Standard Interface
+  /// @{
+
+  /// The recorded steps, one per variable in elimination order
+  const FastVector<Step>& steps() const { return steps_; }
+
+  /// Number of elimination steps in the trace
+  size_t size() const { return steps_.size(); }
+
+  /// Number of edges in the original (unfilled) variable graph
+  size_t nrOriginalEdges() const { return nrOriginalEdges_; }
+
+  /// Total number of fill edges added over all steps
+  size_t totalFill() const;
+
+  /// Largest degree over all steps, i.e. the largest front is
+  /// maxDegree() + 1 variables
+  size_t maxDegree() const;
+
+  /// Replay the trace through step \c nrSteps (all steps by default),
+  /// returning the adjacency of the filled variable graph: every original
+  /// edge plus every fill edge recorded up to that step.
+  FastMap<Key, FastSet<Key> > replayFill(
+      size_t nrSteps = std::numeric_limits<size_t>::max()) const;
+
+  /// @}
+
+  /// @name Testable
+  /// @{
+
+  /// Print the per-step trace and summary statistics
+  void print(const std::string& str = "EliminationTrace: ",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// Check equality
+  bool equals(const EliminationTrace& other, double tol = 1e-9) const;
+
+  /// @}
+
+private:
+
+  FastVector<Step> steps_; ///< Steps in elimination order
+  size_t nrOriginalEdges_; ///< Edge count of the unfilled variable graph
+  FastMap<Key, FastSet<Key> > originalEdges_; ///< Unfilled adjacency, for replay
+};
+
+/// traits
+template<> struct traits<EliminationTrace> : public Testable<EliminationTrace> {
+};
+
+}
@@ -110,14 +110,23 @@ namespace gtsam {
           // variable in this factor a child of the current node.  This means that the variables
           // eliminated earlier in the factor depend on the later variables in the factor.  If we
           // haven't yet hit a variable in this factor, we add the factor to the current node.
-          // TODO: Store root shortcuts instead of parents.
           if (prevCol[i] != none) {
             size_t k = prevCol[i];
-            // Find root r of the current tree that contains k. Use raw pointers in computing the
+            // Find root r of the current tree that contains k. Use plain indices in computing the
             // parents to avoid changing the reference counts while traversing up the tree.
             size_t r = k;
             while (parents[r] != none)
               r = parents[r];
+            // Compress the path from k to the root so later root searches through these entries
+            // are O(1) instead of walking the whole chain again.  This is safe because the final
+            // root-gathering pass below only tests parents[j] == none, which compression never
+            // changes, and the actual child lists are built from the nodes themselves.
+            size_t p = k;
+            while (parents[p] != none) {
+              const size_t next = parents[p];
+              parents[p] = r;
+              p = next;
+            }
             // If the root of the subtree involving this node is actually the current node,
             // TODO: what does this mean?  forest?
             if (r != j) {
@@ -27,6 +27,9 @@
 #include <gtsam/base/FastVector.h>
 #include <gtsam/inference/Key.h>
 
+#include <algorithm>
+#include <atomic>
+
 namespace gtsam {
 /// Define collection types:
 typedef FastVector<FactorIndex> FactorIndices;
@@ -71,21 +74,43 @@ typedef FastSet<FactorIndex> FactorIndexSet;
     /// The keys involved in this factor
     KeyVector keys_;
 
+    /// Cached sortedness of keys_: 1 sorted, 0 unsorted, -1 not yet computed.
+    /// Mutable because it is a lazily computed property of keys_, and reset
+    /// whenever mutable access to the keys is handed out.  Atomic because the
+    /// cache may be filled in from const reads of shared factors on several
+    /// threads at once; relaxed ordering suffices since all racing writers
+    /// store the same value, derived from the keys they are all reading.
+    mutable std::atomic<signed char> sortedKeys_;
+
     /// @name Standard Constructors
     /// @{
 
     /** Default constructor for I/O */
-    Factor() {}
+    Factor() : sortedKeys_(-1) {}
 
     /** Construct factor from container of keys.  This constructor is used internally from derived factor
     *  constructors, either from a container of keys or from a boost::assign::list_of. */
     template<typename CONTAINER>
-    explicit Factor(const CONTAINER& keys) : keys_(keys.begin(), keys.end()) {}
+    explicit Factor(const CONTAINER& keys) : keys_(keys.begin(), keys.end()), sortedKeys_(-1) {}
 
     /** Construct factor from iterator keys.  This constructor may be used internally from derived
     *  factor constructors, although our code currently does not use this. */
     template<typename ITERATOR>
-    Factor(ITERATOR first, ITERATOR last) : keys_(first, last) {}
+    Factor(ITERATOR first, ITERATOR last) : keys_(first, last), sortedKeys_(-1) {}
+
+    /** Copy operations are spelled out because the atomic cache member is not
+    *  copyable; the cached value itself transfers, as it describes keys_. */
+    Factor(const This& other)
+        : keys_(other.keys_),
+          sortedKeys_(other.sortedKeys_.load(std::memory_order_relaxed)) {}
+
+    /** Copy assignment, see the copy constructor */
+    Factor& operator=(const This& other) {
+      keys_ = other.keys_;
+      sortedKeys_.store(other.sortedKeys_.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      return *this;
+    }
 
     /** Construct factor from container of keys.  This is called internally from derived factor static
     *  factor methods, as a workaround for not being able to call the protected constructors above. */
@@ -111,8 +136,27 @@ typedef FastSet<FactorIndex> FactorIndexSet;
     /// Last key
     Key back() const { return keys_.back(); }
 
-    /// find
-    const_iterator find(Key key) const { return std::find(begin(), end(), key); }
+    /// find, using binary search when the keys are known to be sorted
+    const_iterator find(Key key) const {
+      if (sortedKeys()) {
+        const_iterator it = std::lower_bound(begin(), end(), key);
+        return (it != end() && *it == key) ? it : end();
+      }
+      return std::find(begin(), end(), key);
+    }
+
+    /** Whether the keys of this factor are in ascending order.  Computed
+    *  lazily and cached; the cache is invalidated whenever mutable access to
+    *  the keys is handed out.  Algorithms such as the VariableSlots
+    *  intersection pass use this to take ordered fast paths. */
+    bool sortedKeys() const {
+      signed char sorted = sortedKeys_.load(std::memory_order_relaxed);
+      if (sorted < 0) {
+        sorted = std::is_sorted(keys_.begin(), keys_.end()) ? 1 : 0;
+        sortedKeys_.store(sorted, std::memory_order_relaxed);
+      }
+      return sorted == 1;
+    }
 
     /// Access the factor's involved variable keys
     const KeyVector& keys() const { return keys_; }
@@ -151,13 +195,19 @@ typedef FastSet<FactorIndex> FactorIndexSet;
     /// @{
 
     /** @return keys involved in this factor */
-    KeyVector& keys() { return keys_; }
+    KeyVector& keys() { invalidateSortedKeys(); return keys_; }
 
     /** Iterator at beginning of involved variable keys */
-    iterator begin() { return keys_.begin(); }
+    iterator begin() { invalidateSortedKeys(); return keys_.begin(); }
 
     /** Iterator at end of involved variable keys */
-    iterator end() { return keys_.end(); }
+    iterator end() { invalidateSortedKeys(); return keys_.end(); }
+
+  protected:
+    /// Drop the cached sortedness, for use after direct edits of keys_
+    void invalidateSortedKeys() {
+      sortedKeys_.store(-1, std::memory_order_relaxed);
+    }
 
   private:
     /** Serialization function */
@@ -165,6 +215,7 @@ typedef FastSet<FactorIndex> FactorIndexSet;
     template<class Archive>
     void serialize(Archive & ar, const unsigned int /*version*/) {
       ar & BOOST_SERIALIZATION_NVP(keys_);
+      invalidateSortedKeys();
     }
 
     /// @}
@@ -163,12 +163,24 @@ class FactorGraph {
     factors_.push_back(boost::shared_ptr<FACTOR>(factor));
   }
 
-  /// Emplace a shared pointer to factor of given type.
+  /**
+   * Emplace a shared pointer to factor of given type and return it, e.g. to
+   * keep a typed handle on the newly added factor.  The factor and its
+   * shared_ptr control block are created in a single allocation, so combined
+   * with reserve() this builds a graph with one allocation per factor and no
+   * intermediate copies.
+   */
   template <class DERIVEDFACTOR, class... Args>
-  IsDerived<DERIVEDFACTOR> emplace_shared(Args&&... args) {
-    factors_.push_back(boost::allocate_shared<DERIVEDFACTOR>(
-        Eigen::aligned_allocator<DERIVEDFACTOR>(),
-        std::forward<Args>(args)...));
+  typename std::enable_if<
+      std::is_base_of<FactorType, DERIVEDFACTOR>::value,
+      boost::shared_ptr<DERIVEDFACTOR>>::type
+  emplace_shared(Args&&... args) {
+    boost::shared_ptr<DERIVEDFACTOR> factor =
+        boost::allocate_shared<DERIVEDFACTOR>(
+            Eigen::aligned_allocator<DERIVEDFACTOR>(),
+            std::forward<Args>(args)...);
+    factors_.push_back(factor);
+    return factor;
   }
 
   /**
@@ -234,6 +246,7 @@ class FactorGraph {
   /// Push back non-pointer objects in a container (factors are copied).
   template <typename CONTAINER>
   HasDerivedValueType<CONTAINER> push_back(const CONTAINER& container) {
+    factors_.reserve(factors_.size() + container.size());
     push_back(container.begin(), container.end());
   }
 
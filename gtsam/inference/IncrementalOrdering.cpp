@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IncrementalOrdering.cpp
+ * @author  Richard Roberts
+ * @date    Aug 2019
+ */
+
+#include <gtsam/inference/IncrementalOrdering.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/3rdparty/CCOLAMD/Include/ccolamd.h>
+
+#include <boost/format.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+const Ordering& IncrementalOrdering::ordering(const VariableIndex& variableIndex) {
+  gttic(IncrementalOrdering_ordering);
+
+  const size_t nVars = variableIndex.size();
+
+  // Without a cached ordering, or with too large a changed region, splicing
+  // does not pay off - run a full COLAMD.
+  if (!valid_ || dirty_.size() > recomputeFraction_ * nVars) {
+    gttic(full_colamd);
+    ordering_ = Ordering::Colamd(variableIndex);
+    dirty_.clear();
+    valid_ = true;
+    return ordering_;
+  }
+
+  if (dirty_.empty())
+    return ordering_;
+
+  gttic(partial_colamd);
+
+  // Factors adjacent to any changed variable couple it to its neighbours,
+  // so those neighbours must be reordered along with it.
+  FastSet<size_t> dirtyFactors;
+  for (Key key : dirty_) {
+    VariableIndex::const_iterator item = variableIndex.find(key);
+    if (item != variableIndex.end())
+      dirtyFactors.insert(item->second.begin(), item->second.end());
+  }
+
+  // Partition the variables: those touching a dirty factor are reordered,
+  // the rest keep their cached relative order.
+  FastSet<Key> affectedSet;
+  KeyVector affectedKeys;
+  for (const VariableIndex::value_type& keyFactors : variableIndex) {
+    bool affected = false;
+    for (size_t factorIndex : keyFactors.second) {
+      if (dirtyFactors.count(factorIndex)) {
+        affected = true;
+        break;
+      }
+    }
+    if (affected) {
+      affectedSet.insert(keyFactors.first);
+      affectedKeys.push_back(keyFactors.first);
+    }
+  }
+
+  if (affectedKeys.size() > recomputeFraction_ * nVars) {
+    gttic(full_colamd);
+    ordering_ = Ordering::Colamd(variableIndex);
+    dirty_.clear();
+    return ordering_;
+  }
+
+  // Clean prefix: cached order filtered down to the surviving, unaffected
+  // variables.  The reordered region follows, so it is eliminated last.
+  Ordering result;
+  result.reserve(nVars);
+  for (Key key : ordering_) {
+    if (affectedSet.count(key))
+      continue;
+    if (variableIndex.find(key) == variableIndex.end())
+      continue; // variable no longer exists
+    result.push_back(key);
+  }
+
+  const Ordering affectedOrdering = colamdSubProblem(affectedKeys, variableIndex);
+  result.insert(result.end(), affectedOrdering.begin(), affectedOrdering.end());
+
+  if (result.size() != nVars)
+    throw runtime_error(
+        "IncrementalOrdering: changed variables were not announced with markChanged");
+
+  ordering_ = result;
+  dirty_.clear();
+  return ordering_;
+}
+
+/* ************************************************************************* */
+Ordering IncrementalOrdering::colamdSubProblem(const KeyVector& keys,
+    const VariableIndex& variableIndex) {
+  const size_t nVars = keys.size();
+  if (nVars == 0)
+    return Ordering();
+  if (nVars == 1)
+    return Ordering(KeyVector(1, keys[0]));
+
+  // Renumber the factors touching the sub-problem into dense row indices.
+  // Factors shared with clean variables still appear as rows here, which is
+  // what couples the affected variables that interact through them.
+  FastMap<size_t, int> factorRows;
+  size_t nEntries = 0;
+  for (Key key : keys) {
+    const FactorIndices& column = variableIndex[key];
+    nEntries += column.size();
+    for (size_t factorIndex : column)
+      factorRows.insert(make_pair(factorIndex, (int) factorRows.size()));
+  }
+  const size_t nFactors = factorRows.size();
+
+  // Convert to the compressed column major format colamd wants, as in
+  // Ordering::ColamdConstrained but over the sub-problem only
+  const size_t Alen = ccolamd_recommended((int) nEntries, (int) nFactors,
+      (int) nVars);
+  vector<int> A(Alen);
+  vector<int> p(nVars + 1);
+  p[0] = 0;
+  int count = 0;
+  for (size_t index = 0; index < nVars; ++index) {
+    const FactorIndices& column = variableIndex[keys[index]];
+    for (size_t factorIndex : column)
+      A[count++] = factorRows.at(factorIndex);
+    p[index + 1] = count;
+  }
+
+  double knobs[CCOLAMD_KNOBS];
+  ccolamd_set_defaults(knobs);
+  knobs[CCOLAMD_DENSE_ROW] = -1;
+  knobs[CCOLAMD_DENSE_COL] = -1;
+
+  int stats[CCOLAMD_STATS];
+  vector<int> cmember(nVars, 0);
+
+  int rv = ccolamd((int) nFactors, (int) nVars, (int) Alen, &A[0], &p[0],
+      knobs, stats, &cmember[0]);
+  if (rv != 1)
+    throw runtime_error(
+        (boost::format("ccolamd failed with return value %1%") % rv).str());
+
+  // Convert the permutation in p back to keys
+  Ordering result;
+  result.resize(nVars);
+  for (size_t j = 0; j < nVars; ++j)
+    result[j] = keys[p[j]];
+  return result;
+}
+
+} // \namespace gtsam
@@ -0,0 +1,94 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IncrementalOrdering.h
+ * @brief   Elimination ordering maintained incrementally across updates
+ * @author  Richard Roberts
+ * @date    Aug 2019
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/base/FastSet.h>
+
+namespace gtsam {
+
+/**
+ * An IncrementalOrdering maintains a COLAMD elimination ordering across a
+ * sequence of problem updates, instead of recomputing it from scratch each
+ * time.  Callers mark the variables whose factor adjacency changed
+ * (markChanged) after adding or removing factors, and ordering() then reruns
+ * CCOLAMD only over the changed variables and the variables they share a
+ * factor with; all other variables keep their cached relative order and are
+ * placed first, so the reordered region ends up eliminated last, next to the
+ * root.  When the changed region grows beyond recomputeFraction of the
+ * problem the full ordering is recomputed, since at that point a full COLAMD
+ * is both cheaper and of better quality than splicing.
+ *
+ * The spliced ordering is a valid elimination ordering for the whole problem;
+ * the trade-off is ordering quality (fill-in) in exchange for not paying the
+ * full COLAMD cost on every small update.
+ */
+class GTSAM_EXPORT IncrementalOrdering {
+public:
+
+  /// Construct an empty incremental ordering.  recomputeFraction sets the
+  /// changed-variable fraction above which a full COLAMD is run instead of
+  /// the partial update.
+  explicit IncrementalOrdering(double recomputeFraction = 0.3) :
+      valid_(false), recomputeFraction_(recomputeFraction) {
+  }
+
+  /// Mark a single variable whose factor adjacency changed
+  void markChanged(Key key) {
+    dirty_.insert(key);
+  }
+
+  /// Mark a set of variables whose factor adjacency changed, e.g. the keys
+  /// of newly added or removed factors
+  template<typename KEYS>
+  void markChanged(const KEYS& keys) {
+    dirty_.insert(keys.begin(), keys.end());
+  }
+
+  /// Number of variables currently marked as changed
+  size_t nrChanged() const {
+    return dirty_.size();
+  }
+
+  /// Return the ordering for the problem described by variableIndex,
+  /// recomputing only the changed region when possible.  The index must
+  /// reflect all updates announced through markChanged.
+  const Ordering& ordering(const VariableIndex& variableIndex);
+
+  /// Discard the cached ordering, forcing a full recompute on the next call
+  void clear() {
+    ordering_ = Ordering();
+    dirty_.clear();
+    valid_ = false;
+  }
+
+private:
+
+  Ordering ordering_;         ///< Cached ordering over all variables
+  FastSet<Key> dirty_;        ///< Variables whose adjacency changed since the last compute
+  bool valid_;                ///< Whether ordering_ describes a previous problem state
+  double recomputeFraction_;  ///< Changed fraction that triggers a full recompute
+
+  /// Run CCOLAMD over the sub-problem of the given variables only
+  static Ordering colamdSubProblem(const KeyVector& keys,
+      const VariableIndex& variableIndex);
+};
+
+} // \namespace gtsam
@@ -33,6 +33,7 @@ struct ConstructorTraversalData {
   typedef typename JunctionTree<BAYESTREE, GRAPH>::sharedNode sharedNode;
 
   ConstructorTraversalData* const parentData;
+  const AmalgamationPolicy* policy; // shared by the whole traversal, owned by the caller
   sharedNode myJTNode;
   FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
   FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
@@ -42,7 +43,7 @@ struct ConstructorTraversalData {
   };
 
   ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+      parentData(_parentData), policy(_parentData ? _parentData->policy : 0) {
   }
 
   // Pre-order visitor function
@@ -103,15 +104,35 @@ struct ConstructorTraversalData {
     assert(childConditionals.size() == nrChildren);
 
     // decide which children to merge, as index into children
+    const AmalgamationPolicy& policy = *myData.policy;
     std::vector<size_t> nrFrontals = node->nrFrontalsOfChildren();
     std::vector<bool> merge(nrChildren, false);
-    size_t myNrFrontals = 1;
+    size_t myNrFrontals = 1, nrMerged = 0;
+    size_t mergedProblemSize = (size_t) node->problemSize();
     for (size_t i = 0;i<nrChildren;i++){
-      // Check if we should merge the i^th child
-      if (myNrParents + myNrFrontals == childConditionals[i]->nrParents()) {
+      // Check if we should merge the i^th child: the structural rule merges a
+      // child whose separator exactly matches our frontals plus separator
+      bool doMerge =
+          (myNrParents + myNrFrontals == childConditionals[i]->nrParents());
+      // A child with a strictly smaller separator may still be absorbed when
+      // the policy asks for coarser cliques - its frontals then pick up our
+      // separator as extra fill-in, in exchange for a wider frontal block
+      if (!doMerge && policy.targetProblemSize > 0
+          && mergedProblemSize < policy.targetProblemSize)
+        doMerge = true;
+      // The caps veto any merge, structural or not
+      if (doMerge && policy.maxFrontalSize > 0
+          && myNrFrontals + nrFrontals[i] > policy.maxFrontalSize)
+        doMerge = false;
+      if (doMerge && policy.maxMergedChildren > 0
+          && nrMerged >= policy.maxMergedChildren)
+        doMerge = false;
+      if (doMerge) {
         // Increment number of frontal variables
         myNrFrontals += nrFrontals[i];
+        mergedProblemSize += (size_t) node->children[i]->problemSize();
         merge[i] = true;
+        ++nrMerged;
       }
     }
 
@@ -124,7 +145,16 @@ struct ConstructorTraversalData {
 template<class BAYESTREE, class GRAPH>
 template<class ETREE_BAYESNET, class ETREE_GRAPH>
 JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
-    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) {
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) :
+    JunctionTree(eliminationTree, AmalgamationPolicy()) {
+}
+
+/* ************************************************************************* */
+template<class BAYESTREE, class GRAPH>
+template<class ETREE_BAYESNET, class ETREE_GRAPH>
+JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    const AmalgamationPolicy& policy) {
   gttic(JunctionTree_FromEliminationTree);
   // Here we rely on the BayesNet having been produced by this elimination tree,
   // such that the conditionals are arranged in DFS post-order.  We traverse the
@@ -138,6 +168,7 @@ JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
   Data rootData(0);
+  rootData.policy = &policy;
   rootData.myJTNode = boost::make_shared<typename Base::Node>(); // Make a dummy node to gather
                                                                  // the junction tree roots
   treeTraversal::DepthFirstForest(eliminationTree, rootData,
@@ -27,6 +27,40 @@ namespace gtsam {
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
 
+  /**
+   * Policy controlling how elimination-tree nodes are amalgamated into
+   * junction-tree cliques.  Clique granularity is the main lever trading
+   * tree parallelism against dense-block arithmetic efficiency, and the
+   * best setting is workload dependent: sparse 2D problems favor small
+   * cliques with many independent subtrees, while 3D bundle adjustment
+   * favors fewer, wider frontal blocks.  See timing/timeAmalgamationPolicy.cpp.
+   *
+   * The default-constructed policy reproduces the classic structural rule:
+   * a child is merged exactly when its separator matches the parent's
+   * frontals plus separator, so eliminating the parent introduces no fill
+   * beyond what the child already had.  The knobs adjust that rule in both
+   * directions: targetProblemSize greedily absorbs additional children -
+   * accepting bounded extra fill-in - until the clique's estimated
+   * elimination cost reaches the target, while maxFrontalSize and
+   * maxMergedChildren veto merges that would grow a clique past the caps.
+   * A value of 0 leaves the corresponding knob inactive.
+   */
+  struct GTSAM_EXPORT AmalgamationPolicy {
+    size_t maxFrontalSize;     ///< veto merges past this many frontal variables (0 = unlimited)
+    size_t maxMergedChildren;  ///< veto merging more than this many children per clique (0 = unlimited)
+    size_t targetProblemSize;  ///< absorb extra children while the clique's problem size is below this (0 = structural rule only)
+
+    AmalgamationPolicy() :
+        maxFrontalSize(0), maxMergedChildren(0), targetProblemSize(0) {
+    }
+
+    AmalgamationPolicy(size_t maxFrontalSize, size_t maxMergedChildren,
+        size_t targetProblemSize) :
+        maxFrontalSize(maxFrontalSize), maxMergedChildren(maxMergedChildren),
+        targetProblemSize(targetProblemSize) {
+    }
+  };
+
   /**
    * A JunctionTree is a cluster tree, a set of variable clusters with factors, arranged in a tree,
    * with the additional property that it represents the clique tree associated with a Bayes Net.
@@ -68,6 +102,12 @@ namespace gtsam {
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
     JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
 
+    /** Build the junction tree from an elimination tree, amalgamating cliques
+     *  according to the given policy instead of the structural rule alone. */
+    template<class ETREE_BAYESNET, class ETREE_GRAPH>
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+        const AmalgamationPolicy& policy);
+
     /// @}
 
   private:
@@ -84,6 +84,28 @@ void PrintKeySet(const KeySet& keys, const string& s,
   Print(keys, s, keyFormatter);
 }
 
+/* ************************************************************************* */
+const string& KeyFormatterCache::operator()(Key key) const {
+  FastMap<Key, string>::const_iterator it = cache_.find(key);
+  if (it == cache_.end())
+    it = cache_.emplace(key, formatter_(key)).first;
+  return it->second;
+}
+
+/* ************************************************************************* */
+void KeyFormatterCache::append(Key key, string* output) const {
+  *output += (*this)(key);
+}
+
+/* ************************************************************************* */
+void AppendKeyVector(const KeyVector& keys, string* output,
+    const KeyFormatterCache& cache) {
+  for (const Key& key : keys) {
+    cache.append(key, output);
+    *output += ' ';
+  }
+}
+
 /* ************************************************************************* */
 // Access to custom stream property.
 void *&key_formatter::property(ios_base &s) {
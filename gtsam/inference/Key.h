@@ -106,6 +106,49 @@ GTSAM_EXPORT void PrintKeyVector(const KeyVector& keys, const std::string& s =
 GTSAM_EXPORT void PrintKeySet(const KeySet& keys, const std::string& s = "",
     const KeyFormatter& keyFormatter = DefaultKeyFormatter);
 
+/**
+ * Interning cache around a KeyFormatter.  Print paths over large graphs
+ * format the same keys over and over - every factor repeats the keys of its
+ * neighbors - and building a fresh std::string per call dominates full-graph
+ * debug dumps.  The cache formats each distinct key once and hands out
+ * references to the interned string afterwards; append() writes into a
+ * caller-owned growing buffer so streaming dumps of millions of keys do not
+ * allocate per key at all.
+ *
+ * The cache is not cleared automatically: reuse one instance per dump (or
+ * longer, formatters are stable), and clear() it if keys are reused with a
+ * different formatter.
+ */
+class GTSAM_EXPORT KeyFormatterCache {
+ public:
+  explicit KeyFormatterCache(KeyFormatter formatter = DefaultKeyFormatter) :
+      formatter_(formatter) {}
+
+  /// Format a key, interning the result on first use
+  const std::string& operator()(Key key) const;
+
+  /// Append the formatted key to a growing output buffer
+  void append(Key key, std::string* output) const;
+
+  /// Number of distinct keys formatted so far
+  size_t size() const { return cache_.size(); }
+
+  /// Drop all interned strings
+  void clear() { cache_.clear(); }
+
+ private:
+  KeyFormatter formatter_;
+  mutable FastMap<Key, std::string> cache_;
+};
+
+/**
+ * Append the formatted keys, separated by spaces, to a growing output
+ * buffer.  This is the streaming counterpart of PrintKeyVector for dumps
+ * that assemble one large string instead of writing to cout key by key.
+ */
+GTSAM_EXPORT void AppendKeyVector(const KeyVector& keys, std::string* output,
+    const KeyFormatterCache& cache);
+
 // Define Key to be Testable by specializing gtsam::traits
 template<typename T> struct traits;
 
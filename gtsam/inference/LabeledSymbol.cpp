@@ -15,6 +15,7 @@
  * @author: Alex Cunningham
  */
 
+#include <cstdio>
 #include <iostream>
 
 #include <boost/format.hpp>
@@ -76,7 +77,11 @@ void LabeledSymbol::print(const std::string& s) const {
 
 /* ************************************************************************* */
 LabeledSymbol::operator std::string() const {
-  return str(boost::format("%c%c%d") % c_ % label_ % j_);
+  // Same stack-buffer formatting as Symbol, see Symbol.cpp
+  char buffer[32];
+  const int length = snprintf(buffer, sizeof(buffer), "%c%c%llu", c_, label_,
+      (unsigned long long) j_);
+  return std::string(buffer, length);
 }
 
 /* ************************************************************************* */
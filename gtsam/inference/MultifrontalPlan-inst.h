@@ -0,0 +1,207 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultifrontalPlan-inst.h
+ * @brief   Reusable symbolic elimination plan for repeated multifrontal elimination
+ * @author  Richard Roberts
+ * @date    Apr 21, 2013
+ */
+
+#pragma once
+
+#include <gtsam/inference/MultifrontalPlan.h>
+#include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/timing.h>
+
+#include <utility>
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  MultifrontalPlan<FACTORGRAPH>::MultifrontalPlan(const FactorGraphType& graph,
+    const Ordering& ordering, const VariableIndex& variableIndex) :
+  graphSize_(graph.size())
+  {
+    gttic(MultifrontalPlan_constructor);
+
+    // Perform the symbolic analysis once - this is exactly the symbolic work that
+    // eliminateMultifrontal repeats on every call.
+    EliminationTreeType etree(graph, variableIndex, ordering);
+    JunctionTreeType junctionTree(etree);
+
+    // If any factors were not included in the junction tree, the ordering was incomplete
+    if(!junctionTree.remainingFactors().empty())
+      throw InconsistentEliminationRequested();
+
+    // Map each factor back to its slot in the graph, so that numeric passes can re-gather the
+    // corresponding factors from a relinearized graph.
+    typedef typename JunctionTreeType::sharedNode sharedCluster;
+    FastMap<const FactorType*, size_t> factorSlots;
+    for(size_t i = 0; i < graph.size(); ++i)
+      if(graph[i])
+        factorSlots.insert(std::make_pair(graph[i].get(), i));
+
+    // Flatten the junction tree into post-order, recording for each cluster its frontal keys,
+    // factor slots, and children.  An explicit stack is used to avoid deep recursion on chains.
+    FastMap<const typename JunctionTreeType::Node*, size_t> clusterIndex;
+    FastVector<std::pair<sharedCluster, bool> > stack;
+    for(const sharedCluster& root: junctionTree.roots())
+      stack.push_back(std::make_pair(root, false));
+    while(!stack.empty()) {
+      sharedCluster cluster = stack.back().first;
+      const bool childrenDone = stack.back().second;
+      stack.pop_back();
+      if(!childrenDone) {
+        stack.push_back(std::make_pair(cluster, true));
+        for(const sharedCluster& child: cluster->children)
+          stack.push_back(std::make_pair(child, false));
+      } else {
+        PlanCluster planCluster;
+        planCluster.frontalKeys = cluster->orderedFrontalKeys;
+        planCluster.problemSize = cluster->problemSize();
+        planCluster.factorSlots.reserve(cluster->factors.size());
+        for(const sharedFactor& factor: cluster->factors)
+          planCluster.factorSlots.push_back(factorSlots.at(factor.get()));
+        planCluster.children.reserve(cluster->nrChildren());
+        for(const sharedCluster& child: cluster->children)
+          planCluster.children.push_back(clusterIndex.at(child.get()));
+        clusterIndex.insert(std::make_pair(cluster.get(), clusters_.size()));
+        clusters_.push_back(planCluster);
+      }
+    }
+    roots_.reserve(junctionTree.nrRoots());
+    for(const sharedCluster& root: junctionTree.roots())
+      roots_.push_back(clusterIndex.at(root.get()));
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  boost::shared_ptr<typename MultifrontalPlan<FACTORGRAPH>::BayesTreeType>
+    MultifrontalPlan<FACTORGRAPH>::eliminate(
+    const FactorGraphType& graph, const Eliminate& function) const
+  {
+    return eliminate(graph, function, nullptr);
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  boost::shared_ptr<typename MultifrontalPlan<FACTORGRAPH>::BayesTreeType>
+    MultifrontalPlan<FACTORGRAPH>::eliminate(
+    const FactorGraphType& graph, const Eliminate& function,
+    Checkpoint* checkpoint) const
+  {
+    gttic(MultifrontalPlan_eliminate);
+    typedef typename BayesTreeType::Node BTNode;
+
+    if(graph.size() != graphSize_ && !(checkpoint && graph.size() > graphSize_))
+      throw std::invalid_argument(
+        "MultifrontalPlan::eliminate called with a graph of different size than the graph\n"
+        "the plan was built from - the sparsity patterns must be identical.");
+    if(checkpoint) {
+      if(!checkpoint->results_.empty() && checkpoint->results_.size() != clusters_.size())
+        throw std::invalid_argument(
+          "MultifrontalPlan::eliminate called with a checkpoint written by a different plan.");
+      checkpoint->results_.resize(clusters_.size());
+    }
+
+    // Route repair factors - slots appended beyond the planned graph - to the clique where
+    // their first key is frontal.  Those cliques are forced to re-eliminate below.
+    FastVector<FactorIndices> repairSlots;
+    if(graph.size() > graphSize_) {
+      repairSlots.resize(clusters_.size());
+      FastMap<Key, size_t> frontalCluster;
+      for(size_t i = 0; i < clusters_.size(); ++i)
+        for(Key key: clusters_[i].frontalKeys)
+          frontalCluster.insert(std::make_pair(key, i));
+      for(size_t slot = graphSize_; slot < graph.size(); ++slot) {
+        if(!graph[slot])
+          continue;
+        typename FastMap<Key, size_t>::const_iterator item =
+          frontalCluster.find(graph[slot]->front());
+        if(item == frontalCluster.end())
+          throw std::invalid_argument(
+            "MultifrontalPlan::eliminate: a repair factor involves a key unknown to the plan.");
+        repairSlots[item->second].push_back(slot);
+      }
+    }
+
+    // Eliminate cliques in post-order - children always precede their parent in clusters_, so by
+    // the time a clique is processed all of its child remnant factors are available.
+    FastVector<boost::shared_ptr<BTNode> > cliques(clusters_.size());
+    FastVector<sharedFactor> remnants(clusters_.size());
+    FastVector<bool> recomputed(clusters_.size(), false);
+    for(size_t i = 0; i < clusters_.size(); ++i) {
+      const PlanCluster& cluster = clusters_[i];
+
+      // A checkpointed result can be reused unless this clique gathers a repair factor or any
+      // child was re-eliminated (which changes the remnant this clique would gather).
+      bool reuse = checkpoint && checkpoint->results_[i];
+      if(reuse && !repairSlots.empty() && !repairSlots[i].empty())
+        reuse = false;
+      if(reuse)
+        for(size_t child: cluster.children)
+          if(recomputed[child]) { reuse = false; break; }
+
+      EliminationResult eliminationResult;
+      if(reuse) {
+        eliminationResult = *checkpoint->results_[i];
+      } else {
+        // Gather this clique's original factors from the new graph, plus repair factors and
+        // child remnants
+        FactorGraphType gatheredFactors;
+        gatheredFactors.reserve(cluster.factorSlots.size() + cluster.children.size());
+        for(size_t slot: cluster.factorSlots)
+          gatheredFactors.push_back(graph[slot]);
+        if(!repairSlots.empty())
+          for(size_t slot: repairSlots[i])
+            gatheredFactors.push_back(graph[slot]);
+        for(size_t child: cluster.children)
+          if(remnants[child])
+            gatheredFactors.push_back(remnants[child]);
+
+        // Do dense elimination step.  If the elimination function throws, the checkpoint keeps
+        // the results recorded so far - every completed subtree survives the failure.
+        eliminationResult = function(gatheredFactors, cluster.frontalKeys);
+        if(checkpoint)
+          checkpoint->results_[i] = eliminationResult;
+        recomputed[i] = true;
+      }
+
+      // Set up the BayesTree clique with parent and child pointers
+      boost::shared_ptr<BTNode> clique = boost::make_shared<BTNode>();
+      clique->problemSize_ = cluster.problemSize;
+      for(size_t child: cluster.children) {
+        cliques[child]->parent_ = clique;
+        clique->children.push_back(cliques[child]);
+      }
+      clique->setEliminationResult(eliminationResult);
+
+      // Store remaining factor for the parent to gather
+      if(!eliminationResult.second->empty())
+        remnants[i] = eliminationResult.second;
+      cliques[i] = clique;
+    }
+
+    // Assemble the Bayes tree - insertRoot also fills the nodes index
+    boost::shared_ptr<BayesTreeType> result = boost::make_shared<BayesTreeType>();
+    for(size_t root: roots_) {
+      // A non-empty remnant at a root means the ordering was incomplete
+      if(remnants[root])
+        throw InconsistentEliminationRequested();
+      result->insertRoot(cliques[root]);
+    }
+    return result;
+  }
+
+}
@@ -0,0 +1,134 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultifrontalPlan.h
+ * @brief   Reusable symbolic elimination plan for repeated multifrontal elimination
+ * @author  Richard Roberts
+ * @date    Apr 21, 2013
+ */
+
+#pragma once
+
+#include <gtsam/inference/EliminateableFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/optional.hpp>
+#include <utility>
+
+namespace gtsam {
+
+  /**
+   * A MultifrontalPlan caches the symbolic structure of a multifrontal elimination - the
+   * elimination tree, junction tree clusters, and the assignment of factors to cliques - so that
+   * repeated numeric eliminations of graphs with identical sparsity can skip all symbolic work.
+   * This is useful inside iterative nonlinear optimizers, where the factor graph relinearized at
+   * each iteration has exactly the same structure and only the matrix values change.
+   *
+   * Build a plan once with EliminateableFactorGraph::planMultifrontal(), then call eliminate()
+   * with each relinearized graph.  The graph passed to eliminate() must have the same factors in
+   * the same slots as the graph the plan was built from; only the numerical values may differ.
+   */
+  template<class FACTORGRAPH>
+  class MultifrontalPlan
+  {
+  public:
+    typedef FACTORGRAPH FactorGraphType; ///< Typedef to factor graph type
+    typedef EliminationTraits<FactorGraphType> EliminationTraitsType; ///< Elimination traits
+    typedef typename EliminationTraitsType::BayesTreeType BayesTreeType; ///< Bayes tree produced by elimination
+    typedef typename EliminationTraitsType::EliminationTreeType EliminationTreeType; ///< Elimination tree type
+    typedef typename EliminationTraitsType::JunctionTreeType JunctionTreeType; ///< Junction tree type
+    typedef typename EliminationTraitsType::ConditionalType ConditionalType; ///< Conditional produced by elimination
+    typedef typename FactorGraphType::FactorType FactorType; ///< Type of factors in the graph
+    typedef boost::shared_ptr<FactorType> sharedFactor; ///< Shared pointer to a factor
+    typedef std::pair<boost::shared_ptr<ConditionalType>, sharedFactor> EliminationResult; ///< Result of one dense elimination step
+    typedef typename FactorGraphType::Eliminate Eliminate; ///< Dense elimination function
+    typedef boost::shared_ptr<MultifrontalPlan> shared_ptr; ///< Shared pointer to this class
+
+    /**
+     * Completed per-clique elimination results, preserved across a failed
+     * numeric pass.  When the dense elimination function throws (e.g.
+     * IndeterminantLinearSystemException on an underconstrained variable)
+     * partway through eliminate(), the results of every clique completed up
+     * to that point remain in the checkpoint.  After repairing the problem -
+     * typically by appending a prior on the offending variable to the graph -
+     * calling eliminate() again with the same checkpoint re-eliminates only
+     * the repaired clique and its ancestors, reusing all unaffected subtree
+     * factorizations.  A checkpoint belongs to the plan it was first used
+     * with; clear() it if the numerical values of the planned factors change.
+     */
+    class Checkpoint {
+    public:
+      /// Number of cliques with a completed elimination result
+      size_t nrCompleted() const {
+        size_t n = 0;
+        for(const boost::optional<EliminationResult>& result: results_)
+          if(result) ++n;
+        return n;
+      }
+
+      /// Whether no completed results are stored
+      bool empty() const { return nrCompleted() == 0; }
+
+      /// Drop all stored results, so the next eliminate() recomputes everything
+      void clear() { results_.clear(); }
+
+    private:
+      friend class MultifrontalPlan;
+      FastVector<boost::optional<EliminationResult> > results_; ///< Per-clique results, indexed like clusters_
+    };
+
+    /** Build the symbolic plan for eliminating \c graph with the given ordering.  Performs the
+     *  same symbolic analysis as eliminateMultifrontal and records the resulting clique
+     *  structure, in terms of factor slots in \c graph, for later numeric passes. */
+    MultifrontalPlan(const FactorGraphType& graph, const Ordering& ordering,
+      const VariableIndex& variableIndex);
+
+    /** Numerically eliminate \c graph following the cached symbolic structure, producing a Bayes
+     *  tree.  No symbolic analysis is performed.  \c graph must have the same sparsity pattern
+     *  and factor slots as the graph the plan was built from. */
+    boost::shared_ptr<BayesTreeType> eliminate(
+      const FactorGraphType& graph, const Eliminate& function) const;
+
+    /** Numerically eliminate \c graph like eliminate() above, but record each
+     *  completed clique's result in \c checkpoint as it is produced, and
+     *  reuse stored results for cliques whose subtrees are unaffected since
+     *  the checkpoint was written.  \c graph may have extra "repair" factors
+     *  appended beyond the planned slots - each is gathered at the clique
+     *  where its first key is frontal, forcing that clique and its ancestors
+     *  to be re-eliminated.  Repair factors must be unary (e.g. a prior on an
+     *  indeterminate variable) or otherwise stay within the clique structure
+     *  of the plan. */
+    boost::shared_ptr<BayesTreeType> eliminate(
+      const FactorGraphType& graph, const Eliminate& function,
+      Checkpoint* checkpoint) const;
+
+    /// Number of cliques in the plan
+    size_t nrCliques() const { return clusters_.size(); }
+
+  private:
+    /// Cached symbolic information for one clique: its frontal keys, the slots of the original
+    /// factors it gathers, and its children (as indices into clusters_, which is in post-order so
+    /// children always precede their parent).
+    struct PlanCluster {
+      Ordering frontalKeys;
+      FactorIndices factorSlots;
+      FastVector<size_t> children;
+      int problemSize;
+    };
+
+    FastVector<PlanCluster> clusters_; ///< All cliques, in post-order
+    FastVector<size_t> roots_; ///< Indices of the root cliques in clusters_
+    size_t graphSize_; ///< Size of the graph the plan was built from, for sanity checking
+  };
+
+}
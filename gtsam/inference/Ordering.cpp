@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <limits>
+#include <thread>
 
 #include <boost/format.hpp>
 
@@ -47,6 +48,13 @@ Ordering Ordering::Colamd(const VariableIndex& variableIndex) {
   return Ordering::ColamdConstrained(variableIndex, dummy_groups);
 }
 
+/* ************************************************************************* */
+Ordering Ordering::Colamd(const CompressedVariableIndex& variableIndex) {
+  // Call constrained version with all groups set to zero
+  vector<int> dummy_groups(variableIndex.size(), 0);
+  return Ordering::ColamdConstrained(variableIndex, dummy_groups);
+}
+
 /* ************************************************************************* */
 Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
     std::vector<int>& cmember) {
@@ -125,6 +133,81 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   return result;
 }
 
+/* ************************************************************************* */
+Ordering Ordering::ColamdConstrained(
+    const CompressedVariableIndex& variableIndex, std::vector<int>& cmember) {
+  gttic(Ordering_COLAMDConstrained);
+
+  gttic(Prepare);
+  const size_t nVars = variableIndex.size();
+  if (nVars == 0)
+  {
+    return Ordering();
+  }
+
+  const KeyVector& keys = variableIndex.keys();
+  if (nVars == 1)
+  {
+    return Ordering(KeyVector(1, keys.front()));
+  }
+
+  const size_t nEntries = variableIndex.nEntries(), nFactors =
+      variableIndex.nFactors();
+  // Convert to compressed column major format colamd wants it in (== MATLAB format!)
+  const size_t Alen = ccolamd_recommended((int) nEntries, (int) nFactors,
+      (int) nVars); /* colamd arg 3: size of the array A */
+  vector<int> A = vector<int>(Alen); /* colamd arg 4: row indices of A, of size Alen */
+  vector<int> p = vector<int>(nVars + 1); /* colamd arg 5: column pointers of A, of size n_col+1 */
+
+  // Fill in input data for COLAMD.  The compressed storage is already in
+  // column-major order, so this is a single sequential sweep over its flat
+  // entries array, plus any overlay entries appended per column.
+  p[0] = 0;
+  int count = 0;
+  for (size_t j = 0; j < nVars; ++j) {
+    const std::pair<FactorIndices::const_iterator,
+        FactorIndices::const_iterator> column = variableIndex.column(j);
+    for (FactorIndices::const_iterator it = column.first; it != column.second; ++it)
+      A[count++] = (int) *it; // copy sparse column
+    if (const FactorIndices* extra = variableIndex.overlay(keys[j]))
+      for(size_t factorIndex: *extra)
+        A[count++] = (int) factorIndex;
+    p[j + 1] = count;  // column j (base 1) goes from A[j-1] to A[j]-1
+  }
+
+  assert((size_t)count == variableIndex.nEntries());
+
+  double knobs[CCOLAMD_KNOBS];
+  ccolamd_set_defaults(knobs);
+  knobs[CCOLAMD_DENSE_ROW] = -1;
+  knobs[CCOLAMD_DENSE_COL] = -1;
+
+  int stats[CCOLAMD_STATS]; /* colamd arg 7: colamd output statistics and error codes */
+
+  gttoc(Prepare);
+
+  // call colamd, result will be in p
+  /* returns (1) if successful, (0) otherwise*/
+  {
+    gttic(ccolamd);
+    int rv = ccolamd((int) nFactors, (int) nVars, (int) Alen, &A[0], &p[0],
+        knobs, stats, &cmember[0]);
+    if (rv != 1)
+      throw runtime_error(
+          (boost::format("ccolamd failed with return value %1%") % rv).str());
+  }
+
+  // Convert elimination ordering in p to an ordering
+  gttic(Fill_Ordering);
+  Ordering result;
+  result.resize(nVars);
+  for (size_t j = 0; j < nVars; ++j)
+    result[j] = keys[p[j]];
+  gttoc(Fill_Ordering);
+
+  return result;
+}
+
 /* ************************************************************************* */
 Ordering Ordering::ColamdConstrainedLast(const VariableIndex& variableIndex,
     const KeyVector& constrainLast, bool forceOrder) {
@@ -208,6 +291,118 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   return Ordering::ColamdConstrained(variableIndex, cmember);
 }
 
+/* ************************************************************************* */
+void ConstrainedOrderer::constrainLast(const KeyVector& keys, bool forceOrder) {
+  constrainLast_ = keys;
+  forceOrder_ = forceOrder;
+  constraintsDirty_ = true;
+}
+
+/* ************************************************************************* */
+Ordering ConstrainedOrderer::ordering(const VariableIndex& variableIndex) {
+  gttic(ConstrainedOrderer_ordering);
+
+  const size_t nVars = variableIndex.size();
+  if (nVars == 0)
+    return Ordering();
+  if (nVars == 1)
+    return Ordering(KeyVector(1, variableIndex.begin()->first));
+
+  // Check whether the cached columns still describe this variable index:
+  // the same keys in the same positions with the same per-column entry counts
+  bool sameStructure = (keys_.size() == nVars);
+  if (sameStructure) {
+    size_t index = 0;
+    for (const auto& key_factors : variableIndex) {
+      if (keys_[index] != key_factors.first
+          || p_[index + 1] - p_[index] != (int) key_factors.second.size()) {
+        sameStructure = false;
+        break;
+      }
+      ++index;
+    }
+  }
+
+  if (sameStructure) {
+    // Refresh only the entries whose factor lists changed since last call
+    gttic(Refresh_columns);
+    size_t index = 0;
+    for (const auto& key_factors : variableIndex) {
+      const FactorIndices& column = key_factors.second;
+      int* cached = A_.data() + p_[index];
+      for (size_t k = 0; k < column.size(); ++k) {
+        const int entry = (int) column[k];
+        if (cached[k] != entry)
+          cached[k] = entry;
+      }
+      ++index;
+    }
+  } else {
+    // Rebuild the whole encoding, reusing the buffers' capacity
+    gttic(Rebuild_columns);
+    keys_.resize(nVars);
+    p_.resize(nVars + 1);
+    A_.resize(variableIndex.nEntries());
+    keyIndices_.clear();
+    p_[0] = 0;
+    int count = 0;
+    size_t index = 0;
+    for (const auto& key_factors : variableIndex) {
+      for (size_t factorIndex : key_factors.second)
+        A_[count++] = (int) factorIndex;
+      p_[index + 1] = count;
+      keys_[index] = key_factors.first;
+      keyIndices_.insert(keyIndices_.end(), make_pair(key_factors.first, index));
+      ++index;
+    }
+    constraintsDirty_ = true;
+  }
+
+  if (constraintsDirty_) {
+    // Same encoding as Ordering::ColamdConstrainedLast
+    cmember_.assign(nVars, 0);
+    int group = (constrainLast_.size() != nVars ? 1 : 0);
+    for (Key key : constrainLast_) {
+      cmember_[keyIndices_.at(key)] = group;
+      if (forceOrder_)
+        ++group;
+    }
+    constraintsDirty_ = false;
+  }
+
+  // ccolamd consumes its input arrays, so run it on scratch copies and keep
+  // the cached encoding pristine for the next frame
+  const size_t nEntries = (size_t) p_[nVars];
+  const size_t nFactors = variableIndex.nFactors();
+  const size_t Alen = ccolamd_recommended((int) nEntries, (int) nFactors,
+      (int) nVars);
+  if (Awork_.size() < Alen)
+    Awork_.resize(Alen);
+  std::copy(A_.begin(), A_.end(), Awork_.begin());
+  pwork_.assign(p_.begin(), p_.end());
+  cmemberWork_.assign(cmember_.begin(), cmember_.end());
+
+  double knobs[CCOLAMD_KNOBS];
+  ccolamd_set_defaults(knobs);
+  knobs[CCOLAMD_DENSE_ROW] = -1;
+  knobs[CCOLAMD_DENSE_COL] = -1;
+  int stats[CCOLAMD_STATS];
+
+  gttic(ccolamd);
+  int rv = ccolamd((int) nFactors, (int) nVars, (int) Alen, &Awork_[0],
+      &pwork_[0], knobs, stats, &cmemberWork_[0]);
+  if (rv != 1)
+    throw runtime_error(
+        (boost::format("ccolamd failed with return value %1%") % rv).str());
+  gttoc(ccolamd);
+
+  Ordering result;
+  result.resize(nVars);
+  for (size_t j = 0; j < nVars; ++j)
+    result[j] = keys_[pwork_[j]];
+  return result;
+}
+
 /* ************************************************************************* */
 Ordering Ordering::Metis(const MetisIndex& met) {
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
@@ -256,6 +451,141 @@ Ordering Ordering::Metis(const MetisIndex& met) {
 #endif
 }
 
+/* ************************************************************************* */
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+namespace {
+
+/* Recursively bisect the subgraph induced by \c vertices with METIS vertex
+ * separators, assigning an elimination group to every vertex.  Groups are
+ * numbered in post-order of the dissection tree - both halves before their
+ * separator - so eliminating the groups in increasing order eliminates every
+ * region before the separators that connect it to the rest of the graph.
+ * localIndex is shared scratch of global graph size, -1 outside the current
+ * subgraph. */
+void dissect(const vector<idx_t>& xadj, const vector<idx_t>& adj,
+    const vector<idx_t>& vertices, size_t levels, vector<idx_t>& localIndex,
+    vector<int>& group, int& nextGroup) {
+  // Regions smaller than this are not worth splitting further: the subtree
+  // scheduling overhead would outweigh the exposed parallelism
+  static const size_t kMinRegion = 8;
+
+  if (levels == 0 || vertices.size() < 2 * kMinRegion) {
+    for (idx_t v : vertices)
+      group[v] = nextGroup;
+    ++nextGroup;
+    return;
+  }
+
+  // Build the induced subgraph in CSR form with local vertex numbers
+  idx_t nSub = (idx_t) vertices.size();
+  for (idx_t i = 0; i < nSub; ++i)
+    localIndex[vertices[i]] = i;
+  vector<idx_t> xadjSub, adjSub;
+  xadjSub.reserve(nSub + 1);
+  xadjSub.push_back(0);
+  for (idx_t i = 0; i < nSub; ++i) {
+    const idx_t v = vertices[i];
+    for (idx_t e = xadj[v]; e < xadj[v + 1]; ++e) {
+      const idx_t w = localIndex[adj[e]];
+      if (w >= 0)
+        adjSub.push_back(w);
+    }
+    xadjSub.push_back((idx_t) adjSub.size());
+  }
+
+  idx_t sepSize = 0;
+  vector<idx_t> part(nSub, 0);
+  const int rv = METIS_ComputeVertexSeparator(&nSub, &xadjSub[0],
+      adjSub.empty() ? NULL : &adjSub[0], NULL, NULL, &sepSize, &part[0]);
+
+  // Restore the shared scratch before recursing
+  for (idx_t v : vertices)
+    localIndex[v] = -1;
+
+  vector<idx_t> left, right, separator;
+  if (rv == METIS_OK) {
+    for (idx_t i = 0; i < nSub; ++i) {
+      if (part[i] == 0)
+        left.push_back(vertices[i]);
+      else if (part[i] == 1)
+        right.push_back(vertices[i]);
+      else
+        separator.push_back(vertices[i]);
+    }
+  }
+
+  if (rv != METIS_OK || left.empty() || right.empty()) {
+    // Degenerate cut; stop dissecting this region and let COLAMD order it
+    for (idx_t v : vertices)
+      group[v] = nextGroup;
+    ++nextGroup;
+    return;
+  }
+
+  dissect(xadj, adj, left, levels - 1, localIndex, group, nextGroup);
+  dissect(xadj, adj, right, levels - 1, localIndex, group, nextGroup);
+  for (idx_t v : separator)
+    group[v] = nextGroup;
+  ++nextGroup;
+}
+
+} // namespace
+#endif
+
+/* ************************************************************************* */
+Ordering Ordering::Hybrid(const MetisIndex& met,
+    const VariableIndex& variableIndex, size_t levels) {
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  gttic(Ordering_Hybrid);
+
+  const idx_t size = (idx_t) met.nValues();
+  if ((size_t) size != variableIndex.size())
+    throw invalid_argument("Ordering::Hybrid: MetisIndex and VariableIndex "
+        "describe different variable sets");
+  if (size == 0)
+    return Ordering();
+  if (size == 1)
+    return Ordering(KeyVector(1, met.intToKey(0)));
+
+  // Auto-tune the crossover depth: just enough dissection levels to expose
+  // one leaf region per core to DepthFirstForestParallel
+  if (levels == 0) {
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores < 2)
+      cores = 2;
+    levels = 1;
+    while ((size_t(1) << levels) < cores)
+      ++levels;
+  }
+
+  vector<idx_t> xadj = met.xadj();
+  vector<idx_t> adj = met.adj();
+  vector<idx_t> vertices(size);
+  for (idx_t i = 0; i < size; ++i)
+    vertices[i] = i;
+  vector<idx_t> localIndex(size, -1);
+  vector<int> group(size, 0);
+  int nextGroup = 0;
+  dissect(xadj, adj, vertices, levels, localIndex, group, nextGroup);
+
+  // Translate the per-vertex groups into the cmember layout of CCOLAMD, one
+  // entry per variable in VariableIndex iteration order, and let CCOLAMD
+  // reduce fill within every region and separator
+  FastMap<Key, size_t> keyIndices;
+  size_t j = 0;
+  for (auto key_factors : variableIndex)
+    keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
+  vector<int> cmember(size, 0);
+  for (idx_t i = 0; i < size; ++i)
+    cmember[keyIndices.at(met.intToKey(i))] = group[i];
+
+  return Ordering::ColamdConstrained(variableIndex, cmember);
+#else
+  throw runtime_error("GTSAM was built without support for Metis-based "
+                      "nested dissection");
+#endif
+}
+
 /* ************************************************************************* */
 void Ordering::print(const std::string& str,
     const KeyFormatter& keyFormatter) const {
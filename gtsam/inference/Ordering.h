@@ -22,6 +22,7 @@
 
 #include <gtsam/inference/Key.h>
 #include <gtsam/inference/VariableIndex.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
 #include <gtsam/inference/MetisIndex.h>
 #include <gtsam/base/FastSet.h>
 
@@ -39,7 +40,7 @@ public:
 
   /// Type of ordering to use
   enum OrderingType {
-    COLAMD, METIS, NATURAL, CUSTOM
+    COLAMD, METIS, HYBRID, NATURAL, CUSTOM
   };
 
   typedef Ordering This; ///< Typedef to this class
@@ -89,6 +90,11 @@ public:
   /// Compute a fill-reducing ordering using COLAMD from a VariableIndex.
   static GTSAM_EXPORT Ordering Colamd(const VariableIndex& variableIndex);
 
+  /// Compute a fill-reducing ordering using COLAMD from a
+  /// CompressedVariableIndex.  The CSC arrays COLAMD consumes are copied
+  /// straight out of the compressed storage in one sequential sweep.
+  static GTSAM_EXPORT Ordering Colamd(const CompressedVariableIndex& variableIndex);
+
   /// Compute a fill-reducing ordering using constrained COLAMD from a factor graph (see details
   /// for note on performance).  This internally builds a VariableIndex so if you already have a
   /// VariableIndex, it is faster to use COLAMD(const VariableIndex&).  This function constrains
@@ -197,6 +203,32 @@ public:
       return Metis(MetisIndex(graph));
   }
 
+  /**
+   * Compute a hybrid two-level ordering: METIS vertex separators dissect the
+   * graph for the top \c levels levels, and COLAMD orders the variables
+   * within each resulting region.  The dissection fixes the coarse
+   * elimination structure - each leaf region forms an independent subtree of
+   * the elimination forest, with the separators eliminated above them - so
+   * DepthFirstForestParallel gets one well-balanced subtree per region,
+   * while COLAMD keeps the fill inside every region close to what a pure
+   * minimum-degree ordering would achieve.  With \c levels == 0 the
+   * crossover depth is chosen from the hardware core count: just enough
+   * levels to expose one leaf region per core.
+   */
+  template<class FACTOR_GRAPH>
+  static Ordering Hybrid(const FACTOR_GRAPH& graph, size_t levels = 0) {
+    if (graph.empty())
+      return Ordering();
+    else
+      return Hybrid(MetisIndex(graph), VariableIndex(graph), levels);
+  }
+
+  /// Compute a hybrid dissection + COLAMD ordering from a prebuilt
+  /// MetisIndex and VariableIndex over the same variables, see
+  /// Hybrid(const FACTOR_GRAPH&, size_t)
+  static GTSAM_EXPORT Ordering Hybrid(const MetisIndex& met,
+      const VariableIndex& variableIndex, size_t levels = 0);
+
   /// @}
 
   /// @name Named Constructors @{
@@ -212,6 +244,8 @@ public:
       return Colamd(graph);
     case METIS:
       return Metis(graph);
+    case HYBRID:
+      return Hybrid(graph);
     case NATURAL:
       return Natural(graph);
     case CUSTOM:
@@ -223,6 +257,35 @@ public:
     }
   }
 
+  /**
+   * Heuristically pick an ordering type for the given factor graph.
+   * Nested dissection asymptotically dominates minimum-degree orderings on
+   * large, sparsely connected problems (grids, planar pose graphs), while
+   * COLAMD wins on small problems and densely connected ones, so choose
+   * METIS only for graphs with many variables and low average variable
+   * degree.  Without METIS support this always returns COLAMD.  The
+   * thresholds can be examined per dataset with timing/timeOrdering.cpp.
+   */
+  template<class FACTOR_GRAPH>
+  static OrderingType AutoSelect(const FACTOR_GRAPH& graph) {
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+    KeySet variables;
+    size_t slots = 0;
+    for (const typename FACTOR_GRAPH::sharedFactor& factor : graph) {
+      if (!factor) continue;
+      for (Key key : factor->keys())
+        variables.insert(key);
+      slots += factor->size();
+    }
+    if (!variables.empty()) {
+      const double averageDegree = double(slots) / double(variables.size());
+      if (variables.size() >= 1000 && averageDegree <= 4.0)
+        return METIS;
+    }
+#endif
+    return COLAMD;
+  }
+
   /// @}
 
   /// @name Testable @{
@@ -241,6 +304,10 @@ private:
   static GTSAM_EXPORT Ordering ColamdConstrained(
       const VariableIndex& variableIndex, std::vector<int>& cmember);
 
+  /// Internal COLAMD function on compressed storage
+  static GTSAM_EXPORT Ordering ColamdConstrained(
+      const CompressedVariableIndex& variableIndex, std::vector<int>& cmember);
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
@@ -253,5 +320,52 @@ private:
 template<> struct traits<Ordering> : public Testable<Ordering> {
 };
 
+/**
+ * Stateful constrained-COLAMD ordering engine for incremental and fixed-lag
+ * use.  Ordering::ColamdConstrainedLast rebuilds the compressed-column
+ * matrix, the key-to-column map, and the constraint encoding from scratch on
+ * every call; a fixed-lag smoother calls it every frame with a nearly
+ * identical graph and the same "constrain last" group.  ConstrainedOrderer
+ * keeps all of the CCOLAMD input alive between calls: when the variable set
+ * and column sizes are unchanged it refreshes only the entries whose factor
+ * lists differ from the previous frame, and it re-encodes the constraint
+ * groups only when the constrained set or the variable set changes.  CCOLAMD
+ * itself is a batch algorithm and still runs on the whole matrix, but the
+ * per-frame encoding cost scales with the amount of change instead of the
+ * window size.  Produces the same ordering as ColamdConstrainedLast.
+ */
+class GTSAM_EXPORT ConstrainedOrderer {
+public:
+
+  ConstrainedOrderer() :
+      forceOrder_(false), constraintsDirty_(true) {
+  }
+
+  /// Set the variables constrained to the end of the ordering, replacing any
+  /// previously constrained set; same semantics as
+  /// Ordering::ColamdConstrainedLast
+  void constrainLast(const KeyVector& keys, bool forceOrder = false);
+
+  /// Compute the constrained ordering, reusing the cached CCOLAMD input for
+  /// columns that did not change since the previous call
+  Ordering ordering(const VariableIndex& variableIndex);
+
+private:
+
+  KeyVector constrainLast_; ///< Variables pinned to the end of the ordering
+  bool forceOrder_; ///< Keep constrainLast_ in the given relative order
+  bool constraintsDirty_; ///< cmember_ must be re-encoded before the next run
+
+  // Cached CCOLAMD input, refreshed incrementally across calls
+  KeyVector keys_; ///< Column index to key
+  FastMap<Key, size_t> keyIndices_; ///< Key to column index
+  std::vector<int> A_; ///< Row indices in compressed-column format
+  std::vector<int> p_; ///< Column pointers into A_
+  std::vector<int> cmember_; ///< Constraint group of each column
+
+  // Scratch copies consumed (overwritten) by the ccolamd call
+  std::vector<int> Awork_, pwork_, cmemberWork_;
+};
+
 }
 
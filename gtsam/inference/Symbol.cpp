@@ -22,6 +22,7 @@
 #include <boost/bind.hpp>
 
 #include <limits.h>
+#include <cstdio>
 #include <list>
 #include <iostream>
 
@@ -57,7 +58,12 @@ bool Symbol::equals(const Symbol& expected, double tol) const {
 }
 
 Symbol::operator std::string() const {
-  return str(boost::format("%c%d") % c_ % j_);
+  // Formatted keys are on the hot path of full-graph debug dumps, so format
+  // into a stack buffer instead of going through boost::format
+  char buffer[32];
+  const int length = snprintf(buffer, sizeof(buffer), "%c%llu", c_,
+      (unsigned long long) j_);
+  return std::string(buffer, length);
 }
 
 static Symbol make(gtsam::Key key) { return Symbol(key);}
@@ -43,12 +43,65 @@ void VariableIndex::augment(const FG& factors,
     if (newFactorIndices) {
       if ((*newFactorIndices)[i] >= nFactors_)
         nFactors_ = (*newFactorIndices)[i] + 1;
+      // If the caller explicitly reuses a freed slot, it is no longer free
+      if (!freeSlots_.empty()) {
+        auto slot = std::find(freeSlots_.begin(), freeSlots_.end(),
+            (*newFactorIndices)[i]);
+        if (slot != freeSlots_.end())
+          freeSlots_.erase(slot);
+      }
     } else {
       ++nFactors_;
     }
   }
 }
 
+/* ************************************************************************* */
+template<class FG>
+FactorIndices VariableIndex::augmentRecycled(const FG& factors) {
+  gttic(VariableIndex_augmentRecycled);
+
+  FactorIndices newIndices;
+  newIndices.reserve(factors.size());
+
+  for (size_t i = 0; i < factors.size(); ++i) {
+    // Pop a recycled slot if one is available, otherwise append a new one
+    size_t globalI;
+    if (!freeSlots_.empty()) {
+      globalI = freeSlots_.back();
+      freeSlots_.pop_back();
+    } else {
+      globalI = nFactors_;
+      ++nFactors_;
+    }
+    newIndices.push_back(globalI);
+
+    if (factors[i]) {
+      for(const Key key: *factors[i]) {
+        index_[key].push_back(globalI);
+        ++nEntries_;
+      }
+    }
+  }
+
+  return newIndices;
+}
+
+/* ************************************************************************* */
+template<class FG>
+void VariableIndex::replace(const FactorIndices& indices, const FG& oldFactors,
+    const FG& newFactors) {
+  gttic(VariableIndex_replace);
+
+  if (indices.size() != oldFactors.size() || indices.size() != newFactors.size())
+    throw std::invalid_argument(
+        "Requested inconsistent number of factor indices and factors in VariableIndex::replace");
+
+  // Remove the old entries, then reinsert the new factors at the same slots
+  remove(indices.begin(), indices.end(), oldFactors);
+  augment(newFactors, boost::optional<const FactorIndices&>(indices));
+}
+
 /* ************************************************************************* */
 template<typename ITERATOR, class FG>
 void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
@@ -77,6 +130,8 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
         --nEntries_;
       }
     }
+    // Record the slot for recycling by augmentRecycled()
+    freeSlots_.push_back(*factorIndex);
   }
 }
 
@@ -24,6 +24,7 @@
 #include <gtsam/dllexport.h>
 
 #include <boost/optional/optional.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 
 #include <cassert>
@@ -51,6 +52,7 @@ class GTSAM_EXPORT VariableIndex {
   KeyMap index_;
   size_t nFactors_;  // Number of factors in the original factor graph.
   size_t nEntries_;  // Sum of involved variable counts of each factor.
+  FactorIndices freeSlots_;  // Factor indices freed by remove(), available for recycling.
 
  public:
   typedef KeyMap::const_iterator const_iterator;
@@ -128,6 +130,31 @@ class GTSAM_EXPORT VariableIndex {
   template<class FG>
   void augment(const FG& factors, boost::optional<const FactorIndices&> newFactorIndices = boost::none);
 
+  /**
+   * Augment the variable index with new factors, recycling factor indices
+   * freed by earlier calls to remove().  This keeps nFactors() bounded by the
+   * working-set size in sliding-window settings, where factors are removed
+   * and added continuously, instead of growing without bound.
+   *
+   * @return The factor indices assigned to the new factors, in order.
+   */
+  template<class FG>
+  FactorIndices augmentRecycled(const FG& factors);
+
+  /**
+   * Replace the factors at the given indices with new factors in one pass,
+   * equivalent to remove() followed by augment() at the same indices.  The
+   * new factors reuse the removed factor slots, so this is O(replaced
+   * factors) and nFactors() is unchanged.
+   *
+   * @param indices The indices of the factors being replaced
+   * @param oldFactors The factors being removed, which must symbolically
+   *        correspond exactly to the factors currently at \c indices
+   * @param newFactors The replacement factors, in the same order
+   */
+  template<class FG>
+  void replace(const FactorIndices& indices, const FG& oldFactors, const FG& newFactors);
+
   /**
    * Augment the variable index after an existing factor now affects to more
    * variable Keys. This can be used when solving problems incrementally, with
@@ -152,6 +179,9 @@ class GTSAM_EXPORT VariableIndex {
   template<typename ITERATOR>
   void removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey);
 
+  /// Factor indices freed by remove() and not yet recycled by augmentRecycled()
+  const FactorIndices& freeSlots() const { return freeSlots_; }
+
   /// Iterator to the first variable entry
   const_iterator begin() const { return index_.begin(); }
 
@@ -179,10 +209,20 @@ protected:
   FactorIndices& internalAt(Key variable) {
     const KeyMap::iterator item = index_.find(variable);
     assert(item != index_.end());
-    return item->second; 
+    return item->second;
   }
 
   /// @}
+
+private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(index_);
+    ar & BOOST_SERIALIZATION_NVP(nFactors_);
+    ar & BOOST_SERIALIZATION_NVP(nEntries_);
+  }
 };
 
 /// traits
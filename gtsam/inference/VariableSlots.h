@@ -103,20 +103,40 @@ VariableSlots::VariableSlots(const FG& factorGraph)
       continue;
     }
     size_t factorVarSlot = 0;
-    for(const Key involvedVariable: *factor) {
-      // Set the slot in this factor for this variable.  If the
-      // variable was not already discovered, create an array for it
-      // that we'll fill with the slot indices for each factor that
-      // we're combining.  Initially we put the max integer value in
-      // the array entry for each factor that will indicate the factor
-      // does not involve the variable.
-      iterator thisVarSlots; bool inserted;
+    if(factor->sortedKeys()) {
+      // The factor's keys arrive in ascending order, the same order this
+      // map iterates in, so each insertion position is a valid hint for the
+      // next one and the whole factor merges in linearly instead of paying
+      // a tree search per key.  A hinted insert gives no "inserted" flag,
+      // but a preexisting entry always holds a non-empty slot vector, so
+      // emptiness identifies the fresh entries that still need resizing.
+      iterator hint = this->begin();
+      for(const Key involvedVariable: *factor) {
+        iterator thisVarSlots = this->insert(hint, std::make_pair(involvedVariable, FastVector<size_t>()));
+        if(thisVarSlots->second.empty())
+          thisVarSlots->second.resize(factorGraph.nrFactors(), Empty);
+        thisVarSlots->second[jointFactorPos] = factorVarSlot;
+        if(debug) std::cout << "  var " << involvedVariable << " rowblock " << jointFactorPos << " comes from factor's slot " << factorVarSlot << std::endl;
+        ++ factorVarSlot;
+        hint = thisVarSlots;
+        ++ hint;
+      }
+    } else {
+      for(const Key involvedVariable: *factor) {
+        // Set the slot in this factor for this variable.  If the
+        // variable was not already discovered, create an array for it
+        // that we'll fill with the slot indices for each factor that
+        // we're combining.  Initially we put the max integer value in
+        // the array entry for each factor that will indicate the factor
+        // does not involve the variable.
+        iterator thisVarSlots; bool inserted;
         boost::tie(thisVarSlots, inserted) = this->insert(std::make_pair(involvedVariable, FastVector<size_t>()));
-      if(inserted)
-        thisVarSlots->second.resize(factorGraph.nrFactors(), Empty);
-      thisVarSlots->second[jointFactorPos] = factorVarSlot;
-      if(debug) std::cout << "  var " << involvedVariable << " rowblock " << jointFactorPos << " comes from factor's slot " << factorVarSlot << std::endl;
-      ++ factorVarSlot;
+        if(inserted)
+          thisVarSlots->second.resize(factorGraph.nrFactors(), Empty);
+        thisVarSlots->second[jointFactorPos] = factorVarSlot;
+        if(debug) std::cout << "  var " << involvedVariable << " rowblock " << jointFactorPos << " comes from factor's slot " << factorVarSlot << std::endl;
+        ++ factorVarSlot;
+      }
     }
     ++ jointFactorPos;
   }
@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testCompressedVariableIndex
+ * @author Richard Roberts
+ */
+
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/inference/CompressedVariableIndex.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+SymbolicFactorGraph exampleGraph() {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 1);
+  graph.push_factor(1, 2);
+  graph.push_factor(2, 3);
+  graph.push_factor(1, 3);
+  return graph;
+}
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, counting_sort_build) {
+  SymbolicFactorGraph graph = exampleGraph();
+  CompressedVariableIndex compressed(graph);
+
+  LONGS_EQUAL(4, compressed.size());
+  LONGS_EQUAL(4, compressed.nFactors());
+  LONGS_EQUAL(8, compressed.nEntries());
+
+  // The flat storage must hold exactly the columns of the map-based index
+  VariableIndex expected(graph);
+  for(const VariableIndex::value_type& key_factors: expected)
+    EXPECT(key_factors.second == compressed.factors(key_factors.first));
+
+  // Columns are key-sorted and the offsets delimit them
+  LONGS_EQUAL(4, compressed.keys().size());
+  LONGS_EQUAL(5, compressed.offsets().size());
+  LONGS_EQUAL(0, compressed.offsets().front());
+  LONGS_EQUAL(8, compressed.offsets().back());
+  LONGS_EQUAL(1, compressed.columnOf(1));
+
+  // Missing variables throw, as in VariableIndex
+  CHECK_EXCEPTION(compressed.columnOf(10), std::invalid_argument);
+  CHECK_EXCEPTION(compressed.factors(10), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, conversion_equals) {
+  SymbolicFactorGraph graph = exampleGraph();
+
+  // Building from the graph and converting a VariableIndex agree
+  CompressedVariableIndex direct(graph);
+  CompressedVariableIndex converted((VariableIndex(graph)));
+  EXPECT(assert_equal(direct, converted));
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, overlay_and_recompress) {
+  SymbolicFactorGraph graph = exampleGraph();
+  CompressedVariableIndex compressed(graph);
+
+  // Add a factor incrementally; it lands in the overlay
+  SymbolicFactorGraph newFactors;
+  newFactors.push_factor(3, 4);
+  compressed.augment(newFactors);
+  LONGS_EQUAL(5, compressed.nFactors());
+  LONGS_EQUAL(10, compressed.nEntries());
+  CHECK(compressed.overlay(3) != nullptr);
+  CHECK(compressed.overlay(0) == nullptr);
+  EXPECT(compressed.factors(3).back() == 4);
+  EXPECT(compressed.factors(4) == FactorIndices(1, 4));
+
+  // recompress folds the overlay into the flat arrays without changing content
+  SymbolicFactorGraph combined = graph;
+  combined.push_factor(3, 4);
+  CompressedVariableIndex expected(combined);
+  compressed.recompress();
+  CHECK(compressed.overlay(3) == nullptr);
+  LONGS_EQUAL(5, compressed.size());
+  EXPECT(assert_equal(expected, compressed));
+}
+
+/* ************************************************************************* */
+TEST(CompressedVariableIndex, colamd) {
+  SymbolicFactorGraph graph = exampleGraph();
+
+  // The compressed overload must reproduce the map-based COLAMD ordering,
+  // with and without overlay entries present
+  CompressedVariableIndex compressed(graph);
+  EXPECT(assert_equal(Ordering::Colamd(VariableIndex(graph)),
+      Ordering::Colamd(compressed)));
+
+  SymbolicFactorGraph newFactors;
+  newFactors.push_factor(3, 4);
+  compressed.augment(newFactors);
+  SymbolicFactorGraph combined = graph;
+  combined.push_factor(3, 4);
+  EXPECT(assert_equal(Ordering::Colamd(VariableIndex(combined)),
+      Ordering::Colamd(compressed)));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDenseKeyMap.cpp
+ * @brief   Unit tests for the dense Key remapping
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/inference/DenseKeyMap.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+TEST(DenseKeyMap, insert) {
+  DenseKeyMap map;
+  EXPECT(map.empty());
+
+  // Keys are numbered in insertion order, not key order
+  LONGS_EQUAL(0, (long)map.insert(X(7)));
+  LONGS_EQUAL(1, (long)map.insert(X(2)));
+  LONGS_EQUAL(2, (long)map.insert(X(5)));
+  LONGS_EQUAL(3, (long)map.size());
+
+  LONGS_EQUAL(1, (long)map.at(X(2)));
+  LONGS_EQUAL((long)X(5), (long)map.keyAt(2));
+  EXPECT(map.exists(X(7)));
+  EXPECT(!map.exists(X(1)));
+
+  // Duplicate insertion and unknown lookup throw
+  CHECK_EXCEPTION(map.insert(X(2)), std::invalid_argument);
+  CHECK_EXCEPTION(map.at(X(1)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DenseKeyMap, erase) {
+  DenseKeyMap map;
+  for (size_t i = 0; i < 5; ++i) map.insert(X(i));
+
+  // Erasing an interior key relabels exactly the highest id
+  auto moved = map.erase(X(1));
+  CHECK(moved);
+  LONGS_EQUAL((long)X(4), (long)moved->first);
+  LONGS_EQUAL(1, (long)moved->second);
+  LONGS_EQUAL(4, (long)map.size());
+  LONGS_EQUAL(1, (long)map.at(X(4)));
+  EXPECT(!map.exists(X(1)));
+
+  // Ids remain a dense bijection
+  for (DenseIndex id = 0; id < (DenseIndex)map.size(); ++id)
+    LONGS_EQUAL(id, (long)map.at(map.keyAt(id)));
+
+  // Erasing the highest id moves nothing
+  LONGS_EQUAL(3, (long)map.at(X(3)));
+  EXPECT(!map.erase(X(3)));
+  LONGS_EQUAL(3, (long)map.size());
+
+  CHECK_EXCEPTION(map.erase(X(1)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DenseKeyMap, fromFactorGraph) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(X(2));
+  graph.push_factor(X(2), X(0));
+  graph.push_factor(X(0), X(1));
+
+  // Keys are numbered in order of first appearance
+  const DenseKeyMap map(graph);
+  LONGS_EQUAL(3, (long)map.size());
+  LONGS_EQUAL(0, (long)map.at(X(2)));
+  LONGS_EQUAL(1, (long)map.at(X(0)));
+  LONGS_EQUAL(2, (long)map.at(X(1)));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testEliminationTrace.cpp
+ * @brief   Unit tests for simulated vertex elimination traces
+ * @author  Richard Roberts
+ * @date    Sep 2, 2010
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <gtsam/inference/EliminationTrace.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+
+using namespace gtsam;
+using namespace std;
+
+/* ************************************************************************* */
+TEST(EliminationTrace, chain) {
+
+  // A chain eliminated front to back produces no fill at all
+  SymbolicFactorGraph fg;
+  fg.push_factor(0, 1);
+  fg.push_factor(1, 2);
+  fg.push_factor(2, 3);
+
+  Ordering natural;
+  natural += 0, 1, 2, 3;
+  EliminationTrace trace = EliminationTrace::Simulate(fg, natural);
+
+  LONGS_EQUAL(4, trace.size());
+  LONGS_EQUAL(3, trace.nrOriginalEdges());
+  LONGS_EQUAL(0, trace.totalFill());
+  LONGS_EQUAL(1, trace.maxDegree());
+  EXPECT(trace.steps()[0].key == 0);
+  EXPECT(trace.steps()[3].degree == 0); // last variable has no neighbors left
+}
+
+/* ************************************************************************* */
+TEST(EliminationTrace, fill) {
+
+  // Eliminating the middle of a chain first connects its two neighbors
+  SymbolicFactorGraph fg;
+  fg.push_factor(0, 1);
+  fg.push_factor(1, 2);
+  fg.push_factor(2, 3);
+
+  Ordering bad;
+  bad += 1, 0, 2, 3;
+  EliminationTrace trace = EliminationTrace::Simulate(fg, bad);
+
+  LONGS_EQUAL(1, trace.totalFill());
+  LONGS_EQUAL(2, trace.maxDegree());
+  LONGS_EQUAL(1, trace.steps()[0].fillEdges.size());
+  EXPECT(trace.steps()[0].fillEdges[0] == make_pair(Key(0), Key(2)));
+
+  // Replaying through the first step adds exactly that edge to the graph
+  FastMap<Key, FastSet<Key> > before = trace.replayFill(0);
+  FastMap<Key, FastSet<Key> > after = trace.replayFill(1);
+  EXPECT(!before.at(0).count(2));
+  EXPECT(after.at(0).count(2));
+  EXPECT(after.at(2).count(0));
+}
+
+/* ************************************************************************* */
+TEST(EliminationTrace, star) {
+
+  // A star eliminated hub first turns the leaves into a clique
+  SymbolicFactorGraph fg;
+  fg.push_factor(0, 1);
+  fg.push_factor(0, 2);
+  fg.push_factor(0, 3);
+  fg.push_factor(0, 4);
+
+  Ordering hubFirst;
+  hubFirst += 0, 1, 2, 3, 4;
+  EliminationTrace trace = EliminationTrace::Simulate(fg, hubFirst);
+  LONGS_EQUAL(4, trace.maxDegree());
+  LONGS_EQUAL(6, trace.totalFill()); // 4 choose 2 leaf pairs
+
+  // Eliminated leaves first there is nothing to connect
+  Ordering hubLast;
+  hubLast += 1, 2, 3, 4, 0;
+  EliminationTrace noFill = EliminationTrace::Simulate(fg, hubLast);
+  LONGS_EQUAL(0, noFill.totalFill());
+  LONGS_EQUAL(1, noFill.maxDegree());
+
+  // A trace equals itself but not a trace of a different ordering
+  EXPECT(assert_equal(trace, trace));
+  EXPECT(!trace.equals(noFill));
+}
+
+/* ************************************************************************* */
+TEST(EliminationTrace, matchesSymbolicElimination) {
+
+  // On a small grid, the fill-reducing ordering COLAMD produces must
+  // simulate to no more fill than the natural ordering
+  SymbolicFactorGraph fg;
+  const size_t rows = 4, cols = 4;
+  const auto key = [cols](size_t i, size_t j) { return Key(i * cols + j); };
+  for (size_t i = 0; i < rows; ++i)
+    for (size_t j = 0; j < cols; ++j) {
+      if (i + 1 < rows)
+        fg.push_factor(key(i, j), key(i + 1, j));
+      if (j + 1 < cols)
+        fg.push_factor(key(i, j), key(i, j + 1));
+    }
+
+  const VariableIndex variableIndex(fg);
+  EliminationTrace colamd = EliminationTrace::Simulate(variableIndex,
+      Ordering::Colamd(variableIndex));
+  EliminationTrace natural = EliminationTrace::Simulate(variableIndex,
+      Ordering::Natural(fg));
+  LONGS_EQUAL(24, colamd.nrOriginalEdges());
+  EXPECT(colamd.totalFill() <= natural.totalFill());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testIncrementalOrdering.cpp
+ * @brief   Unit tests for incrementally maintained elimination orderings
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/inference/IncrementalOrdering.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Check that an ordering is a permutation of the variables in the index
+static bool isPermutationOf(const Ordering& ordering,
+    const VariableIndex& variableIndex) {
+  if (ordering.size() != variableIndex.size())
+    return false;
+  KeyVector sorted = ordering;
+  std::sort(sorted.begin(), sorted.end());
+  size_t i = 0;
+  for (const VariableIndex::value_type& keyFactors : variableIndex)
+    if (sorted[i++] != keyFactors.first)
+      return false;
+  return true;
+}
+
+/* ************************************************************************* */
+// A chain 0-1-2-3-4-5
+static SymbolicFactorGraph chainGraph() {
+  SymbolicFactorGraph graph;
+  for (Key j = 0; j < 5; ++j)
+    graph.push_factor(j, j + 1);
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(IncrementalOrdering, firstCallIsFullColamd) {
+  SymbolicFactorGraph graph = chainGraph();
+  VariableIndex variableIndex(graph);
+
+  IncrementalOrdering incremental;
+  EXPECT(assert_equal(Ordering::Colamd(variableIndex),
+      incremental.ordering(variableIndex)));
+}
+
+/* ************************************************************************* */
+TEST(IncrementalOrdering, partialUpdate) {
+  SymbolicFactorGraph graph = chainGraph();
+  VariableIndex variableIndex(graph);
+
+  IncrementalOrdering incremental(0.6);
+  const Ordering initial = incremental.ordering(variableIndex);
+
+  // Attach a new variable 6 to variable 5 and announce the change
+  SymbolicFactorGraph newFactors;
+  newFactors.push_factor(5, 6);
+  variableIndex.augment(newFactors);
+  incremental.markChanged(KeyVector{5, 6});
+  LONGS_EQUAL(2, (long)incremental.nrChanged());
+
+  const Ordering updated = incremental.ordering(variableIndex);
+  EXPECT(isPermutationOf(updated, variableIndex));
+  LONGS_EQUAL(0, (long)incremental.nrChanged());
+
+  // Variables away from the change keep their cached relative order and
+  // precede the reordered region
+  KeyVector cleanKeys;
+  for (Key key : initial)
+    if (key != 4 && key != 5) // 4 neighbours the changed region through factor (4,5)
+      cleanKeys.push_back(key);
+  for (size_t i = 0; i < cleanKeys.size(); ++i)
+    EXPECT(updated[i] == cleanKeys[i]);
+
+  // With nothing marked, the cached ordering is returned unchanged
+  EXPECT(assert_equal(updated, incremental.ordering(variableIndex)));
+}
+
+/* ************************************************************************* */
+TEST(IncrementalOrdering, largeChangeFallsBackToFull) {
+  SymbolicFactorGraph graph = chainGraph();
+  VariableIndex variableIndex(graph);
+
+  IncrementalOrdering incremental;
+  incremental.ordering(variableIndex);
+
+  // Marking most of the problem triggers a full recompute
+  incremental.markChanged(KeyVector{0, 1, 2, 3, 4});
+  EXPECT(assert_equal(Ordering::Colamd(variableIndex),
+      incremental.ordering(variableIndex)));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -100,6 +100,46 @@ TEST(Key, Formatting) {
   EXPECT("c3" == ss3.str());
 }
 
+/* ************************************************************************* */
+TEST(Key, FormatterCache) {
+  KeyFormatterCache cache;
+  const Key x1 = Symbol('x', 1), l2 = Symbol('l', 2);
+
+  // Cached formatting matches the underlying formatter
+  EXPECT(DefaultKeyFormatter(x1) == cache(x1));
+  EXPECT(DefaultKeyFormatter(l2) == cache(l2));
+  EXPECT_LONGS_EQUAL(2, cache.size());
+
+  // Repeated lookups are interned: same string object, no growth
+  const std::string* first = &cache(x1);
+  EXPECT(first == &cache(x1));
+  EXPECT_LONGS_EQUAL(2, cache.size());
+
+  cache.clear();
+  EXPECT_LONGS_EQUAL(0, cache.size());
+
+  // A custom formatter is respected
+  KeyFormatterCache special(keyMyFormatter);
+  EXPECT("special" == special(x1));
+}
+
+/* ************************************************************************* */
+TEST(Key, AppendKeyVector) {
+  KeyFormatterCache cache;
+  KeyVector keys;
+  keys.push_back(Symbol('x', 1));
+  keys.push_back(Symbol('x', 2));
+  keys.push_back(Symbol('l', 1));
+
+  // Streaming append builds one growing buffer, repeats come from the cache
+  std::string buffer = "keys: ";
+  AppendKeyVector(keys, &buffer, cache);
+  EXPECT("keys: x1 x2 l1 " == buffer);
+  AppendKeyVector(keys, &buffer, cache);
+  EXPECT("keys: x1 x2 l1 x1 x2 l1 " == buffer);
+  EXPECT_LONGS_EQUAL(3, cache.size());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -17,6 +17,7 @@
 
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesNet.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/MetisIndex.h>
 #include <gtsam/base/TestableAssertions.h>
@@ -65,6 +66,32 @@ TEST(Ordering, constrained_ordering) {
     EXPECT(assert_equal(expected, actual));
   }
 
+  // the stateful engine matches ColamdConstrainedLast across repeated frames
+  {
+    ConstrainedOrderer orderer;
+    orderer.constrainLast(list_of(2)(4));
+
+    // first frame builds the cache, second reuses it unchanged
+    VariableIndex variableIndex(symbolicGraph);
+    Ordering expected = Ordering::ColamdConstrainedLast(variableIndex, list_of(2)(4));
+    EXPECT(assert_equal(expected, orderer.ordering(variableIndex)));
+    EXPECT(assert_equal(expected, orderer.ordering(variableIndex)));
+
+    // a new factor changes the structure; the cache is rebuilt transparently
+    SymbolicFactorGraph augmentedGraph = symbolicGraph;
+    augmentedGraph.push_factor(0, 5);
+    VariableIndex augmentedIndex(augmentedGraph);
+    Ordering expectedAugmented =
+        Ordering::ColamdConstrainedLast(augmentedIndex, list_of(2)(4));
+    EXPECT(assert_equal(expectedAugmented, orderer.ordering(augmentedIndex)));
+
+    // changing the constrained set re-encodes the groups
+    orderer.constrainLast(list_of(3)(5));
+    Ordering expectedMoved =
+        Ordering::ColamdConstrainedLast(augmentedIndex, list_of(3)(5));
+    EXPECT(assert_equal(expectedMoved, orderer.ordering(augmentedIndex)));
+  }
+
   // Make sure giving empty constraints does not break the code
   {
     Ordering actual = Ordering::ColamdConstrainedLast(symbolicGraph, {});
@@ -295,6 +322,46 @@ TEST(Ordering, MetisLoop) {
 #endif
 /* ************************************************************************* */
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+TEST(Ordering, Hybrid) {
+  // A 6x6 grid, large enough for one level of dissection to engage
+  const size_t W = 6;
+  SymbolicFactorGraph symbolicGraph;
+  for (size_t i = 0; i < W; ++i)
+    for (size_t j = 0; j < W; ++j) {
+      if (j + 1 < W)
+        symbolicGraph.push_factor(i * W + j, i * W + j + 1);
+      if (i + 1 < W)
+        symbolicGraph.push_factor(i * W + j, (i + 1) * W + j);
+    }
+
+  Ordering hybrid = Ordering::Hybrid(symbolicGraph, 1);
+
+  // The hybrid ordering is a permutation of all the variables
+  KeyVector sorted = hybrid;
+  std::sort(sorted.begin(), sorted.end());
+  LONGS_EQUAL(W * W, sorted.size());
+  for (size_t k = 0; k < W * W; ++k)
+    LONGS_EQUAL(k, sorted[k]);
+
+  // and is a valid elimination order
+  SymbolicBayesNet::shared_ptr bn = symbolicGraph.eliminateSequential(hybrid);
+  LONGS_EQUAL(W * W, bn->size());
+
+  // The auto-tuned depth is exercised through Create
+  Ordering actual = Ordering::Create(Ordering::HYBRID, symbolicGraph);
+  LONGS_EQUAL(W * W, actual.size());
+}
+#endif
+/* ************************************************************************* */
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+TEST(Ordering, HybridEmptyGraph) {
+  SymbolicFactorGraph symbolicGraph;
+  Ordering actual = Ordering::Create(Ordering::HYBRID, symbolicGraph);
+  EXPECT(assert_equal(Ordering(), actual));
+}
+#endif
+/* ************************************************************************* */
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
 TEST(Ordering, MetisEmptyGraph) {
   SymbolicFactorGraph symbolicGraph;
 
@@ -349,6 +416,17 @@ TEST(Ordering, Create) {
   CHECK_EXCEPTION(Ordering::Create(Ordering::CUSTOM, symbolicGraph), runtime_error);
 }
 
+/* ************************************************************************* */
+TEST(Ordering, AutoSelect) {
+  // A small chain falls well below the METIS thresholds, so the heuristic
+  // must pick COLAMD, and the selected type must be usable with Create
+  SymbolicFactorGraph symbolicGraph = example::symbolicChain();
+  Ordering::OrderingType selected = Ordering::AutoSelect(symbolicGraph);
+  EXPECT(selected == Ordering::COLAMD);
+  Ordering ordering = Ordering::Create(selected, symbolicGraph);
+  LONGS_EQUAL(6, (long)ordering.size());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -51,6 +51,50 @@ TEST(VariableSlots, constructor) {
   CHECK(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(VariableSlots, unsorted_keys) {
+
+  // The factors above all have ascending keys and take the hinted-insert
+  // fast path; unsorted factors must fall back and produce the same answer.
+  SymbolicFactorGraph fg;
+  fg.push_factor(3, 2);
+  fg.push_factor(1, 0);
+  fg.push_factor(0, 2);
+  fg.push_factor(9, 5);
+
+  VariableSlots actual(fg);
+
+  static const size_t none = numeric_limits<size_t>::max();
+  VariableSlots expected((SymbolicFactorGraph()));
+  expected[0] += none, 1, 0, none;
+  expected[1] += none, 0, none, none;
+  expected[2] += 1, none, 1, none;
+  expected[3] += 0, none, none, none;
+  expected[5] += none, none, none, 1;
+  expected[9] += none, none, none, 0;
+
+  CHECK(assert_equal(expected, actual));
+}
+
+/* ************************************************************************* */
+TEST(VariableSlots, sorted_find) {
+
+  SymbolicFactor sorted(0, 2, 4);
+  CHECK(sorted.sortedKeys());
+  LONGS_EQUAL(1, sorted.find(2) - sorted.begin());
+  CHECK(sorted.find(3) == sorted.end());
+
+  SymbolicFactor unsorted(4, 0, 2);
+  CHECK(!unsorted.sortedKeys());
+  LONGS_EQUAL(2, unsorted.find(2) - unsorted.begin());
+  CHECK(unsorted.find(3) == unsorted.end());
+
+  // Handing out mutable keys invalidates the cached flag
+  std::sort(unsorted.keys().begin(), unsorted.keys().end());
+  CHECK(unsorted.sortedKeys());
+  LONGS_EQUAL(1, unsorted.find(2) - unsorted.begin());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
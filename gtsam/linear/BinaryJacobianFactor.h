@@ -50,6 +50,17 @@ struct BinaryJacobianFactor: JacobianFactor {
   // Fixed-size matrix update
   void updateHessian(const KeyVector& infoKeys,
       SymmetricBlockMatrix* info) const {
+    // First build an array of slots, then apply indexed updates
+    std::vector<DenseIndex> slots(3);
+    slots[0] = Slot(infoKeys, key1());
+    slots[1] = Slot(infoKeys, key2());
+    slots[2] = info->nBlocks() - 1;
+    updateHessian(infoKeys, slots, info);
+  }
+
+  // Fixed-size matrix update with precomputed destination slots
+  void updateHessian(const KeyVector& infoKeys,
+      const std::vector<DenseIndex>& slots, SymmetricBlockMatrix* info) const {
     gttic(updateHessian_BinaryJacobianFactor);
     // Whiten the factor if it has a noise model
     const SharedDiagonal& model = get_model();
@@ -60,12 +71,11 @@ struct BinaryJacobianFactor: JacobianFactor {
                 "constrained noise model");
       BinaryJacobianFactor whitenedFactor(key1(), model->Whiten(getA(begin())),
           key2(), model->Whiten(getA(end())), model->whiten(getb()));
-      whitenedFactor.updateHessian(infoKeys, info);
+      whitenedFactor.updateHessian(infoKeys, slots, info);
     } else {
-      // First build an array of slots
-      DenseIndex slot1 = Slot(infoKeys, key1());
-      DenseIndex slot2 = Slot(infoKeys, key2());
-      DenseIndex slotB = info->nBlocks() - 1;
+      const DenseIndex slot1 = slots[0];
+      const DenseIndex slot2 = slots[1];
+      const DenseIndex slotB = slots[2];
 
       const Matrix& Ab = Ab_.matrix();
       Eigen::Block<const Matrix, M, N1> A1(Ab, 0, 0);
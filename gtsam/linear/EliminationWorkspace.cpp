@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationWorkspace.cpp
+ * @brief   Per-thread pool of dense matrix buffers for elimination scratch space
+ * @author  Richard Roberts
+ * @date    Nov 5, 2010
+ */
+
+#include <gtsam/linear/EliminationWorkspace.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastVector.h>
+
+#include <utility>
+
+namespace gtsam {
+
+namespace {
+
+// Keep at most this many bytes of recycled buffers per thread
+static const size_t maxPoolBytes = 32 * 1024 * 1024;
+
+// Set once the thread's pool has been destroyed.  Statically allocated
+// factors are destroyed after the pool at program exit, and their buffers
+// must then be freed normally instead of returned to the dead pool.  The
+// flag is a trivially destructible thread_local, so it outlives the pool.
+thread_local bool poolDestroyed = false;
+
+struct Pool {
+  typedef std::pair<DenseIndex, DenseIndex> Dims;
+  FastMap<Dims, FastVector<Matrix> > buffers;
+  size_t totalBytes;
+  Pool() : totalBytes(0) {}
+  ~Pool() { poolDestroyed = true; }
+};
+
+Pool& threadPool() {
+  static thread_local Pool pool;
+  return pool;
+}
+
+inline size_t bytesOf(const Matrix& matrix) {
+  return sizeof(double) * static_cast<size_t>(matrix.size());
+}
+
+} // anonymous namespace
+
+/* ************************************************************************* */
+Matrix EliminationWorkspace::Acquire(DenseIndex rows, DenseIndex cols) {
+  if (poolDestroyed)
+    return Matrix(rows, cols);
+  Pool& pool = threadPool();
+  FastMap<Pool::Dims, FastVector<Matrix> >::iterator item = pool.buffers.find(
+      std::make_pair(rows, cols));
+  if (item != pool.buffers.end() && !item->second.empty()) {
+    Matrix matrix = std::move(item->second.back());
+    item->second.pop_back();
+    pool.totalBytes -= bytesOf(matrix);
+    return matrix;
+  }
+  return Matrix(rows, cols);
+}
+
+/* ************************************************************************* */
+void EliminationWorkspace::Release(Matrix&& matrix) {
+  const size_t bytes = bytesOf(matrix);
+  if (bytes == 0 || poolDestroyed)
+    return;
+  Pool& pool = threadPool();
+  if (pool.totalBytes + bytes > maxPoolBytes)
+    return; // Pool is full - let the buffer be freed normally
+  pool.buffers[std::make_pair(matrix.rows(), matrix.cols())].push_back(
+      std::move(matrix));
+  pool.totalBytes += bytes;
+}
+
+/* ************************************************************************* */
+void EliminationWorkspace::Clear() {
+  if (poolDestroyed)
+    return;
+  Pool& pool = threadPool();
+  pool.buffers.clear();
+  pool.totalBytes = 0;
+}
+
+} // namespace gtsam
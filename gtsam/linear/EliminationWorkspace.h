@@ -0,0 +1,54 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationWorkspace.h
+ * @brief   Per-thread pool of dense matrix buffers for elimination scratch space
+ * @author  Richard Roberts
+ * @date    Nov 5, 2010
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/global_includes.h>
+
+namespace gtsam {
+
+  /**
+   * EliminationWorkspace maintains a per-thread pool of dense matrix buffers keyed by their
+   * dimensions.  Dense elimination (EliminateCholesky / EliminateQR) allocates a fresh scratch
+   * matrix for every clique; in a multifrontal solve most cliques share a small set of block
+   * dimensions, so recycling buffers through this pool removes most of the malloc/free churn
+   * inside the solve.  Each thread owns its own pool, so borrowing and returning buffers
+   * requires no locking.
+   * @addtogroup linear
+   */
+  class GTSAM_EXPORT EliminationWorkspace {
+  public:
+
+    /** Borrow a buffer with exactly the requested dimensions from the calling thread's pool, or
+     *  allocate a fresh one if no matching buffer is available.  In either case the contents of
+     *  the returned matrix are uninitialized. */
+    static Matrix Acquire(DenseIndex rows, DenseIndex cols);
+
+    /** Return a no-longer-needed buffer to the calling thread's pool.  Once the pool exceeds its
+     *  memory cap the buffer is simply freed, so this is always safe to call. */
+    static void Release(Matrix&& matrix);
+
+    /// Free all buffers held by the calling thread's pool
+    static void Clear();
+
+  private:
+    EliminationWorkspace() {} // Not instantiable - static methods only
+  };
+
+}
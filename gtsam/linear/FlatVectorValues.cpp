@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.cpp
+ * @brief   Contiguous-storage variant of VectorValues for uniform-dimension problems
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  FlatVectorValues::FlatVectorValues(const KeyVector& keys, DenseIndex dim) :
+      keys_(keys), dim_(dim) {
+    std::sort(keys_.begin(), keys_.end());
+    for (size_t i = 0; i < keys_.size(); ++i)
+      slots_.insert(make_pair(keys_[i], (DenseIndex)i));
+    if (slots_.size() != keys_.size())
+      throw invalid_argument("FlatVectorValues constructed with duplicate keys");
+    flat_ = Vector::Zero(dim_ * keys_.size());
+  }
+
+  /* ************************************************************************* */
+  boost::optional<FlatVectorValues> FlatVectorValues::TryFlatten(
+      const VectorValues& values) {
+    if (values.size() == 0)
+      return boost::none;
+
+    // Check for uniform dimension
+    const DenseIndex dim = values.begin()->second.size();
+    for (const VectorValues::value_type& keyValue : values)
+      if (keyValue.second.size() != dim)
+        return boost::none;
+
+    // Build the contiguous representation
+    FlatVectorValues result;
+    result.dim_ = dim;
+    result.keys_.reserve(values.size());
+    for (const VectorValues::value_type& keyValue : values)
+      result.keys_.push_back(keyValue.first);
+    std::sort(result.keys_.begin(), result.keys_.end());
+    result.flat_.resize(dim * values.size());
+    for (size_t i = 0; i < result.keys_.size(); ++i) {
+      result.slots_.insert(make_pair(result.keys_[i], (DenseIndex)i));
+      result.flat_.segment(dim * i, dim) = values[result.keys_[i]];
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  VectorValues FlatVectorValues::unflatten() const {
+    VectorValues result;
+    for (size_t i = 0; i < keys_.size(); ++i)
+      result.insert(keys_[i], flat_.segment(dim_ * i, dim_));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  SubVector FlatVectorValues::at(Key j) {
+    FastMap<Key, DenseIndex>::const_iterator item = slots_.find(j);
+    if (item == slots_.end())
+      throw out_of_range(
+          "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this FlatVectorValues.");
+    return flat_.segment(dim_ * item->second, dim_);
+  }
+
+  /* ************************************************************************* */
+  ConstSubVector FlatVectorValues::at(Key j) const {
+    FastMap<Key, DenseIndex>::const_iterator item = slots_.find(j);
+    if (item == slots_.end())
+      throw out_of_range(
+          "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this FlatVectorValues.");
+    return flat_.segment(dim_ * item->second, dim_);
+  }
+
+  /* ************************************************************************* */
+  void FlatVectorValues::print(const string& str, const KeyFormatter& formatter) const {
+    cout << str << ": " << size() << " elements of dimension " << dim_ << "\n";
+    for (size_t i = 0; i < keys_.size(); ++i)
+      cout << "  " << formatter(keys_[i]) << ": "
+           << flat_.segment(dim_ * i, dim_).transpose() << "\n";
+    cout.flush();
+  }
+
+  /* ************************************************************************* */
+  bool FlatVectorValues::equals(const FlatVectorValues& x, double tol) const {
+    return dim_ == x.dim_ && keys_ == x.keys_
+        && equal_with_abs_tol(flat_, x.flat_, tol);
+  }
+
+  /* ************************************************************************* */
+  void FlatVectorValues::checkCompatible(const FlatVectorValues& other,
+      const char* where) const {
+    if (dim_ != other.dim_ || keys_ != other.keys_)
+      throw invalid_argument(
+          string(where) + " called with a FlatVectorValues of different structure");
+  }
+
+  /* ************************************************************************* */
+  double FlatVectorValues::dot(const FlatVectorValues& v) const {
+    checkCompatible(v, "FlatVectorValues::dot");
+    return flat_.dot(v.flat_);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues FlatVectorValues::operator+(const FlatVectorValues& c) const {
+    checkCompatible(c, "FlatVectorValues::operator+");
+    FlatVectorValues result(*this);
+    result.flat_ += c.flat_;
+    return result;
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues& FlatVectorValues::operator+=(const FlatVectorValues& c) {
+    checkCompatible(c, "FlatVectorValues::operator+=");
+    flat_ += c.flat_;
+    return *this;
+  }
+
+} // \namespace gtsam
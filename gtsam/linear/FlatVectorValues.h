@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.h
+ * @brief   Contiguous-storage variant of VectorValues for uniform-dimension problems
+ * @author  Richard Roberts
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/FastMap.h>
+
+#include <boost/optional.hpp>
+
+namespace gtsam {
+
+  /**
+   * FlatVectorValues stores the values of a VectorValues whose variables all share the same
+   * dimension in one contiguous Vector, with a key-to-slot index on the side.  The hot
+   * element-wise operations used by iterative solvers - dot(), operator+(), operator+=() -
+   * then run as single flat BLAS-style passes over the concatenated storage, instead of
+   * chasing a map node per variable as VectorValues must.
+   *
+   * Use TryFlatten() to select this representation automatically: it returns the compressed
+   * form when every variable has the same dimension (the common case for pose-graph problems),
+   * and none otherwise, in which case callers fall back to the general VectorValues.
+   * unflatten() converts back.
+   * @addtogroup linear
+   */
+  class GTSAM_EXPORT FlatVectorValues {
+  protected:
+    Vector flat_;                    ///< All values, concatenated in key order
+    KeyVector keys_;                 ///< Sorted keys; slot i occupies segment(i*dim, dim)
+    FastMap<Key, DenseIndex> slots_; ///< Key to slot index, for random access only
+    DenseIndex dim_;                 ///< The uniform dimension of every variable
+
+  public:
+    /** Default constructor creates an empty FlatVectorValues */
+    FlatVectorValues() : dim_(0) {}
+
+    /** Construct zero-valued storage for the given keys, each of dimension \c dim.  The keys
+     *  are sorted to fix the storage order. */
+    FlatVectorValues(const KeyVector& keys, DenseIndex dim);
+
+    /** Flatten \c values if all of its variables have the same dimension, otherwise return
+     *  none so the caller can fall back to the general map-based representation. */
+    static boost::optional<FlatVectorValues> TryFlatten(const VectorValues& values);
+
+    /** Convert back to a general VectorValues */
+    VectorValues unflatten() const;
+
+    /// @name Standard interface
+    /// @{
+
+    /** Number of variables stored */
+    size_t size() const { return keys_.size(); }
+
+    /** The uniform dimension of every variable */
+    DenseIndex dim() const { return dim_; }
+
+    /** Check whether a variable with key \c j exists */
+    bool exists(Key j) const { return slots_.find(j) != slots_.end(); }
+
+    /** Read/write access to the vector for key \c j, throws std::out_of_range if \c j does
+     *  not exist. */
+    SubVector at(Key j);
+
+    /** Access the vector for key \c j, throws std::out_of_range if \c j does not exist. */
+    ConstSubVector at(Key j) const;
+
+    /** The keys in storage order */
+    const KeyVector& keys() const { return keys_; }
+
+    /** The concatenated storage */
+    const Vector& vector() const { return flat_; }
+
+    /** The concatenated storage (non-const version) */
+    Vector& vector() { return flat_; }
+
+    /// @}
+    /// @name Testable
+    /// @{
+
+    /** print required by Testable for unit testing */
+    void print(const std::string& str = "FlatVectorValues",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /** equals required by Testable for unit testing */
+    bool equals(const FlatVectorValues& x, double tol = 1e-9) const;
+
+    /// @}
+    /// @name Vector operations
+    /// @{
+
+    /** Dot product with another FlatVectorValues of identical structure - a single contiguous
+     *  pass over the storage. */
+    double dot(const FlatVectorValues& v) const;
+
+    /** Vector L2 norm */
+    double norm() const { return flat_.norm(); }
+
+    /** Squared vector L2 norm */
+    double squaredNorm() const { return flat_.squaredNorm(); }
+
+    /** Element-wise addition, both FlatVectorValues must have identical structure */
+    FlatVectorValues operator+(const FlatVectorValues& c) const;
+
+    /** Element-wise addition in place, both FlatVectorValues must have identical structure */
+    FlatVectorValues& operator+=(const FlatVectorValues& c);
+
+    /// @}
+
+  private:
+    /// Throw if \c other does not share our structure
+    void checkCompatible(const FlatVectorValues& other, const char* where) const;
+  };
+
+  /// traits
+  template<>
+  struct traits<FlatVectorValues> : public Testable<FlatVectorValues> {
+  };
+
+} // \namespace gtsam
@@ -22,6 +22,11 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 using namespace gtsam;
 
@@ -57,6 +62,144 @@ namespace gtsam {
     return soln;
   }
 
+  /* ************************************************************************* */
+  GaussianBayesNet::SolvePlan GaussianBayesNet::compileSolvePlan() const {
+    SolvePlan plan;
+
+    // Pass 1: assign a flat offset to every frontal variable, in solve order,
+    // and count the packed storage.  This is the only place keys are mapped;
+    // the compiled plan works purely with offsets.
+    FastMap<Key, pair<DenseIndex, DenseIndex> > slots;
+    DenseIndex nrDoubles = 0;
+    for (auto cg : boost::adaptors::reverse(*this)) {
+      cg->restoreStorage();  // in case the storage is compressed
+      DenseIndex frontalDim = 0;
+      for (auto it = cg->beginFrontals(); it != cg->endFrontals(); ++it) {
+        const DenseIndex dim = cg->getDim(it);
+        slots.insert(make_pair(*it, make_pair(plan.totalDim_, dim)));
+        SolvePlan::Variable variable;
+        variable.key = *it;
+        variable.offset = plan.totalDim_;
+        variable.dim = dim;
+        plan.variables_.push_back(variable);
+        plan.totalDim_ += dim;
+        frontalDim += dim;
+      }
+      DenseIndex parentDim = 0;
+      for (auto it = cg->beginParents(); it != cg->endParents(); ++it)
+        parentDim += cg->getDim(it);
+      nrDoubles += frontalDim * (frontalDim + parentDim + 1);
+    }
+    plan.storage_.resize(nrDoubles);
+
+    // Pass 2: pack the R, S and d blocks contiguously in solve order, and
+    // level-schedule as we go: a step's level is one past the deepest level
+    // among the steps that solve its parents, so all steps on one level are
+    // independent and can be solved in parallel
+    FastMap<DenseIndex, size_t> levelOfVariable;  // by flat offset
+    DenseIndex pos = 0;
+    for (auto cg : boost::adaptors::reverse(*this)) {
+      SolvePlan::Step step;
+      step.frontKey = cg->keys().front();
+      step.xOffset = slots.at(step.frontKey).first;
+      step.dim = 0;
+      for (auto it = cg->beginFrontals(); it != cg->endFrontals(); ++it)
+        step.dim += cg->getDim(it);
+
+      step.rOffset = pos;
+      Eigen::Map<Matrix>(plan.storage_.data() + pos, step.dim, step.dim) =
+          cg->R();
+      pos += step.dim * step.dim;
+
+      for (auto it = cg->beginParents(); it != cg->endParents(); ++it) {
+        const auto slot = slots.find(*it);
+        if (slot == slots.end())
+          throw std::invalid_argument(
+              "GaussianBayesNet::compileSolvePlan: incomplete Bayes net, "
+              "parent variable is not a frontal variable of any conditional");
+        SolvePlan::ParentBlock parent;
+        parent.sOffset = pos;
+        parent.xOffset = slot->second.first;
+        parent.dim = slot->second.second;
+        Eigen::Map<Matrix>(plan.storage_.data() + pos, step.dim, parent.dim) =
+            cg->getA(it);
+        pos += step.dim * parent.dim;
+        step.parents.push_back(parent);
+      }
+
+      step.dOffset = pos;
+      Eigen::Map<Vector>(plan.storage_.data() + pos, step.dim) = cg->d();
+      pos += step.dim;
+
+      size_t level = 0;
+      for (const SolvePlan::ParentBlock& parent : step.parents)
+        level = std::max(level, levelOfVariable.at(parent.xOffset) + 1);
+      for (auto it = cg->beginFrontals(); it != cg->endFrontals(); ++it)
+        levelOfVariable[slots.at(*it).first] = level;
+      if (level >= plan.levels_.size())
+        plan.levels_.resize(level + 1);
+      plan.levels_[level].push_back(plan.steps_.size());
+
+      plan.steps_.push_back(step);
+    }
+
+    return plan;
+  }
+
+  /* ************************************************************************* */
+  void GaussianBayesNet::SolvePlan::solveStep(const Step& step,
+                                              Vector& x) const {
+    const double* data = storage_.data();
+    Vector rhs = Eigen::Map<const Vector>(data + step.dOffset, step.dim);
+    for (const ParentBlock& parent : step.parents)
+      rhs.noalias() -=
+          Eigen::Map<const Matrix>(data + parent.sOffset, step.dim,
+                                   parent.dim) *
+          x.segment(parent.xOffset, parent.dim);
+    x.segment(step.xOffset, step.dim) =
+        Eigen::Map<const Matrix>(data + step.rOffset, step.dim, step.dim)
+            .triangularView<Eigen::Upper>()
+            .solve(rhs);
+
+    // Check for indeterminant solution
+    if (x.segment(step.xOffset, step.dim).hasNaN())
+      throw IndeterminantLinearSystemException(step.frontKey);
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianBayesNet::SolvePlan::optimize() const {
+    Vector x(totalDim_);
+
+#ifdef GTSAM_USE_TBB
+    // Level-scheduled sweep: all steps on one level only read solution
+    // segments written by earlier levels and write disjoint segments of x,
+    // so each level is a parallel_for.  Singleton levels skip the scheduler.
+    for (const std::vector<size_t>& level : levels_) {
+      if (level.size() == 1) {
+        solveStep(steps_[level.front()], x);
+      } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, level.size()),
+            [this, &level, &x](const tbb::blocked_range<size_t>& range) {
+              for (size_t i = range.begin(); i != range.end(); ++i)
+                solveStep(steps_[level[i]], x);
+            });
+      }
+    }
+#else
+    // One linear sweep: the steps are stored parents-first and their blocks
+    // are packed in the same order, so both the plan and its storage are
+    // traversed sequentially
+    for (const Step& step : steps_)
+      solveStep(step, x);
+#endif
+
+    // Emit the flat solution as a VectorValues
+    VectorValues result;
+    for (const Variable& variable : variables_)
+      result.emplace(variable.key, x.segment(variable.offset, variable.dim));
+    return result;
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianBayesNet::optimizeGradientSearch() const
   {
@@ -92,6 +235,18 @@ namespace gtsam {
   }
 
 
+  /* ************************************************************************* */
+  FastMap<Key, Matrix> GaussianBayesNet::backSubstitute(
+      const FastMap<Key, Matrix>& gx) const
+  {
+    FastMap<Key, Matrix> result;
+    for (auto cg: boost::adaptors::reverse(*this)) {
+      const FastMap<Key, Matrix> solved = cg->solveOtherRHS(result, gx);
+      result.insert(solved.begin(), solved.end());
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   // gy=inv(L)*gx by solving L*gy=gx.
   // gy=inv(R'*inv(Sigma))*gx
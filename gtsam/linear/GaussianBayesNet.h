@@ -74,6 +74,80 @@ namespace gtsam {
     /// Version of optimize for incomplete BayesNet, needs solution for missing variables
     VectorValues optimize(const VectorValues& solutionForMissing) const;
 
+    /**
+     * A back-substitution plan compiled from a complete Bayes net: all R, S
+     * and d blocks are packed into one contiguous buffer in solve order and
+     * every right-hand-side offset is precomputed, so optimize() runs as a
+     * single linear sweep over that buffer with no per-variable map lookups.
+     * Compile once after elimination with compileSolvePlan() and reuse as
+     * long as the conditionals are unchanged.
+     *
+     * Compilation also level-schedules the solve: every conditional is
+     * assigned the smallest level on which all its parents are already
+     * solved, so conditionals within one level are independent.  When GTSAM
+     * is built with TBB, optimize() solves each level's conditionals in
+     * parallel; otherwise it falls back to the sequential sweep.
+     */
+    class GTSAM_EXPORT SolvePlan {
+     public:
+      /// Solve the compiled system, same result as GaussianBayesNet::optimize()
+      VectorValues optimize() const;
+
+      /// Total dimension of the compiled system
+      DenseIndex dim() const { return totalDim_; }
+
+      /// Number of compiled conditionals
+      size_t size() const { return steps_.size(); }
+
+      /// Number of dependency levels; a chain has size() levels, a wide
+      /// Bayes net has few levels with many independent conditionals each
+      size_t numLevels() const { return levels_.size(); }
+
+     private:
+      friend class GaussianBayesNet;
+      SolvePlan() : totalDim_(0) {}
+
+      /// One parent contribution to a step's right-hand side
+      struct ParentBlock {
+        DenseIndex sOffset;  ///< packed S block in storage_
+        DenseIndex xOffset;  ///< parent slice in the flat solution vector
+        DenseIndex dim;      ///< parent column dimension
+      };
+
+      /// One conditional, stored in solve order (parents before children)
+      struct Step {
+        DenseIndex rOffset;  ///< packed R block in storage_
+        DenseIndex dOffset;  ///< packed d vector in storage_
+        DenseIndex xOffset;  ///< frontal slice in the flat solution vector
+        DenseIndex dim;      ///< total frontal dimension
+        Key frontKey;        ///< first frontal key, for error reporting
+        std::vector<ParentBlock> parents;
+      };
+
+      /// Where one variable lives in the flat solution vector
+      struct Variable {
+        Key key;
+        DenseIndex offset;
+        DenseIndex dim;
+      };
+
+      /// Solve one step into the flat solution vector x
+      void solveStep(const Step& step, Vector& x) const;
+
+      std::vector<Step> steps_;        ///< conditionals, in solve order
+      std::vector<Variable> variables_;///< all frontal variables
+      std::vector<std::vector<size_t> > levels_; ///< step indices per dependency level
+      Vector storage_;                 ///< packed R, S and d blocks
+      DenseIndex totalDim_;            ///< dimension of the solution vector
+    };
+
+    /**
+     * Compile this Bayes net into a SolvePlan.  The Bayes net must be
+     * complete (every parent is a frontal variable of a later-eliminated
+     * conditional), otherwise std::invalid_argument is thrown.
+     */
+    SolvePlan compileSolvePlan() const;
+
     /**
      * Return ordering corresponding to a topological sort.
      * There are many topological sorts of a Bayes net. This one
@@ -169,6 +243,14 @@ namespace gtsam {
      */
     VectorValues backSubstitute(const VectorValues& gx) const;
 
+    /**
+     * Multiple right-hand-side version of backSubstitute.  The k^th columns
+     * of the matrices in \c gx form one right-hand side; all columns are
+     * backsolved against the single triangular factorization, equivalent to
+     * (but much cheaper than) calling backSubstitute once per column.
+     */
+    FastMap<Key, Matrix> backSubstitute(const FastMap<Key, Matrix>& gx) const;
+
     /**
      * Transpose backsubstitute with a different RHS vector than the one stored in this BayesNet.
      * gy=inv(L)*gx by solving L*gy=gx.
@@ -24,6 +24,8 @@
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/VectorValues.h>
+#include <set>
+#include <stdexcept>
 
 namespace gtsam {
 
@@ -58,6 +60,75 @@ namespace gtsam {
     return internal::linearAlgorithms::optimizeBayesTree(*this);
   }
 
+  /* ************************************************************************* */
+  VectorValues GaussianBayesTree::backSubstituteSparse(const VectorValues& rhs) const
+  {
+    gttic(GaussianBayesTree_backSubstituteSparse);
+
+    // Mark the cliques that hold right-hand-side entries, plus every ancestor
+    // on their path to a root, so the traversal below can skip whole branches
+    // whose solution stays identically zero.
+    std::set<const GaussianBayesTreeClique*> marked, onPath;
+    for (const VectorValues::value_type& entry : rhs) {
+      Nodes::const_iterator node = nodes().find(entry.first);
+      if (node == nodes().end())
+        throw std::invalid_argument(
+            "GaussianBayesTree::backSubstituteSparse: rhs contains a key that "
+            "is not in the tree");
+      marked.insert(node->second.get());
+      for (sharedClique ancestor = node->second;
+          ancestor && onPath.insert(ancestor.get()).second;
+          ancestor = ancestor->parent()) {}
+    }
+
+    // Pre-order traversal.  A clique is solved once its own right-hand side
+    // or its separator is nonzero; cliques that are merely on the path to a
+    // marked descendant have an all-zero solution and are only descended
+    // through; everything else keeps a zero solution and is never visited.
+    VectorValues delta;
+    std::vector<std::pair<const GaussianBayesTreeClique*, bool> > stack;
+    for (const sharedClique& root : roots())
+      stack.push_back(std::make_pair(root.get(), false));
+    while (!stack.empty()) {
+      const GaussianBayesTreeClique* clique = stack.back().first;
+      const bool separatorNonzero = stack.back().second;
+      stack.pop_back();
+      if (!separatorNonzero && !onPath.count(clique))
+        continue;
+
+      const bool solve = separatorNonzero || marked.count(clique);
+      if (solve) {
+        const GaussianConditional& conditional = *clique->conditional();
+
+        // Assemble the separator solution and the frontal right-hand side,
+        // filling in zeros for entries the sparse inputs do not carry
+        VectorValues parents, frontalRhs;
+        for (GaussianConditional::const_iterator it = conditional.beginParents();
+            it != conditional.endParents(); ++it) {
+          if (delta.exists(*it))
+            parents.emplace(*it, delta.at(*it));
+          else
+            parents.emplace(*it, Vector::Zero(conditional.getDim(it)));
+        }
+        for (GaussianConditional::const_iterator it = conditional.beginFrontals();
+            it != conditional.endFrontals(); ++it) {
+          if (rhs.exists(*it))
+            frontalRhs.emplace(*it, rhs.at(*it));
+          else
+            frontalRhs.emplace(*it, Vector::Zero(conditional.getDim(it)));
+        }
+
+        delta.insert(conditional.solveOtherRHS(parents, frontalRhs));
+      }
+
+      // Once a clique is solved its frontals feed the children's separators,
+      // so the whole subtree below it participates
+      for (const sharedClique& child : clique->children)
+        stack.push_back(std::make_pair(child.get(), solve));
+    }
+    return delta;
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianBayesTree::optimizeGradientSearch() const
   {
@@ -104,6 +175,124 @@ namespace gtsam {
     return marginalFactor(key)->information().inverse();
   }
 
+  /* ************************************************************************* */
+  FastMap<Key, Matrix> GaussianBayesTree::selectedInverse() const
+  {
+    gttic(GaussianBayesTree_selectedInverse);
+
+    // Joint covariance of one clique over (frontals, separator), kept only
+    // while descendants still read their separator blocks out of it
+    struct CliqueCovariance {
+      Matrix joint;
+      FastMap<Key, std::pair<DenseIndex, DenseIndex> > slots; // offset, dim
+    };
+    FastMap<const GaussianBayesTreeClique*, CliqueCovariance> cliqueCovs;
+
+    FastMap<Key, Matrix> result;
+
+    // Pre-order traversal with an explicit unwind marker, so a clique's
+    // joint covariance is dropped as soon as its subtree is finished and the
+    // working set stays proportional to the tree depth
+    std::vector<std::pair<const GaussianBayesTreeClique*, bool> > stack;
+    for (const sharedClique& root : roots())
+      stack.push_back(std::make_pair(root.get(), false));
+    while (!stack.empty()) {
+      const GaussianBayesTreeClique* clique = stack.back().first;
+      const bool unwind = stack.back().second;
+      stack.pop_back();
+      if (unwind) {
+        cliqueCovs.erase(clique);
+        continue;
+      }
+
+      const GaussianConditional& conditional = *clique->conditional();
+      conditional.restoreStorage();
+
+      // Lay out this clique's joint: frontals first, then separator
+      CliqueCovariance cov;
+      DenseIndex offset = 0;
+      for (GaussianConditional::const_iterator it = conditional.beginFrontals();
+          it != conditional.endFrontals(); ++it) {
+        cov.slots.insert(std::make_pair(*it,
+            std::make_pair(offset, conditional.getDim(it))));
+        offset += conditional.getDim(it);
+      }
+      const DenseIndex frontalDim = offset;
+      for (GaussianConditional::const_iterator it = conditional.beginParents();
+          it != conditional.endParents(); ++it) {
+        cov.slots.insert(std::make_pair(*it,
+            std::make_pair(offset, conditional.getDim(it))));
+        offset += conditional.getDim(it);
+      }
+      const DenseIndex separatorDim = offset - frontalDim;
+      cov.joint = Matrix(offset, offset);
+
+      // Copy the separator covariance out of the parent's joint; the Bayes
+      // tree property guarantees the separator is contained in the parent
+      // clique, so all blocks are available there
+      if (separatorDim > 0) {
+        const CliqueCovariance& parentCov =
+            cliqueCovs.at(clique->parent().get());
+        for (GaussianConditional::const_iterator itI = conditional.beginParents();
+            itI != conditional.endParents(); ++itI) {
+          const std::pair<DenseIndex, DenseIndex> slotI = cov.slots.at(*itI);
+          const std::pair<DenseIndex, DenseIndex> parentI = parentCov.slots.at(*itI);
+          for (GaussianConditional::const_iterator itJ = conditional.beginParents();
+              itJ != conditional.endParents(); ++itJ) {
+            const std::pair<DenseIndex, DenseIndex> slotJ = cov.slots.at(*itJ);
+            const std::pair<DenseIndex, DenseIndex> parentJ = parentCov.slots.at(*itJ);
+            cov.joint.block(slotI.first, slotJ.first, slotI.second, slotJ.second) =
+                parentCov.joint.block(parentI.first, parentJ.first,
+                    slotI.second, slotJ.second);
+          }
+        }
+      }
+
+      // Extend to the frontal variables through the conditional:
+      //   x_F = R^{-1} (d - S x_S) + R^{-1} e,  e ~ N(0, Sigma_noise)
+      // hence with A = R^{-1} S:
+      //   Sigma_FF = A Sigma_SS A' + R^{-1} Sigma_noise R^{-T}
+      //   Sigma_FS = -A Sigma_SS
+      const Matrix invR = conditional.R().triangularView<Eigen::Upper>().solve(
+          Matrix::Identity(frontalDim, frontalDim));
+      Matrix noiseCov;
+      if (conditional.get_model())
+        noiseCov = invR *
+            conditional.get_model()->sigmas().array().square().matrix().asDiagonal() *
+            invR.transpose();
+      else
+        noiseCov = invR * invR.transpose();
+      if (separatorDim > 0) {
+        const Matrix A = invR * conditional.S();
+        const Matrix ASigmaSS = A *
+            cov.joint.block(frontalDim, frontalDim, separatorDim, separatorDim);
+        cov.joint.block(0, 0, frontalDim, frontalDim).noalias() =
+            ASigmaSS * A.transpose() + noiseCov;
+        cov.joint.block(0, frontalDim, frontalDim, separatorDim) = -ASigmaSS;
+        cov.joint.block(frontalDim, 0, separatorDim, frontalDim) =
+            -ASigmaSS.transpose();
+      } else {
+        cov.joint = noiseCov;
+      }
+
+      // Every variable is frontal in exactly one clique, so emitting the
+      // frontal diagonal blocks here covers the whole tree in one pass
+      for (GaussianConditional::const_iterator it = conditional.beginFrontals();
+          it != conditional.endFrontals(); ++it) {
+        const std::pair<DenseIndex, DenseIndex> slot = cov.slots.at(*it);
+        result.insert(std::make_pair(*it,
+            cov.joint.block(slot.first, slot.first, slot.second, slot.second)));
+      }
+
+      cliqueCovs.insert(std::make_pair(clique, std::move(cov)));
+      stack.push_back(std::make_pair(clique, true));
+      for (const sharedClique& child : clique->children)
+        stack.push_back(std::make_pair(child.get(), false));
+    }
+
+    return result;
+  }
+
 
 } // \namespace gtsam
 
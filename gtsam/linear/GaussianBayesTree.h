@@ -23,6 +23,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/BayesTreeCliqueBase.h>
+#include <gtsam/base/FastMap.h>
 
 namespace gtsam {
 
@@ -65,6 +66,19 @@ namespace gtsam {
     /** Recursively optimize the BayesTree to produce a vector solution. */
     VectorValues optimize() const;
 
+    /**
+     * Back-substitute a sparse right-hand side, solving \f$ R \delta x = rhs \f$
+     * where entries missing from \c rhs are zero.  Only the cliques that can
+     * produce nonzero solution entries are visited: the cliques holding rhs
+     * entries and their subtrees are solved, ancestors on the path to a root
+     * are merely descended through, and untouched branches are skipped
+     * entirely.  The returned VectorValues likewise only contains the
+     * affected entries - absent variables have a zero solution - so solves
+     * for localized updates cost O(affected) rather than O(n).  Throws
+     * std::invalid_argument if \c rhs contains a key not in the tree.
+     */
+    VectorValues backSubstituteSparse(const VectorValues& rhs) const;
+
     /**
      * Optimize along the gradient direction, with a closed-form computation to perform the line
      * search.  The gradient is computed about \f$ \delta x=0 \f$.
@@ -126,6 +140,18 @@ namespace gtsam {
     /** Return the marginal on the requested variable as a covariance matrix.  See also
     *   marginalFactor(). */
     Matrix marginalCovariance(Key key) const;
+
+    /**
+     * Compute the marginal covariance block of EVERY variable in one
+     * top-down pass over the tree, a Takahashi-style selected inversion
+     * restricted to the clique sparsity pattern.  Each clique receives the
+     * covariance of its separator from its parent and extends it to its
+     * frontal variables through the clique conditional, so the whole map of
+     * marginals costs one tree sweep instead of a clique solve per key.
+     * The returned blocks equal marginalCovariance(key) for every key;
+     * off-diagonal (pairwise) covariance blocks are not computed.
+     */
+    FastMap<Key, Matrix> selectedInverse() const;
   };
 
   /// traits
@@ -30,6 +30,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <list>
 #include <string>
@@ -57,6 +59,7 @@ namespace gtsam {
 
   /* ************************************************************************* */
   void GaussianConditional::print(const string &s, const KeyFormatter& formatter) const {
+    restoreStorage();
     cout << s << "  Conditional density ";
     for (const_iterator it = beginFrontals(); it != endFrontals(); ++it) {
       cout << (boost::format("[%1%]")%(formatter(*it))).str() << " ";
@@ -76,7 +79,9 @@ namespace gtsam {
 
   /* ************************************************************************* */
   bool GaussianConditional::equals(const GaussianFactor& f, double tol) const {
+    restoreStorage();
     if (const GaussianConditional* c = dynamic_cast<const GaussianConditional*>(&f)) {
+      c->restoreStorage();
       // check if the size of the parents_ map is the same
       if (parents().size() != c->parents().size())
         return false;
@@ -116,6 +121,7 @@ namespace gtsam {
 
   /* ************************************************************************* */
   VectorValues GaussianConditional::solve(const VectorValues& x) const {
+    restoreStorage();
     // Concatenate all vector values that correspond to parent variables
     const Vector xS = x.vector(KeyVector(beginParents(), endParents()));
 
@@ -144,6 +150,7 @@ namespace gtsam {
   /* ************************************************************************* */
   VectorValues GaussianConditional::solveOtherRHS(
     const VectorValues& parents, const VectorValues& rhs) const {
+    restoreStorage();
     // Concatenate all vector values that correspond to parent variables
     Vector xS = parents.vector(KeyVector(beginParents(), endParents()));
 
@@ -169,8 +176,169 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  FastMap<Key, Matrix> GaussianConditional::solveOtherRHS(
+    const FastMap<Key, Matrix>& parents, const FastMap<Key, Matrix>& rhs) const {
+    restoreStorage();
+    // Number of right-hand-side columns, taken from the first frontal block
+    const DenseIndex nrhs = rhs.at(keys().front()).cols();
+
+    // Stack the parent solution columns to match the column layout of S
+    Matrix xS(S().cols(), nrhs);
+    DenseIndex rowPos = 0;
+    for (const_iterator it = beginParents(); it != endParents(); ++it) {
+      xS.middleRows(rowPos, getDim(it)) = parents.at(*it);
+      rowPos += getDim(it);
+    }
+
+    // Stack the right-hand-side columns to match the row layout of R
+    Matrix rhsR(R().rows(), nrhs);
+    rowPos = 0;
+    for (const_iterator frontal = beginFrontals(); frontal != endFrontals(); ++frontal) {
+      rhsR.middleRows(rowPos, getDim(frontal)) = rhs.at(*frontal);
+      rowPos += getDim(frontal);
+    }
+
+    // One triangular solve covers all columns at once
+    Matrix soln = R().triangularView<Eigen::Upper>().solve(Matrix(rhsR - S() * xS));
+
+    // Scale by sigmas
+    if (model_)
+      soln.array().colwise() *= model_->sigmas().array();
+
+    // Split the solution into per-frontal blocks
+    FastMap<Key, Matrix> result;
+    rowPos = 0;
+    for (const_iterator frontal = beginFrontals(); frontal != endFrontals(); ++frontal) {
+      result.emplace(*frontal, soln.middleRows(rowPos, getDim(frontal)));
+      rowPos += getDim(frontal);
+    }
+
+    return result;
+  }
+
+  /* ************************************************************************* */
+  // Relative diagonal floor below which up/downdates refuse to commit and the
+  // caller should re-eliminate the clique instead
+  static const double kUpdateConditionFloor = 1e-12;
+
+  /* ************************************************************************* */
+  bool GaussianConditional::updateCholesky(const Matrix& rows, Matrix* remaining) {
+    restoreStorage();
+    const DenseIndex n = Ab_.rows();
+    const DenseIndex m = Ab_.cols();
+    // Only a plain square upper-triangular factor can be rotated in place
+    if (model_ || R().cols() != n || rows.cols() != m)
+      return false;
+
+    // Work on a copy so a failed conditioning check leaves the factor intact
+    Matrix M = Ab_.range(0, Ab_.nBlocks());
+    if (remaining)
+      remaining->resize(rows.rows(), m - n);
+
+    Vector cs(n), sn(n);
+    for (DenseIndex k = 0; k < rows.rows(); ++k) {
+      Vector x = rows.row(k).transpose();
+      // Sweep the row into the triangle, one Givens rotation per pivot; the
+      // parent and rhs columns just keep absorbing the rotations
+      for (DenseIndex j = 0; j < m; ++j) {
+        const DenseIndex nrRotations = std::min(j, n);
+        for (DenseIndex i = 0; i < nrRotations; ++i) {
+          const double t = cs(i) * M(i, j) + sn(i) * x(j);
+          x(j) = cs(i) * x(j) - sn(i) * M(i, j);
+          M(i, j) = t;
+        }
+        if (j < n) {
+          // New rotation zeroing the row entry against the diagonal
+          const double r = std::hypot(M(j, j), x(j));
+          if (r > 0.0) {
+            cs(j) = M(j, j) / r;
+            sn(j) = x(j) / r;
+          } else {
+            cs(j) = 1.0;
+            sn(j) = 0.0;
+          }
+          M(j, j) = r;
+        } else if (remaining) {
+          // What is left of the row after n rotations is this row's message
+          // to the parent clique
+          (*remaining)(k, j - n) = x(j);
+        }
+      }
+    }
+
+    const double maxDiag = M.diagonal().head(n).maxCoeff();
+    const double minDiag = M.diagonal().head(n).minCoeff();
+    if (!(minDiag > kUpdateConditionFloor * maxDiag))
+      return false;
+
+    Ab_.range(0, Ab_.nBlocks()) = M;
+    return true;
+  }
+
+  /* ************************************************************************* */
+  bool GaussianConditional::downdateCholesky(const Matrix& rows) {
+    restoreStorage();
+    const DenseIndex n = Ab_.rows();
+    const DenseIndex m = Ab_.cols();
+    if (model_ || R().cols() != n || rows.cols() != m)
+      return false;
+
+    Matrix M = Ab_.range(0, Ab_.nBlocks());
+    Vector cs(n), sn(n);
+    for (DenseIndex k = 0; k < rows.rows(); ++k) {
+      const Vector x = rows.row(k).transpose();
+
+      // a = R^{-T} x_f; the downdated factor is positive definite only while
+      // |a| < 1, so this is where an over-downdated clique bows out
+      const Vector a = M.topLeftCorner(n, n).triangularView<Eigen::Upper>()
+          .transpose().solve(x.head(n));
+      double alpha = 1.0 - a.squaredNorm();
+      if (alpha <= kUpdateConditionFloor)
+        return false;
+      alpha = std::sqrt(alpha);
+
+      // Rotations reducing [a; alpha] to the last unit vector
+      for (DenseIndex i = n - 1; i >= 0; --i) {
+        const double r = std::hypot(alpha, a(i));
+        cs(i) = alpha / r;
+        sn(i) = a(i) / r;
+        alpha = r;
+      }
+
+      // Rotate the removed row back out of the triangle
+      for (DenseIndex j = 0; j < n; ++j) {
+        double xx = 0.0;
+        for (DenseIndex i = j; i >= 0; --i) {
+          const double t = cs(i) * xx + sn(i) * M(i, j);
+          M(i, j) = cs(i) * M(i, j) - sn(i) * xx;
+          xx = t;
+        }
+      }
+
+      // The parent and rhs columns additionally consume the removed row's
+      // own entries
+      for (DenseIndex j = n; j < m; ++j) {
+        double zeta = x(j);
+        for (DenseIndex i = 0; i < n; ++i) {
+          M(i, j) = (M(i, j) - sn(i) * zeta) / cs(i);
+          zeta = cs(i) * zeta - sn(i) * M(i, j);
+        }
+      }
+    }
+
+    const double maxDiag = M.diagonal().head(n).maxCoeff();
+    const double minDiag = M.diagonal().head(n).minCoeff();
+    if (!(minDiag > kUpdateConditionFloor * maxDiag))
+      return false;
+
+    Ab_.range(0, Ab_.nBlocks()) = M;
+    return true;
+  }
+
   /* ************************************************************************* */
   void GaussianConditional::solveTransposeInPlace(VectorValues& gy) const {
+    restoreStorage();
     Vector frontalVec = gy.vector(KeyVector(beginFrontals(), endFrontals()));
     frontalVec = R().transpose().triangularView<Eigen::Lower>().solve(frontalVec);
 
@@ -192,6 +360,31 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  size_t GaussianConditional::compressStorage() {
+    if (compressedStorage())
+      return 0;
+    Matrix& storage = Ab_.matrix();
+    if (storage.size() == 0)
+      return 0;
+    storage32_ = storage.cast<float>();
+    const size_t before = storage.size() * sizeof(double);
+    storage.resize(0, 0);
+    return before - storage32_.size() * sizeof(float);
+  }
+
+  /* ************************************************************************* */
+  void GaussianConditional::restoreStorage() const {
+    if (!compressedStorage())
+      return;
+    // The block structure in Ab_ is untouched by compression; only the dense
+    // storage is swapped out, so casting back restores a usable conditional.
+    // All further arithmetic accumulates in double again.
+    const_cast<GaussianConditional*>(this)->Ab_.matrix() =
+        storage32_.cast<double>();
+    storage32_.resize(0, 0);
+  }
+
   /* ************************************************************************* */
   void GaussianConditional::scaleFrontalsBySigma(VectorValues& gy) const {
     DenseIndex vectorPosition = 0;
@@ -22,6 +22,7 @@
 #include <boost/utility.hpp>
 
 #include <gtsam/global_includes.h>
+#include <gtsam/base/FastMap.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/inference/Conditional.h>
 #include <gtsam/linear/VectorValues.h>
@@ -122,12 +123,73 @@ namespace gtsam {
 
     VectorValues solveOtherRHS(const VectorValues& parents, const VectorValues& rhs) const;
 
+    /**
+     * Multiple right-hand-side version of solveOtherRHS.  The k^th columns of
+     * the matrices in \c parents and \c rhs together form one independent
+     * right-hand side; all columns are backsolved against the triangular
+     * factor in a single matrix solve instead of once per column.
+     * @param parents map from each parent key to its solved columns
+     * @param rhs map from each frontal key to its right-hand-side columns
+     * @return map from each frontal key to its solution columns
+     */
+    FastMap<Key, Matrix> solveOtherRHS(const FastMap<Key, Matrix>& parents,
+                                       const FastMap<Key, Matrix>& rhs) const;
+
+    /**
+     * Rank-k Givens update of the stored factorization: after the call the
+     * conditional represents the Cholesky factor of \f$ R^T R + A^T A \f$,
+     * where each row of \c rows spans the conditional's full augmented column
+     * layout - frontal columns, then parent columns, then the right-hand
+     * side.  Updating with the whitened rows of a factor newly added to this
+     * clique is algebraically identical to re-eliminating the clique with
+     * that factor included, at O(n k) cost per row instead of an O(n^3)
+     * refactorization.  Each row also leaves behind a remaining row over the
+     * parent columns and rhs; when \c remaining is given these are returned
+     * (k rows) so the caller can propagate the update to the parent clique.
+     *
+     * Returns false, leaving the conditional untouched, when the update
+     * cannot be applied safely: a non-unit noise model, a non-square R, or a
+     * result whose diagonal condition degrades past 1e-12 - re-eliminate the
+     * clique in that case.
+     */
+    bool updateCholesky(const Matrix& rows, Matrix* remaining = nullptr);
+
+    /**
+     * Rank-k Givens downdate, the exact inverse of updateCholesky: removes
+     * rows previously folded into the factorization, restoring the
+     * conditional to its state before the matching update.  Returns false,
+     * leaving the conditional
+     * untouched, when removing the rows would make the factor indefinite or
+     * degrade its diagonal condition past 1e-12 (e.g. after many accumulated
+     * up/downdates) - re-eliminate the clique in that case.
+     */
+    bool downdateCholesky(const Matrix& rows);
+
     /** Performs transpose backsubstition in place on values */
     void solveTransposeInPlace(VectorValues& gy) const;
 
     /** Scale the values in \c gy according to the sigmas for the frontal variables in this
      *  conditional. */
     void scaleFrontalsBySigma(VectorValues& gy) const;
+
+    /**
+     * Re-encode the dense [R S d] storage as float32 and release the double
+     * matrix, halving the conditional's resident memory.  The rounding is
+     * bounded by the float32 unit roundoff: each entry changes by at most a
+     * relative 2^-24 (~6e-8), so a subsequent backsubstitution solution x
+     * satisfies a relative error of order cond(R) * 6e-8.  The double matrix
+     * is rebuilt transparently (with double accumulation thereafter) by the
+     * next solve; callers reading R(), S() or d() directly while compressed
+     * must call restoreStorage() first.
+     * @return number of bytes released, net of the float32 image
+     */
+    size_t compressStorage();
+
+    /// Rebuild the double storage from the float32 image; no-op if not compressed
+    void restoreStorage() const;
+
+    /// Whether the dense storage is currently held as float32
+    bool compressedStorage() const { return storage32_.size() > 0; }
 //    __declspec(deprecated) void scaleFrontalsBySigma(VectorValues& gy) const; // FIXME: depreciated flag doesn't appear to exist?
 
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
@@ -141,10 +203,13 @@ namespace gtsam {
 #endif
 
    private:
+    mutable Eigen::MatrixXf storage32_; ///< Float32 image of Ab_, empty when uncompressed
+
     /** Serialization function */
     friend class boost::serialization::access;
     template<class Archive>
     void serialize(Archive & ar, const unsigned int /*version*/) {
+      restoreStorage(); // archives always hold the double storage
       ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(BaseFactor);
       ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(BaseConditional);
     }
@@ -114,6 +114,13 @@ namespace gtsam {
     /** Test whether the factor is empty */
     virtual bool empty() const = 0;
 
+    /** Approximate heap memory, in bytes, held by this factor.  The base
+     * version only counts the keys; JacobianFactor and HessianFactor add
+     * their matrix storage.  Used by BayesTree::memoryUsage. */
+    virtual size_t memoryUsage() const {
+      return keys_.capacity() * sizeof(Key);
+    }
+
     /**
      * Construct the corresponding anti-factor to negate information
      * stored stored in this factor.
@@ -129,6 +136,19 @@ namespace gtsam {
     virtual void updateHessian(const KeyVector& keys,
                            SymmetricBlockMatrix* info) const = 0;
 
+    /** Update an information matrix given precomputed destination slots, where \c slots[j] is
+     * the block of \c info receiving the j-th variable of this factor and \c slots[size()]
+     * the right-hand-side block.  During elimination the slots are resolved once per factor
+     * from the clique keys, so assembly consists of pure indexed additions without any key
+     * lookups in the inner loops.  The default implementation ignores the hint and falls
+     * back to the key-based overload above.
+     */
+    virtual void updateHessian(const KeyVector& keys,
+                           const std::vector<DenseIndex>& /*slots*/,
+                           SymmetricBlockMatrix* info) const {
+      updateHessian(keys, info);
+    }
+
     /// y += alpha * A'*A*x
     virtual void multiplyHessianAdd(double alpha, const VectorValues& x, VectorValues& y) const = 0;
 
@@ -157,6 +177,13 @@ namespace gtsam {
 
   }; // GaussianFactor
 
+/// Overload of the generic factorMemoryBytes in BayesTree.h: dispatches to
+/// the virtual GaussianFactor::memoryUsage, found by argument-dependent
+/// lookup from BayesTree::memoryUsage.
+inline std::size_t factorMemoryBytes(const GaussianFactor& factor) {
+  return factor.memoryUsage();
+}
+
 /// traits
 template<>
 struct traits<GaussianFactor> : public Testable<GaussianFactor> {
@@ -24,11 +24,23 @@
 #include <gtsam/linear/GaussianEliminationTree.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/DSFMap.h>
+#include <gtsam/base/FastMap.h>
+
+#include <boost/make_shared.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <tuple>
 
 using namespace std;
 using namespace gtsam;
@@ -38,6 +50,7 @@ namespace gtsam {
   // Instantiate base classes
   template class FactorGraph<GaussianFactor>;
   template class EliminateableFactorGraph<GaussianFactorGraph>;
+  template class MultifrontalPlan<GaussianFactorGraph>;
 
   /* ************************************************************************* */
   bool GaussianFactorGraph::equals(const This& fg, double tol) const
@@ -99,6 +112,191 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  GaussianFactorGraph GaussianFactorGraph::combineDuplicateFactors() const {
+    gttic(GaussianFactorGraph_combineDuplicateFactors);
+
+    // Group factor indices by their key set, ignoring key order
+    FastMap<KeyVector, size_t> groupOf;
+    std::vector<std::vector<size_t> > groups;
+    for (size_t i = 0; i < size(); ++i) {
+      const sharedFactor& factor = at(i);
+      if (!factor)
+        continue;
+      KeyVector sortedKeys(factor->begin(), factor->end());
+      std::sort(sortedKeys.begin(), sortedKeys.end());
+      const std::pair<FastMap<KeyVector, size_t>::iterator, bool> inserted =
+          groupOf.insert(std::make_pair(sortedKeys, groups.size()));
+      if (inserted.second)
+        groups.push_back(std::vector<size_t>());
+      groups[inserted.first->second].push_back(i);
+    }
+
+    // Each group of parallel factors is summed into one HessianFactor; unique
+    // factors pass through unchanged.  Groups keep first-occurrence order.
+    GaussianFactorGraph result;
+    result.reserve(groups.size());
+    for (const std::vector<size_t>& group : groups) {
+      if (group.size() == 1) {
+        result.push_back(at(group[0]));
+      } else {
+        GaussianFactorGraph duplicates;
+        duplicates.reserve(group.size());
+        for (size_t i : group)
+          duplicates.push_back(at(i));
+        result.push_back(boost::make_shared<HessianFactor>(duplicates));
+      }
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  GaussianFactorGraph GaussianFactorGraph::substituteEqualityConstraints(
+      VectorValues& fixedValues) const {
+    gttic(GaussianFactorGraph_substituteEqualityConstraints);
+
+    // Pass 1: find variables fixed by hard equality constraints - unary
+    // Jacobian factors with an all-zero-sigma constrained model and a
+    // square, invertible A block (the linearized form of NonlinearEquality)
+    FastMap<Key, size_t> constraintOf; // fixed key -> constraint factor index
+    for (size_t i = 0; i < size(); ++i) {
+      const JacobianFactor::shared_ptr jacobian =
+          boost::dynamic_pointer_cast<JacobianFactor>(at(i));
+      if (!jacobian || jacobian->size() != 1)
+        continue;
+      const SharedDiagonal& model = jacobian->get_model();
+      if (!model || !model->isConstrained())
+        continue;
+      if (!(model->sigmas().array() == 0.0).all())
+        continue;
+      const Matrix A = jacobian->getA(jacobian->begin());
+      if (A.rows() != A.cols())
+        continue;
+      const Eigen::FullPivLU<Matrix> lu(A);
+      if (!lu.isInvertible())
+        continue;
+      const Key key = jacobian->keys().front();
+      // A duplicate constraint on an already-fixed variable must agree with
+      // the first one; an agreeing duplicate reduces to a constant in pass 3
+      // and is dropped, a conflicting one makes the graph infeasible
+      const Vector solution = lu.solve(Vector(jacobian->getb()));
+      if (constraintOf.insert(std::make_pair(key, i)).second) {
+        fixedValues.insert(key, solution);
+      } else if (!equal_with_abs_tol(fixedValues[key], solution, 1e-9)) {
+        throw std::invalid_argument(
+            "GaussianFactorGraph::substituteEqualityConstraints: conflicting "
+            "equality constraints on variable " + DefaultKeyFormatter(key));
+      }
+    }
+
+    // Pass 2: disqualify variables involved in non-Jacobian factors, which
+    // we cannot substitute into - their constraints stay in the graph
+    for (const sharedFactor& factor : *this) {
+      if (!factor || boost::dynamic_pointer_cast<JacobianFactor>(factor))
+        continue;
+      for (Key key : factor->keys()) {
+        const FastMap<Key, size_t>::iterator item = constraintOf.find(key);
+        if (item != constraintOf.end()) {
+          fixedValues.erase(key);
+          constraintOf.erase(item);
+        }
+      }
+    }
+
+    FastSet<size_t> constraintFactors;
+    for (const FastMap<Key, size_t>::value_type& entry : constraintOf)
+      constraintFactors.insert(entry.second);
+
+    // Pass 3: substitute the fixed solutions into the remaining factors,
+    // moving A_f * x_f to the right-hand side and dropping the columns
+    GaussianFactorGraph result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      const sharedFactor& factor = at(i);
+      if (!factor || constraintFactors.exists(i))
+        continue;
+      const JacobianFactor::shared_ptr jacobian =
+          boost::dynamic_pointer_cast<JacobianFactor>(factor);
+      if (!jacobian) {
+        result.push_back(factor);
+        continue;
+      }
+
+      bool involvesFixed = false;
+      for (Key key : jacobian->keys())
+        if (fixedValues.exists(key)) {
+          involvesFixed = true;
+          break;
+        }
+      if (!involvesFixed) {
+        result.push_back(factor);
+        continue;
+      }
+
+      std::vector<std::pair<Key, Matrix> > terms;
+      terms.reserve(jacobian->size());
+      Vector b = jacobian->getb();
+      for (JacobianFactor::const_iterator key = jacobian->begin();
+          key != jacobian->end(); ++key) {
+        if (fixedValues.exists(*key))
+          b -= jacobian->getA(key) * fixedValues[*key];
+        else
+          terms.push_back(std::make_pair(*key, Matrix(jacobian->getA(key))));
+      }
+      // A factor over only fixed variables reduces to a constant and is
+      // dropped; the solution of the reduced graph is unaffected
+      if (!terms.empty())
+        result.push_back(boost::make_shared<JacobianFactor>(terms, b,
+            jacobian->get_model()));
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  GaussianFactorGraph::TypedView::TypedView(const GaussianFactorGraph& graph) {
+    jacobians_.reserve(graph.size()); // most graphs are all-Jacobian
+    for (const sharedFactor& factor : graph)
+      add(factor);
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::TypedView::add(const sharedFactor& factor) {
+    if (!factor)
+      return;
+    if (JacobianFactor::shared_ptr jacobian =
+        boost::dynamic_pointer_cast<JacobianFactor>(factor))
+      jacobians_.push_back(jacobian);
+    else if (HessianFactor::shared_ptr hessian =
+        boost::dynamic_pointer_cast<HessianFactor>(factor))
+      hessians_.push_back(hessian);
+    else
+      others_.push_back(factor);
+  }
+
+  /* ************************************************************************* */
+  namespace {
+  // Erase the entry pointing at the same factor object, swap-and-pop since
+  // slice order carries no meaning
+  template <class SLICE>
+  bool removeFromSlice(SLICE& slice, const GaussianFactor* factor) {
+    for (size_t i = 0; i < slice.size(); ++i)
+      if (slice[i].get() == factor) {
+        slice[i] = slice.back();
+        slice.pop_back();
+        return true;
+      }
+    return false;
+  }
+  }
+
+  bool GaussianFactorGraph::TypedView::remove(const sharedFactor& factor) {
+    if (!factor)
+      return false;
+    return removeFromSlice(jacobians_, factor.get())
+        || removeFromSlice(hessians_, factor.get())
+        || removeFromSlice(others_, factor.get());
+  }
+
   /* ************************************************************************* */
   vector<boost::tuple<size_t, size_t, double> > GaussianFactorGraph::sparseJacobian() const {
     // First find dimensions of each variable
@@ -169,6 +367,130 @@ namespace gtsam {
     return vector<triplet>(entries.begin(), entries.end());
   }
 
+  /* ************************************************************************* */
+  namespace {
+  // View a factor in Jacobian form for the sparse exports, converting
+  // HessianFactors as needed
+  JacobianFactor::shared_ptr castToJacobian(
+      const GaussianFactor::shared_ptr& factor) {
+    JacobianFactor::shared_ptr jacobian(
+        boost::dynamic_pointer_cast<JacobianFactor>(factor));
+    if (!jacobian) {
+      HessianFactor::shared_ptr hessian(
+          boost::dynamic_pointer_cast<HessianFactor>(factor));
+      if (hessian)
+        jacobian.reset(new JacobianFactor(*hessian));
+      else
+        throw invalid_argument(
+            "GaussianFactorGraph contains a factor that is neither a JacobianFactor nor a HessianFactor.");
+    }
+    return jacobian;
+  }
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::sparseJacobianCscDims(size_t& rows, size_t& cols,
+      size_t& nnz) const {
+    typedef std::map<Key, size_t> KeySizeMap;
+    KeySizeMap dims;
+    rows = 0;
+    nnz = 0;
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor))
+        continue;
+      const JacobianFactor::shared_ptr jacobian = castToJacobian(factor);
+      const size_t r = jacobian->rows();
+      size_t factorCols = 0;
+      for (JacobianFactor::const_iterator key = jacobian->begin();
+          key != jacobian->end(); ++key) {
+        const size_t dim = jacobian->getDim(key);
+        dims[*key] = dim;
+        factorCols += dim;
+      }
+      rows += r;
+      nnz += r * factorCols + r; // variable blocks plus the rhs entries
+    }
+    cols = 1; // the rhs column
+    for (const KeySizeMap::value_type& col : dims)
+      cols += col.second;
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::sparseJacobianCsc(int* outerIndex, int* innerIndex,
+      double* values) const {
+    gttic(GaussianFactorGraph_sparseJacobianCsc);
+
+    // Scalar column layout: variables in increasing key order, rhs last
+    typedef std::map<Key, size_t> KeySizeMap;
+    KeySizeMap dims;
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor))
+        continue;
+      for (GaussianFactor::const_iterator key = factor->begin();
+          key != factor->end(); ++key)
+        dims[*key] = factor->getDim(key);
+    }
+    size_t currentColIndex = 0;
+    KeySizeMap columnIndices = dims;
+    for (const KeySizeMap::value_type& col : dims) {
+      columnIndices[col.first] = currentColIndex;
+      currentColIndex += dims[col.first];
+    }
+    const size_t bColumn = currentColIndex;
+    const size_t nCols = currentColIndex + 1;
+
+    // Count the entries of each column into outerIndex[1..nCols], then
+    // prefix-sum into column start offsets
+    std::fill(outerIndex, outerIndex + nCols + 1, 0);
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor))
+        continue;
+      const JacobianFactor::shared_ptr jacobian = castToJacobian(factor);
+      const int r = static_cast<int>(jacobian->rows());
+      for (JacobianFactor::const_iterator key = jacobian->begin();
+          key != jacobian->end(); ++key) {
+        const size_t columnStart = columnIndices[*key];
+        for (DenseIndex j = 0; j < jacobian->getDim(key); ++j)
+          outerIndex[columnStart + j + 1] += r;
+      }
+      outerIndex[bColumn + 1] += r;
+    }
+    for (size_t c = 1; c <= nCols; ++c)
+      outerIndex[c] += outerIndex[c - 1];
+
+    // Fill pass: every factor occupies a contiguous, increasing row range, so
+    // appending per column in factor order leaves row indices sorted
+    std::vector<int> next(outerIndex, outerIndex + nCols);
+    int row = 0;
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor))
+        continue;
+      const JacobianFactor::shared_ptr jacobian = castToJacobian(factor);
+      const JacobianFactor whitened(jacobian->whiten());
+      for (JacobianFactor::const_iterator key = whitened.begin();
+          key != whitened.end(); ++key) {
+        JacobianFactor::constABlock whitenedA = whitened.getA(key);
+        const size_t columnStart = columnIndices[*key];
+        for (int j = 0; j < whitenedA.cols(); ++j) {
+          int& cursor = next[columnStart + j];
+          for (int i = 0; i < whitenedA.rows(); ++i) {
+            innerIndex[cursor] = row + i;
+            values[cursor] = whitenedA(i, j);
+            ++cursor;
+          }
+        }
+      }
+      JacobianFactor::constBVector whitenedb(whitened.getb());
+      int& cursor = next[bColumn];
+      for (int i = 0; i < whitenedb.size(); ++i) {
+        innerIndex[cursor] = row + i;
+        values[cursor] = whitenedb(i);
+        ++cursor;
+      }
+      row += static_cast<int>(whitened.rows());
+    }
+  }
+
   /* ************************************************************************* */
   Matrix GaussianFactorGraph::sparseJacobian_() const {
 
@@ -317,6 +639,123 @@ namespace gtsam {
     return VectorValues(solution, scatter);
   }
 
+  /* ************************************************************************* */
+  std::vector<GaussianFactorGraph> GaussianFactorGraph::splitConnectedComponents() const {
+    gttic(GaussianFactorGraph_splitConnectedComponents);
+
+    // Union the keys that appear in the same factor
+    DSFMap<Key> dsf;
+    for (const sharedFactor& factor : *this) {
+      if (!factor || factor->empty()) continue;
+      const Key first = factor->front();
+      for (Key key : *factor)
+        dsf.merge(first, key);
+    }
+
+    // Bucket factors by component representative, in order of first appearance
+    std::vector<GaussianFactorGraph> components;
+    FastMap<Key, size_t> componentIndex;
+    for (const sharedFactor& factor : *this) {
+      if (!factor || factor->empty()) continue;
+      const Key representative = dsf.find(factor->front());
+      const auto inserted = componentIndex.insert(
+          std::make_pair(representative, components.size()));
+      if (inserted.second)
+        components.push_back(GaussianFactorGraph());
+      components[inserted.first->second].push_back(factor);
+    }
+    return components;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizeComponents(const Eliminate& function) const {
+    gttic(GaussianFactorGraph_optimizeComponents);
+    VectorValues solution;
+    for (const GaussianFactorGraph& component : splitConnectedComponents())
+      solution.insert(component.optimize(function));
+    return solution;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizeSchur(const KeySet& pointKeys,
+      const Eliminate& function) const {
+    gttic(GaussianFactorGraph_optimizeSchur);
+
+    // Partition the factors: every factor touching a point variable goes into
+    // that point's bucket, the rest start off the reduced camera system.  The
+    // bundle-adjustment structure allows at most one point per factor, which
+    // makes the points conditionally independent given the cameras.
+    FastMap<Key, size_t> bucketOf;
+    std::vector<GaussianFactorGraph> buckets;
+    std::vector<Key> points;
+    GaussianFactorGraph reduced;
+    for (const sharedFactor& factor : *this) {
+      if (!factor) continue;
+      Key pointKey = 0;
+      size_t nPoints = 0;
+      for (Key key : *factor) {
+        if (pointKeys.count(key)) {
+          pointKey = key;
+          ++nPoints;
+        }
+      }
+      if (nPoints == 0) {
+        reduced.push_back(factor);
+      } else if (nPoints == 1) {
+        const auto inserted = bucketOf.insert(
+            std::make_pair(pointKey, buckets.size()));
+        if (inserted.second) {
+          buckets.push_back(GaussianFactorGraph());
+          points.push_back(pointKey);
+        }
+        buckets[inserted.first->second].push_back(factor);
+      } else {
+        throw std::invalid_argument(
+            "GaussianFactorGraph::optimizeSchur: a factor connects two point "
+            "variables, so the points are not conditionally independent given "
+            "the cameras and the Schur shortcut does not apply.");
+      }
+    }
+
+    // Eliminate every point from its own bucket.  The buckets share no point
+    // variables, so the eliminations are independent and each writes its
+    // conditional and camera marginal into its own slot.
+    std::vector<GaussianConditional::shared_ptr> conditionals(buckets.size());
+    std::vector<GaussianFactor::shared_ptr> marginals(buckets.size());
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, buckets.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            Ordering ordering;
+            ordering.push_back(points[i]);
+            std::tie(conditionals[i], marginals[i]) =
+                function(buckets[i], ordering);
+          }
+        });
+#else
+    for (size_t i = 0; i < buckets.size(); ++i) {
+      Ordering ordering;
+      ordering.push_back(points[i]);
+      std::tie(conditionals[i], marginals[i]) = function(buckets[i], ordering);
+    }
+#endif
+
+    // The marginal of each bucket onto its cameras is that point's Schur
+    // complement contribution; together with the camera-only factors they
+    // form the reduced camera system
+    for (const GaussianFactor::shared_ptr& marginal : marginals)
+      if (marginal && marginal->size() > 0)
+        reduced.push_back(marginal);
+
+    VectorValues solution = reduced.optimize(function);
+
+    // Recover the points by back-substitution through the conditionals
+    for (const GaussianConditional::shared_ptr& conditional : conditionals)
+      solution.insert(conditional->solve(solution));
+
+    return solution;
+  }
+
   /* ************************************************************************* */
   namespace {
     JacobianFactor::shared_ptr convertToJacobianFactorPtr(const GaussianFactor::shared_ptr &gf) {
@@ -177,6 +177,90 @@ namespace gtsam {
      */
     GaussianFactorGraph negate() const;
 
+    /**
+     * Returns a copy of the graph in which factors over identical key sets
+     * are summed into a single HessianFactor, so repeated measurements of the
+     * same variables (e.g. parallel between-edges) are eliminated once
+     * instead of once per factor.  Key order within a factor is ignored when
+     * matching.  Factors with a unique key set are passed through unchanged;
+     * null factors are dropped, so indices into the original graph are not
+     * valid for the result.  The combined graph defines the same error
+     * function as the original.
+     */
+    GaussianFactorGraph combineDuplicateFactors() const;
+
+    /**
+     * Returns a copy of the graph in which variables fixed by hard equality
+     * constraints are removed by direct substitution.  A variable is fixed
+     * if some unary JacobianFactor constrains it with an all-zero-sigma
+     * Constrained noise model and a square, invertible A block - the
+     * linearization of a NonlinearEquality has exactly this form.  The
+     * constraint is solved for the variable, the solution is substituted
+     * into the right-hand side of every other Jacobian factor involving it,
+     * and the variable disappears from the returned graph, which can then
+     * be eliminated without the constrained-row pivoting in EliminateQR.
+     *
+     * Variables involved in non-Jacobian factors (e.g. HessianFactors) are
+     * left untouched, as are duplicate constraints on an already-fixed
+     * variable, so the result always defines the same solution.  The fixed
+     * solutions are accumulated into \c fixedValues; callers re-assemble
+     * the full solution by inserting them into the reduced graph's result.
+     */
+    GaussianFactorGraph substituteEqualityConstraints(VectorValues& fixedValues) const;
+
+    /**
+     * A type-partitioned view of the graph: the factors sorted into
+     * homogeneous Jacobian, Hessian and other slices by a single RTTI sweep
+     * at construction.  Passes that would otherwise dynamic_cast every
+     * factor on every iteration (iterative solvers, repeated sparse
+     * exports) build the view once and then loop over the typed slices
+     * cast-free.  GaussianConditionals land in the Jacobian slice, since
+     * they derive from JacobianFactor.  The view holds shared_ptrs, so it
+     * stays valid if the graph is cleared, but it does not observe later
+     * changes to the graph - use add() and remove() to keep it in sync.
+     */
+    class GTSAM_EXPORT TypedView {
+     public:
+      typedef std::vector<JacobianFactor::shared_ptr> Jacobians;
+      typedef std::vector<HessianFactor::shared_ptr> Hessians;
+      typedef std::vector<sharedFactor> Others;
+
+      /// Empty view; populate with add()
+      TypedView() {}
+
+      /// Partition all (non-null) factors of the graph, one cast per factor
+      explicit TypedView(const GaussianFactorGraph& graph);
+
+      /// Classify one newly added factor into its slice; ignores null
+      void add(const sharedFactor& factor);
+
+      /// Remove one factor (matched by pointer identity) from its slice;
+      /// returns false if the factor is not in the view
+      bool remove(const sharedFactor& factor);
+
+      /// All JacobianFactors (including GaussianConditionals) in the graph
+      const Jacobians& jacobianFactors() const { return jacobians_; }
+
+      /// All HessianFactors in the graph
+      const Hessians& hessianFactors() const { return hessians_; }
+
+      /// Factors that are neither Jacobian nor Hessian
+      const Others& otherFactors() const { return others_; }
+
+      /// Total number of factors in the view
+      size_t size() const {
+        return jacobians_.size() + hessians_.size() + others_.size();
+      }
+
+     private:
+      Jacobians jacobians_;
+      Hessians hessians_;
+      Others others_;
+    };
+
+    /// Build a type-partitioned view of the current factors, see TypedView
+    TypedView typedView() const { return TypedView(*this); }
+
     ///@name Linear Algebra
     ///@{
 
@@ -194,6 +278,29 @@ namespace gtsam {
      */
     Matrix sparseJacobian_() const;
 
+    /**
+     * Compute the dimensions of the whitened augmented Jacobian [A b] as
+     * written by sparseJacobianCsc, so the caller can allocate the index and
+     * value arrays.  cols includes the right-hand-side column; nnz counts
+     * every entry of each factor's variable blocks (explicit zeros within a
+     * block are kept, unlike sparseJacobian which drops them), plus the
+     * right-hand side.
+     */
+    void sparseJacobianCscDims(size_t& rows, size_t& cols, size_t& nnz) const;
+
+    /**
+     * Write the whitened augmented Jacobian [A b] in compressed sparse
+     * column (CSC) form directly into caller-provided arrays, without
+     * intermediate triplets or dense matrices.  outerIndex must hold cols+1
+     * entries and innerIndex and values nnz entries each, with the sizes
+     * given by sparseJacobianCscDims.  Row indices within each column are
+     * sorted, so the arrays can be viewed zero-copy with
+     * Eigen::Map<const Eigen::SparseMatrix<double> > or handed to external
+     * solvers directly.  Variables are laid out in increasing key order;
+     * indices are int, so rows, cols and nnz must each stay below 2^31.
+     */
+    void sparseJacobianCsc(int* outerIndex, int* innerIndex, double* values) const;
+
     /**
      * Return a dense \f$ [ \;A\;b\; ] \in \mathbb{R}^{m \times n+1} \f$
      * Jacobian matrix, augmented with b with the noise models baked
@@ -297,6 +404,35 @@ namespace gtsam {
      */
     VectorValues optimizeDensely() const;
 
+    /** Split the graph into its connected components: factors that share no
+     *  variables, directly or transitively, end up in different subgraphs.
+     *  Components are returned in order of first appearance in this graph.
+     *  They can be solved independently - e.g. dispatched to separate worker
+     *  threads - and the per-component solutions concatenate to the joint
+     *  solution. */
+    std::vector<GaussianFactorGraph> splitConnectedComponents() const;
+
+    /** Solve each connected component independently and merge the solutions.
+     *  Produces the same result as optimize() but eliminates the components
+     *  separately, so disconnected sessions do not share one elimination
+     *  ordering and a large component does not couple with the rest. */
+    VectorValues optimizeComponents(
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
+
+    /** Solve a bundle-adjustment-structured graph by eliminating the given
+     *  point (landmark) variables first.  Requires every factor to involve at
+     *  most one point variable - the standard structure of projection factors
+     *  - so the points are conditionally independent given the cameras: each
+     *  point is eliminated from its own factor bucket independently (in
+     *  parallel under TBB), the resulting marginals form the reduced (Schur
+     *  complement) camera system, which is solved with optimize(), and the
+     *  points are recovered by back-substitution.  Produces the same solution
+     *  as optimize() while skipping the general junction-tree machinery for
+     *  the point variables.  Throws std::invalid_argument if a factor
+     *  connects two point variables. */
+    VectorValues optimizeSchur(const KeySet& pointKeys,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
+
     /**
      * Compute the gradient of the energy function,
      * \f$ \nabla_{x=x_0} \left\Vert \Sigma^{-1} A x - b \right\Vert^2 \f$,
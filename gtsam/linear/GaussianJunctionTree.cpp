@@ -20,6 +20,9 @@
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
 
+#include <fstream>
+#include <sstream>
+
 namespace gtsam {
 
   // Instantiate base classes
@@ -31,4 +34,374 @@ namespace gtsam {
     const GaussianEliminationTree& eliminationTree) :
   Base(eliminationTree) {}
 
+  /* ************************************************************************* */
+  GaussianJunctionTree::GaussianJunctionTree(
+    const GaussianEliminationTree& eliminationTree,
+    const AmalgamationPolicy& policy) :
+  Base(eliminationTree, policy) {}
+
+  /* ************************************************************************* */
+  size_t GaussianJunctionTree::amalgamate(size_t smallCliqueSize,
+      size_t maxMergedFrontals) {
+    gttic(GaussianJunctionTree_amalgamate);
+
+    // Gather the clusters in pre-order with an explicit stack; walking the
+    // list in reverse then handles every child before its parent, so chains
+    // of tiny cliques collapse bottom-up in a single pass.
+    FastVector<sharedNode> preOrder;
+    FastVector<sharedNode> stack(roots_.begin(), roots_.end());
+    while (!stack.empty()) {
+      sharedNode node = stack.back();
+      stack.pop_back();
+      preOrder.push_back(node);
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+    }
+
+    size_t nrMerged = 0;
+    for (size_t n = preOrder.size(); n > 0; --n) {
+      const sharedNode& node = preOrder[n - 1];
+      const size_t nrChildren = node->nrChildren();
+      if (nrChildren == 0)
+        continue;
+      std::vector<bool> merge(nrChildren, false);
+      bool anyMerged = false;
+      size_t myNrFrontals = node->nrFrontals();
+      for (size_t i = 0; i < nrChildren; ++i) {
+        const Node& child = (*node)[i];
+        if (child.nrFrontals() <= smallCliqueSize
+            && myNrFrontals + child.nrFrontals() <= maxMergedFrontals) {
+          myNrFrontals += child.nrFrontals();
+          merge[i] = true;
+          anyMerged = true;
+          ++nrMerged;
+        }
+      }
+      if (anyMerged)
+        node->mergeChildren(merge);
+    }
+    return nrMerged;
+  }
+
+  /* ************************************************************************* */
+  size_t GaussianJunctionTree::denseSwitch(double densityThreshold) {
+    gttic(GaussianJunctionTree_denseSwitch);
+    if (densityThreshold <= 0.0)
+      return 0;
+
+    // Symbolic pass: the column count (frontals plus separator) of every
+    // cluster, computed bottom-up because a cluster's separator is whatever
+    // its subtree's factors involve beyond the subtree's own frontals
+    FastVector<sharedNode> preOrder;
+    FastVector<sharedNode> stack(roots_.begin(), roots_.end());
+    while (!stack.empty()) {
+      sharedNode node = stack.back();
+      stack.pop_back();
+      preOrder.push_back(node);
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+    }
+    FastMap<const Node*, size_t> width; // frontals + separator, per cluster
+    {
+      FastMap<const Node*, KeySet> colKeys;
+      for (size_t n = preOrder.size(); n > 0; --n) {
+        const sharedNode& node = preOrder[n - 1];
+        KeySet& keys = colKeys[node.get()];
+        for (const sharedFactor& factor : node->factors)
+          if (factor)
+            keys.insert(factor->begin(), factor->end());
+        for (const sharedNode& child : node->children) {
+          keys.insert(colKeys[child.get()].begin(),
+              colKeys[child.get()].end());
+          // A child's frontals are eliminated below this cluster
+          for (Key frontal : child->orderedFrontalKeys)
+            keys.erase(frontal);
+          colKeys.erase(child.get());
+        }
+        width[node.get()] = keys.size();
+      }
+    }
+
+    // Absorb the children of each root while the merged problem stays dense
+    // enough; repeating until fixpoint grows the dense window downwards one
+    // generation at a time.  Children deeper in the tree keep their cached
+    // widths, since merging their ancestors does not change their columns.
+    size_t nrAbsorbed = 0;
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (const sharedNode& root : roots_) {
+        const size_t nrChildren = root->nrChildren();
+        if (nrChildren == 0)
+          continue;
+        // Predicted nonzeros of the triangular factor of the merged tail:
+        // a dense triangle per clique's frontals plus a dense frontals x
+        // separator block, all in variable counts.  A root has no separator.
+        size_t nrVariables = root->nrFrontals();
+        double nnz = 0.5 * double(root->nrFrontals())
+            * double(root->nrFrontals() + 1);
+        for (const sharedNode& child : root->children) {
+          const size_t f = child->nrFrontals();
+          const size_t separator = width.at(child.get()) - f;
+          nnz += 0.5 * double(f) * double(f + 1) + double(f) * double(separator);
+          nrVariables += f;
+        }
+        const double dense = 0.5 * double(nrVariables)
+            * double(nrVariables + 1);
+        if (nnz < densityThreshold * dense)
+          continue;
+        root->mergeChildren(std::vector<bool>(nrChildren, true));
+        nrAbsorbed += nrChildren;
+        merged = true;
+      }
+    }
+    return nrAbsorbed;
+  }
+
+  /* ************************************************************************* */
+  void GaussianJunctionTree::writeCliqueHints(const std::string& filename) const {
+    std::ofstream stream(filename.c_str());
+    if (!stream.is_open())
+      throw std::runtime_error(
+          "GaussianJunctionTree::writeCliqueHints: could not write " + filename);
+
+    // One line per clique, frontal keys separated by spaces, in pre-order
+    FastVector<sharedNode> stack(roots_.begin(), roots_.end());
+    while (!stack.empty()) {
+      sharedNode node = stack.back();
+      stack.pop_back();
+      for (size_t i = 0; i < node->orderedFrontalKeys.size(); ++i) {
+        if (i > 0)
+          stream << ' ';
+        stream << node->orderedFrontalKeys[i];
+      }
+      stream << '\n';
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+    }
+  }
+
+  /* ************************************************************************* */
+  size_t GaussianJunctionTree::applyCliqueHints(const std::string& filename) {
+    gttic(GaussianJunctionTree_applyCliqueHints);
+
+    std::ifstream stream(filename.c_str());
+    if (!stream.is_open())
+      throw std::runtime_error(
+          "GaussianJunctionTree::applyCliqueHints: could not read " + filename);
+
+    // Each hint line defines one group of frontal keys
+    FastMap<Key, size_t> groupOf;
+    size_t nrGroups = 0;
+    std::string line;
+    while (std::getline(stream, line)) {
+      std::istringstream keys(line);
+      Key key;
+      bool any = false;
+      while (keys >> key) {
+        groupOf[key] = nrGroups;
+        any = true;
+      }
+      if (any)
+        ++nrGroups;
+    }
+
+    // The group of a clique, or -1 when its frontals span groups or are
+    // absent from the hints - such cliques are never merged
+    auto cliqueGroup = [&groupOf](const Node& node) -> ptrdiff_t {
+      ptrdiff_t group = -1;
+      for (Key key : node.orderedFrontalKeys) {
+        const FastMap<Key, size_t>::const_iterator item = groupOf.find(key);
+        if (item == groupOf.end())
+          return -1;
+        if (group == -1)
+          group = item->second;
+        else if (group != ptrdiff_t(item->second))
+          return -1;
+      }
+      return group;
+    };
+
+    // Same bottom-up sweep as amalgamate(): walking the pre-order list in
+    // reverse handles every child before its parent, so a hinted clique the
+    // construction split into a chain collapses in one pass
+    FastVector<sharedNode> preOrder;
+    FastVector<sharedNode> stack(roots_.begin(), roots_.end());
+    while (!stack.empty()) {
+      sharedNode node = stack.back();
+      stack.pop_back();
+      preOrder.push_back(node);
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+    }
+
+    size_t nrMerged = 0;
+    for (size_t n = preOrder.size(); n > 0; --n) {
+      const sharedNode& node = preOrder[n - 1];
+      const size_t nrChildren = node->nrChildren();
+      if (nrChildren == 0)
+        continue;
+      const ptrdiff_t myGroup = cliqueGroup(*node);
+      if (myGroup == -1)
+        continue;
+      std::vector<bool> merge(nrChildren, false);
+      bool anyMerged = false;
+      for (size_t i = 0; i < nrChildren; ++i) {
+        if (cliqueGroup((*node)[i]) == myGroup) {
+          merge[i] = true;
+          anyMerged = true;
+          ++nrMerged;
+        }
+      }
+      if (anyMerged)
+        node->mergeChildren(merge);
+    }
+    return nrMerged;
+  }
+
+  /* ************************************************************************* */
+  namespace {
+  // Helpers for the sequential spill-file record format
+  void writeUint64(std::ostream& os, std::uint64_t value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  std::uint64_t readUint64(std::istream& is) {
+    std::uint64_t value = 0;
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+  }
+
+  void writeDoubles(std::ostream& os, const double* data, std::uint64_t count) {
+    os.write(reinterpret_cast<const char*>(data), count * sizeof(double));
+  }
+
+  void readDoubles(std::istream& is, double* data, std::uint64_t count) {
+    is.read(reinterpret_cast<char*>(data), count * sizeof(double));
+  }
+  }  // namespace
+
+  /* ************************************************************************* */
+  GaussianJunctionTree::SpilledConditionals GaussianJunctionTree::eliminateToDisk(
+      const GaussianFactorGraph::Eliminate& function,
+      const std::string& filename) const {
+    gttic(GaussianJunctionTree_eliminateToDisk);
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      throw std::runtime_error(
+          "GaussianJunctionTree::eliminateToDisk: cannot write " + filename);
+
+    SpilledConditionals spilled;
+    spilled.filename_ = filename;
+
+    // Gather the clusters in pre-order; walking the list in reverse then
+    // eliminates every child before its parent (see amalgamate)
+    FastVector<sharedNode> preOrder;
+    FastVector<sharedNode> stack(roots_.begin(), roots_.end());
+    while (!stack.empty()) {
+      sharedNode node = stack.back();
+      stack.pop_back();
+      preOrder.push_back(node);
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+    }
+
+    // Bottom-up numeric sweep.  Only the marginal factors of the active
+    // frontier stay resident; each completed conditional is appended to the
+    // spill file and released before the next cluster is eliminated.
+    FastMap<const Node*, GaussianFactor::shared_ptr> marginals;
+    for (size_t n = preOrder.size(); n > 0; --n) {
+      const sharedNode& node = preOrder[n - 1];
+
+      // Gather this cluster's factors plus its children's marginals
+      GaussianFactorGraph gatheredFactors;
+      gatheredFactors.reserve(node->factors.size() + node->nrChildren());
+      gatheredFactors += node->factors;
+      for (const sharedNode& child : node->children) {
+        const auto item = marginals.find(child.get());
+        if (item != marginals.end()) {
+          gatheredFactors.push_back(item->second);
+          marginals.erase(item);
+        }
+      }
+
+      // Do dense elimination step
+      auto eliminationResult = function(gatheredFactors, node->orderedFrontalKeys);
+      if (!eliminationResult.second->empty())
+        marginals[node.get()] = eliminationResult.second;
+
+      // Append the conditional in the sequential record format and drop it
+      const GaussianConditional& conditional = *eliminationResult.first;
+      spilled.offsets_.push_back(static_cast<std::uint64_t>(file.tellp()));
+      writeUint64(file, conditional.keys().size());
+      for (Key key : conditional.keys()) writeUint64(file, key);
+      writeUint64(file, conditional.nrFrontals());
+      for (auto it = conditional.begin(); it != conditional.end(); ++it)
+        writeUint64(file, conditional.getDim(it));
+      const Matrix augmented = conditional.matrixObject().full();
+      writeUint64(file, augmented.rows());
+      writeDoubles(file, augmented.data(), augmented.size());
+      if (conditional.get_model()) {
+        const Vector& sigmas = conditional.get_model()->sigmas();
+        writeUint64(file, 1);
+        writeDoubles(file, sigmas.data(), sigmas.size());
+      } else {
+        writeUint64(file, 0);
+      }
+    }
+
+    // A marginal left at a root means the elimination was incomplete
+    for (const sharedNode& root : roots_)
+      if (marginals.count(root.get()))
+        throw std::runtime_error(
+            "GaussianJunctionTree::eliminateToDisk: incomplete elimination, "
+            "a marginal factor remains at a root");
+
+    file.close();
+    if (file.fail())
+      throw std::runtime_error(
+          "GaussianJunctionTree::eliminateToDisk: error writing " + filename);
+    return spilled;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianJunctionTree::SpilledConditionals::optimize() const {
+    gttic(SpilledConditionals_optimize);
+    std::ifstream file(filename_.c_str(), std::ios::binary);
+    if (!file.is_open())
+      throw std::runtime_error(
+          "SpilledConditionals::optimize: cannot read " + filename_);
+
+    // The records were appended children-first, so reading them in reverse
+    // yields every parent before its children - backsubstitution order
+    VectorValues soln;
+    for (size_t n = offsets_.size(); n > 0; --n) {
+      file.seekg(static_cast<std::streamoff>(offsets_[n - 1]));
+      const std::uint64_t nrKeys = readUint64(file);
+      KeyVector keys(nrKeys);
+      for (std::uint64_t i = 0; i < nrKeys; ++i) keys[i] = readUint64(file);
+      const std::uint64_t nrFrontals = readUint64(file);
+      FastVector<DenseIndex> dims(nrKeys);
+      DenseIndex cols = 1;  // the right-hand-side column
+      for (std::uint64_t i = 0; i < nrKeys; ++i) {
+        dims[i] = static_cast<DenseIndex>(readUint64(file));
+        cols += dims[i];
+      }
+      const DenseIndex rows = static_cast<DenseIndex>(readUint64(file));
+      Matrix augmented(rows, cols);
+      readDoubles(file, augmented.data(), augmented.size());
+      SharedDiagonal model;
+      if (readUint64(file)) {
+        Vector sigmas(rows);
+        readDoubles(file, sigmas.data(), sigmas.size());
+        model = noiseModel::Diagonal::Sigmas(sigmas);
+      }
+      if (!file)
+        throw std::runtime_error(
+            "SpilledConditionals::optimize: truncated spill file " + filename_);
+
+      // Rebuild the conditional and backsubstitute
+      const VerticalBlockMatrix blockMatrix(dims, augmented, true);
+      const GaussianConditional conditional(keys, nrFrontals, blockMatrix,
+                                            model);
+      soln.insert(conditional.solve(soln));
+    }
+    return soln;
+  }
+
 }
@@ -20,6 +20,8 @@
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/inference/JunctionTree.h>
 
+#include <cstdint>
+
 namespace gtsam {
 
   // Forward declarations
@@ -49,6 +51,123 @@ namespace gtsam {
     * @return The elimination tree
     */
     GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+
+    /**
+     * Build the junction tree from an elimination tree, amalgamating cliques
+     * according to the given policy instead of the structural rule alone.
+     * Unlike amalgamate() and denseSwitch(), which coarsen an already built
+     * tree, the policy acts during construction, so vetoes (maxFrontalSize,
+     * maxMergedChildren) can also keep cliques smaller than the default
+     * would build them.
+     */
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+        const AmalgamationPolicy& policy);
+
+    /**
+     * Merge small cliques into their parents (supernode amalgamation, in the
+     * spirit of CHOLMOD).  The junction-tree construction only merges a child
+     * whose column structure matches the parent's exactly, which leaves many
+     * tiny cliques that are each factorized separately with poor arithmetic
+     * intensity.  Merging such a child into its parent widens the parent's
+     * frontal block, so elimination runs on fewer, larger dense blocks at
+     * the cost of a bounded amount of extra fill-in (the child's frontal
+     * variables pick up the parent's separator as parents).
+     *
+     * A child is merged when it has at most smallCliqueSize frontal
+     * variables and the merged clique would have at most maxMergedFrontals
+     * frontals.  The pass runs bottom-up, so chains of tiny cliques collapse
+     * in a single call.
+     * @return The number of cliques merged away.
+     */
+    size_t amalgamate(size_t smallCliqueSize = 4, size_t maxMergedFrontals = 32);
+
+    /**
+     * Collapse the dense tail of the tree into a single clique (the "dense
+     * window" of supernodal solvers).  Towards the root of loop-closure-dense
+     * problems the separators grow until the remaining subproblem is nearly
+     * fully coupled; at that point the per-clique bookkeeping of multifrontal
+     * elimination only adds overhead compared to factorizing the tail as one
+     * dense problem.
+     *
+     * Starting at each root, all children are absorbed into their parent as
+     * long as the estimated density of the merged problem - predicted
+     * nonzeros of its triangular factor over the dense triangle, with sizes
+     * in variable counts - stays at or above densityThreshold, so the pass
+     * grows a single dense root clique downwards exactly as far as the
+     * density supports it.  A threshold of 1.0 only merges perfectly dense
+     * tails; 0 or negative disables the pass.  See timing/timeDenseSwitch.cpp
+     * for the trade-off on chain-plus-loop-closure problems.
+     * @return The number of cliques absorbed into their parents.
+     */
+    size_t denseSwitch(double densityThreshold = 0.75);
+
+    /**
+     * Export the clique structure to a plain-text hint file: one line per
+     * clique listing its frontal keys.  After a tuned run - e.g. once
+     * amalgamate() and denseSwitch() parameters have been dialed in for a
+     * recurring map region - the resulting structure can be replayed on
+     * later runs with applyCliqueHints(), so cold-start solves inherit the
+     * tuned amalgamation without re-running the heuristics.
+     */
+    void writeCliqueHints(const std::string& filename) const;
+
+    /**
+     * Merge cliques according to a hint file written by writeCliqueHints().
+     * A child is merged into its parent exactly when both cliques' frontal
+     * variables fall in the same hinted clique, repeated bottom-up until the
+     * grouping matches the hints wherever the current tree refines them.
+     * The pass only merges - a hinted clique that the current construction
+     * split across different branches, and keys absent from the hints, are
+     * left as built - so stale hints degrade gracefully to the unhinted
+     * structure.
+     * @return The number of cliques merged away.
+     */
+    size_t applyCliqueHints(const std::string& filename);
+
+    /**
+     * Handle to the conditionals spilled by eliminateToDisk(): the spill
+     * file name plus the record offsets needed to stream the conditionals
+     * back in parents-first order for backsubstitution.
+     */
+    class GTSAM_EXPORT SpilledConditionals {
+     public:
+      /**
+       * Stream the conditionals back from disk and backsubstitute,
+       * returning the same solution as optimizing the in-memory Bayes
+       * tree.  Only one conditional is resident at a time, on top of the
+       * growing solution vector.  Throws std::runtime_error if the spill
+       * file cannot be read or is truncated.
+       */
+      VectorValues optimize() const;
+
+      /// Number of conditionals in the spill file
+      size_t size() const { return offsets_.size(); }
+
+      /// The spill file written by eliminateToDisk()
+      const std::string& filename() const { return filename_; }
+
+     private:
+      friend class GaussianJunctionTree;
+      SpilledConditionals() {}
+      std::string filename_;
+      std::vector<std::uint64_t> offsets_;  ///< record starts, in elimination order
+    };
+
+    /**
+     * Multifrontal elimination with clique spill-to-disk: each completed
+     * clique conditional is appended to \c filename in a sequential binary
+     * format and released immediately, so peak memory is bounded by the
+     * active frontier - the marginal factors still awaiting their parent -
+     * instead of the whole Bayes tree.  Backsubstitution then streams the
+     * records back in reverse with SpilledConditionals::optimize().
+     *
+     * Unlike eliminate(), this requires a complete elimination: a marginal
+     * remaining at a root means not all variables were covered and raises
+     * std::runtime_error, as does a file that cannot be written.
+     */
+    SpilledConditionals eliminateToDisk(
+        const GaussianFactorGraph::Eliminate& function,
+        const std::string& filename) const;
   };
 
 }
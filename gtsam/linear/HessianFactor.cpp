@@ -22,6 +22,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/linearExceptions.h>
+#include <gtsam/linear/EliminationWorkspace.h>
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/FastMap.h>
@@ -72,7 +73,16 @@ void HessianFactor::Allocate(const Scatter& scatter) {
     ++slot;
   }
   dims.back() = 1;
-  info_ = SymmetricBlockMatrix(dims);
+  // Borrow a recycled buffer of the right size from the per-thread workspace pool if one is
+  // available, avoiding a fresh heap allocation for every clique eliminated
+  DenseIndex size = 0;
+  for (DenseIndex dim : dims) size += dim;
+  info_ = SymmetricBlockMatrix(dims, EliminationWorkspace::Acquire(size, size));
+}
+
+/* ************************************************************************* */
+HessianFactor::~HessianFactor() {
+  EliminationWorkspace::Release(std::move(info_.matrix()));
 }
 
 /* ************************************************************************* */
@@ -255,12 +265,33 @@ HessianFactor::HessianFactor(const GaussianFactorGraph& factors,
 
   Allocate(scatter);
 
+  // Resolve each factor's destination slots once, so that the updates below
+  // are pure indexed block additions with no key lookups in the inner loops
+  gttic(scatter_slots);
+  FastMap<Key, DenseIndex> slotMap;
+  for (DenseIndex j = 0; j < (DenseIndex)keys_.size(); ++j)
+    slotMap.emplace(keys_[j], j);
+  const DenseIndex rhsSlot = info_.nBlocks() - 1;
+  vector<vector<DenseIndex> > allSlots;
+  allSlots.reserve(factors.size());
+  for (const auto& factor : factors) {
+    allSlots.emplace_back();
+    if (!factor) continue;
+    vector<DenseIndex>& slots = allSlots.back();
+    const DenseIndex n = factor->size();
+    slots.resize(n + 1);
+    for (DenseIndex j = 0; j < n; ++j)
+      slots[j] = slotMap.at(factor->keys()[j]);
+    slots[n] = rhsSlot;
+  }
+  gttoc(scatter_slots);
+
   // Form A' * A
   gttic(update);
   info_.setZero();
-  for(const auto& factor: factors)
-    if (factor)
-      factor->updateHessian(keys_, &info_);
+  for (size_t i = 0; i < factors.size(); ++i)
+    if (factors[i])
+      factors[i]->updateHessian(keys_, allSlots[i], &info_);
   gttoc(update);
 }
 
@@ -358,27 +389,47 @@ double HessianFactor::error(const VectorValues& c) const {
 /* ************************************************************************* */
 void HessianFactor::updateHessian(const KeyVector& infoKeys,
                                   SymmetricBlockMatrix* info) const {
+  assert(info);
+  // Resolve the destination slot of each variable, then apply indexed updates
+  const DenseIndex n = size();
+  vector<DenseIndex> slots(n + 1);
+  for (DenseIndex j = 0; j < n; ++j)
+    slots[j] = Slot(infoKeys, keys_[j]);
+  slots[n] = info->nBlocks() - 1; // RHS block
+  updateHessian(infoKeys, slots, info);
+}
+
+/* ************************************************************************* */
+void HessianFactor::updateHessian(const KeyVector& /*infoKeys*/,
+    const vector<DenseIndex>& slots, SymmetricBlockMatrix* info) const {
   gttic(updateHessian_HessianFactor);
   assert(info);
-  // Apply updates to the upper triangle
-  DenseIndex nrVariablesInThisFactor = size(), nrBlocksInInfo = info->nBlocks() - 1;
-  vector<DenseIndex> slots(nrVariablesInThisFactor + 1);
-  // Loop over this factor's blocks with indices (i,j)
-  // For every block (i,j), we determine the block (I,J) in info.
-  for (DenseIndex j = 0; j <= nrVariablesInThisFactor; ++j) {
-    const bool rhs = (j == nrVariablesInThisFactor);
-    const DenseIndex J = rhs ? nrBlocksInInfo : Slot(infoKeys, keys_[j]);
-    slots[j] = J;
+  assert(slots.size() == size() + 1);
+  // Apply updates to the upper triangle: every block (i,j) of this factor
+  // is added to the block (slots[i],slots[j]) of info
+  const DenseIndex n = size();
+  for (DenseIndex j = 0; j <= n; ++j) {
+    const DenseIndex J = slots[j];
     for (DenseIndex i = 0; i <= j; ++i) {
-      const DenseIndex I = slots[i];  // because i<=j, slots[i] is valid.
+      const DenseIndex I = slots[i];
 
+      // Use the raw unchecked block views here: this runs once per block
+      // pair per factor during elimination, and the checked accessors cost
+      // more than the adds themselves for small blocks
       if (i == j) {
         assert(I == J);
-        info->updateDiagonalBlock(I, info_.diagonalBlock(i));
+        const auto src = info_.rawBlock(i, i).map();
+        auto dest = info->rawBlock(I, I).map();
+        for (DenseIndex c = 0; c < src.cols(); ++c)
+          dest.col(c).head(c + 1) += src.col(c).head(c + 1);
       } else {
         assert(i < j);
         assert(I != J);
-        info->updateOffDiagonalBlock(I, J, info_.aboveDiagonalBlock(i, j));
+        const auto src = info_.rawBlock(i, j).map();
+        if (I < J)
+          info->rawBlock(I, J).map().noalias() += src;
+        else
+          info->rawBlock(J, I).map().noalias() += src.transpose();
       }
     }
   }
@@ -481,9 +532,12 @@ boost::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Or
     info_.choleskyPartial(nFrontals);
 
     // TODO(frank): pre-allocate GaussianConditional and write into it
-    const VerticalBlockMatrix Ab = info_.split(nFrontals);
+    VerticalBlockMatrix Ab = info_.split(nFrontals);
     conditional = boost::make_shared<GaussianConditional>(keys_, nFrontals, Ab);
 
+    // The conditional copied Ab, so recycle its scratch buffer
+    EliminationWorkspace::Release(std::move(Ab.matrix()));
+
     // Erase the eliminated keys in this factor
     keys_.erase(begin(), begin() + nFrontals);
   } catch (const CholeskyFailed&) {
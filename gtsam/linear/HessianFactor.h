@@ -182,8 +182,8 @@ namespace gtsam {
     explicit HessianFactor(const GaussianFactorGraph& factors)
         : HessianFactor(factors, Scatter(factors)) {}
 
-    /** Destructor */
-    virtual ~HessianFactor() {}
+    /** Destructor - returns the dense buffer to the per-thread elimination workspace pool */
+    virtual ~HessianFactor();
 
     /** Clone this HessianFactor */
     virtual GaussianFactor::shared_ptr clone() const {
@@ -221,6 +221,11 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     virtual bool empty() const { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Approximate heap bytes: the keys plus the augmented information matrix */
+    virtual size_t memoryUsage() const {
+      return Base::memoryUsage() + info_.matrix().size() * sizeof(double);
+    }
+
     /** Return the constant term \f$ f \f$ as described above
      * @return The constant term \f$ f \f$
      */
@@ -316,6 +321,15 @@ namespace gtsam {
      */
     void updateHessian(const KeyVector& keys, SymmetricBlockMatrix* info) const;
 
+    /** Update an information matrix given precomputed destination slots, performing
+     * pure indexed block additions (see GaussianFactor::updateHessian).
+     * @param keys The ordered vector of keys for the information matrix to be updated
+     * @param slots The destination block of \c info for each variable, plus the RHS block
+     * @param info The information matrix to be updated
+     */
+    void updateHessian(const KeyVector& keys, const std::vector<DenseIndex>& slots,
+        SymmetricBlockMatrix* info) const;
+
     /** Update another Hessian factor
      * @param other the HessianFactor to be updated
      */
@@ -0,0 +1,175 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file HessianOperator.cpp
+ * @brief Compiled Hessian-vector product operator for matrix-free solvers
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/HessianOperator.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+HessianOperator::HessianOperator(const GaussianFactorGraph& gfg) :
+    keyInfo_(gfg), maxRows_(0), maxCols_(0) {
+  compile(gfg);
+}
+
+/* ************************************************************************* */
+HessianOperator::HessianOperator(const GaussianFactorGraph& gfg,
+    const KeyInfo& keyInfo) :
+    keyInfo_(keyInfo), maxRows_(0), maxCols_(0) {
+  compile(gfg);
+}
+
+/* ************************************************************************* */
+void HessianOperator::compile(const GaussianFactorGraph& gfg) {
+  gttic(HessianOperator_compile);
+
+  // First pass: size the two streams and build the schedules
+  DenseIndex jacobianSize = 0, hessianSize = 0;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor || factor->empty())
+      continue;
+
+    CompiledFactor entry;
+    entry.cols = 0;
+    entry.blocks.reserve(factor->size());
+    for (Key key : factor->keys()) {
+      KeyInfo::const_iterator it = keyInfo_.find(key);
+      if (it == keyInfo_.end())
+        throw invalid_argument(
+            "HessianOperator: factor involves a key not covered by KeyInfo");
+      entry.blocks.push_back(
+          make_pair((DenseIndex) it->second.start, (DenseIndex) it->second.dim));
+      entry.cols += it->second.dim;
+    }
+
+    const JacobianFactor* jacobian =
+        dynamic_cast<const JacobianFactor*>(factor.get());
+    if (jacobian) {
+      entry.rows = jacobian->rows();
+      entry.offset = jacobianSize;
+      jacobianSize += entry.rows * entry.cols;
+      jacobians_.push_back(entry);
+    } else {
+      // HessianFactor and any other type: compiled as a dense (symmetric)
+      // information matrix, applied with a single matrix-vector product
+      entry.rows = entry.cols;
+      entry.offset = hessianSize;
+      hessianSize += entry.rows * entry.cols;
+      hessians_.push_back(entry);
+    }
+    maxRows_ = std::max(maxRows_, entry.rows);
+    maxCols_ = std::max(maxCols_, entry.cols);
+  }
+
+  // Second pass: copy the numerical values into the contiguous streams.
+  // Jacobians are stored whitened, so A'A at apply time needs no noise model.
+  jacobianStorage_.resize(jacobianSize);
+  hessianStorage_.resize(hessianSize);
+  size_t nrJacobians = 0, nrHessians = 0;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor || factor->empty())
+      continue;
+    const JacobianFactor* jacobian =
+        dynamic_cast<const JacobianFactor*>(factor.get());
+    if (jacobian) {
+      const CompiledFactor& entry = jacobians_[nrJacobians++];
+      Eigen::Map<Matrix>(jacobianStorage_.data() + entry.offset, entry.rows,
+          entry.cols) = jacobian->jacobian().first;
+    } else {
+      const CompiledFactor& entry = hessians_[nrHessians++];
+      Eigen::Map<Matrix>(hessianStorage_.data() + entry.offset, entry.rows,
+          entry.cols) = factor->information();
+    }
+  }
+}
+
+/* ************************************************************************* */
+void HessianOperator::multiplyHessianAdd(double alpha, const Vector& x,
+    Vector& y) const {
+  if (x.size() != (DenseIndex) numCols() || y.size() != (DenseIndex) numCols())
+    throw invalid_argument(
+        "HessianOperator::multiplyHessianAdd: flat vector size mismatch");
+
+  // Scratch reused across all factors in this call
+  Vector xLocal(maxCols_), yLocal(maxCols_), Ax(maxRows_);
+
+  // Jacobian stream: y += alpha * A' * (A * x), two products per factor
+  // over one contiguous matrix
+  for (const CompiledFactor& entry : jacobians_) {
+    DenseIndex col = 0;
+    for (const pair<DenseIndex, DenseIndex>& block : entry.blocks) {
+      xLocal.segment(col, block.second) = x.segment(block.first, block.second);
+      col += block.second;
+    }
+    Eigen::Map<const Matrix> A(jacobianStorage_.data() + entry.offset,
+        entry.rows, entry.cols);
+    Ax.head(entry.rows).noalias() = A * xLocal.head(entry.cols);
+    yLocal.head(entry.cols).noalias() = alpha * A.transpose()
+        * Ax.head(entry.rows);
+    col = 0;
+    for (const pair<DenseIndex, DenseIndex>& block : entry.blocks) {
+      y.segment(block.first, block.second) += yLocal.segment(col, block.second);
+      col += block.second;
+    }
+  }
+
+  // Information stream: y += alpha * H * x, one product per factor
+  for (const CompiledFactor& entry : hessians_) {
+    DenseIndex col = 0;
+    for (const pair<DenseIndex, DenseIndex>& block : entry.blocks) {
+      xLocal.segment(col, block.second) = x.segment(block.first, block.second);
+      col += block.second;
+    }
+    Eigen::Map<const Matrix> H(hessianStorage_.data() + entry.offset,
+        entry.rows, entry.cols);
+    yLocal.head(entry.cols).noalias() = alpha * H * xLocal.head(entry.cols);
+    col = 0;
+    for (const pair<DenseIndex, DenseIndex>& block : entry.blocks) {
+      y.segment(block.first, block.second) += yLocal.segment(col, block.second);
+      col += block.second;
+    }
+  }
+}
+
+/* ************************************************************************* */
+void HessianOperator::multiplyHessianAdd(double alpha, const VectorValues& x,
+    VectorValues& y) const {
+  // Gather into the flat layout, apply, and scatter-add the result
+  Vector xFlat(numCols()), yFlat = Vector::Zero(numCols());
+  for (const KeyInfo::value_type& entry : keyInfo_)
+    xFlat.segment(entry.second.start, entry.second.dim) = x.at(entry.first);
+
+  multiplyHessianAdd(alpha, xFlat, yFlat);
+
+  for (const KeyInfo::value_type& entry : keyInfo_) {
+    const Vector yj = yFlat.segment(entry.second.start, entry.second.dim);
+    VectorValues::iterator it = y.find(entry.first);
+    if (it != y.end())
+      it->second += yj;
+    else
+      y.emplace(entry.first, yj);
+  }
+}
+
+/* ************************************************************************* */
+
+}  // namespace gtsam
@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file HessianOperator.h
+ * @brief Compiled Hessian-vector product operator for matrix-free solvers
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/FastVector.h>
+
+namespace gtsam {
+
+/**
+ * A compiled form of GaussianFactorGraph::multiplyHessianAdd for iterative
+ * solvers.  The generic path loops over factors calling a virtual per-factor
+ * multiply with VectorValues temporaries, so every conjugate-gradient
+ * iteration pays virtual dispatch, map lookups, and scattered block access.
+ * This operator does the symbolic work once at construction: factor blocks
+ * are flattened into two type-segregated contiguous streams - whitened
+ * Jacobians for JacobianFactor and derived types, dense information matrices
+ * for everything else - together with a schedule of column offsets into a
+ * flat vector laid out by KeyInfo.  Applying the operator is then a sequence
+ * of long dense matrix-vector products over contiguous storage, with only
+ * small gather/scatter loops in between.
+ *
+ * The operator captures the numerical values of the factors at construction;
+ * rebuild it after relinearization.
+ */
+class GTSAM_EXPORT HessianOperator {
+ public:
+  /// Compile the graph, laying out the flat vector with KeyInfo(gfg)
+  explicit HessianOperator(const GaussianFactorGraph& gfg);
+
+  /// Compile the graph with an existing KeyInfo (must cover all keys in gfg)
+  HessianOperator(const GaussianFactorGraph& gfg, const KeyInfo& keyInfo);
+
+  /// The layout of the flat vectors accepted by the raw interface
+  const KeyInfo& keyInfo() const { return keyInfo_; }
+
+  /// Number of scalar variables, i.e. the length of the flat vectors
+  size_t numCols() const { return keyInfo_.numCols(); }
+
+  /**
+   * y += alpha * H * x over flat vectors of length numCols(), laid out
+   * according to keyInfo().  This is the inner loop of conjugate gradients.
+   */
+  void multiplyHessianAdd(double alpha, const Vector& x, Vector& y) const;
+
+  /// y += alpha * H * x, gathering from and scattering to VectorValues
+  void multiplyHessianAdd(double alpha, const VectorValues& x,
+      VectorValues& y) const;
+
+ private:
+  /// Schedule entry for one compiled factor: where its matrix lives in the
+  /// stream and which segments of the flat vector it touches
+  struct CompiledFactor {
+    DenseIndex offset;  ///< start of the factor's matrix in the stream
+    DenseIndex rows;    ///< matrix rows (equals cols for information matrices)
+    DenseIndex cols;    ///< total width, the sum of the block dimensions
+    FastVector<std::pair<DenseIndex, DenseIndex> > blocks;  ///< (start, dim) per key
+  };
+
+  void compile(const GaussianFactorGraph& gfg);
+
+  KeyInfo keyInfo_;
+  Vector jacobianStorage_;  ///< whitened Jacobians, one column-major matrix each
+  Vector hessianStorage_;   ///< dense information matrices, column-major
+  FastVector<CompiledFactor> jacobians_;
+  FastVector<CompiledFactor> hessians_;
+  DenseIndex maxRows_, maxCols_;  ///< scratch sizes for the apply loop
+};
+
+}  // namespace gtsam
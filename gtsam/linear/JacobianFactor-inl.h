@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/linear/linearExceptions.h>
+#include <gtsam/linear/EliminationWorkspace.h>
 
 namespace gtsam {
 
@@ -75,8 +76,13 @@ namespace gtsam {
       dimensions.push_back(Ai.cols());
     }
 
-    // Construct block matrix
-    Ab_ = VerticalBlockMatrix(dimensions, b.size(), true);
+    // Construct block matrix, borrowing a recycled buffer from the per-thread workspace pool
+    // if one of the right size is available
+    DenseIndex totalCols = 1;
+    for(size_t dim: dimensions)
+      totalCols += dim;
+    Ab_ = VerticalBlockMatrix(dimensions, b.size(),
+        EliminationWorkspace::Acquire(b.size(), totalCols), true);
 
     // Check and add terms
     DenseIndex i = 0; // For block index
@@ -18,10 +18,12 @@
  */
 
 #include <gtsam/linear/linearExceptions.h>
+#include <gtsam/linear/EliminationWorkspace.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/Scatter.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/IterativeSolver.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/VariableSlots.h>
 #include <gtsam/inference/Ordering.h>
@@ -101,6 +103,36 @@ JacobianFactor::JacobianFactor(const Key i1, const Matrix& A1, Key i2,
       b, model);
 }
 
+/* ************************************************************************* */
+JacobianFactor::~JacobianFactor() {
+  EliminationWorkspace::Release(std::move(Ab_.matrix()));
+}
+
+/* ************************************************************************* */
+JacobianFactor::JacobianFactor(KeyVector&& keys,
+    VerticalBlockMatrix&& augmentedMatrix, SharedDiagonal&& model) {
+  // Check noise model dimension
+  if (model && (DenseIndex)model->dim() != augmentedMatrix.rows())
+    throw InvalidNoiseModel(augmentedMatrix.rows(), model->dim());
+
+  // Check number of variables
+  if ((DenseIndex)keys.size() != augmentedMatrix.nBlocks() - 1)
+    throw std::invalid_argument(
+        "Error in JacobianFactor constructor input.  Number of provided keys plus\n"
+        "one for the RHS vector must equal the number of provided matrix blocks.");
+
+  // Check RHS dimension
+  if (augmentedMatrix(augmentedMatrix.nBlocks() - 1).cols() != 1)
+    throw std::invalid_argument(
+        "Error in JacobianFactor constructor input.  The last provided matrix block\n"
+        "must be the RHS vector, but the last provided block had more than one column.");
+
+  // Take ownership of the storage
+  Base::keys_ = std::move(keys);
+  Ab_ = std::move(augmentedMatrix);
+  model_ = std::move(model);
+}
+
 /* ************************************************************************* */
 JacobianFactor::JacobianFactor(const HessianFactor& factor)
     : Base(factor),
@@ -234,7 +266,9 @@ void JacobianFactor::JacobianFactorHelper(const GaussianFactorGraph& graph,
 
   // Allocate matrix and copy keys in order
   gttic(allocate);
-  Ab_ = VerticalBlockMatrix(varDims, m, true); // Allocate augmented matrix
+  // Allocate augmented matrix, borrowing a recycled buffer from the per-thread workspace pool
+  // if one of the right size is available
+  Ab_ = VerticalBlockMatrix(varDims, m, EliminationWorkspace::Acquire(m, n + 1), true);
   Base::keys_.resize(orderedSlots.size());
   boost::range::copy(
       // Get variable keys
@@ -557,6 +591,22 @@ VectorValues JacobianFactor::hessianDiagonal() const {
   return d;
 }
 
+/* ************************************************************************* */
+void JacobianFactor::addHessianDiagonalTo(const KeyInfo& keyInfo,
+    double* d) const {
+  for (size_t pos = 0; pos < size(); ++pos) {
+    const KeyInfoEntry& entry = keyInfo.find(keys_[pos])->second;
+    const size_t nj = Ab_(pos).cols();
+    Eigen::Map<Vector> dj(d + entry.start, nj);
+    for (size_t k = 0; k < nj; ++k) {
+      Vector column_k = Ab_(pos).col(k);
+      if (model_)
+        model_->whitenInPlace(column_k);
+      dj(k) += dot(column_k, column_k);
+    }
+  }
+}
+
 /* ************************************************************************* */
 // Raw memory access version should be called in Regular Factors only currently
 void JacobianFactor::hessianDiagonal(double* d) const {
@@ -579,6 +629,20 @@ map<Key, Matrix> JacobianFactor::hessianBlockDiagonal() const {
 /* ************************************************************************* */
 void JacobianFactor::updateHessian(const KeyVector& infoKeys,
                                    SymmetricBlockMatrix* info) const {
+  if (rows() == 0) return;
+
+  // Resolve the destination slot of each variable, then apply indexed updates
+  const DenseIndex n = size();
+  vector<DenseIndex> slots(n + 1);
+  for (DenseIndex j = 0; j < n; ++j)
+    slots[j] = Slot(infoKeys, keys_[j]);
+  slots[n] = info->nBlocks() - 1; // RHS block
+  updateHessian(infoKeys, slots, info);
+}
+
+/* ************************************************************************* */
+void JacobianFactor::updateHessian(const KeyVector& infoKeys,
+    const vector<DenseIndex>& slots, SymmetricBlockMatrix* info) const {
   gttic(updateHessian_JacobianFactor);
 
   if (rows() == 0) return;
@@ -591,23 +655,20 @@ void JacobianFactor::updateHessian(const KeyVector& infoKeys,
           "JacobianFactor::updateHessian: cannot update information with "
           "constrained noise model");
     JacobianFactor whitenedFactor = whiten();
-    whitenedFactor.updateHessian(infoKeys, info);
+    whitenedFactor.updateHessian(infoKeys, slots, info);
   } else {
     // Ab_ is the augmented Jacobian matrix A, and we perform I += A'*A below
-    DenseIndex n = Ab_.nBlocks() - 1, N = info->nBlocks() - 1;
+    DenseIndex n = Ab_.nBlocks() - 1;
+    assert(slots.size() == size_t(n + 1));
 
     // Apply updates to the upper triangle
     // Loop over blocks of A, including RHS with j==n
-    vector<DenseIndex> slots(n+1);
     for (DenseIndex j = 0; j <= n; ++j) {
       Eigen::Block<const Matrix> Ab_j = Ab_(j);
-      const DenseIndex J = (j == n) ? N : Slot(infoKeys, keys_[j]);
-      slots[j] = J;
+      const DenseIndex J = slots[j];
       // Fill off-diagonal blocks with Ai'*Aj
-      for (DenseIndex i = 0; i < j; ++i) {
-        const DenseIndex I = slots[i];  // because i<j, slots[i] is valid.
-        info->updateOffDiagonalBlock(I, J, Ab_(i).transpose() * Ab_j);
-      }
+      for (DenseIndex i = 0; i < j; ++i)
+        info->updateOffDiagonalBlock(slots[i], J, Ab_(i).transpose() * Ab_j);
       // Fill diagonal block with Aj'*Aj
       info->diagonalBlock(J).rankUpdate(Ab_j.transpose());
     }
@@ -621,11 +682,22 @@ Vector JacobianFactor::operator*(const VectorValues& x) const {
   if (empty())
     return Ax;
 
-  // Just iterate over all A matrices and multiply in correct config part
+  // Gather the relevant subvectors of x into one stacked vector, then do a
+  // single product against the lazily maintained row-major mirror of Ab_.
+  // gtsam::Matrix is column-major, so transposeMultiplyAdd below already
+  // streams memory contiguously; the mirror gives A*x the same property,
+  // which matters when both are called every CG iteration.
+  const DenseIndex startCol = Ab_.offset(0);
+  const DenseIndex n = Ab_.offset(size()) - startCol;
+  Vector xStacked(n);
+  DenseIndex col = 0;
   for (size_t pos = 0; pos < size(); ++pos) {
-    // http://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-    Ax.noalias() += Ab_(pos) * x[keys_[pos]];
+    const Vector& xj = x[keys_[pos]];
+    xStacked.segment(col, xj.size()) = xj;
+    col += xj.size();
   }
+  const MatrixRowMajor& A = Ab_.rowMajorMirror();
+  Ax.noalias() = A.block(Ab_.rowStart(), startCol, Ab_.rows(), n) * xStacked;
 
   if (model_) model_->whitenInPlace(Ax);
   return Ax;
@@ -714,6 +786,48 @@ VectorValues JacobianFactor::gradientAtZero() const {
   return g;
 }
 
+/* ************************************************************************* */
+void JacobianFactor::addGradientAtZeroTo(const KeyInfo& keyInfo,
+    double* g) const {
+  if (empty())
+    return;
+  Vector b = getb();
+  // Deal with noise properly: whitening twice divides by the variance, which
+  // is exact for diagonal models, as in the raw multiplyHessianAdd
+  if (model_) {
+    model_->whitenInPlace(b);
+    model_->whitenInPlace(b);
+  }
+  for (size_t pos = 0; pos < size(); ++pos) {
+    const KeyInfoEntry& entry = keyInfo.find(keys_[pos])->second;
+    Eigen::Map<Vector>(g + entry.start, entry.dim) -=
+        Ab_(pos).transpose() * b;
+  }
+}
+
+/* ************************************************************************* */
+void JacobianFactor::addGradientTo(const KeyInfo& keyInfo, const double* x,
+    double* g) const {
+  if (empty())
+    return;
+  // e = A*x - b, accumulated block by block over the flat layout
+  Vector e = -getb();
+  for (size_t pos = 0; pos < size(); ++pos) {
+    const KeyInfoEntry& entry = keyInfo.find(keys_[pos])->second;
+    e += Ab_(pos) * Eigen::Map<const Vector>(x + entry.start, entry.dim);
+  }
+  // Whitening twice divides by the variance, exact for diagonal models
+  if (model_) {
+    model_->whitenInPlace(e);
+    model_->whitenInPlace(e);
+  }
+  for (size_t pos = 0; pos < size(); ++pos) {
+    const KeyInfoEntry& entry = keyInfo.find(keys_[pos])->second;
+    Eigen::Map<Vector>(g + entry.start, entry.dim) +=
+        Ab_(pos).transpose() * e;
+  }
+}
+
 /* ************************************************************************* */
 // Raw memory access version should be called in Regular Factors only currently
 void JacobianFactor::gradientAtZero(double* d) const {
@@ -39,6 +39,7 @@ namespace gtsam {
   class VectorValues;
   class Ordering;
   class JacobianFactor;
+  class KeyInfo;
 
   /**
    * Multiply all factors and eliminate the given keys from the resulting factor using a QR
@@ -150,6 +151,13 @@ namespace gtsam {
     JacobianFactor(
       const KEYS& keys, const VerticalBlockMatrix& augmentedMatrix, const SharedDiagonal& sigmas = SharedDiagonal());
 
+    /** Constructor that takes ownership of the provided keys and augmented matrix, avoiding the
+     *  block-matrix copy made by the constructor above.  Useful for custom linearizers that
+     *  assemble the augmented matrix themselves and hand it over, e.g. via
+     *  GaussianFactorGraph::emplace_shared<JacobianFactor>(...). */
+    JacobianFactor(KeyVector&& keys, VerticalBlockMatrix&& augmentedMatrix,
+      SharedDiagonal&& sigmas = SharedDiagonal());
+
     /**
      * Build a dense joint factor from all the factors in a factor graph.  If a VariableSlots
      * structure computed for \c graph is already available, providing it will reduce the amount of
@@ -182,8 +190,8 @@ namespace gtsam {
       const Ordering& ordering,
       const VariableSlots& p_variableSlots);
 
-    /** Virtual destructor */
-    virtual ~JacobianFactor() {}
+    /** Destructor - returns the dense buffer to the per-thread elimination workspace pool */
+    virtual ~JacobianFactor();
 
     /** Clone this JacobianFactor */
     virtual GaussianFactor::shared_ptr clone() const {
@@ -221,6 +229,14 @@ namespace gtsam {
     /// Raw memory access version of hessianDiagonal
     virtual void hessianDiagonal(double* d) const;
 
+    /** Accumulate the Hessian diagonal of this factor into a caller-provided
+     * flat buffer laid out by the column start offsets in \c keyInfo, without
+     * building an intermediate VectorValues.  Unlike the raw
+     * hessianDiagonal() overload this does not require regular (fixed-size)
+     * variables, so it can be called per factor when assembling a Jacobi
+     * preconditioner over an arbitrary graph. */
+    void addHessianDiagonalTo(const KeyInfo& keyInfo, double* d) const;
+
     /// Return the block diagonal of the Hessian for this factor
     virtual std::map<Key,Matrix> hessianBlockDiagonal() const;
 
@@ -260,6 +276,11 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     virtual bool empty() const { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Approximate heap bytes: the keys plus the augmented matrix [A b] */
+    virtual size_t memoryUsage() const {
+      return Base::memoryUsage() + Ab_.matrix().size() * sizeof(double);
+    }
+
     /** is noise model constrained ? */
     bool isConstrained() const {
       return model_ && model_->isConstrained();
@@ -311,6 +332,15 @@ namespace gtsam {
      */
     void updateHessian(const KeyVector& keys, SymmetricBlockMatrix* info) const;
 
+    /** Update an information matrix given precomputed destination slots, performing
+     * pure indexed block additions (see GaussianFactor::updateHessian).
+     * @param keys The ordered vector of keys for the information matrix to be updated
+     * @param slots The destination block of \c info for each variable, plus the RHS block
+     * @param info The information matrix to be updated
+     */
+    void updateHessian(const KeyVector& keys, const std::vector<DenseIndex>& slots,
+        SymmetricBlockMatrix* info) const;
+
     /** Return A*x */
     Vector operator*(const VectorValues& x) const;
 
@@ -338,6 +368,20 @@ namespace gtsam {
     /// A'*b for Jacobian (raw memory version)
     virtual void gradientAtZero(double* d) const;
 
+    /** Accumulate the gradient at zero, -A'*b/sigma^2, into a caller-provided
+     * flat buffer laid out by the column start offsets in \c keyInfo.  As in
+     * the raw multiplyHessianAdd, the noise is applied by whitening twice,
+     * which is exact for diagonal noise models. */
+    void addGradientAtZeroTo(const KeyInfo& keyInfo, double* g) const;
+
+    /** Accumulate the gradient A'*(A*x-b)/sigma^2 at the flat vector \c x
+     * into the flat buffer \c g, both laid out by the column start offsets in
+     * \c keyInfo, without building intermediate VectorValues.  As in the raw
+     * multiplyHessianAdd, the noise is applied by whitening twice, which is
+     * exact for diagonal noise models. */
+    void addGradientTo(const KeyInfo& keyInfo, const double* x,
+        double* g) const;
+
     /// Compute the gradient wrt a key at any values
     Vector gradient(Key key, const VectorValues& x) const;
 
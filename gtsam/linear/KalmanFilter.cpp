@@ -63,6 +63,20 @@ KalmanFilter::fuse(const State& p, GaussianFactor::shared_ptr newFactor) const {
   return solve(factorGraph);
 }
 
+/* ************************************************************************* */
+// Auxiliary function for the fast path: copy the prior in whitened
+// square-root form [R|d] into the top rows of the dense workspace M
+void KalmanFilter::stackPrior(const State& p, Matrix& M) const {
+  const DenseIndex rhs = M.cols() - 1;
+  if (p->get_model()) {
+    M.topLeftCorner(n_, n_) = p->get_model()->Whiten(Matrix(p->R()));
+    M.col(rhs).head(n_) = p->get_model()->whiten(p->d());
+  } else {
+    M.topLeftCorner(n_, n_) = p->R();
+    M.col(rhs).head(n_) = p->d();
+  }
+}
+
 /* ************************************************************************* */
 KalmanFilter::State KalmanFilter::init(const Vector& x0,
     const SharedDiagonal& P0) const {
@@ -133,6 +147,33 @@ KalmanFilter::State KalmanFilter::predict2(const State& p, const Matrix& A0,
   return fuse(p, boost::make_shared<JacobianFactor>(k, A0, k + 1, A1, b, model));
 }
 
+/* ************************************************************************* */
+KalmanFilter::State KalmanFilter::predictFast(const State& p, const Matrix& F,
+    const Matrix& B, const Vector& u, const SharedDiagonal& modelQ) const {
+
+  // Stack the whitened prior |R*x_t - d|^2 and whitened motion model
+  // |Q^{-1/2} (x_{t+1} - F*x_t - B*u)|^2 into one dense (2n) x (2n+1)
+  // system ordered [x_t, x_{t+1}, rhs] ...
+  Matrix M = Matrix::Zero(2 * n_, 2 * n_ + 1);
+  stackPrior(p, M);
+  if (modelQ) {
+    M.block(n_, 0, n_, n_) = modelQ->Whiten(-F);
+    M.block(n_, n_, n_, n_) = modelQ->Whiten(I_);
+    M.col(2 * n_).tail(n_) = modelQ->whiten(B * u);
+  } else {
+    M.block(n_, 0, n_, n_) = -F;
+    M.block(n_, n_, n_, n_) = I_;
+    M.col(2 * n_).tail(n_) = B * u;
+  }
+
+  // ... and triangularize it in place. The bottom-right n rows are the
+  // marginal square-root information form of x_{t+1}
+  inplace_QR(M);
+  const Matrix R1 = M.block(n_, n_, n_, n_);
+  const Vector d1 = M.col(2 * n_).tail(n_);
+  return boost::make_shared<GaussianDensity>(step(p) + 1, d1, R1);
+}
+
 /* ************************************************************************* */
 KalmanFilter::State KalmanFilter::update(const State& p, const Matrix& H,
     const Vector& z, const SharedDiagonal& model) const {
@@ -143,6 +184,29 @@ KalmanFilter::State KalmanFilter::update(const State& p, const Matrix& H,
   return fuse(p, boost::make_shared<JacobianFactor>(k, H, z, model));
 }
 
+/* ************************************************************************* */
+KalmanFilter::State KalmanFilter::updateFast(const State& p, const Matrix& H,
+    const Vector& z, const SharedDiagonal& model) const {
+
+  // Append the whitened measurement rows [H|z] below the prior [R|d] and
+  // re-triangularize the stacked (n+m) x (n+1) system in place
+  const DenseIndex m = H.rows();
+  Matrix M(n_ + m, n_ + 1);
+  stackPrior(p, M);
+  if (model) {
+    M.block(n_, 0, m, n_) = model->Whiten(H);
+    M.col(n_).tail(m) = model->whiten(z);
+  } else {
+    M.block(n_, 0, m, n_) = H;
+    M.col(n_).tail(m) = z;
+  }
+
+  inplace_QR(M);
+  const Matrix R1 = M.topLeftCorner(n_, n_);
+  const Vector d1 = M.col(n_).head(n_);
+  return boost::make_shared<GaussianDensity>(step(p), d1, R1);
+}
+
 /* ************************************************************************* */
 KalmanFilter::State KalmanFilter::updateQ(const State& p, const Matrix& H,
     const Vector& z, const Matrix& Q) const {
@@ -64,6 +64,10 @@ private:
   State solve(const GaussianFactorGraph& factorGraph) const;
   State fuse(const State& p, GaussianFactor::shared_ptr newFactor) const;
 
+  /// Copy the whitened square-root information form [R|d] of p into the
+  /// top-left and right-most columns of the dense workspace M
+  void stackPrior(const State& p, Matrix& M) const;
+
 public:
 
   // Constructor
@@ -124,6 +128,17 @@ public:
   State predict2(const State& p, const Matrix& A0, const Matrix& A1,
       const Vector& b, const SharedDiagonal& model) const;
 
+  /**
+   * Square-root information fast path for predict().
+   * Stacks the whitened prior [R|d] and motion model into one dense
+   * (2n) x (2n+1) workspace ordered [x_t, x_{t+1}, rhs] and triangularizes
+   * it with inplace_QR, without building a factor graph or running
+   * elimination. Intended for high-rate filtering loops; predict() remains
+   * as the reference implementation and yields the same density.
+   */
+  State predictFast(const State& p, const Matrix& F, const Matrix& B,
+      const Vector& u, const SharedDiagonal& modelQ) const;
+
   /**
    * Update Kalman filter with a measurement
    * For the Kalman Filter, the measurement function, h(x_{t}) = z_{t}
@@ -135,6 +150,17 @@ public:
   State update(const State& p, const Matrix& H, const Vector& z,
       const SharedDiagonal& model) const;
 
+  /**
+   * Square-root information fast path for update().
+   * Appends the whitened measurement rows [H|z] below the prior [R|d] and
+   * re-triangularizes the stacked (n+m) x (n+1) system with inplace_QR,
+   * without building a factor graph. Intended for high-rate filtering
+   * loops; update() remains as the reference implementation and yields the
+   * same density.
+   */
+  State updateFast(const State& p, const Matrix& H, const Vector& z,
+      const SharedDiagonal& model) const;
+
   /*
    *  Version of update with full covariance
    *  Q is normally derived as G*w*G^T where w models uncertainty of some
@@ -175,6 +175,14 @@ double Huber::weight(double error) const {
   return (absError <= k_) ? (1.0) : (k_ / absError);
 }
 
+Vector Huber::weight(const Vector &error) const {
+  // Vectorized kernel, one dispatch for the whole residual vector
+  const Eigen::ArrayXd absError = error.array().abs();
+  return (absError <= k_)
+      .select(Eigen::ArrayXd::Ones(error.size()), k_ / absError)
+      .matrix();
+}
+
 double Huber::residual(double error) const {
   const double absError = std::abs(error);
   if (absError <= k_) {  // |x| <= k
@@ -212,6 +220,11 @@ double Cauchy::weight(double error) const {
   return ksquared_ / (ksquared_ + error*error);
 }
 
+Vector Cauchy::weight(const Vector &error) const {
+  // Vectorized kernel, one dispatch for the whole residual vector
+  return (ksquared_ / (error.array().square() + ksquared_)).matrix();
+}
+
 double Cauchy::residual(double error) const {
   const double val = std::log1p(error * error / ksquared_);
   return ksquared_ * val * 0.5;
@@ -249,6 +262,15 @@ double Tukey::weight(double error) const {
   return 0.0;
 }
 
+Vector Tukey::weight(const Vector &error) const {
+  // Vectorized kernel, one dispatch for the whole residual vector
+  const Eigen::ArrayXd one_minus_xc2 =
+      -error.array().square() / csquared_ + 1.0;
+  return (error.array().abs() <= c_)
+      .select(one_minus_xc2.square(), Eigen::ArrayXd::Zero(error.size()))
+      .matrix();
+}
+
 double Tukey::residual(double error) const {
   double absError = std::abs(error);
   if (absError <= c_) {
@@ -98,8 +98,10 @@ class GTSAM_EXPORT Base {
   double sqrtWeight(double error) const { return std::sqrt(weight(error)); }
 
   /** produce a weight vector according to an error vector and the implemented
-   * robust function */
-  Vector weight(const Vector &error) const;
+   * robust function.  The default implementation loops over the scalar weight;
+   * losses on hot whitening paths override this with a vectorized kernel so
+   * that virtual dispatch happens once per residual vector, not per element. */
+  virtual Vector weight(const Vector &error) const;
 
   /** square root version of the weight function */
   Vector sqrtWeight(const Vector &error) const {
@@ -131,6 +133,9 @@ class GTSAM_EXPORT Null : public Base {
   Null(const ReweightScheme reweight = Block) : Base(reweight) {}
   ~Null() {}
   double weight(double /*error*/) const { return 1.0; }
+  Vector weight(const Vector &error) const override {
+    return Vector::Ones(error.size());
+  }
   double residual(double error) const { return error; }
   void print(const std::string &s) const;
   bool equals(const Base & /*expected*/, double /*tol*/) const { return true; }
@@ -180,6 +185,7 @@ class GTSAM_EXPORT Huber : public Base {
 
   Huber(double k = 1.345, const ReweightScheme reweight = Block);
   double weight(double error) const override;
+  Vector weight(const Vector &error) const override;
   double residual(double error) const override;
   void print(const std::string &s) const override;
   bool equals(const Base &expected, double tol = 1e-8) const override;
@@ -210,6 +216,7 @@ class GTSAM_EXPORT Cauchy : public Base {
 
   Cauchy(double k = 0.1, const ReweightScheme reweight = Block);
   double weight(double error) const override;
+  Vector weight(const Vector &error) const override;
   double residual(double error) const override;
   void print(const std::string &s) const override;
   bool equals(const Base &expected, double tol = 1e-8) const override;
@@ -235,6 +242,7 @@ class GTSAM_EXPORT Tukey : public Base {
 
   Tukey(double c = 4.6851, const ReweightScheme reweight = Block);
   double weight(double error) const override;
+  Vector weight(const Vector &error) const override;
   double residual(double error) const override;
   void print(const std::string &s) const override;
   bool equals(const Base &expected, double tol = 1e-8) const override;
@@ -27,9 +27,12 @@
 
 #include <limits>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <typeinfo>
 #include <stdexcept>
 #include <cmath>
+#include <utility>
 
 using namespace std;
 
@@ -180,6 +183,12 @@ void Gaussian::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H = thisR() * H;
 }
 
+/* ************************************************************************* */
+void Gaussian::WhitenInPlaceBatch(std::vector<Matrix>& batch) const {
+  for (Matrix& H : batch)
+    WhitenInPlace(H);
+}
+
 /* ************************************************************************* */
 // General QR, see also special version in Constrained
 SharedDiagonal Gaussian::QR(Matrix& Ab) const {
@@ -307,6 +316,15 @@ void Diagonal::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H = invsigmas().asDiagonal() * H;
 }
 
+/* ************************************************************************* */
+void Diagonal::WhitenInPlaceBatch(std::vector<Matrix>& batch) const {
+  // Broadcast the row scaling over the whole batch with one pass per block and
+  // a single virtual dispatch
+  const Vector& weights = invsigmas();
+  for (Matrix& H : batch)
+    H.array().colwise() *= weights.array();
+}
+
 /* ************************************************************************* */
 // Constrained
 /* ************************************************************************* */
@@ -402,6 +420,13 @@ void Constrained::WhitenInPlace(Eigen::Block<Matrix> H) const {
       H.row(i) *= invsigmas_(i);
 }
 
+/* ************************************************************************* */
+void Constrained::WhitenInPlaceBatch(std::vector<Matrix>& batch) const {
+  // Constrained rows must be left untouched, so whiten block by block
+  for (Matrix& H : batch)
+    WhitenInPlace(H);
+}
+
 /* ************************************************************************* */
 Constrained::shared_ptr Constrained::unit() const {
   Vector sigmas = Vector::Ones(dim());
@@ -559,13 +584,34 @@ SharedDiagonal Constrained::QR(Matrix& Ab) const {
 // Isotropic
 /* ************************************************************************* */
 Isotropic::shared_ptr Isotropic::Sigma(size_t dim, double sigma, bool smart)  {
-  if (smart && std::abs(sigma-1.0)<1e-9) return Unit::Create(dim);
+  if (smart) {
+    if (std::abs(sigma-1.0)<1e-9) return Unit::Create(dim);
+    // Front ends construct millions of factors from a handful of distinct
+    // (dim, sigma) pairs, so intern the models and hand out shared
+    // singletons instead of allocating duplicates.  The models are
+    // immutable, so sharing is safe; the mutex allows factor construction
+    // from multiple threads, and the cache is bounded so pathological
+    // inputs cannot grow it without limit.
+    typedef std::map<std::pair<size_t, double>, shared_ptr> Cache;
+    static Cache cache;
+    static std::mutex cacheMutex;
+    const std::pair<size_t, double> key(dim, sigma);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    Cache::const_iterator item = cache.find(key);
+    if (item != cache.end()) return item->second;
+    shared_ptr model(new Isotropic(dim, sigma));
+    if (cache.size() < 100) cache.insert(std::make_pair(key, model));
+    return model;
+  }
   return shared_ptr(new Isotropic(dim, sigma));
 }
 
 /* ************************************************************************* */
 Isotropic::shared_ptr Isotropic::Variance(size_t dim, double variance, bool smart)  {
-  if (smart && std::abs(variance-1.0)<1e-9) return Unit::Create(dim);
+  if (smart) {
+    if (std::abs(variance-1.0)<1e-9) return Unit::Create(dim);
+    return Sigma(dim, sqrt(variance), smart); // shares the interning cache
+  }
   return shared_ptr(new Isotropic(dim, sqrt(variance)));
 }
 
@@ -609,8 +655,26 @@ void Isotropic::WhitenInPlace(Eigen::Block<Matrix> H) const {
   H *= invsigma_;
 }
 
+/* ************************************************************************* */
+void Isotropic::WhitenInPlaceBatch(std::vector<Matrix>& batch) const {
+  for (Matrix& H : batch)
+    H *= invsigma_;
+}
+
 /* ************************************************************************* */
 // Unit
+/* ************************************************************************* */
+Unit::shared_ptr Unit::Create(size_t dim) {
+  // Preconstructed singletons for the common small dimensions; unit models
+  // carry no state beyond their dimension, so sharing is safe
+  static const shared_ptr units[6] = { //
+      shared_ptr(new Unit(1)), shared_ptr(new Unit(2)), shared_ptr(new Unit(3)),
+      shared_ptr(new Unit(4)), shared_ptr(new Unit(5)), shared_ptr(new Unit(6))};
+  if (dim >= 1 && dim <= 6)
+    return units[dim - 1];
+  return shared_ptr(new Unit(dim));
+}
+
 /* ************************************************************************* */
 void Unit::print(const std::string& name) const {
   cout << name << "unit (" << dim_ << ") " << endl;
@@ -19,14 +19,20 @@
 
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <Eigen/Sparse>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 using namespace std;
 
@@ -40,73 +46,316 @@ void PCGSolverParameters::print(ostream &os) const {
 }
 
 /*****************************************************************************/
-PCGSolver::PCGSolver(const PCGSolverParameters &p) {
+PCGSolver::PCGSolver(const PCGSolverParameters &p) :
+    structuralHash_(0), solvesSinceBuild_(0), previousGradientNorm_(0.0) {
   parameters_ = p;
   preconditioner_ = createPreconditioner(p.preconditioner_);
 }
 
+/*****************************************************************************/
+namespace {
+
+/* A system for preconditionedConjugateGradient that symmetrically rescales
+ * the wrapped system: with S = diag(scale), CG runs on (S A'A S) y = S b and
+ * the caller recovers x = S y.  The scale vector holds the inverse square
+ * roots of the Hessian diagonal (Jacobi equilibration), which normalizes the
+ * mixed per-variable units that otherwise inflate the condition number.  The
+ * wrapped preconditioner is applied unchanged - any SPD preconditioner
+ * remains valid in the scaled space. */
+class EquilibratedSystem {
+public:
+  EquilibratedSystem(const GaussianFactorGraphSystem &system,
+      const Vector &scale) :
+      system_(system), scale_(scale), b_(scale.cwiseProduct(system.b_)),
+      tmp_(scale.size()), Ax_(scale.size()) {
+  }
+
+  void multiply(const Vector &y, Vector &AtAy) const {
+    tmp_ = scale_.cwiseProduct(y);
+    system_.multiply(tmp_, AtAy);
+    AtAy.array() *= scale_.array();
+  }
+
+  void residual(const Vector &y, Vector &r) const {
+    multiply(y, Ax_);
+    r = b_ - Ax_;
+  }
+
+  void leftPrecondition(const Vector &x, Vector &y) const {
+    system_.leftPrecondition(x, y);
+  }
+
+  void rightPrecondition(const Vector &x, Vector &y) const {
+    system_.rightPrecondition(x, y);
+  }
+
+  inline void scal(const double alpha, Vector &x) const {
+    x *= alpha;
+  }
+  inline double dot(const Vector &x, const Vector &y) const {
+    return x.dot(y);
+  }
+  inline void axpy(const double alpha, const Vector &x, Vector &y) const {
+    y += alpha * x;
+  }
+
+  void getb(Vector &b) const {
+    b = b_;
+  }
+
+private:
+  const GaussianFactorGraphSystem &system_;
+  const Vector &scale_;
+  Vector b_; ///< Scaled right-hand side S A'b
+  mutable Vector tmp_; ///< Workspace for the scaled iterate
+  mutable Vector Ax_; ///< Workspace for the Hessian product in residual()
+};
+
+} // namespace
+
 /*****************************************************************************/
 VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
     const VectorValues &initial) {
-  /* build preconditioner */
-  preconditioner_->build(gfg, keyInfo, lambda);
+  /* detect whether this system has the same sparsity as the previous solve */
+  size_t structuralHash = keyInfo.numCols();
+  boost::hash_combine(structuralHash, gfg.size());
+  for (const GaussianFactor::shared_ptr &factor : gfg)
+    if (factor)
+      boost::hash_range(structuralHash, factor->begin(), factor->end());
+  const bool sameStructure = (structuralHash == structuralHash_);
+  structuralHash_ = structuralHash;
+
+  /* build preconditioner, unless a still-valid factorization can be reused */
+  if (!sameStructure || solvesSinceBuild_ >= parameters_.preconditionerLag()) {
+    preconditioner_->build(gfg, keyInfo, lambda);
+    solvesSinceBuild_ = 0;
+  } else {
+    ++solvesSinceBuild_;
+  }
 
-  /* apply pcg */
   GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
+
+  /* warm start: successive outer iterations solve nearby systems, so the
+   * previous solution is a much better initial guess than zero */
   Vector x0 = initial.vector(keyInfo.ordering());
-  const Vector sol = preconditionedConjugateGradient(system, x0, parameters_);
+  if (parameters_.warmStart() && sameStructure
+      && previousSolution_.size() == x0.size())
+    x0 = previousSolution_;
+
+  /* tolerance schedule: loosen/tighten epsilon_rel with the gradient-norm
+   * ratio of consecutive solves, in the spirit of inexact Newton forcing
+   * sequences - no point solving early outer iterations to full accuracy */
+  PCGSolverParameters parameters = parameters_;
+  const double gradientNorm = system.b_.norm();
+  if (parameters_.adaptiveTolerance() && previousGradientNorm_ > 0.0
+      && gradientNorm > 0.0) {
+    const double progress = std::min(1.0,
+        gradientNorm / previousGradientNorm_);
+    parameters.setEpsilon_rel(
+        std::max(parameters_.epsilon_rel() * progress,
+            1e-2 * parameters_.epsilon_rel()));
+  }
+  previousGradientNorm_ = gradientNorm;
+
+  /* apply pcg */
+  Vector sol;
+  if (parameters_.mixedPrecision()) {
+    sol = solveMixedPrecision(system, x0, parameters);
+  } else if (parameters_.equilibrate()) {
+    /* Jacobi equilibration: scale by the inverse square roots of the Hessian
+     * diagonal so the scaled system has unit diagonal, then unscale.  Zero
+     * diagonal entries (unconstrained directions) keep unit scale. */
+    const Vector diagonal = gfg.hessianDiagonal().vector(keyInfo.ordering());
+    Vector scale(diagonal.size());
+    for (DenseIndex i = 0; i < diagonal.size(); ++i)
+      scale[i] = diagonal[i] > 0.0 ? 1.0 / std::sqrt(diagonal[i]) : 1.0;
+    EquilibratedSystem scaledSystem(system, scale);
+    const Vector y0 = x0.cwiseQuotient(scale);
+    const Vector y = preconditionedConjugateGradient(scaledSystem, y0,
+        parameters);
+    sol = scale.cwiseProduct(y);
+  } else {
+    sol = preconditionedConjugateGradient(system, x0, parameters);
+  }
+  previousSolution_ = sol;
 
   return buildVectorValues(sol, keyInfo);
 }
 
+/*****************************************************************************/
+namespace {
+
+/* A system for preconditionedConjugateGradient that holds the whitened
+ * Jacobian in single precision, so the Hessian product A'Ax - the dominant,
+ * memory-bound kernel of the CG iteration - moves half the bytes of the
+ * double system.  The CG recurrences, dot products, and preconditioner
+ * solves stay in double; the accuracy lost to float32 is recovered by the
+ * residual-correction sweeps in PCGSolver::solveMixedPrecision. */
+class MixedPrecisionSystem {
+public:
+
+  MixedPrecisionSystem(const GaussianFactorGraph &gfg,
+      const Preconditioner &preconditioner, const KeyInfo &keyInfo) :
+      preconditioner_(preconditioner), b_(Vector::Zero(keyInfo.numCols())) {
+    // Assemble the whitened Jacobian with the scalar column layout of
+    // keyInfo, so flat vectors are interchangeable with the double system
+    std::vector<Eigen::Triplet<float> > entries;
+    size_t row = 0;
+    for (const GaussianFactor::shared_ptr &factor : gfg) {
+      if (!factor)
+        continue;
+      JacobianFactor::shared_ptr jacobian = boost::dynamic_pointer_cast<
+          JacobianFactor>(factor);
+      if (!jacobian)
+        jacobian = boost::make_shared<JacobianFactor>(*factor);
+      const JacobianFactor whitened(jacobian->whiten());
+      for (JacobianFactor::const_iterator key = whitened.begin();
+          key != whitened.end(); ++key) {
+        JacobianFactor::constABlock A = whitened.getA(key);
+        const size_t columnStart = keyInfo.find(*key)->second.start;
+        for (DenseIndex j = 0; j < A.cols(); ++j)
+          for (DenseIndex i = 0; i < A.rows(); ++i)
+            if (A(i, j) != 0.0)
+              entries.push_back(
+                  Eigen::Triplet<float>(static_cast<int>(row + i),
+                      static_cast<int>(columnStart + j),
+                      static_cast<float>(A(i, j))));
+      }
+      row += whitened.rows();
+    }
+    A_.resize(static_cast<int>(row), static_cast<int>(keyInfo.numCols()));
+    A_.setFromTriplets(entries.begin(), entries.end());
+    xf_.resize(A_.cols());
+    Axf_.resize(A_.rows());
+    Ax_.resize(keyInfo.numCols());
+  }
+
+  void residual(const Vector &x, Vector &r) const {
+    multiply(x, Ax_);
+    r = b_ - Ax_;
+  }
+
+  void multiply(const Vector &x, Vector &AtAx) const {
+    xf_ = x.cast<float>();
+    Axf_.noalias() = A_ * xf_;
+    xf_.noalias() = A_.transpose() * Axf_;
+    AtAx = xf_.cast<double>();
+  }
+
+  void leftPrecondition(const Vector &x, Vector &y) const {
+    preconditioner_.solve(x, y);
+  }
+
+  void rightPrecondition(const Vector &x, Vector &y) const {
+    preconditioner_.transposeSolve(x, y);
+  }
+
+  inline void scal(const double alpha, Vector &x) const {
+    x *= alpha;
+  }
+  inline double dot(const Vector &x, const Vector &y) const {
+    return x.dot(y);
+  }
+  inline void axpy(const double alpha, const Vector &x, Vector &y) const {
+    y += alpha * x;
+  }
+
+  void getb(Vector &b) const {
+    b = b_;
+  }
+
+  /// Right-hand side of the current correction system, set per sweep
+  void setb(const Vector &b) {
+    b_ = b;
+  }
+
+private:
+  const Preconditioner &preconditioner_;
+  Vector b_;
+  Eigen::SparseMatrix<float> A_; ///< Whitened Jacobian in single precision
+  mutable Eigen::VectorXf xf_, Axf_; ///< Float workspaces for the product
+  mutable Vector Ax_; ///< Workspace for the Hessian product in residual()
+};
+
+} // namespace
+
+/*****************************************************************************/
+Vector PCGSolver::solveMixedPrecision(const GaussianFactorGraphSystem &system,
+    const Vector &initial, const PCGSolverParameters &parameters) const {
+  MixedPrecisionSystem floatSystem(system.gfg_, *preconditioner_,
+      system.keyInfo_);
+
+  Vector x = initial;
+  Vector r(x.size()), rhat(x.size());
+
+  /* Each sweep evaluates the residual in double - the step that restores the
+   * accuracy lost to float32 - and solves the correction system A'A d = r
+   * with the float kernel.  One sweep usually reaches the default tolerance;
+   * the cap guards against stagnation on very ill-conditioned systems.  The
+   * stopping rule mirrors preconditionedConjugateGradient: the squared
+   * preconditioned residual norm against the relative threshold of the
+   * first sweep. */
+  static const size_t kMaxSweeps = 3;
+  double threshold = 0.0;
+  for (size_t sweep = 0; sweep < kMaxSweeps; ++sweep) {
+    system.residual(x, r); /* r = b - A'Ax, in double */
+    system.leftPrecondition(r, rhat);
+    const double gamma = rhat.squaredNorm();
+    if (sweep == 0)
+      threshold = std::max(parameters.epsilon_abs(),
+          parameters.epsilon() * parameters.epsilon() * gamma);
+    else if (gamma <= threshold)
+      break;
+    floatSystem.setb(r);
+    const Vector zero = Vector::Zero(x.size());
+    x += preconditionedConjugateGradient(floatSystem, zero, parameters);
+  }
+  return x;
+}
+
 /*****************************************************************************/
 GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
-        lambda) {
+        lambda), vvX_(keyInfo.x0()), vvAtAx_(keyInfo.x0()), Ax_(
+        Vector::Zero(keyInfo.numCols())) {
+  // The right-hand side does not depend on the iterate, so compute it once
+  // instead of on every call to getb()
+  b_ = -gfg_.gradientAtZero().vector(keyInfo_.ordering());
 }
 
 /*****************************************************************************/
 void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
   /* implement b-Ax, assume x and r are pre-allocated */
-
-  /* reset r to b */
-  getb(r);
-
-  /* substract A*x */
-  Vector Ax = Vector::Zero(r.rows(), 1);
-  multiply(x, Ax);
-  r -= Ax;
+  multiply(x, Ax_);
+  r = b_ - Ax_;
 }
 
 /*****************************************************************************/
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
 
-  // Build a VectorValues for Vector x
-  VectorValues vvX = buildVectorValues(x, keyInfo_);
-
-  // VectorValues form of A'Ax for multiplyHessianAdd
-  VectorValues vvAtAx = keyInfo_.x0(); // crucial for performance
+  // Refresh the workspace VectorValues in place from the flat vector, instead
+  // of rebuilding their key maps on every CG iteration
+  for (const KeyInfo::value_type &item: keyInfo_) {
+    vvX_.at(item.first) = x.segment(item.second.start, item.second.dim);
+    vvAtAx_.at(item.first).setZero();
+  }
 
   // vvAtAx += 1.0 * A'Ax for each factor
-  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx);
+  gfg_.multiplyHessianAdd(1.0, vvX_, vvAtAx_);
 
-  // Make the result as Vector form
-  AtAx = vvAtAx.vector(keyInfo_.ordering());
+  // Copy the result back into the pre-allocated flat vector
+  for (const KeyInfo::value_type &item: keyInfo_)
+    AtAx.segment(item.second.start, item.second.dim) = vvAtAx_.at(item.first);
 }
 
 /*****************************************************************************/
 void GaussianFactorGraphSystem::getb(Vector &b) const {
-  /* compute rhs, assume b pre-allocated */
-
-  // Get whitened r.h.s (A^T * b) from each factor in the form of VectorValues
-  VectorValues vvb = gfg_.gradientAtZero();
-
-  // Make the result as Vector form
-  b = -vvb.vector(keyInfo_.ordering());
+  /* return cached rhs, assume b pre-allocated */
+  b = b_;
 }
 
 /**********************************************************************************/
@@ -20,14 +20,15 @@
 #pragma once
 
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/linear/VectorValues.h>
 #include <string>
 
 namespace gtsam {
 
 class GaussianFactorGraph;
+class GaussianFactorGraphSystem;
 class KeyInfo;
 class Preconditioner;
-class VectorValues;
 struct PreconditionerParameters;
 
 /**
@@ -38,7 +39,9 @@ public:
   typedef ConjugateGradientParameters Base;
   typedef boost::shared_ptr<PCGSolverParameters> shared_ptr;
 
-  PCGSolverParameters() {
+  PCGSolverParameters() :
+      warmStart_(true), preconditionerLag_(0), adaptiveTolerance_(false),
+      mixedPrecision_(false), equilibrate_(false) {
   }
 
   virtual void print(std::ostream &os) const;
@@ -48,11 +51,61 @@ public:
     return *preconditioner_;
   }
 
+  inline bool warmStart() const { return warmStart_; }
+  inline size_t preconditionerLag() const { return preconditionerLag_; }
+  inline bool adaptiveTolerance() const { return adaptiveTolerance_; }
+  inline bool mixedPrecision() const { return mixedPrecision_; }
+  inline bool equilibrate() const { return equilibrate_; }
+
+  inline void setWarmStart(bool value) { warmStart_ = value; }
+  inline void setPreconditionerLag(size_t value) { preconditionerLag_ = value; }
+  inline void setAdaptiveTolerance(bool value) { adaptiveTolerance_ = value; }
+  inline void setMixedPrecision(bool value) { mixedPrecision_ = value; }
+  inline void setEquilibrate(bool value) { equilibrate_ = value; }
+
   boost::shared_ptr<PreconditionerParameters> preconditioner_;
+
+  /** start CG from the previous solution instead of zero whenever the system
+   * sparsity is unchanged from the last solve */
+  bool warmStart_;
+
+  /** number of consecutive structurally-identical solves that may reuse the
+   * preconditioner factorization before it is rebuilt (0 rebuilds every
+   * solve).  A slightly stale preconditioner stays symmetric positive
+   * definite, so CG still converges to the exact solution. */
+  size_t preconditionerLag_;
+
+  /** scale epsilon_rel by the gradient-norm ratio of consecutive solves, so
+   * inner iterations stay loose while the outer (e.g. Levenberg-Marquardt)
+   * optimizer is far from convergence and tighten as it makes progress */
+  bool adaptiveTolerance_;
+
+  /** run the CG inner loop against a single-precision copy of the whitened
+   * Jacobian, halving the memory traffic of the dominant Hessian-product
+   * kernel.  Full double accuracy is restored by wrapping the float
+   * iterations in double-precision residual-correction sweeps, so the
+   * converged solution matches the double path to the solver tolerance. */
+  bool mixedPrecision_;
+
+  /** symmetrically rescale the system by the inverse square roots of the
+   * Hessian diagonal before running CG, and unscale the solution afterwards.
+   * Graphs mixing units (pixels, meters, radians) produce Hessians whose
+   * diagonal spans many orders of magnitude; Jacobi equilibration brings the
+   * scaled diagonal to one, which typically cuts the condition number and
+   * with it the CG iteration count.  The rescaling is applied through a
+   * wrapper around the Hessian-product operator, so no factors are copied.
+   * Like the other flags this takes effect through
+   * NonlinearOptimizerParams::iterativeParams.  Ignored on the
+   * mixed-precision path. */
+  bool equilibrate_;
 };
 
 /**
- * A virtual base class for the preconditioned conjugate gradient solver
+ * A virtual base class for the preconditioned conjugate gradient solver.
+ * The solver carries state between calls to optimize (previous solution,
+ * preconditioner factorization, gradient norm), so outer optimizers such as
+ * Levenberg-Marquardt should construct it once and reuse it across
+ * iterations to benefit from warm starts and the tolerance schedule.
  */
 class GTSAM_EXPORT PCGSolver: public IterativeSolver {
 public:
@@ -64,6 +117,17 @@ protected:
   PCGSolverParameters parameters_;
   boost::shared_ptr<Preconditioner> preconditioner_;
 
+  size_t structuralHash_; ///< Sparsity signature of the last solved system
+  size_t solvesSinceBuild_; ///< Solves since the preconditioner was built
+  Vector previousSolution_; ///< Last CG solution, reused as a warm start
+  double previousGradientNorm_; ///< |A'b| of the last system, for the tolerance schedule
+
+  /** Mixed-precision path of optimize(): runs the CG iterations with the
+   * Hessian products evaluated in single precision and recovers full
+   * accuracy through double-precision residual-correction sweeps */
+  Vector solveMixedPrecision(const GaussianFactorGraphSystem &system,
+      const Vector &initial, const PCGSolverParameters &parameters) const;
+
 public:
   /* Interface to initialize a solver without a problem */
   PCGSolver(const PCGSolverParameters &p);
@@ -93,6 +157,13 @@ public:
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
 
+  // Workspace reused across CG iterations, so residual/multiply/getb do not
+  // rebuild key maps or allocate temporaries on every call
+  Vector b_; ///< Cached right-hand side A'*b, independent of the iterate
+  mutable VectorValues vvX_; ///< Workspace for the input of multiplyHessianAdd
+  mutable VectorValues vvAtAx_; ///< Workspace for the output of multiplyHessianAdd
+  mutable Vector Ax_; ///< Workspace for the Hessian product in residual()
+
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
   void leftPrecondition(const Vector &x, Vector &y) const;
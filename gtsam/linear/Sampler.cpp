@@ -62,6 +62,31 @@ Vector Sampler::sample() {
   return sampleDiagonal(sigmas);
 }
 
+/* ************************************************************************* */
+Matrix Sampler::samples(size_t N) {
+  assert(model_.get());
+  const Vector& sigmas = model_->sigmas();
+  const size_t d = sigmas.size();
+  Matrix result(d, N);
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < d; i++) {
+      double sigma = sigmas(i);
+
+      // handle constrained case separately
+      if (sigma == 0.0) {
+        result(i, j) = 0.0;
+      } else {
+        typedef boost::normal_distribution<double> Normal;
+        Normal dist(0.0, sigma);
+        boost::variate_generator<boost::mt19937_64&, Normal> norm(generator_,
+                                                                  dist);
+        result(i, j) = norm();
+      }
+    }
+  }
+  return result;
+}
+
 /* ************************************************************************* */
 Vector Sampler::sampleNewModel(const noiseModel::Diagonal::shared_ptr& model) {
   assert(model.get());
@@ -75,6 +75,15 @@ public:
    */
   Vector sample();
 
+  /**
+   * Draw N samples in one call, returned as the columns of a dim x N matrix.
+   * Produces exactly the same stream as N calls to sample(), but with a
+   * single allocation, so Monte Carlo drivers can pre-draw all their noise
+   * up front.
+   * NOTE: not const due to need to update the underlying generator
+   */
+  Matrix samples(size_t N);
+
   /**
    * Sample from noisemodel passed in as an argument,
    * can be used without having initialized a model for the system.
@@ -40,12 +40,8 @@ Scatter::Scatter(const GaussianFactorGraph& gfg,
     const Ordering& ordering) {
   gttic(Scatter_Constructor);
 
-  // If we have an ordering, pre-fill the ordered variables first
-  for (Key key : ordering) {
-    add(key, 0);
-  }
-
-  // Now, find dimensions of variables and/or extend
+  // Phase 1: collect one (key, dimension) pair per variable slot in the graph
+  FastVector<SlotEntry> slots;
   for (const auto& factor : gfg) {
     if (!factor)
       continue;
@@ -56,20 +52,39 @@ Scatter::Scatter(const GaussianFactorGraph& gfg,
 
     // loop over variables
     for (GaussianFactor::const_iterator variable = factor->begin();
-         variable != factor->end(); ++variable) {
-      const Key key = *variable;
-      iterator it = find(key); // theoretically expensive, yet cache friendly
-      if (it!=end())
-        it->dimension = factor->getDim(variable);
-      else
-        add(key, factor->getDim(variable));
-    }
+         variable != factor->end(); ++variable)
+      slots.emplace_back(SlotEntry(*variable, factor->getDim(variable)));
+  }
+
+  // Phase 2: a single sort plus unique replaces the per-factor linear
+  // searches, which were quadratic for large cliques
+  std::sort(slots.begin(), slots.end());
+  slots.erase(std::unique(slots.begin(), slots.end(),
+                  [](const SlotEntry& p, const SlotEntry& q) {
+                    return p.key == q.key;
+                  }),
+      slots.end());
+
+  // Without an ordering, the slots are exactly the sorted unique variables
+  if (ordering.empty()) {
+    this->swap(slots);
+    return;
+  }
+
+  // Pre-fill the ordered variables first, finding dims by binary search
+  reserve(ordering.size() + slots.size());
+  for (Key key : ordering) {
+    const_iterator it =
+        std::lower_bound(slots.begin(), slots.end(), SlotEntry(key, 0));
+    add(key, (it != slots.end() && it->key == key) ? it->dimension : 0);
   }
 
-  // To keep the same behavior as before, sort the keys after the ordering
-  iterator first = begin();
-  first += ordering.size();
-  if (first != end()) std::sort(first, end());
+  // Append the remaining variables, already sorted by key
+  KeyVector orderedKeys(ordering.begin(), ordering.end());
+  std::sort(orderedKeys.begin(), orderedKeys.end());
+  for (const SlotEntry& slot : slots)
+    if (!std::binary_search(orderedKeys.begin(), orderedKeys.end(), slot.key))
+      push_back(slot);
 }
 
 /* ************************************************************************* */
@@ -77,17 +92,6 @@ void Scatter::add(Key key, size_t dim) {
   emplace_back(SlotEntry(key, dim));
 }
 
-/* ************************************************************************* */
-FastVector<SlotEntry>::iterator Scatter::find(Key key) {
-  iterator it = begin();
-  while(it != end()) {
-    if (it->key == key)
-      return it;
-    ++it;
-  }
-  return it; // end()
-}
-
 /* ************************************************************************* */
 
 } // gtsam
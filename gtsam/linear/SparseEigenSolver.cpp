@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SparseEigenSolver.cpp
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/linear/SparseEigenSolver.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/timing.h>
+
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseQR>
+
+#include <map>
+#include <vector>
+
+namespace gtsam {
+
+typedef Eigen::SparseMatrix<double> SparseMatrixEigen;
+
+/* ************************************************************************* */
+// Assemble the whitened augmented Jacobian [A b] into CSC arrays and record
+// the scalar column layout (variables in increasing key order, rhs last)
+static void assembleCsc(const GaussianFactorGraph& gfg,
+    std::vector<int>& outerIndex, std::vector<int>& innerIndex,
+    std::vector<double>& values, size_t& rows, size_t& cols,
+    std::map<Key, std::pair<size_t, size_t> >& columnLayout) {
+  gttic(SparseEigenSolver_assemble);
+
+  size_t nnz;
+  gfg.sparseJacobianCscDims(rows, cols, nnz);
+  outerIndex.resize(cols + 1);
+  innerIndex.resize(nnz);
+  values.resize(nnz);
+  gfg.sparseJacobianCsc(&outerIndex[0], &innerIndex[0], &values[0]);
+
+  // Reproduce the column layout of sparseJacobianCsc: increasing key order
+  std::map<Key, size_t> dims;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!static_cast<bool>(factor))
+      continue;
+    for (GaussianFactor::const_iterator key = factor->begin();
+        key != factor->end(); ++key)
+      dims[*key] = factor->getDim(key);
+  }
+  size_t currentColumn = 0;
+  for (const std::map<Key, size_t>::value_type& dim : dims) {
+    columnLayout[dim.first] = std::make_pair(currentColumn, dim.second);
+    currentColumn += dim.second;
+  }
+}
+
+/* ************************************************************************* */
+// Scatter the flat solution back onto the graph's keys
+static VectorValues scatterSolution(const Vector& x,
+    const std::map<Key, std::pair<size_t, size_t> >& columnLayout) {
+  VectorValues result;
+  for (const std::map<Key, std::pair<size_t, size_t> >::value_type& entry : columnLayout)
+    result.insert(entry.first,
+        x.segment(entry.second.first, entry.second.second));
+  return result;
+}
+
+/* ************************************************************************* */
+VectorValues optimizeEigenCholesky(const GaussianFactorGraph& gfg) {
+  gttic(SparseEigenSolver_optimizeEigenCholesky);
+
+  std::vector<int> outerIndex, innerIndex;
+  std::vector<double> values;
+  size_t rows, cols;
+  std::map<Key, std::pair<size_t, size_t> > columnLayout;
+  assembleCsc(gfg, outerIndex, innerIndex, values, rows, cols, columnLayout);
+
+  // View the CSC arrays zero-copy and split off the rhs column
+  const Eigen::Map<const SparseMatrixEigen> Ab(rows, cols, innerIndex.size(),
+      &outerIndex[0], &innerIndex[0], &values[0]);
+  const SparseMatrixEigen A = Ab.leftCols(cols - 1);
+  const Vector b = Vector(Ab.rightCols(1));
+
+  gttic(SparseEigenSolver_factorize);
+  Eigen::SimplicialLLT<SparseMatrixEigen> llt;
+  llt.compute(A.transpose() * A);
+  if (llt.info() != Eigen::Success)
+    // Eigen does not report which variable caused the failure
+    throw IndeterminantLinearSystemException(columnLayout.begin()->first);
+  gttoc(SparseEigenSolver_factorize);
+
+  const Vector x = llt.solve(A.transpose() * b);
+  return scatterSolution(x, columnLayout);
+}
+
+/* ************************************************************************* */
+VectorValues optimizeEigenQR(const GaussianFactorGraph& gfg) {
+  gttic(SparseEigenSolver_optimizeEigenQR);
+
+  std::vector<int> outerIndex, innerIndex;
+  std::vector<double> values;
+  size_t rows, cols;
+  std::map<Key, std::pair<size_t, size_t> > columnLayout;
+  assembleCsc(gfg, outerIndex, innerIndex, values, rows, cols, columnLayout);
+
+  const Eigen::Map<const SparseMatrixEigen> Ab(rows, cols, innerIndex.size(),
+      &outerIndex[0], &innerIndex[0], &values[0]);
+  SparseMatrixEigen A = Ab.leftCols(cols - 1);
+  A.makeCompressed();
+  const Vector b = Vector(Ab.rightCols(1));
+
+  gttic(SparseEigenSolver_factorize);
+  Eigen::SparseQR<SparseMatrixEigen, Eigen::COLAMDOrdering<int> > qr(A);
+  if (qr.info() != Eigen::Success)
+    throw IndeterminantLinearSystemException(columnLayout.begin()->first);
+  gttoc(SparseEigenSolver_factorize);
+
+  const Vector x = qr.solve(b);
+  return scatterSolution(x, columnLayout);
+}
+
+} // \ namespace gtsam
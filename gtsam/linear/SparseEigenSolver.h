@@ -0,0 +1,52 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SparseEigenSolver.h
+ * @brief   Bridge from GaussianFactorGraph to Eigen's sparse direct solvers
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+
+namespace gtsam {
+
+/**
+ * Solve the least-squares problem of a GaussianFactorGraph with Eigen's
+ * sparse Cholesky.  The whitened augmented Jacobian [A b] is assembled
+ * straight into compressed sparse column arrays via sparseJacobianCsc and
+ * viewed zero-copy as an Eigen sparse matrix; the normal equations
+ * A'A x = A'b are then factored with Eigen::SimplicialLLT and the solution
+ * mapped back onto the graph's keys.
+ *
+ * Useful on ill-structured graphs where an external supernodal solver beats
+ * the built-in multifrontal elimination; selectable from the nonlinear
+ * optimizers via NonlinearOptimizerParams::EIGEN_CHOLESKY.
+ *
+ * @throws IndeterminantLinearSystemException if the factorization fails.
+ */
+GTSAM_EXPORT VectorValues optimizeEigenCholesky(const GaussianFactorGraph& gfg);
+
+/**
+ * Solve the least-squares problem of a GaussianFactorGraph with Eigen's
+ * sparse QR on the whitened Jacobian, assembled the same way as in
+ * optimizeEigenCholesky.  More expensive than the Cholesky path but does not
+ * square the condition number; selectable via
+ * NonlinearOptimizerParams::EIGEN_QR.
+ *
+ * @throws IndeterminantLinearSystemException if the factorization fails.
+ */
+GTSAM_EXPORT VectorValues optimizeEigenQR(const GaussianFactorGraph& gfg);
+
+} // \ namespace gtsam
@@ -0,0 +1,191 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file StaticFactorGraph.h
+ *
+ * @brief A fully static linear solver for fixed-topology estimators
+ *
+ * Embedded estimators with a graph shape known at compile time - a handful of
+ * states and factor types that never change - cannot afford the dynamic graph
+ * machinery: Key lookups, shared_ptr factors, VerticalBlockMatrix allocation.
+ * StaticFactorGraph takes the variable layout as template parameters and
+ * assembles the normal equations directly into a fixed-size information
+ * matrix, with every block offset computed at compile time and every matrix
+ * on the stack.  Factors contribute their whitened Jacobian blocks through
+ * addUnary()/addBinary(), mirroring what JacobianFactor::updateHessian does
+ * into a SymmetricBlockMatrix, and solve() runs a fixed-size Cholesky
+ * factorization of the whole system.  There is no heap allocation anywhere
+ * in the assemble/solve cycle.
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/linear/linearExceptions.h>
+
+#include <type_traits>
+
+namespace gtsam {
+
+namespace internal {
+
+/// Sum of a compile-time dimension list
+template <int... DIMS>
+struct DimSum;
+template <>
+struct DimSum<> {
+  static const int value = 0;
+};
+template <int D, int... REST>
+struct DimSum<D, REST...> {
+  static const int value = D + DimSum<REST...>::value;
+};
+
+/// Dimension of the I-th entry of a compile-time dimension list
+template <int I, int... DIMS>
+struct NthDim;
+template <int D, int... REST>
+struct NthDim<0, D, REST...> {
+  static const int value = D;
+};
+template <int I, int D, int... REST>
+struct NthDim<I, D, REST...> {
+  static const int value = NthDim<I - 1, REST...>::value;
+};
+
+/// Offset of the I-th entry within the concatenated state vector
+template <int I, int... DIMS>
+struct DimOffset;
+template <int D, int... REST>
+struct DimOffset<0, D, REST...> {
+  static const int value = 0;
+};
+template <int I, int D, int... REST>
+struct DimOffset<I, D, REST...> {
+  static const int value = D + DimOffset<I - 1, REST...>::value;
+};
+
+}  // namespace internal
+
+/**
+ * A linear factor graph over a fixed set of variables with compile-time
+ * dimensions.  Variables are addressed by their position in the DIMS list
+ * instead of by Key; e.g. StaticFactorGraph<3, 3, 2> holds two
+ * 3-dimensional variables (positions 0 and 1) and one 2-dimensional
+ * variable (position 2).  The graph accumulates the Hessian form
+ * H = A'A, eta = A'b of whitened Jacobian factors and solves the normal
+ * equations H x = eta in one fixed-size Cholesky step.
+ */
+template <int... DIMS>
+class StaticFactorGraph {
+ public:
+  /// Total dimension of the concatenated state vector
+  static const int TotalDim = internal::DimSum<DIMS...>::value;
+
+  /// Number of variables
+  static const int NumVariables = sizeof...(DIMS);
+
+  typedef Eigen::Matrix<double, TotalDim, TotalDim> InformationMatrix;
+  typedef Eigen::Matrix<double, TotalDim, 1> StateVector;
+
+  /// Compile-time layout of variable I within the state vector
+  template <int I>
+  struct Variable {
+    static const int Dim = internal::NthDim<I, DIMS...>::value;
+    static const int Offset = internal::DimOffset<I, DIMS...>::value;
+  };
+
+  StaticFactorGraph() { clear(); }
+
+  /// Reset the accumulated system to zero for the next estimator cycle
+  void clear() {
+    H_.setZero();
+    eta_.setZero();
+  }
+
+  /**
+   * Add a whitened unary Jacobian factor |A x_I - b|^2 on variable I.
+   * Factors with a noise model should be whitened by the caller
+   * (A = model->Whiten(A), b = model->whiten(b)) before being added.
+   */
+  template <int I, int M>
+  void addUnary(const Eigen::Matrix<double, M, Variable<I>::Dim>& A,
+                const Eigen::Matrix<double, M, 1>& b) {
+    static const int D = Variable<I>::Dim, O = Variable<I>::Offset;
+    H_.template block<D, D>(O, O).noalias() += A.transpose() * A;
+    eta_.template segment<D>(O).noalias() += A.transpose() * b;
+  }
+
+  /// Add a whitened binary Jacobian factor |A1 x_I + A2 x_J - b|^2
+  template <int I, int J, int M>
+  void addBinary(const Eigen::Matrix<double, M, Variable<I>::Dim>& A1,
+                 const Eigen::Matrix<double, M, Variable<J>::Dim>& A2,
+                 const Eigen::Matrix<double, M, 1>& b) {
+    static const int D1 = Variable<I>::Dim, O1 = Variable<I>::Offset;
+    static const int D2 = Variable<J>::Dim, O2 = Variable<J>::Offset;
+    H_.template block<D1, D1>(O1, O1).noalias() += A1.transpose() * A1;
+    H_.template block<D2, D2>(O2, O2).noalias() += A2.transpose() * A2;
+    H_.template block<D1, D2>(O1, O2).noalias() += A1.transpose() * A2;
+    H_.template block<D2, D1>(O2, O1).noalias() += A2.transpose() * A1;
+    eta_.template segment<D1>(O1).noalias() += A1.transpose() * b;
+    eta_.template segment<D2>(O2).noalias() += A2.transpose() * b;
+  }
+
+  /**
+   * Solve the assembled normal equations H x = eta with a fixed-size
+   * Cholesky factorization and return the full state vector.  Throws
+   * IndeterminantLinearSystemException when the system is singular; the
+   * reported variable is the first one whose diagonal block is not
+   * positive definite (position in the DIMS list, not a Key).
+   */
+  StateVector solve() const {
+    const Eigen::LLT<InformationMatrix> llt(H_);
+    if (llt.info() != Eigen::Success)
+      throw IndeterminantLinearSystemException(firstIndeterminate<0>());
+    return llt.solve(eta_);
+  }
+
+  /// Extract the solution block of variable I from a solved state vector
+  template <int I>
+  static Eigen::Matrix<double, Variable<I>::Dim, 1> at(const StateVector& x) {
+    return x.template segment<Variable<I>::Dim>(Variable<I>::Offset);
+  }
+
+  /// Access the accumulated information matrix, e.g. for covariance recovery
+  const InformationMatrix& information() const { return H_; }
+
+  /// Access the accumulated information vector
+  const StateVector& informationVector() const { return eta_; }
+
+ private:
+  /// Find the first variable whose diagonal block fails Cholesky, for the
+  /// exception raised by solve(); returns 0 when only the joint system fails
+  template <int I>
+  typename std::enable_if<(I < sizeof...(DIMS)), Key>::type
+  firstIndeterminate() const {
+    static const int D = Variable<I>::Dim, O = Variable<I>::Offset;
+    const Eigen::LLT<Eigen::Matrix<double, D, D> > llt(
+        H_.template block<D, D>(O, O));
+    if (llt.info() != Eigen::Success) return I;
+    return firstIndeterminate<I + 1>();
+  }
+  template <int I>
+  typename std::enable_if<(I >= sizeof...(DIMS)), Key>::type
+  firstIndeterminate() const {
+    return 0;
+  }
+
+  InformationMatrix H_;  ///< Accumulated Hessian A'A
+  StateVector eta_;      ///< Accumulated information vector A'b
+};
+
+}  // namespace gtsam
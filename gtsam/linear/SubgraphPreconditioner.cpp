@@ -23,10 +23,14 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/base/types.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/base/DSFVector.h>
+#include <gtsam/inference/Ordering.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 using std::cout;
@@ -93,13 +97,14 @@ static GaussianFactorGraph::shared_ptr convertToJacobianFactors(
 
 /* ************************************************************************* */
 SubgraphPreconditioner::SubgraphPreconditioner(const SubgraphPreconditionerParameters &p) :
-         parameters_(p) {}
+         parameters_(p), structuralHash_(0) {}
 
 /* ************************************************************************* */
 SubgraphPreconditioner::SubgraphPreconditioner(const sharedFG& Ab2,
     const sharedBayesNet& Rc1, const sharedValues& xbar, const SubgraphPreconditionerParameters &p) :
         Ab2_(convertToJacobianFactors(*Ab2)), Rc1_(Rc1), xbar_(xbar),
-        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p) {
+        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p),
+        structuralHash_(0) {
 }
 
 /* ************************************************************************* */
@@ -251,17 +256,98 @@ void SubgraphPreconditioner::transposeSolve(const Vector &y, Vector &x) const {
   }
 }
 
+/*****************************************************************************/
+// Hash of the factor structure only, ignoring the numerical values, used to
+// detect whether the subgraph selection can be carried over between builds
+static size_t structuralHash(const GaussianFactorGraph &gfg) {
+  size_t seed = gfg.size();
+  for (const auto &factor : gfg) {
+    if (!factor) continue;
+    boost::hash_range(seed, factor->begin(), factor->end());
+  }
+  return seed;
+}
+
+/*****************************************************************************/
+Subgraph SubgraphPreconditioner::updateSpanningStructure(
+    const GaussianFactorGraph &gfg) const {
+  const auto inverse_ordering = Ordering::Natural(gfg);
+  const FastMap<Key, size_t> ordering = inverse_ordering.invert();
+  const size_t n = inverse_ordering.size(), m = gfg.size();
+
+  DSFVector dsf(n);
+  vector<size_t> subgraphIndices;
+  subgraphIndices.reserve(n);
+
+  // Pass 0: unary factors are always part of the subgraph
+  for (size_t index = 0; index < m; ++index)
+    if (gfg[index]->size() == 1) subgraphIndices.push_back(index);
+
+  // Pass 1: re-adopt surviving spanning edges, skipping any that would now
+  // close a cycle (e.g. when a removed edge merged two of their components)
+  const auto binaryEdge = [&](size_t index) -> std::pair<Key, Key> {
+    const auto &keys = gfg[index]->keys();
+    return std::make_pair(std::min(keys[0], keys[1]), std::max(keys[0], keys[1]));
+  };
+  size_t count = 0;
+  for (size_t index = 0; index < m && count < n - 1; ++index) {
+    if (gfg[index]->size() != 2) continue;
+    if (spanningEdges_.count(binaryEdge(index)) == 0) continue;
+    const size_t u = ordering.find(gfg[index]->keys()[0])->second,
+                 v = ordering.find(gfg[index]->keys()[1])->second;
+    if (dsf.find(u) != dsf.find(v)) {
+      dsf.merge(u, v);
+      subgraphIndices.push_back(index);
+      ++count;
+    }
+  }
+
+  // Pass 2: complete the spanning structure with new edges in natural order
+  for (size_t index = 0; index < m && count < n - 1; ++index) {
+    if (gfg[index]->size() != 2) continue;
+    if (spanningEdges_.count(binaryEdge(index)) != 0) continue;
+    const size_t u = ordering.find(gfg[index]->keys()[0])->second,
+                 v = ordering.find(gfg[index]->keys()[1])->second;
+    if (dsf.find(u) != dsf.find(v)) {
+      dsf.merge(u, v);
+      subgraphIndices.push_back(index);
+      ++count;
+    }
+  }
+
+  return Subgraph(subgraphIndices);
+}
+
 /*****************************************************************************/
 void SubgraphPreconditioner::build(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
 {
-  /* identify the subgraph structure */
-  const SubgraphBuilder builder(parameters_.builderParams);
-  auto subgraph = builder(gfg);
+  /* identify the subgraph structure, incrementally when possible */
+  const size_t hash = structuralHash(gfg);
+  if (subgraph_.size() == 0) {
+    /* first build: full selection, including augmentation edges */
+    const SubgraphBuilder builder(parameters_.builderParams);
+    subgraph_ = builder(gfg);
+  } else if (hash != structuralHash_) {
+    /* a few edges changed: repair the spanning structure around the
+     * surviving edges instead of re-running weights plus Kruskal */
+    subgraph_ = updateSpanningStructure(gfg);
+  }
+  /* else: unchanged structure, reuse the previous selection outright */
+  structuralHash_ = hash;
+
+  /* record the spanning edges by key pair for the next incremental update */
+  spanningEdges_.clear();
+  for (const Subgraph::Edge &edge : subgraph_) {
+    const auto &keys = gfg[edge.index]->keys();
+    if (keys.size() == 2)
+      spanningEdges_.insert(std::make_pair(std::min(keys[0], keys[1]),
+                                           std::max(keys[0], keys[1])));
+  }
 
   keyInfo_ = keyInfo;
 
   /* build factor subgraph */
-  GaussianFactorGraph::shared_ptr gfg_subgraph = buildFactorSubgraph(gfg, subgraph, true);
+  GaussianFactorGraph::shared_ptr gfg_subgraph = buildFactorSubgraph(gfg, subgraph_, true);
 
   /* factorize and cache BayesNet */
   Rc1_ = gfg_subgraph->eliminateSequential();
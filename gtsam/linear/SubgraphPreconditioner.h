@@ -27,6 +27,8 @@
 #include <boost/shared_ptr.hpp>
 
 #include <map>
+#include <set>
+#include <utility>
 
 namespace gtsam {
 
@@ -67,6 +69,15 @@ namespace gtsam {
     KeyInfo keyInfo_;
     SubgraphPreconditionerParameters parameters_;
 
+    // State for incremental subgraph maintenance across build() calls.  The
+    // subgraph selection is the expensive part (edge weights plus Kruskal);
+    // on repeated builds we reuse it outright when the factor structure is
+    // unchanged, and when a few edges changed we re-span the graph preferring
+    // the surviving spanning edges instead of selecting from scratch.
+    Subgraph subgraph_;                        ///< selection used by the current preconditioner
+    std::set<std::pair<Key, Key> > spanningEdges_; ///< key pairs of the current spanning edges
+    size_t structuralHash_;                    ///< hash of the factor structure subgraph_ was built for
+
   public:
 
     SubgraphPreconditioner(const SubgraphPreconditionerParameters &p = SubgraphPreconditionerParameters());
@@ -146,13 +157,25 @@ namespace gtsam {
     /// implement x = R^{-T} y
     void transposeSolve(const Vector& y, Vector& x) const override;
 
-    /// build/factorize the preconditioner
+    /**
+     * Build/factorize the preconditioner.  The subgraph selection is
+     * maintained incrementally: if the factor structure is unchanged since
+     * the last build only the tree is re-factorized, and if a few edges were
+     * added or removed the spanning structure is repaired around the
+     * surviving edges rather than rebuilt from scratch.  Augmentation edges
+     * beyond the spanning tree are refreshed on full rebuilds only.
+     */
     void build(
       const GaussianFactorGraph &gfg,
       const KeyInfo &info,
       const std::map<Key,Vector> &lambda
       ) override;
     /*****************************************************************************/
+
+  private:
+
+    /// Re-span the graph preferring the surviving spanning edges
+    Subgraph updateSpanningStructure(const GaussianFactorGraph &gfg) const;
   };
 
 } // namespace gtsam
@@ -365,5 +365,20 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
+  template<>
+  void axpy<VectorValues, VectorValues>(double alpha, const VectorValues& x, VectorValues& y)
+  {
+    if(y.size() != x.size())
+      throw invalid_argument("axpy(VectorValues) called with different vector sizes");
+    assert_throw(y.hasSameStructure(x),
+      invalid_argument("axpy(VectorValues) called with different vector sizes"));
+
+    VectorValues::iterator j1 = y.begin();
+    VectorValues::const_iterator j2 = x.begin();
+    for(; j1 != y.end(); ++j1, ++j2)
+      j1->second += alpha * j2->second;
+  }
+
+  /* ************************************************************************* */
 
 } // \namespace gtsam
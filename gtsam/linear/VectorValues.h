@@ -350,6 +350,13 @@ namespace gtsam {
     }
   }; // VectorValues definition
 
+  /** BLAS Level 1 axpy specialization, y += alpha*x in place.  Avoids the temporary
+   *  VectorValues (and its full key map) that the generic y += alpha * x would allocate,
+   *  which matters in iterative solvers calling this every iteration.  Both VectorValues
+   *  must have the same structure. */
+  template<>
+  GTSAM_EXPORT void axpy<VectorValues, VectorValues>(double alpha, const VectorValues& x, VectorValues& y);
+
   /// traits
   template<>
   struct traits<VectorValues> : public Testable<VectorValues> {
@@ -0,0 +1,67 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testEliminationWorkspace.cpp
+ * @brief   Unit tests for the per-thread elimination workspace pool
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/linear/EliminationWorkspace.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <utility>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(EliminationWorkspace, reuse) {
+  EliminationWorkspace::Clear();
+
+  // A released buffer should be handed back for a request with matching dimensions
+  Matrix buffer = EliminationWorkspace::Acquire(7, 5);
+  LONGS_EQUAL(7, buffer.rows());
+  LONGS_EQUAL(5, buffer.cols());
+  const double* data = buffer.data();
+  EliminationWorkspace::Release(std::move(buffer));
+
+  Matrix recycled = EliminationWorkspace::Acquire(7, 5);
+  EXPECT(recycled.data() == data);
+
+  // ... but not for a request with different dimensions
+  EliminationWorkspace::Release(std::move(recycled));
+  Matrix fresh = EliminationWorkspace::Acquire(5, 7);
+  EXPECT(fresh.data() != data);
+  LONGS_EQUAL(5, fresh.rows());
+  LONGS_EQUAL(7, fresh.cols());
+}
+
+/* ************************************************************************* */
+TEST(EliminationWorkspace, clear) {
+  EliminationWorkspace::Clear();
+
+  Matrix buffer = EliminationWorkspace::Acquire(4, 4);
+  EliminationWorkspace::Release(std::move(buffer));
+  EliminationWorkspace::Clear();
+
+  // Clearing the pool must leave Acquire fully functional
+  Matrix fresh = EliminationWorkspace::Acquire(4, 4);
+  LONGS_EQUAL(4, fresh.rows());
+  LONGS_EQUAL(4, fresh.cols());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
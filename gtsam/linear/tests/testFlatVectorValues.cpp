@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testFlatVectorValues.cpp
+ * @brief   Unit tests for the contiguous-storage VectorValues variant
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+static VectorValues exampleUniform() {
+  VectorValues values;
+  values.insert(0, Vector2(1.0, 2.0));
+  values.insert(1, Vector2(3.0, 4.0));
+  values.insert(5, Vector2(5.0, 6.0));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, flattenRoundTrip) {
+  VectorValues values = exampleUniform();
+
+  boost::optional<FlatVectorValues> flat = FlatVectorValues::TryFlatten(values);
+  CHECK(flat);
+  LONGS_EQUAL(3, (long)flat->size());
+  LONGS_EQUAL(2, (long)flat->dim());
+  EXPECT(flat->exists(5));
+  EXPECT(!flat->exists(2));
+  EXPECT(assert_equal(Vector2(3.0, 4.0), Vector(flat->at(1))));
+  EXPECT(assert_equal(values, flat->unflatten()));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, nonUniformNotFlattened) {
+  VectorValues values;
+  values.insert(0, Vector2(1.0, 2.0));
+  values.insert(1, Vector3(3.0, 4.0, 5.0));
+  EXPECT(!FlatVectorValues::TryFlatten(values));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, vectorOperations) {
+  VectorValues a = exampleUniform();
+  VectorValues b = exampleUniform();
+  b.at(1) = Vector2(-1.0, 0.5);
+
+  FlatVectorValues flatA = *FlatVectorValues::TryFlatten(a);
+  FlatVectorValues flatB = *FlatVectorValues::TryFlatten(b);
+
+  // Contiguous operations must agree with the map-based implementations
+  DOUBLES_EQUAL(a.dot(b), flatA.dot(flatB), 1e-9);
+  DOUBLES_EQUAL(a.norm(), flatA.norm(), 1e-9);
+  DOUBLES_EQUAL(a.squaredNorm(), flatA.squaredNorm(), 1e-9);
+  EXPECT(assert_equal(a + b, (flatA + flatB).unflatten()));
+  flatA += flatB;
+  a += b;
+  EXPECT(assert_equal(a, flatA.unflatten()));
+
+  // Writing through at() updates the flat storage
+  flatA.at(5) = Vector2(9.0, 10.0);
+  EXPECT(assert_equal(Vector2(9.0, 10.0), Vector(flatA.at(5))));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
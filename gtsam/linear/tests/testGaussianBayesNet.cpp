@@ -86,6 +86,59 @@ TEST(GaussianBayesNet, Optimize) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianBayesNet, SolvePlan) {
+  // The compiled plan reproduces optimize() on the simple net
+  GaussianBayesNet::SolvePlan plan = smallBayesNet.compileSolvePlan();
+  LONGS_EQUAL(2, (long)plan.dim());
+  LONGS_EQUAL(2, (long)plan.size());
+  EXPECT(assert_equal(smallBayesNet.optimize(), plan.optimize()));
+
+  // And on a net with multi-dimensional variables and several parents
+  GaussianBayesNet bn;
+  bn.emplace_shared<GaussianConditional>(
+      _x_, Vector2(1.0, 2.0), (Matrix2() << 2.0, 1.0, 0.0, 3.0).finished(),
+      _y_, (Matrix2() << 1.0, 0.0, 0.5, 1.0).finished(), _z_,
+      (Matrix2() << 0.1, 0.2, 0.3, 0.4).finished());
+  bn.emplace_shared<GaussianConditional>(
+      _y_, Vector2(3.0, 4.0), (Matrix2() << 1.0, 0.5, 0.0, 2.0).finished(),
+      _z_, (Matrix2() << 0.2, 0.0, 0.0, 0.2).finished());
+  bn.emplace_shared<GaussianConditional>(
+      _z_, Vector2(5.0, 6.0), (Matrix2() << 4.0, 1.0, 0.0, 2.0).finished());
+  EXPECT(assert_equal(bn.optimize(), bn.compileSolvePlan().optimize()));
+
+  // An incomplete net cannot be compiled
+  GaussianBayesNet incomplete;
+  incomplete.emplace_shared<GaussianConditional>(_x_, Vector1::Constant(9),
+                                                 I_1x1, _y_, I_1x1);
+  CHECK_EXCEPTION(incomplete.compileSolvePlan(), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(GaussianBayesNet, SolvePlanLevels) {
+  // A chain is strictly ordered: one step per level
+  GaussianBayesNet chain;
+  chain.emplace_shared<GaussianConditional>(_x_, Vector1::Constant(9), I_1x1,
+                                            _y_, I_1x1);
+  chain.emplace_shared<GaussianConditional>(_y_, Vector1::Constant(5), I_1x1,
+                                            _z_, I_1x1);
+  chain.emplace_shared<GaussianConditional>(_z_, Vector1::Constant(3), I_1x1);
+  GaussianBayesNet::SolvePlan chainPlan = chain.compileSolvePlan();
+  LONGS_EQUAL(3, (long)chainPlan.numLevels());
+  EXPECT(assert_equal(chain.optimize(), chainPlan.optimize()));
+
+  // A star is wide: the root solves first, then all leaves in parallel
+  GaussianBayesNet star;
+  for (Key leaf = 1; leaf <= 4; ++leaf)
+    star.emplace_shared<GaussianConditional>(
+        leaf, Vector1::Constant((double)leaf), I_1x1, 0, I_1x1);
+  star.emplace_shared<GaussianConditional>(0, Vector1::Constant(7), I_1x1);
+  GaussianBayesNet::SolvePlan starPlan = star.compileSolvePlan();
+  LONGS_EQUAL(5, (long)starPlan.size());
+  LONGS_EQUAL(2, (long)starPlan.numLevels());
+  EXPECT(assert_equal(star.optimize(), starPlan.optimize()));
+}
+
 /* ************************************************************************* */
 TEST(GaussianBayesNet, NoisyOptimize) {
   Matrix R;
@@ -137,7 +190,30 @@ TEST( GaussianBayesNet, optimize3 )
 }
 
 /* ************************************************************************* */
-TEST(GaussianBayesNet, ordering) 
+TEST( GaussianBayesNet, backSubstituteMultipleRHS )
+{
+  // Three right-hand sides solved at once should match three separate
+  // single-column backSubstitute calls
+  Matrix gxX = (Matrix(1, 3) << 4.0, 0.0, -2.0).finished();
+  Matrix gxY = (Matrix(1, 3) << 5.0, 1.0, 3.0).finished();
+  FastMap<Key, Matrix> gx;
+  gx[_x_] = gxX;
+  gx[_y_] = gxY;
+
+  const FastMap<Key, Matrix> actual = noisyBayesNet.backSubstitute(gx);
+  EXPECT_LONGS_EQUAL(3, actual.at(_x_).cols());
+  for (int k = 0; k < 3; k++) {
+    VectorValues column = map_list_of<Key, Vector>
+      (_x_, Vector(gxX.col(k)))
+      (_y_, Vector(gxY.col(k)));
+    const VectorValues expected = noisyBayesNet.backSubstitute(column);
+    EXPECT(assert_equal(expected[_x_], Vector(actual.at(_x_).col(k))));
+    EXPECT(assert_equal(expected[_y_], Vector(actual.at(_y_).col(k))));
+  }
+}
+
+/* ************************************************************************* */
+TEST(GaussianBayesNet, ordering)
 {
   Ordering expected;
   expected += _x_, _y_;
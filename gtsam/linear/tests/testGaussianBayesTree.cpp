@@ -25,6 +25,7 @@ using namespace boost::assign;
 
 #include <gtsam/base/debug.h>
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/inference/CliquePool.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianConditional.h>
@@ -110,6 +111,39 @@ TEST( GaussianBayesTree, eliminate )
   EXPECT(assert_equal(bayesTree_expected, bt));
 }
 
+/* ************************************************************************* */
+TEST( GaussianBayesTree, memoryUsage )
+{
+  GaussianBayesTree bt = *chain.eliminateMultifrontal(chainOrdering);
+
+  // Conditional bytes match a manual walk over the cliques
+  size_t expectedConditionalBytes = 0;
+  for (const auto& key_clique : bt.nodes()) {
+    // nodes() maps every key to its clique, so count each clique via its
+    // first frontal key only
+    const auto& clique = key_clique.second;
+    if (key_clique.first == *clique->conditional()->beginFrontals())
+      expectedConditionalBytes += clique->conditional()->memoryUsage();
+  }
+  BayesTreeMemoryUsage usage = bt.memoryUsage();
+  EXPECT_LONGS_EQUAL(2, usage.nrCliques);
+  EXPECT_LONGS_EQUAL(expectedConditionalBytes, usage.conditionalBytes);
+  EXPECT(usage.conditionalBytes > 0);
+
+  // No separator marginals cached yet, and a plain tree caches no factors
+  EXPECT_LONGS_EQUAL(0, usage.nrCachedSeparatorMarginals);
+  EXPECT_LONGS_EQUAL(0, usage.cachedSeparatorMarginalBytes);
+  EXPECT_LONGS_EQUAL(0, usage.cachedFactorBytes);
+  EXPECT_LONGS_EQUAL(usage.conditionalBytes, usage.totalBytes());
+
+  // Querying a marginal fills separator-marginal caches
+  bt.marginalFactor(x1);
+  usage = bt.memoryUsage();
+  EXPECT_LONGS_EQUAL(bt.numCachedSeparatorMarginals(),
+      usage.nrCachedSeparatorMarginals);
+  EXPECT(usage.nrCachedSeparatorMarginals > 0);
+}
+
 /* ************************************************************************* */
 TEST( GaussianBayesTree, optimizeMultiFrontal )
 {
@@ -123,6 +157,78 @@ TEST( GaussianBayesTree, optimizeMultiFrontal )
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST( GaussianBayesTree, backSubstituteSparse )
+{
+  // The chain eliminates into root [x3 x4] with child [x2 x1 : x3]
+  GaussianBayesTree bt = *chain.eliminateMultifrontal(chainOrdering);
+  GaussianBayesNet bn = *chain.eliminateSequential(chainOrdering);
+
+  // A dense right-hand side reproduces sequential back-substitution
+  VectorValues rhs;
+  rhs.insert(x1, (Vector(1) << 1.).finished());
+  rhs.insert(x2, (Vector(1) << -2.).finished());
+  rhs.insert(x3, (Vector(1) << 3.).finished());
+  rhs.insert(x4, (Vector(1) << 0.5).finished());
+  EXPECT(assert_equal(bn.backSubstitute(rhs), bt.backSubstituteSparse(rhs)));
+
+  // A right-hand side confined to the child clique leaves the root branch
+  // untouched: x3 and x4 do not even appear in the solution
+  VectorValues childRhs;
+  childRhs.insert(x2, (Vector(1) << -2.).finished());
+  VectorValues childDense = rhs;
+  childDense.at(x1).setZero();
+  childDense.at(x3).setZero();
+  childDense.at(x4).setZero();
+  VectorValues expected = bn.backSubstitute(childDense);
+  VectorValues actual = bt.backSubstituteSparse(childRhs);
+  EXPECT(!actual.exists(x3));
+  EXPECT(!actual.exists(x4));
+  EXPECT(assert_equal(expected.at(x1), actual.at(x1)));
+  EXPECT(assert_equal(expected.at(x2), actual.at(x2)));
+
+  // A right-hand side on the root propagates into the child through its
+  // separator, so every variable is affected
+  VectorValues rootRhs;
+  rootRhs.insert(x4, (Vector(1) << 0.5).finished());
+  VectorValues rootDense = rhs;
+  rootDense.at(x1).setZero();
+  rootDense.at(x2).setZero();
+  rootDense.at(x3).setZero();
+  EXPECT(assert_equal(bn.backSubstitute(rootDense),
+      bt.backSubstituteSparse(rootRhs)));
+
+  // Unknown keys are rejected
+  VectorValues badRhs;
+  badRhs.insert(99, (Vector(1) << 1.).finished());
+  CHECK_EXCEPTION(bt.backSubstituteSparse(badRhs), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( GaussianBayesTree, selectedInverse )
+{
+  // One pass over the chain reproduces the per-key clique-solve marginals
+  GaussianBayesTree bt = *chain.eliminateMultifrontal(chainOrdering);
+  FastMap<Key, Matrix> actual = bt.selectedInverse();
+  EXPECT_LONGS_EQUAL(4, (long)actual.size());
+  for (Key key : {x1, x2, x3, x4})
+    EXPECT(assert_equal(bt.marginalCovariance(key), actual.at(key)));
+
+  // And on a multifrontal tree over 2D variables with a branching structure
+  GaussianFactorGraph gfg;
+  const SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  gfg.add(0, I_2x2, Vector2(1.0, 2.0), unit2);
+  gfg.add(0, -I_2x2, 1, I_2x2, Vector2(0.5, -0.5), unit2);
+  gfg.add(1, -I_2x2, 2, I_2x2, Vector2(1.5, 0.5), unit2);
+  gfg.add(1, -I_2x2, 3, I_2x2, Vector2(-1.0, 1.0), unit2);
+  gfg.add(2, -I_2x2, 4, I_2x2, Vector2(2.0, -1.0), unit2);
+  GaussianBayesTree branching = *gfg.eliminateMultifrontal();
+  FastMap<Key, Matrix> marginals = branching.selectedInverse();
+  EXPECT_LONGS_EQUAL(5, (long)marginals.size());
+  for (Key key = 0; key < 5; ++key)
+    EXPECT(assert_equal(branching.marginalCovariance(key), marginals.at(key)));
+}
+
 /* ************************************************************************* */
 TEST(GaussianBayesTree, complicatedMarginal) {
 
@@ -320,6 +426,38 @@ TEST(GaussianBayesTree, determinant_and_smallestEigenvalue) {
   EXPECT_DOUBLES_EQUAL(expectedDeterminant,actualDeterminant,expectedDeterminant*1e-6);// relative tolerance
 }
 
+/* ************************************************************************* */
+/* ************************************************************************* */
+TEST(GaussianBayesTree, relocateCliques)
+{
+  // The pool must outlive the tree whose cliques it will hold, so it is
+  // declared first and destroyed last
+  CliquePool pool;
+
+  GaussianBayesTree bayesTree = *chain.eliminateMultifrontal(chainOrdering);
+  const VectorValues expectedSolution = bayesTree.optimize();
+  const GaussianBayesTree reference = *chain.eliminateMultifrontal(chainOrdering);
+
+  // Remember where the cliques used to live
+  std::set<const void*> oldAddresses;
+  for (const GaussianBayesTree::Nodes::value_type& entry : bayesTree.nodes())
+    oldAddresses.insert(entry.second.get());
+
+  bayesTree.relocateCliques(pool);
+  EXPECT(pool.capacity() > 0);
+
+  // Same tree, same solution, but every clique moved into the pool
+  EXPECT(bayesTree.equals(reference));
+  EXPECT(assert_equal(expectedSolution, bayesTree.optimize()));
+  for (const GaussianBayesTree::Nodes::value_type& entry : bayesTree.nodes()) {
+    EXPECT(!oldAddresses.count(entry.second.get()));
+    // Parent-child wiring is consistent after relocation
+    for (const GaussianBayesTreeClique::shared_ptr& child :
+        entry.second->children)
+      EXPECT(child->parent().get() == entry.second.get());
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -24,6 +24,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 
 #include <boost/assign/std/list.hpp>
 #include <boost/assign/std/vector.hpp>
@@ -198,6 +199,34 @@ TEST( GaussianConditional, solve_simple )
   EXPECT(assert_equal(expected, actual, tol));
 }
 
+/* ************************************************************************* */
+TEST( GaussianConditional, compressStorage )
+{
+  // Same system as solve_simple
+  VerticalBlockMatrix blockMatrix(list_of(4)(2)(1), 4);
+  blockMatrix.matrix() <<
+      1.0, 0.0, 2.0, 0.0, 3.0, 0.0, 0.1,
+      0.0, 1.0, 0.0, 2.0, 0.0, 3.0, 0.2,
+      0.0, 0.0, 3.0, 0.0, 4.0, 0.0, 0.3,
+      0.0, 0.0, 0.0, 3.0, 0.0, 4.0, 0.4;
+  GaussianConditional cg(list_of(1)(2), 1, blockMatrix);
+
+  VectorValues parents = map_list_of(2, Vector2(9.0, 10.0));
+  const VectorValues expected = cg.solve(parents);
+
+  // Compressing releases half the dense storage
+  const size_t released = cg.compressStorage();
+  EXPECT(cg.compressedStorage());
+  EXPECT_LONGS_EQUAL(4 * 7 * (sizeof(double) - sizeof(float)), released);
+  EXPECT_LONGS_EQUAL(0, cg.compressStorage()); // idempotent
+
+  // Solving restores the double storage transparently; these entries are
+  // exactly representable in float32 so the solution is exact here
+  const VectorValues actual = cg.solve(parents);
+  EXPECT(!cg.compressedStorage());
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( GaussianConditional, solve_multifrontal )
 {
@@ -315,6 +344,82 @@ TEST( GaussianConditional, isGaussianFactor ) {
   EXPECT(assert_equal(IExpected, IActual));
 }
 
+/* ************************************************************************* */
+namespace {
+// A small clique system: frontals x0, x1 with separator x2
+GaussianFactorGraph cliqueGraph() {
+  GaussianFactorGraph gfg;
+  const SharedDiagonal unit = noiseModel::Unit::Create(1);
+  gfg.add(0, (Matrix(1, 1) << 2.0).finished(), (Vector(1) << 1.0).finished(), unit);
+  gfg.add(0, (Matrix(1, 1) << 1.0).finished(), 1, (Matrix(1, 1) << -1.0).finished(),
+      (Vector(1) << 0.5).finished(), unit);
+  gfg.add(1, (Matrix(1, 1) << 1.0).finished(), 2, (Matrix(1, 1) << -1.0).finished(),
+      (Vector(1) << 0.2).finished(), unit);
+  return gfg;
+}
+}
+
+/* ************************************************************************* */
+TEST( GaussianConditional, updateCholesky ) {
+  const Ordering frontalKeys = list_of(0)(1);
+  GaussianFactorGraph gfg = cliqueGraph();
+  auto eliminated = EliminatePreferCholesky(gfg, frontalKeys);
+  GaussianConditional conditional = *eliminated.first;
+
+  // A new unit-noise factor on x0 and x2, written as a row over the
+  // conditional's augmented layout [x0 x1 | x2 | d]
+  Matrix rows(1, 4);
+  rows << 0.7, 0.0, 0.3, 0.9;
+  Matrix remaining;
+  CHECK(conditional.updateCholesky(rows, &remaining));
+
+  // The update matches re-eliminating the clique with the factor included
+  GaussianFactorGraph augmented = cliqueGraph();
+  augmented.add(0, (Matrix(1, 1) << 0.7).finished(), 2,
+      (Matrix(1, 1) << 0.3).finished(), (Vector(1) << 0.9).finished(),
+      noiseModel::Unit::Create(1));
+  auto expected = EliminatePreferCholesky(augmented, frontalKeys);
+  EXPECT(assert_equal(*expected.first, conditional, 1e-9));
+
+  // The leftover row carries the message to the parent: old remaining
+  // information plus its outer product equals the new remaining information
+  LONGS_EQUAL(1, (long)remaining.rows());
+  LONGS_EQUAL(2, (long)remaining.cols());
+  const Matrix actualInfo = eliminated.second->augmentedInformation()
+      + remaining.transpose() * remaining;
+  EXPECT(assert_equal(Matrix(expected.second->augmentedInformation()),
+      actualInfo, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( GaussianConditional, downdateCholesky ) {
+  const Ordering frontalKeys = list_of(0)(1);
+  auto eliminated = EliminatePreferCholesky(cliqueGraph(), frontalKeys);
+  const GaussianConditional original = *eliminated.first;
+  GaussianConditional conditional = original;
+
+  // A downdate exactly undoes an update
+  Matrix rows(1, 4);
+  rows << 0.7, 0.0, 0.3, 0.9;
+  CHECK(conditional.updateCholesky(rows));
+  CHECK(conditional.downdateCholesky(rows));
+  EXPECT(assert_equal(original, conditional, 1e-9));
+
+  // Removing a row that was never folded in would make the factor
+  // indefinite: the downdate refuses and leaves the conditional untouched
+  Matrix bogus(1, 4);
+  bogus << 10.0, 10.0, 10.0, 10.0;
+  CHECK(!conditional.downdateCholesky(bogus));
+  EXPECT(assert_equal(original, conditional, 1e-9));
+
+  // Conditionals carrying a noise model cannot be rotated in place
+  GaussianConditional modeled(0, (Vector(1) << 1.0).finished(),
+      (Matrix(1, 1) << 1.0).finished(), noiseModel::Isotropic::Sigma(1, 2.0));
+  Matrix unary(1, 2);
+  unary << 0.5, 0.5;
+  CHECK(!modeled.updateCholesky(unary));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -21,11 +21,15 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/inference/MultifrontalPlan.h>
 #include <gtsam/inference/VariableSlots.h>
 #include <gtsam/inference/VariableIndex.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/VerticalBlockMatrix.h>
 
+#include <Eigen/Sparse>
+
 #include <boost/assign/list_of.hpp>
 #include <boost/assign/std/list.hpp>  // for operator +=
 using namespace boost::assign;
@@ -65,6 +69,59 @@ TEST(GaussianFactorGraph, initialization) {
   EQUALITY(expectedIJS, actualIJS);
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, connectedComponents) {
+  // Two disconnected chains: {0,1,2} and {10,11}
+  GaussianFactorGraph fg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  fg +=
+    JacobianFactor(0, 10*I_2x2, -1.0*Vector::Ones(2), unit2),
+    JacobianFactor(0, -10*I_2x2, 1, 10*I_2x2, Vector2(2.0, -1.0), unit2),
+    JacobianFactor(1, -5*I_2x2, 2, 5*I_2x2, Vector2(-1.0, 1.5), unit2),
+    JacobianFactor(10, 10*I_2x2, Vector2(1.0, 2.0), unit2),
+    JacobianFactor(10, -10*I_2x2, 11, 10*I_2x2, Vector2(0.5, -0.5), unit2);
+
+  const std::vector<GaussianFactorGraph> components = fg.splitConnectedComponents();
+  EXPECT_LONGS_EQUAL(2, components.size());
+  EXPECT_LONGS_EQUAL(3, components[0].size());
+  EXPECT_LONGS_EQUAL(2, components[1].size());
+
+  // Solving per component gives the joint solution
+  EXPECT(assert_equal(fg.optimize(), fg.optimizeComponents()));
+
+  // A connected graph is a single component
+  GaussianFactorGraph connected;
+  connected += JacobianFactor(0, 10*I_2x2, -1.0*Vector::Ones(2), unit2);
+  EXPECT_LONGS_EQUAL(1, connected.splitConnectedComponents().size());
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, optimizeSchur) {
+  // Bundle-adjustment-like structure: cameras {0,1}, points {100,101},
+  // every measurement factor links one camera to one point
+  GaussianFactorGraph fg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  fg +=
+    JacobianFactor(0, 10*I_2x2, -1.0*Vector::Ones(2), unit2),
+    JacobianFactor(0, -10*I_2x2, 1, 10*I_2x2, Vector2(2.0, -1.0), unit2),
+    JacobianFactor(0, -5*I_2x2, 100, 5*I_2x2, Vector2(0.0, 1.0), unit2),
+    JacobianFactor(1, -5*I_2x2, 100, 5*I_2x2, Vector2(-1.0, 1.5), unit2),
+    JacobianFactor(0, -5*I_2x2, 101, 5*I_2x2, Vector2(1.0, -0.5), unit2),
+    JacobianFactor(1, -5*I_2x2, 101, 5*I_2x2, Vector2(0.5, 0.5), unit2);
+
+  KeySet pointKeys;
+  pointKeys.insert(100);
+  pointKeys.insert(101);
+
+  // Landmark-first elimination gives the same solution as the generic path
+  EXPECT(assert_equal(fg.optimize(), fg.optimizeSchur(pointKeys)));
+
+  // A factor connecting two points violates the required structure
+  GaussianFactorGraph bad = fg;
+  bad += JacobianFactor(100, -I_2x2, 101, I_2x2, Vector2(0.1, 0.1), unit2);
+  CHECK_EXCEPTION(bad.optimizeSchur(pointKeys), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(GaussianFactorGraph, sparseJacobian) {
   // Create factor graph:
@@ -387,6 +444,102 @@ TEST(GaussianFactorGraph, negate) {
   EXPECT(assert_equal(expNegation, actNegation));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, sparseJacobianCsc) {
+  GaussianFactorGraph gfg;
+  gfg.add(0, (Matrix2() << 1., 2., 3., 4.).finished(), Vector2(1.0, 2.0),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  gfg.add(0, I_2x2, 1, 2 * I_2x2, Vector2(3.0, 4.0), noiseModel::Unit::Create(2));
+
+  size_t rows, cols, nnz;
+  gfg.sparseJacobianCscDims(rows, cols, nnz);
+  LONGS_EQUAL(4, (long)rows);
+  LONGS_EQUAL(5, (long)cols);
+  // one 2x2 block plus rhs for the first factor, two 2x2 blocks plus rhs
+  // for the second; structural zeros within blocks are kept
+  LONGS_EQUAL(4 + 2 + 8 + 2, (long)nnz);
+
+  std::vector<int> outer(cols + 1);
+  std::vector<int> inner(nnz);
+  std::vector<double> values(nnz);
+  gfg.sparseJacobianCsc(&outer[0], &inner[0], &values[0]);
+
+  // The arrays form a valid zero-copy Eigen view of the whitened [A b]
+  const Eigen::Map<const Eigen::SparseMatrix<double> > view(rows, cols, nnz,
+      &outer[0], &inner[0], &values[0]);
+  const Matrix dense = view;
+  EXPECT(assert_equal(gfg.augmentedJacobian(), dense));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, combineDuplicateFactors) {
+  // Two parallel factors on {0,1} (one with its keys swapped), plus a unary
+  // factor on 0 that should pass through untouched
+  GaussianFactorGraph gfg;
+  Matrix2 A = 10 * I_2x2;
+  gfg.add(0, -A, 1, A, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  gfg.add(1, A, 0, -A, Vector2(1.5, 2.5), noiseModel::Isotropic::Sigma(2, 0.5));
+  gfg.add(0, I_2x2, Vector2(0.1, 0.2), noiseModel::Unit::Create(2));
+  gfg.push_back(GaussianFactor::shared_ptr());  /// Null factors are dropped
+
+  GaussianFactorGraph combined = gfg.combineDuplicateFactors();
+  LONGS_EQUAL(2, (long)combined.size());
+
+  // The combined graph defines the same quadratic error function
+  VectorValues x;
+  x.insert(0, Vector2(0.3, -0.2));
+  x.insert(1, Vector2(-0.1, 0.4));
+  DOUBLES_EQUAL(gfg.error(x), combined.error(x), 1e-9);
+  EXPECT(assert_equal(gfg.augmentedHessian(), combined.augmentedHessian(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, substituteEqualityConstraints) {
+  // Variable 0 is locked by a hard equality constraint; 1 and 2 float
+  GaussianFactorGraph gfg;
+  gfg.add(0, I_2x2, Vector2(1.0, 2.0), noiseModel::Constrained::All(2));
+  gfg.add(0, -I_2x2, 1, I_2x2, Vector2(0.5, 0.5), noiseModel::Unit::Create(2));
+  gfg.add(1, -I_2x2, 2, I_2x2, Vector2(1.0, 0.0),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+
+  VectorValues fixed;
+  GaussianFactorGraph reduced = gfg.substituteEqualityConstraints(fixed);
+
+  // The constraint is solved and removed; variable 0 is substituted away
+  LONGS_EQUAL(2, (long)reduced.size());
+  LONGS_EQUAL(1, (long)fixed.size());
+  EXPECT(assert_equal(Vector2(1.0, 2.0), fixed[0]));
+  KeySet expectedKeys;
+  expectedKeys.insert(1);
+  expectedKeys.insert(2);
+  EXPECT(expectedKeys == reduced.keys());
+
+  // Re-assembling the fixed variable reproduces the constrained solution
+  VectorValues expected = gfg.optimize();
+  VectorValues actual = reduced.optimize();
+  actual.insert(fixed);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+
+  // A soft unary on 0 - not a hard constraint - disables nothing
+  GaussianFactorGraph soft;
+  soft.add(0, I_2x2, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  VectorValues none;
+  LONGS_EQUAL(1, (long)soft.substituteEqualityConstraints(none).size());
+  LONGS_EQUAL(0, (long)none.size());
+
+  // An agreeing duplicate constraint reduces to a constant and is dropped
+  gfg.add(0, 2.0 * I_2x2, Vector2(2.0, 4.0), noiseModel::Constrained::All(2));
+  VectorValues fixedDup;
+  LONGS_EQUAL(2, (long)gfg.substituteEqualityConstraints(fixedDup).size());
+  EXPECT(assert_equal(Vector2(1.0, 2.0), fixedDup[0]));
+
+  // A conflicting duplicate makes the graph infeasible
+  gfg.add(0, I_2x2, Vector2(3.0, 3.0), noiseModel::Constrained::All(2));
+  VectorValues fixedBad;
+  CHECK_EXCEPTION(gfg.substituteEqualityConstraints(fixedBad),
+      std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(GaussianFactorGraph, hessianDiagonal) {
   GaussianFactorGraph gfg = createGaussianFactorGraphWithHessianFactor();
@@ -408,6 +561,118 @@ TEST(GaussianFactorGraph, DenseSolve) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, multifrontalPlan) {
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  Ordering ordering = Ordering::Colamd(fg);
+
+  // A plan built once should reproduce the result of eliminateMultifrontal
+  MultifrontalPlan<GaussianFactorGraph>::shared_ptr plan = fg.planMultifrontal(ordering);
+  GaussianBayesTree expected = *fg.eliminateMultifrontal(ordering, EliminateCholesky);
+  GaussianBayesTree actual = *plan->eliminate(fg, EliminateCholesky);
+  EXPECT(assert_equal(expected, actual));
+
+  // ... and also for a graph with identical sparsity but different values
+  GaussianFactorGraph fg2 = createSimpleGaussianFactorGraph();
+  Key x1 = 2;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  fg2.replace(0, boost::make_shared<JacobianFactor>(x1, 10 * I_2x2, Vector2(0.5, -0.5), unit2));
+  GaussianBayesTree expected2 = *fg2.eliminateMultifrontal(ordering, EliminateCholesky);
+  GaussianBayesTree actual2 = *plan->eliminate(fg2, EliminateCholesky);
+  EXPECT(assert_equal(expected2, actual2));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, multifrontalPlanCheckpoint) {
+  // A chain with no prior: every clique eliminates cleanly except the last,
+  // where the remaining information vanishes and Cholesky fails
+  GaussianFactorGraph fg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  for (size_t i = 0; i < 4; ++i)
+    fg += JacobianFactor(i, -I_2x2, i + 1, I_2x2, Vector2(1.0, 0.0), unit2);
+  Ordering ordering;
+  for (Key k = 0; k <= 4; ++k) ordering.push_back(k);
+
+  size_t calls = 0;
+  GaussianFactorGraph::Eliminate countingEliminate =
+      [&calls](const GaussianFactorGraph& factors, const Ordering& keys) {
+        ++calls;
+        return EliminateCholesky(factors, keys);
+      };
+
+  MultifrontalPlan<GaussianFactorGraph>::shared_ptr plan = fg.planMultifrontal(ordering);
+  MultifrontalPlan<GaussianFactorGraph>::Checkpoint checkpoint;
+  EXPECT(checkpoint.empty());
+  Key offending = 0;
+  try {
+    plan->eliminate(fg, countingEliminate, &checkpoint);
+    FAIL("elimination should have thrown IndeterminantLinearSystemException");
+  } catch (const IndeterminantLinearSystemException& e) {
+    offending = e.nearbyVariable();
+  }
+
+  // The completed subtree factorizations survived the failure
+  const size_t completed = checkpoint.nrCompleted();
+  EXPECT(completed > 0);
+  EXPECT(completed < plan->nrCliques());
+
+  // Repair by appending a prior on the offending variable, then re-solve:
+  // only the cliques without a checkpointed result are re-eliminated
+  GaussianFactorGraph repaired = fg;
+  repaired += JacobianFactor(offending, I_2x2, Vector2(0.0, 0.0), unit2);
+  calls = 0;
+  GaussianBayesTree actual = *plan->eliminate(repaired, countingEliminate, &checkpoint);
+  LONGS_EQUAL(plan->nrCliques() - completed, calls);
+  LONGS_EQUAL(plan->nrCliques(), checkpoint.nrCompleted());
+
+  // The restarted solve matches eliminating the repaired graph from scratch
+  GaussianBayesTree expected = *repaired.eliminateMultifrontal(ordering, EliminateCholesky);
+  EXPECT(assert_equal(expected, actual));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, typedView) {
+  // Mixed graph: four Jacobians, one Hessian, one null slot
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  HessianFactor::shared_ptr hessian = boost::make_shared<HessianFactor>(
+      0, I_2x2, Vector2(1.0, 2.0), 3.0);
+  fg.push_back(hessian);
+  fg.push_back(GaussianFactor::shared_ptr());
+
+  GaussianFactorGraph::TypedView view = fg.typedView();
+  LONGS_EQUAL(4, view.jacobianFactors().size());
+  LONGS_EQUAL(1, view.hessianFactors().size());
+  LONGS_EQUAL(0, view.otherFactors().size());
+  LONGS_EQUAL(5, view.size()); // nulls are skipped
+  EXPECT(view.hessianFactors().front() == hessian);
+
+  // The slices alias the graph's factors, no copies
+  EXPECT(view.jacobianFactors().front().get() == fg.at(0).get());
+
+  // Incremental maintenance on add and remove
+  JacobianFactor::shared_ptr extra = boost::make_shared<JacobianFactor>(
+      1, I_2x2, Vector2(0.0, 0.0));
+  fg.push_back(extra);
+  view.add(extra);
+  LONGS_EQUAL(5, view.jacobianFactors().size());
+  EXPECT(view.remove(extra));
+  LONGS_EQUAL(4, view.jacobianFactors().size());
+  EXPECT(!view.remove(extra)); // already gone
+  EXPECT(view.remove(hessian));
+  LONGS_EQUAL(0, view.hessianFactors().size());
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, typedViewConditional) {
+  // GaussianConditionals derive from JacobianFactor and land in that slice
+  GaussianFactorGraph fg;
+  fg.push_back(boost::make_shared<GaussianConditional>(
+      0, Vector2(1.0, 2.0), I_2x2));
+  GaussianFactorGraph::TypedView view = fg.typedView();
+  LONGS_EQUAL(1, view.jacobianFactors().size());
+  LONGS_EQUAL(0, view.hessianFactors().size());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,251 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testGaussianJunctionTree.cpp
+ * @brief   Unit tests for GaussianJunctionTree, in particular amalgamation
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A chain 0-1-2-...-9 with a prior on 0, which eliminates into many tiny
+// cliques under the natural ordering
+static GaussianFactorGraph chainGraph() {
+  GaussianFactorGraph gfg;
+  gfg.add(0, I_2x2, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  for (Key j = 0; j < 9; ++j)
+    gfg.add(j, -I_2x2, j + 1, I_2x2, Vector2(0.1 * (j + 1), 0.0),
+        noiseModel::Isotropic::Sigma(2, 0.5));
+  return gfg;
+}
+
+/* ************************************************************************* */
+static size_t countCliques(const GaussianJunctionTree::sharedNode& node) {
+  size_t count = 1;
+  for (const GaussianJunctionTree::sharedNode& child : node->children)
+    count += countCliques(child);
+  return count;
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, amalgamate) {
+  GaussianFactorGraph gfg = chainGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+  GaussianEliminationTree etree(gfg, variableIndex, ordering);
+  GaussianJunctionTree junctionTree(etree);
+
+  size_t cliquesBefore = 0;
+  for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+    cliquesBefore += countCliques(root);
+
+  // Amalgamation must merge at least one of the tiny chain cliques
+  const size_t nrMerged = junctionTree.amalgamate();
+  EXPECT(nrMerged > 0);
+
+  size_t cliquesAfter = 0;
+  for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+    cliquesAfter += countCliques(root);
+  LONGS_EQUAL((long)cliquesBefore, (long)(cliquesAfter + nrMerged));
+
+  // Eliminating the amalgamated tree still solves the original problem
+  GaussianBayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+  boost::tie(bayesTree, remaining) = junctionTree.eliminate(EliminatePreferCholesky);
+  EXPECT_LONGS_EQUAL(0, remaining->size());
+  EXPECT(assert_equal(gfg.optimize(), bayesTree->optimize()));
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, amalgamateRespectsMaxFrontals) {
+  GaussianFactorGraph gfg = chainGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+  GaussianEliminationTree etree(gfg, variableIndex, ordering);
+  GaussianJunctionTree junctionTree(etree);
+
+  // With a cap of one frontal per clique nothing can be merged
+  LONGS_EQUAL(0, (long)junctionTree.amalgamate(4, 1));
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, cliqueHints) {
+  GaussianFactorGraph gfg = chainGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+
+  // Tuned run: amalgamate, then export the resulting clique structure
+  GaussianEliminationTree tunedEtree(gfg, variableIndex, ordering);
+  GaussianJunctionTree tuned(tunedEtree);
+  const size_t nrMerged = tuned.amalgamate();
+  EXPECT(nrMerged > 0);
+  const string hintFile = "testGaussianJunctionTree_hints.txt";
+  tuned.writeCliqueHints(hintFile);
+
+  size_t tunedCliques = 0;
+  for (const GaussianJunctionTree::sharedNode& root : tuned.roots())
+    tunedCliques += countCliques(root);
+
+  // Cold start: a fresh construction replays the tuned structure from hints
+  GaussianEliminationTree coldEtree(gfg, variableIndex, ordering);
+  GaussianJunctionTree cold(coldEtree);
+  LONGS_EQUAL((long)nrMerged, (long)cold.applyCliqueHints(hintFile));
+
+  size_t coldCliques = 0;
+  for (const GaussianJunctionTree::sharedNode& root : cold.roots())
+    coldCliques += countCliques(root);
+  LONGS_EQUAL((long)tunedCliques, (long)coldCliques);
+
+  // Applying again is a no-op, and the hinted tree still solves the problem
+  LONGS_EQUAL(0, (long)cold.applyCliqueHints(hintFile));
+  GaussianBayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+  boost::tie(bayesTree, remaining) = cold.eliminate(EliminatePreferCholesky);
+  EXPECT_LONGS_EQUAL(0, remaining->size());
+  EXPECT(assert_equal(gfg.optimize(), bayesTree->optimize()));
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, denseSwitch) {
+  // Chain with loop closures between the ends, so the separators towards the
+  // root couple nearly all remaining variables
+  GaussianFactorGraph gfg = chainGraph();
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 1.0);
+  gfg.add(0, -I_2x2, 9, I_2x2, Vector2(0.5, -0.5), model);
+  gfg.add(1, -I_2x2, 8, I_2x2, Vector2(-0.2, 0.1), model);
+  gfg.add(2, -I_2x2, 7, I_2x2, Vector2(0.3, 0.2), model);
+
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+  GaussianEliminationTree etree(gfg, variableIndex, ordering);
+  GaussianJunctionTree junctionTree(etree);
+
+  size_t cliquesBefore = 0;
+  for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+    cliquesBefore += countCliques(root);
+
+  // The dense tail near the root must be collapsed
+  const size_t nrAbsorbed = junctionTree.denseSwitch(0.5);
+  EXPECT(nrAbsorbed > 0);
+
+  size_t cliquesAfter = 0;
+  for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+    cliquesAfter += countCliques(root);
+  LONGS_EQUAL((long)cliquesBefore, (long)(cliquesAfter + nrAbsorbed));
+
+  // Eliminating the collapsed tree still solves the original problem
+  GaussianBayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+  boost::tie(bayesTree, remaining) = junctionTree.eliminate(EliminatePreferCholesky);
+  EXPECT_LONGS_EQUAL(0, remaining->size());
+  EXPECT(assert_equal(gfg.optimize(), bayesTree->optimize()));
+
+  // A threshold above 1 can never be met, and 0 disables the pass
+  GaussianEliminationTree etree2(gfg, variableIndex, ordering);
+  GaussianJunctionTree untouched(etree2);
+  LONGS_EQUAL(0, (long)untouched.denseSwitch(2.0));
+  LONGS_EQUAL(0, (long)untouched.denseSwitch(0.0));
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, eliminateToDisk) {
+  GaussianFactorGraph gfg = chainGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+  GaussianEliminationTree etree(gfg, variableIndex, ordering);
+  GaussianJunctionTree junctionTree(etree);
+  junctionTree.amalgamate();  // mix of single- and multi-frontal cliques
+
+  // Spilled elimination streams the conditionals to disk and back, and
+  // backsubstitution over the spill file solves the original problem
+  const string spillFile = "testGaussianJunctionTree_spill.bin";
+  const GaussianJunctionTree::SpilledConditionals spilled =
+      junctionTree.eliminateToDisk(EliminatePreferCholesky, spillFile);
+  EXPECT(spilled.size() > 0);
+  EXPECT(spilled.filename() == spillFile);
+  EXPECT(assert_equal(gfg.optimize(), spilled.optimize()));
+
+  // Spilling a QR elimination (constrained-capable, keeps the noise model)
+  // gives the same solution
+  const GaussianJunctionTree::SpilledConditionals spilledQR =
+      GaussianJunctionTree(GaussianEliminationTree(gfg, variableIndex, ordering))
+          .eliminateToDisk(EliminateQR, spillFile);
+  EXPECT(assert_equal(gfg.optimize(), spilledQR.optimize()));
+}
+
+/* ************************************************************************* */
+TEST(GaussianJunctionTree, amalgamationPolicy) {
+  GaussianFactorGraph gfg = chainGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+  const VectorValues expected = gfg.optimize();
+
+  // The default policy reproduces the structural construction exactly
+  GaussianJunctionTree structural(
+      GaussianEliminationTree(gfg, variableIndex, ordering));
+  GaussianJunctionTree defaulted(
+      GaussianEliminationTree(gfg, variableIndex, ordering),
+      AmalgamationPolicy());
+  size_t structuralCliques = 0, defaultCliques = 0;
+  for (const GaussianJunctionTree::sharedNode& root : structural.roots())
+    structuralCliques += countCliques(root);
+  for (const GaussianJunctionTree::sharedNode& root : defaulted.roots())
+    defaultCliques += countCliques(root);
+  LONGS_EQUAL((long)structuralCliques, (long)defaultCliques);
+
+  // A frontal cap of 1 vetoes every merge: one clique per variable
+  GaussianJunctionTree capped(
+      GaussianEliminationTree(gfg, variableIndex, ordering),
+      AmalgamationPolicy(1, 0, 0));
+  size_t cappedCliques = 0;
+  for (const GaussianJunctionTree::sharedNode& root : capped.roots())
+    cappedCliques += countCliques(root);
+  LONGS_EQUAL(10, (long)cappedCliques);
+
+  // A huge problem-size target greedily absorbs every child into the root
+  GaussianJunctionTree coarse(
+      GaussianEliminationTree(gfg, variableIndex, ordering),
+      AmalgamationPolicy(0, 0, 1000000));
+  size_t coarseCliques = 0;
+  for (const GaussianJunctionTree::sharedNode& root : coarse.roots())
+    coarseCliques += countCliques(root);
+  LONGS_EQUAL((long)coarse.roots().size(), (long)coarseCliques);
+
+  // Every granularity eliminates to the same solution
+  GaussianBayesTree::shared_ptr bayesTree;
+  GaussianFactorGraph::shared_ptr remaining;
+  boost::tie(bayesTree, remaining) = capped.eliminate(EliminatePreferCholesky);
+  EXPECT(assert_equal(expected, bayesTree->optimize()));
+  boost::tie(bayesTree, remaining) = coarse.eliminate(EliminatePreferCholesky);
+  EXPECT(assert_equal(expected, bayesTree->optimize()));
+
+  // And the policy is reachable through EliminateableFactorGraph
+  EXPECT(assert_equal(expected,
+      gfg.eliminateMultifrontal(ordering, AmalgamationPolicy(4, 0, 100),
+          EliminatePreferCholesky)->optimize()));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
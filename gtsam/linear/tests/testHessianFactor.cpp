@@ -501,6 +501,35 @@ TEST(HessianFactor, combine) {
 
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, updateHessianSlots) {
+
+  // The slot-hinted updateHessian overload must produce the same information
+  // matrix as the key-based one
+  Matrix A0 = (Matrix(2, 2) << 1.0, 0.0, 0.0, 1.0).finished();
+  Matrix A1 = (Matrix(2, 2) << 2.0, 0.0, 0.0, 2.0).finished();
+  Vector b = Vector2(0.5, -0.5);
+  JacobianFactor jacobian(1, A0, 3, A1, b,
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  HessianFactor hessian(jacobian);
+
+  // Destination has keys {3, 1}, i.e. the factor's variables reversed
+  KeyVector infoKeys {3, 1};
+  SymmetricBlockMatrix expectedInfo(list_of(2)(2)(1));
+  expectedInfo.setZero();
+  jacobian.updateHessian(infoKeys, &expectedInfo);
+  hessian.updateHessian(infoKeys, &expectedInfo);
+
+  vector<DenseIndex> slots {1, 0, 2}; // key 1 -> block 1, key 3 -> block 0
+  SymmetricBlockMatrix actualInfo(list_of(2)(2)(1));
+  actualInfo.setZero();
+  jacobian.updateHessian(infoKeys, slots, &actualInfo);
+  hessian.updateHessian(infoKeys, slots, &actualInfo);
+
+  EXPECT(assert_equal(Matrix(expectedInfo.selfadjointView()),
+      Matrix(actualInfo.selfadjointView()), tol));
+}
+
 /* ************************************************************************* */
 TEST(HessianFactor, gradientAtZero)
 {
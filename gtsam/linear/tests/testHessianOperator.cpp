@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testHessianOperator.cpp
+ * @brief Unit tests for the compiled Hessian-vector product operator
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/HessianOperator.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A small graph mixing noise models, factor arities, and factor types
+static GaussianFactorGraph mixedGraph() {
+  GaussianFactorGraph gfg;
+  gfg.add(0, I_2x2, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  gfg.add(0, -I_2x2, 1, I_2x2, Vector2(0.1, 0.2),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  gfg.add(1, -I_2x2, 2, I_2x2, Vector2(0.3, 0.4),
+      noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.3)));
+  Matrix2 G11 = 2.0 * I_2x2, G22 = 3.0 * I_2x2;
+  Matrix2 G12;
+  G12 << 0.5, 0.1, 0.0, 0.2;
+  gfg.push_back(HessianFactor(0, 2, G11, G12, Vector2(0.1, 0.1), G22,
+      Vector2(0.2, 0.2), 1.0));
+  return gfg;
+}
+
+/* ************************************************************************* */
+static VectorValues exampleX() {
+  VectorValues x;
+  x.insert(0, Vector2(1.0, -2.0));
+  x.insert(1, Vector2(0.5, 0.25));
+  x.insert(2, Vector2(-1.5, 3.0));
+  return x;
+}
+
+/* ************************************************************************* */
+TEST(HessianOperator, matchesGenericPath) {
+  GaussianFactorGraph gfg = mixedGraph();
+  const VectorValues x = exampleX();
+
+  VectorValues expected;
+  gfg.multiplyHessianAdd(2.0, x, expected);
+
+  HessianOperator op(gfg);
+  VectorValues actual;
+  op.multiplyHessianAdd(2.0, x, actual);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+
+  // Applying again accumulates, just like the generic path
+  gfg.multiplyHessianAdd(-0.5, x, expected);
+  op.multiplyHessianAdd(-0.5, x, actual);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(HessianOperator, flatInterface) {
+  GaussianFactorGraph gfg = mixedGraph();
+  const VectorValues x = exampleX();
+
+  HessianOperator op(gfg);
+  EXPECT_LONGS_EQUAL(6, op.numCols());
+
+  // Flat apply agrees with the VectorValues apply, using the KeyInfo layout
+  Vector xFlat(op.numCols());
+  for (const KeyInfo::value_type& entry : op.keyInfo())
+    xFlat.segment(entry.second.start, entry.second.dim) = x.at(entry.first);
+  Vector yFlat = Vector::Zero(op.numCols());
+  op.multiplyHessianAdd(1.0, xFlat, yFlat);
+
+  VectorValues y;
+  op.multiplyHessianAdd(1.0, x, y);
+  for (const KeyInfo::value_type& entry : op.keyInfo())
+    EXPECT(assert_equal(Vector(y.at(entry.first)),
+        Vector(yFlat.segment(entry.second.start, entry.second.dim)), 1e-9));
+
+  // Mis-sized flat vectors are rejected
+  Vector tooShort = Vector::Zero(op.numCols() - 1);
+  CHECK_EXCEPTION(op.multiplyHessianAdd(1.0, tooShort, yFlat),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
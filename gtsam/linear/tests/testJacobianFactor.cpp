@@ -23,6 +23,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/IterativeSolver.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <boost/assign/std/vector.hpp>
@@ -142,6 +143,25 @@ TEST(JacobianFactor, constructors_and_accessors)
     EXPECT(noise == expected.get_model());
     EXPECT(noise == actual.get_model());
   }
+  {
+    // Move constructor taking ownership of keys and block matrix
+    JacobianFactor expected(
+      boost::make_iterator_range(terms.begin(), terms.begin() + 3), b, noise);
+    VerticalBlockMatrix blockMatrix(list_of(3)(3)(3)(1), 3);
+    blockMatrix(0) = terms[0].second;
+    blockMatrix(1) = terms[1].second;
+    blockMatrix(2) = terms[2].second;
+    blockMatrix(3) = b;
+    KeyVector keys = list_of(terms[0].first)(terms[1].first)(terms[2].first);
+    SharedDiagonal model = noise;
+    JacobianFactor actual(std::move(keys), std::move(blockMatrix), std::move(model));
+    EXPECT(assert_equal(expected, actual));
+    LONGS_EQUAL((long)terms[2].first, (long)actual.keys().back());
+    EXPECT(assert_equal(terms[2].second, actual.getA(actual.end() - 1)));
+    EXPECT(assert_equal(b, expected.getb()));
+    EXPECT(assert_equal(b, actual.getb()));
+    EXPECT(noise == actual.get_model());
+  }
 }
 
 /* ************************************************************************* */
@@ -340,6 +360,57 @@ TEST(JacobianFactor, matrices)
   EXPECT(assert_equal(36*I_3x3,actualBD[15]));
 }
 
+/* ************************************************************************* */
+TEST(JacobianFactor, flatAccumulators)
+{
+  JacobianFactor factor(simple::terms, simple::b, simple::noise);
+  GaussianFactorGraph gfg;
+  gfg.push_back(factor);
+  const KeyInfo keyInfo(gfg);
+  const size_t n = keyInfo.numCols();
+
+  // The Hessian diagonal accumulated into a flat buffer matches the
+  // VectorValues version; calling twice accumulates twice
+  vector<double> diag(n, 0.0);
+  factor.addHessianDiagonalTo(keyInfo, diag.data());
+  factor.addHessianDiagonalTo(keyInfo, diag.data());
+  const VectorValues expectedDiagonal = factor.hessianDiagonal();
+  for (const auto& key_entry : keyInfo) {
+    const Vector actual = 0.5
+        * Eigen::Map<const Vector>(diag.data() + key_entry.second.start,
+            key_entry.second.dim);
+    EXPECT(assert_equal(expectedDiagonal.at(key_entry.first), actual));
+  }
+
+  // Gradient at zero
+  vector<double> g0(n, 0.0);
+  factor.addGradientAtZeroTo(keyInfo, g0.data());
+  const VectorValues expectedGrad0 = factor.gradientAtZero();
+  for (const auto& key_entry : keyInfo) {
+    const Vector actual = Eigen::Map<const Vector>(
+        g0.data() + key_entry.second.start, key_entry.second.dim);
+    EXPECT(assert_equal(expectedGrad0.at(key_entry.first), actual));
+  }
+
+  // Gradient at a nonzero point equals gradientAtZero + A'A x
+  VectorValues x;
+  x.insert(5, Vector3(0.1, -0.2, 0.3));
+  x.insert(10, Vector3(0.0, 0.5, -0.1));
+  x.insert(15, Vector3(-0.3, 0.2, 0.1));
+  VectorValues expectedGrad = factor.gradientAtZero();
+  factor.multiplyHessianAdd(1.0, x, expectedGrad);
+  vector<double> xflat(n, 0.0), g(n, 0.0);
+  for (const auto& key_entry : keyInfo)
+    Eigen::Map<Vector>(xflat.data() + key_entry.second.start,
+        key_entry.second.dim) = x.at(key_entry.first);
+  factor.addGradientTo(keyInfo, xflat.data(), g.data());
+  for (const auto& key_entry : keyInfo) {
+    const Vector actual = Eigen::Map<const Vector>(
+        g.data() + key_entry.second.start, key_entry.second.dim);
+    EXPECT(assert_equal(expectedGrad.at(key_entry.first), actual));
+  }
+}
+
 /* ************************************************************************* */
 TEST(JacobianFactor, operators )
 {
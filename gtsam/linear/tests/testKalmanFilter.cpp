@@ -286,6 +286,44 @@ TEST( KalmanFilter, QRvsCholesky ) {
   EXPECT(assert_equal(expected2, pb3->covariance(), 1e-7));
 }
 
+/* ************************************************************************* */
+// The square-root fast path must agree with the factor-graph reference path
+TEST( KalmanFilter, fastPath ) {
+
+  // Non-trivial dynamics and measurement models
+  Matrix F = (Matrix(2, 2) << 1.0, 0.1, 0.2, 1.1).finished();
+  Matrix B = (Matrix(2, 3) << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8).finished();
+  Vector u = Vector3(1.0, 0.0, 2.0);
+  SharedDiagonal modelQ = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.3));
+  Matrix H = (Matrix(1, 2) << 1.0, -0.5).finished();
+  Vector z = Vector1(0.4);
+  SharedDiagonal modelR = noiseModel::Isotropic::Sigma(1, 0.2);
+
+  KalmanFilter kf(2);
+  State x_initial(0.2, -0.1);
+  KalmanFilter::State p0 = kf.init(x_initial, noiseModel::Isotropic::Sigma(2, 0.5));
+
+  // Predict: same step index, mean and information as the reference path
+  KalmanFilter::State p1 = kf.predict(p0, F, B, u, modelQ);
+  KalmanFilter::State p1f = kf.predictFast(p0, F, B, u, modelQ);
+  LONGS_EQUAL((long)KalmanFilter::step(p1), (long)KalmanFilter::step(p1f));
+  EXPECT(assert_equal(p1->mean(), p1f->mean()));
+  EXPECT(assert_equal(p1->information(), p1f->information(), 1e-7));
+
+  // Update with fewer measurement rows than state dimensions
+  KalmanFilter::State p2 = kf.update(p1, H, z, modelR);
+  KalmanFilter::State p2f = kf.updateFast(p1f, H, z, modelR);
+  LONGS_EQUAL((long)KalmanFilter::step(p2), (long)KalmanFilter::step(p2f));
+  EXPECT(assert_equal(p2->mean(), p2f->mean()));
+  EXPECT(assert_equal(p2->information(), p2f->information(), 1e-7));
+
+  // The fast states feed back into the reference path and vice versa
+  KalmanFilter::State p3 = kf.predict(p2f, F, B, u, modelQ);
+  KalmanFilter::State p3f = kf.predictFast(p2, F, B, u, modelQ);
+  EXPECT(assert_equal(p3->mean(), p3f->mean()));
+  EXPECT(assert_equal(p3->information(), p3f->information(), 1e-7));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
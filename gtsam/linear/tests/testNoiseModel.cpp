@@ -99,6 +99,30 @@ TEST(NoiseModel, constructors)
   EXPECT(assert_equal(expected,H));
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, WhitenInPlaceBatch)
+{
+  // Batch whitening must agree with whitening each block individually, for all model types
+  vector<Gaussian::shared_ptr> models;
+  models.push_back(Gaussian::SqrtInformation(R));
+  models.push_back(Diagonal::Sigmas(Vector3(kSigma, 0.5 * kSigma, 2.0 * kSigma)));
+  models.push_back(Isotropic::Sigma(3, kSigma));
+  models.push_back(Unit::Create(3));
+  models.push_back(Constrained::MixedSigmas(Vector3(kSigma, 0.0, kSigma)));
+
+  const Matrix A1 = (Matrix(3, 2) << 1., 2., 3., 4., 5., 6.).finished();
+  const Matrix A2 = (Matrix(3, 2) << -1., 0.5, 2., -3., 0., 4.).finished();
+
+  for(const Gaussian::shared_ptr& model: models) {
+    vector<Matrix> batch;
+    batch.push_back(A1);
+    batch.push_back(A2);
+    model->WhitenInPlaceBatch(batch);
+    EXPECT(assert_equal(model->Whiten(A1), batch[0]));
+    EXPECT(assert_equal(model->Whiten(A2), batch[1]));
+  }
+}
+
 /* ************************************************************************* */
 TEST(NoiseModel, Unit)
 {
@@ -505,6 +529,23 @@ TEST(NoiseModel, robustFunctionCauchy)
   DOUBLES_EQUAL(0.490258914416017, cauchy->residual(error4), 1e-8);
 }
 
+TEST(NoiseModel, robustFunctionVectorizedWeights)
+{
+  // The vectorized weight kernels must agree with the scalar weight function
+  const Vector4 error(1.0, 10.0, -10.0, -1.0);
+  std::vector<mEstimator::Base::shared_ptr> estimators;
+  estimators.push_back(mEstimator::Huber::Create(5.0));
+  estimators.push_back(mEstimator::Cauchy::Create(5.0));
+  estimators.push_back(mEstimator::Tukey::Create(5.0));
+  estimators.push_back(mEstimator::Null::Create());
+  for (const mEstimator::Base::shared_ptr& estimator : estimators) {
+    Vector expected(4);
+    for (int i = 0; i < 4; ++i)
+      expected(i) = estimator->weight(error(i));
+    EXPECT(assert_equal(expected, estimator->weight(error), 1e-12));
+  }
+}
+
 TEST(NoiseModel, robustFunctionGemanMcClure)
 {
   const double k = 1.0, error1 = 1.0, error2 = 10.0, error3 = -10.0, error4 = -1.0;
@@ -719,6 +760,24 @@ TEST(NoiseModel, NonDiagonalGaussian)
   }
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, IsotropicInterning)
+{
+  // Smart isotropic construction hands out shared singletons per (dim, sigma)
+  Isotropic::shared_ptr a = Isotropic::Sigma(3, 0.5);
+  EXPECT(a.get() == Isotropic::Sigma(3, 0.5).get());
+  EXPECT(a.get() == Isotropic::Variance(3, 0.25).get());
+  EXPECT(a.get() != Isotropic::Sigma(3, 0.25).get());
+  EXPECT(a.get() != Isotropic::Sigma(2, 0.5).get());
+
+  // smart=false always allocates a private model
+  EXPECT(a.get() != Isotropic::Sigma(3, 0.5, false).get());
+
+  // Unit models of common dimension are preconstructed singletons
+  EXPECT(Unit::Create(3).get() == Unit::Create(3).get());
+  EXPECT(Unit::Create(3).get() == Isotropic::Sigma(3, 1.0).get());
+}
+
 /* ************************************************************************* */
 int main() {  TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
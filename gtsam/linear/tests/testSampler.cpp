@@ -37,6 +37,21 @@ TEST(testSampler, basic) {
   EXPECT(assert_equal(sampler2.sample(), sampler3.sample(), tol));
 }
 
+/* ************************************************************************* */
+TEST(testSampler, samples) {
+  Vector sigmas = Vector3(1.0, 0.1, 0.0);
+  noiseModel::Diagonal::shared_ptr model = noiseModel::Diagonal::Sigmas(sigmas);
+  Sampler sampler1(model, 1), sampler2(model, 1);
+
+  // One batched call produces the same stream as repeated sample() calls
+  const size_t N = 5;
+  Matrix batched = sampler1.samples(N);
+  EXPECT_LONGS_EQUAL(3, batched.rows());
+  EXPECT_LONGS_EQUAL(N, batched.cols());
+  for (size_t j = 0; j < N; j++)
+    EXPECT(assert_equal(sampler2.sample(), Vector(batched.col(j)), tol));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
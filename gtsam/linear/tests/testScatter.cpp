@@ -17,6 +17,7 @@
 
 #include <gtsam/linear/Scatter.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/Symbol.h>
 #include <CppUnitLite/TestHarness.h>
 
@@ -57,6 +58,34 @@ TEST(HessianFactor, CombineAndEliminate) {
   EXPECT_LONGS_EQUAL(n, scatter.at(1).dimension);
 }
 
+/* ************************************************************************* */
+TEST(Scatter, partialOrdering) {
+  static const size_t n = 3;
+  Matrix A = Matrix::Identity(n, n);
+  Vector3 b(1.5, 1.5, 1.5);
+  auto model = noiseModel::Isotropic::Sigma(n, 0.5);
+
+  GaussianFactorGraph gfg;
+  gfg.add(X(1), A, b, model);
+  gfg.add(X(0), A, X(1), -A, b, model);
+  gfg.add(X(1), A, X(2), -A, b, model);
+
+  // Ordered variables come first, in ordering order, including X(5) which
+  // appears in no factor (dimension 0); the rest follow sorted by key
+  Ordering ordering;
+  ordering += X(2), X(5);
+  Scatter scatter(gfg, ordering);
+  EXPECT_LONGS_EQUAL(4, scatter.size());
+  EXPECT(assert_equal(X(2), scatter.at(0).key));
+  EXPECT(assert_equal(X(5), scatter.at(1).key));
+  EXPECT(assert_equal(X(0), scatter.at(2).key));
+  EXPECT(assert_equal(X(1), scatter.at(3).key));
+  EXPECT_LONGS_EQUAL(n, scatter.at(0).dimension);
+  EXPECT_LONGS_EQUAL(0, scatter.at(1).dimension);
+  EXPECT_LONGS_EQUAL(n, scatter.at(2).dimension);
+  EXPECT_LONGS_EQUAL(n, scatter.at(3).dimension);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSparseEigenSolver.cpp
+ * @brief   Unit tests for the Eigen sparse solver bridge
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/linear/SparseEigenSolver.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+static GaussianFactorGraph createSimpleGraph() {
+  GaussianFactorGraph gfg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  SharedDiagonal half2 = noiseModel::Isotropic::Sigma(2, 0.5);
+  gfg.add(0, 10 * I_2x2, -1.0 * Vector::Ones(2), unit2);
+  gfg.add(0, -10 * I_2x2, 1, 10 * I_2x2, Vector2(2.0, -1.0), half2);
+  gfg.add(1, -5 * I_2x2, 2, 5 * I_2x2, Vector2(0.0, 1.0), unit2);
+  gfg.add(0, -5 * I_2x2, 2, 5 * I_2x2, Vector2(-1.0, 1.5), half2);
+  return gfg;
+}
+
+/* ************************************************************************* */
+TEST(SparseEigenSolver, optimizeEigenCholesky) {
+  GaussianFactorGraph gfg = createSimpleGraph();
+  VectorValues expected = gfg.optimize();
+  VectorValues actual = optimizeEigenCholesky(gfg);
+  EXPECT(assert_equal(expected, actual, 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(SparseEigenSolver, optimizeEigenQR) {
+  GaussianFactorGraph gfg = createSimpleGraph();
+  VectorValues expected = gfg.optimize();
+  VectorValues actual = optimizeEigenQR(gfg);
+  EXPECT(assert_equal(expected, actual, 1e-8));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
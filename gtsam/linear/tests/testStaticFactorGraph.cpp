@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testStaticFactorGraph.cpp
+ * @brief   Unit tests for the fully static fixed-topology linear solver
+ */
+
+#include <gtsam/linear/StaticFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+// A small fixed topology: two 3-dimensional states and one 2-dimensional bias
+typedef StaticFactorGraph<3, 3, 2> Graph;
+
+/* ************************************************************************* */
+TEST(StaticFactorGraph, layout) {
+  // The layout is all compile-time
+  static_assert(Graph::TotalDim == 8, "total dimension");
+  static_assert(Graph::NumVariables == 3, "variable count");
+  static_assert(Graph::Variable<0>::Offset == 0, "offset 0");
+  static_assert(Graph::Variable<1>::Offset == 3, "offset 1");
+  static_assert(Graph::Variable<2>::Offset == 6, "offset 2");
+  static_assert(Graph::Variable<2>::Dim == 2, "dim 2");
+}
+
+/* ************************************************************************* */
+TEST(StaticFactorGraph, solve) {
+  // Pseudo-random fixed-size Jacobian blocks
+  const Eigen::Matrix3d P1 = Eigen::Matrix3d::Identity() * 2.0;
+  const Eigen::Vector3d b1(1.0, -1.0, 0.5);
+  Eigen::Matrix<double, 4, 3> A1;
+  A1 << 1, 0, 2, 0, 1, 0, 1, 1, 0, 0, 2, 1;
+  Eigen::Matrix<double, 4, 3> A2;
+  A2 << -1, 0, 0, 0, -1, 1, 2, 0, -1, 1, 1, 1;
+  Eigen::Vector4d b12(0.5, 0.25, -0.5, 1.0);
+  Eigen::Matrix<double, 2, 3> B1;
+  B1 << 1, 2, 0, 0, 1, 1;
+  Eigen::Matrix2d B2;
+  B2 << 3, 0, 1, 2;
+  Eigen::Vector2d b13(2.0, -1.0);
+
+  Graph graph;
+  graph.addUnary<0>(P1, b1);
+  graph.addBinary<0, 1>(A1, A2, b12);
+  graph.addBinary<1, 2>(B1, B2, b13);
+
+  // Reference: assemble the same system as one dense least-squares problem
+  Matrix A = Matrix::Zero(9, 8);
+  Vector b = Vector::Zero(9);
+  A.block<3, 3>(0, 0) = P1;
+  b.segment<3>(0) = b1;
+  A.block<4, 3>(3, 0) = A1;
+  A.block<4, 3>(3, 3) = A2;
+  b.segment<4>(3) = b12;
+  A.block<2, 3>(7, 3) = B1;
+  A.block<2, 2>(7, 6) = B2;
+  b.segment<2>(7) = b13;
+  const Vector expected = (A.transpose() * A).llt().solve(A.transpose() * b);
+
+  const Graph::StateVector x = graph.solve();
+  EXPECT(assert_equal(expected, Vector(x), 1e-9));
+
+  // Per-variable extraction matches the corresponding state segments
+  EXPECT(assert_equal(Vector(expected.segment<3>(0)), Vector(Graph::at<0>(x)), 1e-9));
+  EXPECT(assert_equal(Vector(expected.segment<2>(6)), Vector(Graph::at<2>(x)), 1e-9));
+
+  // clear() resets the system for the next cycle
+  graph.clear();
+  EXPECT(assert_equal(Matrix(Matrix::Zero(8, 8)), Matrix(graph.information()), 1e-15));
+}
+
+/* ************************************************************************* */
+TEST(StaticFactorGraph, indeterminate) {
+  // Leaving variable 2 unconstrained makes the system singular; the
+  // exception reports its position in the layout
+  Graph graph;
+  graph.addUnary<0>(Eigen::Matrix3d(Eigen::Matrix3d::Identity()),
+                    Eigen::Vector3d(1.0, 2.0, 3.0));
+  graph.addUnary<1>(Eigen::Matrix3d(Eigen::Matrix3d::Identity()),
+                    Eigen::Vector3d(0.0, 0.0, 0.0));
+  try {
+    graph.solve();
+    FAIL("solve should have thrown IndeterminantLinearSystemException");
+  } catch (const IndeterminantLinearSystemException& e) {
+    LONGS_EQUAL(2, e.nearbyVariable());
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -168,6 +168,13 @@ TEST(VectorValues, LinearAlgebra)
   EXPECT(assert_equal(scalExpected, scalActual.vector()));
   VectorValues scal2Actual = 5.0 * test1;
   EXPECT(assert_equal(scalExpected, scal2Actual.vector()));
+
+  // In-place axpy, y += alpha*x
+  Vector axpyExpected = test2.vector() + 3.0 * test1.vector();
+  VectorValues axpyActual = test2;
+  axpy(3.0, test1, axpyActual);
+  EXPECT(axpyActual.hasSameStructure(test2));
+  EXPECT(assert_equal(axpyExpected, axpyActual.vector()));
 }
 
 /* ************************************************************************* */
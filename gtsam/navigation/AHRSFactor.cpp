@@ -59,6 +59,35 @@ void PreintegratedAhrsMeasurements::integrateMeasurement(
   preintMeasCov_ = Fr * preintMeasCov_ * Fr.transpose() + p().gyroscopeCovariance * deltaT;
 }
 
+//------------------------------------------------------------------------------
+void PreintegratedAhrsMeasurements::integrateMeasurements(
+    const Matrix& measuredOmegas, const Vector& deltaTs,
+    bool float32Covariance) {
+
+  // Shared batched rotation recursion, recording the per-step Jacobians
+  std::vector<Matrix3> Fs;
+  PreintegratedRotation::integrateMeasurements(measuredOmegas, deltaTs,
+      biasHat_, &Fs);
+
+  // First order uncertainty propagation, step by step as in
+  // integrateMeasurement
+  if (float32Covariance) {
+    // Reduced-precision accumulation: the recursion touches only 3x3 blocks,
+    // so all of it stays in float until the final conversion
+    Eigen::Matrix3f P = preintMeasCov_.cast<float>();
+    const Eigen::Matrix3f Q = p().gyroscopeCovariance.cast<float>();
+    for (size_t k = 0; k < Fs.size(); ++k) {
+      const Eigen::Matrix3f F = Fs[k].cast<float>();
+      P = F * P * F.transpose() + Q * static_cast<float>(deltaTs(k));
+    }
+    preintMeasCov_ = P.cast<double>();
+  } else {
+    for (size_t k = 0; k < Fs.size(); ++k)
+      preintMeasCov_ = Fs[k] * preintMeasCov_ * Fs[k].transpose()
+          + p().gyroscopeCovariance * deltaTs(k);
+  }
+}
+
 //------------------------------------------------------------------------------
 Vector3 PreintegratedAhrsMeasurements::predict(const Vector3& bias,
     OptionalJacobian<3,3> H) const {
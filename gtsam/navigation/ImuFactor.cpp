@@ -91,8 +91,36 @@ void PreintegratedImuMeasurements::integrateMeasurements(
   assert(measuredAccs.cols() == dts.cols());
   assert(measuredOmegas.cols() == dts.cols());
   size_t n = static_cast<size_t>(dts.cols());
+
+  // Validate the whole buffer up front so the hot loop runs check-free
+  for (size_t j = 0; j < n; j++) {
+    if (dts(0, j) <= 0) {
+      throw std::runtime_error(
+          "PreintegratedImuMeasurements::integrateMeasurements: dt <=0");
+    }
+  }
+
+  // Hoist the noise parameters out of the per-sample loop; going through the
+  // public single-sample API would re-fetch them from the shared parameter
+  // object on every sample
+  const Matrix3& aCov = p().accelerometerCovariance;
+  const Matrix3& wCov = p().gyroscopeCovariance;
+  const Matrix3& iCov = p().integrationCovariance;
+
+  Matrix9 A;
+  Matrix93 B, C;
   for (size_t j = 0; j < n; j++) {
-    integrateMeasurement(measuredAccs.col(j), measuredOmegas.col(j), dts(0, j));
+    const double dt = dts(0, j);
+    // NOTE: the qualified call resolves statically, so the whole buffer is
+    // processed without virtual dispatch
+    PreintegrationType::update(measuredAccs.col(j), measuredOmegas.col(j), dt,
+                               &A, &B, &C);
+
+    // First-order covariance propagation, as in the single-sample overload
+    preintMeasCov_ = A * preintMeasCov_ * A.transpose();
+    preintMeasCov_.noalias() += B * (aCov / dt) * B.transpose();
+    preintMeasCov_.noalias() += C * (wCov / dt) * C.transpose();
+    preintMeasCov_.block<3, 3>(3, 3).noalias() += iCov * dt;
   }
 }
 
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  MeasurementBatcher.cpp
+ *  @brief Accumulate high-rate unary measurements into one equivalent factor
+ *  @author Frank Dellaert
+ **/
+
+#include <gtsam/navigation/MeasurementBatcher.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void MeasurementBatcher::add(Key key, const Vector& measurement,
+    const SharedNoiseModel& model) {
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(model.get());
+  if (!gaussian)
+    throw invalid_argument(
+        "MeasurementBatcher::add: only Gaussian noise models can be combined "
+        "analytically");
+  if ((DenseIndex) gaussian->dim() != measurement.size())
+    throw invalid_argument(
+        "MeasurementBatcher::add: measurement and noise model dimensions "
+        "disagree");
+
+  const Matrix information = gaussian->information();
+  FastMap<Key, Accumulator>::iterator it = buffers_.find(key);
+  if (it == buffers_.end()) {
+    Accumulator accumulator;
+    accumulator.information = information;
+    accumulator.weighted = information * measurement;
+    accumulator.count = 1;
+    buffers_.emplace(key, accumulator);
+  } else {
+    if (it->second.weighted.size() != measurement.size())
+      throw invalid_argument(
+          "MeasurementBatcher::add: measurement dimension changed for key");
+    it->second.information += information;
+    it->second.weighted += information * measurement;
+    it->second.count += 1;
+  }
+}
+
+/* ************************************************************************* */
+size_t MeasurementBatcher::count(Key key) const {
+  FastMap<Key, Accumulator>::const_iterator it = buffers_.find(key);
+  return it == buffers_.end() ? 0 : it->second.count;
+}
+
+/* ************************************************************************* */
+CombinedMeasurement MeasurementBatcher::Combine(
+    const Accumulator& accumulator) {
+  CombinedMeasurement result;
+  // The information-weighted mean minimizes the summed quadratic errors
+  result.measurement = accumulator.information.ldlt().solve(
+      accumulator.weighted);
+  result.model = noiseModel::Gaussian::Information(accumulator.information);
+  result.count = accumulator.count;
+  return result;
+}
+
+/* ************************************************************************* */
+CombinedMeasurement MeasurementBatcher::combined(Key key) const {
+  FastMap<Key, Accumulator>::const_iterator it = buffers_.find(key);
+  if (it == buffers_.end())
+    throw invalid_argument(
+        "MeasurementBatcher::combined: no measurements buffered for key");
+  return Combine(it->second);
+}
+
+/* ************************************************************************* */
+FastMap<Key, CombinedMeasurement> MeasurementBatcher::flush() {
+  FastMap<Key, CombinedMeasurement> result;
+  for (const FastMap<Key, Accumulator>::value_type& entry : buffers_)
+    result.emplace(entry.first, Combine(entry.second));
+  buffers_.clear();
+  return result;
+}
+
+/* ************************************************************************* */
+
+}  // namespace gtsam
@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  MeasurementBatcher.h
+ *  @brief Accumulate high-rate unary measurements into one equivalent factor
+ *  @author Frank Dellaert
+ **/
+
+#pragma once
+
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/base/FastMap.h>
+
+namespace gtsam {
+
+/**
+ * One combined measurement returned by MeasurementBatcher: the
+ * information-weighted mean of the buffered measurements, the noise model
+ * with their summed information, and how many measurements it stands for.
+ */
+struct GTSAM_EXPORT CombinedMeasurement {
+  Vector measurement;
+  SharedNoiseModel model;
+  size_t count;
+
+  CombinedMeasurement() : count(0) {}
+};
+
+/**
+ * Measurement-compression stage for sensors that arrive far above the
+ * keyframe rate, such as GPS (GPSFactor), wheel odometry, and magnetometer
+ * (MagFactor) streams.  Adding every sample as its own unary factor grows
+ * the graph with factors that all pull on the same key; instead, buffer the
+ * samples here between updates and add a single factor per key built from
+ * flush().
+ *
+ * The combination is analytic: for measurements z_i with Gaussian
+ * information matrices Lambda_i on the same key, the sum of the quadratic
+ * errors ||h(x) - z_i||^2_i equals ||h(x) - z||^2 under the summed
+ * information plus a constant, where z is the information-weighted mean.
+ * This is exact whenever the factors share the same (possibly nonlinear)
+ * measurement function h and the error is h(x) - z, as in the factors
+ * above.  The accumulation is streaming - O(1) memory per key regardless
+ * of rate - so a 100 Hz sensor between 1 Hz keyframes compresses 100x.
+ *
+ * Robust (non-Gaussian) noise models cannot be summed this way and are
+ * rejected.
+ */
+class GTSAM_EXPORT MeasurementBatcher {
+ public:
+  MeasurementBatcher() {}
+
+  /**
+   * Buffer one measurement for the given key.  All measurements for a key
+   * must have the same dimension, and the model must be Gaussian.
+   */
+  void add(Key key, const Vector& measurement, const SharedNoiseModel& model);
+
+  /// Number of keys with buffered measurements
+  size_t size() const { return buffers_.size(); }
+
+  /// Whether any measurements are buffered
+  bool empty() const { return buffers_.empty(); }
+
+  /// Number of measurements buffered for the given key
+  size_t count(Key key) const;
+
+  /// The combined measurement for one key, without clearing the buffer
+  CombinedMeasurement combined(Key key) const;
+
+  /// Combine the buffers of all keys and clear the batcher
+  FastMap<Key, CombinedMeasurement> flush();
+
+ private:
+  /// Streaming sums: information and information-weighted measurement
+  struct Accumulator {
+    Matrix information;
+    Vector weighted;
+    size_t count;
+  };
+
+  static CombinedMeasurement Combine(const Accumulator& accumulator);
+
+  FastMap<Key, Accumulator> buffers_;
+};
+
+}  // namespace gtsam
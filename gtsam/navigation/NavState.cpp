@@ -17,6 +17,14 @@
  **/
 
 #include <gtsam/navigation/NavState.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+#include <algorithm>
 
 using namespace std;
 
@@ -211,6 +219,131 @@ NavState NavState::update(const Vector3& b_acceleration, const Vector3& b_omega,
   return newState;
 }
 
+//------------------------------------------------------------------------------
+NavState::Batch::Batch(const std::vector<NavState>& states) :
+    positions(3, states.size()), velocities(3, states.size()) {
+  rotations.reserve(states.size());
+  for (size_t i = 0; i < states.size(); ++i) {
+    rotations.push_back(states[i].attitude());
+    positions.col(i) = states[i].position();
+    velocities.col(i) = states[i].velocity();
+  }
+}
+
+//------------------------------------------------------------------------------
+void NavState::UpdateBatch(const Vector3& b_acceleration,
+    const Vector3& b_omega, double dt, Batch* batch,
+    std::vector<Matrix9>* Fs) {
+  const size_t n = batch->size();
+
+  if (Fs) {
+    // The 9x9 Jacobians are state-specific; delegate to the scalar path
+    Fs->resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      const NavState updated = batch->at(i).update(b_acceleration, b_omega,
+          dt, (*Fs)[i], boost::none, boost::none);
+      batch->rotations[i] = updated.attitude();
+      batch->positions.col(i) = updated.position();
+      batch->velocities.col(i) = updated.velocity();
+    }
+    return;
+  }
+
+  // Writing out update()/retract() in the nav frame gives, per state i:
+  //   R_i' = R_i * Expmap(dt * b_omega)
+  //   p_i' = p_i + dt * v_i + dt^2/2 * R_i * a
+  //   v_i' = v_i + dt * R_i * a
+  // The rotation increment is common to all states, and the position and
+  // velocity updates become packed expressions over the 3xN arrays once the
+  // nav-frame accelerations are gathered.
+  const double dt22 = 0.5 * dt * dt;
+  const Rot3 bRc = Rot3::Expmap(dt * b_omega);
+
+  Matrix n_a(3, n);
+  for (size_t i = 0; i < n; ++i)
+    n_a.col(i) = batch->rotations[i].rotate(Point3(b_acceleration));
+
+  batch->positions += dt * batch->velocities + dt22 * n_a;
+  batch->velocities += dt * n_a;
+
+  const std::vector<Rot3> increments(n, bRc);
+  Rot3::BatchCompose(batch->rotations, increments, &batch->rotations);
+}
+
+//------------------------------------------------------------------------------
+NavState NavState::compose(const NavState& other) const {
+  return NavState(R_ * other.R_, t_ + R_ * other.t_, v_ + R_ * other.v_);
+}
+
+//------------------------------------------------------------------------------
+std::vector<NavState> NavState::ComposePrefixes(const NavState& origin,
+    const std::vector<NavState>& increments, size_t blockSize) {
+  const size_t n = increments.size();
+  std::vector<NavState> result(n);
+  if (n == 0)
+    return result;
+
+  // Small chains: plain sequential scan
+  if (n <= blockSize) {
+    NavState state = origin;
+    for (size_t i = 0; i < n; ++i) {
+      state = state.compose(increments[i]);
+      result[i] = state;
+    }
+    return result;
+  }
+
+  const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+  // Pass 1: prefix products local to each block, independent across blocks
+  auto localScan = [&](size_t block) {
+    const size_t start = block * blockSize;
+    const size_t end = std::min(start + blockSize, n);
+    result[start] = increments[start];
+    for (size_t i = start + 1; i < end; ++i)
+      result[i] = result[i - 1].compose(increments[i]);
+  };
+
+  // Pass 2: shift each block by the accumulated product of all earlier blocks
+  std::vector<NavState> blockOffsets(numBlocks);
+  auto applyOffset = [&](size_t block) {
+    const size_t start = block * blockSize;
+    const size_t end = std::min(start + blockSize, n);
+    for (size_t i = start; i < end; ++i)
+      result[i] = blockOffsets[block].compose(result[i]);
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t block = range.begin(); block != range.end(); ++block)
+          localScan(block);
+      });
+#else
+  for (size_t block = 0; block < numBlocks; ++block)
+    localScan(block);
+#endif
+
+  // Sequential combine of block totals: O(numBlocks), the scan's "log" term
+  blockOffsets[0] = origin;
+  for (size_t block = 1; block < numBlocks; ++block)
+    blockOffsets[block] =
+        blockOffsets[block - 1].compose(result[block * blockSize - 1]);
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t block = range.begin(); block != range.end(); ++block)
+          applyOffset(block);
+      });
+#else
+  for (size_t block = 0; block < numBlocks; ++block)
+    applyOffset(block);
+#endif
+
+  return result;
+}
+
 //------------------------------------------------------------------------------
 Vector9 NavState::coriolis(double dt, const Vector3& omega, bool secondOrder,
     OptionalJacobian<9, 9> H) const {
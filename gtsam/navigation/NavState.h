@@ -22,6 +22,8 @@
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/Manifold.h>
 
+#include <vector>
+
 namespace gtsam {
 
 /// Velocity is currently typedef'd to Vector3
@@ -174,6 +176,67 @@ public:
       const double dt, OptionalJacobian<9, 9> F, OptionalJacobian<9, 3> G1,
       OptionalJacobian<9, 3> G2) const;
 
+  /**
+   * Structure-of-arrays storage for a batch of navigation states: rotations
+   * in a flat vector, positions and velocities as one column per state in
+   * contiguous 3xN matrices, so batched propagation can run packed
+   * arithmetic over whole rows instead of state-by-state.
+   */
+  struct GTSAM_EXPORT Batch {
+    std::vector<Rot3> rotations;
+    Matrix positions;   ///< 3xN, column i is the position of state i
+    Matrix velocities;  ///< 3xN, column i is the velocity of state i
+
+    Batch() : positions(3, 0), velocities(3, 0) {}
+
+    /// Gather a set of states into structure-of-arrays form
+    explicit Batch(const std::vector<NavState>& states);
+
+    size_t size() const { return rotations.size(); }
+
+    /// Reassemble state i
+    NavState at(size_t i) const {
+      return NavState(rotations[i], Point3(positions.col(i)),
+          velocities.col(i));
+    }
+  };
+
+  /**
+   * Propagate every state of a batch with a common body-frame IMU sample,
+   * equivalent to calling update() on each state.  The tangent rotation
+   * increment and its exponential are shared by all states, the position and
+   * velocity updates are evaluated as packed row-wise expressions over the
+   * 3xN arrays, and the rotations are composed with Rot3::BatchCompose, so
+   * e.g. 512 hypotheses of a multi-hypothesis tracker propagate with
+   * lane-parallel math instead of 512 scalar calls.  If Fs is given it is
+   * filled with the per-state 9x9 state Jacobians; these are inherently
+   * state-specific, so requesting them falls back to the scalar path.
+   */
+  static void UpdateBatch(const Vector3& b_acceleration,
+      const Vector3& b_omega, double dt, Batch* batch,
+      std::vector<Matrix9>* Fs = nullptr);
+
+  /**
+   * Composition in the matrix group embedding of matrix(): the composed
+   * rotation is R()*other.R(), and other's position and velocity are rotated
+   * into this frame and added.  Used to chain relative dead-reckoning
+   * increments; agrees with the product matrix()*other.matrix().
+   */
+  NavState compose(const NavState& other) const;
+
+  /**
+   * Chain a sequence of relative increments into absolute states:
+   * result[i] = origin * increments[0] * ... * increments[i] under compose().
+   * Because composition is associative this is evaluated as a blocked
+   * two-pass prefix scan - local prefixes per block, a cheap sequential
+   * combine of block totals, then a parallel offset pass - so initializing
+   * e.g. 10k keyframes from per-keyframe preintegration deltas runs in
+   * O(n/p + n/blockSize) parallel time with TBB instead of one sequential
+   * chain.  Without TBB the same blocked scan runs sequentially.
+   */
+  static std::vector<NavState> ComposePrefixes(const NavState& origin,
+      const std::vector<NavState>& increments, size_t blockSize = 1024);
+
   /// Compute tangent space contribution due to Coriolis forces
   Vector9 coriolis(double dt, const Vector3& omega, bool secondOrder = false,
       OptionalJacobian<9, 9> H = boost::none) const;
@@ -21,6 +21,8 @@
 
 #include "PreintegratedRotation.h"
 
+#include <stdexcept>
+
 using namespace std;
 
 namespace gtsam {
@@ -113,6 +115,45 @@ void PreintegratedRotation::integrateMeasurement(const Vector3& measuredOmega,
       - D_incrR_integratedOmega * deltaT;
 }
 
+void PreintegratedRotation::integrateMeasurements(const Matrix& measuredOmegas,
+    const Vector& deltaTs, const Vector3& biasHat, std::vector<Matrix3>* Fs) {
+  if (measuredOmegas.rows() != 3 || measuredOmegas.cols() != deltaTs.size())
+    throw std::invalid_argument(
+        "PreintegratedRotation::integrateMeasurements: measuredOmegas must be "
+        "3xN with one column per entry of deltaTs");
+
+  // Bias and sensor-frame corrections for the whole batch, as packed
+  // matrix expressions instead of one small product per sample
+  Matrix correctedOmegas = measuredOmegas.colwise() - biasHat;
+  if (p_->body_P_sensor)
+    correctedOmegas = p_->body_P_sensor->rotation().matrix() * correctedOmegas;
+
+  const DenseIndex n = deltaTs.size();
+  if (Fs) {
+    Fs->clear();
+    Fs->reserve(n);
+  }
+
+  // The remaining recursion is inherently sequential, exactly as in
+  // integrateMeasurement but without the per-call correction overhead
+  for (DenseIndex k = 0; k < n; ++k) {
+    const double deltaT = deltaTs(k);
+    const Vector3 integratedOmega = correctedOmegas.col(k) * deltaT;
+    Matrix3 D_incrR_integratedOmega;
+    const Rot3 incrR = Rot3::Expmap(integratedOmega, D_incrR_integratedOmega);
+
+    deltaTij_ += deltaT;
+    Matrix3 F;
+    deltaRij_ = deltaRij_.compose(incrR, F);
+
+    const Matrix3 incrRt = incrR.transpose();
+    delRdelBiasOmega_ = incrRt * delRdelBiasOmega_
+        - D_incrR_integratedOmega * deltaT;
+
+    if (Fs) Fs->push_back(F);
+  }
+}
+
 Rot3 PreintegratedRotation::biascorrectedDeltaRij(const Vector3& biasOmegaIncr,
     OptionalJacobian<3, 3> H) const {
   const Vector3 biasInducedOmega = delRdelBiasOmega_ * biasOmegaIncr;
@@ -159,6 +159,21 @@ class GTSAM_EXPORT PreintegratedRotation {
                             OptionalJacobian<3, 3> D_incrR_integratedOmega = boost::none,
                             OptionalJacobian<3, 3> F = boost::none);
 
+  /**
+   * Batched version of integrateMeasurement for high-rate gyros, with
+   * structure-of-arrays inputs: column k of measuredOmegas is the k-th gyro
+   * sample and deltaTs(k) its time interval.  The bias and sensor-frame
+   * corrections are applied to the whole batch as one packed 3xN matrix
+   * expression; only the inherently sequential Expmap/compose recursion then
+   * runs per column.  Equivalent to calling integrateMeasurement once per
+   * column.  If Fs is given it is filled with the per-step Jacobians of the
+   * updated deltaRij w.r.t. the previous one, which derived classes need to
+   * propagate covariance.
+   */
+  void integrateMeasurements(const Matrix& measuredOmegas, const Vector& deltaTs,
+                             const Vector3& biasHat,
+                             std::vector<Matrix3>* Fs = nullptr);
+
   /// Return a bias corrected version of the integrated rotation, with optional Jacobian
   Rot3 biascorrectedDeltaRij(const Vector3& biasOmegaIncr,
                              OptionalJacobian<3, 3> H = boost::none) const;
@@ -17,6 +17,12 @@
 
 #include <gtsam/navigation/ScenarioRunner.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/assign.hpp>
 #include <cmath>
@@ -54,26 +60,65 @@ NavState ScenarioRunner::predict(const PreintegratedImuMeasurements& pim,
   return pim.predict(state_i, estimatedBias);
 }
 
-Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
-                                           const Bias& estimatedBias) const {
-  gttic_(estimateCovariance);
+Matrix ScenarioRunner::integrateRuns(double T, size_t R,
+                                     const Bias& estimatedBias) const {
+  gttic_(integrateRuns);
+
+  const double dt = imuSampleTime();
+  const size_t nrSteps = T / dt;
 
   // Get predict prediction from ground truth measurements
-  NavState prediction = predict(integrate(T));
+  const NavState prediction = predict(integrate(T));
 
-  // Sample !
-  Matrix samples(9, N);
-  Vector9 sum = Vector9::Zero();
-  for (size_t i = 0; i < N; i++) {
-    auto pim = integrate(T, estimatedBias, true);
-    NavState sampled = predict(pim);
-    Vector9 xi = sampled.localCoordinates(prediction);
-    samples.col(i) = xi;
-    sum += xi;
+  // Evaluate the noise-free biased measurements once, shared by all runs
+  Matrix actualOmegas(3, nrSteps), actualAccs(3, nrSteps);
+  double t = 0;
+  for (size_t k = 0; k < nrSteps; k++, t += dt) {
+    actualOmegas.col(k) = actualAngularVelocity(t) + estimatedBias_.gyroscope();
+    actualAccs.col(k) = actualSpecificForce(t) + estimatedBias_.accelerometer();
   }
 
+  // Draw the noise for all runs up front, one batch per sampler.  Each
+  // sampler's stream is exactly what R sequential integrate() calls would
+  // consume, so the errors below do not depend on the thread count.
+  const Matrix gyroNoise = gyroSampler_.samples(nrSteps * R) / sqrt_dt_;
+  const Matrix accNoise = accSampler_.samples(nrSteps * R) / sqrt_dt_;
+
+  // Integrate the runs, each worker reusing a single preintegration object
+  Matrix errors(9, R);
+  auto integrateRun = [&](PreintegratedImuMeasurements& pim, size_t i) {
+    pim.resetIntegration();
+    for (size_t k = 0; k < nrSteps; k++) {
+      const size_t col = i * nrSteps + k;
+      pim.integrateMeasurement(actualAccs.col(k) + accNoise.col(col),
+                               actualOmegas.col(k) + gyroNoise.col(col), dt);
+    }
+    errors.col(i) = predict(pim).localCoordinates(prediction);
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, R),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      PreintegratedImuMeasurements pim(p_, estimatedBias);
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        integrateRun(pim, i);
+                    });
+#else
+  PreintegratedImuMeasurements pim(p_, estimatedBias);
+  for (size_t i = 0; i < R; i++) integrateRun(pim, i);
+#endif
+
+  return errors;
+}
+
+Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
+                                           const Bias& estimatedBias) const {
+  gttic_(estimateCovariance);
+
+  // Integrate all corrupted runs in one batch
+  const Matrix samples = integrateRuns(T, N, estimatedBias);
+
   // Compute MC covariance
-  Vector9 sampleMean = sum / N;
+  Vector9 sampleMean = samples.rowwise().sum() / N;
   Matrix9 Q;
   Q.setZero();
   for (size_t i = 0; i < N; i++) {
@@ -85,16 +130,13 @@ Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
 }
 
 Matrix6 ScenarioRunner::estimateNoiseCovariance(size_t N) const {
+  // Draw all samples in one batch per sampler
   Matrix samples(6, N);
-  Vector6 sum = Vector6::Zero();
-  for (size_t i = 0; i < N; i++) {
-    samples.col(i) << accSampler_.sample() / sqrt_dt_,
-        gyroSampler_.sample() / sqrt_dt_;
-    sum += samples.col(i);
-  }
+  samples.topRows<3>() = accSampler_.samples(N) / sqrt_dt_;
+  samples.bottomRows<3>() = gyroSampler_.samples(N) / sqrt_dt_;
 
   // Compute MC covariance
-  Vector6 sampleMean = sum / N;
+  Vector6 sampleMean = samples.rowwise().sum() / N;
   Matrix6 Q;
   Q.setZero();
   for (size_t i = 0; i < N; i++) {
@@ -98,6 +98,19 @@ class GTSAM_EXPORT ScenarioRunner {
   NavState predict(const PreintegratedImuMeasurements& pim,
                    const Bias& estimatedBias = Bias()) const;
 
+  /**
+   * Integrate R corrupted runs of T seconds in one call and return a 9xR
+   * matrix whose columns are the tangent-space errors of each run's
+   * prediction with respect to the ground-truth prediction.  The noise for
+   * all runs is drawn up front in one batch per sampler (so each sampler's
+   * stream matches R sequential integrate() calls and the result does not
+   * depend on the thread count), the noise-free measurements are evaluated
+   * once and shared by all runs, and with TBB the runs integrate in
+   * parallel, each worker reusing a single preintegration object.
+   */
+  Matrix integrateRuns(double T, size_t R,
+                       const Bias& estimatedBias = Bias()) const;
+
   /// Compute a Monte Carlo estimate of the predict covariance using N samples
   Matrix9 estimateCovariance(double T, size_t N = 1000,
                              const Bias& estimatedBias = Bias()) const;
@@ -119,6 +119,42 @@ TEST( AHRSFactor, PreintegratedMeasurements ) {
   DOUBLES_EQUAL(expectedDeltaT2, actual2.deltaTij(), 1e-6);
 }
 
+//******************************************************************************
+TEST( AHRSFactor, PreintegratedMeasurementsBatch ) {
+  auto p = boost::make_shared<PreintegratedAhrsMeasurements::Params>();
+  p->gyroscopeCovariance = I_3x3 * 1e-4;
+  Vector3 bias(0.01, -0.02, 0.03);
+
+  // A short high-rate burst in structure-of-arrays form
+  const size_t n = 10;
+  Matrix measuredOmegas(3, n);
+  Vector deltaTs(n);
+  for (size_t k = 0; k < n; k++) {
+    measuredOmegas.col(k) = Vector3(0.1 * k, 0.05, -0.02 * k);
+    deltaTs(k) = 0.01;
+  }
+
+  // Sequential integration is the reference
+  PreintegratedAhrsMeasurements expected(p, bias);
+  for (size_t k = 0; k < n; k++)
+    expected.integrateMeasurement(measuredOmegas.col(k), deltaTs(k));
+
+  // The batched version must match exactly
+  PreintegratedAhrsMeasurements actual(p, bias);
+  actual.integrateMeasurements(measuredOmegas, deltaTs);
+  EXPECT(assert_equal(expected.deltaRij(), actual.deltaRij(), 1e-9));
+  DOUBLES_EQUAL(expected.deltaTij(), actual.deltaTij(), 1e-9);
+  EXPECT(assert_equal(expected.delRdelBiasOmega(), actual.delRdelBiasOmega(), 1e-9));
+  EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(), 1e-9));
+
+  // The reduced-precision covariance path agrees to single precision,
+  // and leaves the rotation recursion untouched
+  PreintegratedAhrsMeasurements reduced(p, bias);
+  reduced.integrateMeasurements(measuredOmegas, deltaTs, true);
+  EXPECT(assert_equal(expected.deltaRij(), reduced.deltaRij(), 1e-9));
+  EXPECT(assert_equal(expected.preintMeasCov(), reduced.preintMeasCov(), 1e-6));
+}
+
 //******************************************************************************
 TEST( AHRSFactor, PreintegratedAhrsMeasurementsConstructor ) {
   Matrix3 gyroscopeCovariance = Matrix3::Ones()*0.4;
@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testMeasurementBatcher.cpp
+ * @brief Unit tests for high-rate unary measurement batching
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/navigation/MeasurementBatcher.h>
+#include <gtsam/navigation/GPSFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(MeasurementBatcher, WeightedMean) {
+  MeasurementBatcher batcher;
+  // Two 3D fixes: sigma 1 and sigma 0.5, informations I and 4I
+  batcher.add(1, Vector3(1.0, 2.0, 3.0), noiseModel::Isotropic::Sigma(3, 1.0));
+  batcher.add(1, Vector3(2.0, 0.0, 1.0), noiseModel::Isotropic::Sigma(3, 0.5));
+  EXPECT_LONGS_EQUAL(1, batcher.size());
+  EXPECT_LONGS_EQUAL(2, batcher.count(1));
+
+  const CombinedMeasurement combined = batcher.combined(1);
+  EXPECT_LONGS_EQUAL(2, combined.count);
+  // mean = (z1 + 4 z2) / 5, information = 5I
+  EXPECT(assert_equal(Vector3(9.0 / 5.0, 2.0 / 5.0, 7.0 / 5.0),
+      Vector3(combined.measurement), 1e-9));
+  const noiseModel::Gaussian* gaussian =
+      dynamic_cast<const noiseModel::Gaussian*>(combined.model.get());
+  CHECK(gaussian);
+  EXPECT(assert_equal(Matrix(5.0 * I_3x3), gaussian->information(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(MeasurementBatcher, EquivalentGPSFactor) {
+  // Buffer a burst of GPS fixes and compare the combined factor against the
+  // graph of individual factors: same Hessian and gradient, graph 5x smaller
+  const Key key = 1;
+  MeasurementBatcher batcher;
+  NonlinearFactorGraph individual;
+  for (size_t i = 0; i < 5; i++) {
+    const Point3 fix(1.0 + 0.1 * i, 2.0 - 0.2 * i, 0.5 * i);
+    const SharedNoiseModel model =
+        noiseModel::Isotropic::Sigma(3, 0.5 + 0.3 * i);
+    individual.emplace_shared<GPSFactor>(key, fix, model);
+    batcher.add(key, fix.vector(), model);
+  }
+
+  FastMap<Key, CombinedMeasurement> flushed = batcher.flush();
+  EXPECT_LONGS_EQUAL(1, flushed.size());
+  EXPECT(batcher.empty());
+  const CombinedMeasurement& combined = flushed.at(key);
+  NonlinearFactorGraph batched;
+  batched.emplace_shared<GPSFactor>(key, Point3(combined.measurement),
+      combined.model);
+
+  // The quadratic errors agree up to a constant, so the linearizations
+  // match in Hessian and gradient at any linearization point
+  Values values;
+  values.insert(key, Pose3(Rot3::Ypr(0.1, -0.2, 0.3), Point3(0.5, 1.0, -2.0)));
+  Matrix expectedHessian, actualHessian;
+  Vector expectedGradient, actualGradient;
+  boost::tie(expectedHessian, expectedGradient) =
+      individual.linearize(values)->hessian();
+  boost::tie(actualHessian, actualGradient) =
+      batched.linearize(values)->hessian();
+  EXPECT(assert_equal(expectedHessian, actualHessian, 1e-9));
+  EXPECT(assert_equal(expectedGradient, actualGradient, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(MeasurementBatcher, MultipleKeys) {
+  MeasurementBatcher batcher;
+  batcher.add(1, Vector3(1.0, 0.0, 0.0), noiseModel::Isotropic::Sigma(3, 1.0));
+  batcher.add(2, Vector3(0.0, 1.0, 0.0), noiseModel::Isotropic::Sigma(3, 1.0));
+  batcher.add(1, Vector3(3.0, 0.0, 0.0), noiseModel::Isotropic::Sigma(3, 1.0));
+  EXPECT_LONGS_EQUAL(2, batcher.size());
+  EXPECT_LONGS_EQUAL(2, batcher.count(1));
+  EXPECT_LONGS_EQUAL(1, batcher.count(2));
+  EXPECT_LONGS_EQUAL(0, batcher.count(3));
+
+  // Equal informations reduce to the plain mean
+  EXPECT(assert_equal(Vector3(2.0, 0.0, 0.0),
+      Vector3(batcher.combined(1).measurement), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(MeasurementBatcher, RejectsInvalid) {
+  MeasurementBatcher batcher;
+  batcher.add(1, Vector3(1.0, 2.0, 3.0), noiseModel::Isotropic::Sigma(3, 1.0));
+
+  // Robust models cannot be summed analytically
+  const SharedNoiseModel robust = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(1.345),
+      noiseModel::Isotropic::Sigma(3, 1.0));
+  CHECK_EXCEPTION(batcher.add(1, Vector3(1.0, 2.0, 3.0), robust),
+      std::invalid_argument);
+
+  // Dimensions must stay consistent per key
+  CHECK_EXCEPTION(
+      batcher.add(1, Vector2(1.0, 2.0), noiseModel::Isotropic::Sigma(2, 1.0)),
+      std::invalid_argument);
+  CHECK_EXCEPTION(batcher.combined(99), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
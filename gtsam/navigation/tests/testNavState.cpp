@@ -194,6 +194,82 @@ TEST(NavState, Update) {
 }
 #endif
 
+/* ************************************************************************* */
+TEST(NavState, UpdateBatch) {
+  const Vector3 omega(0.1, 0.2, 0.3);
+  const Vector3 acc(0.4, 0.5, 0.6);
+  const double dt = 0.01;
+
+  std::vector<NavState> states;
+  states.push_back(kState1);
+  states.push_back(NavState(Rot3::RzRyRx(-0.2, 0.1, 0.4),
+      Point3(5.0, 1.0, -50.0), Vector3(0.5, 0.0, 0.0)));
+  states.push_back(kIdentity);
+
+  // Value-only propagation must match the scalar update exactly
+  NavState::Batch batch(states);
+  NavState::UpdateBatch(acc, omega, dt, &batch);
+  LONGS_EQUAL(3, batch.size());
+  for (size_t i = 0; i < states.size(); ++i) {
+    const NavState expected = states[i].update(acc, omega, dt, boost::none,
+        boost::none, boost::none);
+    EXPECT(assert_equal(expected, batch.at(i), 1e-9));
+  }
+
+  // Requesting Jacobians must reproduce the scalar F as well
+  NavState::Batch batch2(states);
+  std::vector<Matrix9> Fs;
+  NavState::UpdateBatch(acc, omega, dt, &batch2, &Fs);
+  LONGS_EQUAL(3, Fs.size());
+  for (size_t i = 0; i < states.size(); ++i) {
+    Matrix9 expectedF;
+    const NavState expected = states[i].update(acc, omega, dt, expectedF,
+        boost::none, boost::none);
+    EXPECT(assert_equal(expected, batch2.at(i), 1e-9));
+    EXPECT(assert_equal(expectedF, Fs[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(NavState, Compose) {
+  const NavState other(Rot3::RzRyRx(-0.2, 0.1, 0.4), Point3(5.0, 1.0, -50.0),
+      Vector3(0.5, 0.0, 0.0));
+
+  // Composition agrees with the matrix group embedding
+  const NavState actual = kState1.compose(other);
+  const Matrix7 expected = kState1.matrix() * other.matrix();
+  EXPECT(assert_equal(expected, actual.matrix(), 1e-9));
+  EXPECT(assert_equal(kState1, kState1.compose(kIdentity), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(NavState, ComposePrefixes) {
+  // A chain of distinct relative increments
+  std::vector<NavState> increments;
+  for (size_t i = 0; i < 10; ++i)
+    increments.push_back(NavState(Rot3::RzRyRx(0.1 * i, -0.02 * i, 0.3),
+        Point3(1.0, 0.1 * i, -0.5), Vector3(0.01 * i, 0.2, 0.0)));
+
+  // Expected: plain sequential dead-reckoning chain
+  std::vector<NavState> expected;
+  NavState state = kState1;
+  for (size_t i = 0; i < increments.size(); ++i) {
+    state = state.compose(increments[i]);
+    expected.push_back(state);
+  }
+
+  // The blocked scan must match, with blocks both larger and smaller than n
+  std::vector<NavState> actual = NavState::ComposePrefixes(kState1, increments);
+  LONGS_EQUAL(10, actual.size());
+  for (size_t i = 0; i < increments.size(); ++i)
+    EXPECT(assert_equal(expected[i], actual[i], 1e-9));
+
+  std::vector<NavState> blocked =
+      NavState::ComposePrefixes(kState1, increments, 3);
+  for (size_t i = 0; i < increments.size(); ++i)
+    EXPECT(assert_equal(expected[i], blocked[i], 1e-9));
+}
+
 /* ************************************************************************* */
 static const double dt = 2.0;
 boost::function<Vector9(const NavState&, const bool&)> coriolis = boost::bind(
@@ -75,6 +75,31 @@ TEST(ScenarioRunner, Spin) {
   EXPECT(assert_equal(estimatedCov, pim.preintMeasCov(), 1e-5));
 }
 
+/* ************************************************************************* */
+TEST(ScenarioRunner, IntegrateRuns) {
+  //  angular velocity 6 degree/sec
+  const double w = 6 * kDegree;
+  const Vector3 W(0, 0, w), V(0, 0, 0);
+  const ConstantTwistScenario scenario(W, V);
+
+  // Two identical runners so the sampler streams line up
+  auto p = defaultParams();
+  ScenarioRunner batched(scenario, p, kDt), sequential(scenario, p, kDt);
+  const double T = 5 * kDt;  // seconds
+  const size_t R = 4;
+
+  // The batched driver must reproduce R sequential corrupted integrations
+  const Matrix errors = batched.integrateRuns(T, R);
+  LONGS_EQUAL(9, (long)errors.rows());
+  LONGS_EQUAL(R, (long)errors.cols());
+  const NavState prediction = sequential.predict(sequential.integrate(T));
+  for (size_t i = 0; i < R; i++) {
+    auto pim = sequential.integrate(T, imuBias::ConstantBias(), true);
+    Vector9 xi = sequential.predict(pim).localCoordinates(prediction);
+    EXPECT_NEAR(xi, errors.col(i), 1e-9);
+  }
+}
+
 /* ************************************************************************* */
 namespace forward {
 const double v = 2;  // m/s
@@ -24,12 +24,19 @@ namespace gtsam {
 /* ************************************************************************* */
 VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
     double delta, const VectorValues& dx_u, const VectorValues& dx_n, const bool verbose) {
+  return ComputeDoglegPoint(delta, dx_u, dx_n, CachedDoglegProducts(dx_u, dx_n), verbose);
+}
+
+/* ************************************************************************* */
+VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
+    double delta, const VectorValues& dx_u, const VectorValues& dx_n,
+    const CachedDoglegProducts& products, const bool verbose) {
 
   // Get magnitude of each update and find out which segment delta falls in
   assert(delta >= 0.0);
   double deltaSq = delta*delta;
-  double x_u_norm_sq = dx_u.squaredNorm();
-  double x_n_norm_sq = dx_n.squaredNorm();
+  double x_u_norm_sq = products.uu;
+  double x_n_norm_sq = products.nn;
   if(verbose) cout << "Steepest descent magnitude " << std::sqrt(x_u_norm_sq) << ", Newton's method magnitude " << std::sqrt(x_n_norm_sq) << endl;
   if(deltaSq < x_u_norm_sq) {
     // Trust region is smaller than steepest descent update
@@ -38,7 +45,7 @@ VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
     return x_d;
   } else if(deltaSq < x_n_norm_sq) {
     // Trust region boundary is between steepest descent point and Newton's method point
-    return ComputeBlend(delta, dx_u, dx_n, verbose);
+    return ComputeBlend(delta, dx_u, dx_n, products, verbose);
   } else {
     assert(deltaSq >= x_n_norm_sq);
     if(verbose) cout << "In pure Newton's method region" << endl;
@@ -49,13 +56,19 @@ VectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
 
 /* ************************************************************************* */
 VectorValues DoglegOptimizerImpl::ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose) {
+  return ComputeBlend(delta, x_u, x_n, CachedDoglegProducts(x_u, x_n), verbose);
+}
+
+/* ************************************************************************* */
+VectorValues DoglegOptimizerImpl::ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n,
+    const CachedDoglegProducts& products, const bool verbose) {
 
   // See doc/trustregion.lyx or doc/trustregion.pdf
 
-  // Compute inner products
-  const double un = dot(x_u, x_n);
-  const double uu = dot(x_u, x_u);
-  const double nn = dot(x_n, x_n);
+  // Inner products, computed once per linearization by the caller
+  const double un = products.un;
+  const double uu = products.uu;
+  const double nn = products.nn;
 
   // Compute quadratic formula terms
   const double a = uu - 2.*un + nn;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <iomanip>
+#include <vector>
 
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/Ordering.h>
@@ -37,6 +38,27 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
     double f_error;
   };
 
+  /** Inner products of the steepest descent point \f$ \delta x_u \f$ and the
+   * Gauss-Newton point \f$ \delta x_n \f$, computed once per linearization.
+   * Every candidate dogleg point is a combination of the same two vectors, so
+   * trust-region backtracking only needs these scalars plus an axpy to form
+   * each retry, instead of re-evaluating the inner products per retry. */
+  struct GTSAM_EXPORT CachedDoglegProducts {
+    double uu; ///< squared norm of the steepest descent point
+    double nn; ///< squared norm of the Gauss-Newton point
+    double un; ///< inner product of the two points
+    CachedDoglegProducts(const VectorValues& dx_u, const VectorValues& dx_n)
+        : uu(dot(dx_u, dx_u)), nn(dot(dx_n, dx_n)), un(dot(dx_u, dx_n)) {}
+  };
+
+  /** A candidate dogleg point for one trust-region radius, as produced by
+   * EvaluateCandidateDeltas */
+  struct GTSAM_EXPORT CandidateResult {
+    double delta;
+    VectorValues dx_d;
+    double M_error; ///< model error \f$ M(\delta x_d) \f$ under the factorization
+  };
+
   /** Specifies how the trust region is adapted at each Dogleg iteration.  If
    * this is SEARCH_EACH_ITERATION, then the trust region radius will be
    * increased potentially multiple times during one iteration until increasing
@@ -120,6 +142,12 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    */
   static VectorValues ComputeDoglegPoint(double delta, const VectorValues& dx_u, const VectorValues& dx_n, const bool verbose=false);
 
+  /** Overload of ComputeDoglegPoint taking precomputed inner products of the
+   * two endpoints, so that trust-region backtracking only recombines the
+   * cached vectors instead of re-evaluating dot products on every retry. */
+  static VectorValues ComputeDoglegPoint(double delta, const VectorValues& dx_u, const VectorValues& dx_n,
+      const CachedDoglegProducts& products, const bool verbose=false);
+
   /** Compute the point on the line between the steepest descent point and the
    * Newton's method point intersecting the trust region boundary.
    * Mathematically, computes \f$ \tau \f$ such that \f$ 0<\tau<1 \f$ and
@@ -130,6 +158,44 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+  /** Overload of ComputeBlend taking precomputed inner products of the two
+   * endpoints, see the corresponding ComputeDoglegPoint overload. */
+  static VectorValues ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n,
+      const CachedDoglegProducts& products, const bool verbose=false);
+
+  /**
+   * Evaluate several candidate trust-region radii against a single
+   * factorization.  For each radius in \c deltas the dogleg point is formed
+   * from the cached endpoints and its model error \f$ M(\delta x_d) \f$ is
+   * evaluated on \c Rd, without re-eliminating or re-solving.  This allows
+   * e.g. radius line searches to amortize one Gauss-Newton solve over many
+   * candidate steps.
+   *
+   * @tparam M The type of the Bayes' net or tree, as in Iterate.
+   * @param deltas The candidate trust region radii.
+   * @param dx_u The steepest descent point, i.e. the Cauchy point
+   * @param dx_n The Gauss-Newton point
+   * @param Rd The Bayes' net or tree obtained from the single factorization.
+   * @return One CandidateResult per radius, in the same order as \c deltas.
+   */
+  template<class M>
+  static std::vector<CandidateResult> EvaluateCandidateDeltas(
+      const std::vector<double>& deltas, const VectorValues& dx_u, const VectorValues& dx_n,
+      const M& Rd, const bool verbose=false)
+  {
+    const CachedDoglegProducts products(dx_u, dx_n);
+    std::vector<CandidateResult> results;
+    results.reserve(deltas.size());
+    for(double delta: deltas) {
+      CandidateResult candidate;
+      candidate.delta = delta;
+      candidate.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, products, verbose);
+      candidate.M_error = Rd.error(candidate.dx_d);
+      results.push_back(candidate);
+    }
+    return results;
+  }
 };
 
 
@@ -143,6 +209,10 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   const double M_error = Rd.error(VectorValues::Zero(dx_u));
   gttoc(M_error);
 
+  // The dogleg endpoints do not change while the trust region is adapted, so
+  // compute their inner products once for all retries
+  const CachedDoglegProducts products(dx_u, dx_n);
+
   // Result to return
   IterationResult result;
 
@@ -151,7 +221,7 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   while(stay) {
     gttic(Dog_leg_point);
     // Compute dog leg point
-    result.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, verbose);
+    result.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, products, verbose);
     gttoc(Dog_leg_point);
 
     if(verbose) std::cout << "delta = " << delta << ", dx_d_norm = " << result.dx_d.norm() << std::endl;
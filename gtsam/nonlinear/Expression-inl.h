@@ -53,6 +53,7 @@ template<typename A>
 Expression<T>::Expression(typename UnaryFunction<A>::type function,
     const Expression<A>& expression) :
     root_(new internal::UnaryExpression<T, A>(function, expression)) {
+  foldIfConstant();
 }
 
 /// Construct a binary function expression
@@ -63,6 +64,7 @@ Expression<T>::Expression(typename BinaryFunction<A1, A2>::type function,
     root_(
         new internal::BinaryExpression<T, A1, A2>(function, expression1,
             expression2)) {
+  foldIfConstant();
 }
 
 /// Construct a ternary function expression
@@ -74,6 +76,7 @@ Expression<T>::Expression(typename TernaryFunction<A1, A2, A3>::type function,
     root_(
         new internal::TernaryExpression<T, A1, A2, A3>(function, expression1,
             expression2, expression3)) {
+  foldIfConstant();
 }
 
 /// Construct a nullary method expression
@@ -84,6 +87,7 @@ Expression<T>::Expression(const Expression<A>& expression,
     root_(
         new internal::UnaryExpression<T, A>(boost::bind(method, _1, _2),
             expression)) {
+  foldIfConstant();
 }
 
 /// Construct a unary method expression
@@ -96,6 +100,7 @@ Expression<T>::Expression(const Expression<A1>& expression1,
     root_(
         new internal::BinaryExpression<T, A1, A2>(
             boost::bind(method, _1, _2, _3, _4), expression1, expression2)) {
+  foldIfConstant();
 }
 
 /// Construct a binary method expression
@@ -111,6 +116,15 @@ Expression<T>::Expression(const Expression<A1>& expression1,
         new internal::TernaryExpression<T, A1, A2, A3>(
             boost::bind(method, _1, _2, _3, _4, _5, _6), expression1,
             expression2, expression3)) {
+  foldIfConstant();
+}
+
+template<typename T>
+void Expression<T>::foldIfConstant() {
+  if (root_->keys().empty()) {
+    static const Values kEmptyValues;
+    root_.reset(new internal::ConstantExpression<T>(root_->value(kEmptyValues)));
+  }
 }
 
 template<typename T>
@@ -190,29 +204,18 @@ template<typename T>
 T Expression<T>::valueAndJacobianMap(const Values& values,
     internal::JacobianMap& jacobians) const {
   // The following piece of code is absolutely crucial for performance.
-  // We allocate a block of memory on the stack, which can be done at runtime
-  // with modern C++ compilers. The traceExecution then fills this memory
-  // with an execution trace, made up entirely of "Record" structs, see
-  // the FunctionalNode class in expression-inl.h
-  size_t size = traceSize();
-
-  // Windows does not support variable length arrays, so memory must be dynamically
-  // allocated on Visual Studio. For more information see the issue below
-  // https://bitbucket.org/gtborg/gtsam/issue/178/vlas-unsupported-in-visual-studio
-#ifdef _MSC_VER
-  auto traceStorage = static_cast<internal::ExecutionTraceStorage*>(_aligned_malloc(size, internal::TraceAlignment));
-#else
-  internal::ExecutionTraceStorage traceStorage[size];
-#endif
+  // The trace is laid out in a flat per-thread buffer, which traceExecution
+  // fills with placement-new'ed "Record" structs, see the FunctionalNode
+  // class in ExpressionNode.h. The buffer is grow-only, so once it has
+  // reached the size of the largest trace no heap allocation happens per
+  // linearize call, on any platform.
+  internal::ExecutionTraceStorage* traceStorage =
+      internal::traceBuffer(traceSize());
 
   internal::ExecutionTrace<T> trace;
   T value(this->traceExecution(values, trace, traceStorage));
   trace.startReverseAD1(jacobians);
 
-#ifdef _MSC_VER
-  _aligned_free(traceStorage);
-#endif
-
   return value;
 }
 
@@ -270,6 +273,10 @@ template <typename T>
 BinarySumExpression<T>::BinarySumExpression(const Expression<T>& e1, const Expression<T>& e2)
     : Expression<T>(boost::make_shared<internal::BinarySumNode<T>>(e1, e2)) {}
 
+template <typename T>
+CachedExpression<T>::CachedExpression(const Expression<T>& e)
+    : Expression<T>(boost::make_shared<internal::CachedExpressionNode<T>>(e)) {}
+
 template <typename T>
 Expression<T>& Expression<T>::operator+=(const Expression<T>& e) {
   root_ = boost::make_shared<internal::BinarySumNode<T>>(*this, e);
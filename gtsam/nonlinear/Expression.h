@@ -182,6 +182,16 @@ protected:
   /// Default constructor, for serialization
   Expression() {}
 
+  /**
+   * Replace the root with a single constant node if the tree contains no
+   * leaf keys: its value can never change, so it is evaluated once here.
+   * Run by the function-expression constructors, this collapses constant
+   * subtrees - e.g. chains of compose over fixed rig transforms - at
+   * construction, shrinking both the execution trace and the per-linearize
+   * work to a single cached value.
+   */
+  void foldIfConstant();
+
   /// Keys and dimensions in same order
   typedef std::pair<KeyVector, FastVector<int> > KeysAndDims;
   KeysAndDims keysAndDims() const;
@@ -232,6 +242,22 @@ class BinarySumExpression : public Expression<T> {
   explicit BinarySumExpression(const Expression<T>& e1, const Expression<T>& e2);
 };
 
+/**
+ *  A CachedExpression wraps a subexpression and memoizes its value and Jacobians:
+ *  as long as the values of the leaves under it are unchanged since the last
+ *  linearization, the cached results are reused instead of re-executing the subtree.
+ *  This pays off for large subtrees whose variables are rarely updated, e.g.
+ *  calibration and extrinsics shared by many factors of a camera rig.
+ *  The cache lives in the wrapped node, so factors sharing the subtree share it too;
+ *  under TBB it is protected by a mutex so factors may be linearized concurrently
+ *  against the same Values.
+ */
+template <typename T>
+class CachedExpression : public Expression<T> {
+ public:
+  explicit CachedExpression(const Expression<T>& e);
+};
+
 
 /**
  * Create an expression out of a linear function f:T->A with (constant) Jacobian dTdA
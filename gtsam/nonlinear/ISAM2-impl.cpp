@@ -18,6 +18,7 @@
  */
 
 #include <gtsam/base/debug.h>
+#include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/config.h>            // for GTSAM_USE_TBB
 #include <gtsam/inference/Symbol.h>  // for selective linearization thresholds
 #include <gtsam/nonlinear/ISAM2-impl.h>
@@ -33,36 +34,62 @@ namespace gtsam {
 
 /* ************************************************************************* */
 namespace internal {
-inline static void optimizeInPlace(const ISAM2::sharedClique& clique,
-                                   VectorValues* result) {
-  // parents are assumed to already be solved and available in result
-  result->update(clique->conditional()->solve(*result));
-
-  // starting from the root, call optimize on each conditional
-  for (const ISAM2::sharedClique& child : clique->children)
-    optimizeInPlace(child, result);
-}
+// Adapts the ISAM2 roots to the forest concept expected by the generic tree
+// traversals, so the full back-substitution below can reuse the same parallel
+// task-graph machinery as GaussianBayesTree::optimize.
+struct DeltaForest {
+  typedef ISAM2::Clique Node;
+  const ISAM2::Roots& roots_;
+  explicit DeltaForest(const ISAM2::Roots& roots) : roots_(roots) {}
+  const ISAM2::Roots& roots() const { return roots_; }
+};
+
+// Pre-order visitor that solves each clique in place.  A clique is always
+// visited after its parent, and sibling subtrees write disjoint frontal keys
+// into the concurrent delta map, so running subtrees in parallel tasks is safe.
+struct OptimizeInPlaceVisitor {
+  VectorValues* result_;
+  explicit OptimizeInPlaceVisitor(VectorValues* result) : result_(result) {}
+  char operator()(const ISAM2::sharedClique& clique, char) const {
+    result_->update(clique->conditional()->solve(*result_));
+    return 0;
+  }
+};
 }  // namespace internal
 
 /* ************************************************************************* */
 size_t DeltaImpl::UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
                                            const KeySet& replacedKeys,
                                            double wildfireThreshold,
-                                           VectorValues* delta) {
+                                           VectorValues* delta,
+                                           KeySet* changedKeys,
+                                           const WildfireThresholds* zones) {
   size_t lastBacksubVariableCount;
 
   if (wildfireThreshold <= 0.0) {
-    // Threshold is zero or less, so do a full recalculation
-    for (const ISAM2::sharedClique& root : roots)
-      internal::optimizeInPlace(root, delta);
+    // Threshold is zero or less, so do a full recalculation.  Independent
+    // subtrees are solved in parallel tasks once their parent clique is done.
+    internal::DeltaForest forest(roots);
+    internal::OptimizeInPlaceVisitor visitor(delta);
+    treeTraversal::no_op postVisitor;
+    char rootData = 0;
+    TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
+    treeTraversal::DepthFirstForestParallel(forest, rootData, visitor,
+                                            postVisitor);
     lastBacksubVariableCount = delta->size();
 
+    // A full recalculation may have touched every entry
+    if (changedKeys)
+      for (const VectorValues::KeyValuePair& key_delta : *delta)
+        changedKeys->insert(key_delta.first);
+
   } else {
     // Optimize with wildfire
     lastBacksubVariableCount = 0;
     for (const ISAM2::sharedClique& root : roots)
       lastBacksubVariableCount += optimizeWildfireNonRecursive(
-          root, wildfireThreshold, replacedKeys, delta);  // modifies delta
+          root, wildfireThreshold, replacedKeys, delta, changedKeys,
+          zones);  // modifies delta
 
 #if !defined(NDEBUG) && defined(GTSAM_EXTRA_CONSISTENCY_CHECKS)
     for (VectorValues::const_iterator key_delta = delta->begin();
@@ -39,6 +39,7 @@ using namespace boost::adaptors;
 #include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -82,12 +83,20 @@ struct GTSAM_EXPORT DeltaImpl {
   };
 
   /**
-   * Update the Newton's method step point, using wildfire
+   * Update the Newton's method step point, using wildfire.  If changedKeys is
+   * given, the keys whose delta entries were modified are inserted into it
+   * (all keys when a full recalculation was performed).  If zones is given,
+   * the wildfire stopping test uses the per-key-range thresholds it holds
+   * instead of the uniform wildfireThreshold (see WildfireThresholds); zones
+   * are ignored on the full-recalculation path taken when wildfireThreshold
+   * is zero or less.
    */
   static size_t UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
                                        const KeySet& replacedKeys,
                                        double wildfireThreshold,
-                                       VectorValues* delta);
+                                       VectorValues* delta,
+                                       KeySet* changedKeys = 0,
+                                       const WildfireThresholds* zones = 0);
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -371,18 +380,114 @@ struct GTSAM_EXPORT UpdateImpl {
     return relinKeys;
   }
 
-  // Mark keys in \Delta above threshold \beta:
+  /**
+   * Incremental version of CheckRelinearizationFull: only the variables in
+   * changedKeys - those whose delta entries changed since the previous check
+   * - are re-tested against the threshold, inserting them into or erasing
+   * them from the persistent candidate set.  The candidate set then holds
+   * exactly the variables at or above the threshold, at O(changed) cost per
+   * update instead of a scan over the whole delta vector.
+   */
+  static void UpdateRelinearizationCandidates(
+      const VectorValues& delta, const KeySet& changedKeys,
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold,
+      KeySet* candidates) {
+    for (Key key : changedKeys) {
+      if (!delta.exists(key)) {
+        candidates->erase(key);  // variable no longer exists
+        continue;
+      }
+      const Vector& deltaVar = delta[key];
+      bool above = false;
+      if (const double* threshold = boost::get<double>(&relinearizeThreshold)) {
+        above = deltaVar.lpNorm<Eigen::Infinity>() >= *threshold;
+      } else if (const FastMap<char, Vector>* thresholds =
+                     boost::get<FastMap<char, Vector> >(&relinearizeThreshold)) {
+        const Vector& threshold =
+            thresholds->find(Symbol(key).chr())->second;
+        if (threshold.rows() != deltaVar.rows())
+          throw std::invalid_argument(
+              "Relinearization threshold vector dimensionality for '" +
+              std::string(1, Symbol(key).chr()) +
+              "' passed into iSAM2 parameters does not match actual variable "
+              "dimensionality.");
+        above = (deltaVar.array().abs() > threshold.array()).any();
+      }
+      if (above)
+        candidates->insert(key);
+      else
+        candidates->erase(key);
+    }
+  }
+
+  /**
+   * Limit the relinearization set to the per-update cost budget
+   * (params_.relinearizeBudget), keeping the keys with the largest deltas.
+   * The cost of a key is modeled as the squared total dimension of its
+   * clique, a proxy for the re-elimination work its relinearization
+   * triggers. Deferred keys are simply left out of the returned set: their
+   * deltas stay above threshold, so they remain candidates and are
+   * reconsidered - with one update's worth of extra delta priority - on
+   * the next call.
+   */
+  KeySet limitRelinearizeKeys(const ISAM2::Nodes& nodes,
+                              const VectorValues& delta,
+                              const KeySet& relinKeys) const {
+    const double budget = params_.relinearizeBudget;
+    if (budget <= 0.0 || relinKeys.empty()) return relinKeys;
+
+    // Queue candidates by delta magnitude, largest first
+    typedef std::pair<double, Key> Entry;
+    std::vector<Entry> queue;
+    queue.reserve(relinKeys.size());
+    for (Key key : relinKeys)
+      queue.push_back(Entry(delta[key].lpNorm<Eigen::Infinity>(), key));
+    std::sort(queue.begin(), queue.end(), std::greater<Entry>());
+
+    KeySet selected;
+    double spent = 0.0;
+    for (const Entry& entry : queue) {
+      const Key key = entry.second;
+      // Estimate cost from the dimensions of the containing clique
+      double cost = delta[key].size();
+      ISAM2::Nodes::const_iterator node = nodes.find(key);
+      if (node != nodes.end()) {
+        double dim = 0.0;
+        for (Key var : *node->second->conditional()) dim += delta[var].size();
+        cost = dim * dim;
+      }
+      // Always take at least one key so deferral cannot stall convergence;
+      // skip (rather than stop at) keys that do not fit, so cheaper cliques
+      // further down the queue can still use the remaining budget
+      if (!selected.empty() && spent + cost > budget) continue;
+      selected.insert(key);
+      spent += cost;
+    }
+    return selected;
+  }
+
+  // Mark keys in \Delta above threshold \beta.  changedKeys and candidates
+  // carry ISAM2's incremental relinearization-check state; changedKeys is
+  // consumed (cleared) by this call.
   KeySet gatherRelinearizeKeys(const ISAM2::Roots& roots,
+                               const ISAM2::Nodes& nodes,
                                const VectorValues& delta,
                                const KeySet& fixedVariables,
+                               KeySet* changedKeys, KeySet* candidates,
                                KeySet* markedKeys) const {
     gttic(gatherRelinearizeKeys);
     // J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
-    KeySet relinKeys =
-        params_.enablePartialRelinearizationCheck
-            ? CheckRelinearizationPartial(roots, delta,
-                                          params_.relinearizeThreshold)
-            : CheckRelinearizationFull(delta, params_.relinearizeThreshold);
+    KeySet relinKeys;
+    if (params_.enablePartialRelinearizationCheck) {
+      relinKeys =
+          CheckRelinearizationPartial(roots, delta, params_.relinearizeThreshold);
+    } else {
+      // Re-test only the variables whose delta changed since the last check
+      UpdateRelinearizationCandidates(delta, *changedKeys,
+                                      params_.relinearizeThreshold, candidates);
+      relinKeys = *candidates;
+    }
+    changedKeys->clear();
     if (updateParams_.forceFullSolve)
       relinKeys = CheckRelinearizationFull(delta, 0.0);  // for debugging
 
@@ -396,6 +501,9 @@ struct GTSAM_EXPORT UpdateImpl {
       }
     }
 
+    // Under a relinearization budget, defer the lowest-priority keys
+    relinKeys = limitRelinearizeKeys(nodes, delta, relinKeys);
+
     // Add the variables being relinearized to the marked keys
     markedKeys->insert(relinKeys.begin(), relinKeys.end());
     return relinKeys;
@@ -25,8 +25,21 @@
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/weak_ptr.hpp>
+
 #include <algorithm>
+#include <fstream>
 #include <map>
+#include <set>
 #include <utility>
 
 using namespace std;
@@ -37,14 +50,18 @@ namespace gtsam {
 template class BayesTree<ISAM2Clique>;
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : deltaGeneration_(0), cacheRecomputeCount_(0), params_(params),
+      update_count_(0), rebalancing_(false), checkpointJournalEnabled_(false) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2()
+    : deltaGeneration_(0), cacheRecomputeCount_(0), update_count_(0),
+      rebalancing_(false), checkpointJournalEnabled_(false) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -86,9 +103,14 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
         useCachedLinear = false;
     }
     if (inside) {
+      if (useCachedLinear && !linearFactors_[idx]) {
+        // The cached linearization was evicted for coldness (see
+        // ISAM2Params::cacheEvictionAge); recompute it on demand below
+        useCachedLinear = false;
+        ++cacheRecomputeCount_;
+      }
       if (useCachedLinear) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
-        assert(linearFactors_[idx]);
         assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
 #endif
         linearized.push_back(linearFactors_[idx]);
@@ -97,11 +119,14 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
         linearized.push_back(linearFactor);
         if (params_.cacheLinearizedFactors) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
-          assert(linearFactors_[idx]->keys() == linearFactor->keys());
+          assert(!linearFactors_[idx] ||
+                 linearFactors_[idx]->keys() == linearFactor->keys());
 #endif
           linearFactors_[idx] = linearFactor;
         }
       }
+      if (params_.cacheLinearizedFactors && params_.cacheEvictionAge > 0)
+        touchLinearFactor(idx);
     }
   }
   gttoc(check_candidates_and_linearize);
@@ -210,7 +235,12 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
 
   gttic(linearize);
   auto linearized = nonlinearFactors_.linearize(theta_);
-  if (params_.cacheLinearizedFactors) linearFactors_ = *linearized;
+  if (params_.cacheLinearizedFactors) {
+    linearFactors_ = *linearized;
+    // The whole cache was just rebuilt, so every slot is fresh again
+    if (params_.cacheEvictionAge > 0)
+      linearFactorLastUsed_.assign(linearFactors_.size(), update_count_);
+  }
   gttoc(linearize);
 
   gttic(eliminate);
@@ -226,7 +256,7 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   roots_.insert(roots_.end(), bayesTree->roots().begin(),
                 bayesTree->roots().end());
   nodes_.clear();
-  nodes_.insert(bayesTree->nodes().begin(), bayesTree->nodes().end());
+  nodes_.bulkInsert(bayesTree->nodes().begin(), bayesTree->nodes().end());
   gttoc(insert);
 
   result->variablesReeliminated = affectedKeysSet->size();
@@ -350,7 +380,7 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
   gttic(reassemble);
   roots_.insert(roots_.end(), bayesTree->roots().begin(),
                 bayesTree->roots().end());
-  nodes_.insert(bayesTree->nodes().begin(), bayesTree->nodes().end());
+  nodes_.bulkInsert(bayesTree->nodes().begin(), bayesTree->nodes().end());
   gttoc(reassemble);
 
   // 4. The orphans have already been inserted during elimination
@@ -363,10 +393,13 @@ void ISAM2::addVariables(const Values& newTheta,
 
   theta_.insert(newTheta);
   if (ISDEBUG("ISAM2 AddVariables")) newTheta.print("The new variables are: ");
+  // Assign dense ids to the new variables
+  for (Key key : newTheta.keys()) denseKeyMap_.insert(key);
   // Add zeros into the VectorValues
   delta_.insert(newTheta.zeroVectors());
   deltaNewton_.insert(newTheta.zeroVectors());
   RgProd_.insert(newTheta.zeroVectors());
+  ++deltaGeneration_;
 
   // New keys for detailed results
   if (detail && params_.enableDetailedResults) {
@@ -386,10 +419,60 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     deltaNewton_.erase(key);
     RgProd_.erase(key);
     deltaReplacedMask_.erase(key);
+    deltaChangedSinceRelinCheck_.erase(key);
+    relinCandidates_.erase(key);
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
     fixedVariables_.erase(key);
+    denseKeyMap_.erase(key);
   }
+  ++deltaGeneration_;
+}
+
+/* ************************************************************************* */
+bool ISAM2::tryDirectAppend(const NonlinearFactorGraph& newFactors,
+                            const Values& newTheta,
+                            const ISAM2UpdateParams& updateParams,
+                            const KeySet& relinKeys, ISAM2Result* result) {
+  // Only the plain add-factors shape qualifies; anything touching existing
+  // structure goes through the general machinery
+  if (newFactors.empty() || roots_.empty() ||
+      !updateParams.removeFactorIndices.empty() ||
+      updateParams.constrainedKeys || updateParams.extraReelimKeys ||
+      !relinKeys.empty() || !result->keysWithRemovedFactors.empty() ||
+      !result->unusedKeys.empty() || params_.enableDetailedResults)
+    return false;
+
+  // Every key of every new factor must be brand new this update
+  for (const auto& factor : newFactors) {
+    if (!factor) return false;
+    for (Key key : *factor)
+      if (!newTheta.exists(key)) return false;
+  }
+
+  gttic(directAppend);
+  // The new variables are disconnected from every existing clique, so
+  // eliminating just the new linear factors yields a conditional with an
+  // empty separator that can be appended as an additional root, leaving the
+  // rest of the tree untouched
+  GaussianFactorGraph factors;
+  for (FactorIndex index : result->newFactorsIndices)
+    factors.push_back(linearFactors_[index]);
+
+  KeySet newKeys;
+  for (const auto& factor : factors)
+    newKeys.insert(factor->begin(), factor->end());
+  const Ordering order(newKeys.begin(), newKeys.end());
+
+  auto clique = boost::make_shared<ISAM2Clique>();
+  clique->setEliminationResult(params_.getEliminationFunction()(factors, order));
+  roots_.push_back(clique);
+  for (Key key : newKeys) nodes_.insert(std::make_pair(key, clique));
+
+  result->variablesReeliminated = newKeys.size();
+  result->factorsRecalculated = newFactors.size();
+  deltaReplacedMask_.insert(newKeys.begin(), newKeys.end());
+  return true;
 }
 
 /* ************************************************************************* */
@@ -416,6 +499,10 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
                           const ISAM2UpdateParams& updateParams) {
   gttic(ISAM2_update);
   this->update_count_ += 1;
+  if (checkpointJournalEnabled_) {
+    journalFactors_.push_back(newFactors);
+    journalValues_.insert(newTheta);
+  }
   UpdateImpl::LogStartingUpdate(newFactors, *this);
   ISAM2Result result(params_.enableDetailedResults);
   UpdateImpl update(params_, updateParams);
@@ -446,8 +533,9 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   result.variablesRelinearized = 0;
   if (update.relinarizationNeeded(update_count_)) {
     // 4. Mark keys in \Delta above threshold \beta:
-    relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
-                                             &result.markedKeys);
+    relinKeys = update.gatherRelinearizeKeys(
+        roots_, nodes_, delta_, fixedVariables_, &deltaChangedSinceRelinCheck_,
+        &relinCandidates_, &result.markedKeys);
     update.recordRelinearizeDetail(relinKeys, result.details());
     if (!relinKeys.empty()) {
       // 5. Mark cliques that involve marked variables \Theta_{J} and ancestors.
@@ -455,6 +543,7 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       // 6. Update linearization point for marked variables:
       // \Theta_{J}:=\Theta_{J}+\Delta_{J}.
       UpdateImpl::ExpmapMasked(delta_, relinKeys, &theta_);
+      ++deltaGeneration_;  // theta_ changed for the relinearized variables
     }
     result.variablesRelinearized = result.markedKeys.size();
   }
@@ -462,19 +551,311 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   // 7. Linearize new factors
   update.linearizeNewFactors(newFactors, theta_, nonlinearFactors_.size(),
                              result.newFactorsIndices, &linearFactors_);
+  if (params_.cacheLinearizedFactors && params_.cacheEvictionAge > 0)
+    for (const FactorIndex idx : result.newFactorsIndices)
+      touchLinearFactor(idx);
   update.augmentVariableIndex(newFactors, result.newFactorsIndices,
                               &variableIndex_);
 
-  // 8. Redo top of Bayes tree and update data structures
-  recalculate(updateParams, relinKeys, &result);
+  // 8. Redo top of Bayes tree and update data structures.  Factor sets over
+  // brand-new variables only can be appended directly, see tryDirectAppend.
+  if (!tryDirectAppend(newFactors, newTheta, updateParams, relinKeys, &result))
+    recalculate(updateParams, relinKeys, &result);
   if (!result.unusedKeys.empty()) removeVariables(result.unusedKeys);
   result.cliques = this->nodes().size();
 
+  // Fill the per-update change journal, see ISAM2Result::ChangeJournal
+  if (params_.enableChangeJournal) {
+    result.journal = ISAM2Result::ChangeJournal();
+    ISAM2Result::ChangeJournal& journal = *result.journal;
+    journal.newKeys.reserve(newTheta.size());
+    for (const auto& key_value : newTheta)
+      journal.newKeys.push_back(key_value.key);
+    journal.removedKeys.assign(result.unusedKeys.begin(),
+                               result.unusedKeys.end());
+    journal.relinearizedKeys.assign(relinKeys.begin(), relinKeys.end());
+
+    // Compare the refreshed delta against the previous one for the affected
+    // variables only, so the journal stays O(changes).  The mask is cleared
+    // by the refresh, hence the snapshot; removeVariables above already
+    // erased the removed keys from it.
+    const KeyVector candidates(deltaReplacedMask_.begin(),
+                               deltaReplacedMask_.end());
+    FastMap<Key, Vector> previousDeltas;
+    for (Key key : candidates) {
+      VectorValues::const_iterator it = delta_.find(key);
+      if (it != delta_.end()) previousDeltas.insert({key, it->second});
+    }
+    const VectorValues& delta = getDelta();  // refreshes eagerly
+    for (Key key : candidates) {
+      VectorValues::const_iterator it = delta.find(key);
+      if (it == delta.end()) continue;
+      const auto previous = previousDeltas.find(key);
+      const double change =
+          (previous == previousDeltas.end())
+              ? it->second.lpNorm<Eigen::Infinity>()
+              : (it->second - previous->second).lpNorm<Eigen::Infinity>();
+      if (change > params_.changeJournalDeltaEpsilon)
+        journal.deltaChangedKeys.push_back(key);
+    }
+  }
+
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
+
+  // Tune the per-type relinearization thresholds from what this update's
+  // relinearizations actually bought, see adaptRelinearizeThresholds
+  if (params_.adaptiveRelinearizationTarget > 0.0)
+    adaptRelinearizeThresholds(result, relinKeys);
+
+  // Opportunistic tree rebalancing, amortized over updates: only runs when
+  // the depth bound is actually exceeded.  The guard keeps the factor-less
+  // update issued by rebalance() from re-triggering itself.
+  if (params_.rebalanceDepthBound > 0 && !rebalancing_) {
+    rebalancing_ = true;
+    rebalance(params_.rebalanceDepthBound);
+    rebalancing_ = false;
+  }
+
+  // Drop cached linearizations that have gone cold, so the resident cache
+  // only covers the recently active part of the graph
+  if (params_.cacheLinearizedFactors && params_.cacheEvictionAge > 0)
+    evictColdLinearFactors();
+
   return result;
 }
 
+/* ************************************************************************* */
+void ISAM2::setRelinearizeThreshold(
+    const ISAM2Params::RelinearizationThreshold& threshold) {
+  params_.relinearizeThreshold = threshold;
+  // The new thresholds become the accuracy contract adaptation works against
+  baseRelinearizeThresholds_.clear();
+  if (const ISAM2ThresholdMap* thresholds =
+          boost::get<ISAM2ThresholdMap>(&params_.relinearizeThreshold))
+    baseRelinearizeThresholds_ = *thresholds;
+  relinearizeThresholdsChanged();
+}
+
+/* ************************************************************************* */
+void ISAM2::setRelinearizeThreshold(unsigned char c, const Vector& threshold) {
+  ISAM2ThresholdMap* thresholds =
+      boost::get<ISAM2ThresholdMap>(&params_.relinearizeThreshold);
+  if (!thresholds)
+    throw std::invalid_argument(
+        "ISAM2::setRelinearizeThreshold: updating a single variable type "
+        "requires relinearizeThreshold to already hold a per-type map");
+  (*thresholds)[c] = threshold;
+  if (!baseRelinearizeThresholds_.empty()) baseRelinearizeThresholds_[c] = threshold;
+  relinearizeThresholdsChanged();
+}
+
+/* ************************************************************************* */
+void ISAM2::relinearizeThresholdsChanged() {
+  for (const VectorValues::KeyValuePair& key_delta : delta_)
+    deltaChangedSinceRelinCheck_.insert(key_delta.first);
+}
+
+/* ************************************************************************* */
+void ISAM2::adaptRelinearizeThresholds(const ISAM2Result& result,
+                                       const KeySet& relinKeys) {
+  if (relinKeys.empty() || !result.errorBefore || !result.errorAfter) return;
+  ISAM2ThresholdMap* thresholds =
+      boost::get<ISAM2ThresholdMap>(&params_.relinearizeThreshold);
+  if (!thresholds) return;  // adaptation needs per-type thresholds
+  if (baseRelinearizeThresholds_.empty())
+    baseRelinearizeThresholds_ = *thresholds;
+
+  // Relative error reduction, attributed equally to the relinearized
+  // variables.  The nonlinear error can grow within an update (the linear
+  // step overshoots), clamp at zero rather than reward that.
+  const double reduction = std::max(*result.errorBefore - *result.errorAfter, 0.0);
+  const double perVariable = reduction /
+      (std::max(*result.errorBefore, 1e-12) * static_cast<double>(relinKeys.size()));
+
+  std::set<unsigned char> involvedTypes;
+  for (Key key : relinKeys) involvedTypes.insert(Symbol(key).chr());
+
+  // Multiplicative increase/decrease with a dead band around the target, so
+  // the thresholds settle instead of oscillating every update
+  double factor = 1.0;
+  if (perVariable < 0.5 * params_.adaptiveRelinearizationTarget)
+    factor = 1.1;
+  else if (perVariable > 2.0 * params_.adaptiveRelinearizationTarget)
+    factor = 0.9;
+  if (factor == 1.0) return;
+
+  bool changed = false;
+  for (const unsigned char c : involvedTypes) {
+    ISAM2ThresholdMap::iterator entry = thresholds->find(c);
+    ISAM2ThresholdMap::const_iterator base = baseRelinearizeThresholds_.find(c);
+    if (entry == thresholds->end() || base == baseRelinearizeThresholds_.end())
+      continue;
+    // The configured threshold is a floor (the accuracy contract), 10x it a cap
+    const Vector scaled = (entry->second * factor)
+        .cwiseMax(base->second).cwiseMin(10.0 * base->second);
+    if (!scaled.isApprox(entry->second)) {
+      entry->second = scaled;
+      changed = true;
+    }
+  }
+  // A tightened threshold may admit deltas dismissed under the looser one;
+  // a loosened one leaves stale candidates.  Either way, re-test.
+  if (changed) relinearizeThresholdsChanged();
+}
+
+/* ************************************************************************* */
+void ISAM2::touchLinearFactor(FactorIndex idx) {
+  if (linearFactorLastUsed_.size() <= idx)
+    linearFactorLastUsed_.resize(idx + 1, update_count_);
+  linearFactorLastUsed_[idx] = update_count_;
+}
+
+/* ************************************************************************* */
+void ISAM2::evictColdLinearFactors() {
+  // Slots that predate the policy being switched on count as fresh now
+  linearFactorLastUsed_.resize(linearFactors_.size(), update_count_);
+  const int horizon = update_count_ - static_cast<int>(params_.cacheEvictionAge);
+  for (size_t idx = 0; idx < linearFactors_.size(); ++idx) {
+    if (linearFactors_[idx] && linearFactorLastUsed_[idx] < horizon)
+      linearFactors_[idx].reset();
+  }
+}
+
+/* ************************************************************************* */
+size_t ISAM2::treeDepth() const {
+  size_t maxDepth = 0;
+  FastVector<std::pair<sharedClique, size_t> > stack;
+  for (const sharedClique& root : roots_)
+    stack.push_back(std::make_pair(root, 1));
+  while (!stack.empty()) {
+    const sharedClique clique = stack.back().first;
+    const size_t depth = stack.back().second;
+    stack.pop_back();
+    maxDepth = std::max(maxDepth, depth);
+    for (const sharedClique& child : clique->children)
+      stack.push_back(std::make_pair(child, depth + 1));
+  }
+  return maxDepth;
+}
+
+/* ************************************************************************* */
+bool ISAM2::rebalance(size_t maxDepth) {
+  if (maxDepth == 0) return false;
+
+  // Collect the frontal variables of every clique deeper than maxDepth
+  FastList<Key> deepKeys;
+  FastVector<std::pair<sharedClique, size_t> > stack;
+  for (const sharedClique& root : roots_)
+    stack.push_back(std::make_pair(root, 1));
+  while (!stack.empty()) {
+    const sharedClique clique = stack.back().first;
+    const size_t depth = stack.back().second;
+    stack.pop_back();
+    if (depth > maxDepth)
+      for (Key key : clique->conditional()->frontals()) deepKeys.push_back(key);
+    for (const sharedClique& child : clique->children)
+      stack.push_back(std::make_pair(child, depth + 1));
+  }
+  if (deepKeys.empty()) return false;
+
+  // Re-eliminate the deep region through a factor-less update: removeTop
+  // pulls out the offending cliques together with their paths to the root,
+  // and the fresh constrained COLAMD ordering computed during recalculation
+  // rebuilds them, typically much shallower
+  ISAM2UpdateParams rebalanceParams;
+  rebalanceParams.extraReelimKeys = deepKeys;
+  update(NonlinearFactorGraph(), Values(), rebalanceParams);
+  return true;
+}
+
+/* ************************************************************************* */
+void ISAM2::enableCheckpointJournal(bool enable) {
+  checkpointJournalEnabled_ = enable;
+  if (!enable) {
+    journalFactors_ = NonlinearFactorGraph();
+    journalValues_.clear();
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::saveCheckpoint(const std::string& filename) {
+  // Clear the journal first so delta checkpoints written later are relative
+  // to the state being saved
+  journalFactors_ = NonlinearFactorGraph();
+  journalValues_.clear();
+
+  std::ofstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    throw std::invalid_argument(
+        "ISAM2::saveCheckpoint: Could not open " + filename);
+  boost::archive::binary_oarchive archive(file);
+  archive << *this;
+}
+
+/* ************************************************************************* */
+void ISAM2::saveDeltaCheckpoint(const std::string& filename) {
+  if (!checkpointJournalEnabled_)
+    throw std::runtime_error(
+        "ISAM2::saveDeltaCheckpoint: call enableCheckpointJournal() before "
+        "the updates the delta checkpoint should cover");
+
+  std::ofstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    throw std::invalid_argument(
+        "ISAM2::saveDeltaCheckpoint: Could not open " + filename);
+  boost::archive::binary_oarchive archive(file);
+  archive << journalFactors_;
+  archive << journalValues_;
+
+  journalFactors_ = NonlinearFactorGraph();
+  journalValues_.clear();
+}
+
+/* ************************************************************************* */
+void ISAM2::restoreCheckpoint(const std::string& filename) {
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    throw std::invalid_argument(
+        "ISAM2::restoreCheckpoint: Could not open " + filename);
+  boost::archive::binary_iarchive archive(file);
+  archive >> *this;
+
+  // The checkpoint starts a fresh journal and a fresh estimate cache
+  journalFactors_ = NonlinearFactorGraph();
+  journalValues_.clear();
+  rebalancing_ = false;
+  ++deltaGeneration_;
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2::restoreDeltaCheckpoint(const std::string& filename) {
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    throw std::invalid_argument(
+        "ISAM2::restoreDeltaCheckpoint: Could not open " + filename);
+  NonlinearFactorGraph factors;
+  Values values;
+  boost::archive::binary_iarchive archive(file);
+  archive >> factors;
+  archive >> values;
+
+  // Replay the recorded updates as a single batched update
+  return update(factors, values);
+}
+
+/* ************************************************************************* */
+void ISAM2::marginalizeLeaves(
+    Key first, Key last,
+    boost::optional<FactorIndices&> marginalFactorsIndices,
+    boost::optional<FactorIndices&> deletedFactorsIndices) {
+  // Collect the keys in [first, last] with an interval query on the sorted
+  // linearization point, then defer to the list version
+  const KeyVector rangeKeys = theta_.keysInRange(first, last);
+  const FastList<Key> leafKeys(rangeKeys.begin(), rangeKeys.end());
+  marginalizeLeaves(leafKeys, marginalFactorsIndices, deletedFactorsIndices);
+}
+
 /* ************************************************************************* */
 void ISAM2::marginalizeLeaves(
     const FastList<Key>& leafKeysList,
@@ -494,10 +875,42 @@ void ISAM2::marginalizeLeaves(
   // Keep track of factors that get summarized by removing cliques
   FactorIndexSet factorIndicesToRemove;
 
-  // Remove the subtree and throw away the cliques
-  auto trackingRemoveSubtree = [&](const sharedClique& subtreeRoot) {
-    const Cliques removedCliques = this->removeSubtree(subtreeRoot);
-    for (const sharedClique& removedClique : removedCliques) {
+  // The loop below is an analysis pass: instead of removing each subtree and
+  // re-eliminating each straddling clique as it is encountered, it only
+  // decides what has to happen.  Whole subtrees are scheduled for removal,
+  // and every clique that keeps some of its frontals becomes an independent
+  // marginalization task.  The expensive work - linearizing the pulled-in
+  // factors and re-eliminating - then runs for all tasks in one batch (in
+  // parallel with TBB), and the tree surgery and the factor-graph/variable-
+  // index compaction are each applied once at the end.
+  Cliques subtreeRootsToRemove;
+  set<const ISAM2Clique*> cliquesToRemove;
+
+  // An independent task for one clique that keeps some of its frontal
+  // variables: re-eliminate the child marginals plus the factors involving
+  // the marginalized frontals, keeping only the marginal on the rest.
+  struct MarginalizationTask {
+    GaussianFactorGraph graph;         ///< child marginals, collected up front
+    FactorIndices factorsToLinearize;  ///< factors pulled into the clique
+    Ordering frontalsToEliminate;      ///< the marginalized frontals
+    Key anchor;                        ///< clique front the marginal attaches to
+    GaussianFactor::shared_ptr marginal;  ///< filled in by the batch below
+  };
+  vector<MarginalizationTask> tasks;
+
+  // Schedule a subtree for removal and do the associated bookkeeping; the
+  // actual tree surgery is deferred to a single batch after the analysis.
+  auto scheduleRemoveSubtree = [&](const sharedClique& subtreeRoot) {
+    Cliques scheduled;
+    if (!cliquesToRemove.insert(subtreeRoot.get()).second)
+      return scheduled;  // Already covered by an earlier subtree
+    scheduled.push_back(subtreeRoot);
+    for (Cliques::iterator clique = scheduled.begin();
+         clique != scheduled.end(); ++clique)
+      for (const sharedClique& child : (*clique)->children)
+        if (cliquesToRemove.insert(child.get()).second)
+          scheduled.push_back(child);
+    for (const sharedClique& removedClique : scheduled) {
       auto cg = removedClique->conditional();
       marginalFactors.erase(cg->front());
       leafKeysRemoved.insert(cg->beginFrontals(), cg->endFrontals());
@@ -515,10 +928,11 @@ void ISAM2::marginalizeLeaves(
 #endif
       }
     }
-    return removedCliques;
+    subtreeRootsToRemove.push_back(subtreeRoot);
+    return scheduled;
   };
 
-  // Remove each variable and its subtrees
+  // Analyze each variable and its subtrees
   for (Key j : leafKeys) {
     if (!leafKeysRemoved.exists(j)) {  // If the index was not already removed
                                        // by removing another subtree
@@ -555,9 +969,9 @@ void ISAM2::marginalizeLeaves(
         // parent of this clique.
         marginalFactors[clique->parent()->conditional()->front()].push_back(
             marginalFactor);
-        // Now remove this clique and its subtree - all of its marginal
-        // information has been stored in marginalFactors.
-        trackingRemoveSubtree(clique);
+        // Now schedule this clique and its subtree for removal - all of its
+        // marginal information has been stored in marginalFactors.
+        scheduleRemoveSubtree(clique);
       } else {
         // Reeliminate the current clique and the marginals from its children,
         // then keep only the marginal on the non-marginalized variables.  We
@@ -565,28 +979,30 @@ void ISAM2::marginalizeLeaves(
         // the marginals from the marginalFactors multimap, which come from any
         // subtrees already marginalized out.
 
-        // Add child marginals and remove marginalized subtrees
-        GaussianFactorGraph graph;
-        KeySet factorsInSubtreeRoot;
+        MarginalizationTask task;
+
+        // Add child marginals and schedule marginalized subtrees for removal
         Cliques subtreesToRemove;
         for (const sharedClique& child : clique->children) {
+          // Skip children whose subtree is already scheduled for removal
+          if (cliquesToRemove.count(child.get())) continue;
           // Remove subtree if child depends on any marginalized keys
           for (Key parent : child->conditional()->parents()) {
             if (leafKeys.exists(parent)) {
               subtreesToRemove.push_back(child);
-              graph.push_back(child->cachedFactor());  // Add child marginal
+              task.graph.push_back(child->cachedFactor());  // Add child marginal
               break;
             }
           }
         }
         Cliques childrenRemoved;
         for (const sharedClique& subtree : subtreesToRemove) {
-          const Cliques removed = trackingRemoveSubtree(subtree);
-          childrenRemoved.insert(childrenRemoved.end(), removed.begin(),
-                                 removed.end());
+          const Cliques scheduled = scheduleRemoveSubtree(subtree);
+          childrenRemoved.insert(childrenRemoved.end(), scheduled.begin(),
+                                 scheduled.end());
         }
 
-        // Add the factors that are pulled into the current clique by the
+        // Gather the factors that are pulled into the current clique by the
         // marginalized variables. These are the factors that involve
         // *marginalized* frontal variables in this clique but do not involve
         // frontal variables of any of its children.
@@ -605,25 +1021,22 @@ void ISAM2::marginalizeLeaves(
             }
           }
         }
-        // Create factor graph from factor indices
-        for (const auto index : factorsFromMarginalizedInClique_step1) {
-          graph.push_back(nonlinearFactors_[index]->linearize(theta_));
-        }
+        // The factors are linearized in the batch below, not here
+        task.factorsToLinearize.assign(
+            factorsFromMarginalizedInClique_step1.begin(),
+            factorsFromMarginalizedInClique_step1.end());
 
-        // Reeliminate the linear graph to get the marginal and discard the
-        // conditional
+        // Record the frontals to eliminate and where the resulting marginal
+        // should attach; the re-elimination itself happens in the batch below
         auto cg = clique->conditional();
         const KeySet cliqueFrontals(cg->beginFrontals(), cg->endFrontals());
         KeyVector cliqueFrontalsToEliminate;
         std::set_intersection(cliqueFrontals.begin(), cliqueFrontals.end(),
                               leafKeys.begin(), leafKeys.end(),
                               std::back_inserter(cliqueFrontalsToEliminate));
-        auto eliminationResult1 = params_.getEliminationFunction()(
-            graph, Ordering(cliqueFrontalsToEliminate));
-
-        // Add the resulting marginal
-        if (eliminationResult1.second)
-          marginalFactors[cg->front()].push_back(eliminationResult1.second);
+        task.frontalsToEliminate = Ordering(cliqueFrontalsToEliminate);
+        task.anchor = cg->front();
+        tasks.push_back(std::move(task));
 
         // Split the current clique
         // Find the position of the last leaf key in this clique
@@ -655,6 +1068,33 @@ void ISAM2::marginalizeLeaves(
     }
   }
 
+  // Form all the marginals in one batch.  Every task re-eliminates its own
+  // local graph, so the tasks are independent and run in parallel with TBB.
+  auto runTask = [&](MarginalizationTask& task) {
+    for (const FactorIndex index : task.factorsToLinearize)
+      task.graph.push_back(nonlinearFactors_[index]->linearize(theta_));
+    auto eliminationResult =
+        params_.getEliminationFunction()(task.graph, task.frontalsToEliminate);
+    task.marginal = eliminationResult.second;
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, tasks.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        runTask(tasks[i]);
+                    });
+#else
+  for (MarginalizationTask& task : tasks) runTask(task);
+#endif
+  for (const MarginalizationTask& task : tasks) {
+    if (task.marginal) marginalFactors[task.anchor].push_back(task.marginal);
+  }
+
+  // Apply the deferred tree surgery in one pass.  The scheduled roots are
+  // disjoint subtrees, so the removal order does not matter.
+  for (const sharedClique& subtreeRoot : subtreeRootsToRemove)
+    this->removeSubtree(subtreeRoot);
+
   // At this point we have updated the BayesTree, now update the remaining iSAM2
   // data structures
 
@@ -696,10 +1136,24 @@ void ISAM2::marginalizeLeaves(
   removeVariables(KeySet(leafKeys.begin(), leafKeys.end()));
 }
 
+/* ************************************************************************* */
+void ISAM2::registerAccuracyZone(Key first, Key last, double threshold) {
+  accuracyZones_.addZone(first, last, threshold);
+  // Deltas previously accepted at a looser tolerance may be stale under the
+  // new one; mark the zone's existing variables for re-solution
+  for (Key key : theta_.keysInRange(first, last)) deltaReplacedMask_.insert(key);
+}
+
+/* ************************************************************************* */
+void ISAM2::clearAccuracyZones() { accuracyZones_.clearZones(); }
+
 /* ************************************************************************* */
 // Marked const but actually changes mutable delta
 void ISAM2::updateDelta(bool forceFullSolve) const {
   gttic(updateDelta);
+  // A forced full solve ignores thresholds, including zone overrides
+  const WildfireThresholds* zones =
+      (forceFullSolve || accuracyZones_.empty()) ? nullptr : &accuracyZones_;
   if (params_.optimizationParams.type() == typeid(ISAM2GaussNewtonParams)) {
     // If using Gauss-Newton, update with wildfireThreshold
     const ISAM2GaussNewtonParams& gaussNewtonParams =
@@ -708,7 +1162,8 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
         forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
     DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
-                                      effectiveWildfireThreshold, &delta_);
+                                      effectiveWildfireThreshold, &delta_,
+                                      &deltaChangedSinceRelinCheck_, zones);
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
 
@@ -724,8 +1179,9 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
 
     // Compute Newton's method step
     gttic(Wildfire_update);
-    DeltaImpl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_);
+    DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
+                                      effectiveWildfireThreshold, &deltaNewton_,
+                                      nullptr, zones);
     gttoc(Wildfire_update);
 
     // Compute steepest descent step
@@ -753,10 +1209,16 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     delta_ =
         doglegResult
             .dx_d;  // Copy the VectorValues containing with the linear solution
+    // The dogleg point blends the whole vector, so every delta entry changed
+    for (const VectorValues::KeyValuePair& key_delta : delta_)
+      deltaChangedSinceRelinCheck_.insert(key_delta.first);
     gttoc(Copy_dx_d);
   } else {
     throw std::runtime_error("iSAM2: unknown ISAM2Params type");
   }
+
+  // The estimate may have changed - invalidate any EstimateView caches
+  ++deltaGeneration_;
 }
 
 /* ************************************************************************* */
@@ -774,6 +1236,35 @@ const Value& ISAM2::calculateEstimate(Key key) const {
   return *theta_.at(key).retract_(delta);
 }
 
+/* ************************************************************************* */
+Values ISAM2::calculateEstimates(const KeyVector& keys) const {
+  gttic(ISAM2_calculateEstimates);
+  const VectorValues& delta(getDelta());
+  gttic(Expmap);
+  Values result;
+  for (Key key : keys) {
+    Value* retracted = theta_.at(key).retract_(delta[key]);
+    result.insert(key, *retracted);
+    retracted->deallocate_();
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+const Value& ISAM2::EstimateView::at(Key key) const {
+  const VectorValues& delta = isam_->getDelta();  // may recompute the delta
+  if (generation_ != isam_->deltaGeneration_) {
+    cache_.clear();
+    generation_ = isam_->deltaGeneration_;
+  }
+  if (!cache_.exists(key)) {
+    Value* retracted = isam_->theta_.at(key).retract_(delta[key]);
+    cache_.insert(key, *retracted);
+    retracted->deallocate_();
+  }
+  return cache_.at(key);
+}
+
 /* ************************************************************************* */
 Values ISAM2::calculateBestEstimate() const {
   updateDelta(true);  // Force full solve when updating delta_
@@ -809,4 +1300,60 @@ VectorValues ISAM2::gradientAtZero() const {
   return g;
 }
 
+/* ************************************************************************* */
+namespace {
+void accumulateCachedFactorBytes(const ISAM2::sharedClique& clique,
+                                 BayesTreeMemoryUsage* usage) {
+  if (clique->archived())  // count the compressed image, without restoring
+    usage->cachedFactorBytes += clique->archivedBytes();
+  else if (clique->cachedFactor())
+    usage->cachedFactorBytes += clique->cachedFactor()->memoryUsage();
+  for (const ISAM2::sharedClique& child : clique->children)
+    accumulateCachedFactorBytes(child, usage);
+}
+
+size_t archiveColdCliquesRecursive(const ISAM2::sharedClique& clique,
+                                   const KeySet& warmKeys,
+                                   bool float32Conditionals) {
+  size_t released = 0;
+  bool cold = true;
+  for (Key key : clique->conditional()->frontals()) {
+    if (warmKeys.count(key)) {
+      cold = false;
+      break;
+    }
+  }
+  if (cold) {
+    released += clique->archive();
+    if (float32Conditionals && clique->conditional())
+      released += clique->conditional()->compressStorage();
+  }
+  for (const ISAM2::sharedClique& child : clique->children)
+    released += archiveColdCliquesRecursive(child, warmKeys, float32Conditionals);
+  return released;
+}
+}  // namespace
+
+size_t ISAM2::archiveColdCliques() {
+  size_t released = 0;
+  // Cliques whose frontals still have pending delta changes are about to be
+  // touched again; everything else is considered cold. Archived factors are
+  // restored transparently when accessed, so archiving a clique that later
+  // warms up costs only the decompression.
+  for (const sharedClique& root : this->roots())
+    released += archiveColdCliquesRecursive(root, deltaReplacedMask_,
+                                            params_.float32CliqueStorage);
+  return released;
+}
+
+BayesTreeMemoryUsage ISAM2::memoryUsage() const {
+  BayesTreeMemoryUsage usage = Base::memoryUsage();
+
+  // Also count the cached linearized factors kept by each clique
+  for (const sharedClique& root : this->roots())
+    accumulateCachedFactorBytes(root, &usage);
+
+  return usage;
+}
+
 }  // namespace gtsam
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <gtsam/inference/DenseKeyMap.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
@@ -27,6 +28,10 @@
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <boost/serialization/optional.hpp>
+
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace gtsam {
@@ -76,6 +81,20 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   mutable KeySet deltaReplacedMask_;  // TODO(dellaert): Make sure accessed in
                                       // the right way
 
+  /** Generation counter for the current estimate (theta_ combined with
+   * delta_), incremented whenever either may have changed.  EstimateView
+   * uses it to invalidate its per-key cache without comparing vectors. */
+  mutable std::uint64_t deltaGeneration_;
+
+  /** Keys whose delta_ entries changed since the last relinearization check;
+   * consumed by update() so the check re-tests only these variables against
+   * relinearizeThreshold instead of scanning the whole delta vector. */
+  mutable KeySet deltaChangedSinceRelinCheck_;
+
+  /** Variables currently at or above relinearizeThreshold, maintained
+   * incrementally from deltaChangedSinceRelinCheck_. */
+  KeySet relinCandidates_;
+
   /** All original nonlinear factors are stored here to use during
    * relinearization */
   NonlinearFactorGraph nonlinearFactors_;
@@ -83,9 +102,30 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** The current linear factors, which are only updated as needed */
   mutable GaussianFactorGraph linearFactors_;
 
+  /** Update count of the last time each slot of linearFactors_ was read or
+   * refreshed, indexed like linearFactors_.  Only maintained when
+   * ISAM2Params::cacheEvictionAge is nonzero, and grown lazily so enabling
+   * the policy mid-session is safe. */
+  FastVector<int> linearFactorLastUsed_;
+
+  /** Number of on-demand relinearizations caused by cache eviction, see
+   * cacheRecomputeCount() */
+  size_t cacheRecomputeCount_;
+
   /** The current parameters */
   ISAM2Params params_;
 
+  /** The configured per-type relinearization thresholds, captured when
+   * adaptive tuning first adjusts them or when setRelinearizeThreshold() is
+   * called.  They bound the tuned thresholds from below (and 10x them from
+   * above), see ISAM2Params::adaptiveRelinearizationTarget.  Empty while the
+   * threshold is a scalar or adaptation has never run. */
+  ISAM2ThresholdMap baseRelinearizeThresholds_;
+
+  /** Per-key-range wildfire thresholds, empty by default so all variables
+   * use the uniform threshold from params_, see registerAccuracyZone() */
+  WildfireThresholds accuracyZones_;
+
   /** The current Dogleg Delta (trust region radius) */
   mutable boost::optional<double> doglegDelta_;
 
@@ -93,9 +133,26 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    * variables and thus cannot have their linearization points changed. */
   KeySet fixedVariables_;
 
+  /** Bijection between the keys currently in the system and the dense range
+   * [0,size()), maintained by addVariables()/removeVariables(), see
+   * getDenseKeyMap() */
+  DenseKeyMap denseKeyMap_;
+
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  bool rebalancing_;  ///< Guards against the rebalancing update re-triggering
+                      ///< itself (see ISAM2Params::rebalanceDepthBound)
+
+  /** Whether update() records its inputs for delta checkpoints, see
+   * enableCheckpointJournal() */
+  bool checkpointJournalEnabled_;
+
+  /** Factors and initial values received by update() since the last
+   * checkpoint was written, the payload of saveDeltaCheckpoint() */
+  NonlinearFactorGraph journalFactors_;
+  Values journalValues_;
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -195,12 +252,90 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    * If provided, 'deletedFactorsIndices' will be augmented with the factor
    * graph indices of any factor that was removed during the 'marginalizeLeaves'
    * call
+   *
+   * The affected cliques are determined in a single analysis pass, the
+   * marginal factors are formed in one batch (in parallel with TBB), and the
+   * factor graph and variable index are compacted once, so marginalizing a
+   * large window of old states costs little more than one elimination per
+   * straddling clique.
    */
   void marginalizeLeaves(
       const FastList<Key>& leafKeys,
       boost::optional<FactorIndices&> marginalFactorsIndices = boost::none,
       boost::optional<FactorIndices&> deletedFactorsIndices = boost::none);
 
+  /** Marginalize out every variable with key in the inclusive interval
+   * [first, last].  With time-ordered Symbol keys this expresses the typical
+   * fixed-lag cleanup "marginalize everything older than t" as a single
+   * O(log n + k) interval query on the sorted linearization point rather
+   * than a scan over all keys.  The collected keys are passed to
+   * marginalizeLeaves(const FastList<Key>&, ...) and must all be leaves.
+   */
+  void marginalizeLeaves(
+      Key first, Key last,
+      boost::optional<FactorIndices&> marginalFactorsIndices = boost::none,
+      boost::optional<FactorIndices&> deletedFactorsIndices = boost::none);
+
+  /** Return all keys j with first <= j <= last in the linearization point,
+   * in increasing order; an O(log n + k) interval query. */
+  KeyVector keysInRange(Key first, Key last) const {
+    return theta_.keysInRange(first, last);
+  }
+
+  /** Return the number of cliques on the longest root-to-leaf path of the
+   * Bayes tree (0 if empty).  Backsubstitution latency grows with this
+   * depth, so it is the quantity to monitor on long incremental sessions. */
+  size_t treeDepth() const;
+
+  /** If any clique sits deeper than maxDepth, re-eliminate the deep region
+   * with a fresh ordering and return true; otherwise do nothing and return
+   * false.  The affected variables are passed as extraReelimKeys to a
+   * factor-less update(), so removeTop pulls out the offending cliques
+   * together with their paths to the root and the constrained COLAMD
+   * ordering computed during recalculation rebuilds them, typically much
+   * shallower.  The solution is unchanged - re-elimination is exact.  Set
+   * ISAM2Params::rebalanceDepthBound to run this automatically after every
+   * update. */
+  bool rebalance(size_t maxDepth);
+
+  /// @name Checkpointing
+  /// @{
+
+  /** Start (or stop) recording the factors and initial values passed to
+   * update(), so saveDeltaCheckpoint() can write just the changes since the
+   * last checkpoint.  Recording is off by default; full checkpoints work
+   * without it. */
+  void enableCheckpointJournal(bool enable = true);
+
+  /** Write the complete ISAM2 state - Bayes tree, linearization point,
+   * delta, nonlinear factors and caches - to a binary file, and clear the
+   * delta journal so subsequent delta checkpoints are relative to this one.
+   * The parameters are not saved; construct the restoring object with the
+   * same ISAM2Params.  As with all gtsam serialization, the concrete factor,
+   * value and noise model types involved must be registered with
+   * BOOST_CLASS_EXPORT in the calling program. */
+  void saveCheckpoint(const std::string& filename);
+
+  /** Write only the factors and initial values received by update() since
+   * the last checkpoint (full or delta) and clear the journal.  Requires
+   * enableCheckpointJournal().  Orders of magnitude smaller and faster than
+   * a full checkpoint on a large tree. */
+  void saveDeltaCheckpoint(const std::string& filename);
+
+  /** Replace the state of this object with a checkpoint written by
+   * saveCheckpoint(), keeping the current parameters. */
+  void restoreCheckpoint(const std::string& filename);
+
+  /** Apply a delta checkpoint on top of the current state by replaying the
+   * recorded factors and values through a single update().  Deltas must be
+   * applied in the order they were written.  The resulting tree is a valid
+   * ISAM2 state for the full measurement set, though not necessarily
+   * bit-identical to the original session, which processed the same
+   * measurements as several updates. */
+  ISAM2Result restoreDeltaCheckpoint(const std::string& filename);
+
+  /// @}
+
   /// Access the current linearization point
   const Values& getLinearizationPoint() const { return theta_; }
 
@@ -236,6 +371,43 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    */
   const Value& calculateEstimate(Key key) const;
 
+  /** Compute estimates for a subset of the variables only.  This retracts
+   * just the requested keys instead of the whole linearization point, so it
+   * is much faster than calculateEstimate() when only a few variables are
+   * needed.
+   * @param keys the variables to retract
+   * @return a Values containing exactly the requested variables
+   */
+  Values calculateEstimates(const KeyVector& keys) const;
+
+  /** A lightweight view over the internal delta that retracts estimates per
+   * key on first access and caches the result.  The cache is invalidated
+   * automatically when the estimate changes (tracked with a generation
+   * counter), so repeated reads of a few keys between updates - e.g. from a
+   * high-rate control loop - cost a map lookup instead of a full retract.
+   * The view holds a pointer to the ISAM2 object and must not outlive it.
+   */
+  class GTSAM_EXPORT EstimateView {
+   public:
+    explicit EstimateView(const ISAM2& isam) : isam_(&isam), generation_(0) {}
+
+    /** Retracted estimate for a single variable, computed on first access
+     * and served from the cache until the next update. */
+    const Value& at(Key key) const;
+
+    /** Typed version of at() */
+    template <class VALUE>
+    VALUE at(Key key) const {
+      at(key);  // ensure the cache is current and the key is cached
+      return cache_.at<VALUE>(key);
+    }
+
+   private:
+    const ISAM2* isam_;                 ///< not owned
+    mutable std::uint64_t generation_;  ///< generation the cache matches
+    mutable Values cache_;              ///< lazily retracted estimates
+  };
+
   /** Return marginal on any variable as a covariance matrix */
   Matrix marginalCovariance(Key key) const;
 
@@ -264,11 +436,78 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** Access the nonlinear variable index */
   const KeySet& getFixedVariables() const { return fixedVariables_; }
 
+  /** Access the dense Key remapping, a bijection between the keys currently
+   * in the system and the dense integer range [0,size()).  It is maintained
+   * incrementally as variables are added and removed, so clients can keep
+   * per-variable quantities in flat arrays indexed by the dense id instead
+   * of hash maps keyed by the sparse Key.  An erase relabels at most one
+   * surviving key, see DenseKeyMap::erase. */
+  const DenseKeyMap& getDenseKeyMap() const { return denseKeyMap_; }
+
   const ISAM2Params& params() const { return params_; }
 
+  /** Register an accuracy zone: all variables with keys in the inclusive
+   * range [first, last] use \c threshold instead of the wildfire threshold
+   * from the optimization parameters during delta updates.  Tight zones
+   * (e.g. threshold 0 over the frontier poses a controller consumes) force
+   * accurate deltas there, while loose zones over the old map let wildfire
+   * propagation stop early; where zones overlap the tightest wins.  Existing
+   * variables in the range are marked for re-solution, so the next delta
+   * update brings them up to the new tolerance.  Zones persist across
+   * updates until replaced or cleared and are not serialized. */
+  void registerAccuracyZone(Key first, Key last, double threshold);
+
+  /** Remove all accuracy zones, restoring the uniform wildfire threshold */
+  void clearAccuracyZones();
+
+  /** Access the registered accuracy zones */
+  const WildfireThresholds& accuracyZones() const { return accuracyZones_; }
+
+  /** Number of times a factor had to be relinearized because its cached
+   * linearization had been evicted under ISAM2Params::cacheEvictionAge.
+   * Compare against the update count to judge whether the eviction age is
+   * too aggressive for the motion pattern of the session. */
+  size_t cacheRecomputeCount() const { return cacheRecomputeCount_; }
+
+  /** Replace the relinearization threshold at runtime.  Unlike mutating a
+   * copy of the parameters, this re-tests every variable with a pending
+   * delta against the new threshold on the next update, so variables whose
+   * deltas were checked (and dismissed) under the old threshold are not
+   * missed.  Accepts either a scalar or a per-type FastMap<char,Vector>,
+   * like ISAM2Params::relinearizeThreshold. */
+  void setRelinearizeThreshold(
+      const ISAM2Params::RelinearizationThreshold& threshold);
+
+  /** Update the relinearization threshold of one variable type (the Symbol
+   * character) at runtime, e.g. to loosen landmark relinearization once the
+   * map has converged while keeping poses tight.  The current threshold must
+   * already be a per-type map - there is no safe automatic promotion from a
+   * scalar because the map must cover every type in the system - otherwise
+   * std::invalid_argument is thrown.  Re-tests pending deltas like the
+   * overload above. */
+  void setRelinearizeThreshold(unsigned char c, const Vector& threshold);
+
   /** prints out clique statistics */
   void printStats() const { getCliqueData().getStats().print(); }
 
+  /** Gather approximate memory usage over all cliques.  On top of the base
+   * class accounting this includes the cached linearized factors kept by each
+   * ISAM2 clique, reported in cachedFactorBytes.  Like the base version this
+   * takes no locks and can be polled from a monitoring thread. */
+  BayesTreeMemoryUsage memoryUsage() const;
+
+  /** Compress the cached linearized factors of cold cliques in place,
+   * releasing their dense storage until they are next accessed. A clique is
+   * considered cold when none of its frontal variables have a pending delta
+   * change; in long sessions most of the tree goes quiet and stays archived.
+   * When ISAM2Params::float32CliqueStorage is set this additionally
+   * re-encodes cold cliques' conditional matrices as float32, roughly
+   * halving the resident memory of the quiet part of the tree (see
+   * GaussianConditional::compressStorage for the accuracy bound).
+   * Restoration is transparent and lazy, so this can be called after every
+   * update. @return number of bytes released. */
+  size_t archiveColdCliques();
+
   /** Compute the gradient of the energy function, \f$ \nabla_{x=0} \left\Vert
    * \Sigma^{-1} R x - d \right\Vert^2 \f$, centered around zero. The gradient
    * about zero is \f$ -R^T d \f$.  See also gradient(const GaussianBayesNet&,
@@ -285,6 +524,21 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void recalculate(const ISAM2UpdateParams& updateParams,
                    const KeySet& relinKeys, ISAM2Result* result);
 
+  /**
+   * Fast path for updates whose new factors involve only brand-new
+   * variables: such variables are disconnected from the existing cliques, so
+   * their conditional can be appended to the tree directly, skipping the
+   * removeTop / junction-tree machinery of recalculate().  Returns true if
+   * the update was handled; returns false (leaving the tree untouched) when
+   * any factor touches an existing variable or the update removes factors,
+   * relinearizes, or constrains the ordering, in which case the caller runs
+   * the general recalculate().
+   */
+  bool tryDirectAppend(const NonlinearFactorGraph& newFactors,
+                       const Values& newTheta,
+                       const ISAM2UpdateParams& updateParams,
+                       const KeySet& relinKeys, ISAM2Result* result);
+
   // Do a batch step - reorder and relinearize all variables
   void recalculateBatch(const ISAM2UpdateParams& updateParams,
                         KeySet* affectedKeysSet, ISAM2Result* result);
@@ -295,6 +549,26 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
       const ISAM2UpdateParams& updateParams, const FastList<Key>& affectedKeys,
       const KeySet& relinKeys);
 
+  /// Record that the cached linearization in slot idx was read or refreshed
+  /// this update, growing the per-slot bookkeeping as needed
+  void touchLinearFactor(FactorIndex idx);
+
+  /// Drop cached linearizations untouched for the last
+  /// ISAM2Params::cacheEvictionAge updates; the slots stay, holding null,
+  /// and relinearizeAffectedFactors() refills them on demand
+  void evictColdLinearFactors();
+
+  /// Mark every variable with a pending delta for re-testing against the
+  /// relinearization threshold, called whenever the threshold changes:
+  /// relinCandidates_ is maintained incrementally against the threshold in
+  /// effect when each delta last changed, so it goes stale otherwise
+  void relinearizeThresholdsChanged();
+
+  /// Scale the per-type thresholds from the error reduction this update's
+  /// relinearizations bought, see ISAM2Params::adaptiveRelinearizationTarget
+  void adaptRelinearizeThresholds(const ISAM2Result& result,
+                                  const KeySet& relinKeys);
+
   void recalculateIncremental(const ISAM2UpdateParams& updateParams,
                               const KeySet& relinKeys,
                               const FastList<Key>& affectedKeys,
@@ -315,6 +589,33 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void removeVariables(const KeySet& unusedKeys);
 
   void updateDelta(bool forceFullSolve = false) const;
+
+ private:
+  /** Serialization function, see saveCheckpoint().  The parameters and the
+   * checkpoint journal are deliberately left out: parameters stay with the
+   * restoring object, and a freshly written checkpoint starts an empty
+   * journal. */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& boost::serialization::make_nvp(
+        "BayesTree", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(theta_);
+    ar& BOOST_SERIALIZATION_NVP(variableIndex_);
+    ar& BOOST_SERIALIZATION_NVP(delta_);
+    ar& BOOST_SERIALIZATION_NVP(deltaNewton_);
+    ar& BOOST_SERIALIZATION_NVP(RgProd_);
+    ar& BOOST_SERIALIZATION_NVP(deltaReplacedMask_);
+    ar& BOOST_SERIALIZATION_NVP(deltaChangedSinceRelinCheck_);
+    ar& BOOST_SERIALIZATION_NVP(relinCandidates_);
+    ar& BOOST_SERIALIZATION_NVP(nonlinearFactors_);
+    ar& BOOST_SERIALIZATION_NVP(linearFactors_);
+    ar& BOOST_SERIALIZATION_NVP(linearFactorLastUsed_);
+    ar& BOOST_SERIALIZATION_NVP(doglegDelta_);
+    ar& BOOST_SERIALIZATION_NVP(fixedVariables_);
+    ar& BOOST_SERIALIZATION_NVP(denseKeyMap_);
+    ar& BOOST_SERIALIZATION_NVP(update_count_);
+  }
 };  // ISAM2
 
 /// traits
@@ -16,10 +16,14 @@
  */
 
 #include <gtsam/inference/BayesTreeCliqueBase-inst.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/linearAlgorithms-inst.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
 
+#include <algorithm>
+#include <limits>
 #include <stack>
 #include <utility>
 
@@ -30,6 +34,31 @@ namespace gtsam {
 // Instantiate base class
 template class BayesTreeCliqueBase<ISAM2Clique, GaussianFactorGraph>;
 
+/* ************************************************************************* */
+void WildfireThresholds::addZone(Key first, Key last, double threshold) {
+  if (last < first) std::swap(first, last);
+  Zone zone;
+  zone.first = first;
+  zone.last = last;
+  zone.threshold = threshold;
+  zones_.push_back(zone);
+}
+
+/* ************************************************************************* */
+double WildfireThresholds::thresholdFor(Key key,
+                                        double defaultThreshold) const {
+  double threshold = defaultThreshold;
+  bool inZone = false;
+  for (const Zone& zone : zones_) {
+    if (key < zone.first || zone.last < key) continue;
+    // The first matching zone replaces the default outright, so a single
+    // loose zone can raise the threshold; overlapping zones take the min.
+    threshold = inZone ? std::min(threshold, zone.threshold) : zone.threshold;
+    inZone = true;
+  }
+  return threshold;
+}
+
 /* ************************************************************************* */
 void ISAM2Clique::setEliminationResult(
     const FactorGraphType::EliminationResult& eliminationResult) {
@@ -42,10 +71,90 @@ void ISAM2Clique::setEliminationResult(
   gradientContribution_ << -conditional_->R().transpose() *
                                conditional_->d(),
       -conditional_->S().transpose() * conditional_->d();
+  // A fresh elimination result supersedes any archived image
+  archiveRuns_.clear();
+  archiveLiterals_.clear();
+  archiveRows_ = archiveCols_ = 0;
+}
+
+/* ************************************************************************* */
+namespace {
+// Lossless zero-run-length coding of a dense double buffer: alternating
+// (zero-run, literal-run) lengths, with the literal values stored in order.
+void compressZeroRuns(const double* data, size_t n,
+                      vector<pair<uint32_t, uint32_t> >* runs,
+                      vector<double>* literals) {
+  size_t i = 0;
+  while (i < n) {
+    size_t zeros = 0;
+    while (i < n && data[i] == 0.0) ++zeros, ++i;
+    const size_t start = i;
+    while (i < n && data[i] != 0.0) ++i;
+    runs->push_back(make_pair(static_cast<uint32_t>(zeros),
+                              static_cast<uint32_t>(i - start)));
+    literals->insert(literals->end(), data + start, data + i);
+  }
+}
+
+void decompressZeroRuns(const vector<pair<uint32_t, uint32_t> >& runs,
+                        const vector<double>& literals, double* out) {
+  size_t li = 0;
+  for (const pair<uint32_t, uint32_t>& run : runs) {
+    std::fill(out, out + run.first, 0.0);
+    out += run.first;
+    std::copy(literals.begin() + li, literals.begin() + li + run.second, out);
+    out += run.second;
+    li += run.second;
+  }
+}
+}  // namespace
+
+/* ************************************************************************* */
+Matrix* ISAM2Clique::cachedFactorStorage() const {
+  if (boost::shared_ptr<JacobianFactor> jf =
+          boost::dynamic_pointer_cast<JacobianFactor>(cachedFactor_))
+    return &jf->matrixObject().matrix();
+  if (boost::shared_ptr<HessianFactor> hf =
+          boost::dynamic_pointer_cast<HessianFactor>(cachedFactor_))
+    return &hf->info().matrix();
+  return nullptr;
+}
+
+/* ************************************************************************* */
+size_t ISAM2Clique::archive() {
+  if (archived() || !cachedFactor_) return 0;
+  Matrix* storage = cachedFactorStorage();
+  if (!storage || storage->size() == 0) return 0;
+
+  compressZeroRuns(storage->data(), storage->size(), &archiveRuns_,
+                   &archiveLiterals_);
+  archiveRows_ = storage->rows();
+  archiveCols_ = storage->cols();
+
+  const size_t before = storage->size() * sizeof(double);
+  const size_t after = archiveLiterals_.size() * sizeof(double) +
+                       archiveRuns_.size() * sizeof(pair<uint32_t, uint32_t>);
+  storage->resize(0, 0);
+  return before > after ? before - after : 0;
+}
+
+/* ************************************************************************* */
+void ISAM2Clique::restore() const {
+  if (!archived()) return;
+  Matrix* storage = cachedFactorStorage();
+  storage->resize(archiveRows_, archiveCols_);
+  decompressZeroRuns(archiveRuns_, archiveLiterals_, storage->data());
+  archiveRuns_.clear();
+  archiveRuns_.shrink_to_fit();
+  archiveLiterals_.clear();
+  archiveLiterals_.shrink_to_fit();
+  archiveRows_ = archiveCols_ = 0;
 }
 
 /* ************************************************************************* */
 bool ISAM2Clique::equals(const This& other, double tol) const {
+  restore();
+  other.restore();
   return Base::equals(other) &&
          ((!cachedFactor_ && !other.cachedFactor_) ||
           (cachedFactor_ && other.cachedFactor_ &&
@@ -54,6 +163,7 @@ bool ISAM2Clique::equals(const This& other, double tol) const {
 
 /* ************************************************************************* */
 void ISAM2Clique::print(const string& s, const KeyFormatter& formatter) const {
+  restore();
   Base::print(s, formatter);
   if (cachedFactor_)
     cachedFactor_->print(s + "Cached: ", formatter);
@@ -232,10 +342,21 @@ size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
   return count;
 }
 
+/* ************************************************************************* */
+double ISAM2Clique::zoneThreshold(double threshold,
+                                  const WildfireThresholds* zones) const {
+  if (!zones || zones->empty()) return threshold;
+  double result = std::numeric_limits<double>::infinity();
+  for (Key frontal : conditional_->frontals())
+    result = std::min(result, zones->thresholdFor(frontal, threshold));
+  return result;
+}
+
 /* ************************************************************************* */
 bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
                                        KeySet* changed, VectorValues* delta,
-                                       size_t* count) const {
+                                       size_t* count,
+                                       const WildfireThresholds* zones) const {
   // TODO(gareth): This code shares a lot of logic w/ linearAlgorithms-inst,
   // potentially refactor
   bool dirty = isDirty(replaced, *changed);
@@ -247,7 +368,8 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
     fastBackSubstitute(delta);
     count += conditional_->nrFrontals();
 
-    if (valuesChanged(replaced, originalValues, *delta, threshold)) {
+    if (valuesChanged(replaced, originalValues, *delta,
+                      zoneThreshold(threshold, zones))) {
       markFrontalsAsChanged(changed);
     } else {
       restoreFromOriginals(originalValues, delta);
@@ -259,7 +381,8 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
 
 size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& keys,
-                                    VectorValues* delta) {
+                                    VectorValues* delta, KeySet* changedKeys,
+                                    const WildfireThresholds* zones) {
   KeySet changed;
   size_t count = 0;
 
@@ -271,7 +394,7 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
       currentNode = travStack.top();
       travStack.pop();
       bool dirty = currentNode->optimizeWildfireNode(keys, threshold, &changed,
-                                                     delta, &count);
+                                                     delta, &count, zones);
       if (dirty) {
         for (const auto& child : currentNode->children) {
           travStack.push(child);
@@ -280,6 +403,9 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
     }
   }
 
+  if (changedKeys)
+    changedKeys->insert(changed.begin(), changed.end());
+
   return count;
 }
 
@@ -24,10 +24,48 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
+/**
+ * Per-key-range wildfire thresholds ("accuracy zones") for the delta update.
+ * The wildfire threshold trades delta accuracy for propagation work, but the
+ * right trade is rarely uniform: frontier poses feeding a controller need
+ * tight deltas while the old map can tolerate loose ones.  A zone assigns its
+ * own threshold to an inclusive key range; keys outside every zone keep the
+ * default threshold from the optimization parameters.  Where zones overlap,
+ * the tightest one wins, and within a clique the tightest requirement among
+ * its frontal variables governs the whole clique.
+ */
+class GTSAM_EXPORT WildfireThresholds {
+ public:
+  WildfireThresholds() {}
+
+  /// Register the inclusive key range [first, last] with its own threshold
+  void addZone(Key first, Key last, double threshold);
+
+  /// Remove all zones, restoring the uniform default threshold
+  void clearZones() { zones_.clear(); }
+
+  /// Whether any zones are registered
+  bool empty() const { return zones_.empty(); }
+
+  /// Threshold for a single key: the tightest zone containing it, or
+  /// defaultThreshold when no zone does
+  double thresholdFor(Key key, double defaultThreshold) const;
+
+ private:
+  struct Zone {
+    Key first, last;
+    double threshold;
+  };
+  std::vector<Zone> zones_;
+};
+
 /**
  * Specialized Clique structure for ISAM2, incorporating caching and gradient
  * contribution
@@ -50,14 +88,18 @@ class GTSAM_EXPORT ISAM2Clique
 #endif
 
   /// Default constructor
-  ISAM2Clique() : Base() {}
+  ISAM2Clique() : Base(), archiveRows_(0), archiveCols_(0) {}
 
   /// Copy constructor, does *not* copy solution pointers as these are invalid
   /// in different trees.
   ISAM2Clique(const ISAM2Clique& other)
       : Base(other),
         cachedFactor_(other.cachedFactor_),
-        gradientContribution_(other.gradientContribution_) {}
+        gradientContribution_(other.gradientContribution_),
+        archiveRuns_(other.archiveRuns_),
+        archiveLiterals_(other.archiveLiterals_),
+        archiveRows_(other.archiveRows_),
+        archiveCols_(other.archiveCols_) {}
 
   /// Assignment operator, does *not* copy solution pointers as these are
   /// invalid in different trees.
@@ -65,6 +107,10 @@ class GTSAM_EXPORT ISAM2Clique
     Base::operator=(other);
     cachedFactor_ = other.cachedFactor_;
     gradientContribution_ = other.gradientContribution_;
+    archiveRuns_ = other.archiveRuns_;
+    archiveLiterals_ = other.archiveLiterals_;
+    archiveRows_ = other.archiveRows_;
+    archiveCols_ = other.archiveCols_;
     return *this;
   }
 
@@ -72,8 +118,33 @@ class GTSAM_EXPORT ISAM2Clique
   void setEliminationResult(
       const FactorGraphType::EliminationResult& eliminationResult);
 
-  /** Access the cached factor */
-  Base::FactorType::shared_ptr& cachedFactor() { return cachedFactor_; }
+  /** Access the cached factor, transparently restoring it if archived */
+  Base::FactorType::shared_ptr& cachedFactor() {
+    if (archived()) restore();
+    return cachedFactor_;
+  }
+
+  /**
+   * Compress the cached factor's dense storage in place and release the
+   * original matrix, leaving the rest of the clique untouched. The coding is
+   * lossless zero-run-length, so the savings are proportional to the
+   * structural zeros in the factor (e.g. below the diagonal of QR results).
+   * The factor is restored transparently on the next cachedFactor() access.
+   * @return number of bytes released, net of the compressed image
+   */
+  size_t archive();
+
+  /// Decompress an archived cached factor back into dense storage
+  void restore() const;
+
+  /// Whether the cached factor is currently archived
+  bool archived() const { return archiveRows_ > 0; }
+
+  /// Size in bytes of the compressed image, zero when not archived
+  size_t archivedBytes() const {
+    return archiveLiterals_.size() * sizeof(double) +
+           archiveRuns_.size() * sizeof(std::pair<std::uint32_t, std::uint32_t>);
+  }
 
   /// Access the gradient contribution
   const Vector& gradientContribution() const { return gradientContribution_; }
@@ -92,8 +163,8 @@ class GTSAM_EXPORT ISAM2Clique
                         size_t* count) const;
 
   bool optimizeWildfireNode(const KeySet& replaced, double threshold,
-                            KeySet* changed, VectorValues* delta,
-                            size_t* count) const;
+                            KeySet* changed, VectorValues* delta, size_t* count,
+                            const WildfireThresholds* zones = 0) const;
 
   /**
    * Starting from the root, add up entries of frontal and conditional matrices
@@ -139,6 +210,10 @@ class GTSAM_EXPORT ISAM2Clique
   bool valuesChanged(const KeySet& replaced, const Vector& originalValues,
                      const VectorValues& delta, double threshold) const;
 
+  /// The effective threshold for this clique: the tightest zone threshold
+  /// among the frontal variables, or \c threshold when no zone applies.
+  double zoneThreshold(double threshold, const WildfireThresholds* zones) const;
+
   /// Set changed flag for each frontal variable
   void markFrontalsAsChanged(KeySet* changed) const;
 
@@ -146,10 +221,21 @@ class GTSAM_EXPORT ISAM2Clique
   void restoreFromOriginals(const Vector& originalValues,
                             VectorValues* delta) const;
 
+  /// Return the dense storage of the cached factor, or nullptr if there is
+  /// none (used by archive()/restore())
+  Matrix* cachedFactorStorage() const;
+
+  /// Compressed image of the cached factor while archived: alternating
+  /// (zero-run, literal-run) lengths, with the literal values in order
+  mutable std::vector<std::pair<std::uint32_t, std::uint32_t> > archiveRuns_;
+  mutable std::vector<double> archiveLiterals_;
+  mutable DenseIndex archiveRows_, archiveCols_;
+
   /** Serialization function */
   friend class boost::serialization::access;
   template <class ARCHIVE>
   void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    restore();  // write the cached factor in dense form; no-op when loading
     ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
     ar& BOOST_SERIALIZATION_NVP(cachedFactor_);
     ar& BOOST_SERIALIZATION_NVP(gradientContribution_);
@@ -170,8 +256,18 @@ class GTSAM_EXPORT ISAM2Clique
 size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
                         const KeySet& replaced, VectorValues* delta);
 
+/**
+ * Non-recursive wildfire optimization.  If changedKeys is given, the keys
+ * whose delta entries were actually modified (i.e. changed by more than the
+ * threshold) are inserted into it, which lets callers track delta changes
+ * incrementally instead of rescanning the whole vector.  If zones is given,
+ * each clique is judged against the tightest zone threshold among its
+ * frontal variables instead of the uniform threshold (see
+ * WildfireThresholds).
+ */
 size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& replaced,
-                                    VectorValues* delta);
+                                    VectorValues* delta, KeySet* changedKeys = 0,
+                                    const WildfireThresholds* zones = 0);
 
 }  // namespace gtsam
@@ -223,6 +223,73 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** Per-update budget on estimated relinearization cost, to spread bursts of
+   * pending relinearizations over several updates instead of paying for all of
+   * them in one frame (default: 0, disabled). The cost of relinearizing a
+   * variable is modeled as the squared total dimension of its clique, a proxy
+   * for the re-elimination work it triggers. When the threshold check marks
+   * more variables than fit in the budget, the ones with the largest deltas
+   * are relinearized now and the rest stay above threshold, so they are
+   * picked up by subsequent updates. Calibrate against a wall-clock target by
+   * timing updates on your problem. At least one variable is always
+   * relinearized per update, so deferral never stalls. */
+  double relinearizeBudget;
+
+  /** Whether to fill ISAM2Result::journal, the compact per-update change
+   * journal for delta-driven consumers (default: false).  Filling the
+   * journal refreshes the linear delta eagerly at the end of every update,
+   * which getDelta() would otherwise do lazily. */
+  bool enableChangeJournal;
+
+  /** Minimum infinity-norm change of a variable's linear delta for the
+   * variable to be reported in ISAM2Result::ChangeJournal::deltaChangedKeys
+   * (default: 0, report every changed delta).  Only used when
+   * enableChangeJournal is set. */
+  double changeJournalDeltaEpsilon;
+
+  /** If nonzero, every update checks whether any clique sits deeper than this
+   * many cliques below its root, and if so re-eliminates the deep region with
+   * a fresh ordering (see ISAM2::rebalance).  Long incremental sessions can
+   * otherwise grow degenerate chain-like Bayes trees whose backsubstitution
+   * latency creeps up over time; an occasional local re-elimination keeps the
+   * tree, and hence per-update latency, flat (default: 0, disabled). */
+  size_t rebalanceDepthBound;
+
+  /** If true, archiveColdCliques() also re-encodes cold cliques' conditional
+   * matrices as float32 (see GaussianConditional::compressStorage), roughly
+   * halving the resident memory of the quiet part of the Bayes tree.  The
+   * double storage is rebuilt transparently when a compressed conditional is
+   * next solved, and all arithmetic accumulates in double; the rounding of
+   * the stored [R S d] entries is bounded by the float32 unit roundoff
+   * (~6e-8 relative), so backsubstitution through a restored clique is
+   * accurate to order cond(R) * 6e-8 (default: false). */
+  bool float32CliqueStorage;
+
+  /** If nonzero, cached linearizations (see cacheLinearizedFactors) of
+   * factors that have not been read or refreshed for this many updates are
+   * dropped at the end of each update, and lazily relinearized if a later
+   * update touches their part of the tree again.  In long sessions most of
+   * the cache covers quiet regions that are rarely re-eliminated, so this
+   * trades an occasional extra linearize() call - counted by
+   * ISAM2::cacheRecomputeCount() - for a much smaller resident cache
+   * (default: 0, keep every cached factor forever). */
+  size_t cacheEvictionAge;
+
+  /** If nonzero, the per-type relinearization thresholds are tuned online
+   * from the observed cost/benefit of relinearizing (default: 0, disabled).
+   * The value is the target relative error reduction per relinearized
+   * variable: after every update that relinearized something, the fraction
+   * of the nonlinear error removed is divided by the number of relinearized
+   * variables and compared against the target.  Types whose relinearizations
+   * bought much less than the target get their thresholds raised (up to 10x
+   * the configured value), so e.g. well-converged landmarks stop being
+   * relinearized for negligible accuracy gain; when relinearization is
+   * paying off again the thresholds decay back toward the configured
+   * values, which act as a floor and therefore as the accuracy contract.
+   * Requires relinearizeThreshold to hold a per-type FastMap<char,Vector>
+   * and evaluateNonlinearError to be set; it is a no-op otherwise. */
+  double adaptiveRelinearizationTarget;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +313,14 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(_enableDetailedResults),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        relinearizeBudget(0.0),
+        enableChangeJournal(false),
+        changeJournalDeltaEpsilon(0.0),
+        rebalanceDepthBound(0),
+        float32CliqueStorage(false),
+        cacheEvictionAge(0),
+        adaptiveRelinearizationTarget(0.0) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +362,14 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "relinearizeBudget:                 " << relinearizeBudget << "\n";
+    cout << "rebalanceDepthBound:               " << rebalanceDepthBound
+         << "\n";
+    cout << "float32CliqueStorage:              " << float32CliqueStorage
+         << "\n";
+    cout << "cacheEvictionAge:                  " << cacheEvictionAge << "\n";
+    cout << "adaptiveRelinearizationTarget:     " << adaptiveRelinearizationTarget
+         << "\n";
     cout.flush();
   }
 
@@ -312,6 +394,12 @@ struct GTSAM_EXPORT ISAM2Params {
   bool isEnablePartialRelinearizationCheck() const {
     return enablePartialRelinearizationCheck;
   }
+  double getRelinearizeBudget() const { return relinearizeBudget; }
+  size_t getRebalanceDepthBound() const { return rebalanceDepthBound; }
+  size_t getCacheEvictionAge() const { return cacheEvictionAge; }
+  double getAdaptiveRelinearizationTarget() const {
+    return adaptiveRelinearizationTarget;
+  }
 
   void setOptimizationParams(OptimizationParams optimizationParams) {
     this->optimizationParams = optimizationParams;
@@ -344,6 +432,18 @@ struct GTSAM_EXPORT ISAM2Params {
       bool enablePartialRelinearizationCheck) {
     this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck;
   }
+  void setRelinearizeBudget(double relinearizeBudget) {
+    this->relinearizeBudget = relinearizeBudget;
+  }
+  void setRebalanceDepthBound(size_t rebalanceDepthBound) {
+    this->rebalanceDepthBound = rebalanceDepthBound;
+  }
+  void setCacheEvictionAge(size_t cacheEvictionAge) {
+    this->cacheEvictionAge = cacheEvictionAge;
+  }
+  void setAdaptiveRelinearizationTarget(double adaptiveRelinearizationTarget) {
+    this->adaptiveRelinearizationTarget = adaptiveRelinearizationTarget;
+  }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -110,6 +110,32 @@ struct ISAM2Result {
   /** All keys that were marked during the update process. */
   KeySet markedKeys;
 
+  /**
+   * A compact per-update change journal for delta-driven consumers (map
+   * servers, renderers, ...) that need "what changed since the last update"
+   * without diffing whole Values snapshots.  Each entry lists only the keys
+   * touched by this update() call, so incremental publication is O(changes)
+   * rather than O(map).  Filled when ISAM2Params::enableChangeJournal is
+   * set; the delta filter uses ISAM2Params::changeJournalDeltaEpsilon.
+   */
+  struct ChangeJournal {
+    /// Variables added by this update
+    KeyVector newKeys;
+    /// Variables removed as unused by this update
+    KeyVector removedKeys;
+    /// Variables whose linearization point moved (relinearized)
+    KeyVector relinearizedKeys;
+    /** Variables whose linear delta changed by more than
+     * ISAM2Params::changeJournalDeltaEpsilon (infinity norm) during this
+     * update.  New keys may appear here as well once their first delta is
+     * computed. */
+    KeyVector deltaChangedKeys;
+  };
+
+  /** The change journal for this update, if enabled by
+   * ISAM2Params::enableChangeJournal.  See ChangeJournal. */
+  boost::optional<ChangeJournal> journal;
+
   /**
    * A struct holding detailed results, which must be enabled with
    * ISAM2Params::enableDetailedResults.
@@ -82,11 +82,21 @@ int LevenbergMarquardtOptimizer::getInnerIterations() const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearize() const {
+  if (params_.useLinearizationArena) {
+    // The previous iteration's linear graph has been discarded by now, but
+    // the buffered damped system still holds shared_ptrs to its
+    // arena-allocated factors; drop those before reclaiming the arena so
+    // nothing outlives the reset
+    dampedSystem_ = GaussianFactorGraph();
+    dampedPrefixValid_ = false;
+    linearizationArena_.reset();
+    return graph_.linearize(state_->values, linearizationArena_);
+  }
   return graph_.linearize(state_->values);
 }
 
 /* ************************************************************************* */
-GaussianFactorGraph LevenbergMarquardtOptimizer::buildDampedSystem(
+const GaussianFactorGraph& LevenbergMarquardtOptimizer::buildDampedSystem(
     const GaussianFactorGraph& linear, const VectorValues& sqrtHessianDiagonal) const {
   gttic(damp);
   auto currentState = static_cast<const State*>(state_.get());
@@ -94,10 +104,22 @@ GaussianFactorGraph LevenbergMarquardtOptimizer::buildDampedSystem(
   if (params_.verbosityLM >= LevenbergMarquardtParams::DAMPED)
     std::cout << "building damped system with lambda " << currentState->lambda << std::endl;
 
+  // The damped system is the linear graph plus one damping prior per
+  // variable.  Only the damping tail depends on lambda, so copy the base
+  // factor slots into the buffer once per linearization and just replace the
+  // tail on each retry.
+  if (!dampedPrefixValid_) {
+    dampedSystem_ = linear;
+    dampedPrefixValid_ = true;
+  } else {
+    dampedSystem_.resize(linear.size());  // drop the previous damping tail
+  }
+
   if (params_.diagonalDamping)
-    return currentState->buildDampedSystem(linear, sqrtHessianDiagonal);
+    currentState->appendDampingFactors(&dampedSystem_, sqrtHessianDiagonal);
   else
-    return currentState->buildDampedSystem(linear);
+    currentState->appendDampingFactors(&dampedSystem_);
+  return dampedSystem_;
 }
 
 /* ************************************************************************* */
@@ -115,6 +137,39 @@ inline void LevenbergMarquardtOptimizer::writeLogFile(double currentError){
   }
 }
 
+/* ************************************************************************* */
+double LevenbergMarquardtOptimizer::errorWithCache(const VectorValues& delta,
+    const Values& newValues, std::vector<double>* newFactorErrors) const {
+  auto currentState = static_cast<const State*>(state_.get());
+
+  // Seed the cache with the per-factor errors at the current values the
+  // first time through; afterwards it is maintained incrementally below.
+  if (cachedFactorErrors_.size() != graph_.size()) {
+    cachedFactorErrors_.resize(graph_.size());
+    for (size_t i = 0; i < graph_.size(); ++i)
+      cachedFactorErrors_[i] = graph_[i] ? graph_[i]->error(currentState->values) : 0.0;
+  }
+
+  newFactorErrors->resize(graph_.size());
+  double total = 0.0;
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    const NonlinearFactor::shared_ptr& factor = graph_[i];
+    if (!factor) {
+      (*newFactorErrors)[i] = 0.0;
+      continue;
+    }
+    // A factor only needs re-evaluation if the step moved one of its
+    // variables by more than epsilon
+    double maxDelta = 0.0;
+    for(Key key: *factor)
+      maxDelta = std::max(maxDelta, delta.at(key).lpNorm<Eigen::Infinity>());
+    (*newFactorErrors)[i] = maxDelta <= params_.errorCacheEpsilon ?
+        cachedFactorErrors_[i] : factor->error(newValues);
+    total += (*newFactorErrors)[i];
+  }
+  return total;
+}
+
 /* ************************************************************************* */
 bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
                                             const VectorValues& sqrtHessianDiagonal) {
@@ -133,7 +188,7 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
     cout << "trying lambda = " << currentState->lambda << endl;
 
   // Build damped system for this lambda (adds prior factors that make it like gradient descent)
-  auto dampedSystem = buildDampedSystem(linear, sqrtHessianDiagonal);
+  const auto& dampedSystem = buildDampedSystem(linear, sqrtHessianDiagonal);
 
   // Try solving
   double modelFidelity = 0.0;
@@ -142,6 +197,7 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
   double newError = numeric_limits<double>::infinity(), costChange;
   Values newValues;
   VectorValues delta;
+  std::vector<double> newFactorErrors;
 
   bool systemSolvedSuccessfully;
   try {
@@ -178,7 +234,10 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
       gttic(compute_error);
       if (verbose)
         cout << "calculating error:" << endl;
-      newError = graph_.error(newValues);
+      if (params_.errorCacheEpsilon > 0.0)
+        newError = errorWithCache(delta, newValues, &newFactorErrors);
+      else
+        newError = graph_.error(newValues);
       gttoc(compute_error);
 
       if (verbose)
@@ -228,6 +287,10 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
 
   if (step_is_successful) {
     // we have successfully decreased the cost and we have good modelFidelity
+    // The accepted step makes the candidate per-factor errors current; a
+    // rejected step falls through below and leaves the cache untouched
+    if (params_.errorCacheEpsilon > 0.0)
+      cachedFactorErrors_.swap(newFactorErrors);
     // NOTE(frank): As we return immediately after this, we move the newValues
     // TODO(frank): make Values actually support move. Does not seem to happen now.
     state_ = currentState->decreaseLambda(params_, modelFidelity, std::move(newValues), newError);
@@ -266,6 +329,9 @@ GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::iterate() {
     cout << "linearizing = " << endl;
   GaussianFactorGraph::shared_ptr linear = linearize();
 
+  // New linearization: the buffered damped-system prefix is stale
+  dampedPrefixValid_ = false;
+
   if(currentState->totalNumberInnerIterations==0) { // write initial error
     writeLogFile(currentState->error);
 
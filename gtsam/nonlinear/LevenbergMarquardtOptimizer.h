@@ -22,8 +22,11 @@
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 #include <gtsam/nonlinear/LevenbergMarquardtParams.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/MemoryArena.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <vector>
 
 class NonlinearOptimizerMoreOptimizationTest;
 
@@ -36,10 +39,24 @@ class GTSAM_EXPORT LevenbergMarquardtOptimizer: public NonlinearOptimizer {
 
 protected:
   const LevenbergMarquardtParams params_; ///< LM parameters
+  mutable MemoryArena linearizationArena_; ///< backs the per-iteration linear graph if params_.useLinearizationArena
+  mutable GaussianFactorGraph dampedSystem_; ///< buffer holding base graph plus damping tail, reused across lambda retries
+  mutable bool dampedPrefixValid_ = false; ///< whether dampedSystem_ holds the current linearization as prefix
+  mutable std::vector<double> cachedFactorErrors_; ///< per-factor errors at the current values, used if params_.errorCacheEpsilon > 0 (empty = not seeded)
   boost::posix_time::ptime startTime_;
 
   void initTime();
 
+  /**
+   * Evaluate the total error at \c newValues, reusing a factor's cached
+   * error whenever the largest delta entry over its variables is at most
+   * params_.errorCacheEpsilon.  Fills \c newFactorErrors with the per-factor
+   * errors of the candidate step; tryLambda swaps them into the cache only
+   * when the step is accepted, so a rejected step leaves the cache intact.
+   */
+  double errorWithCache(const VectorValues& delta, const Values& newValues,
+      std::vector<double>* newFactorErrors) const;
+
 public:
   typedef boost::shared_ptr<LevenbergMarquardtOptimizer> shared_ptr;
 
@@ -110,8 +127,13 @@ public:
   /** linearize, can be overwritten */
   virtual GaussianFactorGraph::shared_ptr linearize() const;
 
-  /** Build a damped system for a specific lambda -- for testing only */
-  GaussianFactorGraph buildDampedSystem(const GaussianFactorGraph& linear,
+  /** Build a damped system for a specific lambda.  The returned reference
+   *  points into an internal buffer: the shared_ptr slots of the base graph
+   *  are copied once per linearization and only the damping tail is replaced
+   *  on subsequent calls (i.e. lambda retries), so speculative retries do not
+   *  re-copy the factor vector.  The reference is invalidated by the next
+   *  call. */
+  const GaussianFactorGraph& buildDampedSystem(const GaussianFactorGraph& linear,
                                         const VectorValues& sqrtHessianDiagonal) const;
 
   /** Inner loop, changes state, returns true if successful or giving up */
@@ -54,6 +54,8 @@ public:
   bool useFixedLambdaFactor; ///< if true applies constant increase (or decrease) to lambda according to lambdaFactor
   double minDiagonal; ///< when using diagonal damping saturates the minimum diagonal entries (default: 1e-6)
   double maxDiagonal; ///< when using diagonal damping saturates the maximum diagonal entries (default: 1e32)
+  bool useLinearizationArena; ///< if true, allocate the per-iteration linearized graph from a resettable memory arena (default: false)
+  double errorCacheEpsilon; ///< if positive, reuse a factor's cached error when the max delta over its variables is below this (default: 0, always re-evaluate)
 
   LevenbergMarquardtParams()
       : verbosityLM(SILENT),
@@ -76,6 +78,8 @@ public:
     p->minModelFidelity = 1e-3;
     p->diagonalDamping = false;
     p->useFixedLambdaFactor = true;
+    p->useLinearizationArena = false;
+    p->errorCacheEpsilon = 0.0;
   }
 
   // these do seem to work better for SFM
@@ -130,6 +134,8 @@ public:
   double getlambdaLowerBound() const { return lambdaLowerBound; }
   double getlambdaUpperBound() const { return lambdaUpperBound; }
   bool getUseFixedLambdaFactor() { return useFixedLambdaFactor; }
+  bool getUseLinearizationArena() const { return useLinearizationArena; }
+  double getErrorCacheEpsilon() const { return errorCacheEpsilon; }
   std::string getLogFile() const { return logFile; }
   std::string getVerbosityLM() const { return verbosityLMTranslator(verbosityLM);}
   
@@ -139,6 +145,8 @@ public:
   void setlambdaLowerBound(double value) { lambdaLowerBound = value; }
   void setlambdaUpperBound(double value) { lambdaUpperBound = value; }
   void setUseFixedLambdaFactor(bool flag) { useFixedLambdaFactor = flag;}
+  void setUseLinearizationArena(bool flag) { useLinearizationArena = flag; }
+  void setErrorCacheEpsilon(double value) { errorCacheEpsilon = value; }
   void setLogFile(const std::string& s) { logFile = s; }
   void setVerbosityLM(const std::string& s) { verbosityLM = verbosityLMTranslator(s);}
   // @}
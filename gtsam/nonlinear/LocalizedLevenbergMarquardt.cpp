@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LocalizedLevenbergMarquardt.cpp
+ * @brief   Trust-region-localized Levenberg-Marquardt over an active subgraph
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/LocalizedLevenbergMarquardt.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+LocalizedLevenbergMarquardt::LocalizedLevenbergMarquardt(
+    const NonlinearFactorGraph& graph, const Values& initialValues,
+    const LocalizedLevenbergMarquardtParams& params) :
+    graph_(graph), values_(initialValues), params_(params), iterations_(0) {
+}
+
+/* ************************************************************************* */
+KeyVector LocalizedLevenbergMarquardt::activeKeys() const {
+  gttic(LocalizedLM_activeKeys);
+
+  // Rank factors by their current error contribution
+  vector<pair<double, size_t> > errors;
+  errors.reserve(graph_.size());
+  double totalError = 0.0;
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    if (!graph_[i])
+      continue;
+    const double error = graph_[i]->error(values_);
+    errors.push_back(make_pair(error, i));
+    totalError += error;
+  }
+  if (errors.empty())
+    return KeyVector();
+  const double seedThreshold = params_.seedErrorFactor * totalError
+      / double(errors.size());
+  sort(errors.begin(), errors.end(), std::greater<pair<double, size_t> >());
+
+  // Grow the active set from the high-error seeds, bounded by maxActiveKeys
+  KeySet active;
+  KeyVector result;
+  for (const pair<double, size_t>& entry : errors) {
+    if (entry.first <= seedThreshold)
+      break;
+    const NonlinearFactor& factor = *graph_[entry.second];
+    if (active.size() + factor.size() > params_.maxActiveKeys)
+      continue;
+    for (Key key : factor.keys()) {
+      if (active.insert(key).second)
+        result.push_back(key);
+    }
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph LocalizedLevenbergMarquardt::buildLocalGraph(
+    const KeyVector& activeKeys, Values* localValues) const {
+  gttic(LocalizedLM_buildLocalGraph);
+  const KeySet active(activeKeys.begin(), activeKeys.end());
+
+  NonlinearFactorGraph localGraph;
+  for (const NonlinearFactor::shared_ptr& factor : graph_) {
+    if (!factor)
+      continue;
+    size_t nrActive = 0;
+    for (Key key : factor->keys())
+      if (active.count(key))
+        ++nrActive;
+    if (nrActive == 0)
+      continue;
+    if (nrActive == factor->size()) {
+      // Interior factor: shared as-is
+      localGraph.push_back(factor);
+      continue;
+    }
+
+    // Straddling factor: linearize at the current estimate and condition on
+    // the boundary variables staying at their values - with zero boundary
+    // delta, dropping the boundary columns of the Jacobian is exact
+    GaussianFactor::shared_ptr linear = factor->linearize(values_);
+    const JacobianFactor jacobian(*linear);
+    vector<pair<Key, Matrix> > terms;
+    terms.reserve(nrActive);
+    for (JacobianFactor::const_iterator it = jacobian.begin();
+        it != jacobian.end(); ++it) {
+      if (active.count(*it))
+        terms.push_back(make_pair(*it, Matrix(jacobian.getA(it))));
+    }
+    const JacobianFactor conditioned(terms, Vector(jacobian.getb()),
+        jacobian.get_model());
+    localGraph.emplace_shared<LinearContainerFactor>(conditioned, values_);
+  }
+
+  if (localValues) {
+    localValues->clear();
+    for (Key key : activeKeys)
+      localValues->insert(key, values_.at(key));
+  }
+  return localGraph;
+}
+
+/* ************************************************************************* */
+size_t LocalizedLevenbergMarquardt::iterate() {
+  ++iterations_;
+  const bool scheduledGlobal = params_.globalInterval > 0
+      && iterations_ % params_.globalInterval == 0;
+
+  KeyVector active;
+  if (!scheduledGlobal)
+    active = activeKeys();
+
+  if (scheduledGlobal || active.empty()) {
+    // Global pass: a single full iteration
+    gttic(LocalizedLM_globalIterate);
+    LevenbergMarquardtOptimizer optimizer(graph_, values_, params_.lmParams);
+    optimizer.iterate();
+    values_ = optimizer.values();
+    return 0;
+  }
+
+  // Local pass: solve the bounded working copy to convergence against the
+  // frozen boundary, then write the active slice back
+  gttic(LocalizedLM_localIterate);
+  Values localValues;
+  const NonlinearFactorGraph localGraph = buildLocalGraph(active, &localValues);
+  LevenbergMarquardtOptimizer optimizer(localGraph, localValues,
+      params_.lmParams);
+  const Values result = optimizer.optimize();
+  for (Key key : active)
+    values_.update(key, result.at(key));
+  return active.size();
+}
+
+/* ************************************************************************* */
+
+}  // namespace gtsam
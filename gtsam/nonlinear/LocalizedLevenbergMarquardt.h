@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LocalizedLevenbergMarquardt.h
+ * @brief   Trust-region-localized Levenberg-Marquardt over an active subgraph
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+namespace gtsam {
+
+/** Parameters for LocalizedLevenbergMarquardt */
+struct GTSAM_EXPORT LocalizedLevenbergMarquardtParams {
+  /// Bound on the number of variables in the active working copy
+  size_t maxActiveKeys;
+
+  /// A factor seeds the active region when its error exceeds this multiple
+  /// of the mean factor error; below, the region counts as converged
+  double seedErrorFactor;
+
+  /// Run a full global iteration every this many calls to iterate()
+  /// (0 disables the periodic global pass)
+  size_t globalInterval;
+
+  /// Settings for the inner Levenberg-Marquardt loops
+  LevenbergMarquardtParams lmParams;
+
+  LocalizedLevenbergMarquardtParams() :
+      maxActiveKeys(100), seedErrorFactor(2.0), globalInterval(10) {
+  }
+};
+
+/**
+ * Levenberg-Marquardt restricted to the region of the graph that is actually
+ * changing.  On large maps most iterations of a full refinement spend their
+ * time re-solving regions that converged long ago; this driver ranks factors
+ * by their current error, grows an active key set (bounded by maxActiveKeys)
+ * from the high-error seeds, and optimizes only that subgraph.  Factors that
+ * straddle the boundary are linearized at the current estimate and
+ * conditioned on the boundary variables staying fixed - their boundary
+ * columns drop out of the Jacobian - then carried as LinearContainerFactor
+ * boundary priors, so the interior still feels the pull of the frozen
+ * surroundings.  Every globalInterval iterations a full global iteration
+ * runs to pick up long-range corrections the local steps cannot see.
+ */
+class GTSAM_EXPORT LocalizedLevenbergMarquardt {
+ public:
+  LocalizedLevenbergMarquardt(const NonlinearFactorGraph& graph,
+      const Values& initialValues,
+      const LocalizedLevenbergMarquardtParams& params =
+          LocalizedLevenbergMarquardtParams());
+
+  /// The current estimate
+  const Values& values() const { return values_; }
+
+  /// The current total error
+  double error() const { return graph_.error(values_); }
+
+  /// Number of iterate() calls so far
+  size_t iterations() const { return iterations_; }
+
+  /**
+   * Perform one optimization step: a local solve of the current active
+   * region, or a single global iteration when the schedule (or an empty
+   * active region) calls for one.
+   * @return the number of active keys optimized, 0 for a global iteration
+   */
+  size_t iterate();
+
+  /**
+   * The currently active keys: factors whose error exceeds seedErrorFactor
+   * times the mean contribute their keys, highest error first, until
+   * maxActiveKeys is reached.  Empty when no factor stands out.
+   */
+  KeyVector activeKeys() const;
+
+  /**
+   * Build the working copy for the given active keys: interior factors are
+   * shared as-is, straddling factors become conditioned boundary priors,
+   * and localValues receives the active slice of the current estimate.
+   */
+  NonlinearFactorGraph buildLocalGraph(const KeyVector& activeKeys,
+      Values* localValues) const;
+
+ private:
+  NonlinearFactorGraph graph_;
+  Values values_;
+  LocalizedLevenbergMarquardtParams params_;
+  size_t iterations_;
+};
+
+}  // namespace gtsam
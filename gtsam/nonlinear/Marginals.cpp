@@ -26,60 +26,89 @@ using namespace std;
 namespace gtsam {
 
 /* ************************************************************************* */
-Marginals::Marginals(const NonlinearFactorGraph& graph, const Values& solution, Factorization factorization)
-                     : values_(solution), factorization_(factorization) {
+Marginals::Marginals(const NonlinearFactorGraph& graph, const Values& solution, Factorization factorization,
+                     bool lazy)
+                     : values_(solution), factorization_(factorization), haveBayesTree_(false) {
   gttic(MarginalsConstructor);
   graph_ = *graph.linearize(solution);
-  computeBayesTree();
+  if(lazy)
+    ordering_ = Ordering::Colamd(graph_);
+  else
+    bayesTree();
 }
 
 /* ************************************************************************* */
 Marginals::Marginals(const NonlinearFactorGraph& graph, const Values& solution, const Ordering& ordering,
-                     Factorization factorization)
-                     : values_(solution), factorization_(factorization) {
+                     Factorization factorization, bool lazy)
+                     : values_(solution), factorization_(factorization), ordering_(ordering), haveBayesTree_(false) {
   gttic(MarginalsConstructor);
   graph_ = *graph.linearize(solution);
-  computeBayesTree(ordering);
+  if(!lazy)
+    bayesTree();
 }
 
 /* ************************************************************************* */
-Marginals::Marginals(const GaussianFactorGraph& graph, const Values& solution, Factorization factorization)
-                     : graph_(graph), values_(solution), factorization_(factorization) {
+Marginals::Marginals(const GaussianFactorGraph& graph, const Values& solution, Factorization factorization,
+                     bool lazy)
+                     : graph_(graph), values_(solution), factorization_(factorization), haveBayesTree_(false) {
   gttic(MarginalsConstructor);
-  computeBayesTree();
+  if(lazy)
+    ordering_ = Ordering::Colamd(graph_);
+  else
+    bayesTree();
 }
 
 /* ************************************************************************* */
 Marginals::Marginals(const GaussianFactorGraph& graph, const Values& solution, const Ordering& ordering,
-                     Factorization factorization)
-                     : graph_(graph), values_(solution), factorization_(factorization) {
+                     Factorization factorization, bool lazy)
+                     : graph_(graph), values_(solution), factorization_(factorization), ordering_(ordering),
+                       haveBayesTree_(false) {
   gttic(MarginalsConstructor);
-  computeBayesTree(ordering);
+  if(!lazy)
+    bayesTree();
 }
 
 /* ************************************************************************* */
-Marginals::Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, Factorization factorization)
-                     : graph_(graph), factorization_(factorization) {
+Marginals::Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, Factorization factorization,
+                     bool lazy)
+                     : graph_(graph), factorization_(factorization), haveBayesTree_(false) {
   gttic(MarginalsConstructor);
   for (const auto& keyValue: solution) {
     values_.insert(keyValue.first, keyValue.second);
   }
-  computeBayesTree();
+  if(lazy)
+    ordering_ = Ordering::Colamd(graph_);
+  else
+    bayesTree();
 }
 
 /* ************************************************************************* */
 Marginals::Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, const Ordering& ordering,
-                     Factorization factorization)
-                     : graph_(graph), factorization_(factorization) {
+                     Factorization factorization, bool lazy)
+                     : graph_(graph), factorization_(factorization), ordering_(ordering), haveBayesTree_(false) {
   gttic(MarginalsConstructor);
   for (const auto& keyValue: solution) {
     values_.insert(keyValue.first, keyValue.second);
   }
-  computeBayesTree(ordering);
+  if(!lazy)
+    bayesTree();
+}
+
+/* ************************************************************************* */
+const GaussianBayesTree& Marginals::bayesTree() const {
+  if(!haveBayesTree_) {
+    gttic(MarginalsLazyFactorization);
+    if(ordering_)
+      computeBayesTree(*ordering_);
+    else
+      computeBayesTree();
+    haveBayesTree_ = true;
+  }
+  return bayesTree_;
 }
 
 /* ************************************************************************* */
-void Marginals::computeBayesTree() {
+void Marginals::computeBayesTree() const {
   // Compute BayesTree
   if(factorization_ == CHOLESKY)
     bayesTree_ = *graph_.eliminateMultifrontal(EliminatePreferCholesky);
@@ -88,7 +117,7 @@ void Marginals::computeBayesTree() {
 }
 
 /* ************************************************************************* */
-void Marginals::computeBayesTree(const Ordering& ordering) {
+void Marginals::computeBayesTree(const Ordering& ordering) const {
   // Compute BayesTree
   if(factorization_ == CHOLESKY)
     bayesTree_ = *graph_.eliminateMultifrontal(ordering, EliminatePreferCholesky);
@@ -101,7 +130,7 @@ void Marginals::print(const std::string& str, const KeyFormatter& keyFormatter)
 {
   graph_.print(str+"Graph: ");
   values_.print(str+"Solution: ", keyFormatter);
-  bayesTree_.print(str+"Bayes Tree: ");
+  bayesTree().print(str+"Bayes Tree: ");
 }
 
 /* ************************************************************************* */
@@ -110,9 +139,9 @@ GaussianFactor::shared_ptr Marginals::marginalFactor(Key variable) const {
 
   // Compute marginal factor
   if(factorization_ == CHOLESKY)
-    return bayesTree_.marginalFactor(variable, EliminatePreferCholesky);
+    return bayesTree().marginalFactor(variable, EliminatePreferCholesky);
   else if(factorization_ == QR)
-    return bayesTree_.marginalFactor(variable, EliminateQR);
+    return bayesTree().marginalFactor(variable, EliminateQR);
   else
     throw std::runtime_error("Marginals::marginalFactor: Unknown factorization");
 }
@@ -130,6 +159,38 @@ Matrix Marginals::marginalCovariance(Key variable) const {
   return marginalInformation(variable).inverse();
 }
 
+/* ************************************************************************* */
+std::map<Key, Matrix> Marginals::marginalCovariances(
+    const KeyVector& variables) const {
+  gttic(marginalCovariances);
+
+  const GaussianFactorGraph::Eliminate function =
+      factorization_ == CHOLESKY
+          ? GaussianFactorGraph::Eliminate(EliminatePreferCholesky)
+          : GaussianFactorGraph::Eliminate(EliminateQR);
+
+  // Group the requested keys by clique, so the clique marginal P(C) is
+  // computed once per clique instead of once per key
+  typedef GaussianBayesTree::sharedClique sharedClique;
+  FastMap<sharedClique, KeyVector> keysByClique;
+  for (Key variable : variables)
+    keysByClique[bayesTree().clique(variable)].push_back(variable);
+
+  std::map<Key, Matrix> result;
+  for (const auto& clique_keys : keysByClique) {
+    // The separator marginals cached in the tree share the top-down ancestor
+    // work between the cliques in this loop
+    const GaussianFactorGraph cliqueMarginal =
+        clique_keys.first->marginal2(function);
+    for (Key variable : clique_keys.second) {
+      const auto marginalBN = cliqueMarginal.marginalMultifrontalBayesNet(
+          Ordering(KeyVector{variable}), function);
+      result.emplace(variable, marginalBN->front()->information().inverse());
+    }
+  }
+  return result;
+}
+
 /* ************************************************************************* */
 JointMarginal Marginals::jointMarginalCovariance(const KeyVector& variables) const {
   JointMarginal info = jointMarginalInformation(variables);
@@ -155,9 +216,9 @@ JointMarginal Marginals::jointMarginalInformation(const KeyVector& variables) co
     GaussianFactorGraph jointFG;
     if(variables.size() == 2) {
       if(factorization_ == CHOLESKY)
-        jointFG = *bayesTree_.joint(variables[0], variables[1], EliminatePreferCholesky);
+        jointFG = *bayesTree().joint(variables[0], variables[1], EliminatePreferCholesky);
       else if(factorization_ == QR)
-        jointFG = *bayesTree_.joint(variables[0], variables[1], EliminateQR);
+        jointFG = *bayesTree().joint(variables[0], variables[1], EliminateQR);
     } else {
       if(factorization_ == CHOLESKY)
         jointFG = GaussianFactorGraph(*graph_.marginalMultifrontalBayesTree(variables, EliminatePreferCholesky));
@@ -186,7 +247,7 @@ JointMarginal Marginals::jointMarginalInformation(const KeyVector& variables) co
 
 /* ************************************************************************* */
 VectorValues Marginals::optimize() const {
-  return bayesTree_.optimize();
+  return bayesTree().optimize();
 }
 
 /* ************************************************************************* */
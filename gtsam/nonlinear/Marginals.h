@@ -22,6 +22,10 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 
+#include <boost/optional.hpp>
+
+#include <map>
+
 namespace gtsam {
 
 class JointMarginal;
@@ -44,61 +48,71 @@ protected:
   GaussianFactorGraph graph_;
   Values values_;
   Factorization factorization_;
-  GaussianBayesTree bayesTree_;
+  boost::optional<Ordering> ordering_;
+  mutable GaussianBayesTree bayesTree_;
+  mutable bool haveBayesTree_;
 
 public:
 
   /// Default constructor only for Cython wrapper
-  Marginals(){}
+  Marginals() : haveBayesTree_(false) {}
 
   /** Construct a marginals class from a nonlinear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The linearization point about which to compute Gaussian marginals (usually the MLE as obtained from a NonlinearOptimizer).
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
    */
-  Marginals(const NonlinearFactorGraph& graph, const Values& solution, Factorization factorization = CHOLESKY);
+  Marginals(const NonlinearFactorGraph& graph, const Values& solution, Factorization factorization = CHOLESKY,
+              bool lazy = false);
 
   /** Construct a marginals class from a nonlinear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The linearization point about which to compute Gaussian marginals (usually the MLE as obtained from a NonlinearOptimizer).
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
    * @param ordering The ordering for elimination.
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
    */
   Marginals(const NonlinearFactorGraph& graph, const Values& solution, const Ordering& ordering,
-              Factorization factorization = CHOLESKY);
+              Factorization factorization = CHOLESKY, bool lazy = false);
 
   /** Construct a marginals class from a linear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The solution point to compute Gaussian marginals.
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
-   */          
-  Marginals(const GaussianFactorGraph& graph, const Values& solution, Factorization factorization = CHOLESKY);
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
+   */
+  Marginals(const GaussianFactorGraph& graph, const Values& solution, Factorization factorization = CHOLESKY,
+              bool lazy = false);
 
   /** Construct a marginals class from a linear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The solution point to compute Gaussian marginals.
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
    * @param ordering The ordering for elimination.
-   */          
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
+   */
   Marginals(const GaussianFactorGraph& graph, const Values& solution, const Ordering& ordering,
-              Factorization factorization = CHOLESKY);
+              Factorization factorization = CHOLESKY, bool lazy = false);
 
   /** Construct a marginals class from a linear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The solution point to compute Gaussian marginals.
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
-   * @param ordering An optional variable ordering for elimination.
-   */          
-  Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, Factorization factorization = CHOLESKY);
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
+   */
+  Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, Factorization factorization = CHOLESKY,
+              bool lazy = false);
 
   /** Construct a marginals class from a linear factor graph.
    * @param graph The factor graph defining the full joint density on all variables.
    * @param solution The solution point to compute Gaussian marginals.
    * @param factorization The linear decomposition mode - either Marginals::CHOLESKY (faster and suitable for most problems) or Marginals::QR (slower but more numerically stable for poorly-conditioned problems).
-   * @param ordering An optional variable ordering for elimination.
-   */          
+   * @param ordering The ordering for elimination.
+   * @param lazy If true, the constructor only performs the symbolic analysis (variable ordering) and the numeric factorization is deferred until the first marginal query.
+   */
   Marginals(const GaussianFactorGraph& graph, const VectorValues& solution, const Ordering& ordering,
-              Factorization factorization = CHOLESKY);
+              Factorization factorization = CHOLESKY, bool lazy = false);
 
   /** print */
   void print(const std::string& str = "Marginals: ", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
@@ -113,6 +127,13 @@ public:
   /** Compute the marginal covariance of a single variable */
   Matrix marginalCovariance(Key variable) const;
 
+  /** Compute the marginal covariances of many variables in bulk.  The
+   * requested keys are grouped by clique so each clique marginal is computed
+   * once and marginalized to every requested variable in it, and the cached
+   * separator marginals share the ancestor work between cliques.  Much faster
+   * than calling marginalCovariance per key for large batches. */
+  std::map<Key, Matrix> marginalCovariances(const KeyVector& variables) const;
+
   /** Compute the joint marginal covariance of several variables */
   JointMarginal jointMarginalCovariance(const KeyVector& variables) const;
 
@@ -123,12 +144,17 @@ public:
   VectorValues optimize() const;
             
 protected:
-  
+
+  /** Return the Bayes Tree, computing it on first use when the factorization was deferred.
+   * Repeated queries reuse the separator marginals cached in the tree, so after the first
+   * query each additional variable only costs the work along its clique chain to the root. */
+  const GaussianBayesTree& bayesTree() const;
+
   /** Compute the Bayes Tree as a helper function to the constructor */
-  void computeBayesTree();
+  void computeBayesTree() const;
 
   /** Compute the Bayes Tree as a helper function to the constructor */
-  void computeBayesTree(const Ordering& ordering);
+  void computeBayesTree(const Ordering& ordering) const;
 
 public:
   /** \deprecated argument order changed due to removing boost::optional<Ordering> */
@@ -61,6 +61,12 @@ NonlinearConjugateGradientOptimizer::System::State NonlinearConjugateGradientOpt
   return current.retract(step);
 }
 
+std::vector<double> NonlinearConjugateGradientOptimizer::System::errors(
+    const State &state, const Gradient &g,
+    const std::vector<double> &steps) const {
+  return graph_.errorAlongDirection(state, g, steps);
+}
+
 GaussianFactorGraph::shared_ptr NonlinearConjugateGradientOptimizer::iterate() {
   Values newValues;
   int dummy;
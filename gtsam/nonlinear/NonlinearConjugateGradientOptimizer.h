@@ -45,6 +45,12 @@ class GTSAM_EXPORT NonlinearConjugateGradientOptimizer : public NonlinearOptimiz
     Gradient gradient(const State &state) const;
     State advance(const State &current, const double alpha,
         const Gradient &g) const;
+    /** Batched error at several step lengths along one direction,
+     *  equivalent to error(advance(state, steps[k], g)) for each k but
+     *  sharing the per-factor setup across all trial points, see
+     *  NonlinearFactorGraph::errorAlongDirection. */
+    std::vector<double> errors(const State &state, const Gradient &g,
+        const std::vector<double> &steps) const;
   };
 
 public:
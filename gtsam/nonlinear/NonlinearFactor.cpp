@@ -17,9 +17,13 @@
  */
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/base/MemoryArena.h>
 #include <boost/make_shared.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -86,6 +90,33 @@ static void check(const SharedNoiseModel& noiseModel, size_t m) {
                 % noiseModel->dim() % m));
 }
 
+/* ************************************************************************* */
+void NoiseModelFactor::Workspace::prepare(const NoiseModelFactor& factor,
+    const Values& x) {
+  const size_t m = factor.dim();
+  error.resize(m);
+  jacobians.resize(factor.size());
+  for (size_t j = 0; j < factor.size(); ++j)
+    jacobians[j].resize(m, x.at(factor.keys()[j]).dim());
+}
+
+/* ************************************************************************* */
+void NoiseModelFactor::unwhitenedErrorInPlace(const Values& x,
+    Workspace& workspace) const {
+  // The virtual unwhitenedError fills the prepared Jacobians without
+  // resizing them; only the returned error vector is still a temporary.
+  workspace.error = unwhitenedError(x, workspace.jacobians);
+}
+
+/* ************************************************************************* */
+void NoiseModelFactor::whitenedErrorInPlace(const Values& c,
+    Workspace& workspace) const {
+  unwhitenedErrorInPlace(c, workspace);
+  check(noiseModel_, workspace.error.size());
+  if (noiseModel_)
+    noiseModel_->whitenInPlace(workspace.error);
+}
+
 /* ************************************************************************* */
 Vector NoiseModelFactor::whitenedError(const Values& c) const {
   const Vector b = unwhitenedError(c);
@@ -163,6 +194,93 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
 }
 
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
+    const Values& x, MemoryArena& arena) const {
+
+  // Only linearize if the factor is active
+  if (!active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  // Call evaluate error to get Jacobians and RHS vector b
+  std::vector<Matrix> A(size());
+  Vector b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  // Fill in terms, needed to create JacobianFactor below
+  std::vector<std::pair<Key, Matrix> > terms(size());
+  for (size_t j = 0; j < size(); ++j) {
+    terms[j].first = keys()[j];
+    terms[j].second.swap(A[j]);
+  }
+
+  // As in linearize(x) above, but allocate_shared places the JacobianFactor
+  // and its control block in the arena with a single bump allocation
+  ArenaAllocator<JacobianFactor> allocator(arena);
+  using noiseModel::Constrained;
+  if (noiseModel_ && noiseModel_->isConstrained())
+    return boost::allocate_shared<JacobianFactor>(allocator, terms, b,
+        boost::static_pointer_cast<Constrained>(noiseModel_)->unit());
+  else
+    return boost::allocate_shared<JacobianFactor>(allocator, terms, b);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
+    const Values& x, const std::vector<bool>& requested) const {
+
+  if (requested.size() != size())
+    throw std::invalid_argument(
+        "NoiseModelFactor::linearize: Jacobian request mask size does not "
+        "match the number of keys");
+  const size_t nrRequested = std::count(requested.begin(), requested.end(),
+      true);
+  if (nrRequested == 0)
+    throw std::invalid_argument(
+        "NoiseModelFactor::linearize: Jacobian request mask is empty");
+
+  // Only linearize if the factor is active
+  if (!active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  // Only the requested Jacobians are computed; the other slots stay empty
+  std::vector<Matrix> A(size());
+  Vector b = -unwhitenedError(x, requested, A);
+  check(noiseModel_, b.size());
+
+  // Whiten the RHS and the requested blocks; the empty slots must be skipped
+  // as WhitenSystem would choke on their dimensions
+  if (noiseModel_) {
+    b = noiseModel_->whiten(b);
+    for (size_t j = 0; j < size(); ++j)
+      if (requested[j])
+        A[j] = noiseModel_->Whiten(A[j]);
+  }
+
+  // Fill in terms for the requested keys only: the omitted variables are
+  // conditioned on staying at their linearization point
+  std::vector<std::pair<Key, Matrix> > terms;
+  terms.reserve(nrRequested);
+  for (size_t j = 0; j < size(); ++j) {
+    if (!requested[j])
+      continue;
+    terms.push_back(std::make_pair(keys()[j], Matrix()));
+    terms.back().second.swap(A[j]);
+  }
+
+  using noiseModel::Constrained;
+  if (noiseModel_ && noiseModel_->isConstrained())
+    return GaussianFactor::shared_ptr(
+        new JacobianFactor(terms, b,
+            boost::static_pointer_cast<Constrained>(noiseModel_)->unit()));
+  else
+    return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
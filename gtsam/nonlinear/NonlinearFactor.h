@@ -38,6 +38,8 @@
 
 namespace gtsam {
 
+class MemoryArena; // forward declaration, see gtsam/base/MemoryArena.h
+
 using boost::assign::cref_list_of;
 
 /* ************************************************************************* */
@@ -116,6 +118,18 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * linearize to a GaussianFactor allocated from the given memory arena,
+   * for callers that discard the linearization in bulk (e.g. once per
+   * optimizer iteration).  The default implementation ignores the arena and
+   * simply forwards to linearize(c); derived factors may override to place
+   * the linearized factor in the arena.
+   */
+  virtual boost::shared_ptr<GaussianFactor>
+  linearize(const Values& c, MemoryArena& /*arena*/) const {
+    return linearize(c);
+  }
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -220,6 +234,48 @@ public:
   virtual Vector unwhitenedError(const Values& x,
       boost::optional<std::vector<Matrix>&> H = boost::none) const = 0;
 
+  /**
+   * Variant of unwhitenedError that only computes the Jacobian blocks whose
+   * entry in \c requested is true; requested[j] corresponds to keys()[j], and
+   * blocks that are not requested are left untouched.  Callers like partial
+   * relinearization, which only consume the blocks of changed variables, use
+   * this to skip the derivative work they will throw away.  The default
+   * implementation simply computes every Jacobian; NoiseModelFactor1 through
+   * NoiseModelFactor6 override it to pass boost::none to evaluateError for
+   * the slots that were not requested.
+   */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    boost::optional<std::vector<Matrix>&> optionalH(H);
+    return unwhitenedError(x, optionalH);
+  }
+
+  /**
+   * Fixed-capacity buffers for the in-place error path below.  Call prepare()
+   * once at graph-preparation time to size the buffers for a factor; repeated
+   * evaluations into a prepared workspace then reuse the Jacobian storage,
+   * as Eigen resizes are no-ops when the dimensions already match.
+   */
+  struct Workspace {
+    Vector error; ///< error vector, dim() rows
+    std::vector<Matrix> jacobians; ///< one dim() x n_j Jacobian per variable
+    /// Size the buffers for the given factor, looking up variable dimensions in x
+    void prepare(const NoiseModelFactor& factor, const Values& x);
+  };
+
+  /**
+   * In-place variant of unwhitenedError: writes the error and the Jacobians
+   * into the caller-provided workspace instead of allocating fresh Jacobian
+   * matrices on every call.  The workspace must have been prepared for this
+   * factor (or a factor of identical dimensions).
+   */
+  void unwhitenedErrorInPlace(const Values& x, Workspace& workspace) const;
+
+  /**
+   * In-place variant of whitenedError, whitening workspace.error directly.
+   */
+  void whitenedErrorInPlace(const Values& c, Workspace& workspace) const;
+
   /**
    * Vector of errors, whitened
    * This is the raw error, i.e., i.e. \f$ (h(x)-z)/\sigma \f$ in case of a Gaussian
@@ -251,6 +307,38 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Linearize as above, but allocate the resulting JacobianFactor (object and
+   * shared_ptr control block) from the given memory arena.  The Jacobian
+   * matrix storage itself still lives on the heap and is released when the
+   * factor is destroyed.
+   */
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x,
+      MemoryArena& arena) const override;
+
+  /**
+   * Linearize computing only the Jacobian blocks whose entry in \c requested
+   * is true; requested[j] corresponds to keys()[j], and at least one entry
+   * must be set.  The returned JacobianFactor only involves the requested
+   * keys: the omitted variables are held at their linearization point, which
+   * is exactly the conditioned factor a partial update solves with.
+   */
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x,
+      const std::vector<bool>& requested) const;
+
+protected:
+
+  /// Wrap H[j] as an optional reference if requested[j], boost::none otherwise
+  static boost::optional<Matrix&> requestedJacobian(
+      const std::vector<bool>& requested, std::vector<Matrix>& H, size_t j) {
+    if (requested[j])
+      return boost::optional<Matrix&>(H[j]);
+    else
+      return boost::none;
+  }
+
+public:
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -328,6 +416,17 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobian if requested[0] is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      const X& x1 = x.at<X>(keys_[0]);
+      return evaluateError(x1, requestedJacobian(requested, H, 0));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a unary factor.
    *  If the optional Matrix reference argument is specified, it should compute
@@ -403,6 +502,19 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobians whose entry in requested is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      const X1& x1 = x.at<X1>(keys_[0]);
+      const X2& x2 = x.at<X2>(keys_[1]);
+      return evaluateError(x1, x2, requestedJacobian(requested, H, 0),
+          requestedJacobian(requested, H, 1));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a binary factor.
    *  If any of the optional Matrix reference arguments are specified, it should compute
@@ -478,6 +590,18 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobians whose entry in requested is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]),
+          requestedJacobian(requested, H, 0), requestedJacobian(requested, H, 1),
+          requestedJacobian(requested, H, 2));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a trinary factor.
    *  If any of the optional Matrix reference arguments are specified, it should compute
@@ -558,6 +682,18 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobians whose entry in requested is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]),
+          requestedJacobian(requested, H, 0), requestedJacobian(requested, H, 1),
+          requestedJacobian(requested, H, 2), requestedJacobian(requested, H, 3));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a 4-way factor.
    *  If any of the optional Matrix reference arguments are specified, it should compute
@@ -642,6 +778,19 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobians whose entry in requested is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]),
+          requestedJacobian(requested, H, 0), requestedJacobian(requested, H, 1),
+          requestedJacobian(requested, H, 2), requestedJacobian(requested, H, 3),
+          requestedJacobian(requested, H, 4));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a 5-way factor.
    *  If any of the optional Matrix reference arguments are specified, it should compute
@@ -730,6 +879,19 @@ public:
     }
   }
 
+  /** As above, but only computing the Jacobians whose entry in requested is set. */
+  virtual Vector unwhitenedError(const Values& x,
+      const std::vector<bool>& requested, std::vector<Matrix>& H) const {
+    if(this->active(x)) {
+      return evaluateError(x.at<X1>(keys_[0]), x.at<X2>(keys_[1]), x.at<X3>(keys_[2]), x.at<X4>(keys_[3]), x.at<X5>(keys_[4]), x.at<X6>(keys_[5]),
+          requestedJacobian(requested, H, 0), requestedJacobian(requested, H, 1),
+          requestedJacobian(requested, H, 2), requestedJacobian(requested, H, 3),
+          requestedJacobian(requested, H, 4), requestedJacobian(requested, H, 5));
+    } else {
+      return Vector::Zero(this->dim());
+    }
+  }
+
   /**
    *  Override this method to finish implementing a 6-way factor.
    *  If any of the optional Matrix reference arguments are specified, it should compute
@@ -22,6 +22,7 @@
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/base/MemoryArena.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/linear/VectorValues.h>
@@ -31,10 +32,13 @@
 
 #ifdef GTSAM_USE_TBB
 #  include <tbb/parallel_for.h>
+#  include <tbb/parallel_reduce.h>
+#  include <tbb/task_scheduler_init.h>
 #endif
 
 #include <cmath>
 #include <limits>
+#include <typeindex>
 
 using namespace std;
 
@@ -43,6 +47,9 @@ namespace gtsam {
 // Instantiate base classes
 template class FactorGraph<NonlinearFactor>;
 
+// See documentation in NonlinearFactorGraph.h
+bool deterministicParallelism = false;
+
 /* ************************************************************************* */
 double NonlinearFactorGraph::probPrime(const Values& values) const {
   return exp(-0.5 * error(values));
@@ -242,9 +249,61 @@ void NonlinearFactorGraph::saveGraph(std::ostream &stm, const Values& values,
   stm << "}\n";
 }
 
+/* ************************************************************************* */
+namespace {
+
+#ifdef GTSAM_USE_TBB
+// Reduction body summing factor errors over a range of the factor vector
+class _FactorErrorBody {
+  const NonlinearFactorGraph& graph_;
+  const Values& values_;
+public:
+  double sum;
+  _FactorErrorBody(const NonlinearFactorGraph& graph, const Values& values) :
+      graph_(graph), values_(values), sum(0.0) {
+  }
+  _FactorErrorBody(_FactorErrorBody& other, tbb::split) :
+      graph_(other.graph_), values_(other.values_), sum(0.0) {
+  }
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) {
+    for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i)
+      if (graph_[i])
+        sum += graph_[i]->error(values_);
+  }
+  void join(const _FactorErrorBody& other) {
+    sum += other.sum;
+  }
+};
+
+// Error evaluation is much cheaper per factor than linearization, so use
+// larger chunks than the linearize loop; over-decompose only mildly.
+// In deterministic mode the tile size must not depend on the worker count,
+// since the tiling fixes the shape of the reduction tree.
+inline size_t errorGrainSize(size_t numFactors) {
+  if (deterministicParallelism) return 64;
+  const size_t numThreads = tbb::task_scheduler_init::default_num_threads();
+  size_t grain = numFactors / (4 * numThreads);
+  if (grain < 1) grain = 1;
+  return grain;
+}
+#endif
+
+}
+
 /* ************************************************************************* */
 double NonlinearFactorGraph::error(const Values& values) const {
   gttic(NonlinearFactorGraph_error);
+#ifdef GTSAM_USE_TBB
+  // parallel_deterministic_reduce always splits down to the grain size and
+  // joins the partial sums in a fixed tree, so the floating-point summation
+  // order - and hence LM step acceptance - is reproducible across runs and
+  // thread counts, unlike parallel_reduce with an auto partitioner.
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  _FactorErrorBody body(*this, values);
+  tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<size_t>(0, size(), errorGrainSize(size())), body);
+  return body.sum;
+#else
   double total_error = 0.;
   // iterate over all the factors_ to accumulate the log probabilities
   for(const sharedFactor& factor: factors_) {
@@ -252,6 +311,34 @@ double NonlinearFactorGraph::error(const Values& values) const {
       total_error += factor->error(values);
   }
   return total_error;
+#endif
+}
+
+/* ************************************************************************* */
+std::vector<double> NonlinearFactorGraph::errorAlongDirection(
+    const Values& values, const VectorValues& direction,
+    const std::vector<double>& steps) const {
+  gttic(NonlinearFactorGraph_errorAlongDirection);
+
+  // Materialize every trial point up front
+  std::vector<Values> trials;
+  trials.reserve(steps.size());
+  for (double step : steps) {
+    VectorValues delta = direction;
+    delta *= step;
+    trials.push_back(values.retract(delta));
+  }
+
+  // Factor-major accumulation: each factor is fetched once and evaluated at
+  // all trial points while its data is hot
+  std::vector<double> errors(steps.size(), 0.0);
+  for (const sharedFactor& factor : factors_) {
+    if (!factor)
+      continue;
+    for (size_t k = 0; k < trials.size(); ++k)
+      errors[k] += factor->error(trials[k]);
+  }
+  return errors;
 }
 
 /* ************************************************************************* */
@@ -307,6 +394,23 @@ public:
     }
   }
 };
+
+/* ************************************************************************* */
+// Pick a grain size for parallel linearization: chunks small enough to
+// load-balance heterogeneous factors over all workers, but large enough that
+// each worker stays on a cache-friendly contiguous range of the factor vector
+// instead of ping-ponging single factors through the scheduler.
+inline size_t linearizeGrainSize(size_t numFactors) {
+  // Linearize results go into per-factor slots, so values are reproducible
+  // regardless of tiling; fix the tile size anyway for stable task ordering
+  if (deterministicParallelism) return 16;
+  const size_t numThreads = tbb::task_scheduler_init::default_num_threads();
+  const size_t chunksPerThread = 8; // over-decompose for load balancing
+  size_t grain = numFactors / (chunksPerThread * numThreads);
+  if (grain < 1) grain = 1;
+  if (grain > 128) grain = 128; // keep chunks within L1/L2 working-set size
+  return grain;
+}
 #endif
 
 }
@@ -316,14 +420,21 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
 {
   gttic(NonlinearFactorGraph_linearize);
 
+  // Build the contiguous lookup index once, so the per-key at() calls inside
+  // every factor run against a flat array instead of the value tree
+  linearizationPoint.prepare();
+
   // create an empty linear FG
   GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
 
 #ifdef GTSAM_USE_TBB
 
+  // Each worker linearizes a contiguous chunk of factors straight into its
+  // preallocated slots in the output vector, so results are "spliced" by
+  // construction and no lock or post-hoc merge is needed.
   linearFG->resize(size());
   TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size(), linearizeGrainSize(size())),
     _LinearizeOneFactor(*this, linearizationPoint, *linearFG));
 
 #else
@@ -343,6 +454,105 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+NonlinearFactorGraph::TypeGroups NonlinearFactorGraph::groupByType() const {
+  gttic(NonlinearFactorGraph_groupByType);
+
+  // Bucket the factor indices per concrete type, groups in order of first
+  // appearance and original order within each group; null slots are simply
+  // left out, they need no linearize call
+  FastMap<std::type_index, size_t> groupOf;
+  FastVector<FastVector<size_t> > buckets;
+  for (size_t i = 0; i < size(); ++i) {
+    if (!factors_[i]) continue;
+    const std::type_index type(typeid(*factors_[i]));
+    const auto inserted = groupOf.insert(std::make_pair(type, buckets.size()));
+    if (inserted.second)
+      buckets.push_back(FastVector<size_t>());
+    buckets[inserted.first->second].push_back(i);
+  }
+
+  // Flatten into one permutation plus per-group ranges
+  TypeGroups result;
+  result.order.reserve(size());
+  result.groups.reserve(buckets.size());
+  for (const FastVector<size_t>& bucket : buckets) {
+    const size_t begin = result.order.size();
+    result.order.insert(result.order.end(), bucket.begin(), bucket.end());
+    result.groups.push_back(std::make_pair(begin, result.order.size()));
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(
+    const Values& linearizationPoint, const TypeGroups& groups) const {
+  gttic(NonlinearFactorGraph_linearize_grouped);
+
+  // see linearize() above
+  linearizationPoint.prepare();
+
+  // Null slots stay default-constructed, matching plain linearize()
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(size());
+
+  const FastVector<size_t>& order = groups.order;
+
+#ifdef GTSAM_USE_TBB
+
+  // Chunks are taken from the permuted order, so each worker's tight loop
+  // stays within one type group except at the seams
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, order.size(), linearizeGrainSize(order.size())),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t pos = range.begin(); pos != range.end(); ++pos) {
+        const size_t i = order[pos];
+        (*linearFG)[i] = factors_[i]->linearize(linearizationPoint);
+      }
+    });
+
+#else
+
+  // One tight loop per concrete type: the virtual call target is the same
+  // for the whole group
+  for (const std::pair<size_t, size_t>& group : groups.groups) {
+    for (size_t pos = group.first; pos != group.second; ++pos) {
+      const size_t i = order[pos];
+      (*linearFG)[i] = factors_[i]->linearize(linearizationPoint);
+    }
+  }
+
+#endif
+
+  return linearFG;
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(
+    const Values& linearizationPoint, MemoryArena& arena) const
+{
+  gttic(NonlinearFactorGraph_linearize_arena);
+
+  // see linearize() above
+  linearizationPoint.prepare();
+
+  // The graph object itself is heap-allocated (a single allocation); the
+  // per-factor objects and control blocks come from the arena
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->reserve(size());
+
+  // linearize all factors sequentially; the arena bump allocator is not
+  // thread-safe, so this path deliberately avoids the TBB parallel loop
+  for(const sharedFactor& factor: factors_) {
+    if(factor) {
+      (*linearFG) += factor->linearize(linearizationPoint, arena);
+    } else
+    (*linearFG) += GaussianFactor::shared_ptr();
+  }
+
+  return linearFG;
+}
+
 /* ************************************************************************* */
 static Scatter scatterFromValues(const Values& values) {
   gttic(scatterFromValues);
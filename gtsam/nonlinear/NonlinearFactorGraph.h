@@ -66,6 +66,19 @@ namespace gtsam {
   };
 
 
+  /**
+   * When true, the parallel (TBB) paths of NonlinearFactorGraph::error and
+   * NonlinearFactorGraph::linearize use a fixed tile size instead of one
+   * derived from the machine's worker count, so the work decomposition - and
+   * with it the fixed-tree summation order of error() - is identical across
+   * runs, thread counts, and machines, giving bitwise-reproducible results at
+   * some load-balancing cost (default: false). The parallel multifrontal
+   * elimination is deterministic either way: every tree node writes its
+   * result into its own slot and parents combine children in structural
+   * order. Without TBB this flag has no effect.
+   */
+  GTSAM_EXPORT extern bool deterministicParallelism;
+
   /**
    * A non-linear factor graph is a graph of non-Gaussian, i.e. non-linear factors,
    * which derive from NonlinearFactor. The values structures are typically (in SAM) more general
@@ -113,12 +126,27 @@ namespace gtsam {
       const GraphvizFormatting& graphvizFormatting = GraphvizFormatting(),
       const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
 
-    /** unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case */
+    /** unnormalized error, \f$ 0.5 \sum_i (h_i(X_i)-z)^2/\sigma^2 \f$ in the most common case.
+     * With TBB enabled the factor errors are summed with a deterministic
+     * parallel reduction, so the result is reproducible across runs. */
     double error(const Values& values) const;
 
     /** Unnormalized probability. O(n) */
     double probPrime(const Values& values) const;
 
+    /**
+     * Evaluate the graph error at several trial points along one search
+     * direction: trial k is values.retract(steps[k] * direction).  All trial
+     * points are materialized up front and the factors are then visited in a
+     * single factor-major pass, so each factor's keys and measurement data
+     * are fetched once and reused for every step length instead of once per
+     * k - the dominant shared work of multi-point line search (see
+     * NonlinearConjugateGradientOptimizer).
+     * @return the k errors, in the order of \c steps
+     */
+    std::vector<double> errorAlongDirection(const Values& values,
+        const VectorValues& direction, const std::vector<double>& steps) const;
+
     /**
      * Create a symbolic factor graph
      */
@@ -142,6 +170,45 @@ namespace gtsam {
     /// Linearize a nonlinear factor graph
     boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * A precomputed type-grouped execution order for linearize().  Real
+     * graphs are dominated by a handful of concrete factor types, but the
+     * factor vector interleaves them, so the virtual linearize call in the
+     * hot loop changes target almost every iteration.  Grouping the indices
+     * by concrete type makes each group's loop hit a single virtual target:
+     * the indirect branch predicts perfectly and that type's linearize code
+     * stays resident in the instruction cache for the whole run.  Build once
+     * at graph-prep time and reuse while the factor layout is unchanged.
+     */
+    struct GTSAM_EXPORT TypeGroups {
+      /// Factor indices permuted so same-type factors are contiguous,
+      /// groups in order of first appearance, original order within a group
+      FastVector<size_t> order;
+      /// One [begin, end) range into \c order per concrete type
+      FastVector<std::pair<size_t, size_t> > groups;
+    };
+
+    /// Group the factor indices by concrete type (typeid)
+    TypeGroups groupByType() const;
+
+    /**
+     * Linearize in the given type-grouped order.  The returned graph has the
+     * same per-index layout as linearize(const Values&); only the execution
+     * order differs.
+     */
+    boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint,
+        const TypeGroups& groups) const;
+
+    /**
+     * Linearize a nonlinear factor graph, allocating the linearized factors
+     * from the given memory arena.  Intended for callers that discard the
+     * whole linear graph at once (one optimizer iteration), after which the
+     * arena can be reclaimed in O(1) with MemoryArena::reset().  The returned
+     * graph and its factors must not outlive the next reset of the arena.
+     */
+    boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint,
+        MemoryArena& arena) const;
+
     /// typdef for dampen functions used below
     typedef std::function<void(const boost::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
 
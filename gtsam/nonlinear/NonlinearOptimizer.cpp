@@ -22,6 +22,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/SparseEigenSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -31,6 +32,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <stdexcept>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 
@@ -66,6 +68,14 @@ void NonlinearOptimizer::defaultOptimize() {
   const NonlinearOptimizerParams& params = _params();
   double currentError = error();
 
+  // Wall clock for the optional time budget and the quality hook
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point startTime = Clock::now();
+  auto elapsed = [startTime]() {
+    return std::chrono::duration<double>(Clock::now() - startTime).count();
+  };
+  double lastIterationTime = 0.0; // seconds spent in the most recent iteration
+
   // check if we're already close enough
   if (currentError <= params.errorTol) {
     if (params.verbosity >= NonlinearOptimizerParams::ERROR)
@@ -91,14 +101,46 @@ void NonlinearOptimizer::defaultOptimize() {
   do {
     // Do next iteration
     currentError = error();
+    Values previousValues;
+    if (params.iterationQualityHook)
+      previousValues = values();
+    const double iterationStart = elapsed();
     iterate();
     tictoc_finishedIteration();
+    lastIterationTime = elapsed() - iterationStart;
 
     // Maybe show output
     if (params.verbosity >= NonlinearOptimizerParams::VALUES)
       values().print("newValues");
     if (params.verbosity >= NonlinearOptimizerParams::ERROR)
       cout << "newError: " << error() << endl;
+
+    // Stream per-iteration quality metrics to the consumer
+    if (params.iterationQualityHook) {
+      NonlinearOptimizerParams::IterationQuality quality;
+      quality.iteration = iterations();
+      quality.error = error();
+      quality.errorDecrease = currentError - error();
+      quality.maxDeltaNorm = 0.0;
+      const VectorValues delta = previousValues.localCoordinates(values());
+      for (const VectorValues::KeyValuePair& key_delta : delta)
+        quality.maxDeltaNorm = std::max(quality.maxDeltaNorm,
+            key_delta.second.norm());
+      quality.elapsed = elapsed();
+      params.iterationQualityHook(quality);
+    }
+
+    // Deadline-based termination: stop once the budget is spent, and do not
+    // start an iteration that the duration of the previous one suggests
+    // would overshoot it.  The state after iterate() is always a consistent
+    // estimate, so we return the best estimate completed within the budget.
+    if (params.timeBudget > 0.0
+        && elapsed() + lastIterationTime > params.timeBudget) {
+      if (params.verbosity >= NonlinearOptimizerParams::TERMINATION)
+        cout << "Terminating because time budget of " << params.timeBudget
+             << "s is spent after " << iterations() << " iterations" << endl;
+      break;
+    }
   } while (iterations() < params.maxIterations &&
            !checkConvergence(params.relativeErrorTol, params.absoluteErrorTol, params.errorTol,
                              currentError, error(), params.verbosity) && std::isfinite(currentError));
@@ -144,6 +186,12 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
     else
       delta = gfg.eliminateSequential(params.getEliminationFunction(), boost::none,
                                       params.orderingType)->optimize();
+  } else if (params.isEigenSparse()) {
+    // Direct bridge to Eigen's sparse solvers on the CSC Jacobian
+    if (params.linearSolverType == NonlinearOptimizerParams::EIGEN_QR)
+      delta = optimizeEigenQR(gfg);
+    else
+      delta = optimizeEigenCholesky(gfg);
   } else if (params.isIterative()) {
     // Conjugate Gradient -> needs params.iterativeParams
     if (!params.iterativeParams)
@@ -151,7 +199,11 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
 
     if (boost::shared_ptr<PCGSolverParameters> pcg =
             boost::dynamic_pointer_cast<PCGSolverParameters>(params.iterativeParams)) {
-      delta = PCGSolver(*pcg).optimize(gfg);
+      // Keep the solver alive across iterations, so it can warm-start CG from
+      // the previous solution and reuse its preconditioner state
+      if (!iterativeSolver_)
+        iterativeSolver_ = boost::make_shared<PCGSolver>(*pcg);
+      delta = iterativeSolver_->optimize(gfg);
     } else if (boost::shared_ptr<SubgraphSolverParameters> spcg =
                    boost::dynamic_pointer_cast<SubgraphSolverParameters>(params.iterativeParams)) {
       if (!params.ordering)
@@ -21,6 +21,10 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearOptimizerParams.h>
 
+namespace gtsam {
+class IterativeSolver;
+}
+
 namespace gtsam {
 
 namespace internal { struct NonlinearOptimizerState; }
@@ -79,6 +83,10 @@ protected:
 
   std::unique_ptr<internal::NonlinearOptimizerState> state_; ///< PIMPL'd state
 
+  /** Iterative linear solver kept alive across calls to solve(), so stateful
+   * solvers (e.g. PCGSolver warm starts) carry over between iterations */
+  mutable boost::shared_ptr<IterativeSolver> iterativeSolver_;
+
 public:
   /** A shared pointer to this class */
   typedef boost::shared_ptr<const NonlinearOptimizer> shared_ptr;
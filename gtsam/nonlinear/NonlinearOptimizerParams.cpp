@@ -80,6 +80,7 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   std::cout << "absolute decrease threshold: " << absoluteErrorTol << "\n";
   std::cout << "      total error threshold: " << errorTol << "\n";
   std::cout << "         maximum iterations: " << maxIterations << "\n";
+  std::cout << "                time budget: " << timeBudget << "\n";
   std::cout << "                  verbosity: " << verbosityTranslator(verbosity)
       << "\n";
   std::cout.flush();
@@ -139,6 +140,10 @@ std::string NonlinearOptimizerParams::linearSolverTranslator(
     return "ITERATIVE";
   case CHOLMOD:
     return "CHOLMOD";
+  case EIGEN_CHOLESKY:
+    return "EIGEN_CHOLESKY";
+  case EIGEN_QR:
+    return "EIGEN_QR";
   default:
     throw std::invalid_argument(
         "Unknown linear solver type in SuccessiveLinearizationOptimizer");
@@ -160,6 +165,10 @@ NonlinearOptimizerParams::LinearSolverType NonlinearOptimizerParams::linearSolve
     return Iterative;
   if (linearSolverType == "CHOLMOD")
     return CHOLMOD;
+  if (linearSolverType == "EIGEN_CHOLESKY")
+    return EIGEN_CHOLESKY;
+  if (linearSolverType == "EIGEN_QR")
+    return EIGEN_QR;
   throw std::invalid_argument(
       "Unknown linear solver type in SuccessiveLinearizationOptimizer");
 }
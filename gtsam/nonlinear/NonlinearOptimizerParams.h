@@ -24,6 +24,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <boost/optional.hpp>
+#include <functional>
 #include <string>
 
 namespace gtsam {
@@ -45,10 +46,40 @@ public:
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
   Ordering::OrderingType orderingType; ///< The method of ordering use during variable elimination (default COLAMD)
 
+  /**
+   * Wall-clock budget in seconds for optimize() (default 0.0, disabled).
+   * When positive, the iteration loop stops once the budget is spent, and
+   * does not start an iteration that the duration of the previous one
+   * suggests would overshoot it.  The optimizer state after every iteration
+   * is a consistent estimate, so the values returned at the deadline are the
+   * best estimate completed within the budget.  The first iteration always
+   * runs: with no timing history there is nothing to predict from.
+   */
+  double timeBudget;
+
+  /**
+   * Per-iteration quality metrics streamed to iterationQualityHook while
+   * optimize() runs, so real-time consumers can track solution quality
+   * before the final result is available.
+   */
+  struct IterationQuality {
+    size_t iteration; ///< number of iterations completed so far
+    double error; ///< nonlinear error after this iteration
+    double errorDecrease; ///< error decrease achieved by this iteration
+    double maxDeltaNorm; ///< largest per-variable update norm of this iteration
+    double elapsed; ///< wall-clock seconds since optimize() started
+  };
+
+  /// Callback invoked with IterationQuality after every iteration of
+  /// optimize() (default: empty).  Computing the metrics copies the previous
+  /// values, so leave the hook unset when the metrics are not consumed.
+  typedef std::function<void(const IterationQuality&)> IterationQualityHook;
+  IterationQualityHook iterationQualityHook;
+
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
           0.0), verbosity(SILENT), orderingType(Ordering::COLAMD),
-          linearSolverType(MULTIFRONTAL_CHOLESKY) {}
+          timeBudget(0.0), linearSolverType(MULTIFRONTAL_CHOLESKY) {}
 
   virtual ~NonlinearOptimizerParams() {
   }
@@ -58,12 +89,17 @@ public:
   double getRelativeErrorTol() const { return relativeErrorTol; }
   double getAbsoluteErrorTol() const { return absoluteErrorTol; }
   double getErrorTol() const { return errorTol; }
+  double getTimeBudget() const { return timeBudget; }
   std::string getVerbosity() const { return verbosityTranslator(verbosity); }
 
   void setMaxIterations(int value) { maxIterations = value; }
   void setRelativeErrorTol(double value) { relativeErrorTol = value; }
   void setAbsoluteErrorTol(double value) { absoluteErrorTol = value; }
   void setErrorTol(double value) { errorTol = value; }
+  void setTimeBudget(double value) { timeBudget = value; }
+  void setIterationQualityHook(const IterationQualityHook& hook) {
+    iterationQualityHook = hook;
+  }
   void setVerbosity(const std::string& src) {
     verbosity = verbosityTranslator(src);
   }
@@ -79,6 +115,8 @@ public:
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
     CHOLMOD, /* Experimental Flag */
+    EIGEN_CHOLESKY, ///< Eigen SimplicialLLT on the normal equations, via the sparse CSC bridge
+    EIGEN_QR, ///< Eigen SparseQR on the whitened Jacobian, via the sparse CSC bridge
   };
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
@@ -103,6 +141,11 @@ public:
     return (linearSolverType == Iterative);
   }
 
+  inline bool isEigenSparse() const {
+    return (linearSolverType == EIGEN_CHOLESKY)
+        || (linearSolverType == EIGEN_QR);
+  }
+
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     switch (linearSolverType) {
     case MULTIFRONTAL_CHOLESKY:
@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PagedValues.cpp
+ * @brief   A disk-backed store of values with a bounded in-memory working set
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/PagedValues.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+PagedValues::PagedValues(const std::string& filename, size_t maxLoadedValues)
+    : filename_(filename), maxLoadedValues_(maxLoadedValues) {
+  // Default policy: evict the least recently used key
+  policy_ = [](const FastList<Key>& lruOrder) { return lruOrder.front(); };
+
+  // Open the backing file, creating it if it does not exist yet
+  file_.open(filename_.c_str(), ios::in | ios::out | ios::binary);
+  if (!file_.is_open()) {
+    file_.open(filename_.c_str(), ios::out | ios::binary);
+    file_.close();
+    file_.open(filename_.c_str(), ios::in | ios::out | ios::binary);
+  }
+  if (!file_.is_open())
+    throw invalid_argument("PagedValues: cannot open file " + filename_);
+
+  // Build the key-to-slot index from the record headers
+  file_.seekg(0, ios::end);
+  const size_t count = static_cast<size_t>(file_.tellg()) / sizeof(Record);
+  for (size_t slot = 0; slot < count; ++slot) {
+    const Record record = readRecord(slot);
+    index_[record.key] = slot;
+  }
+}
+
+/* ************************************************************************* */
+void PagedValues::insert(Key j, const Pose3& pose) {
+  Record record;
+  record.key = j;
+  record.type = 0;
+  const Matrix3 R = pose.rotation().matrix();
+  for (int r = 0; r < 3; ++r)
+    for (int c = 0; c < 3; ++c)
+      record.data[3 * r + c] = R(r, c);
+  record.data[9] = pose.x();
+  record.data[10] = pose.y();
+  record.data[11] = pose.z();
+  writeRecord(record);
+}
+
+/* ************************************************************************* */
+void PagedValues::insert(Key j, const Point3& point) {
+  Record record;
+  record.key = j;
+  record.type = 1;
+  record.data[0] = point.x();
+  record.data[1] = point.y();
+  record.data[2] = point.z();
+  for (int k = 3; k < 12; ++k) record.data[k] = 0.0;
+  writeRecord(record);
+}
+
+/* ************************************************************************* */
+Values PagedValues::load(const KeyVector& keys) const {
+  Values result;
+  for (Key j : keys) {
+    const auto slot = index_.find(j);
+    if (slot == index_.end())
+      throw ValuesKeyDoesNotExist("load", j);
+    // Serve resident values from the working set, read the rest directly so
+    // a bulk load does not churn the cache
+    if (cache_.exists(j))
+      result.insert(j, cache_.at(j));
+    else
+      materialize(readRecord(slot->second), &result);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+void PagedValues::print(const std::string& str) const {
+  cout << str << "PagedValues backed by " << filename_ << ": " << size()
+       << " values, " << loadedSize() << " resident" << endl;
+}
+
+/* ************************************************************************* */
+void PagedValues::touch(Key j) const {
+  const auto position = lruPosition_.find(j);
+  if (position != lruPosition_.end()) {
+    // Resident: move to the most recently used end
+    lruOrder_.splice(lruOrder_.end(), lruOrder_, position->second);
+    return;
+  }
+
+  const auto slot = index_.find(j);
+  if (slot == index_.end())
+    throw ValuesKeyDoesNotExist("at", j);
+
+  // Page the record in and make it the most recently used
+  materialize(readRecord(slot->second), &cache_);
+  lruPosition_[j] = lruOrder_.insert(lruOrder_.end(), j);
+
+  // Shrink the working set back to its budget
+  while (cache_.size() > maxLoadedValues_ && lruOrder_.size() > 1) {
+    Key victim = policy_(lruOrder_);
+    if (victim == j)  // never evict the key being accessed
+      victim = lruOrder_.front();
+    const auto victimPosition = lruPosition_.find(victim);
+    if (victimPosition == lruPosition_.end())
+      throw runtime_error("PagedValues: eviction policy returned a key that is not resident");
+    lruOrder_.erase(victimPosition->second);
+    lruPosition_.erase(victimPosition);
+    cache_.erase(victim);
+  }
+}
+
+/* ************************************************************************* */
+PagedValues::Record PagedValues::readRecord(size_t slot) const {
+  Record record;
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(slot * sizeof(Record)), ios::beg);
+  file_.read(reinterpret_cast<char*>(&record), sizeof(Record));
+  if (!file_)
+    throw runtime_error("PagedValues: failed to read record from " + filename_);
+  return record;
+}
+
+/* ************************************************************************* */
+void PagedValues::writeRecord(const Record& record) {
+  size_t slot;
+  const auto existing = index_.find(record.key);
+  if (existing != index_.end()) {
+    slot = existing->second;
+    // Drop any resident copy so the next access re-reads the new value
+    const auto position = lruPosition_.find(record.key);
+    if (position != lruPosition_.end()) {
+      lruOrder_.erase(position->second);
+      lruPosition_.erase(position);
+      cache_.erase(record.key);
+    }
+  } else {
+    slot = index_.size();
+    index_[record.key] = slot;
+  }
+
+  file_.clear();
+  file_.seekp(static_cast<std::streamoff>(slot * sizeof(Record)), ios::beg);
+  file_.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+  file_.flush();
+  if (!file_)
+    throw runtime_error("PagedValues: failed to write record to " + filename_);
+}
+
+/* ************************************************************************* */
+void PagedValues::materialize(const Record& record, Values* values) {
+  if (record.type == 0) {
+    const Rot3 R(record.data[0], record.data[1], record.data[2],
+                 record.data[3], record.data[4], record.data[5],
+                 record.data[6], record.data[7], record.data[8]);
+    const Point3 t(record.data[9], record.data[10], record.data[11]);
+    values->insert(record.key, Pose3(R, t));
+  } else if (record.type == 1) {
+    values->insert(record.key,
+                   Point3(record.data[0], record.data[1], record.data[2]));
+  } else {
+    throw runtime_error("PagedValues: unknown record type in backing file");
+  }
+}
+
+}  // namespace gtsam
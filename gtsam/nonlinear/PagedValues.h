@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PagedValues.h
+ * @brief   A disk-backed store of values with a bounded in-memory working set
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/FastList.h>
+#include <gtsam/base/FastMap.h>
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * A disk-backed store for Pose3 and Point3 values that keeps only a bounded
+ * working set in memory.  Values live in a fixed-record binary file; reads go
+ * through the operating system page cache, so repeatedly touching the same
+ * keys - e.g. the region a vehicle session visits inside a much larger
+ * basemap - only pages in the touched records.
+ *
+ * This is not a drop-in Values replacement: Values is a concrete container
+ * that owns all of its entries.  Instead, load() materializes an ordinary
+ * Values for a requested set of keys, which can then be passed to
+ * NonlinearFactorGraph::linearize or merged with session variables, while
+ * at() serves single keys from an LRU-bounded cache.
+ *
+ * The eviction policy is pluggable: when the working set exceeds its budget,
+ * the policy is handed the resident keys in least-recently-used order and
+ * returns the key to drop.  The default evicts the least recently used key.
+ */
+class GTSAM_EXPORT PagedValues {
+ public:
+  /// Selects a victim among the resident keys, given in LRU order (least
+  /// recently used first)
+  typedef std::function<Key(const FastList<Key>&)> EvictionPolicy;
+
+  /** Open or create the store backing file.
+   * @param filename path of the fixed-record file, created if missing
+   * @param maxLoadedValues working-set budget, in number of resident values
+   */
+  explicit PagedValues(const std::string& filename,
+                       size_t maxLoadedValues = 1000);
+
+  /// Number of values in the store (resident or not)
+  size_t size() const { return index_.size(); }
+
+  /// Number of values currently resident in memory
+  size_t loadedSize() const { return cache_.size(); }
+
+  /// Check whether a value with the given key exists in the store
+  bool exists(Key j) const { return index_.count(j) > 0; }
+
+  /// Append or overwrite a Pose3, writing through to the backing file
+  void insert(Key j, const Pose3& pose);
+
+  /// Append or overwrite a Point3, writing through to the backing file
+  void insert(Key j, const Point3& point);
+
+  /** Retrieve a single value, reading it from disk if it is not resident.
+   * Throws ValuesKeyDoesNotExist if the key is not in the store and
+   * ValuesIncorrectType if it was stored with a different type. */
+  template <typename ValueType>
+  ValueType at(Key j) const {
+    touch(j);
+    return cache_.at<ValueType>(j);
+  }
+
+  /** Materialize an ordinary Values holding the requested keys, paging in
+   * only those records.  The result is independent of the working-set
+   * budget and suitable for NonlinearFactorGraph::linearize. */
+  Values load(const KeyVector& keys) const;
+
+  /// Replace the eviction policy (default: least recently used)
+  void setEvictionPolicy(const EvictionPolicy& policy) { policy_ = policy; }
+
+  /// print
+  void print(const std::string& str = "") const;
+
+ private:
+  /// One fixed-size record in the backing file
+  struct Record {
+    std::uint64_t key;
+    std::uint64_t type;  ///< 0: Pose3, 1: Point3
+    double data[12];     ///< rotation row-major + translation, or point
+  };
+
+  /// Ensure the value for key j is resident and mark it most recently used
+  void touch(Key j) const;
+
+  /// Read the record at the given slot from the backing file
+  Record readRecord(size_t slot) const;
+
+  /// Write a record to the given slot (or append) and update the index
+  void writeRecord(const Record& record);
+
+  /// Construct the in-memory value for a record and insert it into values
+  static void materialize(const Record& record, Values* values);
+
+  std::string filename_;
+  mutable std::fstream file_;
+  size_t maxLoadedValues_;
+  EvictionPolicy policy_;
+
+  FastMap<Key, size_t> index_;  ///< key to record slot in the file
+
+  // Working set: resident values plus recency bookkeeping
+  mutable Values cache_;
+  mutable FastList<Key> lruOrder_;  ///< least recently used first
+  mutable FastMap<Key, FastList<Key>::iterator> lruPosition_;
+};
+
+}  // namespace gtsam
@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    StochasticGradientDescent.cpp
+ * @brief   Sampled tangent-space gradient descent for very large graphs
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/StochasticGradientDescent.h>
+#include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace gtsam {
+
+// Floor added to every sampling weight so converged factors keep a nonzero
+// probability and the importance correction stays bounded
+static const double kMinFactorWeight = 1e-9;
+
+/* ************************************************************************* */
+StochasticGradientDescent::StochasticGradientDescent(
+    const NonlinearFactorGraph& graph, const Values& initialValues,
+    const StochasticGradientDescentParams& params) :
+    graph_(graph), values_(initialValues), params_(params), iterations_(0),
+    rng_(params.seed), totalWeight_(0.0) {
+  if (params_.batchSize == 0)
+    throw std::invalid_argument(
+        "StochasticGradientDescent: batchSize must be positive");
+}
+
+/* ************************************************************************* */
+void StochasticGradientDescent::refreshWeights() {
+  weights_.resize(graph_.size());
+  totalWeight_ = 0.0;
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    weights_[i] = graph_[i] ? graph_[i]->error(values_) + kMinFactorWeight
+        : 0.0;
+    totalWeight_ += weights_[i];
+  }
+}
+
+/* ************************************************************************* */
+double StochasticGradientDescent::iterate() {
+  // Periodically re-weight the sampling distribution by the current factor
+  // errors, so effort concentrates where the residuals are
+  if (iterations_ % params_.weightRefreshInterval == 0 ||
+      weights_.size() != graph_.size())
+    refreshWeights();
+
+  std::discrete_distribution<size_t> sample(weights_.begin(), weights_.end());
+
+  // Accumulate an importance-weighted gradient estimate over the batch:
+  // factor i is drawn with probability w_i / W, so scaling its gradient by
+  // W / (B w_i) makes the batch sum an unbiased estimate of the full one
+  VectorValues gradient;
+  for (size_t draw = 0; draw < params_.batchSize; ++draw) {
+    const size_t i = sample(rng_);
+    GaussianFactor::shared_ptr linearized = graph_[i]->linearize(values_);
+    if (!linearized)
+      continue;
+    const double importance = totalWeight_
+        / (double(params_.batchSize) * weights_[i]);
+    for (const VectorValues::value_type& entry :
+        linearized->gradientAtZero()) {
+      VectorValues::iterator slot = gradient.find(entry.first);
+      if (slot == gradient.end())
+        gradient.emplace(entry.first, importance * entry.second);
+      else
+        slot->second += importance * entry.second;
+    }
+  }
+
+  // Turn the gradient into a descent step in the tangent space
+  VectorValues delta;
+  double gradientSquaredNorm = 0.0;
+  for (const VectorValues::value_type& entry : gradient) {
+    gradientSquaredNorm += entry.second.squaredNorm();
+    if (params_.useAdaGrad) {
+      VectorValues::iterator accumulator = squaredGradient_.find(entry.first);
+      if (accumulator == squaredGradient_.end())
+        accumulator = squaredGradient_.emplace(entry.first,
+            Vector(Vector::Zero(entry.second.size())));
+      accumulator->second.array() += entry.second.array().square();
+      delta.emplace(entry.first,
+          (-params_.stepSize * entry.second.array()
+              / (accumulator->second.array().sqrt()
+                  + params_.adaGradEpsilon)).matrix());
+    } else {
+      const double step = params_.stepSize
+          / (1.0 + params_.stepDecay * double(iterations_));
+      delta.emplace(entry.first, -step * entry.second);
+    }
+  }
+
+  // Only the sampled factors' variables move; everything else stays put
+  values_.retractInPlace(delta);
+  ++iterations_;
+  return gradientSquaredNorm;
+}
+
+/* ************************************************************************* */
+const Values& StochasticGradientDescent::optimize() {
+  for (size_t i = 0; i < params_.maxIterations; ++i)
+    iterate();
+
+  // Anneal to full-batch Levenberg-Marquardt for the final convergence
+  if (params_.finalBatchIterations > 0) {
+    LevenbergMarquardtOptimizer optimizer(graph_, values_, params_.lmParams);
+    for (size_t i = 0; i < params_.finalBatchIterations; ++i)
+      optimizer.iterate();
+    values_ = optimizer.values();
+  }
+  return values_;
+}
+
+/* ************************************************************************* */
+
+}  // namespace gtsam
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    StochasticGradientDescent.h
+ * @brief   Sampled tangent-space gradient descent for very large graphs
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <random>
+#include <vector>
+
+namespace gtsam {
+
+/** Parameters for StochasticGradientDescent */
+struct GTSAM_EXPORT StochasticGradientDescentParams {
+  /// Number of factors sampled (with replacement) per iteration
+  size_t batchSize;
+
+  /// Base learning rate for the tangent-space step
+  double stepSize;
+
+  /// Learning-rate decay for plain SGD: step = stepSize / (1 + decay * t)
+  double stepDecay;
+
+  /// Scale each coordinate by the inverse root of its accumulated squared
+  /// gradient (AdaGrad) instead of the decayed global rate
+  bool useAdaGrad;
+
+  /// Conditioning floor inside the AdaGrad divisor
+  double adaGradEpsilon;
+
+  /// Iterations between re-weighting the sampling distribution by factor
+  /// error; refreshing touches every factor, so keep this large
+  size_t weightRefreshInterval;
+
+  /// Number of sampled iterations run by optimize()
+  size_t maxIterations;
+
+  /// Full-batch Levenberg-Marquardt iterations run by optimize() after the
+  /// sampled phase, annealing to an exact final convergence (0 disables)
+  size_t finalBatchIterations;
+
+  /// Settings for the final full-batch Levenberg-Marquardt phase
+  LevenbergMarquardtParams lmParams;
+
+  /// Seed for the sampling generator, fixed for reproducible runs
+  unsigned int seed;
+
+  StochasticGradientDescentParams() :
+      batchSize(256), stepSize(0.1), stepDecay(0.01), useAdaGrad(true),
+      adaGradEpsilon(1e-8), weightRefreshInterval(25), maxIterations(100),
+      finalBatchIterations(10), seed(42) {
+  }
+};
+
+/**
+ * Stochastic gradient descent over a nonlinear factor graph.  When a graph
+ * has tens of millions of factors a single batch iteration is prohibitively
+ * expensive, yet most of the improvement comes from a small high-error
+ * subset.  Each iterate() samples batchSize factors with probability
+ * proportional to their error (refreshed every weightRefreshInterval
+ * iterations), linearizes only those factors, and takes an
+ * importance-weighted gradient step in the tangent space via
+ * Values::retractInPlace - so the per-iteration cost is O(batchSize), not
+ * O(factors), and the gradient estimate stays unbiased.  Steps are scaled
+ * per-coordinate with AdaGrad by default, or by a decaying global rate.
+ * optimize() runs the sampled phase and then anneals to full-batch
+ * Levenberg-Marquardt for the final exact convergence.
+ */
+class GTSAM_EXPORT StochasticGradientDescent {
+ public:
+  StochasticGradientDescent(const NonlinearFactorGraph& graph,
+      const Values& initialValues,
+      const StochasticGradientDescentParams& params =
+          StochasticGradientDescentParams());
+
+  /// The current estimate
+  const Values& values() const { return values_; }
+
+  /// The current total error; touches every factor, unlike iterate()
+  double error() const { return graph_.error(values_); }
+
+  /// Number of iterate() calls so far
+  size_t iterations() const { return iterations_; }
+
+  /**
+   * Perform one sampled gradient step.
+   * @return the squared norm of the (importance-weighted) gradient estimate
+   */
+  double iterate();
+
+  /**
+   * Run maxIterations sampled iterations followed by finalBatchIterations
+   * full-batch Levenberg-Marquardt iterations, and return the final estimate.
+   */
+  const Values& optimize();
+
+ private:
+  /// Recompute the error-proportional sampling weights; O(factors)
+  void refreshWeights();
+
+  NonlinearFactorGraph graph_;
+  Values values_;
+  StochasticGradientDescentParams params_;
+  size_t iterations_;
+  std::mt19937 rng_;
+  std::vector<double> weights_;  ///< per-factor sampling weights
+  double totalWeight_;           ///< sum of weights_, for importance scaling
+  VectorValues squaredGradient_; ///< AdaGrad accumulator
+};
+
+}  // namespace gtsam
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 
 #include <gtsam/nonlinear/Values.h> // Only so Eclipse finds class definition
@@ -340,6 +341,19 @@ namespace gtsam {
    /* ************************************************************************* */
    template<typename ValueType>
    ValueType Values::at(Key j) const {
+     // Use the contiguous index when it is current, see prepare()
+     if (flatIndexValid_) {
+       FlatIndex::const_iterator it = std::lower_bound(flatIndex_.begin(),
+           flatIndex_.end(), j,
+           [](const std::pair<Key, const Value*>& entry, Key key) {
+             return entry.first < key;
+           });
+       if (it == flatIndex_.end() || it->first != j)
+         throw ValuesKeyDoesNotExist("at", j);
+       auto h = internal::handle<ValueType>();
+       return h(j, it->second);
+     }
+
      // Find the item
      KeyValueMap::const_iterator item = values_.find(j);
 
@@ -353,6 +367,14 @@ namespace gtsam {
     return h(j,item->second);
   }
 
+  /* ************************************************************************* */
+  template<typename ValueType>
+  ValueType Values::atHandle(size_t handle) const {
+    const Value& value = atHandle(handle); // range- and currency-checked
+    auto h = internal::handle<ValueType>();
+    return h(flatIndex_[handle].first, &value);
+  }
+
   /* ************************************************************************* */
   template<typename ValueType>
   boost::optional<const ValueType&> Values::exists(Key j) const {
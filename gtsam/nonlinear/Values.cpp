@@ -24,6 +24,9 @@
 
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Sim3.h>
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -35,9 +38,11 @@
 #endif
 #include <boost/iterator/transform_iterator.hpp>
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -103,6 +108,44 @@ namespace gtsam {
     return Values(*this, delta);
   }
 
+  /* ************************************************************************* */
+  namespace {
+  // Typed fast path for retractInPlace: updates the wrapped value directly,
+  // bypassing the virtual retract and its temporary allocation
+  template <typename T>
+  bool retractInPlaceIfType(Value& value, const Vector& v) {
+    if (typeid(value) == typeid(GenericValue<T>)) {
+      GenericValue<T>& generic = static_cast<GenericValue<T>&>(value);
+      generic.value() = traits<T>::Retract(generic.value(), v);
+      return true;
+    }
+    return false;
+  }
+  }  // namespace
+
+  /* ************************************************************************* */
+  void Values::retractInPlace(const VectorValues& delta) {
+    for (KeyValueMap::iterator item = values_.begin(); item != values_.end(); ++item) {
+      VectorValues::const_iterator it = delta.find(item->first);
+      if (it == delta.end())
+        continue;
+      const Vector& v = it->second;
+      Value& value = *item->second;
+      if (retractInPlaceIfType<Pose3>(value, v) ||
+          retractInPlaceIfType<Rot3>(value, v) ||
+          retractInPlaceIfType<Sim3>(value, v) ||
+          retractInPlaceIfType<Point3>(value, v) ||
+          retractInPlaceIfType<Pose2>(value, v) ||
+          retractInPlaceIfType<Point2>(value, v))
+        continue;
+      // Other types go through the virtual retract; the temporary is
+      // assigned into the existing storage and released immediately
+      Value* retracted = value.retract_(v);
+      value = *retracted;
+      retracted->deallocate_();
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues Values::localCoordinates(const Values& cp) const {
     if(this->size() != cp.size())
@@ -120,6 +163,18 @@ namespace gtsam {
 
   /* ************************************************************************* */
   const Value& Values::at(Key j) const {
+    // Use the contiguous index when it is current, see prepare()
+    if (flatIndexValid_) {
+      FlatIndex::const_iterator it = std::lower_bound(flatIndex_.begin(),
+          flatIndex_.end(), j,
+          [](const std::pair<Key, const Value*>& entry, Key key) {
+            return entry.first < key;
+          });
+      if (it == flatIndex_.end() || it->first != j)
+        throw ValuesKeyDoesNotExist("retrieve", j);
+      return *it->second;
+    }
+
     // Find the item
     KeyValueMap::const_iterator item = values_.find(j);
 
@@ -129,6 +184,39 @@ namespace gtsam {
     return *item->second;
   }
 
+  /* ************************************************************************* */
+  void Values::prepare() const {
+    if (flatIndexValid_)
+      return;
+    flatIndex_.clear();
+    flatIndex_.reserve(values_.size());
+    for (KeyValueMap::const_iterator item = values_.begin();
+        item != values_.end(); ++item)
+      flatIndex_.push_back(std::make_pair(item->first, item->second));
+    flatIndexValid_ = true;
+  }
+
+  /* ************************************************************************* */
+  size_t Values::handle(Key j) const {
+    prepare();
+    FlatIndex::const_iterator it = std::lower_bound(flatIndex_.begin(),
+        flatIndex_.end(), j,
+        [](const std::pair<Key, const Value*>& entry, Key key) {
+          return entry.first < key;
+        });
+    if (it == flatIndex_.end() || it->first != j)
+      throw ValuesKeyDoesNotExist("handle", j);
+    return it - flatIndex_.begin();
+  }
+
+  /* ************************************************************************* */
+  const Value& Values::atHandle(size_t handle) const {
+    if (!flatIndexValid_ || handle >= flatIndex_.size())
+      throw std::out_of_range(
+          "Values::atHandle: index not current, call prepare() first");
+    return *flatIndex_[handle].second;
+  }
+
   /* ************************************************************************* */
   void Values::insert(Key j, const Value& val) {
     std::pair<iterator,bool> insertResult = tryInsert(j, val);
@@ -146,6 +234,7 @@ namespace gtsam {
 
   /* ************************************************************************* */
   std::pair<Values::iterator, bool> Values::tryInsert(Key j, const Value& value) {
+    flatIndexValid_ = false;
     std::pair<KeyValueMap::iterator, bool> result = values_.insert(j, value.clone_());
     return std::make_pair(boost::make_transform_iterator(result.first, &make_deref_pair), result.second);
   }
@@ -162,6 +251,7 @@ namespace gtsam {
     if (typeid(old_value) != typeid(val))
       throw ValuesIncorrectType(j, typeid(old_value), typeid(val));
 
+    flatIndexValid_ = false; // the replaced value gets new storage
     values_.replace(item, val.clone_());
   }
 
@@ -177,6 +267,7 @@ namespace gtsam {
     KeyValueMap::iterator item = values_.find(j);
     if(item == values_.end())
       throw ValuesKeyDoesNotExist("erase", j);
+    flatIndexValid_ = false;
     values_.erase(item);
   }
 
@@ -189,6 +280,16 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  KeyVector Values::keysInRange(Key first, Key last) const {
+    KeyVector result;
+    const_iterator key_value = lower_bound(first);
+    const const_iterator stop = upper_bound(last);
+    for (; key_value != stop; ++key_value)
+      result.push_back(key_value->key);
+    return result;
+  }
+
   /* ************************************************************************* */
   Values& Values::operator=(const Values& rhs) {
     this->clear();
@@ -26,6 +26,7 @@
 
 #include <gtsam/base/GenericValue.h>
 #include <gtsam/base/VectorSpace.h>
+#include <gtsam/base/FastVector.h>
 #include <gtsam/inference/Key.h>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/filter_iterator.hpp>
@@ -86,6 +87,13 @@ namespace gtsam {
     // The member to store the values, see just above
     KeyValueMap values_;
 
+    // Contiguous key-sorted index over values_, built by prepare(); a
+    // "handle" is a position in this vector.  Any structural mutation
+    // drops the index, see the prepare() documentation.
+    typedef FastVector<std::pair<Key, const Value*> > FlatIndex;
+    mutable FlatIndex flatIndex_;
+    mutable bool flatIndexValid_ = false;
+
     // Types obtained by iterating
     typedef KeyValueMap::const_iterator::value_type ConstKeyValuePtrPair;
     typedef KeyValueMap::iterator::value_type KeyValuePtrPair;
@@ -193,6 +201,39 @@ namespace gtsam {
      */
     const Value& at(Key j) const;
 
+    /** Build a contiguous key-sorted index over the stored values.  While the
+     * index is current, every at() lookup runs as a binary search over a flat
+     * array instead of a walk over the pool-allocated tree, which is
+     * substantially cheaper during linearization where each factor looks up
+     * each of its keys.  Typically called once per iteration, e.g. by
+     * NonlinearFactorGraph::linearize.
+     *
+     * The index also defines stable handles: handle(j) is the rank of j among
+     * the sorted keys, so handles resolved once stay valid for any prepared
+     * Values holding the same key set - in particular across the retract()
+     * results of successive iterations.  insert(), update() and erase() drop
+     * the index (the next prepare() rebuilds it); retractInPlace() updates
+     * values in their existing storage and keeps it.
+     */
+    void prepare() const;
+
+    /// Whether the contiguous index built by prepare() is current
+    bool prepared() const { return flatIndexValid_; }
+
+    /** Resolve key \c j into its stable handle, building the index if needed.
+     * Throws ValuesKeyDoesNotExist if the key is not present. */
+    size_t handle(Key j) const;
+
+    /** Constant-time access by handle, see prepare().  Throws
+     * std::out_of_range if the index is not current or the handle is not one
+     * returned by handle() on an equal key set. */
+    const Value& atHandle(size_t handle) const;
+
+    /** Constant-time typed access by handle, the handle counterpart of
+     * at<ValueType>(), see prepare() */
+    template<typename ValueType>
+    ValueType atHandle(size_t handle) const;
+
     /** Check if a value exists with key \c j.  See exists<>(Key j)
      * and exists(const TypedKey& j) for versions that return the value if it
      * exists. */
@@ -246,6 +287,17 @@ namespace gtsam {
     /** Add a delta config to current config and returns a new config */
     Values retract(const VectorValues& delta) const;
 
+    /**
+     * Retract in place: for every entry with a corresponding vector in
+     * \c delta, replace the value by its retraction without allocating a
+     * replacement object.  Common geometry types (Pose3, Rot3, Point3,
+     * Pose2, Point2) are updated through a direct typed assignment that
+     * bypasses the virtual retract; other types fall back to the virtual
+     * path with a short-lived temporary.  Entries without a delta vector
+     * are left unchanged, matching retract().
+     */
+    void retractInPlace(const VectorValues& delta);
+
     /** Get a delta config about a linearization point c0 (*this) */
     VectorValues localCoordinates(const Values& cp) const;
 
@@ -294,14 +346,29 @@ namespace gtsam {
      */
     KeyVector keys() const;
 
+    /**
+     * Returns all keys j with \c first <= j <= \c last, in increasing order.
+     * Because the config is sorted by key this is an O(log n + k) interval
+     * query, e.g. keysInRange(Symbol('x',0), Symbol('x',1000)) collects the
+     * first 1001 poses of a time-ordered trajectory without a full scan.
+     */
+    KeyVector keysInRange(Key first, Key last) const;
+
     /** Replace all keys and variables */
     Values& operator=(const Values& rhs);
 
     /** Swap the contents of two Values without copying data */
-    void swap(Values& other) { values_.swap(other.values_); }
+    void swap(Values& other) {
+      values_.swap(other.values_);
+      flatIndexValid_ = false;
+      other.flatIndexValid_ = false;
+    }
 
     /** Remove all variables from the config */
-    void clear() { values_.clear(); }
+    void clear() {
+      values_.clear();
+      flatIndexValid_ = false;
+    }
 
     /** Compute the total dimensionality of all values (\f$ O(n) \f$) */
     size_t dim() const;
@@ -412,6 +479,7 @@ namespace gtsam {
     template<class ARCHIVE>
     void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
       ar & BOOST_SERIALIZATION_NVP(values_);
+      flatIndexValid_ = false; // loading replaces the stored values
     }
 
     static ConstKeyValuePair make_const_deref_pair(const KeyValueMap::const_iterator::value_type& key_value) {
@@ -22,10 +22,13 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/base/Manifold.h>
 
+#include <boost/static_assert.hpp>
 #include <boost/type_traits/aligned_storage.hpp>
 
 #include <Eigen/Core>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 namespace gtsam {
 namespace internal {
@@ -38,6 +41,44 @@ template<int T> struct CallRecord;
 static const unsigned TraceAlignment = 32;
 typedef boost::aligned_storage<1, TraceAlignment>::type ExecutionTraceStorage;
 
+/**
+ * Grow-only aligned buffer holding the execution trace, one per thread.
+ * Once the first few linearize calls have grown it to the size of the
+ * largest trace in the problem, laying out a trace is a pointer bump into
+ * this buffer and no heap allocation happens per call, on any platform.
+ * Unlike the stack array it replaces, it also cannot overflow the stack
+ * for very deep expressions.
+ */
+class TraceBuffer {
+  std::vector<char> raw_;
+  ExecutionTraceStorage* aligned_;
+  size_t capacity_;
+
+ public:
+  TraceBuffer() : aligned_(nullptr), capacity_(0) {}
+
+  ExecutionTraceStorage* request(size_t size) {
+    if (size > capacity_) {
+      const size_t bytes = size * sizeof(ExecutionTraceStorage);
+      raw_.resize(bytes + TraceAlignment);
+      void* ptr = raw_.data();
+      size_t space = raw_.size();
+      std::align(TraceAlignment, bytes, ptr, space);
+      aligned_ = static_cast<ExecutionTraceStorage*>(ptr);
+      capacity_ = size;
+    }
+    return aligned_;
+  }
+};
+
+/// Return this thread's trace buffer, grown to at least \p size elements.
+/// Note the buffer is shared by all expressions on the thread, so functors
+/// evaluated during a trace must not themselves linearize expressions.
+inline ExecutionTraceStorage* traceBuffer(size_t size) {
+  static thread_local TraceBuffer buffer;
+  return buffer.request(size);
+}
+
 template<bool UseBlock, typename Derived>
 struct UseBlockIf {
   static void addToJacobian(const Eigen::MatrixBase<Derived>& dTdA,
@@ -100,6 +141,9 @@ class ExecutionTrace {
     CallRecord<Dim>* ptr;
   } content;
 
+  /// Traces of equal dimension may graft each other's contents
+  template<class A> friend class ExecutionTrace;
+
  public:
 
   /// Pointer always starts out as a Constant
@@ -119,6 +163,24 @@ class ExecutionTrace {
     content.ptr = record;
   }
 
+  /**
+   * Adopt the contents of a trace of another type with the same dimension.
+   * Used to fuse nodes whose chain-rule Jacobian is exactly the identity out
+   * of the reverse AD path: the parent's trace points straight at the
+   * argument's record (or leaf), so the identity multiplication - and the
+   * virtual call carrying it - never happens.
+   */
+  template<class A>
+  void graft(const ExecutionTrace<A>& other) {
+    BOOST_STATIC_ASSERT(int(traits<A>::dimension) == Dim);
+    if (other.kind == ExecutionTrace<A>::Leaf)
+      setLeaf(other.content.key);
+    else if (other.kind == ExecutionTrace<A>::Function)
+      setFunction(other.content.ptr);
+    else
+      kind = Constant;
+  }
+
   /// Print
   void print(const std::string& indent = "") const {
     if (kind == Constant)
@@ -26,6 +26,11 @@
 #include <typeinfo>       // operator typeid
 #include <ostream>
 #include <map>
+#include <vector>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/mutex.h>
+#endif
 
 class ExpressionFactorBinaryTest;
 // Forward declare for testing
@@ -224,6 +229,90 @@ static void PrintJacobianAndTrace(const std::string& indent,
   trace.print(indent);
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Trace-time classification of a chain-rule Jacobian block.  Deep expression
+ * chains - casts, frame changes, distortion models - produce many dTdA blocks
+ * that are exactly the identity or diagonal.  Classifying the block once,
+ * when the trace is laid out, lets reverse AD skip the corresponding matrix
+ * multiplication entirely (identity) or replace it with column scaling
+ * (diagonal) on every subsequent propagation through the node.  A unary node
+ * with an identity block is fused out of the AD path altogether: the parent's
+ * trace adopts the argument's trace, so two multiplications around the node
+ * collapse into one.
+ *
+ * Only square blocks can be identity or diagonal; the non-square
+ * specialization below classifies everything as General, so those nodes pay
+ * no runtime checks at all.
+ */
+template <class T, class A,
+    bool Square = (int(traits<T>::dimension) == int(traits<A>::dimension))>
+struct ChainRule {
+  typedef typename Jacobian<T, A>::type JacobianTA;
+  enum Kind { General, Diagonal, Identity };
+
+  /// Classify dTdA, called once after the function has filled it in
+  static Kind Classify(const JacobianTA& dTdA) {
+    if (dTdA.isIdentity(0.0)) return Identity;
+    if (dTdA.isDiagonal(0.0)) return Diagonal;
+    return General;
+  }
+
+  /// Continue reverse AD through the node: dFdT * dTdA, short-circuited
+  template <typename MatrixType>
+  static void Apply(Kind kind, const MatrixType& dFdT, const JacobianTA& dTdA,
+      const ExecutionTrace<A>& trace, JacobianMap& jacobians) {
+    if (kind == Identity)
+      trace.reverseAD1(dFdT, jacobians);
+    else if (kind == Diagonal)
+      trace.reverseAD1(dFdT * dTdA.diagonal().asDiagonal(), jacobians);
+    else
+      trace.reverseAD1(dFdT * dTdA, jacobians);
+  }
+
+  /// Start reverse AD at the node, where dFdT is implicitly the identity
+  static void Start(Kind kind, const JacobianTA& dTdA,
+      const ExecutionTrace<A>& trace, JacobianMap& jacobians) {
+    if (kind == Identity)
+      trace.startReverseAD1(jacobians);
+    else
+      trace.reverseAD1(dTdA, jacobians);
+  }
+
+  /// Fuse an identity node out of the AD path by grafting the argument's
+  /// trace onto the parent's.  Returns true iff the node was fused.
+  static bool Fuse(Kind kind, const ExecutionTrace<A>& argument,
+      ExecutionTrace<T>& trace) {
+    if (kind != Identity) return false;
+    trace.graft(argument);
+    return true;
+  }
+};
+
+/// Non-square blocks can never short-circuit
+template <class T, class A>
+struct ChainRule<T, A, false> {
+  typedef typename Jacobian<T, A>::type JacobianTA;
+  enum Kind { General, Identity /* never produced */ };
+
+  static Kind Classify(const JacobianTA&) { return General; }
+
+  template <typename MatrixType>
+  static void Apply(Kind, const MatrixType& dFdT, const JacobianTA& dTdA,
+      const ExecutionTrace<A>& trace, JacobianMap& jacobians) {
+    trace.reverseAD1(dFdT * dTdA, jacobians);
+  }
+
+  static void Start(Kind, const JacobianTA& dTdA,
+      const ExecutionTrace<A>& trace, JacobianMap& jacobians) {
+    trace.reverseAD1(dTdA, jacobians);
+  }
+
+  static bool Fuse(Kind, const ExecutionTrace<A>&, ExecutionTrace<T>&) {
+    return false;
+  }
+};
+
 //-----------------------------------------------------------------------------
 /// Unary Function Expression
 template<class T, class A1>
@@ -272,6 +361,7 @@ public:
   struct Record: public CallRecordImplementor<Record, traits<T>::dimension> {
 
     typename Jacobian<T, A1>::type dTdA1;
+    typename ChainRule<T, A1>::Kind kind1;  ///< trace-time class of dTdA1
     ExecutionTrace<A1> trace1;
     A1 value1;
 
@@ -296,13 +386,13 @@ public:
       // ExecutionTrace::reverseAD1 just passes this on to CallRecord::reverseAD2
       // which calls the correctly sized CallRecord::reverseAD3, which in turn
       // calls reverseAD4 below.
-      trace1.reverseAD1(dTdA1, jacobians);
+      ChainRule<T, A1>::Start(kind1, dTdA1, trace1, jacobians);
     }
 
     /// Given df/dT, multiply in dT/dA and continue reverse AD process
     template<typename MatrixType>
     void reverseAD4(const MatrixType & dFdT, JacobianMap& jacobians) const {
-      trace1.reverseAD1(dFdT * dTdA1, jacobians);
+      ChainRule<T, A1>::Apply(kind1, dFdT, dTdA1, trace1, jacobians);
     }
   };
 
@@ -321,11 +411,17 @@ public:
     // Records must only contain statically sized objects!
     Record* record = new (ptr) Record(values, *expression1_, ptr);
 
-    // Our trace parameter is set to point to the Record
-    trace.setFunction(record);
+    // The function call fills in the Jacobian dTdA1, which we classify so
+    // reverse AD can short-circuit trivial chain-rule multiplications
+    const T result = function_(record->value1, record->dTdA1);
+    record->kind1 = ChainRule<T, A1>::Classify(record->dTdA1);
 
-    // Finally, the function call fills in the Jacobian dTdA1
-    return function_(record->value1, record->dTdA1);
+    // An identity node is fused out of the AD path entirely: our trace adopts
+    // the argument's trace and this record never participates in reverse AD.
+    // Otherwise our trace parameter is set to point to the Record.
+    if (!ChainRule<T, A1>::Fuse(record->kind1, record->trace1, trace))
+      trace.setFunction(record);
+    return result;
   }
 };
 
@@ -390,6 +486,9 @@ public:
     typename Jacobian<T, A1>::type dTdA1;
     typename Jacobian<T, A2>::type dTdA2;
 
+    typename ChainRule<T, A1>::Kind kind1;  ///< trace-time class of dTdA1
+    typename ChainRule<T, A2>::Kind kind2;  ///< trace-time class of dTdA2
+
     ExecutionTrace<A1> trace1;
     ExecutionTrace<A2> trace2;
 
@@ -413,15 +512,15 @@ public:
 
     /// Start the reverse AD process, see comments in UnaryExpression
     void startReverseAD4(JacobianMap& jacobians) const {
-      trace1.reverseAD1(dTdA1, jacobians);
-      trace2.reverseAD1(dTdA2, jacobians);
+      ChainRule<T, A1>::Start(kind1, dTdA1, trace1, jacobians);
+      ChainRule<T, A2>::Start(kind2, dTdA2, trace2, jacobians);
     }
 
     /// Given df/dT, multiply in dT/dA and continue reverse AD process
     template<typename MatrixType>
     void reverseAD4(const MatrixType & dFdT, JacobianMap& jacobians) const {
-      trace1.reverseAD1(dFdT * dTdA1, jacobians);
-      trace2.reverseAD1(dFdT * dTdA2, jacobians);
+      ChainRule<T, A1>::Apply(kind1, dFdT, dTdA1, trace1, jacobians);
+      ChainRule<T, A2>::Apply(kind2, dFdT, dTdA2, trace2, jacobians);
     }
   };
 
@@ -431,7 +530,11 @@ public:
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record(values, *expression1_, *expression2_, ptr);
     trace.setFunction(record);
-    return function_(record->value1, record->value2, record->dTdA1, record->dTdA2);
+    const T result =
+        function_(record->value1, record->value2, record->dTdA1, record->dTdA2);
+    record->kind1 = ChainRule<T, A1>::Classify(record->dTdA1);
+    record->kind2 = ChainRule<T, A2>::Classify(record->dTdA2);
+    return result;
   }
 };
 
@@ -502,6 +605,10 @@ public:
     typename Jacobian<T, A2>::type dTdA2;
     typename Jacobian<T, A3>::type dTdA3;
 
+    typename ChainRule<T, A1>::Kind kind1;  ///< trace-time class of dTdA1
+    typename ChainRule<T, A2>::Kind kind2;  ///< trace-time class of dTdA2
+    typename ChainRule<T, A3>::Kind kind3;  ///< trace-time class of dTdA3
+
     ExecutionTrace<A1> trace1;
     ExecutionTrace<A2> trace2;
     ExecutionTrace<A3> trace3;
@@ -529,17 +636,17 @@ public:
 
     /// Start the reverse AD process, see comments in Base
     void startReverseAD4(JacobianMap& jacobians) const {
-      trace1.reverseAD1(dTdA1, jacobians);
-      trace2.reverseAD1(dTdA2, jacobians);
-      trace3.reverseAD1(dTdA3, jacobians);
+      ChainRule<T, A1>::Start(kind1, dTdA1, trace1, jacobians);
+      ChainRule<T, A2>::Start(kind2, dTdA2, trace2, jacobians);
+      ChainRule<T, A3>::Start(kind3, dTdA3, trace3, jacobians);
     }
 
     /// Given df/dT, multiply in dT/dA and continue reverse AD process
     template<typename MatrixType>
     void reverseAD4(const MatrixType & dFdT, JacobianMap& jacobians) const {
-      trace1.reverseAD1(dFdT * dTdA1, jacobians);
-      trace2.reverseAD1(dFdT * dTdA2, jacobians);
-      trace3.reverseAD1(dFdT * dTdA3, jacobians);
+      ChainRule<T, A1>::Apply(kind1, dFdT, dTdA1, trace1, jacobians);
+      ChainRule<T, A2>::Apply(kind2, dFdT, dTdA2, trace2, jacobians);
+      ChainRule<T, A3>::Apply(kind3, dFdT, dTdA3, trace3, jacobians);
     }
   };
 
@@ -549,8 +656,12 @@ public:
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record(values, *expression1_, *expression2_, *expression3_, ptr);
     trace.setFunction(record);
-    return function_(record->value1, record->value2, record->value3,
-                     record->dTdA1, record->dTdA2, record->dTdA3);
+    const T result = function_(record->value1, record->value2, record->value3,
+                               record->dTdA1, record->dTdA2, record->dTdA3);
+    record->kind1 = ChainRule<T, A1>::Classify(record->dTdA1);
+    record->kind2 = ChainRule<T, A2>::Classify(record->dTdA2);
+    record->kind3 = ChainRule<T, A3>::Classify(record->dTdA3);
+    return result;
   }
 };
 
@@ -730,5 +841,139 @@ class BinarySumNode : public ExpressionNode<T> {
   }
 };
 
+//-----------------------------------------------------------------------------
+/// Expression that memoizes the value and Jacobians of a subtree
+template <class T>
+class CachedExpressionNode : public ExpressionNode<T> {
+  boost::shared_ptr<ExpressionNode<T> > expression_;
+  KeyVector keys_;        ///< The leaf keys under the subtree, sorted
+  FastVector<int> dims_;  ///< Dimensions corresponding to keys_
+
+  // Cache of the last traceExecution, reused while the leaf values are unchanged.
+  // jacobians_ is allocated once in the constructor and only overwritten in place,
+  // so Records handed out earlier never see their blocks reallocated.
+  mutable boost::optional<T> value_;        ///< Value at the cached linearization point
+  mutable Values leafValues_;               ///< Leaf values the cache was computed at
+  mutable VerticalBlockMatrix jacobians_;   ///< One block of Jacobian per leaf key
+
+#ifdef GTSAM_USE_TBB
+  mutable tbb::mutex mutex_;  ///< Protects the cache when factors share a subtree
+#endif
+
+ public:
+  /// Constructor wrapping the subtree rooted at e
+  CachedExpressionNode(const Expression<T>& e) : expression_(e.root()) {
+    std::map<Key, int> map;
+    expression_->dims(map);
+    keys_.reserve(map.size());
+    dims_.reserve(map.size());
+    for (const std::pair<const Key, int>& keyDim : map) {
+      keys_.push_back(keyDim.first);
+      dims_.push_back(keyDim.second);
+    }
+    jacobians_ = VerticalBlockMatrix(dims_, traits<T>::dimension);
+    // Only our own Record enters the caller's trace, the subtree runs in its own buffer
+    this->traceSize_ = upAligned(sizeof(Record));
+  }
+
+  /// Destructor
+  virtual ~CachedExpressionNode() {}
+
+  /// Print
+  virtual void print(const std::string& indent = "") const {
+    std::cout << indent << "CachedExpressionNode" << std::endl;
+    expression_->print(indent + "  ");
+  }
+
+  /// Return value
+  virtual T value(const Values& values) const {
+    return expression_->value(values);
+  }
+
+  /// Return keys that play in this expression
+  virtual std::set<Key> keys() const {
+    return expression_->keys();
+  }
+
+  /// Return dimensions for each argument
+  virtual void dims(std::map<Key, int>& map) const {
+    expression_->dims(map);
+  }
+
+  // Inner Record Class
+  struct Record : public CallRecordImplementor<Record, traits<T>::dimension> {
+    const CachedExpressionNode* node;
+
+    /// Print to std::cout
+    void print(const std::string& indent) const {
+      std::cout << indent << "CachedExpressionNode::Record {" << std::endl;
+      for (size_t i = 0; i < node->keys_.size(); i++)
+        std::cout << indent << "  cached D/D("
+                  << DefaultKeyFormatter(node->keys_[i])
+                  << ") = " << node->jacobians_(i) << std::endl;
+      std::cout << indent << "}" << std::endl;
+    }
+
+    /// Start the reverse AD process: scatter the cached Jacobians into the leaves
+    void startReverseAD4(JacobianMap& jacobians) const {
+      for (DenseIndex i = 0; i < static_cast<DenseIndex>(node->keys_.size()); i++)
+        jacobians(node->keys_[i]) += node->jacobians_(i);
+    }
+
+    /// Given df/dT, multiply in the cached dT/dLeaf blocks, ending the AD pipeline here
+    template <typename MatrixType>
+    void reverseAD4(const MatrixType& dFdT, JacobianMap& jacobians) const {
+      for (DenseIndex i = 0; i < static_cast<DenseIndex>(node->keys_.size()); i++)
+        jacobians(node->keys_[i]) += dFdT * node->jacobians_(i);
+    }
+  };
+
+  /// Construct an execution trace for reverse AD, refreshing the cache if needed
+  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+                           ExecutionTraceStorage* ptr) const {
+    assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
+#ifdef GTSAM_USE_TBB
+    tbb::mutex::scoped_lock lock(mutex_);
+#endif
+    if (!upToDate(values)) refresh(values);
+    Record* record = new (ptr) Record();
+    record->node = this;
+    trace.setFunction(record);
+    return *value_;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+ private:
+  /// Check whether the cache was computed at exactly the given leaf values
+  bool upToDate(const Values& values) const {
+    if (!value_) return false;
+    for (Key key : keys_)
+      if (!values.at(key).equals_(leafValues_.at(key), 0.0)) return false;
+    return true;
+  }
+
+  /// Recompute value and Jacobians of the subtree and snapshot the leaf values
+  void refresh(const Values& values) const {
+    jacobians_.matrix().setZero();
+    JacobianMap jacobianMap(keys_, jacobians_);
+
+    // Run the subtree's own trace in a heap buffer: a miss is the exceptional case,
+    // and keeping the subtree out of the caller's trace keeps that allocation small.
+    const size_t size = expression_->traceSize();
+    std::vector<char> buffer(size * sizeof(ExecutionTraceStorage) + TraceAlignment);
+    size_t address = reinterpret_cast<size_t>(buffer.data());
+    ExecutionTraceStorage* traceStorage =
+        reinterpret_cast<ExecutionTraceStorage*>(upAligned(address, TraceAlignment));
+
+    ExecutionTrace<T> subTrace;
+    value_ = expression_->traceExecution(values, subTrace, traceStorage);
+    subTrace.startReverseAD1(jacobianMap);
+
+    leafValues_.clear();
+    for (Key key : keys_) leafValues_.insert(key, values.at(key));
+  }
+};
+
 }  // namespace internal
 }  // namespace gtsam
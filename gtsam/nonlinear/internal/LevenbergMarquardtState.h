@@ -121,36 +121,49 @@ struct LevenbergMarquardtState : public NonlinearOptimizerState {
     return item;
   };
 
-  /// Build a damped system for a specific lambda, vanilla version
-  GaussianFactorGraph buildDampedSystem(GaussianFactorGraph damped /* gets copied */) const {
+  /// Append the damping priors for this lambda to an existing damped system
+  /// in place, vanilla version.  Lets the optimizer reuse the base graph
+  /// prefix across lambda retries instead of copying it per retry.
+  void appendDampingFactors(GaussianFactorGraph* damped) const {
     noiseModelCache.resize(0);
     // for each of the variables, add a prior
-    damped.reserve(damped.size() + values.size());
+    damped->reserve(damped->size() + values.size());
     for (const auto& key_value : values) {
       const Key key = key_value.key;
       const size_t dim = key_value.value.dim();
       const CachedModel* item = getCachedModel(dim);
-      damped += boost::make_shared<JacobianFactor>(key, item->A, item->b, item->model);
+      *damped += boost::make_shared<JacobianFactor>(key, item->A, item->b, item->model);
     }
-    return damped;
   }
 
-  /// Build a damped system, use hessianDiagonal per variable (more expensive)
-  GaussianFactorGraph buildDampedSystem(GaussianFactorGraph damped,  // gets copied
-                                        const VectorValues& sqrtHessianDiagonal) const {
+  /// Append damping priors, use hessianDiagonal per variable (more expensive)
+  void appendDampingFactors(GaussianFactorGraph* damped,
+                            const VectorValues& sqrtHessianDiagonal) const {
     noiseModelCache.resize(0);
-    damped.reserve(damped.size() + values.size());
+    damped->reserve(damped->size() + values.size());
     for (const auto& key_vector : sqrtHessianDiagonal) {
       try {
         const Key key = key_vector.first;
         const size_t dim = key_vector.second.size();
         CachedModel* item = getCachedModel(dim);
         item->A.diagonal() = sqrtHessianDiagonal.at(key);  // use diag(hessian)
-        damped += boost::make_shared<JacobianFactor>(key, item->A, item->b, item->model);
+        *damped += boost::make_shared<JacobianFactor>(key, item->A, item->b, item->model);
       } catch (const std::out_of_range&) {
         continue;  // Don't attempt any damping if no key found in diagonal
       }
     }
+  }
+
+  /// Build a damped system for a specific lambda, vanilla version
+  GaussianFactorGraph buildDampedSystem(GaussianFactorGraph damped /* gets copied */) const {
+    appendDampingFactors(&damped);
+    return damped;
+  }
+
+  /// Build a damped system, use hessianDiagonal per variable (more expensive)
+  GaussianFactorGraph buildDampedSystem(GaussianFactorGraph damped,  // gets copied
+                                        const VectorValues& sqrtHessianDiagonal) const {
+    appendDampingFactors(&damped, sqrtHessianDiagonal);
     return damped;
   }
 };
@@ -0,0 +1,532 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file snapshot.cpp
+ * @brief Fast binary checkpoint/restore for Values and GaussianFactorGraph
+ * @author Richard Roberts
+ */
+
+#include <gtsam/nonlinear/snapshot.h>
+
+#include <gtsam/base/GenericValue.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+/* ************************************************************************* */
+// File layout: header (magic, version, kind, entry count) followed by one
+// tagged entry per value or factor.  All buffers are raw host-endian doubles
+// in Eigen's column-major order.
+const char kMagic[4] = { 'G', 'T', 'S', 'N' };
+const uint32_t kVersion = 1;
+
+enum SnapshotKind : uint32_t {
+  kValuesSnapshot = 1, kGraphSnapshot = 2, kBayesTreeSnapshot = 3
+};
+
+// Compact type tags for Values entries
+enum ValueTag : uint8_t {
+  kVectorTag = 1, kPoint2Tag, kPoint3Tag, kRot2Tag, kRot3Tag, kPose2Tag,
+  kPose3Tag, kCal3_S2Tag, kDoubleTag
+};
+
+// Tags for GaussianFactorGraph entries
+enum FactorTag : uint8_t {
+  kNullFactorTag = 0, kJacobianFactorTag, kHessianFactorTag
+};
+
+// Tags for the noise model attached to a JacobianFactor
+enum ModelTag : uint8_t {
+  kNoModelTag = 0, kDiagonalModelTag, kConstrainedModelTag
+};
+
+/* ************************************************************************* */
+// Thin raw-buffer writer over an output file stream
+struct Writer {
+  ofstream stream;
+
+  explicit Writer(const string& filename) :
+      stream(filename.c_str(), ios::binary) {
+  }
+
+  template<typename SCALAR>
+  void raw(SCALAR value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(SCALAR));
+  }
+
+  template<typename DERIVED>
+  void dense(const Eigen::DenseBase<DERIVED>& dense) {
+    const Matrix evaluated = dense;
+    stream.write(reinterpret_cast<const char*>(evaluated.data()),
+        evaluated.size() * sizeof(double));
+  }
+
+  void header(SnapshotKind kind, uint64_t count) {
+    stream.write(kMagic, sizeof(kMagic));
+    raw(kVersion);
+    raw(static_cast<uint32_t>(kind));
+    raw(count);
+  }
+};
+
+/* ************************************************************************* */
+// Cursor over a memory-mapped (or read-in) snapshot, with bounds checking
+struct Reader {
+  const char* pos;
+  const char* end;
+
+  Reader(const char* data, size_t size) :
+      pos(data), end(data + size) {
+  }
+
+  void require(size_t bytes) const {
+    if (static_cast<size_t>(end - pos) < bytes)
+      throw runtime_error("loadSnapshot: truncated snapshot file");
+  }
+
+  template<typename SCALAR>
+  SCALAR raw() {
+    require(sizeof(SCALAR));
+    SCALAR value;
+    memcpy(&value, pos, sizeof(SCALAR));
+    pos += sizeof(SCALAR);
+    return value;
+  }
+
+  Matrix dense(DenseIndex rows, DenseIndex cols) {
+    const size_t bytes = static_cast<size_t>(rows * cols) * sizeof(double);
+    require(bytes);
+    Matrix result(rows, cols);
+    memcpy(result.data(), pos, bytes);
+    pos += bytes;
+    return result;
+  }
+
+  void header(SnapshotKind expectedKind, uint64_t& count) {
+    require(sizeof(kMagic));
+    if (memcmp(pos, kMagic, sizeof(kMagic)) != 0)
+      throw runtime_error("loadSnapshot: not a GTSAM snapshot file");
+    pos += sizeof(kMagic);
+    if (raw<uint32_t>() != kVersion)
+      throw runtime_error("loadSnapshot: unsupported snapshot version");
+    if (raw<uint32_t>() != static_cast<uint32_t>(expectedKind))
+      throw runtime_error("loadSnapshot: snapshot holds a different object type");
+    count = raw<uint64_t>();
+  }
+};
+
+/* ************************************************************************* */
+// Read-only view of a whole file: mmap where available, plain read otherwise
+class MappedFile {
+public:
+  explicit MappedFile(const string& filename) :
+      data_(NULL), size_(0), ok_(false) {
+#ifdef _WIN32
+    ifstream stream(filename.c_str(), ios::binary);
+    if (!stream.is_open())
+      return;
+    stream.seekg(0, ios::end);
+    buffer_.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0, ios::beg);
+    if (!buffer_.empty())
+      stream.read(&buffer_[0], buffer_.size());
+    data_ = buffer_.empty() ? NULL : &buffer_[0];
+    size_ = buffer_.size();
+    ok_ = true;
+#else
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0)
+      return;
+    struct stat status;
+    if (fstat(fd_, &status) != 0)
+      return;
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ > 0) {
+      void* mapped = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+      if (mapped == MAP_FAILED)
+        return;
+      data_ = static_cast<const char*>(mapped);
+    }
+    ok_ = true;
+#endif
+  }
+
+  ~MappedFile() {
+#ifndef _WIN32
+    if (data_)
+      munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0)
+      close(fd_);
+#endif
+  }
+
+  bool ok() const { return ok_; }
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+  bool ok_;
+#ifdef _WIN32
+  string buffer_;
+#else
+  int fd_ = -1;
+#endif
+};
+
+/* ************************************************************************* */
+template<typename T>
+const T* tryCast(const Value* value) {
+  const GenericValue<T>* generic = dynamic_cast<const GenericValue<T>*>(value);
+  return generic ? &generic->value() : NULL;
+}
+
+void writeValue(Writer& writer, const Value& value) {
+  if (const Pose3* pose = tryCast<Pose3>(&value)) {
+    writer.raw<uint8_t>(kPose3Tag);
+    writer.dense(pose->rotation().matrix());
+    const Point3& t = pose->translation();
+    writer.raw(t.x()); writer.raw(t.y()); writer.raw(t.z());
+  } else if (const Pose2* pose = tryCast<Pose2>(&value)) {
+    writer.raw<uint8_t>(kPose2Tag);
+    writer.raw(pose->x()); writer.raw(pose->y()); writer.raw(pose->theta());
+  } else if (const Rot3* rot = tryCast<Rot3>(&value)) {
+    writer.raw<uint8_t>(kRot3Tag);
+    writer.dense(rot->matrix());
+  } else if (const Rot2* rot = tryCast<Rot2>(&value)) {
+    writer.raw<uint8_t>(kRot2Tag);
+    writer.raw(rot->theta());
+  } else if (const Point3* point = tryCast<Point3>(&value)) {
+    writer.raw<uint8_t>(kPoint3Tag);
+    writer.raw(point->x()); writer.raw(point->y()); writer.raw(point->z());
+  } else if (const Point2* point = tryCast<Point2>(&value)) {
+    writer.raw<uint8_t>(kPoint2Tag);
+    writer.raw(point->x()); writer.raw(point->y());
+  } else if (const Cal3_S2* cal = tryCast<Cal3_S2>(&value)) {
+    writer.raw<uint8_t>(kCal3_S2Tag);
+    writer.dense(cal->vector());
+  } else if (const double* scalar = tryCast<double>(&value)) {
+    writer.raw<uint8_t>(kDoubleTag);
+    writer.raw(*scalar);
+  } else if (const Vector* vector = tryCast<Vector>(&value)) {
+    writer.raw<uint8_t>(kVectorTag);
+    writer.raw<uint64_t>(vector->size());
+    writer.dense(*vector);
+  } else {
+    throw invalid_argument(
+        string("saveSnapshot: unsupported value type ") + typeid(value).name());
+  }
+}
+
+void readValue(Reader& reader, Key key, Values& values) {
+  const uint8_t tag = reader.raw<uint8_t>();
+  switch (tag) {
+  case kPose3Tag: {
+    const Matrix R = reader.dense(3, 3);
+    const double x = reader.raw<double>(), y = reader.raw<double>(),
+        z = reader.raw<double>();
+    values.insert(key, Pose3(Rot3(Matrix3(R)), Point3(x, y, z)));
+    break;
+  }
+  case kPose2Tag: {
+    const double x = reader.raw<double>(), y = reader.raw<double>(),
+        theta = reader.raw<double>();
+    values.insert(key, Pose2(x, y, theta));
+    break;
+  }
+  case kRot3Tag:
+    values.insert(key, Rot3(Matrix3(reader.dense(3, 3))));
+    break;
+  case kRot2Tag:
+    values.insert(key, Rot2(reader.raw<double>()));
+    break;
+  case kPoint3Tag: {
+    const double x = reader.raw<double>(), y = reader.raw<double>(),
+        z = reader.raw<double>();
+    values.insert(key, Point3(x, y, z));
+    break;
+  }
+  case kPoint2Tag: {
+    const double x = reader.raw<double>(), y = reader.raw<double>();
+    values.insert(key, Point2(x, y));
+    break;
+  }
+  case kCal3_S2Tag:
+    values.insert(key, Cal3_S2(Vector(reader.dense(5, 1))));
+    break;
+  case kDoubleTag:
+    values.insert(key, reader.raw<double>());
+    break;
+  case kVectorTag: {
+    const uint64_t dim = reader.raw<uint64_t>();
+    values.insert(key, Vector(reader.dense(dim, 1)));
+    break;
+  }
+  default:
+    throw runtime_error("loadSnapshot: unknown value type tag");
+  }
+}
+
+/* ************************************************************************* */
+void writeModel(Writer& writer, const SharedDiagonal& model) {
+  if (!model) {
+    writer.raw<uint8_t>(kNoModelTag);
+  } else if (model->isConstrained()) {
+    writer.raw<uint8_t>(kConstrainedModelTag);
+    writer.dense(model->sigmas());
+    writer.dense(boost::static_pointer_cast<noiseModel::Constrained>(model)->mu());
+  } else {
+    writer.raw<uint8_t>(kDiagonalModelTag);
+    writer.dense(model->sigmas());
+  }
+}
+
+SharedDiagonal readModel(Reader& reader, DenseIndex rows) {
+  SharedDiagonal model;
+  const uint8_t modelTag = reader.raw<uint8_t>();
+  if (modelTag == kDiagonalModelTag) {
+    model = noiseModel::Diagonal::Sigmas(reader.dense(rows, 1));
+  } else if (modelTag == kConstrainedModelTag) {
+    const Vector sigmas = reader.dense(rows, 1);
+    const Vector mu = reader.dense(rows, 1);
+    model = noiseModel::Constrained::MixedSigmas(mu, sigmas);
+  } else if (modelTag != kNoModelTag) {
+    throw runtime_error("loadSnapshot: unknown noise model tag");
+  }
+  return model;
+}
+
+/* ************************************************************************* */
+void writeFactor(Writer& writer, const GaussianFactor::shared_ptr& factor) {
+  if (!factor) {
+    writer.raw<uint8_t>(kNullFactorTag);
+    return;
+  }
+  if (const JacobianFactor* jacobian = dynamic_cast<const JacobianFactor*>(factor.get())) {
+    writer.raw<uint8_t>(kJacobianFactorTag);
+    writer.raw<uint64_t>(jacobian->size());
+    for (Key key : jacobian->keys())
+      writer.raw<uint64_t>(key);
+    for (JacobianFactor::const_iterator it = jacobian->begin(); it != jacobian->end(); ++it)
+      writer.raw<uint64_t>(jacobian->getDim(it));
+    writer.raw<uint64_t>(jacobian->rows());
+    writer.dense(jacobian->matrixObject().full());  // raw unwhitened [A b]
+    writeModel(writer, jacobian->get_model());
+  } else if (const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(factor.get())) {
+    writer.raw<uint8_t>(kHessianFactorTag);
+    writer.raw<uint64_t>(hessian->size());
+    for (Key key : hessian->keys())
+      writer.raw<uint64_t>(key);
+    for (HessianFactor::const_iterator it = hessian->begin(); it != hessian->end(); ++it)
+      writer.raw<uint64_t>(hessian->getDim(it));
+    writer.dense(hessian->augmentedInformation());
+  } else {
+    throw invalid_argument(
+        string("saveSnapshot: unsupported factor type ") + typeid(*factor).name());
+  }
+}
+
+void readFactor(Reader& reader, GaussianFactorGraph& graph) {
+  const uint8_t tag = reader.raw<uint8_t>();
+  if (tag == kNullFactorTag) {
+    graph.push_back(GaussianFactor::shared_ptr());
+    return;
+  }
+
+  const uint64_t n = reader.raw<uint64_t>();
+  KeyVector keys(n);
+  for (uint64_t i = 0; i < n; ++i)
+    keys[i] = reader.raw<uint64_t>();
+  FastVector<DenseIndex> dims(n);
+  DenseIndex totalDim = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    dims[i] = static_cast<DenseIndex>(reader.raw<uint64_t>());
+    totalDim += dims[i];
+  }
+
+  if (tag == kJacobianFactorTag) {
+    const DenseIndex rows = static_cast<DenseIndex>(reader.raw<uint64_t>());
+    const Matrix Ab = reader.dense(rows, totalDim + 1);
+    const SharedDiagonal model = readModel(reader, rows);
+    vector<pair<Key, Matrix> > terms(n);
+    DenseIndex column = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      terms[i] = make_pair(keys[i], Matrix(Ab.middleCols(column, dims[i])));
+      column += dims[i];
+    }
+    graph.add(JacobianFactor(terms, Ab.col(column), model));
+  } else if (tag == kHessianFactorTag) {
+    const Matrix augmented = reader.dense(totalDim + 1, totalDim + 1);
+    graph.add(HessianFactor(keys, SymmetricBlockMatrix(dims, augmented, true)));
+  } else {
+    throw runtime_error("loadSnapshot: unknown factor type tag");
+  }
+}
+
+/* ************************************************************************* */
+// A clique is its conditional - shape header plus one bulk [R S d] buffer -
+// followed by its child count and children, depth-first
+void writeClique(Writer& writer, const GaussianBayesTree::sharedClique& clique) {
+  const GaussianConditional& conditional = *clique->conditional();
+  writer.raw<uint64_t>(conditional.size());
+  for (Key key : conditional.keys())
+    writer.raw<uint64_t>(key);
+  writer.raw<uint64_t>(conditional.nrFrontals());
+  for (GaussianConditional::const_iterator it = conditional.begin();
+      it != conditional.end(); ++it)
+    writer.raw<uint64_t>(conditional.getDim(it));
+  const VerticalBlockMatrix& Ab = conditional.matrixObject();
+  writer.raw<uint64_t>(Ab.rows());
+  writer.dense(Ab.full());
+  writeModel(writer, conditional.get_model());
+
+  writer.raw<uint64_t>(clique->children.size());
+  for (const GaussianBayesTree::sharedClique& child : clique->children)
+    writeClique(writer, child);
+}
+
+GaussianBayesTree::sharedClique readClique(Reader& reader) {
+  const uint64_t n = reader.raw<uint64_t>();
+  KeyVector keys(n);
+  for (uint64_t i = 0; i < n; ++i)
+    keys[i] = reader.raw<uint64_t>();
+  const uint64_t nrFrontals = reader.raw<uint64_t>();
+  FastVector<DenseIndex> dims(n);
+  DenseIndex totalDim = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    dims[i] = static_cast<DenseIndex>(reader.raw<uint64_t>());
+    totalDim += dims[i];
+  }
+  const DenseIndex rows = static_cast<DenseIndex>(reader.raw<uint64_t>());
+  VerticalBlockMatrix Ab(dims, rows, true);  // trailing d column
+  Ab.full() = reader.dense(rows, totalDim + 1);
+  const SharedDiagonal model = readModel(reader, rows);
+  GaussianBayesTree::sharedClique clique =
+      boost::make_shared<GaussianBayesTreeClique>(
+          boost::make_shared<GaussianConditional>(keys, nrFrontals, Ab, model));
+
+  const uint64_t nrChildren = reader.raw<uint64_t>();
+  clique->children.reserve(nrChildren);
+  for (uint64_t i = 0; i < nrChildren; ++i) {
+    const GaussianBayesTree::sharedClique child = readClique(reader);
+    child->parent_ = clique;
+    clique->children.push_back(child);
+  }
+  return clique;
+}
+
+} // \namespace
+
+/* ************************************************************************* */
+bool saveSnapshot(const Values& values, const string& filename) {
+  Writer writer(filename);
+  if (!writer.stream.is_open())
+    return false;
+  writer.header(kValuesSnapshot, values.size());
+  for (const Values::ConstKeyValuePair& keyValue : values) {
+    writer.raw<uint64_t>(keyValue.key);
+    writeValue(writer, keyValue.value);
+  }
+  return writer.stream.good();
+}
+
+/* ************************************************************************* */
+bool loadSnapshot(const string& filename, Values& values) {
+  MappedFile file(filename);
+  if (!file.ok())
+    return false;
+  Reader reader(file.data(), file.size());
+  uint64_t count;
+  reader.header(kValuesSnapshot, count);
+  values.clear();
+  for (uint64_t i = 0; i < count; ++i) {
+    const Key key = reader.raw<uint64_t>();
+    readValue(reader, key, values);
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+bool saveSnapshot(const GaussianFactorGraph& graph, const string& filename) {
+  Writer writer(filename);
+  if (!writer.stream.is_open())
+    return false;
+  writer.header(kGraphSnapshot, graph.size());
+  for (const GaussianFactor::shared_ptr& factor : graph)
+    writeFactor(writer, factor);
+  return writer.stream.good();
+}
+
+/* ************************************************************************* */
+bool loadSnapshot(const string& filename, GaussianFactorGraph& graph) {
+  MappedFile file(filename);
+  if (!file.ok())
+    return false;
+  Reader reader(file.data(), file.size());
+  uint64_t count;
+  reader.header(kGraphSnapshot, count);
+  graph = GaussianFactorGraph();
+  graph.reserve(count);
+  for (uint64_t i = 0; i < count; ++i)
+    readFactor(reader, graph);
+  return true;
+}
+
+/* ************************************************************************* */
+bool saveSnapshot(const GaussianBayesTree& bayesTree, const string& filename) {
+  Writer writer(filename);
+  if (!writer.stream.is_open())
+    return false;
+  writer.header(kBayesTreeSnapshot, bayesTree.roots().size());
+  for (const GaussianBayesTree::sharedClique& root : bayesTree.roots())
+    writeClique(writer, root);
+  return writer.stream.good();
+}
+
+/* ************************************************************************* */
+bool loadSnapshot(const string& filename, GaussianBayesTree& bayesTree) {
+  MappedFile file(filename);
+  if (!file.ok())
+    return false;
+  Reader reader(file.data(), file.size());
+  uint64_t count;
+  reader.header(kBayesTreeSnapshot, count);
+  bayesTree = GaussianBayesTree();
+  for (uint64_t i = 0; i < count; ++i)
+    bayesTree.insertRoot(readClique(reader));  // also fills the nodes index
+  return true;
+}
+
+} // \namespace gtsam
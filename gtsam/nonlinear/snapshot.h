@@ -0,0 +1,68 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file snapshot.h
+ * @brief Fast binary checkpoint/restore for Values and GaussianFactorGraph
+ * @author Richard Roberts
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+
+#include <string>
+
+namespace gtsam {
+
+/**
+ * The snapshot functions below write a dedicated binary checkpoint format:
+ * raw host-endian Eigen buffers preceded by a compact type tag per entry,
+ * instead of routing through boost::serialization as serialization.h does.
+ * This makes checkpoint/restore of large states orders of magnitude faster
+ * and the files far smaller, at the price of generality:
+ *  - snapshots are not portable across machines of different endianness,
+ *  - only the common value types are supported (Vector, Point2, Point3,
+ *    Rot2, Rot3, Pose2, Pose3, Cal3_S2, double); saveSnapshot throws
+ *    std::invalid_argument when it encounters anything else.
+ * Loading maps the file into memory (POSIX mmap, plain read on Windows) and
+ * copies the buffers straight into the reconstructed objects.
+ */
+
+/// Write a binary snapshot of \c values, returns false if the file cannot be opened
+GTSAM_EXPORT bool saveSnapshot(const Values& values, const std::string& filename);
+
+/// Restore \c values from a binary snapshot, returns false if the file cannot be
+/// opened and throws std::runtime_error if the contents are not a Values snapshot
+GTSAM_EXPORT bool loadSnapshot(const std::string& filename, Values& values);
+
+/// Write a binary snapshot of \c graph, returns false if the file cannot be opened
+GTSAM_EXPORT bool saveSnapshot(const GaussianFactorGraph& graph, const std::string& filename);
+
+/// Restore \c graph from a binary snapshot, returns false if the file cannot be
+/// opened and throws std::runtime_error if the contents are not a graph snapshot
+GTSAM_EXPORT bool loadSnapshot(const std::string& filename, GaussianFactorGraph& graph);
+
+/// Write a binary snapshot of \c bayesTree: the tree structure in depth-first
+/// order, with each conditional's [R S d] block matrix written as a shape
+/// header plus one bulk buffer.  Returns false if the file cannot be opened
+GTSAM_EXPORT bool saveSnapshot(const GaussianBayesTree& bayesTree,
+    const std::string& filename);
+
+/// Restore \c bayesTree from a binary snapshot, returns false if the file
+/// cannot be opened and throws std::runtime_error if the contents are not a
+/// Bayes tree snapshot
+GTSAM_EXPORT bool loadSnapshot(const std::string& filename,
+    GaussianBayesTree& bayesTree);
+
+} // \namespace gtsam
@@ -281,6 +281,27 @@ TEST(Expression, compose3) {
   EXPECT(expected == R3.keys());
 }
 
+/* ************************************************************************* */
+// Test that a compose chain over constants folds to a single constant node
+TEST(Expression, compose4) {
+  // Create expression
+  const Rot3 bRs = Rot3::Yaw(0.1), sRl = Rot3::Yaw(0.2);
+  Rot3_ chain = Rot3_(bRs) * Rot3_(sRl);
+
+  // The chain has no keys and needs no trace, just like a plain constant
+  EXPECT(chain.keys().empty());
+  EXPECT_LONGS_EQUAL(0, chain.traceSize());
+  Values values;
+  EXPECT(assert_equal(bRs * sRl, chain.value(values)));
+
+  // Composing the folded constant with a leaf behaves like compose3
+  Rot3_ R3 = chain * Rot3_(3);
+  set<Key> expected = list_of(3);
+  EXPECT(expected == R3.keys());
+  values.insert(3, Rot3::Yaw(0.3));
+  EXPECT(assert_equal(bRs * sRl * Rot3::Yaw(0.3), R3.value(values)));
+}
+
 /* ************************************************************************* */
 // Test with ternary function
 Rot3 composeThree(const Rot3& R1, const Rot3& R2, const Rot3& R3, OptionalJacobian<3, 3> H1,
@@ -512,6 +533,83 @@ TEST(Expression, LinearExpression) {
   EXPECT(assert_equal(I_3x3, H[0]));
 }
 
+/* ************************************************************************* */
+TEST(Expression, Cached) {
+  // Wrap the rotation subtree in a memoizing node
+  Rot3_ R(1);
+  Point3_ p(2);
+  Point3_ uncached(R, &Rot3::rotate, p);
+  Point3_ cached = CachedExpression<Point3>(Point3_(R, &Rot3::rotate, p));
+
+  Values values;
+  values.insert(1, Rot3::Rodrigues(0.1, 0.2, 0.3));
+  values.insert(2, Point3(1, 2, 3));
+
+  // Value and Jacobians must match the uncached expression
+  std::vector<Matrix> expectedH(2), actualH(2);
+  Point3 expected = uncached.value(values, expectedH);
+  EXPECT(assert_equal(expected, cached.value(values, actualH)));
+  EXPECT(assert_equal(expectedH[0], actualH[0]));
+  EXPECT(assert_equal(expectedH[1], actualH[1]));
+
+  // A second evaluation at the same values hits the cache and must agree
+  EXPECT(assert_equal(expected, cached.value(values, actualH)));
+  EXPECT(assert_equal(expectedH[0], actualH[0]));
+
+  // Changing a leaf invalidates the cache
+  values.update(2, Point3(4, 5, 6));
+  expected = uncached.value(values, expectedH);
+  EXPECT(assert_equal(expected, cached.value(values, actualH)));
+  EXPECT(assert_equal(expectedH[0], actualH[0]));
+  EXPECT(assert_equal(expectedH[1], actualH[1]));
+}
+
+/* ************************************************************************* */
+// Identity and diagonal chain-rule blocks are short-circuited at trace time;
+// the Jacobians of a chain through such nodes must be unaffected
+namespace fusion {
+Point3 cast(const Point3& p, OptionalJacobian<3, 3> H) {
+  if (H) *H = I_3x3;
+  return p;
+}
+Point3 stretch(const Point3& p, OptionalJacobian<3, 3> H) {
+  if (H) *H = Vector3(2.0, 3.0, 4.0).asDiagonal();
+  return Point3(2.0 * p.x(), 3.0 * p.y(), 4.0 * p.z());
+}
+}  // namespace fusion
+
+TEST(Expression, ChainRuleFusion) {
+  using namespace fusion;
+
+  // An identity-Jacobian node around a rotate, under a diagonal node
+  Rot3_ R(1);
+  Point3_ p(2);
+  Point3_ rotated(R, &Rot3::rotate, p);
+  Point3_ chain(stretch, Point3_(cast, rotated));
+
+  Values values;
+  values.insert(1, Rot3::Rodrigues(0.1, 0.2, 0.3));
+  values.insert(2, Point3(1, 2, 3));
+
+  // Expected value and Jacobians, from the chain without the trivial nodes
+  const Rot3 rot = values.at<Rot3>(1);
+  Matrix3 D1, D2;
+  const Point3 q = rot.rotate(Point3(1, 2, 3), D1, D2);
+  const Matrix3 S = Vector3(2.0, 3.0, 4.0).asDiagonal();
+
+  std::vector<Matrix> H(2);
+  EXPECT(assert_equal(Point3(2 * q.x(), 3 * q.y(), 4 * q.z()),
+                      chain.value(values, H)));
+  EXPECT(assert_equal(Matrix3(S * D1), H[0]));
+  EXPECT(assert_equal(Matrix3(S * D2), H[1]));
+
+  // An identity node directly on a leaf fuses down to the leaf itself
+  Point3_ wrapped(cast, p);
+  std::vector<Matrix> Hleaf(1);
+  EXPECT(assert_equal(Point3(1, 2, 3), wrapped.value(values, Hleaf)));
+  EXPECT(assert_equal(I_3x3, Hleaf[0]));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
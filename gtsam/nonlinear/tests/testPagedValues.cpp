@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testPagedValues.cpp
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/PagedValues.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cstdio>
+
+using namespace std;
+using namespace gtsam;
+
+static const char* kFilename = "testPagedValues.bin";
+
+/* ************************************************************************* */
+TEST(PagedValues, roundTrip)
+{
+  remove(kFilename);
+  const Pose3 pose(Rot3::Rodrigues(0.1, -0.2, 0.3), Point3(1.0, 2.0, 3.0));
+  const Point3 point(-4.0, 5.0, -6.0);
+
+  {
+    PagedValues store(kFilename);
+    store.insert(0, pose);
+    store.insert(100, point);
+    EXPECT_LONGS_EQUAL(2, store.size());
+    EXPECT(store.exists(0));
+    EXPECT(store.exists(100));
+    EXPECT(!store.exists(1));
+    EXPECT(assert_equal(pose, store.at<Pose3>(0)));
+    EXPECT(assert_equal(point, store.at<Point3>(100)));
+  }
+
+  // Reopening the store reads everything back from the file
+  PagedValues reopened(kFilename);
+  EXPECT_LONGS_EQUAL(2, reopened.size());
+  EXPECT_LONGS_EQUAL(0, reopened.loadedSize());
+  EXPECT(assert_equal(pose, reopened.at<Pose3>(0)));
+  EXPECT(assert_equal(point, reopened.at<Point3>(100)));
+
+  // Overwriting a key replaces the stored value
+  const Pose3 updated(Rot3(), Point3(9.0, 8.0, 7.0));
+  reopened.insert(0, updated);
+  EXPECT_LONGS_EQUAL(2, reopened.size());
+  EXPECT(assert_equal(updated, reopened.at<Pose3>(0)));
+
+  remove(kFilename);
+}
+
+/* ************************************************************************* */
+TEST(PagedValues, workingSetBudget)
+{
+  remove(kFilename);
+  PagedValues store(kFilename, 3);
+  for (Key j = 0; j < 10; ++j)
+    store.insert(j, Point3(double(j), 0.0, 0.0));
+
+  // Touch all keys; residency must never exceed the budget
+  for (Key j = 0; j < 10; ++j) {
+    EXPECT(assert_equal(Point3(double(j), 0.0, 0.0), store.at<Point3>(j)));
+    EXPECT(store.loadedSize() <= 3);
+  }
+  EXPECT_LONGS_EQUAL(3, store.loadedSize());
+
+  // A custom policy controls which key is dropped: keep key 9 pinned
+  store.setEvictionPolicy([](const FastList<Key>& lruOrder) {
+    for (Key j : lruOrder)
+      if (j != 9) return j;
+    return lruOrder.front();
+  });
+  for (Key j = 0; j < 9; ++j)
+    store.at<Point3>(j);
+  EXPECT(assert_equal(Point3(9.0, 0.0, 0.0), store.at<Point3>(9)));
+
+  remove(kFilename);
+}
+
+/* ************************************************************************* */
+TEST(PagedValues, load)
+{
+  remove(kFilename);
+  PagedValues store(kFilename, 2);
+  for (Key j = 0; j < 20; ++j)
+    store.insert(j, Point3(0.0, double(j), 0.0));
+
+  // A bulk load returns an ordinary Values and ignores the budget
+  KeyVector keys;
+  for (Key j = 5; j < 15; ++j) keys.push_back(j);
+  const Values loaded = store.load(keys);
+  EXPECT_LONGS_EQUAL(10, loaded.size());
+  for (Key j = 5; j < 15; ++j)
+    EXPECT(assert_equal(Point3(0.0, double(j), 0.0), loaded.at<Point3>(j)));
+
+  // The working set was not churned by the bulk read
+  EXPECT_LONGS_EQUAL(0, store.loadedSize());
+
+  remove(kFilename);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSnapshot.cpp
+ * @brief   Unit tests for the binary checkpoint/restore functions
+ * @author  Richard Roberts
+ */
+
+#include <gtsam/nonlinear/snapshot.h>
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cstdio>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(Snapshot, valuesRoundTrip) {
+  Values expected;
+  expected.insert(0, Pose3(Rot3::Rodrigues(0.1, 0.2, 0.3), Point3(1, 2, 3)));
+  expected.insert(1, Pose2(4.0, 5.0, 0.6));
+  expected.insert(2, Rot3::Rodrigues(-0.1, 0.4, 0.2));
+  expected.insert(3, Rot2::fromAngle(0.7));
+  expected.insert(4, Point3(7, 8, 9));
+  expected.insert(5, Point2(-1, -2));
+  expected.insert(6, Cal3_S2(500.0, 505.0, 0.1, 320.0, 240.0));
+  expected.insert(7, 3.25);
+  expected.insert(8, (Vector(6) << 1, 2, 3, 4, 5, 6).finished());
+
+  const string filename = "testSnapshot.values.bin";
+  CHECK(saveSnapshot(expected, filename));
+
+  Values actual;
+  CHECK(loadSnapshot(filename, actual));
+  EXPECT(assert_equal(expected, actual));
+  remove(filename.c_str());
+
+  // Loading a missing file just reports failure
+  EXPECT(!loadSnapshot("testSnapshot.doesNotExist.bin", actual));
+}
+
+/* ************************************************************************* */
+TEST(Snapshot, graphRoundTrip) {
+  GaussianFactorGraph expected;
+  expected.add(0, (Matrix(2, 2) << 1, 2, 3, 4).finished(), Vector2(1, -1),
+      noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2)));
+  expected.add(0, 2 * I_2x2, 1, -3 * I_2x2, Vector2(0.5, 0.5),
+      noiseModel::Constrained::MixedSigmas(Vector2(1000, 1000), Vector2(0.0, 0.3)));
+  expected.add(JacobianFactor(2, I_3x3, Vector3(1, 2, 3)));  // no noise model
+  expected.add(HessianFactor(
+      JacobianFactor(1, 5 * I_2x2, Vector2(2, 4),
+          noiseModel::Isotropic::Sigma(2, 0.5))));
+
+  const string filename = "testSnapshot.graph.bin";
+  CHECK(saveSnapshot(expected, filename));
+
+  GaussianFactorGraph actual;
+  CHECK(loadSnapshot(filename, actual));
+  EXPECT(assert_equal(expected, actual));
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+TEST(Snapshot, bayesTreeRoundTrip) {
+  // A small chain with a loop closure, eliminated multifrontally so the tree
+  // has a root with children
+  GaussianFactorGraph graph;
+  graph.add(0, I_2x2, Vector2(0, 0), noiseModel::Isotropic::Sigma(2, 0.1));
+  for (Key key = 0; key < 5; ++key)
+    graph.add(key, -I_2x2, key + 1, I_2x2, Vector2(1, 0),
+        noiseModel::Isotropic::Sigma(2, 0.2));
+  graph.add(0, -I_2x2, 5, I_2x2, Vector2(5, 0),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  const GaussianBayesTree expected = *graph.eliminateMultifrontal();
+
+  const string filename = "testSnapshot.bayesTree.bin";
+  CHECK(saveSnapshot(expected, filename));
+
+  GaussianBayesTree actual;
+  CHECK(loadSnapshot(filename, actual));
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(expected.optimize(), actual.optimize()));
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -29,6 +29,7 @@
 #include <boost/assign/std/vector.hpp>
 #include <boost/assign/list_of.hpp>
 using namespace boost::assign;
+#include <cstdint>
 #include <stdexcept>
 #include <limits>
 #include <type_traits>
@@ -235,6 +236,69 @@ TEST(Values, retract_partial)
   CHECK(assert_equal(expected, Values(config0, delta)));
 }
 
+/* ************************************************************************* */
+TEST(Values, retract_inplace)
+{
+  // Mix typed fast paths (Pose3, Pose2, Point3) with the virtual fallback
+  // (Vector3), and leave one entry without a delta vector
+  Values config0;
+  config0.insert(key1, Pose3(Rot3::Rodrigues(0.1, 0.2, -0.3), Point3(1.0, 2.0, 3.0)));
+  config0.insert(key2, Pose2(1.0, 2.0, 0.3));
+  config0.insert(key3, Point3(4.0, 5.0, 6.0));
+  config0.insert(key4, Vector3(1.0, 2.0, 3.0));
+
+  VectorValues delta = pair_list_of<Key, Vector>
+    (key1, (Vector(6) << 0.1, -0.1, 0.2, 0.3, -0.2, 0.1).finished())
+    (key2, Vector3(0.1, 0.2, -0.1))
+    (key4, Vector3(1.3, 1.4, 1.5));
+
+  const Values expected = config0.retract(delta);
+  config0.retractInPlace(delta);
+  CHECK(assert_equal(expected, config0));
+}
+
+/* ************************************************************************* */
+TEST(Values, prepared_handles)
+{
+  Values config;
+  config.insert(key1, Pose2(1.0, 2.0, 0.3));
+  config.insert(key3, Point3(4.0, 5.0, 6.0));
+  config.insert(key2, Pose2(-1.0, 0.5, 0.1));
+
+  // Lookups through the prepared index match the tree lookups exactly
+  EXPECT(!config.prepared());
+  config.prepare();
+  EXPECT(config.prepared());
+  EXPECT(assert_equal(Pose2(1.0, 2.0, 0.3), config.at<Pose2>(key1)));
+  EXPECT(assert_equal(Point3(4.0, 5.0, 6.0), config.at<Point3>(key3)));
+  CHECK_EXCEPTION(config.at(key4), ValuesKeyDoesNotExist);
+
+  // Handles are ranks in key order and give constant-time access
+  EXPECT_LONGS_EQUAL(0, (long)config.handle(key1));
+  EXPECT_LONGS_EQUAL(1, (long)config.handle(key2));
+  EXPECT_LONGS_EQUAL(2, (long)config.handle(key3));
+  CHECK_EXCEPTION(config.handle(key4), ValuesKeyDoesNotExist);
+  EXPECT(assert_equal(Pose2(-1.0, 0.5, 0.1), config.atHandle<Pose2>(1)));
+
+  // Handles stay valid across retract, which preserves the key set
+  VectorValues delta = config.zeroVectors();
+  delta.at(key2) = Vector3(0.1, -0.1, 0.05);
+  const Values retracted = config.retract(delta);
+  retracted.prepare();
+  EXPECT(assert_equal(retracted.at<Pose2>(key2),
+      retracted.atHandle<Pose2>(config.handle(key2))));
+
+  // retractInPlace keeps the index, mutation drops it
+  Values config2 = config;
+  config2.prepare();
+  config2.retractInPlace(delta);
+  EXPECT(config2.prepared());
+  config2.update(key2, Pose2(0.0, 0.0, 0.0));
+  EXPECT(!config2.prepared());
+  CHECK_EXCEPTION(config2.atHandle(1), std::out_of_range);
+  EXPECT(assert_equal(Pose2(0.0, 0.0, 0.0), config2.at<Pose2>(key2)));
+}
+
 /* ************************************************************************* */
 TEST(Values, equals)
 {
@@ -289,6 +353,27 @@ TEST(Values, extract_keys)
   }
 }
 
+/* ************************************************************************* */
+TEST(Values, keysInRange)
+{
+  Values config;
+
+  config.insert(key1, Pose2());
+  config.insert(key2, Pose2());
+  config.insert(key3, Pose2());
+  config.insert(key4, Pose2());
+
+  // Inclusive interval query on the sorted keys
+  KeyVector expected {key2, key3};
+  EXPECT(expected == config.keysInRange(key2, key3));
+
+  // Bounds need not be existing keys
+  EXPECT(config.keys() == config.keysInRange(0, Symbol('v', 100)));
+
+  // Empty interval
+  EXPECT(config.keysInRange(Symbol('w', 0), Symbol('w', 100)).empty());
+}
+
 /* ************************************************************************* */
 TEST(Values, exists_)
 {
@@ -589,6 +674,39 @@ TEST(Values, MatrixDynamicInsertFixedRead) {
   CHECK_EXCEPTION(values.at<Matrix23>(key1), exception);
 }
 
+/* ************************************************************************* */
+TEST(Values, PooledAllocation) {
+  // GenericValue draws from per-type pools; exercise alloc/free/alloc cycles
+  // and check that chunks satisfy Eigen alignment
+  Values values;
+  for (Key j = 0; j < 20; ++j)
+    values.insert(j, Pose3(Rot3::Rodrigues(0.01 * j, 0, 0), Point3(double(j), 0, 0)));
+  for (Key j = 20; j < 40; ++j)
+    values.insert(j, Point3(double(j), 1, 2));
+
+  // A retract allocates a fresh pooled value per variable
+  VectorValues delta;
+  for (Key j = 0; j < 20; ++j)
+    delta.insert(j, (Vector(6) << 0, 0, 0, 0.01, 0, 0).finished());
+  for (Key j = 20; j < 40; ++j)
+    delta.insert(j, Vector3(0.01, 0, 0));
+  Values retracted = values.retract(delta);
+  EXPECT(assert_equal(delta, values.localCoordinates(retracted), 1e-9));
+
+  // Erase and re-insert recycles chunks without disturbing other values
+  Values copied = retracted;
+  for (Key j = 0; j < 40; j += 2)
+    retracted.erase(j);
+  for (Key j = 0; j < 40; j += 2)
+    retracted.insert(j, copied.at(j));
+  EXPECT(assert_equal(copied, retracted));
+
+  // Pooled chunks respect the alignment of the wrapped type
+  for (const auto& key_value : retracted)
+    EXPECT_LONGS_EQUAL(0,
+        reinterpret_cast<std::uintptr_t>(&key_value.value) % sizeof(void*));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
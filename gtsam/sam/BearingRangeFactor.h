@@ -21,6 +21,7 @@
 
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/geometry/BearingRange.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
 #include <boost/concept/assert.hpp>
 
 namespace gtsam {
@@ -66,6 +67,53 @@ class BearingRangeFactor
                          Expression<A2>(key2));
   }
 
+  enum {
+    DimT = traits<T>::dimension,
+    Dim1 = traits<A1>::dimension,
+    Dim2 = traits<A2>::dimension
+  };
+
+  /**
+   * Fixed-size linearize fast path, same pattern as GeneralSFMFactor:
+   * evaluate T::Measure with statically sized Jacobians and return a
+   * BinaryJacobianFactor, skipping the expression trace and the dynamic
+   * VerticalBlockMatrix of the generic ExpressionFactor path. This pays
+   * off in dense 2D graphs (Pose2-Point2, Pose2-Pose2) where every
+   * matrix involved is at most 3x3.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    // Only linearize if the factor is active
+    if (!this->active(x)) return boost::shared_ptr<JacobianFactor>();
+
+    // Robust models reweight with the current error inside WhitenSystem;
+    // fall back to the generic path that supports them
+    const SharedNoiseModel& noiseModel = this->noiseModel();
+    if (noiseModel && boost::dynamic_pointer_cast<noiseModel::Robust>(noiseModel))
+      return Base::linearize(x);
+
+    const Key key1 = this->keys_[0], key2 = this->keys_[1];
+    Eigen::Matrix<double, DimT, Dim1> H1;
+    Eigen::Matrix<double, DimT, Dim2> H2;
+    const T predicted = T::Measure(x.at<A1>(key1), x.at<A2>(key2), H1, H2);
+    Eigen::Matrix<double, DimT, 1> b = traits<T>::Local(predicted, this->measured());
+
+    // Whiten the system if needed
+    if (noiseModel && !noiseModel->isUnit()) {
+      H1 = noiseModel->Whiten(H1);
+      H2 = noiseModel->Whiten(H2);
+      b = noiseModel->whiten(b);
+    }
+
+    // Create new (unit) noiseModel, preserving constraints if applicable
+    SharedDiagonal model;
+    if (noiseModel && noiseModel->isConstrained()) {
+      model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
+    }
+
+    return boost::make_shared<BinaryJacobianFactor<DimT, Dim1, Dim2> >(
+        key1, H1, key2, H2, b, model);
+  }
+
   /// print
   virtual void print(const std::string& s = "",
                      const KeyFormatter& kf = DefaultKeyFormatter) const {
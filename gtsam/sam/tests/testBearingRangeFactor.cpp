@@ -72,6 +72,41 @@ TEST(BearingRangeFactor, 2D) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 }
 
+/* ************************************************************************* */
+// The fixed-size linearize fast path must match the generic expression path
+TEST(BearingRangeFactor, FastLinearize2D) {
+  Values values;
+  values.insert(poseKey, Pose2(1.0, 2.0, 0.57));
+  values.insert(pointKey, Point2(-4.0, 11.0));
+
+  // Generic path: an ExpressionFactor over the same measurement expression
+  typedef BearingRange<Pose2, Point2> T;
+  ExpressionFactor<T> generic(model2D, T(1, 2),
+                              factor2D.expression(poseKey, pointKey));
+
+  GaussianFactor::shared_ptr expected = generic.linearize(values);
+  GaussianFactor::shared_ptr actual = factor2D.linearize(values);
+  EXPECT(assert_equal(expected->augmentedInformation(),
+                      actual->augmentedInformation(), 1e-9));
+}
+
+/* ************************************************************************* */
+// Same check for the Pose2-Pose2 instantiation
+TEST(BearingRangeFactor, FastLinearizePose2Pose2) {
+  typedef BearingRangeFactor<Pose2, Pose2> Factor;
+  typedef BearingRange<Pose2, Pose2> T;
+  Factor factor(poseKey, pointKey, Rot2::fromAngle(0.3), 5.0, model2D);
+
+  Values values;
+  values.insert(poseKey, Pose2(1.0, 2.0, 0.57));
+  values.insert(pointKey, Pose2(-4.0, 11.0, 0.2));
+
+  ExpressionFactor<T> generic(model2D, T(Rot2::fromAngle(0.3), 5.0),
+                              factor.expression(poseKey, pointKey));
+  EXPECT(assert_equal(generic.linearize(values)->augmentedInformation(),
+                      factor.linearize(values)->augmentedInformation(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(BearingRangeFactor, Serialization3D) {
   EXPECT(serializationTestHelpers::equalsObj(factor3D));
@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ViewGraphFilter.cpp
+ * @brief High-throughput epipolar verification of candidate view-graph edges
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/sfm/ViewGraphFilter.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <cmath>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ViewPairResult ViewGraphFilter::filterPair(
+    const ViewPairCandidate& candidate) const {
+  ViewPairResult result;
+  const size_t n = candidate.vAs.cols();
+  if (n == 0)
+    return result;
+
+  // Outliers we can afford before the required inlier ratio is unreachable
+  const size_t neededInliers =
+      static_cast<size_t>(std::ceil(minInlierRatio_ * double(n)));
+  const size_t outlierBudget = n - neededInliers;
+
+  result.inlier.assign(n, false);
+  size_t nrOutliers = 0;
+  for (size_t begin = 0; begin < n; begin += chunkSize_) {
+    const size_t m = std::min(chunkSize_, n - begin);
+    // Packed evaluation of the whole chunk, one column per correspondence
+    const Vector es = candidate.E.errors(candidate.vAs.middleCols(begin, m),
+                                         candidate.vBs.middleCols(begin, m));
+    for (size_t j = 0; j < m; ++j) {
+      if (std::abs(es(j)) <= inlierThreshold_)
+        result.inlier[begin + j] = true;
+      else
+        ++nrOutliers;
+    }
+    // Early exit: remaining chunks cannot save this pair
+    if (nrOutliers > outlierBudget) {
+      result.inlier.clear();
+      result.nrInliers = (begin + m) - nrOutliers;
+      return result;
+    }
+  }
+
+  result.nrInliers = n - nrOutliers;
+  result.accepted = true;
+  return result;
+}
+
+/* ************************************************************************* */
+std::vector<ViewPairResult> ViewGraphFilter::filter(
+    const std::vector<ViewPairCandidate>& candidates) const {
+  std::vector<ViewPairResult> results(candidates.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, candidates.size()),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          results[i] = filterPair(candidates[i]);
+      });
+#else
+  for (size_t i = 0; i < candidates.size(); ++i)
+    results[i] = filterPair(candidates[i]);
+#endif
+  return results;
+}
+
+/* ************************************************************************* */
+
+} // namespace gtsam
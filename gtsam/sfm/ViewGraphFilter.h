@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ViewGraphFilter.h
+ * @brief High-throughput epipolar verification of candidate view-graph edges
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/geometry/EssentialMatrix.h>
+#include <gtsam/base/Matrix.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * One candidate edge of the view graph: an image pair with a hypothesized
+ * essential matrix and its putative correspondences in structure-of-arrays
+ * form.  Column i of vAs and vBs holds the calibrated homogeneous
+ * coordinates of the i-th correspondence in camera A and B respectively,
+ * following the aEb convention of EssentialMatrix::error.
+ */
+struct GTSAM_EXPORT ViewPairCandidate {
+  size_t indexA, indexB;  ///< camera indices, e.g. into SfM_data::cameras
+  EssentialMatrix E;      ///< hypothesized model for the pair
+  Matrix vAs, vBs;        ///< 3xN correspondences, one column each per match
+
+  ViewPairCandidate() : indexA(0), indexB(0), vAs(3, 0), vBs(3, 0) {}
+};
+
+/// Verification verdict for one candidate edge
+struct GTSAM_EXPORT ViewPairResult {
+  bool accepted;             ///< pair passed the inlier-ratio test
+  size_t nrInliers;          ///< inliers found before acceptance or early exit
+  std::vector<bool> inlier;  ///< per-correspondence mask; empty if the pair
+                             ///< was rejected before full evaluation
+
+  ViewPairResult() : accepted(false), nrInliers(0) {}
+};
+
+/**
+ * View-graph verification stage for structure-from-motion: batch-evaluates
+ * the algebraic epipolar residuals of every candidate image pair and keeps
+ * the pairs whose inlier ratio supports the hypothesized essential matrix.
+ * The residuals of each pair are evaluated chunk-wise with
+ * EssentialMatrix::errors over the structure-of-arrays correspondences, so
+ * the inner loop is packed matrix arithmetic; as soon as the accumulated
+ * outliers make the required inlier ratio unreachable the remaining chunks
+ * of that pair are skipped.  With TBB the pairs are verified in parallel.
+ *
+ * The accepted edges feed view-graph construction over SfM_data: indexA and
+ * indexB of each surviving candidate identify the cameras to connect.
+ */
+class GTSAM_EXPORT ViewGraphFilter {
+ public:
+  /**
+   * @param inlierThreshold maximum |vA' E vB| for a correspondence to count
+   *        as an inlier, in calibrated (normalized) coordinates
+   * @param minInlierRatio minimum fraction of inliers for a pair to be kept
+   * @param chunkSize correspondences evaluated per packed batch; also the
+   *        granularity of the early-exit check
+   */
+  ViewGraphFilter(double inlierThreshold = 1e-2, double minInlierRatio = 0.5,
+                  size_t chunkSize = 1024)
+      : inlierThreshold_(inlierThreshold),
+        minInlierRatio_(minInlierRatio),
+        chunkSize_(chunkSize) {}
+
+  /// Verify a single candidate pair
+  ViewPairResult filterPair(const ViewPairCandidate& candidate) const;
+
+  /// Verify all candidate pairs, in parallel when TBB is enabled
+  std::vector<ViewPairResult> filter(
+      const std::vector<ViewPairCandidate>& candidates) const;
+
+  double inlierThreshold() const { return inlierThreshold_; }
+  double minInlierRatio() const { return minInlierRatio_; }
+  size_t chunkSize() const { return chunkSize_; }
+
+ private:
+  double inlierThreshold_;
+  double minInlierRatio_;
+  size_t chunkSize_;
+};
+
+}  // namespace gtsam
@@ -0,0 +1,116 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testViewGraphFilter.cpp
+ * @brief Unit tests for batched epipolar view-graph verification
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/sfm/ViewGraphFilter.h>
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+//*************************************************************************
+// A relative pose between two views and the corresponding essential matrix
+static const Rot3 aRb = Rot3::Yaw(M_PI / 8);
+static const Point3 aTb(0.5, 0.1, 0.0);
+static const EssentialMatrix trueE(aRb, Unit3(aTb));
+
+/* Build a candidate with n correspondences that satisfy the epipolar
+ * constraint exactly: a point bP in frame B maps to aP = aRb * bP + aTb,
+ * and (vA, vB) ~ (aP, bP) then gives vA' * E * vB = 0. The first
+ * nrOutliers columns of vA are perturbed to violate the constraint. */
+static ViewPairCandidate createCandidate(size_t n, size_t nrOutliers) {
+  ViewPairCandidate candidate;
+  candidate.indexA = 0;
+  candidate.indexB = 1;
+  candidate.E = trueE;
+  candidate.vAs.resize(3, n);
+  candidate.vBs.resize(3, n);
+  for (size_t i = 0; i < n; i++) {
+    Point3 bP(0.2 * i - 1.0, 0.5 - 0.1 * i, 4.0 + 0.3 * i);
+    Point3 aP = aRb * bP + aTb;
+    candidate.vAs.col(i) = aP.vector();
+    candidate.vBs.col(i) = bP.vector();
+    if (i < nrOutliers)
+      candidate.vAs.col(i) += Vector3(0.5, -0.5, 0.0);
+  }
+  return candidate;
+}
+
+//*************************************************************************
+TEST(ViewGraphFilter, AllInliers) {
+  ViewGraphFilter filter(1e-9, 0.5, 4); // small chunks to cover chunking
+  ViewPairResult result = filter.filterPair(createCandidate(10, 0));
+  EXPECT(result.accepted);
+  EXPECT_LONGS_EQUAL(10, result.nrInliers);
+  EXPECT_LONGS_EQUAL(10, result.inlier.size());
+  for (size_t i = 0; i < 10; i++)
+    EXPECT(result.inlier[i]);
+}
+
+//*************************************************************************
+TEST(ViewGraphFilter, MixedInliers) {
+  // 3 of 10 perturbed: above a 0.5 ratio, so accepted with correct mask
+  ViewGraphFilter filter(1e-9, 0.5, 4);
+  ViewPairResult result = filter.filterPair(createCandidate(10, 3));
+  EXPECT(result.accepted);
+  EXPECT_LONGS_EQUAL(7, result.nrInliers);
+  for (size_t i = 0; i < 10; i++)
+    EXPECT(result.inlier[i] == (i >= 3));
+}
+
+//*************************************************************************
+TEST(ViewGraphFilter, EarlyReject) {
+  // 9 of 12 perturbed, leading the mask: the outlier budget of 6 is blown
+  // inside the second chunk, well before all 12 residuals are evaluated
+  ViewGraphFilter filter(1e-9, 0.5, 4);
+  ViewPairResult result = filter.filterPair(createCandidate(12, 9));
+  EXPECT(!result.accepted);
+  EXPECT(result.inlier.empty());
+  EXPECT(result.nrInliers < 3);
+}
+
+//*************************************************************************
+TEST(ViewGraphFilter, FilterMany) {
+  // Batch interface: verdicts line up with per-pair verification
+  ViewGraphFilter filter(1e-9, 0.5, 4);
+  vector<ViewPairCandidate> candidates;
+  candidates.push_back(createCandidate(10, 0));
+  candidates.push_back(createCandidate(12, 9));
+  candidates.push_back(createCandidate(10, 3));
+  vector<ViewPairResult> results = filter.filter(candidates);
+  EXPECT_LONGS_EQUAL(3, results.size());
+  EXPECT(results[0].accepted);
+  EXPECT(!results[1].accepted);
+  EXPECT(results[2].accepted);
+  EXPECT_LONGS_EQUAL(7, results[2].nrInliers);
+}
+
+//*************************************************************************
+TEST(ViewGraphFilter, Empty) {
+  ViewGraphFilter filter;
+  ViewPairResult result = filter.filterPair(ViewPairCandidate());
+  EXPECT(!result.accepted);
+  EXPECT_LONGS_EQUAL(0, result.nrInliers);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
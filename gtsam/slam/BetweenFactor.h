@@ -19,8 +19,11 @@
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 
+#include <type_traits>
+
 namespace gtsam {
 
   /**
@@ -102,6 +105,20 @@ namespace gtsam {
 #endif
     }
 
+    /**
+     * Linearize to a BinaryJacobianFactor with compile-time block dimensions,
+     * so Hessian updates during elimination run unrolled fixed-size Eigen
+     * kernels instead of dynamic-size block math.  Inactive factors,
+     * constrained noise models, and dynamically sized types take the generic
+     * NoiseModelFactor::linearize path.
+     */
+    using Base::linearize;
+    virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+      return linearizeImpl(x,
+          std::integral_constant<bool,
+              traits<T>::dimension != Eigen::Dynamic>());
+    }
+
     /** return the measured */
     const VALUE& measured() const {
       return measured_;
@@ -114,6 +131,65 @@ namespace gtsam {
 
   private:
 
+    /// Fixed-dimension fast path for linearize above
+    boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+        std::true_type) const {
+      // The generic path has special handling for inactive factors and
+      // constrained noise models, so defer to it for both
+      if (!this->active(x)
+          || (this->noiseModel_ && this->noiseModel_->isConstrained()))
+        return Base::linearize(x);
+
+      typedef Eigen::Matrix<double, traits<T>::dimension, traits<T>::dimension> JacobianD;
+      typedef Eigen::Matrix<double, traits<T>::dimension, 1> VectorD;
+
+      // Evaluate the error with Jacobians in fixed-size storage, so the whole
+      // computation stays on unrolled Eigen kernels with no heap traffic
+      JacobianD H1, H2;
+      const T& p1 = x.at<T>(this->key1());
+      const T& p2 = x.at<T>(this->key2());
+      T hx = traits<T>::Between(p1, p2, H1, H2); // h(x)
+#ifdef SLOW_BUT_CORRECT_BETWEENFACTOR
+      typename traits<T>::ChartJacobian::Jacobian Hlocal;
+      VectorD b = -traits<T>::Local(measured_, hx, boost::none, &Hlocal);
+      H1 = (Hlocal * H1).eval();
+      H2 = (Hlocal * H2).eval();
+#else
+      VectorD b = -traits<T>::Local(measured_, hx);
+#endif
+
+      // Diagonal models (including isotropic and unit, by far the most
+      // common) whiten with a fixed-size row scaling; anything else goes
+      // through the virtual WhitenSystem on dynamic copies
+      if (this->noiseModel_) {
+        const noiseModel::Diagonal* diagonal =
+            dynamic_cast<const noiseModel::Diagonal*>(this->noiseModel_.get());
+        if (diagonal) {
+          const Vector& invsigmas = diagonal->invsigmas();
+          H1 = invsigmas.asDiagonal() * H1;
+          H2 = invsigmas.asDiagonal() * H2;
+          b = invsigmas.cwiseProduct(b);
+        } else {
+          Matrix A1 = H1, A2 = H2;
+          Vector bd = b;
+          this->noiseModel_->WhitenSystem(A1, A2, bd);
+          H1 = A1;
+          H2 = A2;
+          b = bd;
+        }
+      }
+
+      return boost::make_shared<BinaryJacobianFactor<traits<T>::dimension,
+          traits<T>::dimension, traits<T>::dimension> >(this->key1(), H1,
+          this->key2(), H2, b);
+    }
+
+    /// Dynamically sized types cannot use fixed-size blocks
+    boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+        std::false_type) const {
+      return Base::linearize(x);
+    }
+
     /** Serialization function */
     friend class boost::serialization::access;
     template<class ARCHIVE>
@@ -0,0 +1,387 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FactorWireFormat.cpp
+ * @brief   Compact binary wire format for streaming factor graphs between processes
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/slam/FactorWireFormat.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+// Wire header: magic plus format version, checked on decode
+const uint32_t kMagic = 0x47574631; // "GWF1"
+
+// Noise model kinds on the wire
+enum NoiseKind {
+  kUnit = 0, kIsotropic = 1, kDiagonal = 2, kGaussian = 3
+};
+
+/* ************************************************************************* */
+// Little append/extract helpers.  All multi-byte fields go through memcpy,
+// so the buffer needs no alignment.
+struct Writer {
+  std::string* out;
+  explicit Writer(std::string* buffer) : out(buffer) {
+  }
+  void raw(const void* data, size_t n) {
+    out->append(static_cast<const char*>(data), n);
+  }
+  void u8(uint8_t v) { raw(&v, sizeof(v)); }
+  void u32(uint32_t v) { raw(&v, sizeof(v)); }
+  void u64(uint64_t v) { raw(&v, sizeof(v)); }
+  void f64(double v) { raw(&v, sizeof(v)); }
+  void doubles(const double* data, size_t n) { raw(data, n * sizeof(double)); }
+};
+
+struct Reader {
+  const char* pos;
+  const char* end;
+  Reader(const std::string& buffer) :
+      pos(buffer.data()), end(buffer.data() + buffer.size()) {
+  }
+  void raw(void* data, size_t n) {
+    if (size_t(end - pos) < n)
+      throw invalid_argument("FactorWireFormat: truncated buffer");
+    memcpy(data, pos, n);
+    pos += n;
+  }
+  uint8_t u8() { uint8_t v; raw(&v, sizeof(v)); return v; }
+  uint32_t u32() { uint32_t v; raw(&v, sizeof(v)); return v; }
+  uint64_t u64() { uint64_t v; raw(&v, sizeof(v)); return v; }
+  double f64() { double v; raw(&v, sizeof(v)); return v; }
+  void doubles(double* data, size_t n) { raw(data, n * sizeof(double)); }
+};
+
+/* ************************************************************************* */
+void writePose2(const Pose2& pose, Writer& w) {
+  w.f64(pose.x());
+  w.f64(pose.y());
+  w.f64(pose.theta());
+}
+
+Pose2 readPose2(Reader& r) {
+  const double x = r.f64(), y = r.f64(), theta = r.f64();
+  return Pose2(x, y, theta);
+}
+
+// Poses go over the wire as rotation matrix plus translation: exact
+// round-trip, no log-map evaluation on either end
+void writePose3(const Pose3& pose, Writer& w) {
+  const Matrix3 R = pose.rotation().matrix();
+  w.doubles(R.data(), 9);
+  const Point3 t = pose.translation();
+  w.f64(t.x());
+  w.f64(t.y());
+  w.f64(t.z());
+}
+
+Pose3 readPose3(Reader& r) {
+  Matrix3 R;
+  r.doubles(R.data(), 9);
+  const double x = r.f64(), y = r.f64(), z = r.f64();
+  return Pose3(Rot3(R), Point3(x, y, z));
+}
+
+/* ************************************************************************* */
+void writeNoise(const SharedNoiseModel& model, Writer& w) {
+  if (!model)
+    throw invalid_argument("FactorWireFormat: factor has no noise model");
+  const uint32_t dim = (uint32_t) model->dim();
+  // Check the most derived Gaussian classes first; Constrained derives from
+  // Diagonal but zero sigmas cannot be represented, so reject it explicitly
+  if (boost::dynamic_pointer_cast<noiseModel::Constrained>(model)) {
+    throw invalid_argument(
+        "FactorWireFormat: constrained noise models are not encodable");
+  } else if (boost::dynamic_pointer_cast<noiseModel::Unit>(model)) {
+    w.u8(kUnit);
+    w.u32(dim);
+  } else if (noiseModel::Isotropic::shared_ptr isotropic =
+      boost::dynamic_pointer_cast<noiseModel::Isotropic>(model)) {
+    w.u8(kIsotropic);
+    w.u32(dim);
+    w.f64(isotropic->sigma());
+  } else if (noiseModel::Diagonal::shared_ptr diagonal =
+      boost::dynamic_pointer_cast<noiseModel::Diagonal>(model)) {
+    w.u8(kDiagonal);
+    w.u32(dim);
+    const Vector sigmas = diagonal->sigmas();
+    w.doubles(sigmas.data(), dim);
+  } else if (noiseModel::Gaussian::shared_ptr gaussian =
+      boost::dynamic_pointer_cast<noiseModel::Gaussian>(model)) {
+    w.u8(kGaussian);
+    w.u32(dim);
+    const Matrix R = gaussian->R();
+    w.doubles(R.data(), size_t(dim) * dim);
+  } else {
+    throw invalid_argument(
+        "FactorWireFormat: unsupported noise model (robust models are not "
+        "encodable)");
+  }
+}
+
+SharedNoiseModel readNoise(Reader& r) {
+  const uint8_t kind = r.u8();
+  const uint32_t dim = r.u32();
+  switch (kind) {
+  case kUnit:
+    return noiseModel::Unit::Create(dim);
+  case kIsotropic:
+    return noiseModel::Isotropic::Sigma(dim, r.f64());
+  case kDiagonal: {
+    Vector sigmas(dim);
+    r.doubles(sigmas.data(), dim);
+    return noiseModel::Diagonal::Sigmas(sigmas);
+  }
+  case kGaussian: {
+    Matrix R(dim, dim);
+    r.doubles(R.data(), size_t(dim) * dim);
+    return noiseModel::Gaussian::SqrtInformation(R);
+  }
+  default:
+    throw invalid_argument("FactorWireFormat: unknown noise model kind");
+  }
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+// Rebuilds a tangent preintegration from its wire fields.  The members are
+// protected in TangentPreintegration, so a throwaway derived class fills
+// them in; PreintegratedImuMeasurements then slices the base part back out.
+class WirePreintegration : public PreintegrationType {
+public:
+  WirePreintegration(const boost::shared_ptr<PreintegrationParams>& p,
+      const imuBias::ConstantBias& biasHat, double deltaTij,
+      const Vector9& preintegrated, const Matrix93& H_biasAcc,
+      const Matrix93& H_biasOmega) :
+      PreintegrationType(p, biasHat) {
+    deltaTij_ = deltaTij;
+    preintegrated_ = preintegrated;
+    preintegrated_H_biasAcc_ = H_biasAcc;
+    preintegrated_H_biasOmega_ = H_biasOmega;
+  }
+};
+#endif
+
+} // namespace
+
+/* ************************************************************************* */
+void FactorWireFormat::encode(const NonlinearFactorGraph& graph,
+    std::string* buffer) const {
+  gttic(FactorWireFormat_encode);
+  Writer w(buffer);
+  w.u32(kMagic);
+
+  uint32_t count = 0;
+  for (const NonlinearFactor::shared_ptr& factor : graph)
+    if (factor)
+      ++count;
+  w.u32(count);
+
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    if (!factor)
+      continue;
+    if (PriorFactor<Pose2>::shared_ptr prior2 = boost::dynamic_pointer_cast<
+        PriorFactor<Pose2> >(factor)) {
+      w.u8(kPriorFactorPose2);
+      w.u64(prior2->key());
+      writePose2(prior2->prior(), w);
+      writeNoise(prior2->noiseModel(), w);
+    } else if (PriorFactor<Pose3>::shared_ptr prior3 =
+        boost::dynamic_pointer_cast<PriorFactor<Pose3> >(factor)) {
+      w.u8(kPriorFactorPose3);
+      w.u64(prior3->key());
+      writePose3(prior3->prior(), w);
+      writeNoise(prior3->noiseModel(), w);
+    } else if (BetweenFactor<Pose2>::shared_ptr between2 =
+        boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(factor)) {
+      w.u8(kBetweenFactorPose2);
+      w.u64(between2->key1());
+      w.u64(between2->key2());
+      writePose2(between2->measured(), w);
+      writeNoise(between2->noiseModel(), w);
+    } else if (BetweenFactor<Pose3>::shared_ptr between3 =
+        boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor)) {
+      w.u8(kBetweenFactorPose3);
+      w.u64(between3->key1());
+      w.u64(between3->key2());
+      writePose3(between3->measured(), w);
+      writeNoise(between3->noiseModel(), w);
+    } else if (GenericProjectionFactor<Pose3, Point3, Cal3_S2>::shared_ptr
+        projection = boost::dynamic_pointer_cast<
+            GenericProjectionFactor<Pose3, Point3, Cal3_S2> >(factor)) {
+      w.u8(kGenericProjectionFactor);
+      w.u64(projection->key1());
+      w.u64(projection->key2());
+      const Point2& measured = projection->measured();
+      w.f64(measured.x());
+      w.f64(measured.y());
+      const Cal3_S2& K = *projection->calibration();
+      w.f64(K.fx());
+      w.f64(K.fy());
+      w.f64(K.skew());
+      w.f64(K.px());
+      w.f64(K.py());
+      uint8_t flags = 0;
+      if (projection->throwCheirality()) flags |= 1;
+      if (projection->verboseCheirality()) flags |= 2;
+      if (projection->body_P_sensor()) flags |= 4;
+      w.u8(flags);
+      if (projection->body_P_sensor())
+        writePose3(*projection->body_P_sensor(), w);
+      writeNoise(projection->noiseModel(), w);
+    } else if (ImuFactor::shared_ptr imu = boost::dynamic_pointer_cast<
+        ImuFactor>(factor)) {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+      w.u8(kImuFactor);
+      for (size_t i = 0; i < 5; ++i)
+        w.u64(imu->keys()[i]);
+      const PreintegratedImuMeasurements& pim =
+          imu->preintegratedMeasurements();
+      const Vector6 biasHat = pim.biasHat().vector();
+      w.doubles(biasHat.data(), 6);
+      w.f64(pim.deltaTij());
+      w.doubles(pim.preintegrated().data(), 9);
+      w.doubles(pim.preintegrated_H_biasAcc().data(), 27);
+      w.doubles(pim.preintegrated_H_biasOmega().data(), 27);
+      const Matrix9 cov = pim.preintMeasCov();
+      w.doubles(cov.data(), 81);
+#else
+      throw invalid_argument(
+          "FactorWireFormat: encoding ImuFactor requires GTSAM built with "
+          "tangent-space preintegration");
+#endif
+    } else {
+      throw invalid_argument(
+          "FactorWireFormat: graph contains an unsupported factor type");
+    }
+  }
+}
+
+/* ************************************************************************* */
+std::string FactorWireFormat::encode(const NonlinearFactorGraph& graph) const {
+  std::string buffer;
+  encode(graph, &buffer);
+  return buffer;
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph FactorWireFormat::decode(const std::string& buffer) const {
+  gttic(FactorWireFormat_decode);
+  Reader r(buffer);
+  if (r.u32() != kMagic)
+    throw invalid_argument("FactorWireFormat: bad magic number");
+  const uint32_t count = r.u32();
+
+  NonlinearFactorGraph graph;
+  graph.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint8_t typeId = r.u8();
+    switch (typeId) {
+    case kPriorFactorPose2: {
+      const Key key = r.u64();
+      const Pose2 prior = readPose2(r);
+      graph.emplace_shared<PriorFactor<Pose2> >(key, prior, readNoise(r));
+      break;
+    }
+    case kPriorFactorPose3: {
+      const Key key = r.u64();
+      const Pose3 prior = readPose3(r);
+      graph.emplace_shared<PriorFactor<Pose3> >(key, prior, readNoise(r));
+      break;
+    }
+    case kBetweenFactorPose2: {
+      const Key key1 = r.u64(), key2 = r.u64();
+      const Pose2 measured = readPose2(r);
+      graph.emplace_shared<BetweenFactor<Pose2> >(key1, key2, measured,
+          readNoise(r));
+      break;
+    }
+    case kBetweenFactorPose3: {
+      const Key key1 = r.u64(), key2 = r.u64();
+      const Pose3 measured = readPose3(r);
+      graph.emplace_shared<BetweenFactor<Pose3> >(key1, key2, measured,
+          readNoise(r));
+      break;
+    }
+    case kGenericProjectionFactor: {
+      const Key poseKey = r.u64(), pointKey = r.u64();
+      const double u = r.f64(), v = r.f64();
+      const double fx = r.f64(), fy = r.f64(), s = r.f64();
+      const double u0 = r.f64(), v0 = r.f64();
+      const uint8_t flags = r.u8();
+      boost::optional<Pose3> body_P_sensor;
+      if (flags & 4)
+        body_P_sensor = readPose3(r);
+      graph.emplace_shared<GenericProjectionFactor<Pose3, Point3, Cal3_S2> >(
+          Point2(u, v), readNoise(r), poseKey, pointKey,
+          boost::make_shared<Cal3_S2>(fx, fy, s, u0, v0), bool(flags & 1),
+          bool(flags & 2), body_P_sensor);
+      break;
+    }
+    case kImuFactor: {
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+      if (!imuParams_)
+        throw invalid_argument(
+            "FactorWireFormat: buffer contains ImuFactors but the codec was "
+            "constructed without preintegration parameters");
+      Key keys[5];
+      for (size_t k = 0; k < 5; ++k)
+        keys[k] = r.u64();
+      Vector6 biasHat;
+      r.doubles(biasHat.data(), 6);
+      const double deltaTij = r.f64();
+      Vector9 preintegrated;
+      r.doubles(preintegrated.data(), 9);
+      Matrix93 H_biasAcc, H_biasOmega;
+      r.doubles(H_biasAcc.data(), 27);
+      r.doubles(H_biasOmega.data(), 27);
+      Matrix9 cov;
+      r.doubles(cov.data(), 81);
+      const WirePreintegration base(imuParams_,
+          imuBias::ConstantBias(biasHat), deltaTij, preintegrated, H_biasAcc,
+          H_biasOmega);
+      const PreintegratedImuMeasurements pim(base, cov);
+      graph.emplace_shared<ImuFactor>(keys[0], keys[1], keys[2], keys[3],
+          keys[4], pim);
+      break;
+#else
+      throw invalid_argument(
+          "FactorWireFormat: decoding ImuFactor requires GTSAM built with "
+          "tangent-space preintegration");
+#endif
+    }
+    default:
+      throw invalid_argument("FactorWireFormat: unknown factor type id");
+    }
+  }
+  return graph;
+}
+
+}
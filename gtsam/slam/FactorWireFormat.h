@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FactorWireFormat.h
+ * @brief   Compact binary wire format for streaming factor graphs between processes
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/navigation/PreintegrationParams.h>
+
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Compact binary wire format for shipping NonlinearFactorGraph deltas
+ * between processes, e.g. a front-end producing factors and a back-end
+ * optimizing them.  Boost text archives spend most of their time formatting
+ * and parsing; this codec writes a fixed layout per factor type - a one-byte
+ * type identifier, the keys, and the measurement and noise model as raw
+ * doubles - so encoding and decoding are linear scans over the buffer with
+ * no text parsing and no per-field allocation.
+ *
+ * Supported factor types: PriorFactor<Pose2>, PriorFactor<Pose3>,
+ * BetweenFactor<Pose2>, BetweenFactor<Pose3>,
+ * GenericProjectionFactor<Pose3, Point3, Cal3_S2>, and ImuFactor (the
+ * latter only when GTSAM is configured with tangent-space preintegration).
+ * Supported noise models: Unit, Isotropic, Diagonal, and full Gaussian.
+ * encode() throws std::invalid_argument for anything else, so senders fail
+ * fast instead of silently dropping factors.
+ *
+ * The preintegration parameters of ImuFactors (gravity, sensor covariances,
+ * ...) are fixed per application and are not sent with every factor; both
+ * ends construct their codec with the same shared PreintegrationParams.
+ *
+ * The format assumes both ends share endianness and IEEE-754 doubles, which
+ * holds for the same-machine inter-process use case it is meant for.
+ */
+class GTSAM_EXPORT FactorWireFormat {
+public:
+
+  /// Factor type identifiers on the wire
+  enum TypeId {
+    kPriorFactorPose2 = 1,
+    kPriorFactorPose3 = 2,
+    kBetweenFactorPose2 = 3,
+    kBetweenFactorPose3 = 4,
+    kGenericProjectionFactor = 5, ///< GenericProjectionFactor<Pose3, Point3, Cal3_S2>
+    kImuFactor = 6
+  };
+
+  /// Construct a codec without ImuFactor decoding support
+  FactorWireFormat() {
+  }
+
+  /// Construct a codec that decodes ImuFactors with the given shared
+  /// preintegration parameters
+  explicit FactorWireFormat(
+      const boost::shared_ptr<PreintegrationParams>& imuParams) :
+      imuParams_(imuParams) {
+  }
+
+  /// Append the encoding of \c graph to \c *buffer.  Null factors are
+  /// skipped.  Throws std::invalid_argument if the graph contains an
+  /// unsupported factor or noise model.
+  void encode(const NonlinearFactorGraph& graph, std::string* buffer) const;
+
+  /// Convenience overload returning a fresh buffer
+  std::string encode(const NonlinearFactorGraph& graph) const;
+
+  /// Decode a buffer produced by encode().  Throws std::invalid_argument on
+  /// malformed input, or if the buffer contains ImuFactors and the codec
+  /// was constructed without preintegration parameters.
+  NonlinearFactorGraph decode(const std::string& buffer) const;
+
+private:
+
+  boost::shared_ptr<PreintegrationParams> imuParams_;
+};
+
+}
@@ -26,6 +26,8 @@
 
 #include <boost/math/special_functions.hpp>
 
+#include <vector>
+
 using namespace std;
 
 namespace gtsam {
@@ -360,4 +362,101 @@ Values InitializePose3::initialize(const NonlinearFactorGraph& graph) {
   return initialize(graph, Values(), false);
 }
 
+/* ************************************************************************* */
+Values InitializePose3::initializeFast(const NonlinearFactorGraph& graph) {
+  gttic(InitializePose3_initializeFast);
+
+  // The measurement and marginal precisions of one Pose3 constraint; priors
+  // become edges from the fictitious anchor, as in buildPose3graph
+  struct Edge {
+    Key key1, key2;
+    Rot3 Rij;
+    Point3 tij;
+    double rotPrecision, transPrecision;
+  };
+
+  // Stream over the graph once, no intermediate factor graph copies
+  std::vector<Edge> edges;
+  edges.reserve(graph.size());
+  for (const auto& factor : graph) {
+    Edge edge;
+    SharedNoiseModel model;
+    const auto pose3Between =
+        boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
+    if (pose3Between) {
+      edge.key1 = pose3Between->key1();
+      edge.key2 = pose3Between->key2();
+      edge.Rij = pose3Between->measured().rotation();
+      edge.tij = pose3Between->measured().translation();
+      model = pose3Between->noiseModel();
+    } else {
+      const auto pose3Prior =
+          boost::dynamic_pointer_cast<PriorFactor<Pose3> >(factor);
+      if (!pose3Prior)
+        continue;
+      edge.key1 = kAnchorKey;
+      edge.key2 = pose3Prior->keys()[0];
+      edge.Rij = pose3Prior->prior().rotation();
+      edge.tij = pose3Prior->prior().translation();
+      model = pose3Prior->noiseModel();
+    }
+    // marginal precisions of the first rotation and translation components,
+    // same trick as buildLinearOrientationGraph
+    Vector rotPrecisions = Vector::Zero(6);
+    rotPrecisions[0] = 1.0;
+    model->whitenInPlace(rotPrecisions);
+    edge.rotPrecision = rotPrecisions[0];
+    Vector transPrecisions = Vector::Zero(6);
+    transPrecisions[3] = 1.0;
+    model->whitenInPlace(transPrecisions);
+    edge.transPrecision = transPrecisions[3];
+    edges.push_back(edge);
+  }
+
+  // Stage 1: chordal rotation relaxation, one sparse linear solve
+  GaussianFactorGraph relaxedGraph;
+  for (const Edge& edge : edges) {
+    Matrix M9 = Z_9x9;
+    const Matrix3 Rij = edge.Rij.matrix();
+    M9.block(0, 0, 3, 3) = Rij;
+    M9.block(3, 3, 3, 3) = Rij;
+    M9.block(6, 6, 3, 3) = Rij;
+    relaxedGraph.add(edge.key1, -I_9x9, edge.key2, M9, Z_9x1,
+        noiseModel::Isotropic::Precision(9, edge.rotPrecision));
+  }
+  relaxedGraph.add(
+      kAnchorKey, I_9x9,
+      (Vector(9) << 1.0, 0.0, 0.0, /*  */ 0.0, 1.0, 0.0, /*  */ 0.0, 0.0, 1.0)
+          .finished(),
+      noiseModel::Isotropic::Precision(9, 1));
+
+  // Both stages have identical connectivity, so one ordering serves both
+  const Ordering ordering = Ordering::Colamd(relaxedGraph);
+  Values rotations =
+      normalizeRelaxedRotations(relaxedGraph.optimize(ordering));
+
+  // Stage 2: with the rotations fixed the translations are linear,
+  // t2 - t1 = R1 * t12, so a single 3-dim solve replaces the GN iteration
+  GaussianFactorGraph translationGraph;
+  for (const Edge& edge : edges) {
+    const Rot3 Ri = (edge.key1 == kAnchorKey) ? Rot3()
+                                              : rotations.at<Rot3>(edge.key1);
+    translationGraph.add(edge.key1, -I_3x3, edge.key2, I_3x3,
+        Ri * edge.tij,
+        noiseModel::Isotropic::Precision(3, edge.transPrecision));
+  }
+  translationGraph.add(kAnchorKey, I_3x3, Z_3x1,
+      noiseModel::Isotropic::Precision(3, 1));
+  const VectorValues translations = translationGraph.optimize(ordering);
+
+  // Assemble the initial estimate, dropping the anchor
+  Values estimate;
+  for (const auto& key_value : rotations) {
+    Key key = key_value.key;
+    estimate.insert(key,
+        Pose3(rotations.at<Rot3>(key), Point3(translations.at(key))));
+  }
+  return estimate;
+}
+
 } // namespace gtsam
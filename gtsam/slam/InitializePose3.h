@@ -83,5 +83,20 @@ struct GTSAM_EXPORT InitializePose3 {
 
   /// Calls initialize above using Chordal method.
   static Values initialize(const NonlinearFactorGraph& graph);
+
+  /**
+   * Streaming initializer for large 3D pose graphs.  Extracts the relative
+   * measurement and the marginal rotation/translation precisions of every
+   * Pose3 constraint in a single pass (no intermediate NonlinearFactorGraph
+   * copies), solves the chordal rotation relaxation, and then solves for the
+   * translations with the rotations held fixed - a single linear solve
+   * instead of the full Gauss-Newton iteration of initialize(), whose
+   * linearization of every BetweenFactor<Pose3> dominates on large graphs.
+   * Both solves share one elimination ordering since the two linear systems
+   * have identical connectivity.  On noise-free graphs the result matches
+   * initialize(); under noise the decoupled translation solve is a close
+   * approximation of the single GN step.
+   */
+  static Values initializeFast(const NonlinearFactorGraph& graph);
 };
 }  // end of namespace gtsam
@@ -167,6 +167,11 @@ namespace gtsam {
       return K_;
     }
 
+    /** return the optional sensor pose in the body frame */
+    inline const boost::optional<POSE>& body_P_sensor() const {
+      return body_P_sensor_;
+    }
+
     /** return verbosity */
     inline bool verboseCheirality() const { return verboseCheirality_; }
 
@@ -41,6 +41,15 @@ protected:
   const Matrix E_; ///< The 2m*3 E Jacobian with respect to the point
   const Vector b_; ///< 2m-dimensional RHS vector
 
+  // The Hessian-vector product below dominates iterative BA solves, so we
+  // precompute a streaming-friendly layout at construction: E stored
+  // transposed makes each camera's 3*ZDim block contiguous in memory (the
+  // FBlocks_ vector of fixed-size matrices is contiguous already), and the
+  // raw offset of each camera's segment in a flat delta vector is cached to
+  // avoid recomputing D*key in the inner loops.
+  Matrix ETranspose_; ///< Packed transpose of E, one contiguous 3*ZDim block per camera
+  std::vector<DenseIndex> offsets_; ///< Raw offset D*keys_[k] of each camera in a flat vector
+
 public:
 
   /// Constructor
@@ -51,7 +60,10 @@ public:
   RegularImplicitSchurFactor(const KeyVector& keys,
       const std::vector<MatrixZD, Eigen::aligned_allocator<MatrixZD> >& FBlocks, const Matrix& E, const Matrix& P,
       const Vector& b) :
-      GaussianFactor(keys), FBlocks_(FBlocks), PointCovariance_(P), E_(E), b_(b) {
+      GaussianFactor(keys), FBlocks_(FBlocks), PointCovariance_(P), E_(E), b_(b),
+      ETranspose_(E.transpose()), offsets_(keys.size()) {
+    for (size_t k = 0; k < keys.size(); ++k)
+      offsets_[k] = D * static_cast<DenseIndex>(keys[k]);
   }
 
   /// Destructor
@@ -359,20 +371,23 @@ public:
 
     // resize does not do malloc if correct size
     e1.resize(size());
-    e2.resize(size());
 
-    // e1 = F * x = (2m*dm)*dm
+    // Fused first pass: e1 = F * x and d1 = E' * e1, using the cached raw
+    // offsets and the packed E transpose so F and E are each streamed once
+    Vector3 d1;
+    d1.setZero();
     for (size_t k = 0; k < size(); ++k) {
-      Key key = keys_[k];
-      e1[k] = FBlocks_[k] * ConstDMap(x + D * key);
+      e1[k] = FBlocks_[k] * ConstDMap(x + offsets_[k]);
+      d1 += ETranspose_.block<3, ZDim>(0, ZDim * k) * e1[k];
     }
 
-    projectError(e1, e2);
+    const Vector3 d2 = PointCovariance_ * d1;
 
-    // y += F.transpose()*e2 = (2d*2m)*2m
+    // Fused second pass: e2 = e1 - E * d2 and y += alpha * F' * e2
     for (size_t k = 0; k < size(); ++k) {
-      Key key = keys_[k];
-      DMap(y + D * key) += FBlocks_[k].transpose() * alpha * e2[k];
+      const Vector2 e2k = e1[k]
+          - ETranspose_.block<3, ZDim>(0, ZDim * k).transpose() * d2;
+      DMap(y + offsets_[k]) += FBlocks_[k].transpose() * (alpha * e2k);
     }
   }
 
@@ -464,8 +479,7 @@ public:
     projectError(e1, e2);
 
     for (size_t k = 0; k < size(); ++k) { // for each camera in the factor
-      Key j = keys_[k];
-      DMap(d + D * j) += -FBlocks_[k].transpose() * e2[k];
+      DMap(d + offsets_[k]) += -FBlocks_[k].transpose() * e2[k];
     }
   }
 
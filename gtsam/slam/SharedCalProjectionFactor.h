@@ -0,0 +1,273 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SharedCalProjectionFactor.h
+ * @brief Projection factor bound to a shared, fixed Cal3_S2 calibration
+ * @author Richard Roberts
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/geometry/CalibratedCamera.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/base/FastMap.h>
+
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * The calibration-derived constants shared by every projection factor
+   * using one fixed Cal3_S2.  For Cal3_S2 the uncalibration map is affine,
+   * so its Jacobian - the fx/fy/skew pipeline - is the constant 2x2 matrix
+   * [fx s; 0 fy], precomputed here once instead of per linearize in every
+   * factor.  One context is typically shared by thousands of factors.
+   * @addtogroup SLAM
+   */
+  class SharedCalibrationContext {
+
+  private:
+
+    boost::shared_ptr<Cal3_S2> K_; ///< the shared calibration
+    Matrix2 Dcal_; ///< constant Jacobian of uncalibrate, [fx s; 0 fy]
+    Vector2 principal_; ///< principal point (u0, v0)
+
+  public:
+
+    /// shorthand for a smart pointer to a context
+    typedef boost::shared_ptr<SharedCalibrationContext> shared_ptr;
+
+    /// Default constructor, for serialization only
+    SharedCalibrationContext() : Dcal_(Matrix2::Identity()), principal_(0, 0) {}
+
+    /// Pre-compute the constants of the given calibration
+    explicit SharedCalibrationContext(const boost::shared_ptr<Cal3_S2>& K) :
+        K_(K), principal_(K->px(), K->py()) {
+      Dcal_ << K->fx(), K->skew(), 0.0, K->fy();
+    }
+
+    /// Apply the calibration to normalized image coordinates
+    Point2 uncalibrate(const Point2& pn) const {
+      return Point2(Dcal_(0, 0) * pn.x() + Dcal_(0, 1) * pn.y() + principal_(0),
+          Dcal_(1, 1) * pn.y() + principal_(1));
+    }
+
+    /// The constant Jacobian of uncalibrate w.r.t. normalized coordinates
+    const Matrix2& Dcal() const { return Dcal_; }
+
+    /// The shared calibration
+    const Cal3_S2& calibration() const { return *K_; }
+
+  private:
+
+    /// Serialization function
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & BOOST_SERIALIZATION_NVP(K_);
+      ar & BOOST_SERIALIZATION_NVP(Dcal_);
+      ar & BOOST_SERIALIZATION_NVP(principal_);
+    }
+  };
+
+  /**
+   * A projection factor for monocular visual SLAM rigs whose calibration is
+   * fixed and shared by all measurements.  Functionally equivalent to
+   * GenericProjectionFactor<Pose3, Point3, Cal3_S2> without a sensor offset,
+   * but the calibration chain is hoisted into a SharedCalibrationContext:
+   * per-factor Jacobian work reduces to the pose/point part of the
+   * projection, followed by one constant 2x2 product.  EvaluateBatch()
+   * additionally hoists the pose-derived quantities across factors sharing
+   * a camera.
+   * @addtogroup SLAM
+   */
+  class SharedCalProjectionFactor: public NoiseModelFactor2<Pose3, Point3> {
+  protected:
+
+    Point2 measured_; ///< 2D measurement
+    SharedCalibrationContext::shared_ptr context_; ///< shared calibration constants
+
+    // verbosity handling for Cheirality Exceptions
+    bool throwCheirality_; ///< If true, rethrows Cheirality exceptions (default: false)
+    bool verboseCheirality_; ///< If true, prints text for Cheirality exceptions (default: false)
+
+  public:
+
+    /// shorthand for base class type
+    typedef NoiseModelFactor2<Pose3, Point3> Base;
+
+    /// shorthand for this class
+    typedef SharedCalProjectionFactor This;
+
+    /// shorthand for a smart pointer to a factor
+    typedef boost::shared_ptr<This> shared_ptr;
+
+    /// Default constructor
+    SharedCalProjectionFactor() :
+        measured_(0, 0), throwCheirality_(false), verboseCheirality_(false) {
+    }
+
+    /**
+     * Constructor
+     * @param measured is the 2 dimensional location of point in image (the measurement)
+     * @param model is the standard deviation
+     * @param poseKey is the index of the camera
+     * @param pointKey is the index of the landmark
+     * @param context the calibration context shared by all factors of the rig
+     */
+    SharedCalProjectionFactor(const Point2& measured, const SharedNoiseModel& model,
+        Key poseKey, Key pointKey, const SharedCalibrationContext::shared_ptr& context) :
+          Base(model, poseKey, pointKey), measured_(measured), context_(context),
+          throwCheirality_(false), verboseCheirality_(false) {}
+
+    /**
+     * Constructor with exception-handling flags
+     * @param throwCheirality determines whether Cheirality exceptions are rethrown
+     * @param verboseCheirality determines whether exceptions are printed for Cheirality
+     */
+    SharedCalProjectionFactor(const Point2& measured, const SharedNoiseModel& model,
+        Key poseKey, Key pointKey, const SharedCalibrationContext::shared_ptr& context,
+        bool throwCheirality, bool verboseCheirality) :
+          Base(model, poseKey, pointKey), measured_(measured), context_(context),
+          throwCheirality_(throwCheirality), verboseCheirality_(verboseCheirality) {}
+
+    /** Virtual destructor */
+    virtual ~SharedCalProjectionFactor() {}
+
+    /// @return a deep copy of this factor
+    virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+      return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+          gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
+
+    /**
+     * print
+     * @param s optional string naming the factor
+     * @param keyFormatter optional formatter useful for printing Symbols
+     */
+    void print(const std::string& s = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+      std::cout << s << "SharedCalProjectionFactor, z = ";
+      traits<Point2>::Print(measured_);
+      Base::print("", keyFormatter);
+    }
+
+    /// equals
+    virtual bool equals(const NonlinearFactor& p, double tol = 1e-9) const {
+      const This *e = dynamic_cast<const This*>(&p);
+      return e
+          && Base::equals(p, tol)
+          && traits<Point2>::Equals(this->measured_, e->measured_, tol)
+          && this->context_->calibration().equals(e->context_->calibration(), tol);
+    }
+
+    /// Evaluate error h(x)-z and optionally derivatives
+    Vector evaluateError(const Pose3& pose, const Point3& point,
+        boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 = boost::none) const {
+      try {
+        // Only the pose/point part of the projection is factor-specific; the
+        // calibration chain is the context's constant 2x2 matrix
+        const CalibratedCamera camera(pose);
+        Matrix26 Dpose;
+        Matrix23 Dpoint;
+        const Point2 pn = camera.project(point, H1 ? &Dpose : 0, H2 ? &Dpoint : 0);
+        if (H1) *H1 = context_->Dcal() * Dpose;
+        if (H2) *H2 = context_->Dcal() * Dpoint;
+        return context_->uncalibrate(pn) - measured_;
+      } catch( CheiralityException& e) {
+        if (H1) *H1 = Matrix::Zero(2,6);
+        if (H2) *H2 = Matrix::Zero(2,3);
+        if (verboseCheirality_)
+          std::cout << e.what() << ": Landmark "<< DefaultKeyFormatter(this->key2()) <<
+              " moved behind camera " << DefaultKeyFormatter(this->key1()) << std::endl;
+        if (throwCheirality_)
+          throw CheiralityException(this->key2());
+      }
+      return Vector2::Constant(2.0 * context_->calibration().fx());
+    }
+
+    /**
+     * Evaluate the unwhitened errors of many factors at once.  The factors
+     * are grouped by pose key so the pose-derived quantities (see
+     * ProjectionContext) are computed once per camera instead of once per
+     * measurement, and each projection finishes with the context's constant
+     * calibration product.  Cheirality failures produce the same fallback
+     * error as evaluateError.
+     * @return the errors as columns of a 2xN matrix, in input order
+     */
+    static Matrix EvaluateBatch(const std::vector<shared_ptr>& factors,
+        const Values& values) {
+      Matrix errors(2, factors.size());
+
+      // Group measurement indices by camera
+      FastMap<Key, std::vector<size_t> > byPose;
+      for (size_t i = 0; i < factors.size(); ++i)
+        byPose[factors[i]->key1()].push_back(i);
+
+      for (const FastMap<Key, std::vector<size_t> >::value_type& group : byPose) {
+        const Pose3& pose = values.at<Pose3>(group.first);
+        const CalibratedCamera camera(pose);
+        const ProjectionContext context = camera.projectionContext();
+        for (size_t i : group.second) {
+          const This& factor = *factors[i];
+          const Point3& point = values.at<Point3>(factor.key2());
+          try {
+            const Point2 pn = camera.project2(point, context);
+            errors.col(i) = Vector2(factor.context_->uncalibrate(pn) - factor.measured_);
+          } catch (CheiralityException&) {
+            errors.col(i) =
+                Vector2::Constant(2.0 * factor.context_->calibration().fx());
+          }
+        }
+      }
+      return errors;
+    }
+
+    /** return the measurement */
+    const Point2& measured() const {
+      return measured_;
+    }
+
+    /** return the calibration context */
+    const SharedCalibrationContext::shared_ptr& context() const {
+      return context_;
+    }
+
+    /** return verbosity */
+    inline bool verboseCheirality() const { return verboseCheirality_; }
+
+    /** return flag for throwing cheirality exceptions */
+    inline bool throwCheirality() const { return throwCheirality_; }
+
+  private:
+
+    /// Serialization function
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+      ar & BOOST_SERIALIZATION_NVP(measured_);
+      ar & BOOST_SERIALIZATION_NVP(context_);
+      ar & BOOST_SERIALIZATION_NVP(throwCheirality_);
+      ar & BOOST_SERIALIZATION_NVP(verboseCheirality_);
+    }
+
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+  /// traits
+  template<>
+  struct traits<SharedCalProjectionFactor> :
+      public Testable<SharedCalProjectionFactor> {
+  };
+
+} // \ namespace gtsam
@@ -126,6 +126,7 @@ protected:
     }
     this->measured_.push_back(measured);
     this->keys_.push_back(key);
+    this->invalidateSortedKeys();
   }
 
   /**
@@ -147,6 +148,7 @@ protected:
       this->measured_.push_back(trackToAdd.measurements[k].second);
       this->keys_.push_back(trackToAdd.measurements[k].first);
     }
+    this->invalidateSortedKeys();
   }
 
   /// get the dimension (number of rows!) of the factor
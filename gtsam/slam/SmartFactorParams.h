@@ -48,6 +48,7 @@ struct SmartProjectionParams {
   /// @{
   TriangulationParameters triangulation;
   double retriangulationThreshold; ///< threshold to decide whether to re-triangulate
+  bool warmStartTriangulation; ///< If true, refine a previously valid point instead of re-triangulating from scratch (default: false)
   /// @}
 
   /// @name Parameters governing how triangulation result is treated
@@ -61,8 +62,8 @@ struct SmartProjectionParams {
       DegeneracyMode degMode = IGNORE_DEGENERACY, bool throwCheirality = false,
       bool verboseCheirality = false, double retriangulationTh = 1e-5) :
         linearizationMode(linMode), degeneracyMode(degMode), retriangulationThreshold(
-            retriangulationTh), throwCheirality(throwCheirality), verboseCheirality(
-                verboseCheirality) {
+            retriangulationTh), warmStartTriangulation(false), throwCheirality(
+                throwCheirality), verboseCheirality(verboseCheirality) {
   }
 
   virtual ~SmartProjectionParams() {
@@ -93,6 +94,9 @@ struct SmartProjectionParams {
   double getRetriangulationThreshold() const {
     return retriangulationThreshold;
   }
+  bool getWarmStartTriangulation() const {
+    return warmStartTriangulation;
+  }
   // set class variables
   void setLinearizationMode(LinearizationMode linMode) {
     linearizationMode = linMode;
@@ -103,6 +107,9 @@ struct SmartProjectionParams {
   void setRetriangulationThreshold(double retriangulationTh) {
     retriangulationThreshold = retriangulationTh;
   }
+  void setWarmStartTriangulation(bool warmStart) {
+    warmStartTriangulation = warmStart;
+  }
   void setRankTolerance(double rankTol) {
     triangulation.rankTolerance = rankTol;
   }
@@ -126,6 +133,7 @@ private:
     ar & BOOST_SERIALIZATION_NVP(degeneracyMode);
     ar & BOOST_SERIALIZATION_NVP(triangulation);
     ar & BOOST_SERIALIZATION_NVP(retriangulationThreshold);
+    ar & BOOST_SERIALIZATION_NVP(warmStartTriangulation);
     ar & BOOST_SERIALIZATION_NVP(throwCheirality);
     ar & BOOST_SERIALIZATION_NVP(verboseCheirality);
   }
@@ -64,6 +64,14 @@ protected:
   mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesTriangulation_; ///< current triangulation poses
   /// @}
 
+  /// @name Caching linearization
+  /// @{
+  mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesLinearization_; ///< poses at which the cached Jacobian rows were computed
+  mutable typename Base::FBlocks cachedFBlocks_; ///< cached F block of each measurement
+  mutable Matrix cachedE_; ///< cached block rows of the point Jacobian E
+  mutable Vector cachedUe_; ///< cached unwhitened reprojection errors
+  /// @}
+
 public:
 
   /// shorthand for a smart pointer to a factor
@@ -160,9 +168,28 @@ public:
       return TriangulationResult::Degenerate();
 
     bool retriangulate = decideIfTriangulate(cameras);
-    if (retriangulate)
-      result_ = gtsam::triangulateSafe(cameras, this->measured_,
-          params_.triangulation);
+    if (retriangulate) {
+      bool warmStarted = false;
+      if (params_.warmStartTriangulation && result_.valid()) {
+        // Stable landmark: the cameras moved, but the cached point is a good
+        // initial guess, so refine it nonlinearly and redo only the cheirality
+        // and outlier checks, skipping the DLT's SVD entirely.
+        const Point3 refined = triangulateNonlinear<CAMERA>(cameras,
+            this->measured_, *result_);
+        const TriangulationResult checked = checkTriangulatedPoint<CAMERA>(
+            cameras, this->measured_, refined, params_.triangulation);
+        if (checked.valid()) {
+          result_ = checked;
+          warmStarted = true;
+        }
+        // A failed check falls through to the full pipeline below, in case
+        // the warm start got trapped rather than the geometry going bad
+      }
+      if (!warmStarted)
+        result_ = gtsam::triangulateSafe(cameras, this->measured_,
+            params_.triangulation);
+      cameraPosesLinearization_.clear(); // a new point invalidates all cached Jacobian rows
+    }
     return result_;
   }
 
@@ -330,6 +357,32 @@ public:
     return triangulateAndComputeE(E, cameras);
   }
 
+  /// Recompute cached Jacobian row i at the current triangulation result.
+  /// This mirrors one block row of Base::unwhitenedError, including the
+  /// body_P_sensor correction, but excluding correctForMissingMeasurements,
+  /// which subclasses may override and which is re-applied on every assembly.
+  void updateCachedJacobianRow(const Cameras& cameras, size_t i) const {
+    typename Base::MatrixZD Fi;
+    Eigen::Matrix<double, Base::ZDim, 3> Ei;
+    const typename CAMERA::Measurement zi = cameras[i].project2(*result_, Fi,
+        Ei);
+    Vector bi = traits<typename CAMERA::Measurement>::Local(
+        this->measured_.at(i), zi);
+    if (Base::ZDim == 3 && std::isnan(bi(1))) // stereo point with missing right pixel
+      bi(1) = 0;
+    if (this->body_P_sensor_) {
+      const Pose3 sensor_P_body = this->body_P_sensor_->inverse();
+      const Pose3 w_Pose_body = cameras[i].pose() * sensor_P_body;
+      Matrix J(6, 6);
+      w_Pose_body.compose(*this->body_P_sensor_, J);
+      Fi = Fi * J;
+    }
+    cachedFBlocks_[i] = Fi;
+    cachedE_.block<Base::ZDim, 3>(Base::ZDim * i, 0) = Ei;
+    cachedUe_.segment<Base::ZDim>(Base::ZDim * i) = bi;
+    cameraPosesLinearization_[i] = cameras[i].pose();
+  }
+
   /// Compute F, E only (called below in both vanilla and SVD versions)
   /// Assumes the point has been computed
   /// Note E can be 2m*3 or 2m*2, in case point is degenerate
@@ -344,8 +397,31 @@ public:
           this->measured_.at(0));
       Base::computeJacobians(Fblocks, E, b, cameras, backProjected);
     } else {
-      // valid result: just return Base version
-      Base::computeJacobians(Fblocks, E, b, cameras, *result_);
+      // valid result: only recompute rows whose camera has moved since they
+      // were cached. Had any pose moved beyond retriangulationThreshold,
+      // triangulateSafe would have retriangulated and cleared the cache, so
+      // a pose matching its cached value guarantees the row is still current.
+      size_t m = cameras.size();
+      if (cameraPosesLinearization_.size() != m) {
+        cameraPosesLinearization_.resize(m);
+        cachedFBlocks_.resize(m);
+        cachedE_.resize(Base::ZDim * m, 3);
+        cachedUe_.resize(Base::ZDim * m);
+        for (size_t i = 0; i < m; i++)
+          updateCachedJacobianRow(cameras, i);
+      } else {
+        for (size_t i = 0; i < m; i++)
+          if (!cameras[i].pose().equals(cameraPosesLinearization_[i],
+              params_.retriangulationThreshold))
+            updateCachedJacobianRow(cameras, i);
+      }
+      // Hand out copies so downstream whitening does not touch the cache,
+      // and re-apply the (possibly overridden) missing-measurement correction
+      Fblocks = cachedFBlocks_;
+      E = cachedE_;
+      Vector ue = cachedUe_;
+      this->correctForMissingMeasurements(cameras, ue, Fblocks, E);
+      b = -ue;
     }
   }
 
@@ -0,0 +1,511 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SmartStereoProjectionFactor.h
+ * @brief  Smart stereo factor on StereoCamera (pose + fixed stereo calibration)
+ * @author Luca Carlone
+ * @author Zsolt Kira
+ * @author Frank Dellaert
+ * @author Chris Beall
+ */
+
+#pragma once
+
+#include <gtsam/slam/SmartFactorBase.h>
+#include <gtsam/slam/SmartFactorParams.h>
+
+#include <gtsam/geometry/StereoCamera.h>
+#include <gtsam/geometry/triangulation.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <boost/optional.hpp>
+#include <boost/make_shared.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/// The stereo smart factors share the parameter struct of the projection ones
+typedef SmartProjectionParams SmartStereoProjectionParams;
+
+/**
+ * SmartStereoProjectionFactor: triangulates a point from rectified stereo
+ * measurements and keeps an estimate of it around.  This factor operates
+ * with StereoCamera, so unlike the monocular SmartProjectionFactor no DLT is
+ * needed: each view with a valid disparity backprojects to a world point
+ * directly, and the per-view points are fused with inverse-depth-variance
+ * weights (see triangulateStereo).  Measurements whose right pixel is NaN
+ * are treated as monocular-only views: they do not contribute depth to the
+ * triangulation, and the corresponding Jacobian rows are zeroed out at
+ * linearization.
+ * This factor requires that values contains the involved StereoCameras.
+ * If the calibration is fixed use SmartStereoProjectionPoseFactor instead!
+ */
+class SmartStereoProjectionFactor: public SmartFactorBase<StereoCamera> {
+
+private:
+  typedef SmartFactorBase<StereoCamera> Base;
+  typedef SmartStereoProjectionFactor This;
+
+protected:
+
+  /// @name Parameters
+  /// @{
+  SmartStereoProjectionParams params_;
+  /// @}
+
+  /// @name Caching triangulation
+  /// @{
+  mutable TriangulationResult result_; ///< result from triangulateSafe
+  mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesTriangulation_; ///< current triangulation poses
+  /// @}
+
+  /// @name Caching linearization
+  /// @{
+  mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesLinearization_; ///< poses at which the cached Jacobian rows were computed
+  mutable Base::FBlocks cachedFBlocks_; ///< cached F block of each measurement
+  mutable Matrix cachedE_; ///< cached block rows of the point Jacobian E
+  mutable Vector cachedUe_; ///< cached unwhitened reprojection errors
+  /// @}
+
+public:
+
+  /// shorthand for a smart pointer to a factor
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /// shorthand for a set of cameras
+  typedef CameraSet<StereoCamera> Cameras;
+
+  /**
+   * Default constructor, only for serialization
+   */
+  SmartStereoProjectionFactor() {}
+
+  /**
+   * Constructor
+   * @param sharedNoiseModel isotropic noise model for the 3D stereo measurements
+   * @param params parameters for the smart stereo projection factors
+   * @param body_P_sensor pose of the camera in the body frame (optional)
+   */
+  SmartStereoProjectionFactor(
+      const SharedNoiseModel& sharedNoiseModel,
+      const SmartStereoProjectionParams& params = SmartStereoProjectionParams(),
+      const boost::optional<Pose3> body_P_sensor = boost::none)
+      : Base(sharedNoiseModel, body_P_sensor),
+        params_(params),
+        result_(TriangulationResult::Degenerate()) {}
+
+  /** Virtual destructor */
+  virtual ~SmartStereoProjectionFactor() {
+  }
+
+  /**
+   * print
+   * @param s optional string naming the factor
+   * @param keyFormatter optional formatter useful for printing Symbols
+   */
+  void print(const std::string& s = "", const KeyFormatter& keyFormatter =
+      DefaultKeyFormatter) const {
+    std::cout << s << "SmartStereoProjectionFactor\n";
+    std::cout << "linearizationMode:\n" << params_.linearizationMode
+        << std::endl;
+    std::cout << "triangulationParameters:\n" << params_.triangulation
+        << std::endl;
+    std::cout << "result:\n" << result_ << std::endl;
+    Base::print("", keyFormatter);
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& p, double tol = 1e-9) const {
+    const This *e = dynamic_cast<const This*>(&p);
+    return e && params_.linearizationMode == e->params_.linearizationMode
+        && Base::equals(p, tol);
+  }
+
+  /// Check if the new linearization point is the same as the one used for previous triangulation
+  bool decideIfTriangulate(const Cameras& cameras) const {
+    // several calls to linearize will be done from the same linearization point, hence it is not needed to re-triangulate
+    // Note that this is not yet "selecting linearization", that will come later, and we only check if the
+    // current linearization is the "same" (up to tolerance) w.r.t. the last time we triangulated the point
+
+    size_t m = cameras.size();
+
+    bool retriangulate = false;
+
+    // if we do not have a previous linearization point or the new linearization point includes more poses
+    if (cameraPosesTriangulation_.empty()
+        || cameras.size() != cameraPosesTriangulation_.size())
+      retriangulate = true;
+
+    if (!retriangulate) {
+      for (size_t i = 0; i < cameras.size(); i++) {
+        if (!cameras[i].pose().equals(cameraPosesTriangulation_[i],
+            params_.retriangulationThreshold)) {
+          retriangulate = true; // at least two poses are different, hence we retriangulate
+          break;
+        }
+      }
+    }
+
+    if (retriangulate) { // we store the current poses used for triangulation
+      cameraPosesTriangulation_.clear();
+      cameraPosesTriangulation_.reserve(m);
+      for (size_t i = 0; i < m; i++)
+        cameraPosesTriangulation_.push_back(cameras[i].pose());
+    }
+
+    return retriangulate; // if we arrive to this point all poses are the same and we don't need re-triangulation
+  }
+
+  /// triangulateSafe
+  TriangulationResult triangulateSafe(const Cameras& cameras) const {
+
+    size_t m = cameras.size();
+    if (m < 2) // if we have a single pose the corresponding factor is uninformative
+      return TriangulationResult::Degenerate();
+
+    // No warm start here: stereo triangulation is a closed-form batch of
+    // backprojections with no SVD, so re-running it is as cheap as checking
+    // a cached point would be
+    bool retriangulate = decideIfTriangulate(cameras);
+    if (retriangulate) {
+      result_ = gtsam::triangulateSafe(cameras, this->measured_,
+          params_.triangulation);
+      cameraPosesLinearization_.clear(); // a new point invalidates all cached Jacobian rows
+    }
+    return result_;
+  }
+
+  /// triangulate
+  bool triangulateForLinearize(const Cameras& cameras) const {
+    triangulateSafe(cameras); // imperative, might reset result_
+    return bool(result_);
+  }
+
+  /// linearize returns a Hessianfactor that is an approximation of error(p)
+  boost::shared_ptr<RegularHessianFactor<Base::Dim> > createHessianFactor(
+      const Cameras& cameras, const double lambda = 0.0, bool diagonalDamping =
+          false) const {
+
+    size_t numKeys = this->keys_.size();
+    // Create structures for Hessian Factors
+    KeyVector js;
+    std::vector<Matrix> Gs(numKeys * (numKeys + 1) / 2);
+    std::vector<Vector> gs(numKeys);
+
+    if (this->measured_.size() != cameras.size())
+      throw std::runtime_error("SmartStereoProjectionHessianFactor: this->"
+                               "measured_.size() inconsistent with input");
+
+    triangulateSafe(cameras);
+
+    if (params_.degeneracyMode == ZERO_ON_DEGENERACY && !result_) {
+      // failed: return "empty" Hessian
+      for(Matrix& m: Gs)
+        m = Matrix::Zero(Base::Dim, Base::Dim);
+      for(Vector& v: gs)
+        v = Vector::Zero(Base::Dim);
+      return boost::make_shared<RegularHessianFactor<Base::Dim> >(this->keys_,
+          Gs, gs, 0.0);
+    }
+
+    // E and F come fused out of a single project2 evaluation per view
+    Base::FBlocks Fblocks;
+    Matrix E;
+    Vector b;
+    computeJacobiansWithTriangulatedPoint(Fblocks, E, b, cameras);
+
+    // Whiten using noise model
+    Base::whitenJacobians(Fblocks, E, b);
+
+    // build augmented hessian
+    SymmetricBlockMatrix augmentedHessian = //
+        Cameras::SchurComplement(Fblocks, E, b, lambda, diagonalDamping);
+
+    return boost::make_shared<RegularHessianFactor<Base::Dim> >(this->keys_,
+        augmentedHessian);
+  }
+
+  /// create factor
+  boost::shared_ptr<JacobianFactorQ<Base::Dim, Base::ZDim> > createJacobianQFactor(
+      const Cameras& cameras, double lambda) const {
+    if (triangulateForLinearize(cameras))
+      return Base::createJacobianQFactor(cameras, *result_, lambda);
+    else
+      // failed: return empty
+      return boost::make_shared<JacobianFactorQ<Base::Dim, Base::ZDim> >(
+          this->keys_);
+  }
+
+  /// different (faster) way to compute Jacobian factor
+  boost::shared_ptr<JacobianFactor> createJacobianSVDFactor(
+      const Cameras& cameras, double lambda) const {
+    if (triangulateForLinearize(cameras))
+      return Base::createJacobianSVDFactor(cameras, *result_, lambda);
+    else
+      // failed: return empty
+      return boost::make_shared<JacobianFactorSVD<Base::Dim, Base::ZDim> >(
+          this->keys_);
+  }
+
+  /**
+   * Linearize to Gaussian Factor
+   * @param cameras stereo cameras corresponding to keys involved in this factor
+   * @return a Gaussian factor
+   */
+  boost::shared_ptr<GaussianFactor> linearizeDamped(const Cameras& cameras,
+      const double lambda = 0.0) const {
+    // depending on flag set on construction we may linearize to different linear factors
+    switch (params_.linearizationMode) {
+    case HESSIAN:
+      return createHessianFactor(cameras, lambda);
+    case JACOBIAN_SVD:
+      return createJacobianSVDFactor(cameras, lambda);
+    case JACOBIAN_Q:
+      return createJacobianQFactor(cameras, lambda);
+    default:
+      // IMPLICIT_SCHUR: RegularImplicitSchurFactor only models 2D errors
+      throw std::runtime_error(
+          "SmartStereoProjectionFactor: unsupported linearization mode");
+    }
+  }
+
+  /**
+   * Linearize to Gaussian Factor
+   * @param values Values structure which must contain camera poses for this factor
+   * @return a Gaussian factor
+   */
+  boost::shared_ptr<GaussianFactor> linearizeDamped(const Values& values,
+      const double lambda = 0.0) const {
+    Cameras cameras = this->cameras(values);
+    return linearizeDamped(cameras, lambda);
+  }
+
+  /// linearize
+  virtual boost::shared_ptr<GaussianFactor> linearize(
+      const Values& values) const {
+    return linearizeDamped(values);
+  }
+
+  /**
+   * Triangulate and compute derivative of error with respect to point
+   * @return whether triangulation worked
+   */
+  bool triangulateAndComputeE(Matrix& E, const Cameras& cameras) const {
+    bool nonDegenerate = triangulateForLinearize(cameras);
+    if (nonDegenerate)
+      cameras.project2(*result_, boost::none, E);
+    return nonDegenerate;
+  }
+
+  /**
+   * Triangulate and compute derivative of error with respect to point
+   * @return whether triangulation worked
+   */
+  bool triangulateAndComputeE(Matrix& E, const Values& values) const {
+    Cameras cameras = this->cameras(values);
+    return triangulateAndComputeE(E, cameras);
+  }
+
+  /// Recompute cached Jacobian row i at the current triangulation result.
+  /// This mirrors one block row of Base::unwhitenedError, including the
+  /// body_P_sensor correction, but excluding correctForMissingMeasurements,
+  /// which is re-applied on every assembly.
+  void updateCachedJacobianRow(const Cameras& cameras, size_t i) const {
+    Base::MatrixZD Fi;
+    Eigen::Matrix<double, Base::ZDim, 3> Ei;
+    const StereoPoint2 zi = cameras[i].project2(*result_, Fi, Ei);
+    Vector bi = traits<StereoPoint2>::Local(this->measured_.at(i), zi);
+    if (std::isnan(bi(1))) // stereo point with missing right pixel
+      bi(1) = 0;
+    if (this->body_P_sensor_) {
+      const Pose3 sensor_P_body = this->body_P_sensor_->inverse();
+      const Pose3 w_Pose_body = cameras[i].pose() * sensor_P_body;
+      Matrix J(6, 6);
+      w_Pose_body.compose(*this->body_P_sensor_, J);
+      Fi = Fi * J;
+    }
+    cachedFBlocks_[i] = Fi;
+    cachedE_.block<Base::ZDim, 3>(Base::ZDim * i, 0) = Ei;
+    cachedUe_.segment<Base::ZDim>(Base::ZDim * i) = bi;
+    cameraPosesLinearization_[i] = cameras[i].pose();
+  }
+
+  /// Compute F, E only (called below in both vanilla and SVD versions)
+  /// Assumes the point has been computed
+  void computeJacobiansWithTriangulatedPoint(Base::FBlocks& Fblocks, Matrix& E,
+      Vector& b, const Cameras& cameras) const {
+
+    if (!result_) {
+      // Handle degeneracy: unlike the monocular factor we cannot fall back
+      // to a point at infinity, since a stereo measurement has no such model
+      throw std::runtime_error("SmartStereoProjectionFactor: "
+          "computeJacobiansWithTriangulatedPoint called without valid point");
+    } else {
+      // valid result: only recompute rows whose camera has moved since they
+      // were cached. Had any pose moved beyond retriangulationThreshold,
+      // triangulateSafe would have retriangulated and cleared the cache, so
+      // a pose matching its cached value guarantees the row is still current.
+      size_t m = cameras.size();
+      if (cameraPosesLinearization_.size() != m) {
+        cameraPosesLinearization_.resize(m);
+        cachedFBlocks_.resize(m);
+        cachedE_.resize(Base::ZDim * m, 3);
+        cachedUe_.resize(Base::ZDim * m);
+        for (size_t i = 0; i < m; i++)
+          updateCachedJacobianRow(cameras, i);
+      } else {
+        for (size_t i = 0; i < m; i++)
+          if (!cameras[i].pose().equals(cameraPosesLinearization_[i],
+              params_.retriangulationThreshold))
+            updateCachedJacobianRow(cameras, i);
+      }
+      // Hand out copies so downstream whitening does not touch the cache,
+      // and re-apply the missing-measurement correction
+      Fblocks = cachedFBlocks_;
+      E = cachedE_;
+      Vector ue = cachedUe_;
+      this->correctForMissingMeasurements(cameras, ue, Fblocks, E);
+      b = -ue;
+    }
+  }
+
+  /// Version that takes values, and creates the point
+  bool triangulateAndComputeJacobians(Base::FBlocks& Fblocks, Matrix& E,
+      Vector& b, const Values& values) const {
+    Cameras cameras = this->cameras(values);
+    bool nonDegenerate = triangulateForLinearize(cameras);
+    if (nonDegenerate)
+      computeJacobiansWithTriangulatedPoint(Fblocks, E, b, cameras);
+    return nonDegenerate;
+  }
+
+  /// takes values
+  bool triangulateAndComputeJacobiansSVD(Base::FBlocks& Fblocks, Matrix& Enull,
+      Vector& b, const Values& values) const {
+    Cameras cameras = this->cameras(values);
+    bool nonDegenerate = triangulateForLinearize(cameras);
+    if (nonDegenerate)
+      Base::computeJacobiansSVD(Fblocks, Enull, b, cameras, *result_);
+    return nonDegenerate;
+  }
+
+  /// Calculate vector of re-projection errors, before applying noise model
+  Vector reprojectionErrorAfterTriangulation(const Values& values) const {
+    Cameras cameras = this->cameras(values);
+    bool nonDegenerate = triangulateForLinearize(cameras);
+    if (nonDegenerate)
+      return Base::unwhitenedError(cameras, *result_);
+    else
+      return Vector::Zero(cameras.size() * Base::ZDim);
+  }
+
+  /**
+   * Zero out the Jacobian rows and error components of monocular-only views,
+   * i.e. measurements whose right pixel is NaN.  The left pixel and the row
+   * coordinate still constrain the problem; only the disparity row vanishes.
+   */
+  virtual void correctForMissingMeasurements(const Cameras& cameras, Vector& ue,
+      boost::optional<typename Cameras::FBlocks&> Fs = boost::none,
+      boost::optional<Matrix&> E = boost::none) const {
+    for (size_t i = 0; i < this->measured_.size(); i++) {
+      if (std::isnan(this->measured_.at(i).uR())) {
+        ue(Base::ZDim * i + 1) = 0.0;
+        if (Fs)
+          Fs->at(i).row(1).setZero();
+        if (E)
+          E->row(Base::ZDim * i + 1).setZero();
+      }
+    }
+  }
+
+  /**
+   * Calculate the error of the factor.
+   * This is the log-likelihood, e.g. \f$ 0.5(h(x)-z)^2/\sigma^2 \f$ in case of Gaussian.
+   * In this class, we take the raw prediction error \f$ h(x)-z \f$, ask the noise model
+   * to transform it to \f$ (h(x)-z)^2/\sigma^2 \f$, and then multiply by 0.5.
+   */
+  double totalReprojectionError(const Cameras& cameras,
+      boost::optional<Point3> externalPoint = boost::none) const {
+
+    if (externalPoint)
+      result_ = TriangulationResult(*externalPoint);
+    else
+      result_ = triangulateSafe(cameras);
+
+    if (result_)
+      // All good, just use version in base class
+      return Base::totalReprojectionError(cameras, *result_);
+    else if (params_.degeneracyMode == HANDLE_INFINITY) {
+      // points at infinity are not modeled for rectified stereo
+      throw std::runtime_error(
+          "SmartStereoProjectionFactor: HANDLE_INFINITY not supported");
+    } else
+      // if we don't want to manage the exceptions we discard the factor
+      return 0.0;
+  }
+
+  /// Calculate total reprojection error
+  virtual double error(const Values& values) const {
+    if (this->active(values)) {
+      return totalReprojectionError(Base::cameras(values));
+    } else { // else of active flag
+      return 0.0;
+    }
+  }
+
+  /** return the landmark */
+  TriangulationResult point() const {
+    return result_;
+  }
+
+  /** COMPUTE the landmark */
+  TriangulationResult point(const Values& values) const {
+    Cameras cameras = this->cameras(values);
+    return triangulateSafe(cameras);
+  }
+
+  /// Is result valid?
+  bool isValid() const { return result_.valid(); }
+
+  /** return the degenerate state */
+  bool isDegenerate() const { return result_.degenerate(); }
+
+  /** return the cheirality status flag */
+  bool isPointBehindCamera() const { return result_.behindCamera(); }
+
+  /** return the outlier state */
+  bool isOutlier() const { return result_.outlier(); }
+
+  /** return the farPoint state */
+  bool isFarPoint() const { return result_.farPoint(); }
+
+ private:
+
+  /// Serialization function
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int version) {
+    ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+    ar & BOOST_SERIALIZATION_NVP(params_);
+    ar & BOOST_SERIALIZATION_NVP(result_);
+    ar & BOOST_SERIALIZATION_NVP(cameraPosesTriangulation_);
+  }
+}
+;
+
+/// traits
+template<>
+struct traits<SmartStereoProjectionFactor> : public Testable<
+    SmartStereoProjectionFactor> {
+};
+
+} // \ namespace gtsam
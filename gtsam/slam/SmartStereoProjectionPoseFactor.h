@@ -0,0 +1,196 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SmartStereoProjectionPoseFactor.h
+ * @brief  Smart stereo factor on poses, assuming camera calibration is fixed
+ * @author Luca Carlone
+ * @author Chris Beall
+ * @author Zsolt Kira
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/slam/SmartStereoProjectionFactor.h>
+
+namespace gtsam {
+/**
+ *
+ * @addtogroup SLAM
+ *
+ * If you are using the factor, please cite:
+ * L. Carlone, Z. Kira, C. Beall, V. Indelman, F. Dellaert, Eliminating conditionally
+ * independent sets in factor graphs: a unifying perspective based on smart factors,
+ * Int. Conf. on Robotics and Automation (ICRA), 2014.
+ *
+ */
+
+/**
+ * This factor assumes that camera calibration is fixed, but each measurement
+ * can carry its own calibration, so mixed rigs (several stereo heads, or an
+ * RGB-D sensor expressed as a virtual stereo pair) are supported.
+ * The factor only constrains poses (variable dimension is 6).
+ * This factor requires that values contains the involved poses (Pose3).
+ * If the calibration should be optimized, as well, use SmartStereoProjectionFactor instead!
+ * @addtogroup SLAM
+ */
+class SmartStereoProjectionPoseFactor: public SmartStereoProjectionFactor {
+
+private:
+  typedef SmartStereoProjectionFactor Base;
+  typedef SmartStereoProjectionPoseFactor This;
+
+protected:
+
+  std::vector<Cal3_S2Stereo::shared_ptr> K_all_; ///< calibration object, one per measurement
+
+public:
+
+  /// shorthand for a smart pointer to a factor
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /**
+   * Default constructor, only for serialization
+   */
+  SmartStereoProjectionPoseFactor() {}
+
+  /**
+   * Constructor
+   * @param sharedNoiseModel isotropic noise model for the 3D stereo measurements
+   * @param params parameters for the smart stereo projection factors
+   * @param body_P_sensor pose of the camera in the body frame (optional)
+   */
+  SmartStereoProjectionPoseFactor(
+      const SharedNoiseModel& sharedNoiseModel,
+      const SmartStereoProjectionParams& params = SmartStereoProjectionParams(),
+      const boost::optional<Pose3> body_P_sensor = boost::none)
+      : Base(sharedNoiseModel, params, body_P_sensor) {
+  }
+
+  /** Virtual destructor */
+  virtual ~SmartStereoProjectionPoseFactor() {
+  }
+
+  /**
+   * add a new measurement and pose key
+   * @param measured stereo measurement (uL, uR, v) of the landmark in this view
+   * @param poseKey key corresponding to the camera observing the landmark
+   * @param K the (fixed) stereo calibration of this camera
+   */
+  void add(const StereoPoint2& measured, const Key& poseKey,
+      const Cal3_S2Stereo::shared_ptr& K) {
+    Base::add(measured, poseKey);
+    K_all_.push_back(K);
+  }
+
+  /**
+   * Variant of the previous one in which we include a set of measurements
+   * @param measurements vector of stereo measurements of a single landmark
+   * @param poseKeys keys corresponding to the cameras observing the landmark
+   * @param Ks vector of calibration objects
+   */
+  void add(const std::vector<StereoPoint2>& measurements,
+      const KeyVector& poseKeys,
+      const std::vector<Cal3_S2Stereo::shared_ptr>& Ks) {
+    for (size_t i = 0; i < measurements.size(); i++) {
+      Base::add(measurements.at(i), poseKeys.at(i));
+      K_all_.push_back(Ks.at(i));
+    }
+  }
+
+  /**
+   * Variant of the previous one in which all measurements share a calibration
+   * @param measurements vector of stereo measurements of a single landmark
+   * @param poseKeys keys corresponding to the cameras observing the landmark
+   * @param K the (known) camera calibration (same for all measurements)
+   */
+  void add(const std::vector<StereoPoint2>& measurements,
+      const KeyVector& poseKeys, const Cal3_S2Stereo::shared_ptr& K) {
+    for (size_t i = 0; i < measurements.size(); i++) {
+      Base::add(measurements.at(i), poseKeys.at(i));
+      K_all_.push_back(K);
+    }
+  }
+
+  /**
+   * print
+   * @param s optional string naming the factor
+   * @param keyFormatter optional formatter useful for printing Symbols
+   */
+  void print(const std::string& s = "", const KeyFormatter& keyFormatter =
+      DefaultKeyFormatter) const {
+    std::cout << s << "SmartStereoProjectionPoseFactor, z = \n ";
+    for (const Cal3_S2Stereo::shared_ptr& K : K_all_)
+      K->print("calibration = ");
+    Base::print("", keyFormatter);
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& p, double tol = 1e-9) const {
+    const This *e = dynamic_cast<const This*>(&p);
+    return e && Base::equals(p, tol);
+  }
+
+  /**
+   * error calculates the error of the factor.
+   */
+  virtual double error(const Values& values) const {
+    if (this->active(values)) {
+      return this->totalReprojectionError(cameras(values));
+    } else { // else of active flag
+      return 0.0;
+    }
+  }
+
+  /** return calibration shared pointers */
+  inline const std::vector<Cal3_S2Stereo::shared_ptr>& calibration() const {
+    return K_all_;
+  }
+
+  /**
+   * Collect all cameras involved in this factor
+   * @param values Values structure which must contain camera poses corresponding
+   * to keys involved in this factor
+   * @return vector of cameras
+   */
+  Base::Cameras cameras(const Values& values) const {
+    Base::Cameras cameras;
+    size_t i = 0;
+    for (const Key& k : this->keys_) {
+      const Pose3 world_P_sensor_k =
+          Base::body_P_sensor_ ? values.at<Pose3>(k) * *Base::body_P_sensor_
+                               : values.at<Pose3>(k);
+      cameras.emplace_back(world_P_sensor_k, K_all_[i++]);
+    }
+    return cameras;
+  }
+
+ private:
+
+  /// Serialization function
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+    ar & BOOST_SERIALIZATION_NVP(K_all_);
+  }
+
+};
+// end of class declaration
+
+/// traits
+template<>
+struct traits<SmartStereoProjectionPoseFactor> : public Testable<
+    SmartStereoProjectionPoseFactor> {
+};
+
+} // \ namespace gtsam
@@ -17,6 +17,7 @@
 
 #include <gtsam/sam/BearingRangeFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
 #include <gtsam/slam/dataset.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Pose2.h>
@@ -37,12 +38,26 @@
 #include <boost/assign/list_inserter.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
 
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
 
+#if !defined(_WIN32)
+#  define GTSAM_POSIX_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 using namespace std;
 namespace fs = boost::filesystem;
 using namespace gtsam::symbol_shorthand;
@@ -375,6 +390,157 @@ GraphAndValues load2D_robust(const string& filename,
   return load2D(filename, model, maxID);
 }
 
+/* ************************************************************************* */
+// Bounded queue shared between the parser thread and the consumer
+struct Load2DReplayer::Queue {
+  boost::mutex mutex;
+  boost::condition_variable notEmpty; ///< signaled when a frame is pushed
+  boost::condition_variable notFull;  ///< signaled when a frame is popped
+  std::deque<Frame> frames;
+  size_t capacity;
+  bool done;      ///< parser finished (successfully or with error)
+  bool aborted;   ///< consumer destroyed, parser should stop
+  std::string error; ///< parse error message, rethrown by next()
+
+  explicit Queue(size_t capacity_) :
+      capacity(capacity_ > 0 ? capacity_ : 1), done(false), aborted(false) {}
+
+  /// Called by the parser; blocks while full, returns false on abort
+  bool push(Frame& frame) {
+    boost::unique_lock<boost::mutex> lock(mutex);
+    while (frames.size() >= capacity && !aborted)
+      notFull.wait(lock);
+    if (aborted)
+      return false;
+    frames.push_back(frame);
+    notEmpty.notify_one();
+    return true;
+  }
+};
+
+/* ************************************************************************* */
+Load2DReplayer::Load2DReplayer(const std::string& filename,
+    SharedNoiseModel model, size_t queueCapacity, NoiseFormat noiseFormat,
+    KernelFunctionType kernelFunctionType) :
+    queue_(boost::make_shared<Queue>(queueCapacity)), filename_(filename),
+    model_(model), noiseFormat_(noiseFormat),
+    kernelFunctionType_(kernelFunctionType) {
+  parser_ = boost::make_shared<boost::thread>(&Load2DReplayer::parse, this);
+}
+
+/* ************************************************************************* */
+Load2DReplayer::~Load2DReplayer() {
+  {
+    boost::unique_lock<boost::mutex> lock(queue_->mutex);
+    queue_->aborted = true;
+    queue_->notFull.notify_all();
+  }
+  if (parser_ && parser_->joinable())
+    parser_->join();
+}
+
+/* ************************************************************************* */
+bool Load2DReplayer::next(Frame& frame) {
+  boost::unique_lock<boost::mutex> lock(queue_->mutex);
+  while (queue_->frames.empty() && !queue_->done)
+    queue_->notEmpty.wait(lock);
+  if (!queue_->frames.empty()) {
+    frame = queue_->frames.front();
+    queue_->frames.pop_front();
+    queue_->notFull.notify_one();
+    return true;
+  }
+  if (!queue_->error.empty())
+    throw runtime_error(queue_->error);
+  return false;
+}
+
+/* ************************************************************************* */
+void Load2DReplayer::parse() {
+  Queue& queue = *queue_;
+  try {
+    ifstream is(filename_.c_str());
+    if (!is)
+      throw invalid_argument(
+          "Load2DReplayer: can not find file " + filename_);
+
+    // Pass 1: read the vertices, cheap relative to the edge noise matrices
+    Values vertices;
+    string tag;
+    while (!is.eof()) {
+      if (!(is >> tag))
+        break;
+      const auto indexed_pose = parseVertex(is, tag);
+      if (indexed_pose)
+        vertices.insert(indexed_pose->first, indexed_pose->second);
+      is.ignore(LINESIZE, '\n');
+    }
+    is.clear();
+    is.seekg(0, ios::beg);
+
+    // Pass 2: stream the edges, emitting a frame whenever the newest pose
+    // index advances.  Loop closures arriving after their frame was emitted
+    // are appended to the frame under construction.
+    SharedNoiseModel model = model_;
+    const bool useModelInFile = !model_;
+    Values emitted; // initial values already placed in some frame
+    Frame frame;
+    bool haveFactors = false;
+    Key framePose = 0;
+    while (!is.eof()) {
+      if (!(is >> tag))
+        break;
+      const auto between_pose = parseEdge(is, tag);
+      if (between_pose) {
+        Key id1, id2;
+        std::tie(id1, id2) = between_pose->first;
+        const Pose2& l1Xl2 = between_pose->second;
+
+        // Consume the noise parameters even if the model is overridden
+        SharedNoiseModel modelInFile = readNoiseModel(is, true, noiseFormat_,
+            kernelFunctionType_);
+        if (useModelInFile)
+          model = modelInFile;
+
+        const Key newer = std::max(id1, id2);
+        if (haveFactors && newer > framePose) {
+          if (!queue.push(frame))
+            return; // consumer destroyed
+          frame = Frame();
+        }
+        framePose = std::max(framePose, newer);
+        haveFactors = true;
+
+        // Initialize poses this factor introduces, as load2D does
+        if (!emitted.exists(id1)) {
+          const Pose2 initial1 = vertices.exists(id1) ?
+              vertices.at<Pose2>(id1) : Pose2();
+          emitted.insert(id1, initial1);
+          frame.second.insert(id1, initial1);
+        }
+        if (!emitted.exists(id2)) {
+          const Pose2 initial2 = vertices.exists(id2) ?
+              vertices.at<Pose2>(id2) : emitted.at<Pose2>(id1) * l1Xl2;
+          emitted.insert(id2, initial2);
+          frame.second.insert(id2, initial2);
+        }
+
+        frame.first.push_back(
+            boost::make_shared<BetweenFactor<Pose2> >(id1, id2, l1Xl2, model));
+      }
+      is.ignore(LINESIZE, '\n');
+    }
+    if (haveFactors)
+      queue.push(frame);
+  } catch (const std::exception& e) {
+    boost::unique_lock<boost::mutex> lock(queue.mutex);
+    queue.error = e.what();
+  }
+  boost::unique_lock<boost::mutex> lock(queue.mutex);
+  queue.done = true;
+  queue.notEmpty.notify_all();
+}
+
 /* ************************************************************************* */
 void save2D(const NonlinearFactorGraph& graph, const Values& config,
     const noiseModel::Diagonal::shared_ptr model, const string& filename) {
@@ -408,6 +574,320 @@ void save2D(const NonlinearFactorGraph& graph, const Values& config,
   stream.close();
 }
 
+/* ************************************************************************* */
+// Support machinery for readG2oFast below
+namespace {
+
+// Raw pose-graph records scanned from a g2o file, before any noise model or
+// factor objects are built.  Doubles are kept in file order; fixed-size
+// arrays make the records trivially copyable for the binary sidecar.
+struct G2oRecords {
+  struct Vertex {
+    Key key;
+    double v[7]; // x y theta | x y z qx qy qz qw
+  };
+  struct Edge {
+    Key key1, key2;
+    double meas[7]; // as Vertex
+    double info[21]; // upper-triangular information entries, file order
+  };
+  std::vector<Vertex> vertices;
+  std::vector<Edge> edges;
+};
+
+// Read-only view of a whole file: memory-mapped where POSIX mmap is
+// available, otherwise read into a heap buffer in one call.  The view is
+// guaranteed to be followed by a NUL so strtod cannot run off the end.
+class MappedFile {
+public:
+  explicit MappedFile(const string& filename)
+      : data_(nullptr), size_(0), mapped_(nullptr), mappedSize_(0) {
+#ifdef GTSAM_POSIX_MMAP
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat status;
+      if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        const size_t size = static_cast<size_t>(status.st_size);
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        // If the size is an exact multiple of the page size there is no
+        // zero-filled tail to act as terminator, so use the buffered path
+        if (size % pageSize != 0) {
+          void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (mapped != MAP_FAILED) {
+            mapped_ = mapped;
+            mappedSize_ = size;
+            data_ = static_cast<const char*>(mapped);
+            size_ = size;
+          }
+        }
+      }
+      close(fd);
+    }
+    if (data_)
+      return;
+#endif
+    ifstream is(filename.c_str(), ios::binary | ios::ate);
+    if (!is)
+      throw invalid_argument("readG2oFast: can not find file " + filename);
+    const size_t size = static_cast<size_t>(is.tellg());
+    is.seekg(0, ios::beg);
+    // Read in one call; the extra byte NUL-terminates the buffer
+    buffer_.resize(size + 1);
+    if (size > 0)
+      is.read(&buffer_[0], size);
+    buffer_[size] = '\0';
+    data_ = buffer_.data();
+    size_ = size;
+  }
+
+  ~MappedFile() {
+#ifdef GTSAM_POSIX_MMAP
+    if (mapped_)
+      munmap(mapped_, mappedSize_);
+#endif
+  }
+
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+  void* mapped_;
+  size_t mappedSize_;
+  std::vector<char> buffer_;
+
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+};
+
+// Zero-allocation scanning primitives over a NUL-terminated character range
+inline void skipBlanks(const char*& p, const char* end) {
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+}
+
+inline void skipLine(const char*& p, const char* end) {
+  while (p != end && *p != '\n') ++p;
+  if (p != end) ++p;
+}
+
+inline bool scanDouble(const char*& p, double* out) {
+  char* parseEnd;
+  *out = strtod(p, &parseEnd);
+  if (parseEnd == p) return false;
+  p = parseEnd;
+  return true;
+}
+
+inline bool scanKey(const char*& p, Key* out) {
+  char* parseEnd;
+  *out = strtoull(p, &parseEnd, 10);
+  if (parseEnd == p) return false;
+  p = parseEnd;
+  return true;
+}
+
+inline bool tagIs(const char* tag, size_t len, const char* expected) {
+  return len == strlen(expected) && memcmp(tag, expected, len) == 0;
+}
+
+// Scan pose vertices and between-pose edges; all other lines are skipped
+void scanG2o(const char* p, const char* end, bool is3D, G2oRecords* records) {
+  const size_t measCount = is3D ? 7 : 3;
+  const size_t infoCount = is3D ? 21 : 6;
+  while (p != end) {
+    skipBlanks(p, end);
+    const char* tag = p;
+    while (p != end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+    const size_t tagLen = p - tag;
+
+    bool isVertex, isEdge;
+    if (is3D) {
+      isVertex = tagIs(tag, tagLen, "VERTEX_SE3:QUAT");
+      isEdge = tagIs(tag, tagLen, "EDGE_SE3:QUAT");
+    } else {
+      isVertex = tagIs(tag, tagLen, "VERTEX_SE2") || tagIs(tag, tagLen, "VERTEX2")
+          || tagIs(tag, tagLen, "VERTEX");
+      isEdge = tagIs(tag, tagLen, "EDGE_SE2") || tagIs(tag, tagLen, "EDGE2")
+          || tagIs(tag, tagLen, "EDGE") || tagIs(tag, tagLen, "ODOMETRY");
+    }
+
+    if (isVertex) {
+      G2oRecords::Vertex vertex;
+      bool ok = scanKey(p, &vertex.key);
+      for (size_t i = 0; ok && i < measCount; ++i)
+        ok = scanDouble(p, &vertex.v[i]);
+      if (ok)
+        records->vertices.push_back(vertex);
+    } else if (isEdge) {
+      G2oRecords::Edge edge;
+      bool ok = scanKey(p, &edge.key1) && scanKey(p, &edge.key2);
+      for (size_t i = 0; ok && i < measCount; ++i)
+        ok = scanDouble(p, &edge.meas[i]);
+      for (size_t i = 0; ok && i < infoCount; ++i)
+        ok = scanDouble(p, &edge.info[i]);
+      if (ok)
+        records->edges.push_back(edge);
+    }
+    skipLine(p, end);
+  }
+}
+
+// Wrap a Gaussian model in the requested robust kernel, as in readNoiseModel
+SharedNoiseModel wrapKernel(const SharedNoiseModel& model,
+    KernelFunctionType kernelFunctionType) {
+  switch (kernelFunctionType) {
+  case KernelFunctionTypeNONE:
+    return model;
+  case KernelFunctionTypeHUBER:
+    return noiseModel::Robust::Create(
+        noiseModel::mEstimator::Huber::Create(1.345), model);
+  case KernelFunctionTypeTUKEY:
+    return noiseModel::Robust::Create(
+        noiseModel::mEstimator::Tukey::Create(4.6851), model);
+  default:
+    throw invalid_argument("readG2oFast: invalid kernel function type");
+  }
+}
+
+// Build the factor graph and initial values from scanned records, with the
+// same conventions as load2D (G2O noise format) and load3D
+GraphAndValues buildFromG2oRecords(const G2oRecords& records, bool is3D,
+    KernelFunctionType kernelFunctionType) {
+  Values::shared_ptr initial(new Values);
+  NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
+  graph->reserve(records.edges.size());
+
+  if (is3D) {
+    for (const auto& vertex : records.vertices) {
+      const double* v = vertex.v;
+      initial->insert(vertex.key,
+          Pose3(Rot3::Quaternion(v[6], v[3], v[4], v[5]), Point3(v[0], v[1], v[2])));
+    }
+    for (const auto& edge : records.edges) {
+      const double* v = edge.meas;
+      Pose3 measured(Rot3::Quaternion(v[6], v[3], v[4], v[5]), Point3(v[0], v[1], v[2]));
+      Matrix m(6, 6);
+      size_t idx = 0;
+      for (size_t i = 0; i < 6; i++) {
+        for (size_t j = i; j < 6; j++) {
+          m(i, j) = edge.info[idx];
+          m(j, i) = edge.info[idx];
+          ++idx;
+        }
+      }
+      // g2o stores translation first, gtsam rotation first
+      Matrix mgtsam(6, 6);
+      mgtsam.block<3, 3>(0, 0) = m.block<3, 3>(3, 3); // cov rotation
+      mgtsam.block<3, 3>(3, 3) = m.block<3, 3>(0, 0); // cov translation
+      mgtsam.block<3, 3>(0, 3) = m.block<3, 3>(0, 3); // off diagonal
+      mgtsam.block<3, 3>(3, 0) = m.block<3, 3>(3, 0); // off diagonal
+      SharedNoiseModel model = wrapKernel(
+          noiseModel::Gaussian::Information(mgtsam), kernelFunctionType);
+      graph->emplace_shared<BetweenFactor<Pose3> >(edge.key1, edge.key2,
+          measured, model);
+    }
+  } else {
+    for (const auto& vertex : records.vertices)
+      initial->insert(vertex.key, Pose2(vertex.v[0], vertex.v[1], vertex.v[2]));
+    for (const auto& edge : records.edges) {
+      const Pose2 l1Xl2(edge.meas[0], edge.meas[1], edge.meas[2]);
+      // i.e., [ v1 v2 v3; v2' v4 v5; v3' v5' v6 ], stored as information
+      const double* v = edge.info;
+      Matrix3 M;
+      M << v[0], v[1], v[2], v[1], v[3], v[4], v[2], v[4], v[5];
+      SharedNoiseModel model = wrapKernel(
+          noiseModel::Gaussian::Information(M, true), kernelFunctionType);
+
+      // Insert vertices if pure odometry file, as in load2D
+      if (!initial->exists(edge.key1))
+        initial->insert(edge.key1, Pose2());
+      if (!initial->exists(edge.key2))
+        initial->insert(edge.key2, initial->at<Pose2>(edge.key1) * l1Xl2);
+
+      graph->emplace_shared<BetweenFactor<Pose2> >(edge.key1, edge.key2,
+          l1Xl2, model);
+    }
+  }
+
+  return make_pair(graph, initial);
+}
+
+// Binary sidecar: a magic header followed by the raw fixed-size records
+const char kSidecarMagic[8] = { 'g', '2', 'o', 'b', 'i', 'n', '0', '1' };
+
+bool readBinarySidecar(const string& filename, bool is3D, G2oRecords* records) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is)
+    return false;
+  char magic[8];
+  char fileIs3D;
+  uint64_t nVertices, nEdges;
+  is.read(magic, sizeof(magic));
+  is.read(&fileIs3D, 1);
+  is.read(reinterpret_cast<char*>(&nVertices), sizeof(nVertices));
+  is.read(reinterpret_cast<char*>(&nEdges), sizeof(nEdges));
+  if (!is || memcmp(magic, kSidecarMagic, sizeof(magic)) != 0
+      || (fileIs3D != 0) != is3D)
+    return false;
+  records->vertices.resize(nVertices);
+  records->edges.resize(nEdges);
+  if (nVertices > 0)
+    is.read(reinterpret_cast<char*>(records->vertices.data()),
+        nVertices * sizeof(G2oRecords::Vertex));
+  if (nEdges > 0)
+    is.read(reinterpret_cast<char*>(records->edges.data()),
+        nEdges * sizeof(G2oRecords::Edge));
+  return bool(is);
+}
+
+void writeBinarySidecar(const string& filename, bool is3D,
+    const G2oRecords& records) {
+  ofstream os(filename.c_str(), ios::binary | ios::trunc);
+  if (!os)
+    return; // best effort, the text file remains authoritative
+  const char fileIs3D = is3D ? 1 : 0;
+  const uint64_t nVertices = records.vertices.size();
+  const uint64_t nEdges = records.edges.size();
+  os.write(kSidecarMagic, sizeof(kSidecarMagic));
+  os.write(&fileIs3D, 1);
+  os.write(reinterpret_cast<const char*>(&nVertices), sizeof(nVertices));
+  os.write(reinterpret_cast<const char*>(&nEdges), sizeof(nEdges));
+  if (nVertices > 0)
+    os.write(reinterpret_cast<const char*>(records.vertices.data()),
+        nVertices * sizeof(G2oRecords::Vertex));
+  if (nEdges > 0)
+    os.write(reinterpret_cast<const char*>(records.edges.data()),
+        nEdges * sizeof(G2oRecords::Edge));
+}
+
+} // namespace
+
+/* ************************************************************************* */
+GraphAndValues readG2oFast(const string& g2oFile, const bool is3D,
+    KernelFunctionType kernelFunctionType, bool useBinarySidecar) {
+  gttic(readG2oFast);
+
+  const string sidecarFile = g2oFile + ".bin";
+  G2oRecords records;
+
+  // Reuse the sidecar if it is up to date with respect to the text file
+  if (useBinarySidecar && fs::exists(sidecarFile) && fs::exists(g2oFile)
+      && fs::last_write_time(sidecarFile) >= fs::last_write_time(g2oFile)
+      && readBinarySidecar(sidecarFile, is3D, &records))
+    return buildFromG2oRecords(records, is3D, kernelFunctionType);
+
+  {
+    MappedFile file(g2oFile);
+    scanG2o(file.begin(), file.end(), is3D, &records);
+  }
+
+  if (useBinarySidecar)
+    writeBinarySidecar(sidecarFile, is3D, records);
+
+  return buildFromG2oRecords(records, is3D, kernelFunctionType);
+}
+
 /* ************************************************************************* */
 GraphAndValues readG2o(const string& g2oFile, const bool is3D,
                        KernelFunctionType kernelFunctionType) {
@@ -424,10 +904,10 @@ GraphAndValues readG2o(const string& g2oFile, const bool is3D,
 }
 
 /* ************************************************************************* */
-void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
-    const string& filename) {
-  fstream stream(filename.c_str(), fstream::out);
+// Formatting shared by writeG2o and G2oStreamWriter below
+namespace {
 
+void writeG2oValues(ostream& stream, const Values& estimate) {
   // save 2D & 3D poses
   for (const auto& key_value : estimate) {
     auto p = dynamic_cast<const GenericValue<Pose2>*>(&key_value.value);
@@ -447,7 +927,9 @@ void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
         << " " << R.toQuaternion().x() << " " << R.toQuaternion().y() << " " << R.toQuaternion().z()
         << " " << R.toQuaternion().w() << endl;
   }
+}
 
+void writeG2oFactors(ostream& stream, const NonlinearFactorGraph& graph) {
   // save edges (2D or 3D)
   for(const auto& factor_: graph) {
     boost::shared_ptr<BetweenFactor<Pose2> > factor =
@@ -507,9 +989,73 @@ void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
       stream << endl;
     }
   }
+}
+
+} // \namespace
+
+/* ************************************************************************* */
+void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
+    const string& filename) {
+  fstream stream(filename.c_str(), fstream::out);
+  writeG2oValues(stream, estimate);
+  writeG2oFactors(stream, graph);
   stream.close();
 }
 
+/* ************************************************************************* */
+G2oStreamWriter::G2oStreamWriter(const std::string& filename) :
+    filename_(filename), factorCount_(0) {
+  // Truncate so the appended stream starts from a clean file
+  fstream stream(filename_.c_str(), fstream::out);
+}
+
+/* ************************************************************************* */
+G2oStreamWriter::~G2oStreamWriter() {
+  flush();
+}
+
+/* ************************************************************************* */
+void G2oStreamWriter::flush() {
+  if (writer_) {
+    writer_->join();
+    writer_.reset();
+  }
+}
+
+/* ************************************************************************* */
+void G2oStreamWriter::save(const NonlinearFactorGraph& graph,
+    const Values& estimate) {
+  // The pending buffers are handed to the background thread, so the previous
+  // save must have finished before they are refilled
+  flush();
+
+  // Snapshot only the factors and values added since the last save.  Copying
+  // here is what lets the caller keep mutating graph and estimate while the
+  // background thread formats and writes.
+  pendingGraph_ = NonlinearFactorGraph();
+  for (size_t i = factorCount_; i < graph.size(); ++i)
+    pendingGraph_.push_back(graph[i]);
+  factorCount_ = graph.size();
+
+  pendingValues_.clear();
+  for (const auto& key_value : estimate) {
+    if (writtenKeys_.exists(key_value.key))
+      continue;
+    pendingValues_.insert(key_value.key, key_value.value);
+    writtenKeys_.insert(key_value.key);
+  }
+
+  writer_ = boost::make_shared<boost::thread>(&G2oStreamWriter::writePending,
+      this);
+}
+
+/* ************************************************************************* */
+void G2oStreamWriter::writePending() {
+  fstream stream(filename_.c_str(), fstream::out | fstream::app);
+  writeG2oValues(stream, pendingValues_);
+  writeG2oFactors(stream, pendingGraph_);
+}
+
 /* ************************************************************************* */
 std::map<Key, Pose3> parse3DPoses(const string& filename) {
   ifstream is(filename.c_str());
@@ -792,6 +1338,106 @@ bool readBAL(const string& filename, SfM_data &data) {
   return true;
 }
 
+/* ************************************************************************* */
+bool readBALStreaming(const string& filename,
+    const std::function<void(size_t, const SfM_Camera&)>& cameraCallback,
+    const std::function<void(size_t, const SfM_Track&)>& trackCallback,
+    const std::function<void(size_t, size_t, size_t)>& headerCallback) {
+  // Load the data file
+  ifstream is(filename.c_str(), ifstream::in);
+  if (!is) {
+    cout << "Error in readBALStreaming: can not find the file!!" << endl;
+    return false;
+  }
+
+  // Get the number of camera poses and 3D points
+  size_t nrPoses, nrPoints, nrObservations;
+  is >> nrPoses >> nrPoints >> nrObservations;
+
+  if (headerCallback)
+    headerCallback(nrPoses, nrPoints, nrObservations);
+
+  // The observation block precedes the point block in the file, so the
+  // per-track measurement lists are the one thing we have to buffer
+  std::vector<std::vector<SfM_Measurement> > measurements(nrPoints);
+  for (size_t k = 0; k < nrObservations; k++) {
+    size_t i = 0, j = 0;
+    float u, v;
+    is >> i >> j >> u >> v;
+    measurements[j].emplace_back(i, Point2(u, -v));
+  }
+
+  // Stream out the cameras
+  for (size_t i = 0; i < nrPoses; i++) {
+    // Get the Rodrigues vector
+    float wx, wy, wz;
+    is >> wx >> wy >> wz;
+    Rot3 R = Rot3::Rodrigues(wx, wy, wz); // BAL-OpenGL rotation matrix
+
+    // Get the translation vector
+    float tx, ty, tz;
+    is >> tx >> ty >> tz;
+
+    Pose3 pose = openGL2gtsam(R, tx, ty, tz);
+
+    // Get the focal length and the radial distortion parameters
+    float f, k1, k2;
+    is >> f >> k1 >> k2;
+    Cal3Bundler K(f, k1, k2);
+
+    if (cameraCallback)
+      cameraCallback(i, SfM_Camera(pose, K));
+  }
+
+  // Stream out the tracks; each measurement list moves into its track and is
+  // released when the track goes out of scope
+  for (size_t j = 0; j < nrPoints; j++) {
+    // Get the 3D position
+    float x, y, z;
+    is >> x >> y >> z;
+    SfM_Track track;
+    track.p = Point3(x, y, z);
+    track.r = 0.4f;
+    track.g = 0.4f;
+    track.b = 0.4f;
+    track.measurements.swap(measurements[j]);
+    if (trackCallback)
+      trackCallback(j, track);
+  }
+
+  is.close();
+  return true;
+}
+
+/* ************************************************************************* */
+GraphAndValues loadBAL(const string& filename, SharedNoiseModel model) {
+  typedef GeneralSFMFactor<SfM_Camera, Point3> ProjectionFactor;
+  if (!model)
+    model = noiseModel::Isotropic::Sigma(2, 1.0); // one pixel in u and v
+
+  NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
+  Values::shared_ptr initial(new Values);
+
+  bool success = readBALStreaming(filename,
+      [&initial](size_t i, const SfM_Camera& camera) {
+        initial->insert(i, camera);
+      },
+      [&graph, &initial, &model](size_t j, const SfM_Track& track) {
+        const Key pointKey = P(j);
+        for (const SfM_Measurement& m : track.measurements)
+          graph->emplace_shared<ProjectionFactor>(m.second, model, m.first,
+              pointKey);
+        initial->insert(pointKey, track.p);
+      },
+      [&graph](size_t nrPoses, size_t nrPoints, size_t nrObservations) {
+        graph->reserve(nrObservations);
+      });
+  if (!success)
+    throw invalid_argument("loadBAL: can not find file " + filename);
+
+  return make_pair(graph, initial);
+}
+
 /* ************************************************************************* */
 bool writeBAL(const string& filename, SfM_data &data) {
   // Open the output file
@@ -28,6 +28,7 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/FastSet.h>
 #include <gtsam/base/types.h>
 
 #include <boost/smart_ptr/shared_ptr.hpp>
@@ -36,6 +37,11 @@
 #include <vector>
 #include <iosfwd>
 #include <map>
+#include <functional>
+
+namespace boost {
+class thread;
+}
 
 namespace gtsam {
 
@@ -134,6 +140,60 @@ GTSAM_EXPORT void save2D(const NonlinearFactorGraph& graph,
     const Values& config, const noiseModel::Diagonal::shared_ptr model,
     const std::string& filename);
 
+/**
+ * Streams a load2D-format pose graph as per-pose frame updates, for
+ * replaying a dataset through an incremental solver such as ISAM2.  A
+ * background thread parses the file ahead of the consumer and keeps a
+ * bounded queue of ready frames, so the per-edge parsing (dominated by the
+ * noise model matrices) overlaps with optimization instead of interleaving
+ * with it.
+ *
+ * A frame holds the between factors whose newer pose index first appears
+ * with that frame, together with initial values for any poses those factors
+ * introduce - vertex values from the file where present, composed from
+ * odometry otherwise, exactly as load2D initializes them.  Feeding every
+ * frame to ISAM2::update in order therefore replays the dataset
+ * incrementally; the union of all frames equals the load2D result for a
+ * pure pose graph.  Bearing-range and landmark lines are skipped - use
+ * load2D for datasets that need them.
+ */
+class GTSAM_EXPORT Load2DReplayer {
+public:
+  /// One incremental update: new factors and initial values for new poses
+  typedef std::pair<NonlinearFactorGraph, Values> Frame;
+
+  /**
+   * Start parsing filename on a background thread.  model, noiseFormat and
+   * kernelFunctionType have the same meaning as in load2D; queueCapacity
+   * bounds how many frames may be parsed ahead of the consumer.
+   */
+  explicit Load2DReplayer(const std::string& filename,
+      SharedNoiseModel model = SharedNoiseModel(), size_t queueCapacity = 8,
+      NoiseFormat noiseFormat = NoiseFormatAUTO,
+      KernelFunctionType kernelFunctionType = KernelFunctionTypeNONE);
+
+  /// Stops the parser thread, discarding any frames not yet consumed
+  ~Load2DReplayer();
+
+  /**
+   * Retrieve the next frame, blocking until the parser has one ready.
+   * Returns false once the dataset is exhausted; rethrows any parse error
+   * encountered on the background thread.
+   */
+  bool next(Frame& frame);
+
+private:
+  void parse();
+
+  struct Queue; ///< shared bounded-queue state, defined in dataset.cpp
+  boost::shared_ptr<Queue> queue_;
+  boost::shared_ptr<boost::thread> parser_;
+  std::string filename_;
+  SharedNoiseModel model_;
+  NoiseFormat noiseFormat_;
+  KernelFunctionType kernelFunctionType_;
+};
+
 /**
  * @brief This function parses a g2o file and stores the measurements into a
  * NonlinearFactorGraph and the initial guess in a Values structure
@@ -145,6 +205,34 @@ GTSAM_EXPORT void save2D(const NonlinearFactorGraph& graph,
 GTSAM_EXPORT GraphAndValues readG2o(const std::string& g2oFile, const bool is3D = false,
     KernelFunctionType kernelFunctionType = KernelFunctionTypeNONE);
 
+/**
+ * @brief Fast pose-graph-only version of readG2o for very large files.
+ *
+ * The file is memory-mapped and parsed with a zero-allocation scanner, which
+ * is an order of magnitude faster than the stringstream-based parser on
+ * multi-million-edge files.  Only pose vertices and between-pose edges are
+ * handled (VERTEX_SE2/VERTEX2/VERTEX and EDGE_SE2/EDGE2/EDGE in 2D,
+ * VERTEX_SE3:QUAT and EDGE_SE3:QUAT in 3D); all other lines are skipped.
+ * Use readG2o for files with landmarks or bearing-range measurements.
+ *
+ * If \c useBinarySidecar is true, a compact binary copy of the parsed records
+ * is written next to the file (suffix ".bin") on first load and reused on
+ * subsequent loads as long as it is newer than the text file, making repeated
+ * loads near-instant.
+ *
+ * On platforms without POSIX mmap the file is instead read into memory with a
+ * single read, which is still far faster than the line-based parser.
+ *
+ * @param filename The name of the g2o file
+ * @param is3D indicates if the file describes a 2D or 3D problem
+ * @param kernelFunctionType whether to wrap the noise model in a robust kernel
+ * @param useBinarySidecar write/reuse a binary sidecar file (default false)
+ * @return graph and initial values
+ */
+GTSAM_EXPORT GraphAndValues readG2oFast(const std::string& g2oFile, const bool is3D = false,
+    KernelFunctionType kernelFunctionType = KernelFunctionTypeNONE,
+    bool useBinarySidecar = false);
+
 /**
  * @brief This function writes a g2o file from
  * NonlinearFactorGraph and a Values structure
@@ -155,6 +243,51 @@ GTSAM_EXPORT GraphAndValues readG2o(const std::string& g2oFile, const bool is3D
 GTSAM_EXPORT void writeG2o(const NonlinearFactorGraph& graph,
     const Values& estimate, const std::string& filename);
 
+/**
+ * A streaming g2o writer for periodic saves during optimization.  Where
+ * writeG2o rewrites the whole graph synchronously, save() appends only the
+ * factors and values added since the previous save, snapshots them into an
+ * internal buffer, and runs the formatting and file I/O on a background
+ * thread so the calling (optimizer) thread returns immediately.
+ *
+ * The output is a valid g2o file provided the graph and values only grow
+ * between saves; entries that were already written are never updated, so
+ * call save once more after optimization converges if final estimates are
+ * wanted (under a fresh filename, or accept duplicate vertex lines that a
+ * g2o reader resolves last-wins).
+ */
+class GTSAM_EXPORT G2oStreamWriter {
+public:
+  /// Create a writer appending to filename, truncating any existing file
+  explicit G2oStreamWriter(const std::string& filename);
+
+  /// Waits for any in-flight background save to finish
+  ~G2oStreamWriter();
+
+  /**
+   * Append the factors and values added since the last save.  The new
+   * entries are copied before returning; the file write then happens on a
+   * background thread, so the caller may keep mutating graph and estimate.
+   */
+  void save(const NonlinearFactorGraph& graph, const Values& estimate);
+
+  /// Block until the most recent background save has reached the file
+  void flush();
+
+  /// Number of factors written or queued for writing so far
+  size_t nrFactors() const { return factorCount_; }
+
+private:
+  void writePending();
+
+  std::string filename_;
+  size_t factorCount_;          ///< factors already queued or written
+  FastSet<Key> writtenKeys_;    ///< values already queued or written
+  NonlinearFactorGraph pendingGraph_;  ///< double buffer read by the writer thread
+  Values pendingValues_;
+  boost::shared_ptr<boost::thread> writer_;  ///< in-flight background save
+};
+
 /// Parse edges in 3D TORO graph file into a set of BetweenFactors.
 using BetweenFactorPose3s = std::vector<gtsam::BetweenFactor<Pose3>::shared_ptr>;
 GTSAM_EXPORT BetweenFactorPose3s parse3DFactors(const std::string& filename);
@@ -216,6 +349,42 @@ GTSAM_EXPORT bool readBundler(const std::string& filename, SfM_data &data);
  */
 GTSAM_EXPORT bool readBAL(const std::string& filename, SfM_data &data);
 
+/**
+ * @brief Parse a "Bundle Adjustment in the Large" (BAL) file, streaming the
+ * result through callbacks instead of materializing a SfM_data.  Cameras are
+ * delivered first, then every track exactly once, each in index order.  Only
+ * the per-track measurement lists are buffered between the observation block
+ * and the point block of the file, and each list is released as soon as its
+ * track callback returns, so peak memory is roughly the measurements alone
+ * rather than a full SfM_data.
+ * @param filename The name of the BAL file
+ * @param cameraCallback invoked as cameraCallback(i, camera) for each camera
+ * @param trackCallback invoked as trackCallback(j, track) for each track
+ * @param headerCallback invoked once, before any other callback, as
+ *        headerCallback(nrCameras, nrTracks, nrObservations), e.g. to
+ *        preallocate storage
+ * @return true if the parsing was successful, false otherwise
+ */
+GTSAM_EXPORT bool readBALStreaming(const std::string& filename,
+    const std::function<void(size_t, const SfM_Camera&)>& cameraCallback,
+    const std::function<void(size_t, const SfM_Track&)>& trackCallback,
+    const std::function<void(size_t, size_t, size_t)>& headerCallback =
+        nullptr);
+
+/**
+ * @brief Build a bundle-adjustment factor graph and initial estimate directly
+ * from a BAL file.  Cameras are keyed by their index i and points by P(j), as
+ * in writeBALfromValues.  The graph is built incrementally on top of
+ * readBALStreaming with factor storage preallocated from the observation
+ * count in the header, so no intermediate SfM_data is ever resident.
+ * @param filename The name of the BAL file
+ * @param model noise model on the projection factors; one pixel in u and v
+ *        if not given
+ * @return graph and initial values
+ */
+GTSAM_EXPORT GraphAndValues loadBAL(const std::string& filename,
+    SharedNoiseModel model = SharedNoiseModel());
+
 /**
  * @brief This function writes a "Bundle Adjustment in the Large" (BAL) file from a
  * SfM_data structure
@@ -6,8 +6,11 @@
  */
 
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <CppUnitLite/TestHarness.h>
 
@@ -68,6 +71,73 @@ TEST(BetweenFactor, ConstructorDynamicSizeVector) {
 }
 */
 
+/* ************************************************************************* */
+typedef BinaryJacobianFactor<3, 3, 3> BinaryJacobianFactor333;
+
+TEST(BetweenFactor, Linearize) {
+  // Fixed-dimension types linearize to a BinaryJacobianFactor
+  BetweenFactor<Pose2> factor(X(1), X(2), Pose2(1, 2, 0.3),
+      Isotropic::Sigma(3, 0.5));
+  Values values;
+  values.insert(X(1), Pose2(0.1, 0.2, 0.1));
+  values.insert(X(2), Pose2(1.2, 2.1, 0.4));
+
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  CHECK(actual);
+  EXPECT(dynamic_cast<BinaryJacobianFactor333*>(actual.get()) != NULL);
+
+  // The result matches the generic NoiseModelFactor linearization
+  GaussianFactor::shared_ptr expected =
+      factor.NoiseModelFactor::linearize(values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+
+  // And contributes the same Hessian blocks during elimination
+  GaussianFactorGraph expectedGraph, actualGraph;
+  expectedGraph.push_back(expected);
+  actualGraph.push_back(actual);
+  EXPECT(assert_equal(expectedGraph.augmentedHessian(),
+      actualGraph.augmentedHessian(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(BetweenFactor, LinearizeFullGaussian) {
+  // Non-diagonal Gaussian models whiten through the virtual WhitenSystem but
+  // still produce a fixed-size factor that matches the generic path
+  Matrix3 covariance;
+  covariance << 0.25, 0.05, 0.0, //
+                0.05, 0.30, 0.1, //
+                0.00, 0.10, 0.5;
+  BetweenFactor<Pose2> factor(X(1), X(2), Pose2(1, 2, 0.3),
+      Gaussian::Covariance(covariance));
+  Values values;
+  values.insert(X(1), Pose2(0.1, 0.2, 0.1));
+  values.insert(X(2), Pose2(1.2, 2.1, 0.4));
+
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  CHECK(actual);
+  EXPECT(dynamic_cast<BinaryJacobianFactor333*>(actual.get()) != NULL);
+  GaussianFactor::shared_ptr expected =
+      factor.NoiseModelFactor::linearize(values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(BetweenFactor, LinearizeConstrained) {
+  // Constrained noise models fall back to the generic path
+  BetweenFactor<Pose2> factor(X(1), X(2), Pose2(1, 2, 0.3),
+      Constrained::All(3));
+  Values values;
+  values.insert(X(1), Pose2(0.1, 0.2, 0.1));
+  values.insert(X(2), Pose2(1.2, 2.1, 0.4));
+
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+  CHECK(actual);
+  EXPECT(dynamic_cast<BinaryJacobianFactor333*>(actual.get()) == NULL);
+  GaussianFactor::shared_ptr expected =
+      factor.NoiseModelFactor::linearize(values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
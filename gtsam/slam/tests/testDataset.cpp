@@ -18,6 +18,7 @@
 
 #include <gtsam/slam/dataset.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/base/TestableAssertions.h>
@@ -26,6 +27,7 @@
 
 #include <CppUnitLite/TestHarness.h>
 
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -90,6 +92,37 @@ TEST( dataSet, load2D)
   EXPECT(assert_equal(expected, *actual));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, load2DReplayer)
+{
+  const string filename = findExampleDataFile("w100.graph");
+
+  // Replay frame by frame with a small queue to exercise the blocking path
+  NonlinearFactorGraph replayedGraph;
+  Values replayedValues;
+  size_t frames = 0;
+  Load2DReplayer replayer(filename, SharedNoiseModel(), 2);
+  Load2DReplayer::Frame frame;
+  while (replayer.next(frame)) {
+    EXPECT(frame.first.size() > 0); // every frame carries at least one factor
+    replayedGraph.push_back(frame.first);
+    replayedValues.insert(frame.second);
+    ++frames;
+  }
+
+  // The union of all frames equals the batch load2D result
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr initial;
+  boost::tie(graph, initial) = load2D(filename);
+  EXPECT_LONGS_EQUAL(99, frames); // one frame per new pose after the first
+  EXPECT(assert_equal(*graph, replayedGraph));
+  EXPECT(assert_equal(*initial, replayedValues));
+
+  // Destroying a replayer mid-stream stops the parser without hanging
+  Load2DReplayer abandoned(filename, SharedNoiseModel(), 2);
+  EXPECT(abandoned.next(frame));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, load2DVictoriaPark)
 {
@@ -328,6 +361,54 @@ TEST( dataSet, readG2oTukey)
   EXPECT(assert_equal(expectedGraph,*actualGraph,1e-5));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, readG2oFast)
+{
+  // The fast scanner must agree exactly with the stringstream-based parser
+  const string g2oFile = findExampleDataFile("pose2example");
+  NonlinearFactorGraph::shared_ptr expectedGraph, actualGraph;
+  Values::shared_ptr expectedValues, actualValues;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile);
+  boost::tie(actualGraph, actualValues) = readG2oFast(g2oFile);
+  EXPECT(assert_equal(*expectedValues, *actualValues, 1e-9));
+  EXPECT(assert_equal(*expectedGraph, *actualGraph, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( dataSet, readG2oFast3D)
+{
+  const string g2oFile = findExampleDataFile("pose3example");
+  NonlinearFactorGraph::shared_ptr expectedGraph, actualGraph;
+  Values::shared_ptr expectedValues, actualValues;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile, true);
+  boost::tie(actualGraph, actualValues) = readG2oFast(g2oFile, true);
+  EXPECT(assert_equal(*expectedValues, *actualValues, 1e-9));
+  EXPECT(assert_equal(*expectedGraph, *actualGraph, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( dataSet, readG2oFastSidecar)
+{
+  // Copy the example file so the sidecar is written in a scratch location
+  const string g2oFile = findExampleDataFile("pose2example");
+  const string copiedFile = createRewrittenFileName(g2oFile);
+  {
+    ifstream src(g2oFile.c_str(), ios::binary);
+    ofstream dst(copiedFile.c_str(), ios::binary | ios::trunc);
+    dst << src.rdbuf();
+  }
+
+  // First load writes the sidecar, second load reads it back
+  NonlinearFactorGraph::shared_ptr expectedGraph, actualGraph;
+  Values::shared_ptr expectedValues, actualValues;
+  boost::tie(expectedGraph, expectedValues) = readG2oFast(copiedFile, false,
+      KernelFunctionTypeNONE, true);
+  boost::tie(actualGraph, actualValues) = readG2oFast(copiedFile, false,
+      KernelFunctionTypeNONE, true);
+  EXPECT(assert_equal(*expectedValues, *actualValues, 1e-9));
+  EXPECT(assert_equal(*expectedGraph, *actualGraph, 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, writeG2o)
 {
@@ -384,6 +465,36 @@ TEST( dataSet, writeG2o3DNonDiagonalNoise)
   EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-4));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, g2oStreamWriter)
+{
+  const string g2oFile = findExampleDataFile("pose2example");
+  NonlinearFactorGraph::shared_ptr expectedGraph;
+  Values::shared_ptr expectedValues;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile);
+
+  // Stream the problem out in two incremental saves: first half the factors,
+  // then the full graph, from which only the new factors should be appended
+  const string filenameToWrite = createRewrittenFileName(g2oFile);
+  G2oStreamWriter writer(filenameToWrite);
+
+  NonlinearFactorGraph partialGraph;
+  const size_t half = expectedGraph->size() / 2;
+  for (size_t i = 0; i < half; ++i)
+    partialGraph.push_back((*expectedGraph)[i]);
+  writer.save(partialGraph, *expectedValues);
+  writer.save(*expectedGraph, *expectedValues);
+  writer.flush();
+  LONGS_EQUAL((long)expectedGraph->size(), (long)writer.nrFactors());
+
+  // The streamed file holds the same problem as a monolithic writeG2o
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readG2o(filenameToWrite);
+  EXPECT(assert_equal(*expectedValues,*actualValues,1e-5));
+  EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-5));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, readBAL_Dubrovnik)
 {
@@ -405,6 +516,91 @@ TEST( dataSet, readBAL_Dubrovnik)
   EXPECT(assert_equal(expected,actual,12));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, readBALStreaming_Dubrovnik)
+{
+  const string filename = findExampleDataFile("dubrovnik-3-7-pre");
+
+  // Collect the streamed data into a SfM_data so we can compare with readBAL
+  SfM_data streamed;
+  size_t headerPoses = 0, headerPoints = 0, headerObservations = 0;
+  CHECK(readBALStreaming(filename,
+      [&](size_t i, const SfM_Camera& camera) {
+        EXPECT_LONGS_EQUAL(i, streamed.number_cameras());
+        streamed.cameras.push_back(camera);
+      },
+      [&](size_t j, const SfM_Track& track) {
+        EXPECT_LONGS_EQUAL(j, streamed.number_tracks());
+        streamed.tracks.push_back(track);
+      },
+      [&](size_t nrPoses, size_t nrPoints, size_t nrObservations) {
+        headerPoses = nrPoses;
+        headerPoints = nrPoints;
+        headerObservations = nrObservations;
+      }));
+
+  // The header matches what was streamed
+  EXPECT_LONGS_EQUAL(3, headerPoses);
+  EXPECT_LONGS_EQUAL(7, headerPoints);
+  EXPECT_LONGS_EQUAL(streamed.number_cameras(), headerPoses);
+  EXPECT_LONGS_EQUAL(streamed.number_tracks(), headerPoints);
+
+  // And the data agrees with the monolithic reader
+  SfM_data expected;
+  CHECK(readBAL(filename, expected));
+  size_t nrObservations = 0;
+  for (size_t i = 0; i < expected.number_cameras(); i++)
+    EXPECT(assert_equal(expected.cameras[i], streamed.cameras[i], 1e-9));
+  for (size_t j = 0; j < expected.number_tracks(); j++) {
+    const SfM_Track &expectedTrack = expected.tracks[j], &actualTrack =
+        streamed.tracks[j];
+    EXPECT(assert_equal(expectedTrack.p, actualTrack.p, 1e-9));
+    EXPECT_LONGS_EQUAL(expectedTrack.number_measurements(),
+        actualTrack.number_measurements());
+    for (size_t k = 0; k < expectedTrack.number_measurements(); k++) {
+      EXPECT_LONGS_EQUAL(expectedTrack.measurements[k].first,
+          actualTrack.measurements[k].first);
+      EXPECT(assert_equal(expectedTrack.measurements[k].second,
+          actualTrack.measurements[k].second, 1e-9));
+    }
+    nrObservations += expectedTrack.number_measurements();
+  }
+  EXPECT_LONGS_EQUAL(nrObservations, headerObservations);
+}
+
+/* ************************************************************************* */
+TEST( dataSet, loadBAL_Dubrovnik)
+{
+  const string filename = findExampleDataFile("dubrovnik-3-7-pre");
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr initial;
+  boost::tie(graph, initial) = loadBAL(filename);
+
+  // Build the same graph the classic way, as in SFMExample_bal
+  SfM_data mydata;
+  CHECK(readBAL(filename, mydata));
+  typedef GeneralSFMFactor<SfM_Camera, Point3> ProjectionFactor;
+  SharedNoiseModel noise = noiseModel::Isotropic::Sigma(2, 1.0);
+  NonlinearFactorGraph expectedGraph;
+  Values expectedInitial;
+  size_t i = 0;
+  for (const SfM_Camera& camera : mydata.cameras)
+    expectedInitial.insert(i++, camera);
+  size_t j = 0;
+  for (const SfM_Track& track : mydata.tracks) {
+    for (const SfM_Measurement& m : track.measurements)
+      expectedGraph.emplace_shared<ProjectionFactor>(m.second, noise, m.first,
+          P(j));
+    expectedInitial.insert(P(j), track.p);
+    j++;
+  }
+
+  EXPECT(assert_equal(expectedGraph, *graph, 1e-9));
+  EXPECT(assert_equal(expectedInitial, *initial, 1e-9));
+  EXPECT_DOUBLES_EQUAL(expectedGraph.error(expectedInitial),
+      graph->error(*initial), 1e-7);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, openGL2gtsam)
 {
@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testFactorWireFormat.cpp
+ * @brief Unit tests for the binary factor graph wire format
+ */
+
+#include <gtsam/slam/FactorWireFormat.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/sam/RangeFactor.h>
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+using symbol_shorthand::V;
+using symbol_shorthand::B;
+
+/* ************************************************************************* */
+TEST(FactorWireFormat, roundTrip) {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Pose2> >(X(0), Pose2(0.1, -0.2, 0.3),
+      noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.1, 0.05)));
+  graph.emplace_shared<BetweenFactor<Pose2> >(X(0), X(1), Pose2(1.0, 0.0, 0.1),
+      noiseModel::Isotropic::Sigma(3, 0.2));
+  graph.emplace_shared<PriorFactor<Pose3> >(X(2),
+      Pose3(Rot3::RzRyRx(0.1, -0.2, 0.3), Point3(1.0, 2.0, 3.0)),
+      noiseModel::Gaussian::Covariance(
+          I_6x6 + 0.1 * Vector6::Ones() * Vector6::Ones().transpose()));
+  graph.emplace_shared<BetweenFactor<Pose3> >(X(2), X(3),
+      Pose3(Rot3::Yaw(0.2), Point3(0.5, 0.0, -0.1)),
+      noiseModel::Unit::Create(6));
+  graph.emplace_shared<GenericProjectionFactor<Pose3, Point3, Cal3_S2> >(
+      Point2(320.5, 240.5), noiseModel::Isotropic::Sigma(2, 1.0), X(2), L(0),
+      boost::make_shared<Cal3_S2>(500.0, 505.0, 0.1, 320.0, 240.0));
+  graph.emplace_shared<GenericProjectionFactor<Pose3, Point3, Cal3_S2> >(
+      Point2(100.0, 200.0), noiseModel::Isotropic::Sigma(2, 0.5), X(3), L(1),
+      boost::make_shared<Cal3_S2>(500.0, 505.0, 0.1, 320.0, 240.0), true,
+      false, Pose3(Rot3::Roll(0.1), Point3(0.0, 0.1, 0.2)));
+
+  FactorWireFormat codec;
+  const string buffer = codec.encode(graph);
+  NonlinearFactorGraph decoded = codec.decode(buffer);
+  EXPECT(assert_equal(graph, decoded));
+
+  // Null factors are skipped, not encoded
+  graph.push_back(NonlinearFactor::shared_ptr());
+  NonlinearFactorGraph decoded2 = codec.decode(codec.encode(graph));
+  EXPECT_LONGS_EQUAL(6, decoded2.size());
+}
+
+/* ************************************************************************* */
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+TEST(FactorWireFormat, imuFactor) {
+  // Integrate a few measurements so all preintegration fields are non-trivial
+  boost::shared_ptr<PreintegrationParams> params =
+      PreintegrationParams::MakeSharedU(9.81);
+  params->accelerometerCovariance = 0.01 * I_3x3;
+  params->gyroscopeCovariance = 0.0001 * I_3x3;
+  params->integrationCovariance = 1e-8 * I_3x3;
+  imuBias::ConstantBias biasHat(Vector3(0.01, -0.02, 0.03),
+      Vector3(0.001, 0.002, -0.001));
+  PreintegratedImuMeasurements pim(params, biasHat);
+  for (size_t i = 0; i < 10; ++i)
+    pim.integrateMeasurement(Vector3(0.1, 0.0, -9.81), Vector3(0.0, 0.0, 0.1),
+        0.01);
+
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<ImuFactor>(X(0), V(0), X(1), V(1), B(0), pim);
+
+  // Both ends share the preintegration parameters out-of-band
+  FactorWireFormat codec(params);
+  NonlinearFactorGraph decoded = codec.decode(codec.encode(graph));
+  EXPECT(assert_equal(graph, decoded));
+
+  // A codec without parameters cannot decode ImuFactors
+  FactorWireFormat plainCodec;
+  CHECK_EXCEPTION(plainCodec.decode(codec.encode(graph)),
+      std::invalid_argument);
+}
+#endif
+
+/* ************************************************************************* */
+TEST(FactorWireFormat, unsupported) {
+  FactorWireFormat codec;
+
+  // Unsupported factor type
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<RangeFactor<Pose2, Point2> >(X(0), L(0), 2.0,
+      noiseModel::Isotropic::Sigma(1, 0.1));
+  CHECK_EXCEPTION(codec.encode(graph), std::invalid_argument);
+
+  // Unsupported (robust) noise model on a supported factor
+  NonlinearFactorGraph robustGraph;
+  robustGraph.emplace_shared<BetweenFactor<Pose2> >(X(0), X(1),
+      Pose2(1.0, 0.0, 0.0),
+      noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.345),
+          noiseModel::Isotropic::Sigma(3, 0.1)));
+  CHECK_EXCEPTION(codec.encode(robustGraph), std::invalid_argument);
+
+  // Corrupted buffers are rejected
+  CHECK_EXCEPTION(codec.decode(std::string("junk")), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
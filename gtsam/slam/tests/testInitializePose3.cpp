@@ -273,6 +273,33 @@ TEST( InitializePose3, initializePoses )
   EXPECT(assert_equal(*expectedValues,initial,0.1));  // TODO(frank): very loose !!
 }
 
+/* ************************************************************************* */
+TEST( InitializePose3, initializeFast )
+{
+  // On the noise-free toy graph the streaming initializer recovers the exact
+  // poses, like initialize()
+  Values initial = InitializePose3::initializeFast(simple::graph());
+  EXPECT(assert_equal(simple::pose0, initial.at<Pose3>(x0), 1e-6));
+  EXPECT(assert_equal(simple::pose1, initial.at<Pose3>(x1), 1e-6));
+  EXPECT(assert_equal(simple::pose2, initial.at<Pose3>(x2), 1e-6));
+  EXPECT(assert_equal(simple::pose3, initial.at<Pose3>(x3), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST( InitializePose3, initializeFastGrid )
+{
+  const string g2oFile = findExampleDataFile("pose3example-grid");
+  NonlinearFactorGraph::shared_ptr inputGraph;
+  Values::shared_ptr expectedValues;
+  bool is3D = true;
+  boost::tie(inputGraph, expectedValues) = readG2o(g2oFile, is3D);
+  noiseModel::Unit::shared_ptr priorModel = noiseModel::Unit::Create(6);
+  inputGraph->add(PriorFactor<Pose3>(0, Pose3(), priorModel));
+
+  Values initial = InitializePose3::initializeFast(*inputGraph);
+  EXPECT(assert_equal(*expectedValues, initial, 0.1));  // same tolerance as initializePoses
+}
+
 
 /* ************************************************************************* */
 int main() {
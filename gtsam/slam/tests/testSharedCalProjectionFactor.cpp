@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  testSharedCalProjectionFactor.cpp
+ *  @brief Unit tests for SharedCalProjectionFactor Class
+ *  @author Richard Roberts
+ */
+
+#include <gtsam/slam/SharedCalProjectionFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// make a realistic calibration matrix, with a little skew to exercise Dcal
+static Cal3_S2::shared_ptr K(new Cal3_S2(500.0, 480.0, 0.1, 320.0, 240.0));
+static SharedCalibrationContext::shared_ptr context(
+    new SharedCalibrationContext(K));
+
+// Create a noise model for the pixel error
+static SharedNoiseModel model(noiseModel::Unit::Create(2));
+
+// Convenience for named keys
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+// The equivalent generic factor, used as reference throughout
+typedef GenericProjectionFactor<Pose3, Point3> ReferenceFactor;
+
+static const Pose3 pose(Rot3(Vector3(1, -1, -1).asDiagonal()), Point3(0, 0, -6));
+static const Point3 point(0.5, -0.2, 0.0);
+
+/* ************************************************************************* */
+TEST( SharedCalProjectionFactor, Error ) {
+  SharedCalProjectionFactor factor(Point2(323, 240), model, X(1), L(1), context);
+  ReferenceFactor expected(Point2(323, 240), model, X(1), L(1), K);
+
+  EXPECT(assert_equal(expected.evaluateError(pose, point),
+      factor.evaluateError(pose, point), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( SharedCalProjectionFactor, Jacobian ) {
+  SharedCalProjectionFactor factor(Point2(323, 240), model, X(1), L(1), context);
+  ReferenceFactor expected(Point2(323, 240), model, X(1), L(1), K);
+
+  // The hoisted calibration chain must reproduce the full-chain Jacobians
+  Matrix H1Actual, H2Actual, H1Expected, H2Expected;
+  factor.evaluateError(pose, point, H1Actual, H2Actual);
+  expected.evaluateError(pose, point, H1Expected, H2Expected);
+  EXPECT(assert_equal(H1Expected, H1Actual, 1e-9));
+  EXPECT(assert_equal(H2Expected, H2Actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( SharedCalProjectionFactor, EvaluateBatch ) {
+  // Two cameras observing two landmarks; all four factors share the context
+  const Pose3 pose2 = pose * Pose3(Rot3(), Point3(0.5, 0, 0));
+  const Point3 point2(-0.3, 0.4, 1.0);
+
+  Values values;
+  values.insert(X(1), pose);
+  values.insert(X(2), pose2);
+  values.insert(L(1), point);
+  values.insert(L(2), point2);
+
+  std::vector<SharedCalProjectionFactor::shared_ptr> factors;
+  factors.push_back(boost::make_shared<SharedCalProjectionFactor>(
+      Point2(323, 240), model, X(1), L(1), context));
+  factors.push_back(boost::make_shared<SharedCalProjectionFactor>(
+      Point2(300, 220), model, X(1), L(2), context));
+  factors.push_back(boost::make_shared<SharedCalProjectionFactor>(
+      Point2(340, 250), model, X(2), L(1), context));
+  factors.push_back(boost::make_shared<SharedCalProjectionFactor>(
+      Point2(310, 230), model, X(2), L(2), context));
+
+  const Matrix errors = SharedCalProjectionFactor::EvaluateBatch(factors, values);
+  LONGS_EQUAL(4, errors.cols());
+  for (size_t i = 0; i < factors.size(); ++i) {
+    const Vector expected = factors[i]->evaluateError(
+        values.at<Pose3>(factors[i]->key1()),
+        values.at<Point3>(factors[i]->key2()));
+    EXPECT(assert_equal(expected, Vector(errors.col(i)), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
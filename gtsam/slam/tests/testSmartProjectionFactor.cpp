@@ -810,6 +810,85 @@ TEST(SmartProjectionFactor, implicitJacobianFactor ) {
   EXPECT(assert_equal(yActual, yExpected, 1e-7));
 }
 
+/* *************************************************************************/
+TEST(SmartProjectionFactor, cachedJacobianRows ) {
+  using namespace vanilla;
+
+  Point2Vector measurements_cam1;
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements_cam1);
+  KeyVector views {c1, c2, c3};
+
+  SmartFactor::shared_ptr cachedFactor(new SmartFactor(unit2));
+  cachedFactor->add(measurements_cam1, views);
+
+  Values values;
+  values.insert(c1, cam1);
+  values.insert(c2, cam2);
+  values.insert(c3, cam3);
+
+  // First linearization fills the Jacobian row cache, the second reuses all
+  // rows; both must agree with a fresh factor that never cached anything
+  cachedFactor->linearize(values);
+  GaussianFactor::shared_ptr cached = cachedFactor->linearize(values);
+  SmartFactor::shared_ptr freshFactor(new SmartFactor(unit2));
+  freshFactor->add(measurements_cam1, views);
+  GaussianFactor::shared_ptr fresh = freshFactor->linearize(values);
+  EXPECT(assert_equal(fresh->augmentedInformation(),
+      cached->augmentedInformation(), 1e-7));
+
+  // Moving a camera beyond retriangulationThreshold invalidates the cache
+  values.update(c3, perturbCameraPose(cam3));
+  cached = cachedFactor->linearize(values);
+  freshFactor.reset(new SmartFactor(unit2));
+  freshFactor->add(measurements_cam1, views);
+  fresh = freshFactor->linearize(values);
+  EXPECT(assert_equal(fresh->augmentedInformation(),
+      cached->augmentedInformation(), 1e-7));
+}
+
+/* *************************************************************************/
+TEST(SmartProjectionFactor, warmStartTriangulation ) {
+  using namespace vanilla;
+
+  Point2Vector measurements_cam1;
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements_cam1);
+  KeyVector views {c1, c2, c3};
+
+  SmartProjectionParams warmParams;
+  warmParams.setWarmStartTriangulation(true);
+  SmartFactor::shared_ptr warmFactor(new SmartFactor(unit2, warmParams));
+  warmFactor->add(measurements_cam1, views);
+
+  Values values;
+  values.insert(c1, cam1);
+  values.insert(c2, cam2);
+  values.insert(c3, cam3);
+
+  // First call triangulates from scratch
+  TriangulationResult warm = warmFactor->point(values);
+  CHECK(warm.valid());
+  EXPECT(assert_equal(landmark1, *warm, 1e-7));
+
+  // Move cameras and landmark by the same rigid transform: the measurements
+  // stay exactly consistent, but every pose moves beyond
+  // retriangulationThreshold, so the next call refines the cached point
+  // instead of triangulating from scratch
+  Pose3 T(Rot3::Ypr(0.1, -0.05, 0.02), Point3(0.3, -0.2, 0.1));
+  values.update(c1, Camera(T * cam1.pose(), cam1.calibration()));
+  values.update(c2, Camera(T * cam2.pose(), cam2.calibration()));
+  values.update(c3, Camera(T * cam3.pose(), cam3.calibration()));
+  TriangulationResult refined = warmFactor->point(values);
+  CHECK(refined.valid());
+  EXPECT(assert_equal(Point3(T * landmark1), *refined, 1e-6));
+
+  // and agrees with a factor that always triangulates from scratch
+  SmartFactor::shared_ptr coldFactor(new SmartFactor(unit2));
+  coldFactor->add(measurements_cam1, views);
+  TriangulationResult cold = coldFactor->point(values);
+  CHECK(cold.valid());
+  EXPECT(assert_equal(*cold, *refined, 1e-6));
+}
+
 /* ************************************************************************* */
 BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Constrained, "gtsam_noiseModel_Constrained");
 BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
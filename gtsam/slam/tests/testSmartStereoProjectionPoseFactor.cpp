@@ -0,0 +1,275 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  testSmartStereoProjectionPoseFactor.cpp
+ *  @brief Unit tests for SmartStereoProjectionPoseFactor Class
+ *  @author Chris Beall
+ *  @author Luca Carlone
+ *  @author Zsolt Kira
+ *  @author Frank Dellaert
+ */
+
+#include <gtsam/slam/SmartStereoProjectionPoseFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <CppUnitLite/TestHarness.h>
+#include <iostream>
+#include <limits>
+
+using namespace gtsam;
+
+// Create a noise model for the stereo error
+static const double sigma = 0.1;
+static SharedIsotropic model(noiseModel::Isotropic::Sigma(3, sigma));
+
+// Convenience for named keys
+using symbol_shorthand::X;
+
+// tests data
+static Symbol x1('X', 1);
+static Symbol x2('X', 2);
+static Symbol x3('X', 3);
+
+static Cal3_S2Stereo::shared_ptr K(
+    new Cal3_S2Stereo(1500, 1200, 0, 640, 480, 0.5));
+
+// three cameras on a baseline along x, all looking down +z
+static Pose3 pose1 = Pose3();
+static Pose3 pose2 = Pose3(Rot3(), Point3(1.0, 0.0, 0.0));
+static Pose3 pose3 = Pose3(Rot3(), Point3(2.0, 0.0, 0.0));
+static StereoCamera cam1(pose1, K);
+static StereoCamera cam2(pose2, K);
+static StereoCamera cam3(pose3, K);
+
+static Point3 landmark1(1.0, 0.5, 5.0);
+static Point3 landmark2(1.5, -0.5, 6.0);
+static Point3 landmark3(0.5, 0.2, 4.0);
+
+LevenbergMarquardtParams lmParams;
+
+/* ************************************************************************* */
+TEST( SmartStereoProjectionPoseFactor, Constructor) {
+  SmartStereoProjectionPoseFactor::shared_ptr factor1(
+      new SmartStereoProjectionPoseFactor(model));
+  factor1->add(cam1.project(landmark1), x1, K);
+}
+
+/* ************************************************************************* */
+TEST( SmartStereoProjectionPoseFactor, Equals ) {
+  SmartStereoProjectionPoseFactor::shared_ptr factor1(
+      new SmartStereoProjectionPoseFactor(model));
+  factor1->add(cam1.project(landmark1), x1, K);
+
+  SmartStereoProjectionPoseFactor::shared_ptr factor2(
+      new SmartStereoProjectionPoseFactor(model));
+  factor2->add(cam1.project(landmark1), x1, K);
+
+  CHECK(assert_equal(*factor1, *factor2));
+}
+
+/* *************************************************************************/
+TEST( triangulateStereo, twoCameras ) {
+
+  // each stereo view determines the point by itself, so the fused point is exact
+  CameraSet<StereoCamera> cameras;
+  cameras.push_back(cam1);
+  cameras.push_back(cam2);
+
+  StereoPoint2Vector measurements;
+  measurements.push_back(cam1.project(landmark1));
+  measurements.push_back(cam2.project(landmark1));
+
+  Point3 actual = triangulateStereo(cameras, measurements);
+  EXPECT(assert_equal(landmark1, actual, 1e-7));
+
+  // the nonlinear refinement should not move a noiseless point
+  Point3 refined = triangulateStereo(cameras, measurements, true);
+  EXPECT(assert_equal(landmark1, refined, 1e-7));
+}
+
+/* *************************************************************************/
+TEST( triangulateStereo, missingRightPixel ) {
+
+  CameraSet<StereoCamera> cameras;
+  cameras.push_back(cam1);
+  cameras.push_back(cam2);
+
+  // the second view lost its right pixel: depth comes from the first alone
+  StereoPoint2 z2 = cam2.project(landmark1);
+  StereoPoint2Vector measurements;
+  measurements.push_back(cam1.project(landmark1));
+  measurements.push_back(StereoPoint2(z2.uL(), std::numeric_limits<double>::quiet_NaN(), z2.v()));
+
+  Point3 actual = triangulateStereo(cameras, measurements);
+  EXPECT(assert_equal(landmark1, actual, 1e-7));
+
+  // no view with a usable disparity at all: underconstrained
+  StereoPoint2Vector monocularOnly(2, measurements.back());
+  CHECK_EXCEPTION(triangulateStereo(cameras, monocularOnly),
+      TriangulationUnderconstrainedException);
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, noiseless ) {
+
+  SmartStereoProjectionPoseFactor factor(model);
+  factor.add(cam1.project(landmark1), x1, K);
+  factor.add(cam2.project(landmark1), x2, K);
+
+  Values values; // it's a pose factor, hence these are poses
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+
+  double actualError = factor.error(values);
+  EXPECT_DOUBLES_EQUAL(0.0, actualError, 1e-7);
+
+  TriangulationResult point = factor.point(values);
+  EXPECT(point.valid());
+  EXPECT(assert_equal(landmark1, *point, 1e-7));
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, monocularFallback ) {
+
+  // the third view has no right pixel; the factor must still triangulate
+  // and linearize, with the disparity row of that view zeroed out
+  SmartStereoProjectionPoseFactor factor(model);
+  factor.add(cam1.project(landmark1), x1, K);
+  factor.add(cam2.project(landmark1), x2, K);
+  StereoPoint2 z3 = cam3.project(landmark1);
+  factor.add(StereoPoint2(z3.uL(), std::numeric_limits<double>::quiet_NaN(), z3.v()), x3, K);
+
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+  values.insert(x3, pose3);
+
+  double actualError = factor.error(values);
+  EXPECT_DOUBLES_EQUAL(0.0, actualError, 1e-7);
+  EXPECT(factor.point(values).valid());
+
+  boost::shared_ptr<GaussianFactor> hessianFactor = factor.linearize(values);
+  CHECK(hessianFactor);
+  EXPECT_DOUBLES_EQUAL(0.0, hessianFactor->error(values.zeroVectors()), 1e-7);
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, 3poses_smart_projection_factor ) {
+
+  // three landmarks seen by three cameras, third pose perturbed and recovered
+  std::vector<StereoPoint2> measurements_l1, measurements_l2, measurements_l3;
+  for (const StereoCamera& cam : {cam1, cam2, cam3}) {
+    measurements_l1.push_back(cam.project(landmark1));
+    measurements_l2.push_back(cam.project(landmark2));
+    measurements_l3.push_back(cam.project(landmark3));
+  }
+
+  KeyVector views;
+  views.push_back(x1);
+  views.push_back(x2);
+  views.push_back(x3);
+
+  SmartStereoProjectionPoseFactor::shared_ptr smartFactor1(
+      new SmartStereoProjectionPoseFactor(model));
+  smartFactor1->add(measurements_l1, views, K);
+
+  SmartStereoProjectionPoseFactor::shared_ptr smartFactor2(
+      new SmartStereoProjectionPoseFactor(model));
+  smartFactor2->add(measurements_l2, views, K);
+
+  SmartStereoProjectionPoseFactor::shared_ptr smartFactor3(
+      new SmartStereoProjectionPoseFactor(model));
+  smartFactor3->add(measurements_l3, views, K);
+
+  const SharedDiagonal noisePrior = noiseModel::Isotropic::Sigma(6, 1e-10);
+
+  NonlinearFactorGraph graph;
+  graph.push_back(smartFactor1);
+  graph.push_back(smartFactor2);
+  graph.push_back(smartFactor3);
+  graph.emplace_shared<PriorFactor<Pose3> >(x1, pose1, noisePrior);
+  graph.emplace_shared<PriorFactor<Pose3> >(x2, pose2, noisePrior);
+
+  // initialize third pose with a large error
+  Pose3 noise_pose = Pose3(Rot3::Ypr(-0.01, 0.01, 0.01),
+      Point3(0.1, -0.1, 0.1));
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+  values.insert(x3, pose3 * noise_pose);
+
+  Values result;
+  LevenbergMarquardtOptimizer optimizer(graph, values, lmParams);
+  result = optimizer.optimize();
+  EXPECT(assert_equal(pose3, result.at<Pose3>(x3), 1e-5));
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, jacobianSVD ) {
+
+  std::vector<StereoPoint2> measurements_l1;
+  for (const StereoCamera& cam : {cam1, cam2, cam3})
+    measurements_l1.push_back(cam.project(landmark1));
+
+  KeyVector views;
+  views.push_back(x1);
+  views.push_back(x2);
+  views.push_back(x3);
+
+  SmartStereoProjectionParams params;
+  params.setLinearizationMode(JACOBIAN_SVD);
+
+  SmartStereoProjectionPoseFactor factor(model, params);
+  factor.add(measurements_l1, views, K);
+
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+  values.insert(x3, pose3);
+
+  boost::shared_ptr<GaussianFactor> jacobianFactor = factor.linearize(values);
+  CHECK(jacobianFactor);
+  EXPECT_DOUBLES_EQUAL(0.0, jacobianFactor->error(values.zeroVectors()), 1e-7);
+}
+
+/* *************************************************************************/
+TEST( SmartStereoProjectionPoseFactor, landmarkDistance ) {
+
+  // landmark further than the threshold: degenerate, and with
+  // ZERO_ON_DEGENERACY the factor becomes a zero Hessian
+  SmartStereoProjectionParams params;
+  params.setLandmarkDistanceThreshold(2.0);
+  params.setDegeneracyMode(ZERO_ON_DEGENERACY);
+
+  SmartStereoProjectionPoseFactor factor(model, params);
+  factor.add(cam1.project(landmark1), x1, K);
+  factor.add(cam2.project(landmark1), x2, K);
+
+  Values values;
+  values.insert(x1, pose1);
+  values.insert(x2, pose2);
+
+  EXPECT_DOUBLES_EQUAL(0.0, factor.error(values), 1e-7);
+  EXPECT(factor.isFarPoint());
+
+  boost::shared_ptr<GaussianFactor> hessianFactor = factor.linearize(values);
+  CHECK(hessianFactor);
+  Matrix information = hessianFactor->information();
+  EXPECT(assert_equal(Matrix(Matrix::Zero(12, 12)), information, 1e-9));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SymbolicEliminationCache.cpp
+ * @brief Cache of symbolic elimination results keyed by graph structure
+ * @date Aug 29, 2026
+ */
+
+#include <gtsam/symbolic/SymbolicEliminationCache.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/functional/hash.hpp>
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  SymbolicEliminationCache::Signature SymbolicEliminationCache::MakeSignature(
+      const SymbolicFactorGraph& graph) {
+    Signature signature;
+    signature.reserve(graph.size());
+    for (const SymbolicFactor::shared_ptr& factor : graph) {
+      if (factor)
+        signature.push_back(factor->keys());
+      else
+        signature.push_back(KeyVector());
+    }
+    return signature;
+  }
+
+  /* ************************************************************************* */
+  size_t SymbolicEliminationCache::Hash(const Signature& signature,
+      const Ordering& ordering, bool orderingWasGiven) {
+    size_t seed = boost::hash_value(signature.size());
+    for (const KeyVector& keys : signature) {
+      boost::hash_combine(seed, keys.size());
+      for (Key key : keys)
+        boost::hash_combine(seed, key);
+    }
+    boost::hash_combine(seed, orderingWasGiven);
+    if (orderingWasGiven)
+      for (Key key : ordering)
+        boost::hash_combine(seed, key);
+    return seed;
+  }
+
+  /* ************************************************************************* */
+  const SymbolicEliminationCache::Entry& SymbolicEliminationCache::lookup(
+      const SymbolicFactorGraph& graph, const Ordering& ordering,
+      bool orderingWasGiven) {
+    gttic(SymbolicEliminationCache_lookup);
+    Signature signature = MakeSignature(graph);
+    std::vector<Entry>& entries = cache_[Hash(signature, ordering,
+        orderingWasGiven)];
+
+    // Verify the full structure so a hash collision cannot return a wrong tree
+    for (const Entry& entry : entries) {
+      if (entry.orderingWasGiven == orderingWasGiven
+          && entry.signature == signature
+          && (!orderingWasGiven || entry.ordering == ordering))
+        return entry;
+    }
+
+    // Not cached yet - eliminate and remember the result
+    gttic(SymbolicEliminationCache_eliminate);
+    Entry entry;
+    entry.signature = signature;
+    entry.orderingWasGiven = orderingWasGiven;
+    entry.ordering = orderingWasGiven ? ordering : Ordering::Colamd(graph);
+    entry.bayesTree = graph.eliminateMultifrontal(entry.ordering);
+    entries.push_back(entry);
+    ++count_;
+    return entries.back();
+  }
+
+  /* ************************************************************************* */
+  SymbolicBayesTree::shared_ptr SymbolicEliminationCache::eliminateMultifrontal(
+      const SymbolicFactorGraph& graph, const Ordering& ordering) {
+    return lookup(graph, ordering, true).bayesTree;
+  }
+
+  /* ************************************************************************* */
+  std::pair<SymbolicBayesTree::shared_ptr, Ordering>
+  SymbolicEliminationCache::eliminateMultifrontal(
+      const SymbolicFactorGraph& graph) {
+    const Entry& entry = lookup(graph, Ordering(), false);
+    return std::make_pair(entry.bayesTree, entry.ordering);
+  }
+
+} // \ namespace gtsam
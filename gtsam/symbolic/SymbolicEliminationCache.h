@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SymbolicEliminationCache.h
+ * @brief Cache of symbolic elimination results keyed by graph structure
+ * @date Aug 29, 2026
+ */
+
+#pragma once
+
+#include <gtsam/symbolic/SymbolicBayesTree.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastMap.h>
+
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+  /**
+   * A cache that recognizes previously eliminated symbolic factor graphs by their
+   * structure and returns the cached SymbolicBayesTree (and ordering) instead of
+   * repeating the symbolic phase.  Problems with recurring structure, such as
+   * fixed-lag windows whose topology is identical every frame, thereby reduce
+   * repeated symbolic elimination to a hash lookup.
+   *
+   * Entries are matched on a hash of the factor key lists, then verified against
+   * the full structure, so hash collisions cannot return a wrong result.  The
+   * returned Bayes trees are shared between the cache and all callers and must
+   * not be modified.
+   */
+  class GTSAM_EXPORT SymbolicEliminationCache {
+  public:
+
+    /** Eliminate the graph multifrontally with the given ordering, reusing the
+     * cached Bayes tree if a graph with identical structure was already
+     * eliminated with the same ordering. */
+    SymbolicBayesTree::shared_ptr eliminateMultifrontal(
+        const SymbolicFactorGraph& graph, const Ordering& ordering);
+
+    /** Eliminate the graph multifrontally with a COLAMD ordering, computing the
+     * ordering only once per graph structure.  Returns the Bayes tree along
+     * with the ordering that produced it. */
+    std::pair<SymbolicBayesTree::shared_ptr, Ordering> eliminateMultifrontal(
+        const SymbolicFactorGraph& graph);
+
+    /** Number of cached elimination results */
+    size_t size() const { return count_; }
+
+    /** Remove all cached results */
+    void clear() { cache_.clear(); count_ = 0; }
+
+  private:
+
+    /// The factor key lists that identify a graph structure
+    typedef std::vector<KeyVector> Signature;
+
+    /// A cached elimination result, storing the signature to verify hash matches
+    struct Entry {
+      Signature signature;
+      Ordering ordering;
+      bool orderingWasGiven;
+      SymbolicBayesTree::shared_ptr bayesTree;
+    };
+
+    static Signature MakeSignature(const SymbolicFactorGraph& graph);
+    static size_t Hash(const Signature& signature, const Ordering& ordering,
+        bool orderingWasGiven);
+
+    /// Look up or compute the entry for the given graph and ordering
+    const Entry& lookup(const SymbolicFactorGraph& graph,
+        const Ordering& ordering, bool orderingWasGiven);
+
+    FastMap<size_t, std::vector<Entry> > cache_;
+    size_t count_ = 0;
+  };
+
+} // \ namespace gtsam
@@ -30,6 +30,7 @@ namespace gtsam {
   // Instantiate base classes
   template class FactorGraph<SymbolicFactor>;
   template class EliminateableFactorGraph<SymbolicFactorGraph>;
+  template class MultifrontalPlan<SymbolicFactorGraph>;
 
   using namespace std;
 
@@ -31,4 +31,10 @@ namespace gtsam {
     const SymbolicEliminationTree& eliminationTree) :
   Base(eliminationTree) {}
 
+  /* ************************************************************************* */
+  SymbolicJunctionTree::SymbolicJunctionTree(
+    const SymbolicEliminationTree& eliminationTree,
+    const AmalgamationPolicy& policy) :
+  Base(eliminationTree, policy) {}
+
 }
@@ -61,6 +61,11 @@ namespace gtsam {
     * @return The elimination tree
     */
     SymbolicJunctionTree(const SymbolicEliminationTree& eliminationTree);
+
+    /** Build the junction tree from an elimination tree, amalgamating cliques
+     *  according to the given policy. */
+    SymbolicJunctionTree(const SymbolicEliminationTree& eliminationTree,
+        const AmalgamationPolicy& policy);
   };
 
 }
@@ -113,6 +113,36 @@ TEST(SymbolicBayesTree, clique_structure)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(SymbolicBayesTree, findCliques)
+{
+  SymbolicFactorGraph graph;
+  graph += SymbolicFactor(X(1), L(1));
+  graph += SymbolicFactor(X(1), X(2));
+  graph += SymbolicFactor(X(2), L(1));
+  graph += SymbolicFactor(X(2), X(3));
+  graph += SymbolicFactor(X(3), X(4));
+  graph += SymbolicFactor(X(4), L(2));
+  graph += SymbolicFactor(X(4), X(5));
+  graph += SymbolicFactor(L(2), X(5));
+  graph += SymbolicFactor(X(4), L(3));
+  graph += SymbolicFactor(X(5), L(3));
+
+  Ordering order = list_of(X(1)) (L(3)) (L(1)) (X(5)) (X(2)) (L(2)) (X(4)) (X(3));
+  SymbolicBayesTree bayesTree = *graph.eliminateMultifrontal(order);
+
+  // X(5) and L(2) share a clique, so the result is deduplicated; unknown keys
+  // are skipped
+  KeyVector keys = list_of(X(5)) (L(2)) (X(1)) (X(9));
+  SymbolicBayesTree::Cliques cliques = bayesTree.findCliques(keys);
+  SymbolicBayesTree::Cliques expectedCliques;
+  expectedCliques += bayesTree[X(5)], bayesTree[X(1)];
+  CHECK(assert_container_equal(expectedCliques|indirected, cliques|indirected));
+
+  // An empty query returns no cliques
+  EXPECT_LONGS_EQUAL(0, bayesTree.findCliques(KeyVector()).size());
+}
+
 /* ************************************************************************* *
 Bayes Tree for testing conversion to a forest of orphans needed for incremental.
        A,B
@@ -268,6 +298,52 @@ TEST( BayesTree, shortcutCheck )
 //  }
 }
 
+/* ************************************************************************* */
+TEST( BayesTree, separatorMarginalBudget )
+{
+  const Key _A_=6, _B_=5, _C_=4, _D_=3, _E_=2, _F_=1, _G_=0;
+  SymbolicFactorGraph chain = list_of
+    (SymbolicFactor(_A_))
+    (SymbolicFactor(_B_, _A_))
+    (SymbolicFactor(_C_, _A_))
+    (SymbolicFactor(_D_, _C_))
+    (SymbolicFactor(_E_, _B_))
+    (SymbolicFactor(_F_, _E_))
+    (SymbolicFactor(_G_, _F_));
+  Ordering ordering(list_of(_G_)(_F_)(_E_)(_D_)(_C_)(_B_)(_A_));
+  SymbolicBayesTree bayesTree = *chain.eliminateMultifrontal(ordering);
+
+  typedef SymbolicBayesTreeClique Clique;
+  SymbolicBayesTree::sharedClique rootClique = bayesTree.roots().front();
+  SymbolicBayesTree::Cliques allCliques;
+  getAllCliques(rootClique, allCliques);
+
+  // Allow at most 2 cached separator marginals
+  Clique::SetSeparatorMarginalBudget(2);
+  Clique::ResetCacheStatistics();
+
+  for(SymbolicBayesTree::sharedClique& clique: allCliques)
+    clique->separatorMarginal();
+  size_t cached = 0;
+  for(SymbolicBayesTree::sharedClique& clique: allCliques)
+    if (clique->cachedSeparatorMarginal())
+      ++cached;
+  EXPECT_LONGS_EQUAL(2, (long)cached);
+  EXPECT(Clique::GetCacheStatistics().misses > 0);
+  EXPECT(Clique::GetCacheStatistics().evictions > 0);
+
+  // Repeated queries of the most recent clique hit the cache
+  const size_t hitsBefore = Clique::GetCacheStatistics().hits;
+  allCliques.back()->separatorMarginal();
+  EXPECT(Clique::GetCacheStatistics().hits > hitsBefore);
+
+  // Restore the unlimited default for the remaining tests
+  rootClique->deleteCachedShortcuts();
+  Clique::SetSeparatorMarginalBudget(0);
+  Clique::ResetCacheStatistics();
+  EXPECT_LONGS_EQUAL(0, (long)rootClique->numCachedSeparatorMarginals());
+}
+
 /* ************************************************************************* */
 TEST( BayesTree, removeTop )
 {
@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testSymbolicEliminationCache.cpp
+ *  @brief  Unit tests for the symbolic elimination cache
+ **/
+
+#include <gtsam/symbolic/SymbolicEliminationCache.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/symbolic/tests/symbolicExampleGraphs.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(SymbolicEliminationCache, givenOrdering) {
+  SymbolicEliminationCache cache;
+  const Ordering order(KeyVector{0, 1, 2, 3, 4});
+
+  // First query eliminates, and matches a direct elimination
+  SymbolicBayesTree::shared_ptr actual =
+      cache.eliminateMultifrontal(simpleTestGraph1, order);
+  EXPECT(assert_equal(*simpleTestGraph1.eliminateMultifrontal(order), *actual));
+  LONGS_EQUAL(1, (long)cache.size());
+
+  // A structurally identical graph hits the cache and returns the same tree
+  SymbolicFactorGraph sameStructure = simpleTestGraph1;
+  SymbolicBayesTree::shared_ptr cached =
+      cache.eliminateMultifrontal(sameStructure, order);
+  EXPECT(cached == actual);
+  LONGS_EQUAL(1, (long)cache.size());
+
+  // A different ordering is a different entry
+  const Ordering reversed(KeyVector{4, 3, 2, 1, 0});
+  SymbolicBayesTree::shared_ptr other =
+      cache.eliminateMultifrontal(simpleTestGraph1, reversed);
+  EXPECT(other != actual);
+  LONGS_EQUAL(2, (long)cache.size());
+
+  // A different graph structure is a different entry
+  cache.eliminateMultifrontal(asiaGraph, asiaOrdering);
+  LONGS_EQUAL(3, (long)cache.size());
+
+  cache.clear();
+  LONGS_EQUAL(0, (long)cache.size());
+}
+
+/* ************************************************************************* */
+TEST(SymbolicEliminationCache, computedOrdering) {
+  SymbolicEliminationCache cache;
+
+  // The COLAMD ordering is computed once per structure and cached
+  pair<SymbolicBayesTree::shared_ptr, Ordering> first =
+      cache.eliminateMultifrontal(asiaGraph);
+  EXPECT(assert_equal(Ordering::Colamd(asiaGraph), first.second));
+  EXPECT(assert_equal(*asiaGraph.eliminateMultifrontal(first.second),
+      *first.first));
+  LONGS_EQUAL(1, (long)cache.size());
+
+  pair<SymbolicBayesTree::shared_ptr, Ordering> second =
+      cache.eliminateMultifrontal(asiaGraph);
+  EXPECT(second.first == first.first);
+  EXPECT(assert_equal(first.second, second.second));
+  LONGS_EQUAL(1, (long)cache.size());
+
+  // Entries with a computed ordering do not collide with given-ordering ones
+  cache.eliminateMultifrontal(asiaGraph, first.second);
+  LONGS_EQUAL(2, (long)cache.size());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -47,6 +47,17 @@ TEST(SymbolicFactorGraph, keys2) {
   EXPECT(expected == actual);
 }
 
+/* ************************************************************************* */
+TEST(SymbolicFactorGraph, emplaceShared) {
+  // emplace_shared returns a typed handle on the newly added factor
+  SymbolicFactorGraph graph;
+  graph.reserve(2);
+  SymbolicFactor::shared_ptr factor = graph.emplace_shared<SymbolicFactor>(0, 1);
+  EXPECT_LONGS_EQUAL(1, graph.size());
+  EXPECT(factor == graph.at(0));
+  EXPECT(assert_equal(SymbolicFactor(0, 1), *factor));
+}
+
 /* ************************************************************************* */
 TEST(SymbolicFactorGraph, eliminateFullSequential) {
   // Test with simpleTestGraph1
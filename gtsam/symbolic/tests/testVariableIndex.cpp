@@ -114,6 +114,57 @@ TEST(VariableIndex, remove) {
   CHECK(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, augmentRecycled) {
+
+  auto fg1 = testGraph1(), fg2 = testGraph2();
+
+  SymbolicFactorGraph fgCombined; fgCombined.push_back(fg1); fgCombined.push_back(fg2);
+
+  VariableIndex actual(fgCombined);
+  LONGS_EQUAL(0, actual.freeSlots().size());
+
+  // Remove the four fg1 factors, freeing their slots
+  vector<size_t> indices;
+  indices.push_back(0); indices.push_back(1); indices.push_back(2); indices.push_back(3);
+  actual.remove(indices.begin(), indices.end(), fg1);
+  LONGS_EQUAL(4, actual.freeSlots().size());
+
+  // New factors must reuse the freed slots, so nFactors does not grow
+  FactorIndices newIndices = actual.augmentRecycled(fg1);
+  LONGS_EQUAL(4, newIndices.size());
+  LONGS_EQUAL(0, actual.freeSlots().size());
+  LONGS_EQUAL(8, actual.nFactors());
+  for (size_t newIndex : newIndices)
+    CHECK(newIndex < 4);
+
+  // Once the free list is exhausted, new slots are appended as in augment()
+  actual.augmentRecycled(fg2);
+  LONGS_EQUAL(12, actual.nFactors());
+}
+
+/* ************************************************************************* */
+TEST(VariableIndex, replace) {
+
+  auto fg1 = testGraph1(), fg2 = testGraph2();
+
+  SymbolicFactorGraph fgCombined; fgCombined.push_back(fg1); fgCombined.push_back(fg2);
+
+  // Replace the fg1 factors (slots 0-3) with the fg2 factors
+  SymbolicFactorGraph fgExpected; fgExpected.push_back(fg2); fgExpected.push_back(fg2);
+  VariableIndex expected(fgExpected);
+
+  VariableIndex actual(fgCombined);
+  FactorIndices indices = list_of(0)(1)(2)(3);
+  actual.replace(indices, fg1, fg2);
+  std::list<Key> unusedVariables; unusedVariables += 0, 9;
+  actual.removeUnusedVariables(unusedVariables.begin(), unusedVariables.end());
+
+  LONGS_EQUAL(8, actual.nFactors());
+  LONGS_EQUAL(0, actual.freeSlots().size());
+  CHECK(assert_equal(expected, actual));
+}
+
 /* ************************************************************************* */
 TEST(VariableIndex, deep_copy) {
 
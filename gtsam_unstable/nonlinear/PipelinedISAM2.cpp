@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PipelinedISAM2.cpp
+ * @brief   Thread-safe frame handoff around ISAM2 so that preparing the next
+ *          frame can overlap the numeric update of the previous one.
+ * @author  Frank Dellaert, et al.
+ */
+
+#include <gtsam_unstable/nonlinear/PipelinedISAM2.h>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+PipelinedISAM2::PipelinedISAM2(const ISAM2Params& params) :
+    isam2_(params), framesSubmitted_(0), framesProcessed_(0), stopped_(false) {
+}
+
+/* ************************************************************************* */
+void PipelinedISAM2::print(const std::string& s,
+    const KeyFormatter& keyFormatter) const {
+  std::cout << s;
+  std::unique_lock<std::mutex> queueLock(queueMutex_);
+  std::cout << "  frames submitted: " << framesSubmitted_
+      << ", processed: " << framesProcessed_
+      << ", pending: " << pendingFrames_.size() << std::endl;
+  queueLock.unlock();
+  std::lock_guard<std::mutex> isam2Lock(isam2Mutex_);
+  isam2_.print("  ", keyFormatter);
+}
+
+/* ************************************************************************* */
+size_t PipelinedISAM2::submitFrame(const NonlinearFactorGraph& newFactors,
+    const Values& newTheta, const ISAM2UpdateParams& updateParams) {
+  Frame frame;
+  frame.newFactors = newFactors;
+  frame.newTheta = newTheta;
+  frame.updateParams = updateParams;
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  frame.id = framesSubmitted_++;
+  pendingFrames_.push_back(frame);
+  framesAvailable_.notify_all();
+  return frame.id;
+}
+
+/* ************************************************************************* */
+KeySet PipelinedISAM2::lastAffectedKeys() const {
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  return lastAffectedKeys_;
+}
+
+/* ************************************************************************* */
+ISAM2Result PipelinedISAM2::waitForResult(size_t frameId) {
+  std::unique_lock<std::mutex> lock(queueMutex_);
+  while (framesProcessed_ <= frameId)
+    resultsAvailable_.wait(lock);
+  FastMap<size_t, ISAM2Result>::iterator item = results_.find(frameId);
+  if (item == results_.end())
+    throw std::out_of_range(
+        "PipelinedISAM2::waitForResult: result already handed over");
+  ISAM2Result result = item->second;
+  results_.erase(item);
+  return result;
+}
+
+/* ************************************************************************* */
+void PipelinedISAM2::waitForAllFrames() {
+  std::unique_lock<std::mutex> lock(queueMutex_);
+  while (framesProcessed_ < framesSubmitted_)
+    resultsAvailable_.wait(lock);
+}
+
+/* ************************************************************************* */
+bool PipelinedISAM2::processNextFrame(bool blocking) {
+  Frame frame;
+  {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    while (pendingFrames_.empty()) {
+      if (stopped_ || !blocking)
+        return false;
+      framesAvailable_.wait(lock);
+    }
+    frame = pendingFrames_.front();
+    pendingFrames_.pop_front();
+  }
+
+  // Run the update outside the queue lock, so the preparation thread can
+  // keep submitting frames while the numeric phases run
+  ISAM2Result result;
+  {
+    std::lock_guard<std::mutex> isam2Lock(isam2Mutex_);
+    result = isam2_.update(frame.newFactors, frame.newTheta,
+        frame.updateParams);
+  }
+
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  results_.insert(std::make_pair(frame.id, result));
+  lastAffectedKeys_ = result.markedKeys;
+  ++framesProcessed_;
+  resultsAvailable_.notify_all();
+  return true;
+}
+
+/* ************************************************************************* */
+void PipelinedISAM2::stop() {
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  stopped_ = true;
+  framesAvailable_.notify_all();
+}
+
+/* ************************************************************************* */
+size_t PipelinedISAM2::framesSubmitted() const {
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  return framesSubmitted_;
+}
+
+/* ************************************************************************* */
+size_t PipelinedISAM2::framesProcessed() const {
+  std::lock_guard<std::mutex> lock(queueMutex_);
+  return framesProcessed_;
+}
+
+/* ************************************************************************* */
+Values PipelinedISAM2::calculateEstimate() const {
+  std::lock_guard<std::mutex> lock(isam2Mutex_);
+  return isam2_.calculateEstimate();
+}
+
+} // \namespace gtsam
@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PipelinedISAM2.h
+ * @brief   Thread-safe frame handoff around ISAM2 so that preparing the next
+ *          frame can overlap the numeric update of the previous one.
+ * @author  Frank Dellaert, et al.
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace gtsam {
+
+/**
+ * A pipelined front-end for ISAM2.  ISAM2::update() runs its mark,
+ * re-eliminate, and delta-update phases strictly sequentially, so a caller
+ * that prepares frames (builds factors, initializes new variables, selects
+ * keys to force re-elimination) on the same thread serializes work that has
+ * no data dependence on the current update.  This class defines the handoff
+ * between a preparation thread and an optimization thread:
+ *
+ *  - The preparation thread calls submitFrame() with fully assembled new
+ *    factors, initializations, and update parameters.  Frames queue in
+ *    submission order.
+ *  - The optimization thread calls processNextFrame() in a loop; each call
+ *    runs ISAM2::update() on the oldest pending frame and publishes its
+ *    ISAM2Result.
+ *  - After each update the set of affected (re-eliminated) keys is published
+ *    through lastAffectedKeys(), so the preparation thread can consult the
+ *    previous frame's affected set while assembling the next frame.
+ *
+ * As with the Concurrent Filtering and Smoothing classes, this class does not
+ * create threads; it only provides the synchronization contract.  All public
+ * methods are safe to call from either thread.  Note that the marking phase
+ * of frame N+1 depends on the Bayes tree produced by frame N, so the phases
+ * that overlap are the caller's frame preparation and this class's queueing,
+ * not two updates of the tree itself.
+ */
+class GTSAM_UNSTABLE_EXPORT PipelinedISAM2 {
+
+public:
+
+  typedef boost::shared_ptr<PipelinedISAM2> shared_ptr;
+
+  /** A fully prepared frame, queued between the two threads */
+  struct Frame {
+    size_t id; ///< Frame id assigned by submitFrame()
+    NonlinearFactorGraph newFactors; ///< The new factors added by this frame
+    Values newTheta; ///< Initialization points for new variables
+    ISAM2UpdateParams updateParams; ///< Extra parameters for ISAM2::update()
+  };
+
+  /** Create a pipelined ISAM2 instance with the given solver parameters */
+  PipelinedISAM2(const ISAM2Params& params = ISAM2Params());
+
+  /** Implement a standard 'print' function */
+  void print(const std::string& s = "Pipelined ISAM2:\n",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @name Preparation thread interface
+  /// @{
+
+  /**
+   * Queue a prepared frame for the optimization thread.  Returns the frame
+   * id, a counter starting at 0, which can be passed to waitForResult().
+   */
+  size_t submitFrame(const NonlinearFactorGraph& newFactors,
+      const Values& newTheta = Values(),
+      const ISAM2UpdateParams& updateParams = ISAM2UpdateParams());
+
+  /**
+   * The keys re-eliminated by the most recently processed frame (the
+   * markedKeys of its ISAM2Result), i.e. the variables whose cliques were
+   * affected.  Empty before the first frame completes.
+   */
+  KeySet lastAffectedKeys() const;
+
+  /**
+   * Block until the given frame has been processed, then return its
+   * ISAM2Result.  Each result is handed over exactly once; asking twice for
+   * the same frame throws std::out_of_range.
+   */
+  ISAM2Result waitForResult(size_t frameId);
+
+  /** Block until every submitted frame has been processed */
+  void waitForAllFrames();
+
+  /// @}
+  /// @name Optimization thread interface
+  /// @{
+
+  /**
+   * Run ISAM2::update() on the oldest pending frame.  If no frame is pending
+   * and \c blocking is true (the default), wait until one is submitted or
+   * stop() is called.  Returns false if no frame was processed.  The
+   * pipeline expects a single optimization thread; frames are processed
+   * strictly in submission order.
+   */
+  bool processNextFrame(bool blocking = true);
+
+  /** Wake any blocked processNextFrame() calls and make them return false */
+  void stop();
+
+  /// @}
+  /// @name Shared queries (safe from either thread)
+  /// @{
+
+  /** Number of frames submitted so far */
+  size_t framesSubmitted() const;
+
+  /** Number of frames processed so far */
+  size_t framesProcessed() const;
+
+  /** A snapshot of the current best estimate; blocks during an update */
+  Values calculateEstimate() const;
+
+  /// @}
+
+protected:
+
+  mutable std::mutex isam2Mutex_; ///< Protects isam2_ during updates and estimate queries
+  ISAM2 isam2_; ///< The underlying solver, touched only under isam2Mutex_
+
+  mutable std::mutex queueMutex_; ///< Protects the members below
+  std::condition_variable framesAvailable_; ///< Signaled on submitFrame() and stop()
+  std::condition_variable resultsAvailable_; ///< Signaled after each processed frame
+  std::deque<Frame> pendingFrames_; ///< Frames submitted but not yet processed
+  FastMap<size_t, ISAM2Result> results_; ///< Results not yet handed over
+  KeySet lastAffectedKeys_; ///< markedKeys of the most recent result
+  size_t framesSubmitted_; ///< Total number of submitted frames
+  size_t framesProcessed_; ///< Total number of processed frames
+  bool stopped_; ///< Set by stop(); makes blocking calls return
+
+}; // PipelinedISAM2
+
+} // \namespace gtsam
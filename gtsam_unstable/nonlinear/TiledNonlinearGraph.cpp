@@ -0,0 +1,249 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TiledNonlinearGraph.cpp
+ * @brief   A NonlinearFactorGraph + Values sharded by spatial tile, with
+ *          inactive tiles offloaded to disk.
+ * @author  Richard Roberts
+ * @date    Aug 29, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/TiledNonlinearGraph.h>
+#include <gtsam/base/serialization.h>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::print(const std::string& s,
+    const KeyFormatter& keyFormatter) const {
+  std::cout << s;
+  std::cout << "  tiles: " << tiles_.size() << " (" << loadedTiles_.size()
+      << " active), separator factors: " << separatorFactors_.size() << "\n";
+  for(const FastMap<TileId, Tile>::value_type& entry: tiles_) {
+    const bool loaded = loadedTiles_.exists(entry.first);
+    std::cout << "  tile " << entry.first
+        << (loaded ? " (active): " : " (offloaded): ")
+        << entry.second.graph.size() << " factors, "
+        << entry.second.values.size() << " values\n";
+  }
+  separatorValues_.print("  separator cache", keyFormatter);
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::assignKey(Key key, TileId tile) {
+  std::pair<FastMap<Key, TileId>::iterator, bool> inserted =
+      keyTiles_.insert(std::make_pair(key, tile));
+  if(!inserted.second && inserted.first->second != tile)
+    throw std::invalid_argument(
+        "TiledNonlinearGraph::assignKey: key is already assigned to a different tile");
+  // Create the tile on first assignment so empty tiles are still addressable
+  if(tiles_.insert(std::make_pair(tile, Tile())).second)
+    loadedTiles_.insert(tile);
+}
+
+/* ************************************************************************* */
+TiledNonlinearGraph::TileId TiledNonlinearGraph::tileOf(Key key) const {
+  FastMap<Key, TileId>::const_iterator item = keyTiles_.find(key);
+  if(item == keyTiles_.end())
+    throw std::invalid_argument(
+        "TiledNonlinearGraph::tileOf: requested key was never assigned to a tile");
+  return item->second;
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::insert(const Values& values) {
+  for(const Values::ConstKeyValuePair& keyValue: values) {
+    const TileId tile = tileOf(keyValue.key);
+    if(!loadedTiles_.exists(tile))
+      throw std::invalid_argument(
+          "TiledNonlinearGraph::insert: destination tile is not active");
+    tiles_.at(tile).values.insert(keyValue.key, keyValue.value);
+    // Keep the separator cache consistent if the variable is a separator one
+    if(separatorKeys_.exists(keyValue.key))
+      separatorValues_.insert(keyValue.key, keyValue.value);
+  }
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::add(const NonlinearFactor::shared_ptr& factor) {
+  if(!factor || factor->keys().empty())
+    return;
+
+  // A factor belongs to a tile iff all its variables share that tile
+  const TileId tile = tileOf(factor->keys().front());
+  bool spansTiles = false;
+  for(Key key: factor->keys())
+    if(tileOf(key) != tile) {
+      spansTiles = true;
+      break;
+    }
+
+  if(!spansTiles) {
+    if(!loadedTiles_.exists(tile))
+      throw std::invalid_argument(
+          "TiledNonlinearGraph::add: destination tile is not active");
+    tiles_.at(tile).graph.push_back(factor);
+    return;
+  }
+
+  // Separator factor: stays resident, and its variables' current values are
+  // cached so bordering subproblems can be materialized later
+  separatorFactors_.push_back(factor);
+  for(Key key: factor->keys()) {
+    separatorKeys_.insert(key);
+    if(!separatorValues_.exists(key)) {
+      const TileId keyTile = tileOf(key);
+      if(loadedTiles_.exists(keyTile) && tiles_.at(keyTile).values.exists(key))
+        separatorValues_.insert(key, tiles_.at(keyTile).values.at(key));
+    }
+  }
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::add(const NonlinearFactorGraph& graph) {
+  for(const NonlinearFactor::shared_ptr& factor: graph)
+    add(factor);
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::setActiveTiles(const std::set<TileId>& tiles) {
+  // Offload loaded tiles that fall out of the active set.  Offloading first
+  // bounds peak memory at (old active set) + (one incoming tile).
+  const FastSet<TileId> previouslyLoaded = loadedTiles_;
+  for(TileId tile: previouslyLoaded)
+    if(tiles.count(tile) == 0)
+      offloadTile(tile);
+
+  // Load requested tiles that are not resident
+  for(TileId tile: tiles) {
+    if(tiles_.find(tile) == tiles_.end())
+      throw std::invalid_argument(
+          "TiledNonlinearGraph::setActiveTiles: requested tile does not exist");
+    if(!loadedTiles_.exists(tile))
+      loadTile(tile);
+  }
+}
+
+/* ************************************************************************* */
+std::set<TiledNonlinearGraph::TileId> TiledNonlinearGraph::activeTiles() const {
+  return std::set<TileId>(loadedTiles_.begin(), loadedTiles_.end());
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph TiledNonlinearGraph::activeGraph() const {
+  NonlinearFactorGraph graph;
+  for(TileId tile: loadedTiles_)
+    graph.push_back(tiles_.at(tile).graph);
+  // Include separator factors anchored in the active set
+  for(const NonlinearFactor::shared_ptr& factor: separatorFactors_) {
+    for(Key key: factor->keys())
+      if(loadedTiles_.exists(tileOf(key))) {
+        graph.push_back(factor);
+        break;
+      }
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+Values TiledNonlinearGraph::activeValues() const {
+  Values values;
+  for(TileId tile: loadedTiles_)
+    values.insert(tiles_.at(tile).values);
+  // Out-of-tile separator variables come from the resident cache
+  for(const NonlinearFactor::shared_ptr& factor: separatorFactors_) {
+    bool anchored = false;
+    for(Key key: factor->keys())
+      if(loadedTiles_.exists(tileOf(key))) {
+        anchored = true;
+        break;
+      }
+    if(!anchored)
+      continue;
+    for(Key key: factor->keys())
+      if(!values.exists(key)) {
+        if(!separatorValues_.exists(key))
+          throw std::runtime_error(
+              "TiledNonlinearGraph::activeValues: separator variable has no cached value");
+        values.insert(key, separatorValues_.at(key));
+      }
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::writeBack(const Values& newValues) {
+  for(const Values::ConstKeyValuePair& keyValue: newValues) {
+    const TileId tile = tileOf(keyValue.key);
+    if(loadedTiles_.exists(tile))
+      tiles_.at(tile).values.update(keyValue.key, keyValue.value);
+    if(separatorValues_.exists(keyValue.key))
+      separatorValues_.update(keyValue.key, keyValue.value);
+  }
+}
+
+/* ************************************************************************* */
+std::string TiledNonlinearGraph::tileFilename(TileId tile) const {
+  std::ostringstream filename;
+  filename << tileDirectory_ << "/tile_" << tile << ".bin";
+  return filename.str();
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::offloadTile(TileId tile) {
+  Tile& stored = tiles_.at(tile);
+  cacheSeparatorValues(stored);
+  if(!tileDirectory_.empty()) {
+    if(!serializeToBinaryFile(stored, tileFilename(tile)))
+      throw std::runtime_error(
+          "TiledNonlinearGraph::offloadTile: could not write " + tileFilename(tile));
+    // Release the resident copy; the disk copy is now authoritative
+    stored.graph = NonlinearFactorGraph();
+    stored.values = Values();
+  }
+  loadedTiles_.erase(tile);
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::loadTile(TileId tile) {
+  Tile& stored = tiles_.at(tile);
+  if(!tileDirectory_.empty()) {
+    if(!deserializeFromBinaryFile(tileFilename(tile), stored))
+      throw std::runtime_error(
+          "TiledNonlinearGraph::loadTile: could not read " + tileFilename(tile));
+    // The separator cache may have been optimized since this tile was
+    // offloaded - the cache is authoritative for separator variables
+    for(Key key: separatorKeys_)
+      if(stored.values.exists(key) && separatorValues_.exists(key))
+        stored.values.update(key, separatorValues_.at(key));
+  }
+  loadedTiles_.insert(tile);
+}
+
+/* ************************************************************************* */
+void TiledNonlinearGraph::cacheSeparatorValues(const Tile& tile) {
+  for(Key key: separatorKeys_) {
+    if(!tile.values.exists(key))
+      continue;
+    if(separatorValues_.exists(key))
+      separatorValues_.update(key, tile.values.at(key));
+    else
+      separatorValues_.insert(key, tile.values.at(key));
+  }
+}
+
+/* ************************************************************************* */
+} // \namespace gtsam
@@ -0,0 +1,193 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TiledNonlinearGraph.h
+ * @brief   A NonlinearFactorGraph + Values sharded by spatial tile, with
+ *          inactive tiles offloaded to disk.
+ * @author  Richard Roberts
+ * @date    Aug 29, 2026
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/FastSet.h>
+
+#include <set>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * A factor graph and its values sharded into tiles, intended for maps too
+ * large to optimize (or even hold) in memory at once.  The caller assigns
+ * every variable to a tile - typically by spatial binning of an initial
+ * estimate - and factors are routed automatically: a factor whose variables
+ * all share one tile belongs to that tile, while a factor spanning tiles is a
+ * *separator* factor and is kept resident at all times.
+ *
+ * A subset of tiles is *active* at any time.  setActiveTiles() loads the
+ * requested tiles and offloads the rest to disk using the boost
+ * serialization helpers in gtsam/base/serialization.h (when constructed
+ * without a tile directory, inactive tiles stay in memory but are still
+ * excluded from materialization).  Before a tile is offloaded, the values of
+ * its variables that appear in separator factors are copied into a resident
+ * separator cache, so the separator factors bordering the active set can be
+ * linearized without touching disk.
+ *
+ * activeGraph() and activeValues() then materialize the subproblem for the
+ * active set: the active tiles' factors and values, plus the separator
+ * factors anchored in them and the cached values of their out-of-tile
+ * variables.  After optimization, writeBack() routes the updated estimate
+ * into the loaded tiles and the separator cache.
+ *
+ * Note the out-of-tile separator variables are included in the materialized
+ * subproblem as ordinary variables; callers wanting them held fixed should
+ * add priors or use a constrained ordering.
+ *
+ * \nosubgrouping
+ */
+class GTSAM_UNSTABLE_EXPORT TiledNonlinearGraph {
+
+public:
+
+  /// Typedef for a shared pointer to a tiled graph
+  typedef boost::shared_ptr<TiledNonlinearGraph> shared_ptr;
+
+  /// Tile identifiers are assigned by the caller, e.g. from a spatial hash
+  typedef size_t TileId;
+
+  /** The resident state of one tile.  Public so callers can serialize tiles
+   *  through their own archives if desired. */
+  struct Tile {
+    NonlinearFactorGraph graph; ///< Factors entirely within this tile
+    Values values; ///< Current estimate for this tile's variables
+
+  private:
+    /** Serialization function */
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & BOOST_SERIALIZATION_NVP(graph);
+      ar & BOOST_SERIALIZATION_NVP(values);
+    }
+  };
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Construct an empty tiled graph.
+   * @param tileDirectory Directory that offloaded tiles are written to.  If
+   *        empty, inactive tiles are kept in memory instead of on disk. */
+  TiledNonlinearGraph(const std::string& tileDirectory = "") :
+      tileDirectory_(tileDirectory) {}
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /** Print the tile layout for debugging and testing */
+  void print(const std::string& s = "TiledNonlinearGraph:\n",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @}
+  /// @name Building the tiled graph
+  /// @{
+
+  /** Assign a variable to a tile.  Every variable must be assigned before
+   *  values or factors involving it are added.  Re-assigning a variable to a
+   *  different tile is not supported and throws. */
+  void assignKey(Key key, TileId tile);
+
+  /// The tile a variable was assigned to; throws if unassigned
+  TileId tileOf(Key key) const;
+
+  /** Insert initial values, routed to the tiles their keys are assigned to.
+   *  The destination tiles must be active. */
+  void insert(const Values& values);
+
+  /** Add a factor.  If all its variables share one tile the factor is stored
+   *  in that tile (which must be active); otherwise it is a separator factor
+   *  and stays resident, and the current values of its variables are copied
+   *  into the separator cache. */
+  void add(const NonlinearFactor::shared_ptr& factor);
+
+  /// Add all factors in a graph, routing each as in add()
+  void add(const NonlinearFactorGraph& graph);
+
+  /// @}
+  /// @name Active tile management
+  /// @{
+
+  /** Make exactly the requested tiles active, offloading the rest.  Values
+   *  of offloaded variables that appear in separator factors are retained in
+   *  the separator cache. */
+  void setActiveTiles(const std::set<TileId>& tiles);
+
+  /// The currently active (loaded) tiles
+  std::set<TileId> activeTiles() const;
+
+  /// Number of tiles, active or not
+  size_t nrTiles() const { return tiles_.size(); }
+
+  /// The separator factors (those spanning more than one tile)
+  const NonlinearFactorGraph& separatorFactors() const { return separatorFactors_; }
+
+  /// @}
+  /// @name Materialization for optimization
+  /// @{
+
+  /** The factors of the active tiles, plus the separator factors with at
+   *  least one variable in an active tile. */
+  NonlinearFactorGraph activeGraph() const;
+
+  /** The values of the active tiles, plus the cached values of out-of-tile
+   *  variables referenced by the included separator factors. */
+  Values activeValues() const;
+
+  /** Route an optimized estimate back into the tiles and separator cache.
+   *  Keys in \c newValues that belong to inactive tiles update only the
+   *  separator cache; the tile copy is refreshed when it is next loaded and
+   *  written back while active. */
+  void writeBack(const Values& newValues);
+
+  /// @}
+
+protected:
+
+  /// The filename an offloaded tile is stored under
+  std::string tileFilename(TileId tile) const;
+
+  /// Offload one tile, retaining its separator values; no-op without a directory
+  void offloadTile(TileId tile);
+
+  /// Load one tile back from disk; throws on a missing or unreadable file
+  void loadTile(TileId tile);
+
+  /// Copy the separator values owned by a tile into the separator cache
+  void cacheSeparatorValues(const Tile& tile);
+
+  std::string tileDirectory_; ///< Directory for offloaded tiles, empty keeps tiles in memory
+  FastMap<TileId, Tile> tiles_; ///< All tiles; offloaded ones have empty graph and values
+  FastSet<TileId> loadedTiles_; ///< Tiles currently resident (the active set)
+  FastMap<Key, TileId> keyTiles_; ///< The tile each variable is assigned to
+  NonlinearFactorGraph separatorFactors_; ///< Factors spanning tiles, always resident
+  KeySet separatorKeys_; ///< Variables appearing in separator factors
+  Values separatorValues_; ///< Resident cache of separator variable values
+
+}; // TiledNonlinearGraph
+
+} // \namespace gtsam
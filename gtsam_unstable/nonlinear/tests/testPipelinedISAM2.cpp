@@ -0,0 +1,118 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPipelinedISAM2.cpp
+ * @brief   Unit tests for the pipelined ISAM2 frame handoff
+ * @author  Frank Dellaert, et al.
+ */
+
+#include <gtsam_unstable/nonlinear/PipelinedISAM2.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+#include <thread>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+
+const SharedNoiseModel priorNoise = noiseModel::Isotropic::Sigma(3, 0.1);
+const SharedNoiseModel odometryNoise = noiseModel::Isotropic::Sigma(3, 0.2);
+const Pose2 odometry(1.0, 0.0, 0.1);
+
+/* ************************************************************************* */
+// Create the new factors and initializations for one frame of a simple
+// odometry chain, as a preparation thread would
+PipelinedISAM2::Frame makeFrame(size_t i) {
+  PipelinedISAM2::Frame frame;
+  if (i == 0) {
+    frame.newFactors.push_back(
+        boost::make_shared<PriorFactor<Pose2> >(0, Pose2(), priorNoise));
+    frame.newTheta.insert(0, Pose2(0.01, -0.01, 0.0));
+  } else {
+    frame.newFactors.push_back(
+        boost::make_shared<BetweenFactor<Pose2> >(i - 1, i, odometry,
+            odometryNoise));
+    frame.newTheta.insert(i,
+        Pose2(double(i) + 0.01, -0.01, 0.1 * double(i)));
+  }
+  return frame;
+}
+
+} // end anonymous namespace
+
+/* ************************************************************************* */
+TEST( PipelinedISAM2, singleThread )
+{
+  // Processing queued frames one at a time must match a plain ISAM2 run
+  PipelinedISAM2 pipeline;
+  ISAM2 expected;
+
+  for (size_t i = 0; i < 6; ++i) {
+    PipelinedISAM2::Frame frame = makeFrame(i);
+    size_t frameId = pipeline.submitFrame(frame.newFactors, frame.newTheta);
+    LONGS_EQUAL(i, (long)frameId);
+    EXPECT(pipeline.processNextFrame(false));
+
+    ISAM2Result expectedResult = expected.update(frame.newFactors,
+        frame.newTheta);
+    ISAM2Result actualResult = pipeline.waitForResult(frameId);
+    EXPECT(expectedResult.markedKeys == actualResult.markedKeys);
+    EXPECT(expectedResult.markedKeys == pipeline.lastAffectedKeys());
+  }
+
+  LONGS_EQUAL(6, (long)pipeline.framesSubmitted());
+  LONGS_EQUAL(6, (long)pipeline.framesProcessed());
+  EXPECT(!pipeline.processNextFrame(false)); // nothing pending
+  EXPECT(assert_equal(expected.calculateEstimate(),
+      pipeline.calculateEstimate()));
+
+  // A result is handed over exactly once
+  CHECK_EXCEPTION(pipeline.waitForResult(0), std::out_of_range);
+}
+
+/* ************************************************************************* */
+TEST( PipelinedISAM2, twoThreads )
+{
+  // Submit frames from this thread while a dedicated optimization thread
+  // drains the queue
+  PipelinedISAM2 pipeline;
+  std::thread optimizer([&pipeline]() {
+    while (pipeline.processNextFrame(true)) {
+    }
+  });
+
+  for (size_t i = 0; i < 10; ++i) {
+    PipelinedISAM2::Frame frame = makeFrame(i);
+    pipeline.submitFrame(frame.newFactors, frame.newTheta);
+  }
+  pipeline.waitForAllFrames();
+  pipeline.stop();
+  optimizer.join();
+
+  ISAM2 expected;
+  for (size_t i = 0; i < 10; ++i) {
+    PipelinedISAM2::Frame frame = makeFrame(i);
+    expected.update(frame.newFactors, frame.newTheta);
+  }
+  LONGS_EQUAL(10, (long)pipeline.framesProcessed());
+  EXPECT(assert_equal(expected.calculateEstimate(),
+      pipeline.calculateEstimate()));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTiledNonlinearGraph.cpp
+ * @brief   Unit tests for the tiled graph layer
+ * @author  Richard Roberts
+ * @date    Aug 29, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/TiledNonlinearGraph.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <boost/serialization/export.hpp>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// A null noise model avoids having to register noise-model serialization
+static const SharedNoiseModel model;
+
+// Register the types stored through the tile archives
+BOOST_CLASS_EXPORT_GUID(gtsam::GenericValue<double>, "gtsam_GenericValue_double");
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<double>, "gtsam_PriorFactor_double");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<double>, "gtsam_BetweenFactor_double");
+
+/* ************************************************************************* */
+// A 4-variable chain split into two tiles: {0, 1} and {2, 3}.  The factor
+// between 1 and 2 spans the tiles and becomes a separator factor.
+namespace {
+TiledNonlinearGraph buildChain(const std::string& tileDirectory) {
+  TiledNonlinearGraph tiled(tileDirectory);
+  tiled.assignKey(0, 0); tiled.assignKey(1, 0);
+  tiled.assignKey(2, 1); tiled.assignKey(3, 1);
+
+  Values initial;
+  initial.insert(0, 0.0); initial.insert(1, 1.0);
+  initial.insert(2, 2.0); initial.insert(3, 3.0);
+  tiled.insert(initial);
+
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<double> >(0, 0.0, model);
+  graph.emplace_shared<BetweenFactor<double> >(0, 1, 1.0, model);
+  graph.emplace_shared<BetweenFactor<double> >(1, 2, 1.0, model);
+  graph.emplace_shared<BetweenFactor<double> >(2, 3, 1.0, model);
+  tiled.add(graph);
+  return tiled;
+}
+}
+
+/* ************************************************************************* */
+TEST(TiledNonlinearGraph, routing) {
+  TiledNonlinearGraph tiled = buildChain("");
+
+  EXPECT_LONGS_EQUAL(2, tiled.nrTiles());
+  EXPECT_LONGS_EQUAL(2, tiled.activeTiles().size());
+  EXPECT_LONGS_EQUAL(1, tiled.separatorFactors().size());
+  EXPECT_LONGS_EQUAL(0, tiled.tileOf(1));
+  EXPECT_LONGS_EQUAL(1, tiled.tileOf(2));
+
+  // With everything active, the full problem is materialized
+  EXPECT_LONGS_EQUAL(4, tiled.activeGraph().size());
+  EXPECT_LONGS_EQUAL(4, tiled.activeValues().size());
+}
+
+/* ************************************************************************* */
+TEST(TiledNonlinearGraph, inMemoryDeactivation) {
+  TiledNonlinearGraph tiled = buildChain("");
+
+  // Deactivate tile 0; its factors drop out, the separator factor remains
+  std::set<TiledNonlinearGraph::TileId> active;
+  active.insert(1);
+  tiled.setActiveTiles(active);
+
+  NonlinearFactorGraph graph = tiled.activeGraph();
+  Values values = tiled.activeValues();
+  EXPECT_LONGS_EQUAL(2, graph.size()); // between(2,3) and separator between(1,2)
+  EXPECT_LONGS_EQUAL(3, values.size()); // keys 2, 3 and cached separator key 1
+  EXPECT_DOUBLES_EQUAL(1.0, values.at<double>(1), 1e-9);
+  EXPECT_DOUBLES_EQUAL(2.0, values.at<double>(2), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(TiledNonlinearGraph, offloadAndWriteBack) {
+  TiledNonlinearGraph tiled = buildChain(".");
+
+  // Offload tile 0 to disk and materialize the subproblem around tile 1
+  std::set<TiledNonlinearGraph::TileId> active;
+  active.insert(1);
+  tiled.setActiveTiles(active);
+  EXPECT_LONGS_EQUAL(1, tiled.activeTiles().size());
+  EXPECT_LONGS_EQUAL(2, tiled.activeGraph().size());
+  EXPECT_LONGS_EQUAL(3, tiled.activeValues().size());
+
+  // Write back an "optimized" estimate, touching the cached separator key 1
+  Values optimized;
+  optimized.insert(1, 1.5);
+  optimized.insert(2, 2.5);
+  optimized.insert(3, 3.5);
+  tiled.writeBack(optimized);
+
+  // Reload tile 0: its factors return, and the separator cache is
+  // authoritative for key 1
+  active.insert(0);
+  tiled.setActiveTiles(active);
+  Values values = tiled.activeValues();
+  EXPECT_LONGS_EQUAL(4, tiled.activeGraph().size());
+  EXPECT_LONGS_EQUAL(4, values.size());
+  EXPECT_DOUBLES_EQUAL(0.0, values.at<double>(0), 1e-9); // untouched
+  EXPECT_DOUBLES_EQUAL(1.5, values.at<double>(1), 1e-9); // via separator cache
+  EXPECT_DOUBLES_EQUAL(2.5, values.at<double>(2), 1e-9); // written back in-tile
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
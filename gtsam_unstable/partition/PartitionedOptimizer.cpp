@@ -0,0 +1,156 @@
+/*
+ * PartitionedOptimizer.cpp
+ *
+ *   Created on: Aug 29, 2026
+ *  Description: optimize a partitioned nonlinear factor graph by submaps,
+ *               solving the separator system globally each iteration
+ */
+
+#include <gtsam_unstable/partition/PartitionedOptimizer.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gtsam { namespace partition {
+
+/* ************************************************************************* */
+PartitionedOptimizer::PartitionedOptimizer(const NonlinearFactorGraph& graph,
+    const Values& initialValues, const FastMap<Key, int>& partitionTable,
+    const Params& params) :
+    graph_(graph), values_(initialValues), params_(params), iterations_(0) {
+
+  // Count the submaps
+  int nrSubmaps = 0;
+  for (const FastMap<Key, int>::value_type& entry : partitionTable) {
+    if (entry.second < 0)
+      throw std::invalid_argument(
+          "PartitionedOptimizer: unassigned variable in partition table");
+    nrSubmaps = std::max(nrSubmaps, entry.second);
+  }
+  if (nrSubmaps < 1)
+    throw std::invalid_argument(
+        "PartitionedOptimizer: partition table contains no submaps");
+  submapGraphs_.resize(nrSubmaps);
+  submapInteriorKeys_.resize(nrSubmaps);
+
+  // Assign each factor to the single submap whose interior it touches, or to
+  // the separator system if it only involves separator variables
+  for (const NonlinearFactor::shared_ptr& factor : graph_) {
+    if (!factor) continue;
+    int submap = 0;
+    for (Key key : factor->keys()) {
+      FastMap<Key, int>::const_iterator entry = partitionTable.find(key);
+      if (entry == partitionTable.end())
+        throw std::invalid_argument(
+            "PartitionedOptimizer: variable missing from partition table");
+      const int p = entry->second;
+      if (p == 0) continue; // separator variable
+      if (submap == 0)
+        submap = p;
+      else if (submap != p)
+        throw std::invalid_argument(
+            "PartitionedOptimizer: factor spans two submap interiors, "
+            "so the table does not describe a vertex separator");
+    }
+    if (submap == 0)
+      separatorGraph_.push_back(factor);
+    else
+      submapGraphs_[submap - 1].push_back(factor);
+  }
+
+  // Collect the interior variables of each submap
+  for (const FastMap<Key, int>::value_type& entry : partitionTable)
+    if (entry.second > 0)
+      submapInteriorKeys_[entry.second - 1].push_back(entry.first);
+
+  // Per-submap interior elimination orderings: colamd on the submap with its
+  // local separator variables constrained last, then truncated to interiors
+  submapOrderings_.resize(nrSubmaps);
+  for (int i = 0; i < nrSubmaps; ++i) {
+    const NonlinearFactorGraph& submap = submapGraphs_[i];
+    if (submap.empty()) continue;
+    KeySet localSeparator;
+    for (const NonlinearFactor::shared_ptr& factor : submap)
+      for (Key key : factor->keys())
+        if (partitionTable.at(key) == 0)
+          localSeparator.insert(key);
+    const Ordering full = Ordering::ColamdConstrainedLast(submap,
+        KeyVector(localSeparator.begin(), localSeparator.end()));
+    submapOrderings_[i] = Ordering(full.begin(),
+        full.end() - localSeparator.size());
+  }
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr PartitionedOptimizer::eliminateSubmap(
+    size_t i, GaussianBayesNet::shared_ptr& bayesNet) const {
+  const GaussianFactorGraph::shared_ptr linear = //
+      submapGraphs_[i].linearize(values_);
+  std::pair<GaussianBayesNet::shared_ptr, GaussianFactorGraph::shared_ptr>
+      result = linear->eliminatePartialSequential(submapOrderings_[i]);
+  bayesNet = result.first;
+  return result.second;
+}
+
+/* ************************************************************************* */
+void PartitionedOptimizer::iterate() {
+  const size_t nrSubmaps = submapGraphs_.size();
+  std::vector<GaussianBayesNet::shared_ptr> bayesNets(nrSubmaps);
+  std::vector<GaussianFactorGraph::shared_ptr> marginals(nrSubmaps);
+
+  // Step 1: each submap eliminates its interior, leaving a marginal on its
+  // separator variables.  Submaps are independent, so run them in parallel.
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrSubmaps),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          marginals[i] = eliminateSubmap(i, bayesNets[i]);
+      });
+#else
+  for (size_t i = 0; i < nrSubmaps; ++i)
+    marginals[i] = eliminateSubmap(i, bayesNets[i]);
+#endif
+
+  // Step 2: solve the separator system formed by the submap marginals and
+  // the factors involving only separator variables
+  GaussianFactorGraph separatorSystem;
+  for (size_t i = 0; i < nrSubmaps; ++i)
+    separatorSystem.push_back(*marginals[i]);
+  separatorSystem.push_back(*separatorGraph_.linearize(values_));
+  VectorValues delta = separatorSystem.optimize();
+
+  // Step 3: back-substitute each submap's interior given the separator
+  for (size_t i = 0; i < nrSubmaps; ++i) {
+    const VectorValues solution = bayesNets[i]->optimize(delta);
+    for (Key key : submapOrderings_[i])
+      delta.insert(key, solution.at(key));
+  }
+
+  values_ = values_.retract(delta);
+  ++iterations_;
+}
+
+/* ************************************************************************* */
+Values PartitionedOptimizer::optimize() {
+  double currentError = error();
+  for (size_t k = 0; k < params_.maxIterations; ++k) {
+    iterate();
+    const double newError = error();
+    // standard NonlinearOptimizer stopping criterion
+    if (currentError - newError < params_.absoluteErrorTol
+        || currentError - newError
+            < params_.relativeErrorTol * std::abs(currentError))
+      break;
+    currentError = newError;
+  }
+  return values_;
+}
+
+}} // namespace gtsam::partition
@@ -0,0 +1,100 @@
+/*
+ * PartitionedOptimizer.h
+ *
+ *   Created on: Aug 29, 2026
+ *  Description: optimize a partitioned nonlinear factor graph by submaps,
+ *               solving the separator system globally each iteration
+ */
+
+#pragma once
+
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <vector>
+
+namespace gtsam { namespace partition {
+
+  /**
+   * An end-to-end submap optimizer on top of the partitioning utilities in
+   * this module.  Given a partition of the variables into submaps plus a
+   * separator (e.g. obtained from findSeparator, or supplied by the caller),
+   * each Gauss-Newton iteration is computed in partitioned form:
+   *
+   *  1. each submap linearizes its factors and eliminates its interior
+   *     variables, leaving a marginal on its separator variables;
+   *  2. the submap marginals and the pure separator factors form the
+   *     separator system, which is solved globally;
+   *  3. each submap back-substitutes its interior variables given the
+   *     separator solution.
+   *
+   * The per-submap work in steps 1 and 3 is independent, so submaps are
+   * processed in parallel when GTSAM is built with TBB.  The same structure
+   * is what a distributed deployment would ship per rank: only the separator
+   * system and the submap marginals ever need to be communicated.
+   */
+  class GTSAM_UNSTABLE_EXPORT PartitionedOptimizer {
+
+  public:
+
+    /** Convergence parameters, following NonlinearOptimizerParams */
+    struct Params {
+      size_t maxIterations; ///< The maximum number of outer iterations
+      double relativeErrorTol; ///< The maximum relative error decrease to stop iterating
+      double absoluteErrorTol; ///< The maximum absolute error decrease to stop iterating
+      Params() : maxIterations(10), relativeErrorTol(1e-5),
+          absoluteErrorTol(1e-5) {}
+    };
+
+    /**
+     * Construct from a graph, initial values, and a partition table mapping
+     * each variable to a submap index: 0 means the separator, i > 0 means
+     * the ith submap (the convention of PartitionTable in this module).
+     * Every factor must involve interior variables of at most one submap;
+     * throws std::invalid_argument otherwise, since then the table does not
+     * describe a vertex separator.
+     */
+    PartitionedOptimizer(const NonlinearFactorGraph& graph,
+        const Values& initialValues, const FastMap<Key, int>& partitionTable,
+        const Params& params = Params());
+
+    /** Iterate partitioned Gauss-Newton steps until convergence */
+    Values optimize();
+
+    /** Perform a single partitioned Gauss-Newton iteration */
+    void iterate();
+
+    /** The current estimate */
+    const Values& values() const { return values_; }
+
+    /** The nonlinear error of the full graph at the current estimate */
+    double error() const { return graph_.error(values_); }
+
+    /** Number of iterations performed so far */
+    size_t iterations() const { return iterations_; }
+
+    /** Number of submaps in the partition */
+    size_t nrSubmaps() const { return submapGraphs_.size(); }
+
+  protected:
+
+    /** Eliminate one submap's interior, returning the separator marginal */
+    GaussianFactorGraph::shared_ptr eliminateSubmap(size_t i,
+        GaussianBayesNet::shared_ptr& bayesNet) const;
+
+    NonlinearFactorGraph graph_; ///< The full graph, for error evaluation
+    Values values_; ///< The current estimate
+    Params params_; ///< Convergence parameters
+    size_t iterations_; ///< Number of iterations performed
+
+    std::vector<NonlinearFactorGraph> submapGraphs_; ///< Factors of each submap
+    std::vector<Ordering> submapOrderings_; ///< Interior elimination order per submap
+    std::vector<KeyVector> submapInteriorKeys_; ///< Interior variables per submap
+    NonlinearFactorGraph separatorGraph_; ///< Factors on separator variables only
+
+  }; // PartitionedOptimizer
+
+}} // namespace gtsam::partition
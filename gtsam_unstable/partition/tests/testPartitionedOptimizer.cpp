@@ -0,0 +1,108 @@
+/*
+ * testPartitionedOptimizer.cpp
+ *
+ *   Created on: Aug 29, 2026
+ *  Description: unit tests for the partitioned submap optimizer
+ */
+
+#include <gtsam_unstable/partition/PartitionedOptimizer.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam::partition;
+
+namespace {
+
+// A chain of 7 poses: keys 0-2 form submap 1, key 3 the separator, and
+// keys 4-6 submap 2
+const SharedNoiseModel priorNoise = noiseModel::Isotropic::Sigma(3, 0.1);
+const SharedNoiseModel odoNoise = noiseModel::Isotropic::Sigma(3, 0.2);
+
+NonlinearFactorGraph chainGraph() {
+  NonlinearFactorGraph graph;
+  graph.push_back(
+      boost::make_shared<PriorFactor<Pose2> >(0, Pose2(), priorNoise));
+  for (Key i = 0; i < 6; ++i)
+    graph.push_back(
+        boost::make_shared<BetweenFactor<Pose2> >(i, i + 1,
+            Pose2(1.0, 0.0, 0.0), odoNoise));
+  return graph;
+}
+
+Values chainInitial() {
+  Values initial;
+  for (Key i = 0; i < 7; ++i)
+    initial.insert(i, Pose2(double(i) + 0.1, -0.1, 0.05));
+  return initial;
+}
+
+FastMap<Key, int> chainPartition() {
+  FastMap<Key, int> table;
+  for (Key i = 0; i < 3; ++i) table[i] = 1;
+  table[3] = 0; // separator
+  for (Key i = 4; i < 7; ++i) table[i] = 2;
+  return table;
+}
+
+} // end anonymous namespace
+
+/* ************************************************************************* */
+TEST( PartitionedOptimizer, iterateMatchesGaussNewton )
+{
+  // Each iteration is an exact Gauss-Newton step computed in partitioned
+  // form, so one iterate must match one full Gauss-Newton iteration
+  PartitionedOptimizer partitioned(chainGraph(), chainInitial(),
+      chainPartition());
+  LONGS_EQUAL(2, (long)partitioned.nrSubmaps());
+  partitioned.iterate();
+
+  GaussNewtonOptimizer full(chainGraph(), chainInitial());
+  full.iterate();
+  EXPECT(assert_equal(full.values(), partitioned.values(), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST( PartitionedOptimizer, optimize )
+{
+  PartitionedOptimizer partitioned(chainGraph(), chainInitial(),
+      chainPartition());
+  Values actual = partitioned.optimize();
+
+  Values expected = GaussNewtonOptimizer(chainGraph(), chainInitial())
+      .optimize();
+  EXPECT(assert_equal(expected, actual, 1e-5));
+  EXPECT(partitioned.iterations() > 0);
+}
+
+/* ************************************************************************* */
+TEST( PartitionedOptimizer, invalidPartitions )
+{
+  // A factor spanning both submap interiors is not a vertex separator
+  FastMap<Key, int> table = chainPartition();
+  table[3] = 1;
+  NonlinearFactorGraph graph = chainGraph();
+  graph.push_back(
+      boost::make_shared<BetweenFactor<Pose2> >(2, 4, Pose2(2.0, 0.0, 0.0),
+          odoNoise));
+  table[3] = 2; // now factor 3-4 stays inside submap 2, but 2-4 spans both
+  CHECK_EXCEPTION(
+      PartitionedOptimizer(graph, chainInitial(), table),
+      std::invalid_argument);
+
+  // A variable missing from the table is also rejected
+  FastMap<Key, int> incomplete = chainPartition();
+  incomplete.erase(6);
+  CHECK_EXCEPTION(
+      PartitionedOptimizer(chainGraph(), chainInitial(), incomplete),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
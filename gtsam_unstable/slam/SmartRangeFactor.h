@@ -64,6 +64,7 @@ class SmartRangeFactor: public NoiseModelFactor {
           "SmartRangeFactor::addRange: adding duplicate measurement for key.");
     }
     keys_.push_back(key);
+    invalidateSortedKeys();
     measurements_.push_back(measuredRange);
     size_t n = keys_.size();
     // Since we add the errors, the noise variance adds
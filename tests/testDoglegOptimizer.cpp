@@ -121,6 +121,28 @@ TEST(DoglegOptimizer, ComputeDoglegPoint) {
   VectorValues expected3 = gbn.optimize();
   VectorValues actual3 = DoglegOptimizerImpl::ComputeDoglegPoint(Delta3, gbn.optimizeGradientSearch(), gbn.optimize());
   EXPECT(assert_equal(expected3, actual3));
+
+  // The overloads taking precomputed inner products give the same points
+  VectorValues xu = gbn.optimizeGradientSearch();
+  VectorValues xn = gbn.optimize();
+  DoglegOptimizerImpl::CachedDoglegProducts products(xu, xn);
+  EXPECT(assert_equal(actual1, DoglegOptimizerImpl::ComputeDoglegPoint(Delta1, xu, xn, products)));
+  EXPECT(assert_equal(actual2, DoglegOptimizerImpl::ComputeDoglegPoint(Delta2, xu, xn, products)));
+  EXPECT(assert_equal(actual3, DoglegOptimizerImpl::ComputeDoglegPoint(Delta3, xu, xn, products)));
+  EXPECT(assert_equal(expected2, DoglegOptimizerImpl::ComputeBlend(Delta2, xu, xn, products)));
+
+  // Evaluating candidate radii against the single factorization matches
+  // computing each dogleg point and its model error separately
+  std::vector<double> deltas = boost::assign::list_of(Delta1)(Delta2)(Delta3);
+  std::vector<DoglegOptimizerImpl::CandidateResult> candidates =
+      DoglegOptimizerImpl::EvaluateCandidateDeltas(deltas, xu, xn, gbn);
+  LONGS_EQUAL(3, candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    DOUBLES_EQUAL(deltas[i], candidates[i].delta, 1e-15);
+    VectorValues expected = DoglegOptimizerImpl::ComputeDoglegPoint(deltas[i], xu, xn);
+    EXPECT(assert_equal(expected, candidates[i].dx_d));
+    DOUBLES_EQUAL(gbn.error(expected), candidates[i].M_error, 1e-10);
+  }
 }
 
 /* ************************************************************************* */
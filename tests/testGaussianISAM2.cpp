@@ -15,10 +15,12 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Marginals.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Symbol.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/treeTraversal-inst.h>
@@ -346,6 +348,170 @@ TEST(ISAM2, slamlike_solution_dogleg_qr)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, wildfireThresholds)
+{
+  WildfireThresholds zones;
+  EXPECT(zones.empty());
+  DOUBLES_EQUAL(0.001, zones.thresholdFor(5, 0.001), 1e-12);
+
+  zones.addZone(0, 9, 0.1);     // loose zone, raises the default
+  zones.addZone(5, 20, 1e-6);   // tight zone, overlaps the loose one
+  EXPECT(!zones.empty());
+  DOUBLES_EQUAL(0.1, zones.thresholdFor(0, 0.001), 1e-12);   // loose zone wins over default
+  DOUBLES_EQUAL(1e-6, zones.thresholdFor(7, 0.001), 1e-12);  // overlap: tightest wins
+  DOUBLES_EQUAL(1e-6, zones.thresholdFor(20, 0.001), 1e-12); // last key is inclusive
+  DOUBLES_EQUAL(0.001, zones.thresholdFor(21, 0.001), 1e-12);  // outside all zones
+
+  zones.clearZones();
+  EXPECT(zones.empty());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, accuracyZones)
+{
+  // A wildfire threshold this loose leaves deltas stale away from the
+  // re-eliminated top of the tree
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none,
+      ISAM2Params(ISAM2GaussNewtonParams(100.0), 0.0, 0, false));
+
+  // A loop closure with a large residual shifts the whole trajectory; the
+  // loose threshold stops delta propagation below the re-eliminated top
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(9, 11, Pose2(8.5, 0.1, 0.0), odoNoise);
+  isam.update(newfactors, Values());
+  isam.calculateEstimate();
+
+  // A tight zone over every key overrides the loose default and marks the
+  // zone's variables for re-solution, so the estimate matches a full
+  // back-substitution even though the default threshold would accept
+  // whatever deltas the previous solve left behind
+  isam.registerAccuracyZone(0, 101, 0.0);
+  EXPECT(!isam.accuracyZones().empty());
+  Values tight = isam.calculateEstimate();
+  Values best = isam.calculateBestEstimate();
+  EXPECT(assert_equal(best, tight));
+
+  isam.clearAccuracyZones();
+  EXPECT(isam.accuracyZones().empty());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, cacheEviction)
+{
+  // With relinearization disabled the cached and freshly computed
+  // linearizations are identical, so eviction must not change the solution
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  ISAM2Params evictParams = params;
+  evictParams.cacheEvictionAge = 1;
+
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, evictParams);
+  ISAM2 reference = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // The aggressive age already forces some recomputes while the trajectory
+  // is built; a quiet update re-eliminates nothing, so it evicts the whole
+  // cache without recomputing anything
+  const size_t baseline = isam.cacheRecomputeCount();
+  isam.update(NonlinearFactorGraph(), Values());
+  reference.update(NonlinearFactorGraph(), Values());
+  EXPECT_LONGS_EQUAL(baseline, isam.cacheRecomputeCount());
+
+  // A loop closure into the oldest poses re-eliminates their long-quiet
+  // part of the tree; the affected factors there have evicted caches and
+  // are relinearized on demand
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 2, Pose2(2.0, 0.1, 0.0), odoNoise);
+  isam.update(newfactors, Values());
+  reference.update(newfactors, Values());
+
+  EXPECT(isam.cacheRecomputeCount() > baseline);
+  EXPECT(assert_equal(reference.calculateEstimate(), isam.calculateEstimate()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, runtimeRelinearizeThreshold)
+{
+  // Per-type thresholds, initially so loose nothing ever relinearizes
+  ISAM2ThresholdMap thresholds;
+  thresholds['x'] = Vector3::Constant(100.0);
+  ISAM2 isam(ISAM2Params(ISAM2GaussNewtonParams(0.0), thresholds, 1, true));
+
+  // A chain of poses with deliberately poor initial guesses accumulates
+  // large deltas that stay below the loose threshold
+  NonlinearFactorGraph fullgraph;
+  Values fullinit;
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += PriorFactor<Pose2>(Symbol('x', 0), Pose2(0.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(Symbol('x', 0), Pose2(0.1, 0.2, 0.05));
+    fullgraph.push_back(newfactors); fullinit.insert(init);
+    isam.update(newfactors, init);
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(Symbol('x', i), Symbol('x', i + 1),
+        Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(Symbol('x', i + 1), Pose2(i + 1.5, 0.4, -0.1));
+    fullgraph.push_back(newfactors); fullinit.insert(init);
+    isam.update(newfactors, init);
+  }
+
+  // A factor-less update marks nothing: the pending deltas are all below
+  // the loose threshold
+  ISAM2Result quiet = isam.update();
+  EXPECT_LONGS_EQUAL(0, quiet.variablesRelinearized);
+
+  // Tightening the pose threshold at runtime re-tests the pending deltas,
+  // so the very next update relinearizes even though no delta changed
+  isam.setRelinearizeThreshold('x', Vector3::Constant(0.001));
+  ISAM2Result result = isam.update();
+  EXPECT(result.variablesRelinearized > 0);
+
+  // A few more updates iterate to the batch solution
+  for (size_t i = 0; i < 5; ++i) isam.update();
+  Values expected = GaussNewtonOptimizer(fullgraph, fullinit).optimize();
+  EXPECT(assert_equal(expected, isam.calculateEstimate(), 1e-6));
+
+  // The per-type setter requires a per-type map
+  ISAM2 scalarIsam((ISAM2Params()));
+  CHECK_EXCEPTION(scalarIsam.setRelinearizeThreshold('x', Vector3::Constant(0.1)),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, adaptiveRelinearizeThreshold)
+{
+  // An unattainable target makes every relinearization look not worth its
+  // cost, so the tuner should back the threshold off - but never beyond the
+  // documented 10x cap
+  ISAM2ThresholdMap thresholds;
+  thresholds['x'] = Vector3::Constant(0.001);
+  ISAM2Params params(ISAM2GaussNewtonParams(0.0), thresholds, 1, true, true);
+  params.adaptiveRelinearizationTarget = 1.0;
+  ISAM2 isam(params);
+
+  NonlinearFactorGraph newfactors;
+  newfactors += PriorFactor<Pose2>(Symbol('x', 0), Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(Symbol('x', 0), Pose2(0.1, 0.2, 0.05));
+  isam.update(newfactors, init);
+  for (size_t i = 0; i < 5; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(Symbol('x', i), Symbol('x', i + 1),
+        Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(Symbol('x', i + 1), Pose2(i + 1.5, 0.4, -0.1));
+    isam.update(newfactors, init);
+  }
+
+  const ISAM2ThresholdMap& tuned =
+      boost::get<ISAM2ThresholdMap>(isam.params().relinearizeThreshold);
+  EXPECT(tuned.at('x')[0] > 0.001);
+  EXPECT(tuned.at('x')[0] <= 10.0 * 0.001 + 1e-12);
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, clone) {
 
@@ -796,6 +962,129 @@ TEST(ISAM2, marginalizeLeaves5)
   EXPECT(checkMarginalizeLeaves(isam, marginalizeKeys));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, marginalizeLeavesRange)
+{
+  // Two identical systems: one marginalizes by explicit list, the other by
+  // key interval; the results must agree
+  auto makeIsam = []() {
+    ISAM2 isam;
+    NonlinearFactorGraph factors;
+    factors += PriorFactor<double>(0, 0.0, model);
+    factors += BetweenFactor<double>(0, 1, 0.0, model);
+    factors += BetweenFactor<double>(1, 2, 0.0, model);
+    factors += BetweenFactor<double>(0, 2, 0.0, model);
+    factors += BetweenFactor<double>(2, 3, 0.0, model);
+    Values values;
+    values.insert(0, 0.0);
+    values.insert(1, 0.0);
+    values.insert(2, 0.0);
+    values.insert(3, 0.0);
+    FastMap<Key, int> constrainedKeys;
+    constrainedKeys.insert(make_pair(0, 0));
+    constrainedKeys.insert(make_pair(1, 1));
+    constrainedKeys.insert(make_pair(2, 2));
+    constrainedKeys.insert(make_pair(3, 3));
+    isam.update(factors, values, FactorIndices(), constrainedKeys);
+    return isam;
+  };
+
+  ISAM2 isamList = makeIsam(), isamRange = makeIsam();
+
+  // The interval query returns the sorted keys in [first, last]
+  KeyVector expectedKeys {0, 1, 2, 3};
+  EXPECT(expectedKeys == isamRange.keysInRange(0, 3));
+  KeyVector expectedFront {0};
+  EXPECT(expectedFront == isamRange.keysInRange(0, 0));
+
+  // Marginalize the oldest variable through both interfaces
+  FastList<Key> leafKeys = list_of(0);
+  isamList.marginalizeLeaves(leafKeys);
+  isamRange.marginalizeLeaves(Key(0), Key(0));
+
+  Matrix expectedHessian = GaussianFactorGraph(isamList).augmentedHessian();
+  Matrix actualHessian = GaussianFactorGraph(isamRange).augmentedHessian();
+  EXPECT(assert_equal(expectedHessian, actualHessian, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, rebalance)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+  const size_t depthBefore = isam.treeDepth();
+  EXPECT(depthBefore > 0);
+
+  // A bound the tree already satisfies is a no-op
+  EXPECT(!isam.rebalance(depthBefore));
+
+  // Forcing a tiny bound re-eliminates the deep region; re-elimination is
+  // exact, so the solution is unchanged
+  Values expected = isam.calculateBestEstimate();
+  EXPECT(isam.rebalance(1));
+  Values actual = isam.calculateBestEstimate();
+  EXPECT(assert_equal(expected, actual, 1e-8));
+
+  // Automatic rebalancing after every update stays consistent with batch
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.rebalanceDepthBound = 2;
+  ISAM2 isam2 = createSlamlikeISAM2(fullinit, fullgraph, params);
+  CHECK(isam_check(fullgraph, fullinit, isam2, *this, result_));
+}
+
+/* ************************************************************************* */
+// Class exports needed to serialize the checkpoint in the test below; the
+// archive headers must come first so the exports are instantiated for the
+// binary archives saveCheckpoint() uses
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/export.hpp>
+#include <gtsam/linear/HessianFactor.h>
+BOOST_CLASS_EXPORT_GUID(gtsam::GenericValue<double>, "gtsam_GenericValue_double")
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<double>, "gtsam_PriorFactor_double")
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<double>, "gtsam_BetweenFactor_double")
+BOOST_CLASS_EXPORT_GUID(gtsam::JacobianFactor, "gtsam_JacobianFactor")
+BOOST_CLASS_EXPORT_GUID(gtsam::HessianFactor, "gtsam_HessianFactor")
+BOOST_CLASS_EXPORT_GUID(gtsam::GaussianConditional, "gtsam_GaussianConditional")
+
+/* ************************************************************************* */
+TEST(ISAM2, checkpoint)
+{
+  // Build a small chain incrementally, checkpointing along the way
+  ISAM2 isam;
+  isam.enableCheckpointJournal();
+  NonlinearFactorGraph graph;
+  graph += PriorFactor<double>(0, 0.0, model);
+  Values values;
+  values.insert(0, 0.0);
+  isam.update(graph, values);
+
+  const string full = "testGaussianISAM2_checkpoint_full.bin";
+  const string delta = "testGaussianISAM2_checkpoint_delta.bin";
+  isam.saveCheckpoint(full);
+
+  // Updates after the full checkpoint land in the delta checkpoint
+  for (Key j = 1; j <= 3; ++j) {
+    NonlinearFactorGraph newFactors;
+    newFactors += BetweenFactor<double>(j - 1, j, 1.0, model);
+    Values newValues;
+    newValues.insert(j, double(j));
+    isam.update(newFactors, newValues);
+  }
+  isam.saveDeltaCheckpoint(delta);
+
+  // Restore into a fresh object: full state, then the recorded updates
+  ISAM2 restored;
+  restored.restoreCheckpoint(full);
+  EXPECT_LONGS_EQUAL(1, restored.getLinearizationPoint().size());
+  restored.restoreDeltaCheckpoint(delta);
+
+  EXPECT_LONGS_EQUAL(4, restored.getLinearizationPoint().size());
+  EXPECT(assert_equal(isam.calculateBestEstimate(),
+                      restored.calculateBestEstimate(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, marginalCovariance)
 {
@@ -808,6 +1097,212 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, calculateEstimates)
+{
+  // Create isam2
+  ISAM2 isam = createSlamlikeISAM2();
+
+  // A subset query should match the corresponding entries of the full estimate
+  const Values full = isam.calculateEstimate();
+  const KeyVector keys = list_of(0)(3)(5)(100);
+  const Values subset = isam.calculateEstimates(keys);
+  EXPECT_LONGS_EQUAL(4, subset.size());
+  for (Key key : keys)
+    EXPECT(full.at(key).equals_(subset.at(key)));
+
+  // The lazy view serves the same estimates, typed or untyped
+  ISAM2::EstimateView view(isam);
+  for (Key key : keys)
+    EXPECT(full.at(key).equals_(view.at(key)));
+  EXPECT(assert_equal(full.at<Pose2>(3), view.at<Pose2>(3)));
+
+  // After another update the view must serve the refreshed estimate
+  NonlinearFactorGraph newfactors;
+  newfactors += PriorFactor<Pose2>(0, Pose2(0.1, 0.2, 0.3),
+      noiseModel::Isotropic::Sigma(3, 0.1));
+  isam.update(newfactors, Values());
+  const Values updated = isam.calculateEstimate();
+  for (Key key : keys)
+    EXPECT(updated.at(key).equals_(view.at(key)));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, changeJournal)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.0), 0.01, 1);
+  params.enableChangeJournal = true;
+  ISAM2 isam(params);
+
+  // The first update introduces the first pose
+  NonlinearFactorGraph newfactors;
+  newfactors += PriorFactor<Pose2>(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(0, Pose2(0.01, 0.01, 0.01));
+  ISAM2Result result = isam.update(newfactors, init);
+  CHECK(result.journal);
+  EXPECT_LONGS_EQUAL(1, (long)result.journal->newKeys.size());
+  EXPECT_LONGS_EQUAL(0, (long)result.journal->newKeys[0]);
+  EXPECT(result.journal->removedKeys.empty());
+  EXPECT(!result.journal->deltaChangedKeys.empty());  // the prior moves x0
+
+  // An odometry step: only the new key is reported as new
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(0, 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+  init.clear();
+  init.insert(1, Pose2(1.1, -0.1, 0.01));
+  result = isam.update(newfactors, init);
+  EXPECT_LONGS_EQUAL(1, (long)result.journal->newKeys.size());
+  EXPECT_LONGS_EQUAL(1, (long)result.journal->newKeys[0]);
+  EXPECT(!result.journal->deltaChangedKeys.empty());
+
+  // The coarse initial guess of x1 exceeds the relinearization threshold,
+  // so the following update journals it as relinearized
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(1, 2, Pose2(1.0, 0.0, 0.0), odoNoise);
+  init.clear();
+  init.insert(2, Pose2(2.1, -0.1, 0.01));
+  result = isam.update(newfactors, init);
+  EXPECT(!result.journal->relinearizedKeys.empty());
+
+  // Without the parameter the journal is not filled
+  ISAM2 plain;
+  newfactors = NonlinearFactorGraph();
+  newfactors += PriorFactor<Pose2>(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.clear();
+  init.insert(0, Pose2(0.01, 0.01, 0.01));
+  result = plain.update(newfactors, init);
+  EXPECT(!result.journal);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, directAppend)
+{
+  // Threshold zero so forced relinearization below iterates to convergence
+  ISAM2 isam(ISAM2Params(ISAM2GaussNewtonParams(), 0.0));
+  NonlinearFactorGraph fullGraph;
+  Values fullInit;
+
+  // Anchor the first pose
+  NonlinearFactorGraph newfactors;
+  newfactors += PriorFactor<Pose2>(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(0, Pose2(0.01, 0.01, 0.01));
+  fullGraph.push_back(newfactors);
+  fullInit.insert(init);
+  isam.update(newfactors, init);
+
+  // A prior on a brand-new, disconnected variable takes the direct-append
+  // path; the result must still match the batch solution
+  newfactors = NonlinearFactorGraph();
+  newfactors += PriorFactor<Pose2>(100, Pose2(5.0, 0.0, 0.0), odoNoise);
+  init.clear();
+  init.insert(100, Pose2(5.1, 0.1, 0.01));
+  fullGraph.push_back(newfactors);
+  fullInit.insert(init);
+  ISAM2Result result = isam.update(newfactors, init);
+  EXPECT_LONGS_EQUAL(1, (long)result.variablesReeliminated);
+  CHECK(isam.nodes().exists(100));
+
+  Values expected = GaussNewtonOptimizer(fullGraph, fullInit).optimize();
+  EXPECT(assert_equal(expected, isam.calculateBestEstimate(), 1e-6));
+
+  // Connecting the appended variable to the rest of the tree afterwards must
+  // go through the general machinery and stay consistent with batch
+  newfactors = NonlinearFactorGraph();
+  newfactors += BetweenFactor<Pose2>(0, 100, Pose2(5.0, 0.0, 0.0), odoNoise);
+  fullGraph.push_back(newfactors);
+  isam.update(newfactors, Values());
+
+  // The new factor is nonlinear, so iterate relinearization before
+  // comparing against the fully converged batch solution
+  for (size_t i = 0; i < 3; ++i)
+    isam.update(NonlinearFactorGraph(), Values(), FactorIndices(),
+                boost::none, boost::none, boost::none, true);
+
+  expected = GaussNewtonOptimizer(fullGraph, fullInit).optimize();
+  EXPECT(assert_equal(expected, isam.calculateBestEstimate(), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, archiveColdCliques)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+  isam.getDelta();  // flush pending delta changes so the whole tree is cold
+
+  // Record every cached factor's augmented information beforehand
+  std::map<ISAM2Clique*, Matrix> expected;
+  for (const auto& key_clique : isam.nodes()) {
+    ISAM2Clique* clique = key_clique.second.get();
+    if (clique->cachedFactor())
+      expected[clique] = clique->cachedFactor()->augmentedInformation();
+  }
+  EXPECT(!expected.empty());
+
+  // Archiving the cold tree releases memory
+  const size_t released = isam.archiveColdCliques();
+  EXPECT(released > 0);
+  size_t archived = 0;
+  for (const auto& pair : expected)
+    if (pair.first->archived()) ++archived;
+  EXPECT(archived > 0);
+
+  // Access through cachedFactor() restores each factor losslessly
+  for (const auto& pair : expected) {
+    EXPECT(assert_equal(pair.second,
+                        pair.first->cachedFactor()->augmentedInformation()));
+    EXPECT(!pair.first->archived());
+  }
+
+  // The tree keeps functioning across archive cycles
+  isam.archiveColdCliques();
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 1, Pose2(1.0, 0.0, 0.0),
+      noiseModel::Isotropic::Sigma(3, 0.1));
+  const size_t n = isam.getLinearizationPoint().size();
+  isam.update(newfactors, Values());
+  EXPECT_LONGS_EQUAL(n, isam.calculateEstimate().size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, relinearizeBudget)
+{
+  // Chain of poses with deliberately bad initial guesses, so the first
+  // solve leaves every variable above the relinearization threshold
+  NonlinearFactorGraph graph;
+  Values init;
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.1);
+  graph += PriorFactor<Pose2>(0, Pose2(), model);
+  init.insert(0, Pose2(0.05, -0.05, 0.01));
+  for (size_t i = 1; i < 5; ++i) {
+    graph += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), model);
+    init.insert(i, Pose2(double(i) + 0.4, 0.3, -0.2));
+  }
+
+  ISAM2Params params;
+  params.relinearizeThreshold = 0.01;
+  params.relinearizeSkip = 1;
+  ISAM2 reference(params);
+  params.relinearizeBudget = 1.0;  // smaller than any clique cost
+  ISAM2 budgeted(params);
+
+  reference.update(graph, init);
+  budgeted.update(graph, init);
+
+  // Drain each filter until no variables need relinearization
+  size_t referenceRounds = 0, budgetedRounds = 0;
+  for (; referenceRounds < 20; ++referenceRounds)
+    if (reference.update().variablesRelinearized == 0) break;
+  for (; budgetedRounds < 50; ++budgetedRounds)
+    if (budgeted.update().variablesRelinearized == 0) break;
+
+  // The budget spreads the same relinearization work over more updates,
+  // but the filter still reaches the same estimate
+  EXPECT(budgetedRounds > referenceRounds);
+  EXPECT(assert_equal(reference.calculateBestEstimate(),
+                      budgeted.calculateBestEstimate(), 1e-4));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testLocalizedLevenbergMarquardt.cpp
+ * @brief   Unit tests for trust-region-localized Levenberg-Marquardt
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/LocalizedLevenbergMarquardt.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t nrKeys = 12;
+
+/* ************************************************************************* */
+// A chain of Point2 variables with exact unit steps: ground truth is (i, 0)
+static NonlinearFactorGraph chainGraph() {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Point2> >(0, Point2(0, 0),
+      noiseModel::Isotropic::Sigma(2, 0.1));
+  for (Key j = 0; j + 1 < nrKeys; ++j)
+    graph.emplace_shared<BetweenFactor<Point2> >(j, j + 1, Point2(1, 0),
+        noiseModel::Isotropic::Sigma(2, 0.1));
+  return graph;
+}
+
+/* ************************************************************************* */
+// Ground truth everywhere except a perturbed patch at keys 5 and 6
+static Values perturbedValues() {
+  Values values;
+  for (Key j = 0; j < nrKeys; ++j)
+    values.insert(j, Point2(double(j), 0.0));
+  values.update(5, Point2(6.0, -1.0));
+  values.update(6, Point2(5.0, 1.0));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(LocalizedLevenbergMarquardt, activeRegion) {
+  LocalizedLevenbergMarquardtParams params;
+  params.maxActiveKeys = 6;
+  LocalizedLevenbergMarquardt optimizer(chainGraph(), perturbedValues(),
+      params);
+
+  // The active region surrounds the perturbed patch and respects the bound
+  const KeyVector active = optimizer.activeKeys();
+  const KeySet activeSet(active.begin(), active.end());
+  EXPECT(active.size() > 0 && active.size() <= 6);
+  EXPECT(activeSet.count(5));
+  EXPECT(activeSet.count(6));
+
+  // The working copy only involves active keys; straddling factors have
+  // become linear boundary priors
+  Values localValues;
+  const NonlinearFactorGraph localGraph = optimizer.buildLocalGraph(active,
+      &localValues);
+  EXPECT_LONGS_EQUAL((long)active.size(), (long)localValues.size());
+  size_t nrContainers = 0;
+  for (const NonlinearFactor::shared_ptr& factor : localGraph) {
+    for (Key key : factor->keys())
+      EXPECT(activeSet.count(key));
+    if (dynamic_cast<const LinearContainerFactor*>(factor.get()))
+      ++nrContainers;
+  }
+  EXPECT(nrContainers > 0);
+}
+
+/* ************************************************************************* */
+TEST(LocalizedLevenbergMarquardt, localStep) {
+  NonlinearFactorGraph graph = chainGraph();
+  LocalizedLevenbergMarquardtParams params;
+  params.maxActiveKeys = 6;
+  LocalizedLevenbergMarquardt optimizer(graph, perturbedValues(), params);
+
+  const double errorBefore = optimizer.error();
+  const size_t nrActive = optimizer.iterate();
+  EXPECT(nrActive > 0);
+  EXPECT(optimizer.error() < errorBefore);
+
+  // Variables outside the active region are untouched by a local step
+  EXPECT(assert_equal(Point2(0.0, 0.0), optimizer.values().at<Point2>(0)));
+  EXPECT(assert_equal(Point2(11.0, 0.0), optimizer.values().at<Point2>(11)));
+}
+
+/* ************************************************************************* */
+TEST(LocalizedLevenbergMarquardt, convergence) {
+  NonlinearFactorGraph graph = chainGraph();
+  LocalizedLevenbergMarquardtParams params;
+  params.maxActiveKeys = 6;
+  params.globalInterval = 4;
+  LocalizedLevenbergMarquardt optimizer(graph, perturbedValues(), params);
+
+  for (size_t i = 0; i < 8; ++i)
+    optimizer.iterate();
+
+  // The localized schedule reaches the same optimum as a full batch solve
+  const Values batch = LevenbergMarquardtOptimizer(graph, perturbedValues())
+      .optimize();
+  DOUBLES_EQUAL(graph.error(batch), optimizer.error(), 1e-6);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -259,6 +259,70 @@ TEST(Marginals, order) {
   testMarginals(marginals, set);
 }
 
+/* ************************************************************************* */
+TEST(Marginals, lazy) {
+  // A simple chain with one landmark, queried through the lazy mode
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(0, Pose2(), noiseModel::Unit::Create(3));
+  fg += BetweenFactor<Pose2>(0, 1, Pose2(1,0,0), noiseModel::Unit::Create(3));
+  fg += BetweenFactor<Pose2>(1, 2, Pose2(1,0,0), noiseModel::Unit::Create(3));
+
+  Values vals;
+  vals.insert(0, Pose2());
+  vals.insert(1, Pose2(1,0,0));
+  vals.insert(2, Pose2(2,0,0));
+
+  vals.insert(100, Point2(1,1));
+  fg += BearingRangeFactor<Pose2,Point2>(1, 100,
+    vals.at<Pose2>(1).bearing(vals.at<Point2>(100)),
+    vals.at<Pose2>(1).range(vals.at<Point2>(100)), noiseModel::Unit::Create(2));
+  fg += BearingRangeFactor<Pose2,Point2>(2, 100,
+    vals.at<Pose2>(2).bearing(vals.at<Point2>(100)),
+    vals.at<Pose2>(2).range(vals.at<Point2>(100)), noiseModel::Unit::Create(2));
+
+  // The lazy mode defers the numeric factorization, so queries must match the
+  // eager mode exactly - both eliminate the same graph with the same ordering.
+  Marginals eager(fg, vals);
+  Marginals lazy(fg, vals, Marginals::CHOLESKY, true);
+  for(Key key: fg.keys()) {
+    EXPECT(assert_equal(eager.marginalCovariance(key), lazy.marginalCovariance(key), 1e-8));
+  }
+
+  // Also exercise a lazy instance with a user-supplied ordering
+  Ordering ordering = Ordering::Colamd(fg);
+  Marginals lazyOrdered(fg, vals, ordering, Marginals::QR, true);
+  Marginals eagerOrdered(fg, vals, ordering, Marginals::QR);
+  EXPECT(assert_equal(eagerOrdered.marginalCovariance(100), lazyOrdered.marginalCovariance(100), 1e-8));
+  EXPECT(assert_equal(eagerOrdered.jointMarginalCovariance(KeyVector{0, 2}).fullMatrix(),
+                      lazyOrdered.jointMarginalCovariance(KeyVector{0, 2}).fullMatrix(), 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(Marginals, bulkCovariances) {
+  // The bulk query must match the per-key marginalCovariance exactly
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(0, Pose2(), noiseModel::Unit::Create(3));
+  fg += BetweenFactor<Pose2>(0, 1, Pose2(1,0,0), noiseModel::Unit::Create(3));
+  fg += BetweenFactor<Pose2>(1, 2, Pose2(1,0,0), noiseModel::Unit::Create(3));
+
+  Values vals;
+  vals.insert(0, Pose2());
+  vals.insert(1, Pose2(1,0,0));
+  vals.insert(2, Pose2(2,0,0));
+
+  vals.insert(100, Point2(1,1));
+  fg += BearingRangeFactor<Pose2,Point2>(1, 100,
+    vals.at<Pose2>(1).bearing(vals.at<Point2>(100)),
+    vals.at<Pose2>(1).range(vals.at<Point2>(100)), noiseModel::Unit::Create(2));
+
+  Marginals marginals(fg, vals);
+  const KeyVector keys {0, 1, 2, 100};
+  std::map<Key, Matrix> covariances = marginals.marginalCovariances(keys);
+  LONGS_EQUAL(4, (long)covariances.size());
+  for(Key key: keys)
+    EXPECT(assert_equal(marginals.marginalCovariance(key), covariances.at(key), 1e-8));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
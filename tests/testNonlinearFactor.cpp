@@ -233,6 +233,91 @@ TEST( NonlinearFactor, linearize_constraint2 )
   CHECK(assert_equal((const GaussianFactor&)expected, *actual));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactor, Workspace )
+{
+  SharedNoiseModel sigma(noiseModel::Isotropic::Sigma(2,0.1));
+
+  Point2 z3(0.,-1.);
+  simulated2D::Measurement f0(z3, sigma, X(1),L(1));
+
+  Values config;
+  config.insert(X(1), Point2(1.0, 2.0));
+  config.insert(L(1), Point2(5.0, 4.0));
+
+  NoiseModelFactor::Workspace workspace;
+  workspace.prepare(f0, config);
+  f0.unwhitenedErrorInPlace(config, workspace);
+
+  // matches the allocating path, error and Jacobians
+  vector<Matrix> H(2);
+  Vector expected = f0.unwhitenedError(config, H);
+  CHECK(assert_equal(expected, workspace.error));
+  CHECK(assert_equal(H[0], workspace.jacobians[0]));
+  CHECK(assert_equal(H[1], workspace.jacobians[1]));
+
+  // re-evaluating into a prepared workspace must not reallocate the Jacobians
+  const double* data0 = workspace.jacobians[0].data();
+  const double* data1 = workspace.jacobians[1].data();
+  f0.unwhitenedErrorInPlace(config, workspace);
+  CHECK(data0 == workspace.jacobians[0].data());
+  CHECK(data1 == workspace.jacobians[1].data());
+
+  // whitened variant agrees with whitenedError
+  f0.whitenedErrorInPlace(config, workspace);
+  CHECK(assert_equal(f0.whitenedError(config), workspace.error));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactor, maskedUnwhitenedError )
+{
+  SharedNoiseModel sigma(noiseModel::Isotropic::Sigma(2, 0.1));
+  simulated2D::Measurement f0(Point2(0., -1.), sigma, X(1), L(1));
+  Values config = createNoisyValues();
+
+  // Reference: all Jacobians
+  std::vector<Matrix> expected(f0.size());
+  Vector expectedError = f0.unwhitenedError(config, expected);
+
+  // Request only the first block: the second slot must stay untouched
+  std::vector<Matrix> H(f0.size());
+  std::vector<bool> requested(f0.size(), false);
+  requested[0] = true;
+  Vector actualError = f0.unwhitenedError(config, requested, H);
+  CHECK(assert_equal(expectedError, actualError));
+  CHECK(assert_equal(expected[0], H[0]));
+  LONGS_EQUAL(0, (long)H[1].size());
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactor, linearizeMasked )
+{
+  SharedNoiseModel sigma(noiseModel::Isotropic::Sigma(2, 0.1));
+  simulated2D::Measurement f0(Point2(0., -1.), sigma, X(1), L(1));
+  Values config = createNoisyValues();
+
+  JacobianFactor::shared_ptr full = //
+      boost::dynamic_pointer_cast<JacobianFactor>(f0.linearize(config));
+
+  // Requesting only the landmark block yields a unary factor on L(1) whose
+  // block and RHS agree with the full linearization
+  std::vector<bool> requested(f0.size(), false);
+  requested[1] = true;
+  JacobianFactor::shared_ptr masked = //
+      boost::dynamic_pointer_cast<JacobianFactor>(f0.linearize(config, requested));
+  LONGS_EQUAL(1, (long)masked->size());
+  LONGS_EQUAL((long)L(1), (long)masked->keys()[0]);
+  CHECK(assert_equal((Matrix)full->getA(full->begin() + 1),
+      (Matrix)masked->getA(masked->begin())));
+  CHECK(assert_equal((Vector)full->getb(), (Vector)masked->getb()));
+
+  // A wrong-sized or empty mask is rejected
+  CHECK_EXCEPTION(f0.linearize(config, std::vector<bool>(1, true)),
+      std::invalid_argument);
+  CHECK_EXCEPTION(f0.linearize(config, std::vector<bool>(f0.size(), false)),
+      std::invalid_argument);
+}
+
 /* ************************************************************************* */
 class TestFactor4 : public NoiseModelFactor4<double, double, double, double> {
 public:
@@ -66,6 +66,49 @@ TEST( NonlinearFactorGraph, error )
   DOUBLES_EQUAL( 5.625, actual2, 1e-9 );
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, errorAlongDirection )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values values = createNoisyValues();
+
+  // Use the negative gradient at the linearization point as direction
+  GaussianFactorGraph::shared_ptr linear = fg.linearize(values);
+  VectorValues direction = linear->gradientAtZero();
+  direction *= -1.0;
+
+  std::vector<double> steps;
+  steps.push_back(0.0);
+  steps.push_back(0.01);
+  steps.push_back(0.1);
+
+  // The batched evaluation must match one retract + error per step
+  const std::vector<double> actual = fg.errorAlongDirection(values, direction, steps);
+  LONGS_EQUAL(3, (long)actual.size());
+  for (size_t k = 0; k < steps.size(); ++k) {
+    VectorValues delta = direction;
+    delta *= steps[k];
+    DOUBLES_EQUAL(fg.error(values.retract(delta)), actual[k], 1e-9);
+  }
+  DOUBLES_EQUAL(fg.error(values), actual[0], 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, deterministicParallelism )
+{
+  // The deterministic-parallel mode only changes the work decomposition,
+  // never the results
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values c2 = createNoisyValues();
+  const double expectedError = fg.error(c2);
+  GaussianFactorGraph::shared_ptr expectedLinear = fg.linearize(c2);
+
+  deterministicParallelism = true;
+  DOUBLES_EQUAL(expectedError, fg.error(c2), 1e-15);
+  EXPECT(assert_equal(*expectedLinear, *fg.linearize(c2)));
+  deterministicParallelism = false;
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, keys )
 {
@@ -116,6 +159,29 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeGrouped )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  fg.push_back(NonlinearFactor::shared_ptr()); // a null slot must survive grouping
+  Values initial = createNoisyValues();
+
+  // Every non-null factor appears exactly once in the permutation, and
+  // same-type factors are contiguous
+  const NonlinearFactorGraph::TypeGroups groups = fg.groupByType();
+  LONGS_EQUAL((long)fg.size() - 1, (long)groups.order.size());
+  CHECK(!groups.groups.empty());
+  size_t counted = 0;
+  for (const pair<size_t, size_t>& group : groups.groups)
+    counted += group.second - group.first;
+  LONGS_EQUAL((long)groups.order.size(), (long)counted);
+
+  // The grouped execution order produces the same graph, slot for slot
+  GaussianFactorGraph::shared_ptr expected = fg.linearize(initial);
+  GaussianFactorGraph::shared_ptr actual = fg.linearize(initial, groups);
+  CHECK(assert_equal(*expected, *actual));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
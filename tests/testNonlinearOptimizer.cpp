@@ -126,6 +126,61 @@ TEST( NonlinearOptimizer, SimpleLMOptimizer )
   DOUBLES_EQUAL(0,fg.error(actual),tol);
 }
 
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, SimpleLMOptimizerErrorCache )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // With a tiny epsilon the cached evaluation must reach the same optimum
+  LevenbergMarquardtParams params;
+  params.setErrorCacheEpsilon(1e-12);
+  Values actual = LevenbergMarquardtOptimizer(fg, c0, params).optimize();
+  DOUBLES_EQUAL(0,fg.error(actual),tol);
+
+  // A large epsilon freezes all factor errors, so the reported error cannot
+  // drop and the optimizer terminates without diverging
+  params.setErrorCacheEpsilon(1e6);
+  LevenbergMarquardtOptimizer frozen(fg, c0, params);
+  frozen.optimize();
+  DOUBLES_EQUAL(fg.error(c0), frozen.error(), tol);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, SimpleLMOptimizerArena )
+{
+  // A genuinely nonlinear problem from a bad initial guess, so the run
+  // spans several outer iterations and at least one rejected step - each
+  // new linearization reclaims the arena while the damped-system buffer
+  // still references the previous iteration's factors
+  NonlinearFactorGraph fg;
+  fg += PriorFactor<Pose2>(0, Pose2(0, 0, 0),
+      noiseModel::Isotropic::Sigma(3, 1));
+  fg += BetweenFactor<Pose2>(0, 1, Pose2(1, 0, M_PI / 2),
+      noiseModel::Isotropic::Sigma(3, 1));
+  fg += BetweenFactor<Pose2>(1, 2, Pose2(1, 0, M_PI / 2),
+      noiseModel::Isotropic::Sigma(3, 1));
+
+  Values init;
+  init.insert(0, Pose2(3, 4, -M_PI));
+  init.insert(1, Pose2(10, 2, -M_PI));
+  init.insert(2, Pose2(11, 7, -M_PI));
+
+  LevenbergMarquardtParams params;
+  params.setUseLinearizationArena(true);
+  LevenbergMarquardtOptimizer optimizer(fg, init, params);
+  Values actual = optimizer.optimize();
+  DOUBLES_EQUAL(0, fg.error(actual), tol);
+
+  // More inner than outer iterations means some lambda was rejected, so the
+  // damped system really was rebuilt across an arena reset
+  EXPECT(optimizer.iterations() >= 2);
+  EXPECT(optimizer.getInnerIterations() > (int) optimizer.iterations());
+}
+
 /* ************************************************************************* */
 TEST( NonlinearOptimizer, SimpleGNOptimizer )
 {
@@ -491,6 +546,68 @@ TEST(NonlinearOptimizer, Traits) {
   EXPECT(assert_equal(init, actual));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, IterationQualityHook )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // collect the streamed quality metrics
+  std::vector<NonlinearOptimizerParams::IterationQuality> qualities;
+  GaussNewtonParams params;
+  params.iterationQualityHook =
+      [&qualities](const NonlinearOptimizerParams::IterationQuality& quality) {
+        qualities.push_back(quality);
+      };
+
+  GaussNewtonOptimizer optimizer(fg, c0, params);
+  optimizer.optimize();
+
+  // one report per iteration, consistent with the optimizer's final state
+  EXPECT(qualities.size() > 0);
+  EXPECT_LONGS_EQUAL(optimizer.iterations(), qualities.size());
+  EXPECT_LONGS_EQUAL(1, qualities.front().iteration);
+  DOUBLES_EQUAL(optimizer.error(), qualities.back().error, 1e-12);
+  // the first iteration moves the estimate and reduces the error
+  EXPECT(qualities.front().maxDeltaNorm > 0.0);
+  EXPECT(qualities.front().errorDecrease > 0.0);
+  // elapsed times are nondecreasing
+  for (size_t i = 1; i < qualities.size(); i++)
+    EXPECT(qualities[i].elapsed >= qualities[i-1].elapsed);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, TimeBudget )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // a vanishing budget stops the loop right after the first iteration, but
+  // the returned values are the consistent result of that iteration
+  GaussNewtonParams params;
+  params.relativeErrorTol = 0.0;
+  params.absoluteErrorTol = 0.0;
+  params.timeBudget = 1e-12;
+  GaussNewtonOptimizer optimizer(fg, c0, params);
+  Values actual = optimizer.optimize();
+  EXPECT_LONGS_EQUAL(1, optimizer.iterations());
+  DOUBLES_EQUAL(fg.error(actual), optimizer.error(), 1e-12);
+
+  // the same problem without a budget runs more iterations
+  GaussNewtonParams unlimited;
+  unlimited.relativeErrorTol = 0.0;
+  unlimited.absoluteErrorTol = 0.0;
+  GaussNewtonOptimizer reference(fg, c0, unlimited);
+  reference.optimize();
+  EXPECT(reference.iterations() > 1);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
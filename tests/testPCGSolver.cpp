@@ -166,6 +166,107 @@ TEST( PCGSolver, blockjacobi )
   DOUBLES_EQUAL(0,fg.error(actualPCG),tol);
 }
 
+/* ************************************************************************* */
+// Warm-started repeated solves must reach the same solution as cold starts
+TEST( PCGSolver, warmStart )
+{
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Point2 x0(10,10);
+  Values c0;
+  c0.insert(X(1), x0);
+  GaussianFactorGraph::shared_ptr gfg = fg.linearize(c0);
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg.setWarmStart(true);
+  pcg.setPreconditionerLag(2);
+  pcg.setAdaptiveTolerance(true);
+  PCGSolver stateful(pcg);
+
+  // Solving the same system repeatedly must keep returning the exact answer,
+  // with the second and third solves starting from the previous solution and
+  // reusing the preconditioner factorization
+  VectorValues expected = gfg->optimize();
+  for (size_t i = 0; i < 3; ++i) {
+    VectorValues actual = stateful.optimize(*gfg);
+    EXPECT(assert_equal(expected, actual, 1e-5));
+  }
+
+  // A stateful solver through the LM path still converges
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  paramsPCG.iterativeParams = boost::make_shared<PCGSolverParameters>(pcg);
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize();
+  DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
+}
+
+/* ************************************************************************* */
+// The mixed-precision path must refine back to the double solution
+TEST( PCGSolver, mixedPrecision )
+{
+  // Multi-variable system, same as the multiply_getb example above
+  GaussianFactorGraph simpleGFG;
+  SharedDiagonal unit2 = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.3));
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << -1, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -10, 0, 0, -10).finished(), 0, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << 2, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << 0, 1).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << -1, 1.5).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(1, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  VectorValues expected = simpleGFG.optimize();
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg.setMixedPrecision(true);
+  PCGSolver solver(pcg);
+  EXPECT(assert_equal(expected, solver.optimize(simpleGFG), 1e-5));
+
+  // Through the LM path as well
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  paramsPCG.iterativeParams = boost::make_shared<PCGSolverParameters>(pcg);
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Point2 x0(10,10);
+  Values c0;
+  c0.insert(X(1), x0);
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize();
+  DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
+}
+
+/* ************************************************************************* */
+// Equilibration must reach the direct solution on a badly scaled system
+TEST( PCGSolver, equilibrate )
+{
+  // Mixed units: variable 0 measured at ~1e3 scale, variable 1 at ~1e-2,
+  // giving a Hessian diagonal spanning ten orders of magnitude
+  GaussianFactorGraph badlyScaledGFG;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  badlyScaledGFG += JacobianFactor(0, (Matrix(2,2)<< 1e3, 0, 0, 1e3).finished(), (Vector(2) << 1e3, -2e3).finished(), unit2);
+  badlyScaledGFG += JacobianFactor(1, (Matrix(2,2)<< 1e-2, 0, 0, 1e-2).finished(), (Vector(2) << 3e-2, -1e-2).finished(), unit2);
+  badlyScaledGFG += JacobianFactor(0, (Matrix(2,2)<< -1e3, 0, 0, -1e3).finished(), 1, (Matrix(2,2)<< 1e-2, 0, 0, 1e-2).finished(), (Vector(2) << 0.5, 0.5).finished(), unit2);
+  VectorValues expected = badlyScaledGFG.optimize();
+
+  PCGSolverParameters pcg;
+  pcg.preconditioner_ = boost::make_shared<DummyPreconditionerParameters>();
+  pcg.setEquilibrate(true);
+  PCGSolver solver(pcg);
+  EXPECT(assert_equal(expected, solver.optimize(badlyScaledGFG), 1e-5));
+
+  // Through the LM path as well
+  LevenbergMarquardtParams paramsPCG;
+  paramsPCG.linearSolverType = LevenbergMarquardtParams::Iterative;
+  paramsPCG.iterativeParams = boost::make_shared<PCGSolverParameters>(pcg);
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+  Point2 x0(10,10);
+  Values c0;
+  c0.insert(X(1), x0);
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, paramsPCG).optimize();
+  DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
+}
+
 /* ************************************************************************* */
 // Test Incremental Subgraph PCG Solver
 TEST( PCGSolver, subgraph )
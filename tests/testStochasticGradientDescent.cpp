@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testStochasticGradientDescent.cpp
+ * @brief   Unit tests for sampled tangent-space gradient descent
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/StochasticGradientDescent.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t nrKeys = 6;
+
+/* ************************************************************************* */
+// A chain of Point2 variables with exact unit steps: ground truth is (i, 0)
+static NonlinearFactorGraph chainGraph() {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Point2> >(0, Point2(0, 0),
+      noiseModel::Isotropic::Sigma(2, 0.5));
+  for (Key j = 0; j + 1 < nrKeys; ++j)
+    graph.emplace_shared<BetweenFactor<Point2> >(j, j + 1, Point2(1, 0),
+        noiseModel::Isotropic::Sigma(2, 0.5));
+  return graph;
+}
+
+/* ************************************************************************* */
+static Values perturbedValues() {
+  Values values;
+  for (Key j = 0; j < nrKeys; ++j)
+    values.insert(j, Point2(double(j) + 0.3 * double(j % 3), -0.2 * double(j)));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(StochasticGradientDescent, sampledPhase) {
+  NonlinearFactorGraph graph = chainGraph();
+  StochasticGradientDescentParams params;
+  params.batchSize = graph.size();
+  params.stepSize = 0.1;
+  StochasticGradientDescent optimizer(graph, perturbedValues(), params);
+
+  const double errorBefore = optimizer.error();
+  double gradientNorm = 0.0;
+  for (size_t i = 0; i < 50; ++i)
+    gradientNorm = optimizer.iterate();
+  EXPECT_LONGS_EQUAL(50, (long)optimizer.iterations());
+  EXPECT(optimizer.error() < errorBefore);
+  EXPECT(gradientNorm >= 0.0);
+
+  // The same seed reproduces the same trajectory
+  StochasticGradientDescent repeat(graph, perturbedValues(), params);
+  for (size_t i = 0; i < 50; ++i)
+    repeat.iterate();
+  EXPECT(assert_equal(repeat.values(), optimizer.values()));
+}
+
+/* ************************************************************************* */
+TEST(StochasticGradientDescent, annealsToBatchOptimum) {
+  NonlinearFactorGraph graph = chainGraph();
+  StochasticGradientDescentParams params;
+  params.batchSize = 4;
+  params.maxIterations = 30;
+  params.finalBatchIterations = 20;
+  StochasticGradientDescent optimizer(graph, perturbedValues(), params);
+
+  const Values& result = optimizer.optimize();
+
+  // The final full-batch phase reaches the batch Levenberg-Marquardt optimum
+  const Values batch = LevenbergMarquardtOptimizer(graph, perturbedValues())
+      .optimize();
+  DOUBLES_EQUAL(graph.error(batch), graph.error(result), 1e-6);
+}
+
+/* ************************************************************************* */
+TEST(StochasticGradientDescent, rejectsEmptyBatch) {
+  StochasticGradientDescentParams params;
+  params.batchSize = 0;
+  CHECK_EXCEPTION(
+      StochasticGradientDescent(chainGraph(), perturbedValues(), params),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
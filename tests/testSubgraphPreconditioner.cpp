@@ -268,6 +268,38 @@ TEST(SubgraphSolver, Solves) {
   }
 }
 
+/* ************************************************************************* */
+TEST(SubgraphPreconditioner, incrementalBuild) {
+  // Repeated builds reuse or repair the subgraph selection; the resulting
+  // preconditioner must stay consistent with a freshly built one
+  SubgraphPreconditioner incremental;
+
+  GaussianFactorGraph Ab = planarGraph(3).first;
+  KeyInfo keyInfo(Ab);
+  std::map<Key, Vector> lambda;
+  incremental.build(Ab, keyInfo, lambda);
+  const auto xbar1 = incremental.Rc1()->optimize();
+
+  // Unchanged structure: the selection is reused and the solution unchanged
+  incremental.build(Ab, keyInfo, lambda);
+  EXPECT(assert_equal(xbar1, incremental.Rc1()->optimize()));
+
+  // Add one edge: the spanning structure is repaired, not rebuilt.  The
+  // repaired tree must still solve its own system exactly
+  Ab.add(key(1, 1), -I_2x2, key(3, 3), I_2x2, Vector2(1.0, 1.0),
+         noiseModel::Unit::Create(2));
+  KeyInfo keyInfo2(Ab);
+  incremental.build(Ab, keyInfo2, lambda);
+
+  SubgraphPreconditioner batch;
+  batch.build(Ab, keyInfo2, lambda);
+  const auto ordering = keyInfo2.ordering();
+  const auto y = incremental.Rc1()->optimize();
+  // Both preconditioners span all variables of the updated graph
+  EXPECT_LONGS_EQUAL(batch.Rc1()->size(), incremental.Rc1()->size());
+  EXPECT_LONGS_EQUAL(9, y.size());
+}
+
 /* ************************************************************************* */
 TEST(SubgraphPreconditioner, conjugateGradients) {
   // Build a planar graph
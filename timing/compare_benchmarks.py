@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+"""
+Compare two JSON files produced by timeRegressionSuite and flag regressions.
+
+Usage:
+  python compare_benchmarks.py baseline.json current.json [--threshold 0.10]
+
+Exits non-zero if any benchmark's median time regressed by more than the
+threshold (default 10%), so this can gate a CI job or release checklist.
+"""
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    return dict((b["name"], b) for b in data["benchmarks"])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown that counts as a regression")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = []
+    print("%-20s %12s %12s %9s" % ("benchmark", "baseline", "current", "change"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline:
+            print("%-20s %12s %12.6f %9s" % (name, "-", current[name]["median"], "new"))
+            continue
+        if name not in current:
+            print("%-20s %12.6f %12s %9s" % (name, baseline[name]["median"], "-", "removed"))
+            continue
+        old = baseline[name]["median"]
+        new = current[name]["median"]
+        change = (new - old) / old if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        print("%-20s %12.6f %12.6f %+8.1f%%%s" % (name, old, new, 100 * change, flag))
+
+    if regressions:
+        print("\n%d benchmark(s) regressed more than %.0f%%: %s" %
+              (len(regressions), 100 * args.threshold, ", ".join(regressions)))
+        return 1
+    print("\nNo regressions above %.0f%%" % (100 * args.threshold))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeAmalgamationPolicy.cpp
+ * @brief   Benchmark AmalgamationPolicy settings for junction-tree
+ *          construction, on a sparse 2D-style chain and a densely
+ *          connected 3D-BA-style graph
+ */
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t nrTrials = 10;
+
+/* ************************************************************************* */
+// A pose chain with sparse short-range extra links: many small independent
+// cliques, the regime where 2D indoor mapping problems live
+static GaussianFactorGraph buildChainGraph(size_t n) {
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.5);
+  gfg.add(0, I_3x3, Vector3(0.1, 0.2, 0.3), noiseModel::Unit::Create(3));
+  for (Key j = 0; j + 1 < n; ++j)
+    gfg.add(j, -I_3x3, j + 1, I_3x3, Vector3(0.1, 0.0, 0.0), model);
+  for (Key j = 0; j + 5 < n; j += 3)
+    gfg.add(j, -I_3x3, j + 5, I_3x3, Vector3(0.0, 0.1, 0.0), model);
+  return gfg;
+}
+
+/* ************************************************************************* */
+// Random long-range connectivity: wide separators and large frontal blocks,
+// the regime of 3D bundle adjustment after the Schur complement
+static GaussianFactorGraph buildDenseGraph(size_t n, size_t nrLinks) {
+  GaussianFactorGraph gfg = buildChainGraph(n);
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.5);
+  unsigned seed = 42;
+  for (size_t k = 0; k < nrLinks; ++k) {
+    seed = 1664525u * seed + 1013904223u;
+    const Key i = seed % n;
+    seed = 1664525u * seed + 1013904223u;
+    const Key j = seed % n;
+    if (i != j)
+      gfg.add(i, -I_3x3, j, I_3x3, Vector3(0.0, 0.0, 0.1), model);
+  }
+  return gfg;
+}
+
+/* ************************************************************************* */
+static size_t countCliques(const GaussianJunctionTree::sharedNode& node) {
+  size_t count = 1;
+  for (const GaussianJunctionTree::sharedNode& child : node->children)
+    count += countCliques(child);
+  return count;
+}
+
+/* ************************************************************************* */
+static void benchmark(const GaussianFactorGraph& gfg, const Ordering& ordering,
+    const VariableIndex& variableIndex, const AmalgamationPolicy& policy,
+    const string& name) {
+  double buildSeconds = 0, eliminateSeconds = 0;
+  size_t nrCliques = 0;
+
+  for (size_t trial = 0; trial < nrTrials; ++trial) {
+    clock_t start = clock();
+    GaussianEliminationTree etree(gfg, variableIndex, ordering);
+    GaussianJunctionTree junctionTree(etree, policy);
+    buildSeconds += double(clock() - start) / CLOCKS_PER_SEC;
+
+    nrCliques = 0;
+    for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+      nrCliques += countCliques(root);
+
+    start = clock();
+    GaussianBayesTree::shared_ptr bayesTree;
+    GaussianFactorGraph::shared_ptr remaining;
+    boost::tie(bayesTree, remaining) =
+        junctionTree.eliminate(EliminatePreferCholesky);
+    eliminateSeconds += double(clock() - start) / CLOCKS_PER_SEC;
+  }
+
+  cout << "  " << name << ": " << nrCliques << " cliques, build "
+      << 1000 * buildSeconds / nrTrials << " ms, eliminate "
+      << 1000 * eliminateSeconds / nrTrials << " ms" << endl;
+}
+
+/* ************************************************************************* */
+static void sweep(const GaussianFactorGraph& gfg, const string& name) {
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+
+  cout << name << ": " << variableIndex.size() << " variables, " << gfg.size()
+      << " factors" << endl;
+
+  benchmark(gfg, ordering, variableIndex, AmalgamationPolicy(), "structural");
+  benchmark(gfg, ordering, variableIndex, AmalgamationPolicy(8, 0, 0),
+      "maxFrontals 8");
+  benchmark(gfg, ordering, variableIndex, AmalgamationPolicy(0, 2, 0),
+      "maxChildren 2");
+  benchmark(gfg, ordering, variableIndex, AmalgamationPolicy(32, 0, 200),
+      "target 200, maxFrontals 32");
+  benchmark(gfg, ordering, variableIndex, AmalgamationPolicy(64, 0, 1000),
+      "target 1000, maxFrontals 64");
+}
+
+/* ************************************************************************* */
+int main() {
+  sweep(buildChainGraph(1000), "chain");
+  sweep(buildDenseGraph(500, 150), "dense");
+  return 0;
+}
+/* ************************************************************************* */
@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeDenseSwitch.cpp
+ * @brief   Benchmark GaussianJunctionTree::denseSwitch thresholds on
+ *          loop-closure-dense chains, see the denseSwitch documentation
+ */
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t nrVariables = 500;
+static const size_t nrLoopClosures = 150;
+static const size_t nrTrials = 10;
+
+/* ************************************************************************* */
+// A pose chain with random long-range loop closures, the pattern that
+// produces dense separators towards the root of the junction tree
+static GaussianFactorGraph buildGraph() {
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.5);
+  gfg.add(0, I_3x3, Vector3(0.1, 0.2, 0.3), noiseModel::Unit::Create(3));
+  for (Key j = 0; j + 1 < nrVariables; ++j)
+    gfg.add(j, -I_3x3, j + 1, I_3x3, Vector3(0.1, 0.0, 0.0), model);
+  unsigned seed = 42;
+  for (size_t k = 0; k < nrLoopClosures; ++k) {
+    seed = 1664525u * seed + 1013904223u;
+    const Key i = seed % nrVariables;
+    seed = 1664525u * seed + 1013904223u;
+    const Key j = seed % nrVariables;
+    if (i != j)
+      gfg.add(i, -I_3x3, j, I_3x3, Vector3(0.0, 0.1, 0.0), model);
+  }
+  return gfg;
+}
+
+/* ************************************************************************* */
+static size_t countCliques(const GaussianJunctionTree::sharedNode& node) {
+  size_t count = 1;
+  for (const GaussianJunctionTree::sharedNode& child : node->children)
+    count += countCliques(child);
+  return count;
+}
+
+/* ************************************************************************* */
+static void benchmark(const GaussianFactorGraph& gfg, const Ordering& ordering,
+    const VariableIndex& variableIndex, double threshold) {
+  double buildSeconds = 0, eliminateSeconds = 0;
+  size_t nrCliques = 0, nrAbsorbed = 0;
+
+  for (size_t trial = 0; trial < nrTrials; ++trial) {
+    clock_t start = clock();
+    GaussianEliminationTree etree(gfg, variableIndex, ordering);
+    GaussianJunctionTree junctionTree(etree);
+    nrAbsorbed = junctionTree.denseSwitch(threshold);
+    buildSeconds += double(clock() - start) / CLOCKS_PER_SEC;
+
+    nrCliques = 0;
+    for (const GaussianJunctionTree::sharedNode& root : junctionTree.roots())
+      nrCliques += countCliques(root);
+
+    start = clock();
+    GaussianBayesTree::shared_ptr bayesTree;
+    GaussianFactorGraph::shared_ptr remaining;
+    boost::tie(bayesTree, remaining) =
+        junctionTree.eliminate(EliminatePreferCholesky);
+    eliminateSeconds += double(clock() - start) / CLOCKS_PER_SEC;
+  }
+
+  cout << "threshold " << threshold << ": " << nrCliques << " cliques, "
+      << nrAbsorbed << " absorbed, build " << 1000 * buildSeconds / nrTrials
+      << " ms, eliminate " << 1000 * eliminateSeconds / nrTrials << " ms"
+      << endl;
+}
+
+/* ************************************************************************* */
+int main() {
+  const GaussianFactorGraph gfg = buildGraph();
+  const Ordering ordering = Ordering::Colamd(gfg);
+  const VariableIndex variableIndex(gfg);
+
+  cout << nrVariables << " variables, " << gfg.size() << " factors" << endl;
+
+  const double thresholds[] = {0.0, 0.9, 0.75, 0.5, 0.25};
+  for (double threshold : thresholds)
+    benchmark(gfg, ordering, variableIndex, threshold);
+
+  return 0;
+}
+/* ************************************************************************* */
@@ -0,0 +1,124 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeOrdering.cpp
+ * @brief   Compare ordering quality (fill-in, clique sizes, FLOPs, time) of
+ *          COLAMD vs METIS on a dataset, see also Ordering::AutoSelect
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Statistics of one elimination, gathered from the resulting Bayes tree
+struct OrderingStats {
+  double orderingTime, eliminationTime; // seconds
+  size_t nrCliques, maxCliqueSize; // clique count, largest clique (variables)
+  size_t nnzR; // scalar nonzeros in the square-root information factor
+  double flops; // rough dense factorization cost, sum of r*r*n per clique
+};
+
+/* ************************************************************************* */
+static void accumulateCliqueStats(
+    const GaussianBayesTree::sharedClique& clique, OrderingStats* stats) {
+  ++stats->nrCliques;
+  stats->maxCliqueSize = max(stats->maxCliqueSize,
+      clique->conditional()->size());
+  const size_t r = clique->conditional()->rows();
+  const size_t n = clique->conditional()->cols() - 1; // minus rhs column
+  stats->nnzR += r * (r + 1) / 2 + r * (n - r);
+  stats->flops += double(r) * double(r) * double(n);
+  for (const GaussianBayesTree::sharedClique& child : clique->children)
+    accumulateCliqueStats(child, stats);
+}
+
+/* ************************************************************************* */
+static OrderingStats benchmark(const GaussianFactorGraph& graph,
+    Ordering::OrderingType type) {
+  OrderingStats stats = {0, 0, 0, 0, 0, 0};
+
+  clock_t start = clock();
+  const Ordering ordering = Ordering::Create(type, graph);
+  stats.orderingTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  const GaussianBayesTree::shared_ptr bayesTree = //
+      graph.eliminateMultifrontal(ordering);
+  stats.eliminationTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+  for (const GaussianBayesTree::sharedClique& root : bayesTree->roots())
+    accumulateCliqueStats(root, &stats);
+  return stats;
+}
+
+/* ************************************************************************* */
+static void report(const string& name, const OrderingStats& stats,
+    size_t nnzA) {
+  cout << name << ":" << endl;
+  cout << "  ordering time:    " << stats.orderingTime << " s" << endl;
+  cout << "  elimination time: " << stats.eliminationTime << " s" << endl;
+  cout << "  cliques:          " << stats.nrCliques //
+      << " (max size " << stats.maxCliqueSize << ")" << endl;
+  cout << "  nnz(R):           " << stats.nnzR //
+      << " (fill-in ratio " << double(stats.nnzR) / double(nnzA) //
+      << ", approx. " << stats.nnzR * sizeof(double) / 1048576.0 //
+      << " MB)" << endl;
+  cout << "  factorization flops (approx.): " << stats.flops << endl;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Load a g2o (or TORO .graph) dataset; default to the w10000 example
+  string filename;
+  bool is3D = false;
+  if (argc > 1) {
+    filename = argv[1];
+    is3D = (argc > 2 && string(argv[2]) == "3d");
+  } else {
+    filename = findExampleDataFile("w10000");
+  }
+  cout << "Loading " << filename << endl;
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr initial;
+  boost::tie(graph, initial) = readG2o(filename, is3D);
+
+  const GaussianFactorGraph::shared_ptr linearized = //
+      graph->linearize(*initial);
+  const size_t nnzA = linearized->sparseJacobian().size();
+  cout << graph->size() << " factors, " << initial->size() << " variables, "
+      << "nnz(A) = " << nnzA << endl << endl;
+
+  report("COLAMD", benchmark(*linearized, Ordering::COLAMD), nnzA);
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  report("METIS", benchmark(*linearized, Ordering::METIS), nnzA);
+#else
+  cout << "METIS: not available (GTSAM_SUPPORT_NESTED_DISSECTION off)" << endl;
+#endif
+
+  const Ordering::OrderingType selected = Ordering::AutoSelect(*linearized);
+  cout << endl << "Ordering::AutoSelect picks: "
+      << (selected == Ordering::METIS ? "METIS" : "COLAMD") << endl;
+
+  return 0;
+}
+/* ************************************************************************* */
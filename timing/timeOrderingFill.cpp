@@ -0,0 +1,145 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeOrderingFill.cpp
+ * @brief   Render fill-in heatmaps from an EliminationTrace to diagnose why
+ *          an ordering produces pathological fill, see also timeOrdering.cpp
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/EliminationTrace.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Character ramp used to render cell intensity, blank through densest
+static const char kRamp[] = " .:-=+*#%@";
+static const size_t kRampSize = sizeof(kRamp) - 2; // index of densest char
+
+/* ************************************************************************* */
+/* Render the lower triangle of the (permuted) filled matrix as an ASCII
+ * heatmap of \c gridSize x \c gridSize cells.  Variables are placed at their
+ * elimination positions, so structure that COLAMD pushed toward the end of
+ * the ordering shows up in the bottom-right corner.  Original edges and fill
+ * edges are accumulated into separate grids and rendered side by side: a
+ * healthy ordering shows fill hugging the diagonal, a pathological one shows
+ * dense blocks far from it. */
+static void renderHeatmaps(const EliminationTrace& trace,
+    const Ordering& ordering, size_t gridSize) {
+  const size_t n = ordering.size();
+  if (n == 0)
+    return;
+  if (gridSize > n)
+    gridSize = n;
+  const FastMap<Key, size_t> position = ordering.invert();
+
+  vector<vector<size_t> > original(gridSize, vector<size_t>(gridSize, 0));
+  vector<vector<size_t> > fill(gridSize, vector<size_t>(gridSize, 0));
+  const auto cellOf = [n, gridSize](size_t pos) {
+    return pos * gridSize / n;
+  };
+  const auto accumulate = [&](vector<vector<size_t> >& grid, Key key1,
+      Key key2) {
+    size_t row = cellOf(position.at(key1)), col = cellOf(position.at(key2));
+    if (row < col)
+      swap(row, col); // lower triangle
+    ++grid[row][col];
+  };
+
+  for (const auto& key_neighbors : trace.replayFill(0))
+    for (Key neighbor : key_neighbors.second)
+      if (key_neighbors.first < neighbor)
+        accumulate(original, key_neighbors.first, neighbor);
+  for (const EliminationTrace::Step& step : trace.steps())
+    for (const pair<Key, Key>& edge : step.fillEdges)
+      accumulate(fill, edge.first, edge.second);
+
+  // Scale each grid by its own densest cell so both stay readable
+  const auto render = [gridSize](const string& name,
+      const vector<vector<size_t> >& grid) {
+    size_t densest = 1;
+    for (const vector<size_t>& row : grid)
+      for (size_t count : row)
+        densest = max(densest, count);
+    cout << name << " (densest cell " << densest << " edges):" << endl;
+    for (size_t row = 0; row < gridSize; ++row) {
+      cout << "  |";
+      for (size_t col = 0; col <= row; ++col)
+        cout << kRamp[grid[row][col] * kRampSize / densest];
+      cout << endl;
+    }
+  };
+  render("original edges", original);
+  render("fill edges", fill);
+}
+
+/* ************************************************************************* */
+static void report(const string& name, const EliminationTrace& trace,
+    const Ordering& ordering, size_t gridSize) {
+  cout << name << ": " << trace.nrOriginalEdges() << " original edges, "
+      << trace.totalFill() << " fill edges, max front "
+      << trace.maxDegree() + 1 << " variables" << endl;
+
+  // The handful of worst steps is usually the actionable part of the trace
+  size_t shown = 0;
+  for (size_t i = 0; i < trace.size() && shown < 5; ++i) {
+    const EliminationTrace::Step& step = trace.steps()[i];
+    if (step.degree + 1 == trace.maxDegree() + 1
+        || step.fillEdges.size() >= trace.totalFill() / 10 + 1) {
+      cout << "  step " << i << ": " << DefaultKeyFormatter(step.key)
+          << " degree " << step.degree << ", " << step.fillEdges.size()
+          << " fill edges" << endl;
+      ++shown;
+    }
+  }
+
+  renderHeatmaps(trace, ordering, gridSize);
+  cout << endl;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  // Load a TORO .graph (or g2o) dataset; default to the w100 example
+  string filename;
+  if (argc > 1)
+    filename = argv[1];
+  else
+    filename = findExampleDataFile("w100");
+  cout << "Loading " << filename << endl;
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr initial;
+  boost::tie(graph, initial) = load2D(filename);
+
+  const VariableIndex variableIndex(*graph);
+  cout << graph->size() << " factors, " << variableIndex.size()
+      << " variables" << endl << endl;
+
+  static const size_t gridSize = 58; // heatmap cells per side
+  const Ordering colamd = Ordering::Colamd(variableIndex);
+  report("COLAMD", EliminationTrace::Simulate(variableIndex, colamd), colamd,
+      gridSize);
+
+  const Ordering natural = Ordering::Natural(*graph);
+  report("NATURAL", EliminationTrace::Simulate(variableIndex, natural),
+      natural, gridSize);
+
+  return 0;
+}
+/* ************************************************************************* */
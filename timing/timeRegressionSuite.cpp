@@ -0,0 +1,182 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeRegressionSuite.cpp
+ * @brief   Tracked benchmark suite over the core hot paths, with JSON output
+ *
+ * Runs named benchmarks for linearization, multifrontal elimination,
+ * back-substitution, and incremental ISAM2 updates on a canned dataset from
+ * examples/Data, repeating each one several times and reporting min/mean/median
+ * wall time. When an output path is given on the command line the results are
+ * also written as JSON, so two runs can be diffed with compare_benchmarks.py
+ * to catch performance regressions before a release:
+ *
+ *   timeRegressionSuite baseline.json        # on the old tree
+ *   timeRegressionSuite current.json         # on the new tree
+ *   python compare_benchmarks.py baseline.json current.json
+ */
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+static const size_t kRepetitions = 5;
+
+/* ************************************************************************* */
+// One benchmark result: name plus per-repetition wall times in seconds
+struct BenchmarkResult {
+  string name;
+  vector<double> seconds;
+
+  double min() const {
+    return *min_element(seconds.begin(), seconds.end());
+  }
+
+  double mean() const {
+    double sum = 0.0;
+    for(double s: seconds) sum += s;
+    return sum / seconds.size();
+  }
+
+  double median() const {
+    vector<double> sorted = seconds;
+    sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+  }
+};
+
+/* ************************************************************************* */
+// Run functor for kRepetitions repetitions, recording wall time of each
+template<class RUNNABLE>
+static BenchmarkResult runBenchmark(const string& name, const RUNNABLE& runnable) {
+  BenchmarkResult result;
+  result.name = name;
+  for (size_t rep = 0; rep < kRepetitions; ++rep) {
+    clock_t start = clock();
+    runnable();
+    result.seconds.push_back(double(clock() - start) / CLOCKS_PER_SEC);
+  }
+  cout << result.name << ": min " << result.min() << " s, mean "
+      << result.mean() << " s, median " << result.median() << " s" << endl;
+  return result;
+}
+
+/* ************************************************************************* */
+static void writeJSON(const string& filename, const vector<BenchmarkResult>& results) {
+  ofstream out(filename.c_str());
+  if (!out) {
+    cerr << "Could not open " << filename << " for writing" << endl;
+    return;
+  }
+  out << "{\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchmarkResult& r = results[i];
+    out << "    {\n";
+    out << "      \"name\": \"" << r.name << "\",\n";
+    out << "      \"repetitions\": " << r.seconds.size() << ",\n";
+    out << "      \"min\": " << r.min() << ",\n";
+    out << "      \"mean\": " << r.mean() << ",\n";
+    out << "      \"median\": " << r.median() << ",\n";
+    out << "      \"times\": [";
+    for (size_t j = 0; j < r.seconds.size(); ++j)
+      out << (j ? ", " : "") << r.seconds[j];
+    out << "]\n";
+    out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+  cout << "Wrote " << results.size() << " benchmark results to " << filename << endl;
+}
+
+/* ************************************************************************* */
+// Replay the dataset odometry as incremental ISAM2 updates, batching the
+// factors per new pose, the same way timeIncremental.cpp plays time steps
+static void runISAM2Updates(const NonlinearFactorGraph& measurements,
+    size_t maxSteps) {
+  ISAM2 isam2;
+  size_t nextMeasurement = 0;
+  for (size_t step = 1; step <= maxSteps && nextMeasurement < measurements.size(); ++step) {
+    Values newVariables;
+    NonlinearFactorGraph newFactors;
+    if (step == 1) {
+      newVariables.insert(0, Pose2());
+      newFactors.add(PriorFactor<Pose2>(0, Pose2(), noiseModel::Unit::Create(3)));
+    }
+    while (nextMeasurement < measurements.size()) {
+      BetweenFactor<Pose2>::shared_ptr measurement = boost::dynamic_pointer_cast<
+          BetweenFactor<Pose2> >(measurements[nextMeasurement]);
+      if (!measurement)
+        throw runtime_error("Unexpected factor type in dataset");
+      if (measurement->key1() > step || measurement->key2() > step)
+        break;
+      newFactors.push_back(measurement);
+      if (measurement->key2() == step && !newVariables.exists(step)) {
+        Pose2 previous = measurement->key1() < step
+            ? isam2.calculateEstimate<Pose2>(measurement->key1())
+            : Pose2();
+        newVariables.insert(step, previous * measurement->measured());
+      }
+      ++nextMeasurement;
+    }
+    isam2.update(newFactors, newVariables);
+  }
+}
+
+/* ************************************************************************* */
+int main(int argc, char *argv[]) {
+
+  cout << "Loading data..." << endl;
+  const string datasetFile = findExampleDataFile("w100");
+  GraphAndValues data = load2D(datasetFile);
+  const NonlinearFactorGraph graph = *data.first;
+  const Values initial = *data.second;
+  cout << "Loaded " << graph.size() << " factors, " << initial.size()
+      << " variables" << endl;
+
+  vector<BenchmarkResult> results;
+
+  // Linearize the whole graph at the initial estimate
+  results.push_back(runBenchmark("linearize", [&graph, &initial]() {
+    graph.linearize(initial);
+  }));
+
+  // Multifrontal elimination of the linearized graph
+  const GaussianFactorGraph::shared_ptr linear = graph.linearize(initial);
+  results.push_back(runBenchmark("eliminate", [&linear]() {
+    linear->eliminateMultifrontal();
+  }));
+
+  // Back-substitution on the eliminated Bayes tree
+  const GaussianBayesTree::shared_ptr bayesTree = linear->eliminateMultifrontal();
+  results.push_back(runBenchmark("backsub", [&bayesTree]() {
+    bayesTree->optimize();
+  }));
+
+  // Incremental ISAM2 updates, replaying the dataset one pose at a time
+  results.push_back(runBenchmark("isam2_update", [&graph]() {
+    runISAM2Updates(graph, 100);
+  }));
+
+  if (argc > 1)
+    writeJSON(argv[1], results);
+
+  return 0;
+}